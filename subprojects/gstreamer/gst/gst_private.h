@@ -212,6 +212,36 @@ gboolean		priv_gst_registry_binary_read_cache	(GstRegistry * registry, const cha
 G_GNUC_INTERNAL
 gboolean		priv_gst_registry_binary_write_cache	(GstRegistry * registry, GList * plugins, const char *location);
 
+/* binary tracer record backend, see gsttracerbinary.c */
+#ifndef GST_DISABLE_GST_DEBUG
+typedef enum {
+  GST_TRACER_BINARY_FIELD_INT32 = 1,	/* int, uint, boolean, enum, flags */
+  GST_TRACER_BINARY_FIELD_INT64,	/* int64, uint64 */
+  GST_TRACER_BINARY_FIELD_DOUBLE,	/* float, double */
+  GST_TRACER_BINARY_FIELD_STRING,	/* string, gtype name */
+  GST_TRACER_BINARY_FIELD_POINTER,
+  GST_TRACER_BINARY_FIELD_WRAPPED	/* anything serialized as GST_WRAPPED_PTR_FORMAT */
+} GstTracerBinaryFieldKind;
+
+G_GNUC_INTERNAL
+extern gboolean _priv_gst_tracer_binary_enabled;
+
+G_GNUC_INTERNAL
+void		_priv_gst_tracer_binary_init		(void);
+
+G_GNUC_INTERNAL
+void		_priv_gst_tracer_binary_deinit		(void);
+
+G_GNUC_INTERNAL
+guint32		_priv_gst_tracer_binary_add_schema	(const gchar * format, const guint8 * kinds, guint n_kinds);
+
+G_GNUC_INTERNAL
+void		_priv_gst_tracer_binary_log		(guint32 id, const guint8 * kinds, guint n_kinds, va_list var_args);
+#else
+#define _priv_gst_tracer_binary_init()		G_STMT_START{ }G_STMT_END
+#define _priv_gst_tracer_binary_deinit()	G_STMT_START{ }G_STMT_END
+#endif
+
 
 G_GNUC_INTERNAL
 void      __gst_element_factory_add_static_pad_template (GstElementFactory    * elementfactory,
@@ -0,0 +1,553 @@
+/* GStreamer
+ *
+ * gsttracerbinary.c: binary tracer record backend
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Binary tracer record backend:
+ *
+ * When the environment variable GST_TRACER_BINARY_FILE is set, the tracer
+ * records are not formatted into the debug log. Instead each call to
+ * gst_tracer_record_log() appends a small binary event (timestamp, record id
+ * and the raw values) to a ring buffer owned by the calling thread. Only the
+ * logging thread writes to its ring and only the drain thread reads from it,
+ * so the hot path neither takes a lock nor allocates. If a ring is full, the
+ * event is dropped and counted.
+ *
+ * The drain thread periodically copies the rings to the output, which is
+ * either a file or, if the variable is set to "memfd", an anonymous memory
+ * file that stays open until the process exits.
+ *
+ * The output can be converted back to the textual log lines with
+ * gst-tracer-decode-1.0. Its layout (native byte order) is:
+ *
+ *   header: "GSTTRBIN" | guint32 version | guint32 byte order mark | guint32 pid
+ *   chunks: guint16 type | guint16 reserved | guint32 payload size | payload
+ *
+ *   SCHEMA:  guint32 id | guint32 n_fields | guint8 kinds[n_fields] | format\0
+ *   THREAD:  guint64 thread (applies to the following events)
+ *   EVENT:   guint64 ts | guint32 id | values
+ *   DROPPED: guint64 thread | guint64 number of dropped events
+ *
+ * INT32 values take 4 bytes, INT64, DOUBLE and POINTER values 8 bytes and
+ * STRING and WRAPPED values a guint32 length (G_MAXUINT32 for NULL) followed
+ * by the characters. The chunk layout must be kept in sync with
+ * tools/gst-tracer-decode.c.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gst_private.h"
+#include "gstinfo.h"
+#include "gstutils.h"
+
+#include <glib/gstdio.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HAVE_MEMFD_CREATE
+#include <sys/mman.h>
+#endif
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifndef GST_DISABLE_GST_DEBUG
+
+GST_DEBUG_CATEGORY_EXTERN (tracer_debug);
+#define GST_CAT_DEFAULT tracer_debug
+
+#define BINARY_MAGIC "GSTTRBIN"
+#define BINARY_VERSION 1
+#define BINARY_BYTE_ORDER_MARK 0x01020304
+
+enum
+{
+  CHUNK_SCHEMA = 1,
+  CHUNK_THREAD,
+  CHUNK_EVENT,
+  CHUNK_DROPPED
+};
+
+#define CHUNK_HEADER_SIZE 8
+
+/* per thread ring size, must be a power of two */
+#define RING_SIZE (512 * 1024)
+/* events bigger than this are dropped */
+#define MAX_EVENT_SIZE (RING_SIZE / 4)
+/* events up to this size are encoded without allocating */
+#define WRITER_STACK_SIZE 512
+/* interval of the drain thread */
+#define DRAIN_INTERVAL (20 * G_TIME_SPAN_MILLISECOND)
+
+typedef struct
+{
+  guint8 *data;
+  guint64 thread;
+
+  /* written by the logging thread only */
+  volatile gint head;
+  /* written by the drain thread only */
+  volatile gint tail;
+
+  volatile gint dropped;
+  gint reported_dropped;
+
+  /* protected by lock */
+  gboolean closed;
+} GstTracerBinaryRing;
+
+typedef struct
+{
+  guint8 *data;
+  gsize len;
+  gsize size;
+  guint8 stack[WRITER_STACK_SIZE];
+} GstTracerBinaryWriter;
+
+gboolean _priv_gst_tracer_binary_enabled = FALSE;
+
+/* protects the list of rings, the output and the drain thread state */
+static GMutex lock;
+static GCond cond;
+static GList *rings = NULL;
+static FILE *out = NULL;
+static gboolean out_is_memfd = FALSE;
+static guint32 last_id = 0;
+static GThread *drain_thread = NULL;
+static gboolean drain_stop = FALSE;
+static gboolean rings_orphaned = FALSE;
+
+static void ring_release (gpointer data);
+static GPrivate thread_ring = G_PRIVATE_INIT (ring_release);
+
+static void
+ring_free (GstTracerBinaryRing * ring)
+{
+  g_free (ring->data);
+  g_free (ring);
+}
+
+/* called on thread exit */
+static void
+ring_release (gpointer data)
+{
+  GstTracerBinaryRing *ring = data;
+
+  g_mutex_lock (&lock);
+  if (rings_orphaned) {
+    /* already drained and removed from the list */
+    ring_free (ring);
+  } else {
+    ring->closed = TRUE;
+  }
+  g_mutex_unlock (&lock);
+}
+
+static GstTracerBinaryRing *
+ring_get (void)
+{
+  GstTracerBinaryRing *ring = g_private_get (&thread_ring);
+
+  if (G_UNLIKELY (ring == NULL)) {
+    ring = g_new0 (GstTracerBinaryRing, 1);
+    ring->data = g_malloc (RING_SIZE);
+    ring->thread = (guint64) (guintptr) g_thread_self ();
+
+    g_mutex_lock (&lock);
+    rings = g_list_prepend (rings, ring);
+    g_mutex_unlock (&lock);
+
+    g_private_set (&thread_ring, ring);
+  }
+
+  return ring;
+}
+
+static gboolean
+ring_push (GstTracerBinaryRing * ring, const guint8 * data, guint len)
+{
+  guint head = (guint) ring->head;
+  guint tail = (guint) g_atomic_int_get (&ring->tail);
+  guint offset, part;
+
+  if (RING_SIZE - (head - tail) < len)
+    return FALSE;
+
+  offset = head & (RING_SIZE - 1);
+  part = MIN (len, RING_SIZE - offset);
+  memcpy (ring->data + offset, data, part);
+  if (part < len)
+    memcpy (ring->data, data + part, len - part);
+
+  /* publish the complete event */
+  g_atomic_int_set (&ring->head, (gint) (head + len));
+  return TRUE;
+}
+
+static inline void
+writer_init (GstTracerBinaryWriter * w)
+{
+  w->data = w->stack;
+  w->len = 0;
+  w->size = WRITER_STACK_SIZE;
+}
+
+static inline void
+writer_clear (GstTracerBinaryWriter * w)
+{
+  if (w->data != w->stack)
+    g_free (w->data);
+}
+
+static void
+writer_grow (GstTracerBinaryWriter * w, gsize len)
+{
+  gsize size = MAX (w->size * 2, w->len + len);
+
+  if (w->data == w->stack) {
+    w->data = g_malloc (size);
+    memcpy (w->data, w->stack, w->len);
+  } else {
+    w->data = g_realloc (w->data, size);
+  }
+  w->size = size;
+}
+
+static inline void
+writer_put (GstTracerBinaryWriter * w, gconstpointer data, gsize len)
+{
+  if (G_UNLIKELY (w->len + len > w->size))
+    writer_grow (w, len);
+
+  memcpy (w->data + w->len, data, len);
+  w->len += len;
+}
+
+static inline void
+writer_put_string (GstTracerBinaryWriter * w, const gchar * str)
+{
+  guint32 len = str ? strlen (str) : G_MAXUINT32;
+
+  writer_put (w, &len, sizeof (len));
+  if (str)
+    writer_put (w, str, len);
+}
+
+static void
+writer_put_chunk_header (GstTracerBinaryWriter * w, guint16 type,
+    guint32 size)
+{
+  guint16 reserved = 0;
+
+  writer_put (w, &type, sizeof (type));
+  writer_put (w, &reserved, sizeof (reserved));
+  writer_put (w, &size, sizeof (size));
+}
+
+/* update the payload size in the chunk header at the start of the writer */
+static inline void
+writer_finish_chunk (GstTracerBinaryWriter * w)
+{
+  guint32 size = w->len - CHUNK_HEADER_SIZE;
+
+  memcpy (w->data + 4, &size, sizeof (size));
+}
+
+static void
+output_write (gconstpointer data, gsize len)
+{
+  if (len && fwrite (data, 1, len, out) != len)
+    GST_WARNING ("failed to write tracer records: %s", g_strerror (errno));
+}
+
+/* must be called with the lock */
+static void
+drain_ring_unlocked (GstTracerBinaryRing * ring)
+{
+  GstTracerBinaryWriter w;
+  guint head = (guint) g_atomic_int_get (&ring->head);
+  guint tail = (guint) ring->tail;
+  gint dropped = g_atomic_int_get (&ring->dropped);
+
+  if (head != tail) {
+    guint offset = tail & (RING_SIZE - 1);
+    guint len = head - tail;
+    guint part = MIN (len, RING_SIZE - offset);
+
+    writer_init (&w);
+    writer_put_chunk_header (&w, CHUNK_THREAD, sizeof (guint64));
+    writer_put (&w, &ring->thread, sizeof (guint64));
+    output_write (w.data, w.len);
+    writer_clear (&w);
+
+    output_write (ring->data + offset, part);
+    if (part < len)
+      output_write (ring->data, len - part);
+
+    g_atomic_int_set (&ring->tail, (gint) head);
+  }
+
+  if (dropped != ring->reported_dropped) {
+    guint64 count = (guint) (dropped - ring->reported_dropped);
+
+    GST_WARNING ("dropped %" G_GUINT64_FORMAT " tracer records of thread %p",
+        count, (gpointer) (guintptr) ring->thread);
+
+    writer_init (&w);
+    writer_put_chunk_header (&w, CHUNK_DROPPED, 2 * sizeof (guint64));
+    writer_put (&w, &ring->thread, sizeof (guint64));
+    writer_put (&w, &count, sizeof (guint64));
+    output_write (w.data, w.len);
+    writer_clear (&w);
+
+    ring->reported_dropped = dropped;
+  }
+}
+
+/* must be called with the lock */
+static void
+drain_unlocked (void)
+{
+  GList *node = rings;
+
+  while (node) {
+    GList *next = g_list_next (node);
+    GstTracerBinaryRing *ring = node->data;
+
+    drain_ring_unlocked (ring);
+    if (ring->closed) {
+      rings = g_list_delete_link (rings, node);
+      ring_free (ring);
+    }
+    node = next;
+  }
+
+  fflush (out);
+}
+
+static gpointer
+drain_thread_func (gpointer user_data)
+{
+  g_mutex_lock (&lock);
+  while (!drain_stop) {
+    gint64 end_time = g_get_monotonic_time () + DRAIN_INTERVAL;
+
+    g_cond_wait_until (&cond, &lock, end_time);
+    drain_unlocked ();
+  }
+  g_mutex_unlock (&lock);
+
+  return NULL;
+}
+
+static FILE *
+output_open (const gchar * location)
+{
+  FILE *f = NULL;
+
+  if (!strcmp (location, "memfd")) {
+#ifdef HAVE_MEMFD_CREATE
+    gint fd = memfd_create ("gst-tracer", MFD_CLOEXEC);
+
+    if (fd < 0) {
+      GST_WARNING ("failed to create memfd: %s", g_strerror (errno));
+      return NULL;
+    }
+    if (!(f = fdopen (fd, "wb"))) {
+      close (fd);
+      return NULL;
+    }
+    out_is_memfd = TRUE;
+    GST_INFO ("writing tracer records to /proc/%d/fd/%d", (gint) getpid (),
+        fd);
+#else
+    GST_WARNING ("memfd is not supported on this platform");
+#endif
+  } else if (!(f = g_fopen (location, "wb"))) {
+    GST_WARNING ("failed to open '%s': %s", location, g_strerror (errno));
+  }
+
+  return f;
+}
+
+/* Initialize the binary backend, before any tracer is instantiated */
+void
+_priv_gst_tracer_binary_init (void)
+{
+  const gchar *env = g_getenv ("GST_TRACER_BINARY_FILE");
+  guint32 version = BINARY_VERSION;
+  guint32 bom = BINARY_BYTE_ORDER_MARK;
+  guint32 pid = 0;
+
+  if (env == NULL || *env == '\0')
+    return;
+
+  if (!(out = output_open (env)))
+    return;
+
+  /* the rings are drained in large blocks */
+  setvbuf (out, NULL, _IOFBF, 64 * 1024);
+
+#ifdef HAVE_GETPID
+  pid = (guint32) getpid ();
+#endif
+  output_write (BINARY_MAGIC, strlen (BINARY_MAGIC));
+  output_write (&version, sizeof (version));
+  output_write (&bom, sizeof (bom));
+  output_write (&pid, sizeof (pid));
+
+  drain_stop = FALSE;
+  rings_orphaned = FALSE;
+  drain_thread = g_thread_new ("gst-tracer-drain", drain_thread_func, NULL);
+
+  GST_INFO ("writing binary tracer records to '%s'", env);
+  _priv_gst_tracer_binary_enabled = TRUE;
+}
+
+/* Flush all pending events and stop the drain thread */
+void
+_priv_gst_tracer_binary_deinit (void)
+{
+  if (!_priv_gst_tracer_binary_enabled)
+    return;
+
+  _priv_gst_tracer_binary_enabled = FALSE;
+
+  g_mutex_lock (&lock);
+  drain_stop = TRUE;
+  g_cond_signal (&cond);
+  g_mutex_unlock (&lock);
+  g_thread_join (drain_thread);
+  drain_thread = NULL;
+
+  g_mutex_lock (&lock);
+  drain_unlocked ();
+  /* the remaining rings belong to threads that are still alive, they are
+   * freed on thread exit */
+  g_list_free (rings);
+  rings = NULL;
+  rings_orphaned = TRUE;
+
+  /* keep a memfd open, otherwise the data would be lost */
+  if (!out_is_memfd)
+    fclose (out);
+  out = NULL;
+  g_mutex_unlock (&lock);
+}
+
+/* Announce a record layout, returns the id used by its events */
+guint32
+_priv_gst_tracer_binary_add_schema (const gchar * format, const guint8 * kinds,
+    guint n_kinds)
+{
+  GstTracerBinaryWriter w;
+  guint32 id, n = n_kinds;
+
+  writer_init (&w);
+
+  g_mutex_lock (&lock);
+  id = ++last_id;
+
+  writer_put_chunk_header (&w, CHUNK_SCHEMA, 0);
+  writer_put (&w, &id, sizeof (id));
+  writer_put (&w, &n, sizeof (n));
+  writer_put (&w, kinds, n_kinds);
+  writer_put (&w, format, strlen (format) + 1);
+  writer_finish_chunk (&w);
+
+  /* written directly, so that it precedes all events of the record */
+  if (out)
+    output_write (w.data, w.len);
+  g_mutex_unlock (&lock);
+
+  writer_clear (&w);
+  return id;
+}
+
+/* Serialize an event into the ring of the calling thread */
+void
+_priv_gst_tracer_binary_log (guint32 id, const guint8 * kinds, guint n_kinds,
+    va_list var_args)
+{
+  GstTracerBinaryRing *ring = ring_get ();
+  GstTracerBinaryWriter w;
+  guint64 ts = GST_CLOCK_DIFF (_priv_gst_start_time, gst_util_get_timestamp ());
+  guint i;
+
+  writer_init (&w);
+  writer_put_chunk_header (&w, CHUNK_EVENT, 0);
+  writer_put (&w, &ts, sizeof (ts));
+  writer_put (&w, &id, sizeof (id));
+
+  for (i = 0; i < n_kinds; i++) {
+    switch (kinds[i]) {
+      case GST_TRACER_BINARY_FIELD_INT32:{
+        guint32 v = va_arg (var_args, guint);
+
+        writer_put (&w, &v, sizeof (v));
+        break;
+      }
+      case GST_TRACER_BINARY_FIELD_INT64:{
+        guint64 v = va_arg (var_args, guint64);
+
+        writer_put (&w, &v, sizeof (v));
+        break;
+      }
+      case GST_TRACER_BINARY_FIELD_DOUBLE:{
+        gdouble v = va_arg (var_args, gdouble);
+
+        writer_put (&w, &v, sizeof (v));
+        break;
+      }
+      case GST_TRACER_BINARY_FIELD_STRING:
+        writer_put_string (&w, va_arg (var_args, const gchar *));
+        break;
+      case GST_TRACER_BINARY_FIELD_POINTER:{
+        guint64 v = (guint64) (guintptr) va_arg (var_args, gpointer);
+
+        writer_put (&w, &v, sizeof (v));
+        break;
+      }
+      case GST_TRACER_BINARY_FIELD_WRAPPED:{
+        /* rare, e.g. caps or structures, use the same serialization as the
+         * debug log */
+        gchar *str = gst_info_strdup_printf ("%" GST_WRAPPED_PTR_FORMAT,
+            va_arg (var_args, gpointer));
+
+        writer_put_string (&w, str);
+        g_free (str);
+        break;
+      }
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+  }
+  writer_finish_chunk (&w);
+
+  if (w.len > MAX_EVENT_SIZE || !ring_push (ring, w.data, w.len))
+    g_atomic_int_inc (&ring->dropped);
+
+  writer_clear (&w);
+}
+
+#endif /* GST_DISABLE_GST_DEBUG */
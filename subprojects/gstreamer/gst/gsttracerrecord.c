@@ -47,6 +47,10 @@ struct _GstTracerRecord
 
   GstStructure *spec;
   gchar *format;
+
+  /* binary backend: record id and the kind of each logged value */
+  guint32 binary_id;
+  GByteArray *kinds;
 };
 
 struct _GstTracerRecordClass
@@ -57,10 +61,45 @@ struct _GstTracerRecordClass
 #define gst_tracer_record_parent_class parent_class
 G_DEFINE_TYPE (GstTracerRecord, gst_tracer_record, GST_TYPE_OBJECT);
 
+typedef struct
+{
+  GString *s;
+  GByteArray *kinds;
+} GstTracerRecordTemplate;
+
+#ifndef GST_DISABLE_GST_DEBUG
+/* must match the printf conversions chosen by
+ * priv__gst_structure_append_template_to_gstring() */
+static void
+append_binary_kind (GByteArray * kinds, GType type)
+{
+  guint8 kind;
+
+  if (type == G_TYPE_INT || type == G_TYPE_UINT || type == G_TYPE_BOOLEAN
+      || g_type_is_a (type, G_TYPE_ENUM) || g_type_is_a (type, G_TYPE_FLAGS)) {
+    kind = GST_TRACER_BINARY_FIELD_INT32;
+  } else if (type == G_TYPE_INT64 || type == G_TYPE_UINT64) {
+    kind = GST_TRACER_BINARY_FIELD_INT64;
+  } else if (type == G_TYPE_FLOAT || type == G_TYPE_DOUBLE) {
+    kind = GST_TRACER_BINARY_FIELD_DOUBLE;
+  } else if (type == G_TYPE_STRING || type == G_TYPE_GTYPE) {
+    kind = GST_TRACER_BINARY_FIELD_STRING;
+  } else if (type == G_TYPE_POINTER) {
+    kind = GST_TRACER_BINARY_FIELD_POINTER;
+  } else {
+    kind = GST_TRACER_BINARY_FIELD_WRAPPED;
+  }
+  g_byte_array_append (kinds, &kind, 1);
+}
+#else
+#define append_binary_kind(kinds, type)
+#endif
+
 static gboolean
 build_field_template (GQuark field_id, const GValue * value, gpointer user_data)
 {
-  GString *s = (GString *) user_data;
+  GstTracerRecordTemplate *t = (GstTracerRecordTemplate *) user_data;
+  GString *s = t->s;
   const GstStructure *sub;
   GValue template_value = { 0, };
   GType type = G_TYPE_INVALID;
@@ -86,12 +125,14 @@ build_field_template (GQuark field_id, const GValue * value, gpointer user_data)
         (opt_name), &template_value, s);
     g_value_unset (&template_value);
     g_free (opt_name);
+    append_binary_kind (t->kinds, G_TYPE_BOOLEAN);
   }
 
   g_value_init (&template_value, type);
   res = priv__gst_structure_append_template_to_gstring (field_id,
       &template_value, s);
   g_value_unset (&template_value);
+  append_binary_kind (t->kinds, type);
   return res;
 }
 
@@ -99,6 +140,7 @@ static void
 gst_tracer_record_build_format (GstTracerRecord * self)
 {
   GstStructure *structure = self->spec;
+  GstTracerRecordTemplate t;
   GString *s;
   gchar *name = (gchar *) g_quark_to_string (structure->name);
   gchar *p;
@@ -116,12 +158,21 @@ gst_tracer_record_build_format (GstTracerRecord * self)
 
   s = g_string_sized_new (STRUCTURE_ESTIMATED_STRING_LEN (structure));
   g_string_append (s, name);
-  gst_structure_foreach (structure, build_field_template, s);
+  t.s = s;
+  t.kinds = self->kinds;
+  gst_structure_foreach (structure, build_field_template, &t);
   g_string_append_c (s, ';');
 
   self->format = g_string_free (s, FALSE);
   GST_DEBUG ("new format string: %s", self->format);
   g_free (name);
+
+#ifndef GST_DISABLE_GST_DEBUG
+  if (_priv_gst_tracer_binary_enabled) {
+    self->binary_id = _priv_gst_tracer_binary_add_schema (self->format,
+        self->kinds->data, self->kinds->len);
+  }
+#endif
 }
 
 static void
@@ -135,6 +186,10 @@ gst_tracer_record_dispose (GObject * object)
   }
   g_free (self->format);
   self->format = NULL;
+  if (self->kinds) {
+    g_byte_array_unref (self->kinds);
+    self->kinds = NULL;
+  }
 }
 
 static void
@@ -148,6 +203,7 @@ gst_tracer_record_class_init (GstTracerRecordClass * klass)
 static void
 gst_tracer_record_init (GstTracerRecord * self)
 {
+  self->kinds = g_byte_array_new ();
 }
 
 /**
@@ -245,7 +301,10 @@ gst_tracer_record_new (const gchar * name, const gchar * firstfield, ...)
  * Serialzes the trace event into the log.
  *
  * Right now this is using the gstreamer debug log with the level TRACE (7) and
- * the category "GST_TRACER".
+ * the category "GST_TRACER". If the environment variable
+ * `GST_TRACER_BINARY_FILE` was set when GStreamer was initialized, the values
+ * are instead written unformatted to a binary file that can be turned into
+ * the same log lines with gst-tracer-decode-1.0.
  *
  * > Please note that this is still under discussion and subject to change.
  *
@@ -268,6 +327,14 @@ gst_tracer_record_log (GstTracerRecord * self, ...)
    * gst_debug_log_default() will pick
    */
 
+  if (_priv_gst_tracer_binary_enabled && self->binary_id) {
+    va_start (var_args, self);
+    _priv_gst_tracer_binary_log (self->binary_id, self->kinds->data,
+        self->kinds->len, var_args);
+    va_end (var_args);
+    return;
+  }
+
   va_start (var_args, self);
   if (G_LIKELY (GST_LEVEL_TRACE <= _gst_debug_min)) {
     gst_debug_log_valist (GST_CAT_DEFAULT, GST_LEVEL_TRACE, "", "", 0, NULL,
@@ -27,6 +27,10 @@
  * The user can activate tracers by setting the environment variable GST_TRACE
  * to a ';' separated list of tracers.
  *
+ * The tracer records are logged to the debug log, unless the environment
+ * variable GST_TRACER_BINARY_FILE selects the binary backend (see
+ * gsttracerbinary.c).
+ *
  * Note that instantiating tracers at runtime is possible but is not thread safe
  * and needs to be done before any pipeline state is set to PAUSED.
  */
@@ -86,6 +90,9 @@ _priv_gst_tracing_init (void)
         g_quark_from_static_string (_quark_strings[i]);
   }
 
+  /* must be ready before the tracers create their records */
+  _priv_gst_tracer_binary_init ();
+
   if (env != NULL && *env != '\0') {
     GstRegistry *registry = gst_registry_get ();
     GstPluginFeature *feature;
@@ -160,6 +167,9 @@ _priv_gst_tracing_deinit (void)
   g_list_free (h_list);
   g_hash_table_destroy (_priv_tracers);
   _priv_tracers = NULL;
+
+  /* write out what the tracers logged in their final reports */
+  _priv_gst_tracer_binary_deinit ();
 }
 
 static void
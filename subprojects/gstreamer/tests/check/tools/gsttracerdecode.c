@@ -0,0 +1,237 @@
+/* GStreamer gst-tracer-decode unit test
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <gst/check/gstcheck.h>
+#include <gst/gsttracerrecord.h>
+#include <glib/gstdio.h>
+
+static int gst_tracer_decode_main (int argc, char **argv);
+
+#define main gst_tracer_decode_main
+#include "../../tools/gst-tracer-decode.c"
+#undef main
+
+static gchar *binary_file = NULL;
+
+/* the text backend formats the record with the debug printf */
+static gchar *
+format_record (const gchar * format, ...)
+{
+  va_list var_args;
+  gchar *res;
+
+  va_start (var_args, format);
+  res = gst_info_strdup_vprintf (format, var_args);
+  va_end (var_args);
+
+  return res;
+}
+
+static const gchar *
+find_record_format (const gchar * name)
+{
+  GHashTableIter iter;
+  RecordSchema *schema;
+
+  g_hash_table_iter_init (&iter, schemas);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) & schema)) {
+    if (g_str_has_prefix (schema->format, name))
+      return schema->format;
+  }
+
+  return NULL;
+}
+
+/* decodes the binary file into log lines, waits for the drain thread */
+static gchar **
+decode_lines (guint n_lines)
+{
+  gchar **lines = NULL;
+  guint i;
+
+  for (i = 0; i < 250 && lines == NULL; i++) {
+    FILE *f = tmpfile ();
+    gboolean res;
+
+    fail_unless (f != NULL);
+
+    num_events = 0;
+    res = decode (binary_file, f);
+    if (res && num_events == n_lines) {
+      gchar *contents;
+      glong size;
+
+      size = ftell (f);
+      contents = g_malloc0 (size + 1);
+      rewind (f);
+      fail_unless_equals_int (fread (contents, 1, size, f), size);
+
+      lines = g_strsplit (contents, "\n", -1);
+      g_free (contents);
+    } else {
+      g_usleep (20 * G_USEC_PER_SEC / 1000);
+    }
+    fclose (f);
+  }
+
+  return lines;
+}
+
+GST_START_TEST (test_decode_same_as_text)
+{
+  GstTracerRecord *tr;
+  GstStructure *info;
+  const gchar *format;
+  gchar **lines;
+  gchar *expected[2];
+  guint i;
+
+  /* *INDENT-OFF* */
+  tr = gst_tracer_record_new ("binary-test.class",
+      "string", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_STRING,
+          NULL),
+      "int", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_INT,
+          NULL),
+      "uint", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_UINT,
+          NULL),
+      "bool", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_BOOLEAN,
+          NULL),
+      "enum", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, GST_TYPE_PAD_DIRECTION,
+          NULL),
+      "ts", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+          NULL),
+      "delta", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_INT64,
+          NULL),
+      "load", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, G_TYPE_DOUBLE,
+          NULL),
+      "info", GST_TYPE_STRUCTURE, gst_structure_new ("value",
+          "type", G_TYPE_GTYPE, GST_TYPE_STRUCTURE,
+          NULL),
+      NULL);
+  /* *INDENT-ON* */
+
+  info = gst_structure_new ("info", "name", G_TYPE_STRING, "src", NULL);
+  schemas = g_hash_table_new_full (NULL, NULL, NULL,
+      (GDestroyNotify) free_schema);
+
+  gst_tracer_record_log (tr, "test", -5, 7u, TRUE, GST_PAD_SRC,
+      G_GUINT64_CONSTANT (1234567890123), G_GINT64_CONSTANT (-42), 0.25, info);
+  gst_tracer_record_log (tr, NULL, G_MAXINT, G_MAXUINT, FALSE, GST_PAD_SINK,
+      G_MAXUINT64, G_MININT64, -1.5, info);
+
+  lines = decode_lines (2);
+  fail_unless (lines != NULL, "records were not written to %s", binary_file);
+
+  format = find_record_format ("binary-test");
+  fail_unless (format != NULL);
+
+  expected[0] = format_record (format, "test", -5, 7u, TRUE, GST_PAD_SRC,
+      G_GUINT64_CONSTANT (1234567890123), G_GINT64_CONSTANT (-42), 0.25, info);
+  expected[1] = format_record (format, NULL, G_MAXINT, G_MAXUINT, FALSE,
+      GST_PAD_SINK, G_MAXUINT64, G_MININT64, -1.5, info);
+
+  for (i = 0; i < 2; i++) {
+    const gchar *msg;
+
+    GST_INFO ("decoded '%s'", lines[i]);
+    fail_unless (strstr (lines[i], " GST_TRACER :0:: ") != NULL);
+
+    msg = strstr (lines[i], ":0:: ") + 5;
+    fail_unless_equals_string (msg, expected[i]);
+    g_free (expected[i]);
+  }
+
+  g_strfreev (lines);
+  g_hash_table_destroy (schemas);
+  gst_structure_free (info);
+  gst_object_unref (tr);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_decode_invalid_file)
+{
+  gchar *filename;
+  gint fd;
+
+  fd = g_file_open_tmp ("gst-tracer-decode-XXXXXX", &filename, NULL);
+  fail_unless (fd >= 0);
+  g_close (fd, NULL);
+  fail_unless (g_file_set_contents (filename, "GSTTRBIX", 8, NULL));
+
+  {
+    const gchar *argv[] = { "gst-tracer-decode-1.0", filename, NULL };
+
+    fail_unless_equals_int (gst_tracer_decode_main (2, (gchar **) argv), 1);
+  }
+
+  g_unlink (filename);
+  g_free (filename);
+}
+
+GST_END_TEST;
+
+static Suite *
+gst_tracer_decode_suite (void)
+{
+  Suite *s = suite_create ("gst-tracer-decode");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_decode_same_as_text);
+  tcase_add_test (tc_chain, test_decode_invalid_file);
+
+  return s;
+}
+
+/* Replacement for GST_CHECK_MAIN (gst_tracer_decode); because we need to set
+ * the env before gst_init() is called */
+int
+main (int argc, char **argv)
+{
+  Suite *s;
+  gint fd, res;
+
+  fd = g_file_open_tmp ("gst-tracer-binary-XXXXXX", &binary_file, NULL);
+  if (fd < 0)
+    return 1;
+  g_close (fd, NULL);
+
+  g_setenv ("GST_TRACER_BINARY_FILE", binary_file, TRUE);
+  /* the drain thread does not exist in a forked test */
+  g_setenv ("CK_FORK", "no", TRUE);
+
+  gst_check_init (&argc, &argv);
+
+  s = gst_tracer_decode_suite ();
+  res = gst_check_run_suite (s, "gst_tracer_decode", __FILE__);
+
+  g_unlink (binary_file);
+  g_free (binary_file);
+
+  return res;
+}
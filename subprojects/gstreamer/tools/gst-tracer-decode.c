@@ -0,0 +1,427 @@
+/* GStreamer
+ *
+ * gst-tracer-decode.c: convert binary tracer records to log lines
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Reads the output of the binary tracer backend (GST_TRACER_BINARY_FILE) and
+ * prints the records as debug log lines, so that they can be analysed with
+ * gst-stats-1.0 or any other tool consuming GST_TRACER log lines.
+ *
+ * The file layout is described in gst/gsttracerbinary.c.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tools.h"
+
+/* must match gst/gsttracerbinary.c */
+#define BINARY_MAGIC "GSTTRBIN"
+#define BINARY_VERSION 1
+#define BINARY_BYTE_ORDER_MARK 0x01020304
+#define BINARY_HEADER_SIZE 20
+#define CHUNK_HEADER_SIZE 8
+
+enum
+{
+  CHUNK_SCHEMA = 1,
+  CHUNK_THREAD,
+  CHUNK_EVENT,
+  CHUNK_DROPPED
+};
+
+enum
+{
+  FIELD_INT32 = 1,
+  FIELD_INT64,
+  FIELD_DOUBLE,
+  FIELD_STRING,
+  FIELD_POINTER,
+  FIELD_WRAPPED
+};
+
+typedef struct
+{
+  gchar *format;
+  guint8 *kinds;
+  guint n_kinds;
+} RecordSchema;
+
+typedef struct
+{
+  const guint8 *pos;
+  const guint8 *end;
+} Reader;
+
+static GHashTable *schemas = NULL;
+static guint32 pid = 0;
+static guint64 thread = 0;
+static guint64 num_events = 0;
+static guint64 num_dropped = 0;
+
+static void
+free_schema (RecordSchema * schema)
+{
+  g_free (schema->format);
+  g_free (schema->kinds);
+  g_free (schema);
+}
+
+static gboolean
+read_bytes (Reader * r, gpointer dest, gsize len)
+{
+  if ((gsize) (r->end - r->pos) < len)
+    return FALSE;
+  memcpy (dest, r->pos, len);
+  r->pos += len;
+  return TRUE;
+}
+
+/* appends the string value or "(null)", as printf would do */
+static gboolean
+read_string (Reader * r, GString * line)
+{
+  guint32 len;
+
+  if (!read_bytes (r, &len, sizeof (len)))
+    return FALSE;
+  if (len == G_MAXUINT32) {
+    g_string_append (line, "(null)");
+    return TRUE;
+  }
+  if ((gsize) (r->end - r->pos) < len)
+    return FALSE;
+  g_string_append_len (line, (const gchar *) r->pos, len);
+  r->pos += len;
+  return TRUE;
+}
+
+/* skip the printf conversion at fmt (after the '%'), return its conversion
+ * character */
+static gchar
+skip_conversion (const gchar ** fmt)
+{
+  const gchar *p = *fmt;
+  gchar conv;
+
+  while (*p && strchr ("-+ #0123456789.hlLqjzt", *p))
+    p++;
+  conv = *p;
+  if (conv)
+    p++;
+  /* GStreamer pointer extensions, e.g. GST_WRAPPED_PTR_FORMAT */
+  if (conv == 'p' && p[0] == '\a' && p[1])
+    p += 2;
+
+  *fmt = p;
+  return conv;
+}
+
+static gboolean
+render_event (RecordSchema * schema, Reader * r, GString * line)
+{
+  const gchar *fmt = schema->format;
+  guint i = 0;
+
+  while (*fmt) {
+    gchar conv;
+
+    if (*fmt != '%') {
+      g_string_append_c (line, *fmt++);
+      continue;
+    }
+    fmt++;
+    if (*fmt == '%') {
+      g_string_append_c (line, *fmt++);
+      continue;
+    }
+    conv = skip_conversion (&fmt);
+    if (i >= schema->n_kinds)
+      return FALSE;
+
+    switch (schema->kinds[i++]) {
+      case FIELD_INT32:{
+        guint32 v;
+
+        if (!read_bytes (r, &v, sizeof (v)))
+          return FALSE;
+        if (conv == 'u')
+          g_string_append_printf (line, "%u", v);
+        else
+          g_string_append_printf (line, "%i", (gint32) v);
+        break;
+      }
+      case FIELD_INT64:{
+        guint64 v;
+
+        if (!read_bytes (r, &v, sizeof (v)))
+          return FALSE;
+        if (conv == 'u')
+          g_string_append_printf (line, "%" G_GUINT64_FORMAT, v);
+        else
+          g_string_append_printf (line, "%" G_GINT64_FORMAT, (gint64) v);
+        break;
+      }
+      case FIELD_DOUBLE:{
+        gdouble v;
+
+        if (!read_bytes (r, &v, sizeof (v)))
+          return FALSE;
+        g_string_append_printf (line, "%f", v);
+        break;
+      }
+      case FIELD_POINTER:{
+        guint64 v;
+
+        if (!read_bytes (r, &v, sizeof (v)))
+          return FALSE;
+        g_string_append_printf (line, "%p", (gpointer) (guintptr) v);
+        break;
+      }
+      case FIELD_STRING:
+      case FIELD_WRAPPED:
+        if (!read_string (r, line))
+          return FALSE;
+        break;
+      default:
+        return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static gboolean
+decode_schema (Reader * r)
+{
+  RecordSchema *schema;
+  guint32 id, n_kinds;
+  const guint8 *nul;
+
+  if (!read_bytes (r, &id, sizeof (id)) ||
+      !read_bytes (r, &n_kinds, sizeof (n_kinds)) ||
+      (gsize) (r->end - r->pos) < n_kinds)
+    return FALSE;
+
+  schema = g_new0 (RecordSchema, 1);
+  schema->n_kinds = n_kinds;
+  schema->kinds = g_malloc (n_kinds);
+  memcpy (schema->kinds, r->pos, n_kinds);
+  r->pos += n_kinds;
+
+  nul = memchr (r->pos, '\0', r->end - r->pos);
+  if (!nul) {
+    free_schema (schema);
+    return FALSE;
+  }
+  schema->format = g_strdup ((const gchar *) r->pos);
+  r->pos = nul + 1;
+
+  g_hash_table_replace (schemas, GUINT_TO_POINTER (id), schema);
+  return TRUE;
+}
+
+static gboolean
+decode_event (Reader * r, GString * line, FILE * out)
+{
+  RecordSchema *schema;
+  guint64 ts;
+  guint32 id;
+
+  if (!read_bytes (r, &ts, sizeof (ts)) || !read_bytes (r, &id, sizeof (id)))
+    return FALSE;
+
+  if (!(schema = g_hash_table_lookup (schemas, GUINT_TO_POINTER (id)))) {
+    g_printerr ("unknown record id %u\n", id);
+    return FALSE;
+  }
+
+  /* same layout as the default debug log function */
+  g_string_printf (line, "%" GST_TIME_FORMAT " %5u 0x%" G_GINT64_MODIFIER
+      "x TRACE %20s :0:: ", GST_TIME_ARGS (ts), pid, thread, "GST_TRACER");
+  if (!render_event (schema, r, line))
+    return FALSE;
+
+  g_string_append_c (line, '\n');
+  fputs (line->str, out);
+  num_events++;
+  return TRUE;
+}
+
+/* decodes the file and writes the log lines to out */
+static gboolean
+decode (const gchar * filename, FILE * out)
+{
+  gchar *data;
+  gsize size;
+  GError *err = NULL;
+  GString *line;
+  Reader r;
+  guint32 version, bom;
+  gboolean res = TRUE;
+
+  if (!g_file_get_contents (filename, &data, &size, &err)) {
+    g_printerr ("failed to read '%s': %s\n", filename, err->message);
+    g_clear_error (&err);
+    return FALSE;
+  }
+
+  r.pos = (const guint8 *) data;
+  r.end = r.pos + size;
+
+  if (size < BINARY_HEADER_SIZE || memcmp (data, BINARY_MAGIC, 8)) {
+    g_printerr ("'%s' is not a binary tracer file\n", filename);
+    g_free (data);
+    return FALSE;
+  }
+  r.pos += 8;
+  read_bytes (&r, &version, sizeof (version));
+  read_bytes (&r, &bom, sizeof (bom));
+  read_bytes (&r, &pid, sizeof (pid));
+
+  if (bom != BINARY_BYTE_ORDER_MARK) {
+    g_printerr ("'%s' was written on a machine with a different byte order\n",
+        filename);
+    g_free (data);
+    return FALSE;
+  }
+  if (version != BINARY_VERSION) {
+    g_printerr ("unsupported version %u\n", version);
+    g_free (data);
+    return FALSE;
+  }
+
+  line = g_string_sized_new (256);
+  while (r.pos < r.end) {
+    guint16 type, reserved;
+    guint32 payload_size;
+    Reader chunk;
+
+    if (!read_bytes (&r, &type, sizeof (type)) ||
+        !read_bytes (&r, &reserved, sizeof (reserved)) ||
+        !read_bytes (&r, &payload_size, sizeof (payload_size)) ||
+        (gsize) (r.end - r.pos) < payload_size) {
+      /* e.g. the process was killed while writing */
+      g_printerr ("truncated chunk at offset %" G_GSIZE_FORMAT "\n",
+          (gsize) (r.pos - (const guint8 *) data));
+      res = FALSE;
+      break;
+    }
+    chunk.pos = r.pos;
+    chunk.end = r.pos + payload_size;
+    r.pos = chunk.end;
+
+    switch (type) {
+      case CHUNK_SCHEMA:
+        res = decode_schema (&chunk);
+        break;
+      case CHUNK_THREAD:
+        res = read_bytes (&chunk, &thread, sizeof (thread));
+        break;
+      case CHUNK_EVENT:
+        res = decode_event (&chunk, line, out);
+        break;
+      case CHUNK_DROPPED:{
+        guint64 dropped_thread, count;
+
+        res = read_bytes (&chunk, &dropped_thread, sizeof (dropped_thread)) &&
+            read_bytes (&chunk, &count, sizeof (count));
+        if (res)
+          num_dropped += count;
+        break;
+      }
+      default:
+        /* skip unknown chunks */
+        break;
+    }
+
+    if (!res) {
+      g_printerr ("malformed chunk of type %u\n", type);
+      break;
+    }
+  }
+
+  g_string_free (line, TRUE);
+  g_free (data);
+  return res;
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  gchar **filenames = NULL;
+  guint num;
+  GError *err = NULL;
+  GOptionContext *ctx;
+  gboolean res;
+  GOptionEntry options[] = {
+    GST_TOOLS_GOPTION_VERSION,
+    {G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &filenames, NULL}
+    ,
+    {NULL}
+  };
+
+#ifdef ENABLE_NLS
+  bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
+  bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
+  textdomain (GETTEXT_PACKAGE);
+#endif
+
+  g_set_prgname ("gst-tracer-decode-" GST_API_VERSION);
+
+  ctx = g_option_context_new ("FILE");
+  g_option_context_add_main_entries (ctx, options, GETTEXT_PACKAGE);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    exit (1);
+  }
+  g_option_context_free (ctx);
+
+  gst_tools_print_version ();
+
+  if (filenames == NULL || *filenames == NULL) {
+    g_print ("Please give one filename to %s\n\n", g_get_prgname ());
+    return 1;
+  }
+  num = g_strv_length (filenames);
+  if (num == 0 || num > 1) {
+    g_print ("Please give exactly one filename to %s (%d given).\n\n",
+        g_get_prgname (), num);
+    return 1;
+  }
+
+  schemas = g_hash_table_new_full (NULL, NULL, NULL,
+      (GDestroyNotify) free_schema);
+
+  res = decode (filenames[0], stdout);
+  if (num_dropped) {
+    g_printerr ("%" G_GUINT64_FORMAT " records were dropped while tracing\n",
+        num_dropped);
+  }
+  g_printerr ("decoded %" G_GUINT64_FORMAT " records\n", num_events);
+
+  g_hash_table_destroy (schemas);
+  g_strfreev (filenames);
+  return res ? 0 : 1;
+}
@@ -55,6 +55,9 @@ typedef struct {
   gboolean is_server;
   gboolean is_blocking;
 
+  guint num_streams;  /* the number of concurrent streams (async client) */
+  guint max_buffers;  /* the maximum number of queued buffers (0: unlimited) */
+
   grpc_cb cb;
   void *cb_data;
 
@@ -77,8 +80,21 @@ enum
   PROP_HOST,
   PROP_PORT,
   PROP_OUT,
+  PROP_STREAMS,
+  PROP_MAX_BUFFERS,
 };
 
+/**
+ * @brief Default and maximum number of concurrent gRPC streams
+ */
+#define DEFAULT_PROP_STREAMS  1
+#define MAX_PROP_STREAMS      16
+
+/**
+ * @brief Default maximum number of buffers queued to be sent (0: unlimited)
+ */
+#define DEFAULT_PROP_MAX_BUFFERS  0
+
 /**
  * @brief C++ wrappers for gRPC per-IDL codes
  */
@@ -25,6 +25,9 @@
 #define NNS_GRPC_FLATBUF_NAME    "libnnstreamer_grpc_flatbuf.so"
 #define NNS_GRPC_CREATE_INSTANCE "create_instance"
 
+/** @brief max time to wait for the queued buffers to be sent when stopping */
+#define NNS_GRPC_DRAIN_TIMEOUT   (G_USEC_PER_SEC)
+
 using namespace grpc;
 
 /** @brief create new instance of NNStreamerRPC */
@@ -74,12 +77,13 @@ NNStreamerRPC::createInstance (const grpc_config * config)
 NNStreamerRPC::NNStreamerRPC (const grpc_config * config):
   host_ (config->host), port_ (config->port),
   is_server_ (config->is_server), is_blocking_ (config->is_blocking),
-  direction_ (config->dir), cb_ (config->cb), cb_data_ (config->cb_data),
+  num_streams_ (MAX (config->num_streams, 1)),
+  max_buffers_ (config->max_buffers), direction_ (config->dir), cb_ (config->cb), cb_data_ (config->cb_data),
   config_ (config->config), server_instance_ (nullptr), handle_ (nullptr),
   stop_ (false)
 {
   queue_ = gst_data_queue_new (_data_queue_check_full_cb,
-      NULL, NULL, NULL);
+      NULL, NULL, this);
 }
 
 /** @brief destructor of NNStreamerRPC */
@@ -93,6 +97,10 @@ NNStreamerRPC::start () {
   if (direction_ == GRPC_DIRECTION_NONE)
     return FALSE;
 
+  if (num_streams_ > 1 && (is_server_ || is_blocking_))
+    ml_logw ("The streams property is valid only for a non-blocking client, "
+        "a single stream is used.");
+
   if (is_server_)
     return _start_server ();
   else
@@ -109,10 +117,19 @@ NNStreamerRPC::stop () {
   stop_ = true;
 
   if (queue_) {
-    /* wait until the queue's flushed */
-    while (!gst_data_queue_is_empty (queue_))
+    gint64 end_time = g_get_monotonic_time () + NNS_GRPC_DRAIN_TIMEOUT;
+
+    /**
+     * give the worker a chance to send the queued buffers, but do not wait
+     * forever if the peer is gone. flushing also wakes up a blocked send ().
+     */
+    while (!gst_data_queue_is_empty (queue_) &&
+        g_get_monotonic_time () < end_time)
       g_usleep (G_USEC_PER_SEC / 100);
 
+    if (!gst_data_queue_is_empty (queue_))
+      ml_logw ("Failed to send the queued buffers before stopping.");
+
     gst_data_queue_set_flushing (queue_, TRUE);
   }
 
@@ -149,6 +166,23 @@ NNStreamerRPC::send (GstBuffer *buffer) {
   return TRUE;
 }
 
+/**
+ * @brief create a gRPC channel for the given stream
+ * @note Each stream gets its own subchannel pool and thus its own connection,
+ *       so that concurrent streams are not multiplexed over a single socket.
+ */
+std::shared_ptr<Channel>
+NNStreamerRPC::create_channel (std::string address, guint stream)
+{
+  ChannelArguments args;
+
+  if (stream > 0)
+    args.SetInt (GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+
+  return grpc::CreateCustomChannel (address,
+      grpc::InsecureChannelCredentials (), args);
+}
+
 /** @brief start server service */
 gboolean
 NNStreamerRPC::_start_server () {
@@ -171,13 +205,21 @@ NNStreamerRPC::_start_client () {
   return start_client (address);
 }
 
-/** @brief private method to check full  */
+/**
+ * @brief private method to check full
+ * @note A bounded queue blocks send () until the transport catches up, which
+ *       applies back-pressure to the pipeline instead of piling up buffers.
+ */
 gboolean
 NNStreamerRPC::_data_queue_check_full_cb (GstDataQueue * queue,
     guint visible, guint bytes, guint64 time, gpointer checkdata)
 {
-  /* no full */
-  return FALSE;
+  NNStreamerRPC * self = static_cast<NNStreamerRPC *> (checkdata);
+
+  if (self->max_buffers_ == 0)
+    return FALSE;
+
+  return visible >= self->max_buffers_;
 }
 
 /** @brief private method to free a data item */
@@ -360,6 +402,14 @@ grpc_common_set_property (GObject * self, gboolean * silent,
       grpc->config.port = g_value_get_int (value);
       silent_debug ("Set port = %d", grpc->config.port);
       break;
+    case PROP_STREAMS:
+      grpc->config.num_streams = g_value_get_uint (value);
+      silent_debug ("Set streams = %u", grpc->config.num_streams);
+      break;
+    case PROP_MAX_BUFFERS:
+      grpc->config.max_buffers = g_value_get_uint (value);
+      silent_debug ("Set max-buffers = %u", grpc->config.max_buffers);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -404,6 +454,12 @@ grpc_common_get_property (GObject * self, gboolean silent, guint out,
     case PROP_OUT:
       g_value_set_uint (value, out);
       break;
+    case PROP_STREAMS:
+      g_value_set_uint (value, grpc->config.num_streams);
+      break;
+    case PROP_MAX_BUFFERS:
+      g_value_set_uint (value, grpc->config.max_buffers);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
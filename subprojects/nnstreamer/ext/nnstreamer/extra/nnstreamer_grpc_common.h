@@ -23,6 +23,7 @@
 #include <cstring>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace grpc {
 
@@ -65,12 +66,18 @@ class NNStreamerRPC {
     }
 
   protected:
+    static std::shared_ptr<Channel> create_channel (std::string address,
+        guint stream);
+
     const gchar *host_;
     gint port_;
 
     gboolean is_server_;
     gboolean is_blocking_;
 
+    guint num_streams_;
+    guint max_buffers_;
+
     grpc_direction direction_;
 
     grpc_cb cb_;
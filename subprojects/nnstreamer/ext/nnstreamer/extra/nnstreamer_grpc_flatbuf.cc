@@ -106,27 +106,51 @@ Status ServiceImplFlatbuf::_write_tensors (T writer)
   return Status::OK;
 }
 
+/** @brief release the received message wrapped by a memory */
+static void
+_free_tensors_message (gpointer data)
+{
+  delete static_cast<Message<Tensors> *> (data);
+}
+
 /** @brief convert tensors to buffer */
 void
 ServiceImplFlatbuf::_get_buffer_from_tensors (Message<Tensors> &msg,
     GstBuffer **buffer)
 {
-  const Tensors *tensors = msg.GetRoot ();
-  guint num_tensor = tensors->num_tensor ();
+  Message<Tensors> *owner;
+  const Tensors *tensors;
+  guint num_tensor;
+  GstMemory *parent;
   GstMemory *memory;
+  const guint8 *base;
+  gsize msg_size;
+
+  /**
+   * take the ownership of the received message and share its tensor data
+   * with the memories instead of duplicating them.
+   */
+  owner = new Message<Tensors> (std::move (msg));
+  tensors = owner->GetRoot ();
+  num_tensor = tensors->num_tensor ();
+  base = owner->data ();
+  msg_size = owner->size ();
+
+  parent = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      (gpointer) base, msg_size, 0, msg_size, owner, _free_tensors_message);
 
   *buffer = gst_buffer_new ();
 
   for (guint i = 0; i < num_tensor; i++) {
     const Tensor * tensor = tensors->tensor ()->Get (i);
-    const void * data = tensor->data ()->data ();
+    const guint8 * data = tensor->data ()->data ();
     gsize size = VectorLength (tensor->data ());
-    gpointer new_data = _g_memdup (data, size);
 
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
+    memory = gst_memory_share (parent, data - base, size);
     gst_buffer_append_memory (*buffer, memory);
   }
+
+  gst_memory_unref (parent);
 }
 
 /** @brief convert buffer to tensors */
@@ -149,8 +173,15 @@ ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
 
   GstMapInfo map;
   gsize data_ptr = 0;
+  gboolean per_memory;
 
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
+  /**
+   * Each tensor is usually held in its own memory block. Map the blocks one
+   * by one so that gst_buffer_map () does not merge (copy) them beforehand.
+   */
+  per_memory = (gst_buffer_n_memory (buffer) == num_tensors);
+
+  if (!per_memory && !gst_buffer_map (buffer, &map, GST_MAP_READ)) {
     ml_loge ("Unable to map the buffer\n");
     return;
   }
@@ -158,18 +189,41 @@ ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
   for (guint i = 0; i < num_tensors; i++) {
     const GstTensorInfo * info = &config_->info.info[i];
     gsize tsize = gst_tensor_info_get_size (info);
+    GstMemory *mem = NULL;
+    GstMapInfo mem_map;
+    const guint8 *data;
+
+    if (per_memory) {
+      mem = gst_buffer_peek_memory (buffer, i);
+      if (!gst_memory_map (mem, &mem_map, GST_MAP_READ)) {
+        ml_loge ("Unable to map the memory of tensor %u\n", i);
+        break;
+      }
 
-    if (data_ptr + tsize > map.size) {
-      ml_logw ("Setting invalid tensor data");
-      break;
+      if (tsize > mem_map.size) {
+        ml_logw ("Setting invalid tensor data");
+        gst_memory_unmap (mem, &mem_map);
+        break;
+      }
+
+      data = mem_map.data;
+    } else {
+      if (data_ptr + tsize > map.size) {
+        ml_logw ("Setting invalid tensor data");
+        break;
+      }
+
+      data = map.data + data_ptr;
+      data_ptr += tsize;
     }
 
     tensor_dim = builder.CreateVector (info->dimension, NNS_TENSOR_RANK_LIMIT);
     tensor_name = builder.CreateString ("Anonymous");
     tensor_type = (Tensor_type) info->type;
-    tensor_data = builder.CreateVector<unsigned char> (map.data + data_ptr, tsize);
+    tensor_data = builder.CreateVector<unsigned char> (data, tsize);
 
-    data_ptr += tsize;
+    if (mem)
+      gst_memory_unmap (mem, &mem_map);
 
     tensor = CreateTensor (builder, tensor_name, tensor_type, tensor_dim, tensor_data);
     tensor_vector.push_back (tensor);
@@ -180,7 +234,8 @@ ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
   builder.Finish (tensors);
   msg = builder.ReleaseMessage<Tensors>();
 
-  gst_buffer_unmap (buffer, &map);
+  if (!per_memory)
+    gst_buffer_unmap (buffer, &map);
 }
 
 /** @brief Constructor of SyncServiceImplFlatbuf */
@@ -323,14 +378,16 @@ AsyncServiceImplFlatbuf::start_server (std::string address)
 gboolean
 AsyncServiceImplFlatbuf::start_client (std::string address)
 {
-  /* create a gRPC channel */
-  std::shared_ptr<Channel> channel = grpc::CreateChannel(
-      address, grpc::InsecureChannelCredentials());
+  /* connect the server with a gRPC channel per stream */
+  for (guint i = 0; i < num_streams_; i++) {
+    std::unique_ptr<TensorService::Stub> stub =
+        TensorService::NewStub (create_channel (address, i));
 
-  /* connect the server */
-  client_stub_ = TensorService::NewStub (channel);
-  if (client_stub_.get () == nullptr)
-    return FALSE;
+    if (stub.get () == nullptr)
+      return FALSE;
+
+    client_stubs_.push_back (std::move (stub));
+  }
 
   worker_ = std::thread ([this] { this->_client_thread (); });
 
@@ -351,13 +408,11 @@ class AsyncCallDataServer : public AsyncCallData {
     void RunState (bool ok = true) override
     {
       if (state_ == PROCESS && !ok) {
-        if (count_ != 0) {
-          if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+        /* the last read failed, i.e., no message is received in this turn */
+        if (count_ != 0)
           state_ = FINISH;
-        } else {
+        else
           return;
-        }
       }
 
       if (state_ == CREATE) {
@@ -424,8 +479,9 @@ class AsyncCallDataClient : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataClient */
     AsyncCallDataClient (AsyncServiceImplFlatbuf *service, TensorService::Stub * stub,
-        CompletionQueue *cq)
-      : AsyncCallData (service), stub_ (stub), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+        CompletionQueue *cq, bool *closed)
+      : AsyncCallData (service), stub_ (stub), cq_ (cq), closed_ (closed),
+        writer_ (nullptr), reader_ (nullptr)
     {
       RunState ();
     }
@@ -434,13 +490,8 @@ class AsyncCallDataClient : public AsyncCallData {
     void RunState (bool ok = true) override
     {
       if (state_ == PROCESS && !ok) {
-        if (count_ != 0) {
-          if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
-          state_ = FINISH;
-        } else {
-          return;
-        }
+        /* the stream is closed or failed to start */
+        state_ = FINISH;
       }
 
       if (state_ == CREATE) {
@@ -474,13 +525,16 @@ class AsyncCallDataClient : public AsyncCallData {
           }
         }
       } else if (state_ == FINISH) {
-        Status status;
-
         if (reader_.get () != nullptr)
-          reader_->Finish (&status, this);
+          reader_->Finish (&status_, this);
         if (writer_.get () != nullptr)
-          writer_->Finish (&status, this);
+          writer_->Finish (&status_, this);
+        state_ = DESTROY;
+      } else {
+        if (!status_.ok ())
+          ml_logw ("gRPC stream closed: %s", status_.error_message ().c_str ());
 
+        *closed_ = true;
         delete this;
       }
     }
@@ -488,7 +542,9 @@ class AsyncCallDataClient : public AsyncCallData {
   private:
     TensorService::Stub * stub_;
     CompletionQueue * cq_;
+    bool * closed_;
     ClientContext ctx_;
+    Status status_;
 
     std::unique_ptr<ClientAsyncWriter<Message<Tensors>>> writer_;
     std::unique_ptr<ClientAsyncReader<Message<Tensors>>> reader_;
@@ -522,20 +578,46 @@ AsyncServiceImplFlatbuf::_server_thread ()
   }
 }
 
-/** @brief gRPC client thread */
+/**
+ * @brief gRPC client thread
+ * @note Each stream runs on its own thread with its own completion queue.
+ *       The writers share the data queue, so a stream blocked on an empty
+ *       queue does not hold back the completions of the other streams.
+ */
 void
 AsyncServiceImplFlatbuf::_client_thread ()
+{
+  std::vector<std::thread> streams;
+
+  for (guint i = 1; i < client_stubs_.size (); i++) {
+    TensorService::Stub *stub = client_stubs_[i].get ();
+
+    streams.emplace_back ([this, stub] { this->_stream_thread (stub); });
+  }
+
+  _stream_thread (client_stubs_[0].get ());
+
+  for (auto &stream : streams)
+    stream.join ();
+}
+
+/** @brief gRPC client stream thread */
+void
+AsyncServiceImplFlatbuf::_stream_thread (TensorService::Stub * stub)
 {
   CompletionQueue cq;
+  bool closed = false;
 
-  /* spawn a new instance to serve new clients */
-  new AsyncCallDataClient (this, client_stub_.get (), &cq);
+  new AsyncCallDataClient (this, stub, &cq, &closed);
 
-  /* until the stop is called */
-  while (!stop_) {
+  /* until the stream is closed or the stop is called for the reader */
+  while (!closed) {
     void *tag;
     bool ok;
 
+    if (stop_ && direction_ == GRPC_DIRECTION_BUFFER_TO_TENSORS)
+      break;
+
     /* 10 msec deadline to wait the next event */
     gpr_timespec deadline =
       gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
@@ -544,8 +626,6 @@ AsyncServiceImplFlatbuf::_client_thread ()
     switch (cq.AsyncNext (&tag, &ok, deadline)) {
       case CompletionQueue::GOT_EVENT:
         static_cast<AsyncCallDataClient *>(tag)->RunState(ok);
-        if (ok == false)
-          return;
         break;
       default:
         break;
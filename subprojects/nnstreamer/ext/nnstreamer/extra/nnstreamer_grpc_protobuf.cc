@@ -100,6 +100,13 @@ Status ServiceImplProtobuf::_write_tensors (T writer)
   return Status::OK;
 }
 
+/** @brief release the tensor data taken from the protobuf message */
+static void
+_free_tensor_data (gpointer data)
+{
+  delete static_cast<std::string *> (data);
+}
+
 /** @brief convert tensors to buffer */
 void
 ServiceImplProtobuf::_get_buffer_from_tensors (Tensors &tensors,
@@ -111,13 +118,12 @@ ServiceImplProtobuf::_get_buffer_from_tensors (Tensors &tensors,
   *buffer = gst_buffer_new ();
 
   for (guint i = 0; i < num_tensor; i++) {
-    const Tensor * tensor = &tensors.tensor (i);
-    const void * data = tensor->data ().c_str ();
-    gsize size = tensor->data ().length ();
-    gpointer new_data = _g_memdup (data, size);
+    /* take the ownership of the received data instead of copying it */
+    std::string * data = tensors.mutable_tensor (i)->release_data ();
+    gsize size = data->length ();
 
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
+    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, &(*data)[0], size,
+        0, size, data, _free_tensor_data);
     gst_buffer_append_memory (*buffer, memory);
   }
 }
@@ -130,26 +136,56 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
   Tensors::frame_rate *fr;
   GstMapInfo map;
   gsize data_ptr = 0;
+  guint num_tensors = config_->info.num_tensors;
+  gboolean per_memory;
 
-  tensors.set_num_tensor (config_->info.num_tensors);
+  tensors.set_num_tensor (num_tensors);
 
   fr = tensors.mutable_fr ();
   fr->set_rate_n (config_->rate_n);
   fr->set_rate_d (config_->rate_d);
 
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
+  /**
+   * Each tensor is usually held in its own memory block. Map the blocks one
+   * by one so that gst_buffer_map () does not merge (copy) them beforehand.
+   */
+  per_memory = (gst_buffer_n_memory (buffer) == num_tensors);
+
+  if (!per_memory && !gst_buffer_map (buffer, &map, GST_MAP_READ)) {
     ml_loge ("Unable to map the buffer\n");
     return;
   }
 
-  for (guint i = 0; i < config_->info.num_tensors; i++) {
+  for (guint i = 0; i < num_tensors; i++) {
     nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
     const GstTensorInfo * info = &config_->info.info[i];
     gsize tsize = gst_tensor_info_get_size (info);
+    GstMemory *mem = NULL;
+    GstMapInfo mem_map;
+    const guint8 *data;
+
+    if (per_memory) {
+      mem = gst_buffer_peek_memory (buffer, i);
+      if (!gst_memory_map (mem, &mem_map, GST_MAP_READ)) {
+        ml_loge ("Unable to map the memory of tensor %u\n", i);
+        break;
+      }
 
-    if (data_ptr + tsize > map.size) {
-      ml_logw ("Setting invalid tensor data");
-      break;
+      if (tsize > mem_map.size) {
+        ml_logw ("Setting invalid tensor data");
+        gst_memory_unmap (mem, &mem_map);
+        break;
+      }
+
+      data = mem_map.data;
+    } else {
+      if (data_ptr + tsize > map.size) {
+        ml_logw ("Setting invalid tensor data");
+        break;
+      }
+
+      data = map.data + data_ptr;
+      data_ptr += tsize;
     }
 
     /* set tensor info */
@@ -159,11 +195,14 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
     for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++)
       tensor->add_dimension (info->dimension[j]);
 
-    tensor->set_data (map.data + data_ptr, tsize);
-    data_ptr += tsize;
+    tensor->set_data (data, tsize);
+
+    if (mem)
+      gst_memory_unmap (mem, &mem_map);
   }
 
-  gst_buffer_unmap (buffer, &map);
+  if (!per_memory)
+    gst_buffer_unmap (buffer, &map);
 }
 
 /** @brief Constructor of SyncServiceImplProtobuf */
@@ -293,14 +332,16 @@ AsyncServiceImplProtobuf::start_server (std::string address)
 gboolean
 AsyncServiceImplProtobuf::start_client (std::string address)
 {
-  /* create a gRPC channel */
-  std::shared_ptr<Channel> channel = grpc::CreateChannel(
-      address, grpc::InsecureChannelCredentials());
+  /* connect the server with a gRPC channel per stream */
+  for (guint i = 0; i < num_streams_; i++) {
+    std::unique_ptr<TensorService::Stub> stub =
+        TensorService::NewStub (create_channel (address, i));
 
-  /* connect the server */
-  client_stub_ = TensorService::NewStub (channel);
-  if (client_stub_.get () == nullptr)
-    return FALSE;
+    if (stub.get () == nullptr)
+      return FALSE;
+
+    client_stubs_.push_back (std::move (stub));
+  }
 
   worker_ = std::thread ([this] { this->_client_thread (); });
 
@@ -321,13 +362,11 @@ class AsyncCallDataServer : public AsyncCallData {
     void RunState (bool ok = true) override
     {
       if (state_ == PROCESS && !ok) {
-        if (count_ != 0) {
-          if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+        /* the last read failed, i.e., no message is received in this turn */
+        if (count_ != 0)
           state_ = FINISH;
-        } else {
+        else
           return;
-        }
       }
 
       if (state_ == CREATE) {
@@ -388,8 +427,9 @@ class AsyncCallDataClient : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataClient */
     AsyncCallDataClient (AsyncServiceImplProtobuf *service, TensorService::Stub * stub,
-        CompletionQueue *cq)
-      : AsyncCallData (service), stub_ (stub), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+        CompletionQueue *cq, bool *closed)
+      : AsyncCallData (service), stub_ (stub), cq_ (cq), closed_ (closed),
+        writer_ (nullptr), reader_ (nullptr)
     {
       RunState ();
     }
@@ -398,13 +438,8 @@ class AsyncCallDataClient : public AsyncCallData {
     void RunState (bool ok = true) override
     {
       if (state_ == PROCESS && !ok) {
-        if (count_ != 0) {
-          if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
-          state_ = FINISH;
-        } else {
-          return;
-        }
+        /* the stream is closed or failed to start */
+        state_ = FINISH;
       }
 
       if (state_ == CREATE) {
@@ -432,13 +467,16 @@ class AsyncCallDataClient : public AsyncCallData {
           }
         }
       } else if (state_ == FINISH) {
-        Status status;
-
         if (reader_.get () != nullptr)
-          reader_->Finish (&status, this);
+          reader_->Finish (&status_, this);
         if (writer_.get () != nullptr)
-          writer_->Finish (&status, this);
+          writer_->Finish (&status_, this);
+        state_ = DESTROY;
+      } else {
+        if (!status_.ok ())
+          ml_logw ("gRPC stream closed: %s", status_.error_message ().c_str ());
 
+        *closed_ = true;
         delete this;
       }
     }
@@ -446,7 +484,9 @@ class AsyncCallDataClient : public AsyncCallData {
   private:
     TensorService::Stub * stub_;
     CompletionQueue * cq_;
+    bool * closed_;
     ClientContext ctx_;
+    Status status_;
 
     std::unique_ptr<ClientAsyncWriter<Tensors>> writer_;
     std::unique_ptr<ClientAsyncReader<Tensors>> reader_;
@@ -480,20 +520,46 @@ AsyncServiceImplProtobuf::_server_thread ()
   }
 }
 
-/** @brief gRPC client thread */
+/**
+ * @brief gRPC client thread
+ * @note Each stream runs on its own thread with its own completion queue.
+ *       The writers share the data queue, so a stream blocked on an empty
+ *       queue does not hold back the completions of the other streams.
+ */
 void
 AsyncServiceImplProtobuf::_client_thread ()
+{
+  std::vector<std::thread> streams;
+
+  for (guint i = 1; i < client_stubs_.size (); i++) {
+    TensorService::Stub *stub = client_stubs_[i].get ();
+
+    streams.emplace_back ([this, stub] { this->_stream_thread (stub); });
+  }
+
+  _stream_thread (client_stubs_[0].get ());
+
+  for (auto &stream : streams)
+    stream.join ();
+}
+
+/** @brief gRPC client stream thread */
+void
+AsyncServiceImplProtobuf::_stream_thread (TensorService::Stub * stub)
 {
   CompletionQueue cq;
+  bool closed = false;
 
-  /* spawn a new instance to serve new clients */
-  new AsyncCallDataClient (this, client_stub_.get (), &cq);
+  new AsyncCallDataClient (this, stub, &cq, &closed);
 
-  /* until the stop is called */
-  while (!stop_) {
+  /* until the stream is closed or the stop is called for the reader */
+  while (!closed) {
     void *tag;
     bool ok;
 
+    if (stop_ && direction_ == GRPC_DIRECTION_BUFFER_TO_TENSORS)
+      break;
+
     /* 10 msec deadline to wait the next event */
     gpr_timespec deadline =
       gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
@@ -502,8 +568,6 @@ AsyncServiceImplProtobuf::_client_thread ()
     switch (cq.AsyncNext (&tag, &ok, deadline)) {
       case CompletionQueue::GOT_EVENT:
         static_cast<AsyncCallDataClient *>(tag)->RunState(ok);
-        if (ok == false)
-          return;
         break;
       default:
         break;
@@ -93,8 +93,12 @@ class AsyncServiceImplProtobuf final
 
     void _server_thread ();
     void _client_thread ();
+    void _stream_thread (TensorService::Stub * stub);
 
     AsyncCallData * last_call_;
+
+    /* one stub (connection) per concurrent stream */
+    std::vector<std::unique_ptr<TensorService::Stub>> client_stubs_;
 };
 
 /** @brief Internal base class to serve a request */
@@ -24,21 +24,213 @@
  * protobuf-compiler17
  */
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_util.h>
 #include "nnstreamer.pb.h" /* Generated by `protoc` */
 #include "nnstreamer_protobuf.h"
 
+/**
+ * @brief Field numbers and wire types in nnstreamer.proto.
+ * The tensor data is written and read directly (not via the generated
+ * message) to avoid copying it into std::string.
+ */
+#define PB_WIRETYPE_VARINT (0)
+#define PB_WIRETYPE_FIXED64 (1)
+#define PB_WIRETYPE_LENGTH_DELIMITED (2)
+#define PB_WIRETYPE_FIXED32 (5)
+#define PB_MAKE_TAG(f, w) ((guint32) (((f) << 3) | (w)))
+
+#define PB_TENSORS_NUM_TENSOR (1)
+#define PB_TENSORS_FR (2)
+#define PB_TENSORS_TENSOR (3)
+#define PB_TENSORS_FORMAT (4)
+#define PB_FR_RATE_N (1)
+#define PB_FR_RATE_D (2)
+#define PB_TENSOR_NAME (1)
+#define PB_TENSOR_TYPE (2)
+#define PB_TENSOR_DIMENSION (3)
+#define PB_TENSOR_DATA (4)
+
+/** @brief Read a base-128 varint. Returns FALSE if the input is truncated. */
+static gboolean
+_pb_read_varint (const guint8 **pos, const guint8 *end, guint64 *val)
+{
+  const guint8 *p = *pos;
+  guint shift = 0;
+  guint64 v = 0;
+
+  while (p < end && shift < 64) {
+    guint8 b = *p++;
+
+    v |= ((guint64) (b & 0x7f)) << shift;
+    if (!(b & 0x80)) {
+      *pos = p;
+      *val = v;
+      return TRUE;
+    }
+    shift += 7;
+  }
+
+  return FALSE;
+}
+
+/** @brief Read the length of a length-delimited field and check the boundary. */
+static gboolean
+_pb_read_length (const guint8 **pos, const guint8 *end, gsize *len)
+{
+  guint64 v;
+
+  if (!_pb_read_varint (pos, end, &v) || v > (guint64) (end - *pos))
+    return FALSE;
+
+  *len = (gsize) v;
+  return TRUE;
+}
+
+/** @brief Skip the value of a field with the given wire type. */
+static gboolean
+_pb_skip_field (const guint8 **pos, const guint8 *end, guint32 wire_type)
+{
+  guint64 v;
+  gsize len;
+
+  switch (wire_type) {
+    case PB_WIRETYPE_VARINT:
+      return _pb_read_varint (pos, end, &v);
+    case PB_WIRETYPE_FIXED64:
+      len = 8;
+      break;
+    case PB_WIRETYPE_FIXED32:
+      len = 4;
+      break;
+    case PB_WIRETYPE_LENGTH_DELIMITED:
+      if (!_pb_read_length (pos, end, &len))
+        return FALSE;
+      break;
+    default:
+      return FALSE;
+  }
+
+  if (len > (gsize) (end - *pos))
+    return FALSE;
+
+  *pos += len;
+  return TRUE;
+}
+
+/**
+ * @brief Parse a serialized nnstreamer::protobuf::Tensor.
+ * @param[out] data The position of the tensor data in the given range.
+ * @param[out] data_size The size of the tensor data.
+ */
+static gboolean
+_pb_parse_tensor (const guint8 *pos, const guint8 *end, GstTensorInfo *info,
+    const guint8 **data, gsize *data_size)
+{
+  guint num_dims = 0;
+  guint64 tag, v;
+  gsize len;
+
+  *data = pos;
+  *data_size = 0;
+
+  while (pos < end) {
+    if (!_pb_read_varint (&pos, end, &tag))
+      return FALSE;
+
+    switch (tag) {
+      case PB_MAKE_TAG (PB_TENSOR_NAME, PB_WIRETYPE_LENGTH_DELIMITED):
+        if (!_pb_read_length (&pos, end, &len))
+          return FALSE;
+        g_free (info->name);
+        info->name = (len > 0) ? g_strndup ((const gchar *) pos, len) : NULL;
+        pos += len;
+        break;
+      case PB_MAKE_TAG (PB_TENSOR_TYPE, PB_WIRETYPE_VARINT):
+        if (!_pb_read_varint (&pos, end, &v))
+          return FALSE;
+        info->type = (tensor_type) v;
+        break;
+      case PB_MAKE_TAG (PB_TENSOR_DIMENSION, PB_WIRETYPE_LENGTH_DELIMITED):
+      {
+        const guint8 *dim_end;
+
+        /* packed (default in proto3) */
+        if (!_pb_read_length (&pos, end, &len))
+          return FALSE;
+        dim_end = pos + len;
+        while (pos < dim_end) {
+          if (!_pb_read_varint (&pos, dim_end, &v))
+            return FALSE;
+          if (num_dims < NNS_TENSOR_RANK_LIMIT)
+            info->dimension[num_dims++] = (uint32_t) v;
+        }
+        break;
+      }
+      case PB_MAKE_TAG (PB_TENSOR_DIMENSION, PB_WIRETYPE_VARINT):
+        if (!_pb_read_varint (&pos, end, &v))
+          return FALSE;
+        if (num_dims < NNS_TENSOR_RANK_LIMIT)
+          info->dimension[num_dims++] = (uint32_t) v;
+        break;
+      case PB_MAKE_TAG (PB_TENSOR_DATA, PB_WIRETYPE_LENGTH_DELIMITED):
+        if (!_pb_read_length (&pos, end, &len))
+          return FALSE;
+        *data = pos;
+        *data_size = len;
+        pos += len;
+        break;
+      default:
+        if (!_pb_skip_field (&pos, end, (guint32) (tag & 0x7)))
+          return FALSE;
+        break;
+    }
+  }
+
+  return TRUE;
+}
+
+/** @brief Parse a serialized nnstreamer::protobuf::Tensors::frame_rate. */
+static gboolean
+_pb_parse_frame_rate (const guint8 *pos, const guint8 *end, GstTensorsConfig *config)
+{
+  guint64 tag, v;
+
+  while (pos < end) {
+    if (!_pb_read_varint (&pos, end, &tag))
+      return FALSE;
+
+    if (tag == PB_MAKE_TAG (PB_FR_RATE_N, PB_WIRETYPE_VARINT)) {
+      if (!_pb_read_varint (&pos, end, &v))
+        return FALSE;
+      config->rate_n = (gint32) v;
+    } else if (tag == PB_MAKE_TAG (PB_FR_RATE_D, PB_WIRETYPE_VARINT)) {
+      if (!_pb_read_varint (&pos, end, &v))
+        return FALSE;
+      config->rate_d = (gint32) v;
+    } else if (!_pb_skip_field (&pos, end, (guint32) (tag & 0x7))) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 GstFlowReturn
 gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
     const GstTensorMemory *input, GstBuffer *outbuf)
 {
+  using google::protobuf::io::CodedOutputStream;
   GstMapInfo out_info;
   GstMemory *out_mem;
-  size_t size, outbuf_size;
+  size_t size = 0, outbuf_size, data_size;
+  size_t tensor_size[NNS_TENSOR_SIZE_LIMIT];
   nnstreamer::protobuf::Tensors tensors;
+  nnstreamer::protobuf::Tensor tensor_meta[NNS_TENSOR_SIZE_LIMIT];
   nnstreamer::protobuf::Tensors::frame_rate *fr = NULL;
   guint num_tensors;
   gboolean is_flexible;
@@ -73,8 +265,14 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
   tensors.set_format (
       (nnstreamer::protobuf::Tensors::Tensor_format) pbd_config.format);
 
+  /**
+   * The tensor data is not copied into the message (set_data () and
+   * SerializeToArray () copy it twice). The message without the data is
+   * serialized first, and then each tensor is written with its data field
+   * directly into the output memory.
+   */
   for (unsigned int i = 0; i < num_tensors; ++i) {
-    nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
+    nnstreamer::protobuf::Tensor *tensor = &tensor_meta[i];
     gchar *name = NULL;
 
     if (is_flexible) {
@@ -96,10 +294,13 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
       tensor->add_dimension (pbd_config.info.info[i].dimension[j]);
     }
 
-    tensor->set_data (input[i].data, (int)input[i].size);
+    data_size = input[i].size;
+    tensor_size[i] = tensor->ByteSizeLong () + 1
+        + CodedOutputStream::VarintSize64 (data_size) + data_size;
+    size += 1 + CodedOutputStream::VarintSize64 (tensor_size[i]) + tensor_size[i];
   }
 
-  size = tensors.ByteSizeLong ();
+  size += tensors.ByteSizeLong ();
   outbuf_size = gst_buffer_get_size (outbuf);
 
   if (outbuf_size == 0) {
@@ -117,7 +318,20 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
     return GST_FLOW_ERROR;
   }
 
-  tensors.SerializeToArray (out_info.data, size);
+  {
+    google::protobuf::io::ArrayOutputStream array_stream (out_info.data, (int) size);
+    CodedOutputStream stream (&array_stream);
+
+    tensors.SerializeWithCachedSizes (&stream);
+    for (unsigned int i = 0; i < num_tensors; ++i) {
+      stream.WriteTag (PB_MAKE_TAG (PB_TENSORS_TENSOR, PB_WIRETYPE_LENGTH_DELIMITED));
+      stream.WriteVarint64 (tensor_size[i]);
+      tensor_meta[i].SerializeWithCachedSizes (&stream);
+      stream.WriteTag (PB_MAKE_TAG (PB_TENSOR_DATA, PB_WIRETYPE_LENGTH_DELIMITED));
+      stream.WriteVarint64 (input[i].size);
+      stream.WriteRaw (input[i].data, (int) input[i].size);
+    }
+  }
 
   gst_memory_unmap (out_mem, &out_info);
 
@@ -133,13 +347,13 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
 GstBuffer *
 gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void *priv_data)
 {
-  nnstreamer::protobuf::Tensors tensors;
-  nnstreamer::protobuf::Tensors::frame_rate *fr = NULL;
   GstMemory *in_mem, *out_mem;
   GstMapInfo in_info;
-  GstBuffer *out_buf;
-  gsize mem_size;
-  gpointer mem_data;
+  GstBuffer *out_buf = NULL;
+  const guint8 *pos, *end;
+  guint num_parsed = 0;
+  guint64 tag, v;
+  gsize len;
   UNUSED (priv_data);
 
   if (!in_buf || !config) {
@@ -154,32 +368,81 @@ gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void
     return NULL;
   }
 
-  tensors.ParseFromArray (in_info.data, in_info.size);
-
-  config->info.num_tensors = tensors.num_tensor ();
-  config->format = (tensor_format) tensors.format ();
-  fr = tensors.mutable_fr ();
-  config->rate_n = fr->rate_n ();
-  config->rate_d = fr->rate_d ();
+  /**
+   * Walk the wire format instead of ParseFromArray () so that the tensor
+   * data is not copied. Each memory of the output buffer refers to the tensor
+   * data in the input memory.
+   */
+  config->info.num_tensors = 0;
+  config->format = _NNS_TENSOR_FORMAT_STATIC;
+  config->rate_n = config->rate_d = 0;
   out_buf = gst_buffer_new ();
 
-  for (guint i = 0; i < config->info.num_tensors; i++) {
-    const nnstreamer::protobuf::Tensor *tensor = &tensors.tensor (i);
-    std::string _name = tensor->name ();
-    const gchar *name = _name.c_str ();
-
-    config->info.info[i].name = (name && strlen (name) > 0) ? g_strdup (name) : NULL;
-    config->info.info[i].type = (tensor_type)tensor->type ();
-    for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++) {
-      config->info.info[i].dimension[j] = tensor->dimension (j);
+  pos = in_info.data;
+  end = in_info.data + in_info.size;
+  while (pos < end) {
+    if (!_pb_read_varint (&pos, end, &tag))
+      goto error;
+
+    switch (tag) {
+      case PB_MAKE_TAG (PB_TENSORS_NUM_TENSOR, PB_WIRETYPE_VARINT):
+        if (!_pb_read_varint (&pos, end, &v))
+          goto error;
+        if (v > NNS_TENSOR_SIZE_LIMIT) {
+          nns_loge ("The number of tensors is limited to %d", NNS_TENSOR_SIZE_LIMIT);
+          goto error;
+        }
+        config->info.num_tensors = (guint) v;
+        break;
+      case PB_MAKE_TAG (PB_TENSORS_FR, PB_WIRETYPE_LENGTH_DELIMITED):
+        if (!_pb_read_length (&pos, end, &len)
+            || !_pb_parse_frame_rate (pos, pos + len, config))
+          goto error;
+        pos += len;
+        break;
+      case PB_MAKE_TAG (PB_TENSORS_TENSOR, PB_WIRETYPE_LENGTH_DELIMITED):
+      {
+        GstTensorInfo *info;
+        const guint8 *data;
+        gsize data_size;
+
+        if (num_parsed >= NNS_TENSOR_SIZE_LIMIT) {
+          nns_loge ("The number of tensors is limited to %d", NNS_TENSOR_SIZE_LIMIT);
+          goto error;
+        }
+
+        info = &config->info.info[num_parsed];
+        info->name = NULL;
+        for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++)
+          info->dimension[j] = 0;
+        info->type = _NNS_INT32;
+
+        if (!_pb_read_length (&pos, end, &len)
+            || !_pb_parse_tensor (pos, pos + len, info, &data, &data_size))
+          goto error;
+        pos += len;
+
+        out_mem = gst_memory_share (in_mem, data - in_info.data, data_size);
+        gst_buffer_append_memory (out_buf, out_mem);
+        num_parsed++;
+        break;
+      }
+      case PB_MAKE_TAG (PB_TENSORS_FORMAT, PB_WIRETYPE_VARINT):
+        if (!_pb_read_varint (&pos, end, &v))
+          goto error;
+        config->format = (tensor_format) v;
+        break;
+      default:
+        if (!_pb_skip_field (&pos, end, (guint32) (tag & 0x7)))
+          goto error;
+        break;
     }
-    mem_size = tensor->data ().length ();
-    mem_data = _g_memdup (tensor->data ().c_str (), mem_size);
-
-    out_mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, mem_data, mem_size,
-        0, mem_size, NULL, NULL);
+  }
 
-    gst_buffer_append_memory (out_buf, out_mem);
+  if (num_parsed != config->info.num_tensors) {
+    nns_loge ("The number of tensors (%u) does not match the parsed tensors (%u)",
+        config->info.num_tensors, num_parsed);
+    goto error;
   }
 
   /** copy timestamps */
@@ -188,4 +451,15 @@ gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void
   gst_memory_unmap (in_mem, &in_info);
 
   return out_buf;
+
+error:
+  nns_loge ("Failed to parse the protobuf message / tensor_converter_protobuf");
+  for (guint i = 0; i <= num_parsed && i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    g_free (config->info.info[i].name);
+    config->info.info[i].name = NULL;
+  }
+  gst_buffer_unref (out_buf);
+  gst_memory_unmap (in_mem, &in_info);
+
+  return NULL;
 }
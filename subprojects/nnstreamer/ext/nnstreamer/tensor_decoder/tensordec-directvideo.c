@@ -29,6 +29,7 @@
 #include <string.h>
 #include <glib.h>
 #include <gst/video/video-format.h>
+#include <gst/video/gstvideometa.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_log.h>
@@ -74,6 +75,10 @@ typedef struct
 {
   /* From option1 */
   direct_video_formats format;
+
+  /* From allocation query */
+  gboolean video_meta; /**< downstream supports GstVideoMeta */
+  GstVideoFormat video_format; /**< negotiated video format */
 } direct_video_ops;
 
 /**
@@ -108,6 +113,8 @@ dv_init (void **pdata)
   }
 
   ddata->format = DIRECT_VIDEO_FORMAT_UNKNOWN;
+  ddata->video_meta = FALSE;
+  ddata->video_format = GST_VIDEO_FORMAT_UNKNOWN;
 
   return TRUE;
 }
@@ -158,22 +165,12 @@ dv_setOption (void **pdata, int opNum, const char *param)
   return TRUE;
 }
 
-/** @brief tensordec-plugin's GstTensorDecoderDef callback */
-static GstCaps *
-dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
+/** @brief Get the video format from the number of channels and option1 */
+static GstVideoFormat
+_dv_get_video_format (const direct_video_ops * ddata, guint channel)
 {
-  direct_video_ops *ddata = *pdata;
-  /* Old gst_tensordec_video_caps_from_config () had this */
   GstVideoFormat format;
-  gint width, height, channel;
-  GstCaps *caps;
 
-  g_return_val_if_fail (config != NULL, NULL);
-  GST_INFO ("Num Tensors = %d", config->info.num_tensors);
-  g_return_val_if_fail (config->info.num_tensors >= 1, NULL);
-
-  /* Direct video uses the first tensor only even if it's multi-tensor */
-  channel = config->info.info[0].dimension[0];
   if (channel == 1) {
     switch (ddata->format) {
       case DIRECT_VIDEO_FORMAT_GRAY8:
@@ -185,7 +182,7 @@ dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
         break;
       default:
         GST_ERROR ("Invalid format. Please check the video format");
-        return NULL;
+        return GST_VIDEO_FORMAT_UNKNOWN;
     }
   } else if (channel == 3) {
     switch (ddata->format) {
@@ -201,7 +198,7 @@ dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
         break;
       default:
         GST_ERROR ("Invalid format. Please check the video format");
-        return NULL;
+        return GST_VIDEO_FORMAT_UNKNOWN;
     }
   } else if (channel == 4) {
     switch (ddata->format) {
@@ -235,13 +232,35 @@ dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
         break;
       default:
         GST_ERROR ("Invalid format. Please check the video format");
-        return NULL;
+        return GST_VIDEO_FORMAT_UNKNOWN;
     }
   } else {
-    GST_ERROR ("%d channel is not supported", channel);
-    return NULL;
+    GST_ERROR ("%u channel is not supported", channel);
+    return GST_VIDEO_FORMAT_UNKNOWN;
   }
 
+  return format;
+}
+
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstCaps *
+dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
+{
+  direct_video_ops *ddata = *pdata;
+  /* Old gst_tensordec_video_caps_from_config () had this */
+  GstVideoFormat format;
+  gint width, height;
+  GstCaps *caps;
+
+  g_return_val_if_fail (config != NULL, NULL);
+  GST_INFO ("Num Tensors = %d", config->info.num_tensors);
+  g_return_val_if_fail (config->info.num_tensors >= 1, NULL);
+
+  /* Direct video uses the first tensor only even if it's multi-tensor */
+  format = _dv_get_video_format (ddata, config->info.info[0].dimension[0]);
+  if (format == GST_VIDEO_FORMAT_UNKNOWN)
+    return NULL;
+
   width = config->info.info[0].dimension[1];
   height = config->info.info[0].dimension[2];
 
@@ -349,6 +368,75 @@ dv_decode (void **pdata, const GstTensorsConfig * config,
   return GST_FLOW_OK;
 }
 
+/** @brief tensordec-plugin's GstTensorDecoderBufferDef callback */
+static int
+dv_decideAllocation (void **pdata, const GstTensorsConfig * config,
+    GstQuery * query)
+{
+  direct_video_ops *ddata = *pdata;
+
+  ddata->video_format =
+      _dv_get_video_format (ddata, config->info.info[0].dimension[0]);
+  ddata->video_meta = (ddata->video_format != GST_VIDEO_FORMAT_UNKNOWN &&
+      gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL));
+
+  return TRUE;
+}
+
+/** @brief tensordec-plugin's GstTensorDecoderBufferDef callback */
+static GstFlowReturn
+dv_decodeBuffer (void **pdata, const GstTensorsConfig * config,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  direct_video_ops *ddata = *pdata;
+  /* Direct video uses the first tensor only even if it's multi-tensor */
+  const uint32_t *dim = &(config->info.info[0].dimension[0]);
+  gsize stride = (gsize) dim[0] * dim[1];
+  gsize size = stride * dim[2];
+  GstMemory *in_mem;
+  GstMapInfo in_info;
+  GstTensorMemory input;
+  GstFlowReturn ret;
+
+  g_assert (config->info.info[0].type == _NNS_UINT8);
+  in_mem = gst_buffer_peek_memory (inbuf, 0);
+
+  /**
+   * Share the input memory if the rows are 4-byte aligned (default stride of GstVideoInfo)
+   * or downstream can read the stride from GstVideoMeta.
+   */
+  if (gst_tensors_config_is_static (config) &&
+      (stride % 4 == 0 || ddata->video_meta) &&
+      !GST_MEMORY_FLAG_IS_SET (in_mem, GST_MEMORY_FLAG_NO_SHARE) &&
+      gst_memory_get_sizes (in_mem, NULL, NULL) >= size) {
+    gst_buffer_append_memory (outbuf, gst_memory_share (in_mem, 0, size));
+
+    if (ddata->video_meta) {
+      gsize offset[GST_VIDEO_MAX_PLANES] = { 0, };
+      gint strides[GST_VIDEO_MAX_PLANES] = { 0, };
+
+      strides[0] = (gint) stride;
+      gst_buffer_add_video_meta_full (outbuf, GST_VIDEO_FRAME_FLAG_NONE,
+          ddata->video_format, dim[1], dim[2], 1, offset, strides);
+    }
+
+    return GST_FLOW_OK;
+  }
+
+  /* Repack the rows into a new memory */
+  if (!gst_memory_map (in_mem, &in_info, GST_MAP_READ)) {
+    ml_loge ("Cannot map input memory / tensordec-directvideo.\n");
+    return GST_FLOW_ERROR;
+  }
+
+  input.data = in_info.data;
+  input.size = in_info.size;
+  ret = dv_decode (pdata, config, &input, outbuf);
+
+  gst_memory_unmap (in_mem, &in_info);
+  return ret;
+}
+
 static gchar decoder_subplugin_direct_video[] = "direct_video";
 
 /** @brief Direct-Video tensordec-plugin GstTensorDecoderDef instance */
@@ -362,11 +450,17 @@ static GstTensorDecoderDef directVideo = {
   .decode = dv_decode
 };
 
+/** @brief Direct-Video tensordec-plugin GstTensorDecoderBufferDef instance */
+static GstTensorDecoderBufferDef directVideoBuffer = {
+  .decideAllocation = dv_decideAllocation,
+  .decodeBuffer = dv_decodeBuffer
+};
+
 /** @brief Initialize this object for tensordec-plugin */
 void
 init_dv (void)
 {
-  nnstreamer_decoder_probe (&directVideo);
+  nnstreamer_decoder_probe_buffer (&directVideo, &directVideoBuffer);
 }
 
 /** @brief Destruct this object for tensordec-plugin */
@@ -18,6 +18,7 @@
 #include <glib.h>
 #include <gst/gstinfo.h>
 #include <iostream>
+#include <new>
 #include <nnstreamer_generated.h> /* Generated by `flatc`. */
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api.h>
@@ -78,6 +79,13 @@ fbd_getOutCaps (void **pdata, const GstTensorsConfig *config)
   return caps;
 }
 
+/** @brief Release the flatbuffer detached from the builder */
+static void
+fbd_free_detached_buffer (gpointer data)
+{
+  delete static_cast<flatbuffers::DetachedBuffer *> (data);
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
 fbd_decode (void **pdata, const GstTensorsConfig *config,
@@ -133,8 +141,10 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
 
     type = (Tensor_type) fbd_config.info.info[i].type;
 
-    /* Create the vector first, and fill in data later */
-    /** @todo Consider to remove memcpy */
+    /**
+     * Create the vector first, and fill in data later.
+     * This is the only copy of the tensor data, the builder owns the serialized buffer.
+     */
     input_vector = builder.CreateUninitializedVector<unsigned char> (input[i].size, &tmp_buf);
     memcpy (tmp_buf, input[i].data, input[i].size);
 
@@ -149,14 +159,27 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
   fb_size = builder.GetSize ();
 
   if (gst_buffer_get_size (outbuf) == 0) {
-    out_mem = gst_allocator_alloc (NULL, fb_size, NULL);
-  } else {
-    if (gst_buffer_get_size (outbuf) < fb_size) {
-      gst_buffer_set_size (outbuf, fb_size);
+    flatbuffers::DetachedBuffer *detached;
+
+    /* Hand over the serialized buffer to GstMemory without copying it. */
+    try {
+      detached = new flatbuffers::DetachedBuffer (builder.Release ());
+    } catch (const std::bad_alloc &e) {
+      nns_loge ("Failed to allocate the flatbuffer (tensor decoder flatbuf)\n");
+      return GST_FLOW_ERROR;
     }
-    out_mem = gst_buffer_get_all_memory (outbuf);
+
+    out_mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, detached->data (),
+        detached->size (), 0, detached->size (), detached, fbd_free_detached_buffer);
+    gst_buffer_append_memory (outbuf, out_mem);
+    return GST_FLOW_OK;
   }
 
+  if (gst_buffer_get_size (outbuf) < fb_size) {
+    gst_buffer_set_size (outbuf, fb_size);
+  }
+  out_mem = gst_buffer_get_all_memory (outbuf);
+
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     gst_memory_unref (out_mem);
     nns_loge ("Cannot map gst memory (tensor decoder flatbuf)\n");
@@ -166,11 +189,7 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
   memcpy (out_info.data, builder.GetBufferPointer (), fb_size);
 
   gst_memory_unmap (out_mem, &out_info);
-
-  if (gst_buffer_get_size (outbuf) == 0)
-    gst_buffer_append_memory (outbuf, out_mem);
-  else
-    gst_memory_unref (out_mem);
+  gst_memory_unref (out_mem);
 
   return GST_FLOW_OK;
 }
@@ -166,6 +166,26 @@ case typename:\
   break;
 
 
+/**
+ * @brief Search for max of half precision (float16, bfloat16) data.
+ * The sign-magnitude bits are mapped to an unsigned key with the same order.
+ */
+#define search_max_half(i, max_index, bpe, data, num_data) \
+do {\
+  unsigned int i;\
+  uint16_t *cursor = (uint16_t *) (data);\
+  uint16_t key, max_key;\
+  max_key = cursor[0] ^ ((cursor[0] & 0x8000U) ? 0xffffU : 0x8000U);\
+  max_index = 0;\
+  for (i = 1; i < (num_data); i++) {\
+    key = cursor[i] ^ ((cursor[i] & 0x8000U) ? 0xffffU : 0x8000U);\
+    if (key > max_key) {\
+      max_key = key;\
+      max_index = i;\
+    }\
+  }\
+} while (0);
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
 il_decode (void **pdata, const GstTensorsConfig * config,
@@ -201,6 +221,10 @@ il_decode (void **pdata, const GstTensorsConfig * config,
       search_max_case (float, _NNS_FLOAT32);
       search_max_case (int64_t, _NNS_INT64);
       search_max_case (uint64_t, _NNS_UINT64);
+    case _NNS_FLOAT16:
+    case _NNS_BFLOAT16:
+      search_max_half (i, max_index, bpe, input_data, num_data);
+      break;
     default:
       return GST_FLOW_NOT_SUPPORTED;
   }
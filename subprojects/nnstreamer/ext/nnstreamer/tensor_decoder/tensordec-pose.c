@@ -58,6 +58,21 @@
  *      Available: heatmap-only (default)
  *                 heatmap-offset
  *
+ * option5: Output (optional)
+ *      Available: video (default) RGBA video with the skeleton and labels
+ *                 tensor, float32 tensor 3 : #labels : #peaks with the keypoints,
+ *                        (x, y, score) in the output video dimension (option1)
+ *                        or in the input dimension if option1 is not given.
+ *                        Score 0 means the keypoint is not found.
+ *                        In heatmap-only mode, the position is refined to
+ *                        sub-pixel with the neighbor cells.
+ *
+ * option6: Peaks (optional, tensor output) #peaks[:threshold]
+ *      The number of peaks (local maxima) for each keypoint (e.g., for
+ *      multiple persons, 1 by default for the maximum) and the score
+ *      threshold of the peaks (e.g., 3:0.5). The peaks are sorted by the
+ *      score for each keypoint. They are not grouped into persons.
+ *
  * 	Expected input dims:
  * 		Note: Width, Height are related to heatmap resolution.
  * 		- heatmap-only:
@@ -119,6 +134,7 @@ extern uint8_t rasters[][13];
 
 #define POSE_MD_MAX_LABEL_SZ 16
 #define POSE_MD_MAX_CONNECTIONS_SZ 8
+#define POSE_MAX_PEAKS 64
 
 /**
  * @brief Macro for calculating sigmoid
@@ -145,6 +161,25 @@ static const char *pose_string_modes[] = {
   NULL,
 };
 
+/**
+ * @brief The output format of pose estimation decoder.
+ */
+typedef enum
+{
+  POSE_OUTPUT_VIDEO = 0,
+  POSE_OUTPUT_TENSOR = 1,
+  POSE_OUTPUT_UNKNOWN,
+} pose_outputs;
+
+/**
+ * @brief List of the output formats in string
+ */
+static const char *pose_string_outputs[] = {
+  [POSE_OUTPUT_VIDEO] = "video",
+  [POSE_OUTPUT_TENSOR] = "tensor",
+  NULL,
+};
+
 /**
  * @brief Data structure for key body point description.
  */
@@ -215,6 +250,19 @@ typedef struct
 
   /* From option4 */
   pose_modes mode; /**< The pose estimation decoding mode */
+
+  /* From option5 */
+  pose_outputs output; /**< The output format */
+
+  /* From option6 */
+  guint max_peaks; /**< The number of peaks for each keypoint */
+  gfloat threshold; /**< The score threshold of the peaks */
+  gboolean has_threshold; /**< TRUE if the threshold is given */
+
+  /* Buffers of the peaks, reused for the frames */
+  gfloat *peak_values; /**< The raw values of the peaks (#labels x #peaks) */
+  guint *peak_cells; /**< The heatmap cells of the peaks (#labels x #peaks) */
+  guint num_peaks_alloc; /**< The number of peaks allocated */
 } pose_data;
 
 /**
@@ -336,6 +384,8 @@ pose_init (void **pdata)
   data->total_labels = POSE_SIZE_DEFAULT;
 
   data->mode = HEATMAP_ONLY;
+  data->output = POSE_OUTPUT_VIDEO;
+  data->max_peaks = 1;
 
   initSingleLineSprite (singleLineSprite, rasters, PIXEL_VALUE);
 
@@ -351,6 +401,8 @@ pose_exit (void **pdata)
   if (data->metadata != pose_metadata_default)
     g_free (data->metadata);
 
+  g_free (data->peak_values);
+  g_free (data->peak_cells);
   g_free (*pdata);
   *pdata = NULL;
 }
@@ -419,6 +471,42 @@ pose_setOption (void **pdata, int opNum, const char *param)
     }
     data->mode = mode;
 
+    return TRUE;
+  } else if (opNum == 4) {
+    gint output = find_key_strv (pose_string_outputs, param);
+    if (output == -1) {
+      GST_ERROR ("Output %s is not supported\n", param);
+      return FALSE;
+    }
+    data->output = output;
+
+    return TRUE;
+  } else if (opNum == 5) {
+    gchar **tokens;
+    guint64 peaks;
+
+    data->max_peaks = 1;
+    data->has_threshold = FALSE;
+    if (param == NULL || *param == '\0')
+      return TRUE;
+
+    tokens = g_strsplit (param, ":", 2);
+    peaks = g_ascii_strtoull (tokens[0], NULL, 10);
+    if (peaks == 0 || peaks > POSE_MAX_PEAKS) {
+      GST_ERROR
+          ("mode-option-6 of pose estimation is the number of peaks (1 - %d) with optional threshold (PEAKS:THRESHOLD). The given parameter, \"%s\", is not acceptable.",
+          POSE_MAX_PEAKS, param);
+      g_strfreev (tokens);
+      return FALSE;
+    }
+
+    data->max_peaks = (guint) peaks;
+    if (tokens[1] != NULL) {
+      data->threshold = (gfloat) g_ascii_strtod (tokens[1], NULL);
+      data->has_threshold = TRUE;
+    }
+
+    g_strfreev (tokens);
     return TRUE;
   }
 
@@ -481,6 +569,29 @@ pose_getOutCaps (void **pdata, const GstTensorsConfig * config)
       g_return_val_if_fail (dim[i] == 1, NULL);
   }
 
+  if (data->output == POSE_OUTPUT_TENSOR) {
+    GstTensorsConfig out_config;
+    GstTensorInfo *info;
+
+    gst_tensors_config_init (&out_config);
+    out_config.info.num_tensors = 1;
+
+    info = &out_config.info.info[0];
+    info->type = _NNS_FLOAT32;
+    info->dimension[0] = 3;     /* x, y, score */
+    info->dimension[1] = pose_size;
+    info->dimension[2] = data->max_peaks;
+    info->dimension[3] = 1;
+
+    out_config.rate_n = config->rate_n;
+    out_config.rate_d = config->rate_d;
+
+    caps = gst_tensors_caps_from_config (&out_config);
+    gst_tensors_config_free (&out_config);
+
+    return caps;
+  }
+
   str = g_strdup_printf ("video/x-raw, format = RGBA, " /* Use alpha channel to make the background transparent */
       "width = %u, height = %u", data->width, data->height);
   caps = gst_caps_from_string (str);
@@ -700,23 +811,256 @@ draw (GstMapInfo * out_info, pose_data * data, GArray * results)
   g_free (XYdata);
 }
 
+/**
+ * @brief Find the maximum of all keypoints in one pass over the heatmap.
+ * @param[in] data The pose data, the results are in peak_values and peak_cells.
+ * @param[in] heatmap The heatmap, the keypoints of a cell are contiguous.
+ * @param[in] num_cells The number of cells (width x height) of the heatmap.
+ * @note The loop over the keypoints is branch-free, so that the compiler vectorizes it.
+ */
+static void
+pose_find_maxima (pose_data * data, const gfloat * heatmap, guint num_cells)
+{
+  const guint pose_size = data->total_labels;
+  gfloat *max_val = data->peak_values;
+  guint *max_cell = data->peak_cells;
+  const gfloat *cell;
+  guint c, k;
+
+  memcpy (max_val, heatmap, sizeof (gfloat) * pose_size);
+  memset (max_cell, 0, sizeof (guint) * pose_size);
+
+  cell = heatmap + pose_size;
+  for (c = 1; c < num_cells; c++, cell += pose_size) {
+    for (k = 0; k < pose_size; k++) {
+      const gboolean greater = (cell[k] > max_val[k]);
+
+      max_val[k] = greater ? cell[k] : max_val[k];
+      max_cell[k] = greater ? c : max_cell[k];
+    }
+  }
+}
+
+/**
+ * @brief Check the value is the maximum of the 3x3 neighbor cells.
+ * @note The first cell of a plateau in scan order is the peak.
+ */
+static gboolean
+pose_is_local_max (const gfloat * p, gfloat v, guint x, guint y,
+    guint grid_xsize, guint grid_ysize, guint pose_size)
+{
+  const gssize row = (gssize) grid_xsize * pose_size;
+  gint dx, dy;
+
+  for (dy = -1; dy <= 1; dy++) {
+    if ((dy < 0 && y == 0) || (dy > 0 && y + 1 >= grid_ysize))
+      continue;
+
+    for (dx = -1; dx <= 1; dx++) {
+      gfloat n;
+
+      if ((dx == 0 && dy == 0) || (dx < 0 && x == 0) ||
+          (dx > 0 && x + 1 >= grid_xsize))
+        continue;
+
+      n = p[dy * row + dx * (gssize) pose_size];
+      if (n > v || (n == v && (dy < 0 || (dy == 0 && dx < 0))))
+        return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Find the peaks (local maxima) of all keypoints in one pass over the heatmap.
+ * @param[in] data The pose data, the results are in peak_values and peak_cells sorted by the value.
+ * @param[in] heatmap The heatmap, the keypoints of a cell are contiguous.
+ * @param[in] min_value The minimum raw value of the peaks.
+ */
+static void
+pose_find_peaks (pose_data * data, const gfloat * heatmap, guint grid_xsize,
+    guint grid_ysize, gfloat min_value)
+{
+  const guint pose_size = data->total_labels;
+  const guint peaks = data->max_peaks;
+  const gfloat *cell = heatmap;
+  guint x, y, k, n;
+
+  for (n = 0; n < pose_size * peaks; n++) {
+    data->peak_values[n] = -G_MAXFLOAT;
+    data->peak_cells[n] = G_MAXUINT;
+  }
+
+  for (y = 0; y < grid_ysize; y++) {
+    for (x = 0; x < grid_xsize; x++, cell += pose_size) {
+      for (k = 0; k < pose_size; k++) {
+        gfloat *values = &data->peak_values[k * peaks];
+        guint *cells = &data->peak_cells[k * peaks];
+        const gfloat v = cell[k];
+
+        /* below the threshold or the smallest peak found */
+        if (v < min_value ||
+            (cells[peaks - 1] != G_MAXUINT && v <= values[peaks - 1]))
+          continue;
+
+        if (!pose_is_local_max (cell + k, v, x, y, grid_xsize, grid_ysize,
+                pose_size))
+          continue;
+
+        /* insertion, the peaks are sorted by the value */
+        n = peaks - 1;
+        while (n > 0 && (cells[n - 1] == G_MAXUINT || values[n - 1] < v)) {
+          values[n] = values[n - 1];
+          cells[n] = cells[n - 1];
+          n--;
+        }
+
+        values[n] = v;
+        cells[n] = y * grid_xsize + x;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Get the threshold in the scale of the heatmap.
+ * @note Sigmoid is monotonic, the logits are compared without sigmoid.
+ */
+static gfloat
+pose_get_raw_threshold (pose_data * data)
+{
+  gfloat t = data->threshold;
+
+  if (!data->has_threshold)
+    return -G_MAXFLOAT;
+
+  if (data->mode == HEATMAP_OFFSET) {
+    if (t <= 0.f)
+      return -G_MAXFLOAT;
+    if (t >= 1.f)
+      return G_MAXFLOAT;
+    return logf (t / (1.f - t));
+  }
+
+  return t;
+}
+
+/**
+ * @brief Get the sub-pixel offset of the peak with the quadratic fit of the neighbor cells.
+ */
+static gfloat
+pose_refine (const gfloat * p, gfloat v, guint pos, guint size, gssize stride)
+{
+  gfloat l, r, denom, d;
+
+  if (pos == 0 || pos + 1 >= size)
+    return 0.f;
+
+  l = p[-stride];
+  r = p[stride];
+  denom = l - 2.f * v + r;
+  if (denom >= 0.f)
+    return 0.f;
+
+  d = (l - r) / (2.f * denom);
+  return CLAMP (d, -0.5f, 0.5f);
+}
+
+/**
+ * @brief Get the position (output dimension) and the score of the peak.
+ * @param[out] kp The keypoint (x, y, score).
+ * @return TRUE if the peak is found.
+ */
+static gboolean
+pose_get_keypoint (pose_data * data, const GstTensorsConfig * config,
+    const GstTensorMemory * input, guint index, guint peak, gfloat kp[3])
+{
+  const guint pose_size = data->total_labels;
+  const guint grid_xsize = config->info.info[0].dimension[1];
+  const guint grid_ysize = config->info.info[0].dimension[2];
+  const guint n = index * data->max_peaks + peak;
+  const guint cell = data->peak_cells[n];
+  const gfloat value = data->peak_values[n];
+  guint maxX, maxY, in_w, in_h, out_w, out_h;
+  gfloat posX, posY;
+
+  if (cell == G_MAXUINT)
+    return FALSE;
+
+  maxX = cell % grid_xsize;
+  maxY = cell / grid_xsize;
+
+  in_w = data->i_width ? data->i_width : grid_xsize;
+  in_h = data->i_height ? data->i_height : grid_ysize;
+  out_w = data->width ? data->width : in_w;
+  out_h = data->height ? data->height : in_h;
+
+  if (data->mode == HEATMAP_OFFSET) {
+    const gfloat *offset = (const gfloat *) input[1].data;
+    gsize offsetIdx = (gsize) cell * pose_size * 2 + index;
+
+    posX = (((gfloat) maxX) / MAX (grid_xsize - 1, 1)) * in_w +
+        offset[offsetIdx + pose_size];
+    posY = (((gfloat) maxY) / MAX (grid_ysize - 1, 1)) * in_h +
+        offset[offsetIdx];
+    kp[2] = _sigmoid (value);
+  } else {
+    const gfloat *p = (const gfloat *) input[0].data +
+        (gsize) cell * pose_size + index;
+
+    posX = maxX + pose_refine (p, value, maxX, grid_xsize, pose_size);
+    posY = maxY + pose_refine (p, value, maxY, grid_ysize,
+        (gssize) grid_xsize * pose_size);
+    kp[2] = value;
+  }
+
+  /* Some keypoints can be estimated slightly out of image range */
+  kp[0] = CLAMP (posX * out_w / in_w, 0.f, (gfloat) out_w);
+  kp[1] = CLAMP (posY * out_h / in_h, 0.f, (gfloat) out_h);
+  return TRUE;
+}
+
 /** @brief tensordec-plugin's TensorDecDef callback */
 static GstFlowReturn
 pose_decode (void **pdata, const GstTensorsConfig * config,
     const GstTensorMemory * input, GstBuffer * outbuf)
 {
   pose_data *data = *pdata;
-  const size_t size = (size_t) data->width * data->height * 4;   /* RGBA */
+  size_t size;
   GstMapInfo out_info;
   GstMemory *out_mem;
-  GArray *results = NULL;
-  const GstTensorMemory *detections = NULL;
-  float *arr;
-  int i, j;
-  int grid_xsize, grid_ysize;
-  guint pose_size, index;
+  guint grid_xsize, grid_ysize;
+  guint pose_size, index, num_peaks;
+  gfloat kp[3];
 
   g_assert (outbuf); /** GST Internal Bug */
+
+  pose_size = data->total_labels;
+  grid_xsize = config->info.info[0].dimension[1];
+  grid_ysize = config->info.info[0].dimension[2];
+
+  /* Find the peaks of all keypoints with a pass over the heatmap */
+  num_peaks = pose_size * data->max_peaks;
+  if (data->num_peaks_alloc < num_peaks) {
+    data->peak_values = g_renew (gfloat, data->peak_values, num_peaks);
+    data->peak_cells = g_renew (guint, data->peak_cells, num_peaks);
+    data->num_peaks_alloc = num_peaks;
+  }
+
+  if (data->max_peaks == 1 && !data->has_threshold) {
+    pose_find_maxima (data, (const gfloat *) input[0].data,
+        grid_xsize * grid_ysize);
+  } else {
+    pose_find_peaks (data, (const gfloat *) input[0].data, grid_xsize,
+        grid_ysize, pose_get_raw_threshold (data));
+  }
+
+  if (data->output == POSE_OUTPUT_TENSOR)
+    size = sizeof (gfloat) * 3 * num_peaks;
+  else
+    size = (size_t) data->width * data->height * 4;     /* RGBA */
+
   /* Ensure we have outbuf properly allocated */
   if (gst_buffer_get_size (outbuf) == 0) {
     out_mem = gst_allocator_alloc (NULL, size, NULL);
@@ -731,63 +1075,41 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
     ml_loge ("Cannot map output memory / tensordec-pose.\n");
     return GST_FLOW_ERROR;
   }
-  /** reset the buffer with alpha 0 / black */
+  /** reset the buffer with alpha 0 / black (score 0 for the tensor) */
   memset (out_info.data, 0, size);
 
-  pose_size = data->total_labels;
-
-  grid_xsize = config->info.info[0].dimension[1];
-  grid_ysize = config->info.info[0].dimension[2];
+  if (data->output == POSE_OUTPUT_TENSOR) {
+    gfloat *keypoints = (gfloat *) out_info.data;
+    guint peak;
 
-  results = g_array_sized_new (FALSE, TRUE, sizeof (pose), pose_size);
-  detections = &input[0];
-  arr = detections->data;
-  for (index = 0; index < pose_size; index++) {
-    int maxX = 0;
-    int maxY = 0;
-    float max = G_MINFLOAT;
-    pose p;
-    for (j = 0; j < grid_ysize; j++) {
-      for (i = 0; i < grid_xsize; i++) {
-        float cen = arr[i * pose_size + j * grid_xsize * pose_size + index];
-        if (data->mode == HEATMAP_OFFSET) {
-          cen = _sigmoid (cen);
-        }
-        if (cen > max) {
-          max = cen;
-          maxX = i;
-          maxY = j;
-        }
+    for (peak = 0; peak < data->max_peaks; peak++) {
+      for (index = 0; index < pose_size; index++) {
+        if (pose_get_keypoint (data, config, input, index, peak, kp))
+          memcpy (&keypoints[(peak * pose_size + index) * 3], kp, sizeof (kp));
       }
     }
+  } else {
+    GArray *results;
+
+    results = g_array_sized_new (FALSE, TRUE, sizeof (pose), pose_size);
+    for (index = 0; index < pose_size; index++) {
+      pose p = { 0 };
+
+      /* The first peak is the maximum */
+      if (pose_get_keypoint (data, config, input, index, 0, kp)) {
+        p.valid = TRUE;
+        p.x = (int) kp[0];
+        p.y = (int) kp[1];
+        p.prob = kp[2];
+      }
 
-    p.valid = TRUE;
-    p.prob = max;
-    if (data->mode == HEATMAP_OFFSET) {
-      const gfloat *offset = ((const GstTensorMemory *) &input[1])->data;
-      gfloat offsetX, offsetY, posX, posY;
-      int offsetIdx;
-      offsetIdx = (maxY * grid_xsize + maxX) * pose_size * 2 + index;
-      offsetY = offset[offsetIdx];
-      offsetX = offset[offsetIdx + pose_size];
-      posX = (((gfloat) maxX) / (grid_xsize - 1)) * data->i_width + offsetX;
-      posY = (((gfloat) maxY) / (grid_ysize - 1)) * data->i_height + offsetY;
-      p.x = posX * data->width / data->i_width;
-      p.y = posY * data->height / data->i_height;
-
-    } else {
-      p.x = (maxX * data->width) / data->i_width;
-      p.y = (maxY * data->height) / data->i_height;;
+      g_array_append_val (results, p);
     }
-    /* Some keypoints can be estimated slightly out of image range */
-    p.x = MIN (data->width, (guint) (MAX (0, p.x)));
-    p.y = MIN (data->height, (guint) (MAX (0, p.y)));
 
-    g_array_append_val (results, p);
+    draw (&out_info, data, results);
+    g_array_free (results, TRUE);
   }
 
-  draw (&out_info, data, results);
-  g_array_free (results, TRUE);
   gst_memory_unmap (out_mem, &out_info);
   if (gst_buffer_get_size (outbuf) == 0)
     gst_buffer_append_memory (outbuf, out_mem);
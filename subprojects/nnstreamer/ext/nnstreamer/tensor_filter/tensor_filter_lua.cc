@@ -84,6 +84,7 @@ extern "C" {
 #include <nnstreamer_log.h>
 #include <nnstreamer_util.h>
 #include <tensor_common.h>
+#include <tensor_data.h>
 
 
 namespace nnstreamer
@@ -151,6 +152,15 @@ tensor_index (lua_State *L)
     case _NNS_UINT64:
       value = (double) ((uint64_t *) lt->data)[tidx];
       break;
+    case _NNS_FLOAT16:
+    case _NNS_BFLOAT16:
+    {
+      float temp = 0.0f;
+      gst_tensor_data_raw_half_to_float (
+          ((uint16_t *) lt->data) + tidx, lt->type, &temp, 1);
+      value = (double) temp;
+      break;
+    }
     default:
       throw std::runtime_error ("Error occurred during get tensor value");
       break;
@@ -216,6 +226,14 @@ tensor_newindex (lua_State* L)
       ((uint64_t *) lt->data)[tidx] = (uint64_t) temp;
       break;
     }
+    case _NNS_FLOAT16:
+    case _NNS_BFLOAT16:
+    {
+      float temp = (float) value;
+      gst_tensor_data_raw_float_to_half (
+          &temp, ((uint16_t *) lt->data) + tidx, lt->type, 1);
+      break;
+    }
     default:
       throw std::runtime_error ("Error occurred during set tensor value");
       break;
@@ -161,6 +161,10 @@ TorchCore::init (const GstTensorFilterProperties *prop)
   gst_tensors_info_copy (&inputTensorMeta, &prop->input_meta);
   gst_tensors_info_copy (&outputTensorMeta, &prop->output_meta);
 
+  /* intra-op threads, the thread pool of torch is global in the process */
+  if (prop->num_threads > 0)
+    at::set_num_threads (prop->num_threads);
+
   if (loadModel ()) {
     ml_loge ("Failed to load model\n");
     return -1;
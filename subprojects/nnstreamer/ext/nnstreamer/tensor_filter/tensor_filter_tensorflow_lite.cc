@@ -1254,7 +1254,8 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
   option->model_file = prop->model_files[0];
   option->accelerators = prop->accl_str;
   option->delegate = TFLITE_DELEGATE_NONE;
-  option->num_threads = -1;
+  /* the property num-threads, custom option NumThreads has priority */
+  option->num_threads = (prop->num_threads > 0) ? prop->num_threads : -1;
   option->ext_delegate_path = nullptr;
   option->ext_delegate_kv_table = nullptr;
 
@@ -176,6 +176,14 @@ gst_tensor_src_grpc_class_init (GstTensorSrcGRPCClass * klass)
           "The number of output buffers generated",
           0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_STREAMS,
+      g_param_spec_uint ("streams", "Streams",
+          "The number of concurrent gRPC streams opened by a non-blocking client. "
+          "With more than one stream, the order of buffers is not preserved. "
+          "Ignored in blocking mode and by a server",
+          1, MAX_PROP_STREAMS, DEFAULT_PROP_STREAMS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (gstelement_class, &srctemplate);
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -306,6 +314,8 @@ grpc_config_init (GstTensorSrcGRPC * self)
   grpc->config.dir = GRPC_DIRECTION_BUFFER_TO_TENSORS;
   grpc->config.port = DEFAULT_PROP_PORT;
   grpc->config.host = g_strdup (DEFAULT_PROP_HOST);
+  grpc->config.num_streams = DEFAULT_PROP_STREAMS;
+  grpc->config.max_buffers = DEFAULT_PROP_MAX_BUFFERS;
   grpc->config.cb = _grpc_callback;
   grpc->config.cb_data = (void *) self;
   grpc->config.config = &self->config;
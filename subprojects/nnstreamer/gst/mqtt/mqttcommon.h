@@ -62,6 +62,98 @@ typedef struct _GstMQTTMessageHdr {
   };
 } GstMQTTMessageHdr;
 
+/**
+ * @brief The compact message header (version 1).
+ *
+ * The compact header is an alternative to GstMQTTMessageHdr for small
+ * payloads. All the integers are LEB128 varints and the caps string is
+ * included only if GST_MQTT_COMPACT_FLAG_CAPS is set (i.e., on the first
+ * message, when the caps is changed, and periodically for late subscribers).
+ *
+ *   magic (4 bytes, "NMQC") | version (1 byte) | flags (1 byte) |
+ *   caps_seq | num_mems | size_mems[num_mems] |
+ *   zigzag (base_time_epoch) | zigzag (sent_time_epoch) |
+ *   duration + 1 | dts + 1 | pts + 1 |
+ *   [caps_len | caps string (not null-terminated)] | payload
+ *
+ * The timestamps are incremented by 1 so that GST_CLOCK_TIME_NONE is encoded
+ * as 0 (a single byte). The first 4 bytes of GstMQTTMessageHdr (num_mems) can
+ * never match the magic, so the subscriber may accept both formats.
+ */
+#define GST_MQTT_COMPACT_MAGIC          "NMQC"
+#define GST_MQTT_COMPACT_LEN_MAGIC      4
+#define GST_MQTT_COMPACT_VERSION        1
+#define GST_MQTT_COMPACT_FLAG_CAPS      (1 << 0)
+#define GST_MQTT_MAX_LEN_VARINT         10
+/**
+ * @brief The maximum length of the compact header except the caps string.
+ */
+#define GST_MQTT_MAX_LEN_COMPACT_HDR \
+    (GST_MQTT_COMPACT_LEN_MAGIC + 2 + \
+     GST_MQTT_MAX_LEN_VARINT * (GST_MQTT_MAX_NUM_MEMS + 8))
+
+/**
+ * @brief Encode the given value as a LEB128 varint.
+ * @return The number of bytes written to dst (at most GST_MQTT_MAX_LEN_VARINT).
+ */
+static inline unsigned int
+mqtt_put_varint (uint8_t * dst, uint64_t val)
+{
+  unsigned int len = 0;
+
+  while (val >= 0x80) {
+    dst[len++] = (uint8_t) (val | 0x80);
+    val >>= 7;
+  }
+  dst[len++] = (uint8_t) val;
+
+  return len;
+}
+
+/**
+ * @brief Decode a LEB128 varint and advance the given position.
+ * @return 0 if the varint is valid, -1 if it is truncated or too long.
+ */
+static inline int
+mqtt_get_varint (const uint8_t ** pos, const uint8_t * end, uint64_t * val)
+{
+  const uint8_t *p = *pos;
+  unsigned int shift = 0;
+  uint64_t v = 0;
+
+  while (p < end && shift < 64) {
+    uint8_t b = *p++;
+
+    v |= ((uint64_t) (b & 0x7f)) << shift;
+    if (!(b & 0x80)) {
+      *pos = p;
+      *val = v;
+      return 0;
+    }
+    shift += 7;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Map a signed integer to an unsigned one so that small magnitudes use short varints.
+ */
+static inline uint64_t
+mqtt_zigzag_encode (int64_t val)
+{
+  return ((uint64_t) val << 1) ^ (uint64_t) (val >> 63);
+}
+
+/**
+ * @brief The inverse of mqtt_zigzag_encode ().
+ */
+static inline int64_t
+mqtt_zigzag_decode (uint64_t val)
+{
+  return (int64_t) (val >> 1) ^ -(int64_t) (val & 1);
+}
+
 typedef int64_t (*mqtt_get_unix_epoch)(uint32_t, char **, uint16_t *);
 
 /**
@@ -58,6 +58,8 @@ enum
   PROP_MQTT_QOS,
   PROP_MQTT_NTP_SYNC,
   PROP_MQTT_NTP_SRVS,
+  PROP_COMPACT_HDR,
+  PROP_CAPS_INTERVAL,
 
   PROP_LAST
 };
@@ -75,6 +77,8 @@ enum
   DEFAULT_MAX_MSG_BUF_SIZE = 0, /* Buffer size is not fixed */
   DEFAULT_MQTT_QOS = 0,         /* fire and forget */
   DEFAULT_MQTT_NTP_SYNC = FALSE,
+  DEFAULT_COMPACT_HDR = FALSE,
+  DEFAULT_CAPS_INTERVAL = 30,   /* resend the caps every 30 messages */
   MAX_LEN_PROP_NTP_SRVS = 4096,
 };
 
@@ -146,6 +150,12 @@ static void gst_mqtt_sink_set_mqtt_ntp_sync (GstMqttSink * self,
 static gchar *gst_mqtt_sink_get_mqtt_ntp_srvs (GstMqttSink * self);
 static void gst_mqtt_sink_set_mqtt_ntp_srvs (GstMqttSink * self,
     const gchar * pairs);
+static gboolean gst_mqtt_sink_get_compact_hdr (GstMqttSink * self);
+static void gst_mqtt_sink_set_compact_hdr (GstMqttSink * self,
+    const gboolean flag);
+static guint gst_mqtt_sink_get_caps_interval (GstMqttSink * self);
+static void gst_mqtt_sink_set_caps_interval (GstMqttSink * self,
+    const guint num);
 
 static void cb_mqtt_on_connect (void *context,
     MQTTAsync_successData * response);
@@ -196,6 +206,10 @@ gst_mqtt_sink_init (GstMqttSink * self)
   memset (&self->mqtt_msg_hdr, 0x0, sizeof (self->mqtt_msg_hdr));
   self->base_time_epoch = GST_CLOCK_TIME_NONE;
   self->in_caps = NULL;
+  self->in_caps_str = NULL;
+  self->caps_seq = 0;
+  self->caps_pending = FALSE;
+  self->num_msgs_wo_caps = 0;
 
   /** init mqttsink properties */
   self->debug = DEFAULT_DEBUG;
@@ -216,6 +230,8 @@ gst_mqtt_sink_init (GstMqttSink * self)
   self->mqtt_ntp_num_srvs = 0;
   self->get_epoch_func = default_mqtt_get_unix_epoch;
   self->is_connected = FALSE;
+  self->compact_hdr = DEFAULT_COMPACT_HDR;
+  self->caps_interval = DEFAULT_CAPS_INTERVAL;
 
   /** init basesink properties */
   gst_base_sink_set_qos_enabled (basesink, DEFAULT_QOS);
@@ -318,6 +334,21 @@ gst_mqtt_sink_class_init (GstMqttSinkClass * klass)
           "\t\t\tsee also: https://www.eclipse.org/paho/files/mqttdoc/MQTTAsync/html/qos.html",
           0, 2, DEFAULT_MQTT_QOS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_COMPACT_HDR,
+      g_param_spec_boolean ("compact-header", "Compact message header",
+          "Use the compact (varint-encoded) message header instead of the "
+          "fixed-size one. The caps is sent only when it is changed and "
+          "every caps-interval messages. mqttsrc accepts both formats.",
+          DEFAULT_COMPACT_HDR, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CAPS_INTERVAL,
+      g_param_spec_uint ("caps-interval", "Caps interval",
+          "The number of messages between the repetitions of the caps "
+          "for late subscribers (0 = send the caps only when it is changed). "
+          "Valid only if compact-header is true.",
+          0, G_MAXUINT, DEFAULT_CAPS_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_mqtt_sink_change_state;
 
   gstbasesink_class->start = GST_DEBUG_FUNCPTR (gst_mqtt_sink_start);
@@ -386,6 +417,12 @@ gst_mqtt_sink_set_property (GObject * object, guint prop_id,
     case PROP_MQTT_NTP_SRVS:
       gst_mqtt_sink_set_mqtt_ntp_srvs (self, g_value_get_string (value));
       break;
+    case PROP_COMPACT_HDR:
+      gst_mqtt_sink_set_compact_hdr (self, g_value_get_boolean (value));
+      break;
+    case PROP_CAPS_INTERVAL:
+      gst_mqtt_sink_set_caps_interval (self, g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -441,6 +478,12 @@ gst_mqtt_sink_get_property (GObject * object, guint prop_id,
     case PROP_MQTT_NTP_SRVS:
       g_value_set_string (value, gst_mqtt_sink_get_mqtt_ntp_srvs (self));
       break;
+    case PROP_COMPACT_HDR:
+      g_value_set_boolean (value, gst_mqtt_sink_get_compact_hdr (self));
+      break;
+    case PROP_CAPS_INTERVAL:
+      g_value_set_uint (value, gst_mqtt_sink_get_caps_interval (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -470,7 +513,8 @@ gst_mqtt_sink_class_finalize (GObject * object)
   g_free (self->mqtt_topic);
   self->mqtt_topic = NULL;
   gst_caps_replace (&self->in_caps, NULL);
-  g_free (self->mqtt_msg_buf);
+  g_free (self->in_caps_str);
+  self->in_caps_str = NULL;
   g_free (self->mqtt_ntp_srvs);
   self->mqtt_ntp_srvs = NULL;
   self->mqtt_ntp_num_srvs = 0;
@@ -745,6 +789,40 @@ _mqtt_set_msg_buf_hdr (GstBuffer * gst_buf, GstMQTTMessageHdr * hdr)
   return ret;
 }
 
+/**
+ * @brief A utility function to encode the given header into the compact format
+ * @return The length of the compact header except the caps string
+ */
+static gsize
+_mqtt_build_compact_hdr (GstMqttSink * self, const GstMQTTMessageHdr * hdr,
+    const gboolean with_caps, guint8 * dst)
+{
+  gsize len = 0;
+  guint i;
+
+  memcpy (dst, GST_MQTT_COMPACT_MAGIC, GST_MQTT_COMPACT_LEN_MAGIC);
+  len += GST_MQTT_COMPACT_LEN_MAGIC;
+  dst[len++] = GST_MQTT_COMPACT_VERSION;
+  dst[len++] = with_caps ? GST_MQTT_COMPACT_FLAG_CAPS : 0;
+
+  len += mqtt_put_varint (&dst[len], self->caps_seq);
+  len += mqtt_put_varint (&dst[len], hdr->num_mems);
+  for (i = 0; i < hdr->num_mems; ++i)
+    len += mqtt_put_varint (&dst[len], hdr->size_mems[i]);
+
+  len += mqtt_put_varint (&dst[len], mqtt_zigzag_encode (hdr->base_time_epoch));
+  len += mqtt_put_varint (&dst[len], mqtt_zigzag_encode (hdr->sent_time_epoch));
+  /** GST_CLOCK_TIME_NONE wraps around to 0 */
+  len += mqtt_put_varint (&dst[len], hdr->duration + 1);
+  len += mqtt_put_varint (&dst[len], hdr->dts + 1);
+  len += mqtt_put_varint (&dst[len], hdr->pts + 1);
+
+  if (with_caps)
+    len += mqtt_put_varint (&dst[len], strlen (self->in_caps_str));
+
+  return len;
+}
+
 /**
  * @brief The callback to process each buffer receiving on the sink pad
  */
@@ -756,10 +834,16 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
   GstMqttSink *self = GST_MQTT_SINK (basesink);
   GstFlowReturn ret = GST_FLOW_ERROR;
   mqtt_sink_state_t cur_state;
-  GstMemory *in_buf_mem;
-  GstMapInfo in_buf_map;
+  guint8 compact_hdr[GST_MQTT_MAX_LEN_COMPACT_HDR];
+  gboolean with_caps = FALSE;
+  gsize compact_hdr_len = 0;
+  gsize caps_len = 0;
+  gsize hdr_len;
+  gsize offset;
+  guint num_mems;
   gint mqtt_rc;
   guint8 *msg_pub;
+  guint i;
 
   while ((cur_state =
           g_atomic_int_get (&self->mqtt_sink_state)) != MQTT_CONNECTED) {
@@ -798,9 +882,33 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
     self->num_buffers -= 1;
   }
 
+  if (!_mqtt_set_msg_buf_hdr (in_buf, &self->mqtt_msg_hdr)) {
+    ret = GST_FLOW_ERROR;
+    goto ret_with;
+  }
+
+  if (self->compact_hdr) {
+    if (!self->in_caps_str) {
+      ret = GST_FLOW_NOT_NEGOTIATED;
+      goto ret_with;
+    }
+
+    with_caps = self->caps_pending || ((self->caps_interval > 0) &&
+        (self->num_msgs_wo_caps >= self->caps_interval));
+    if (with_caps)
+      caps_len = strlen (self->in_caps_str);
+
+    _put_timestamp_to_msg_buf_hdr (self, in_buf, &self->mqtt_msg_hdr);
+    compact_hdr_len = _mqtt_build_compact_hdr (self, &self->mqtt_msg_hdr,
+        with_caps, compact_hdr);
+    hdr_len = compact_hdr_len + caps_len;
+  } else {
+    hdr_len = GST_MQTT_LEN_MSG_HDR;
+  }
+
   if ((!is_static_sized_buf) && (self->mqtt_msg_buf) &&
       (self->mqtt_msg_buf_size != 0) &&
-      (self->mqtt_msg_buf_size < in_buf_size + GST_MQTT_LEN_MSG_HDR)) {
+      (self->mqtt_msg_buf_size < in_buf_size + hdr_len)) {
     g_free (self->mqtt_msg_buf);
     self->mqtt_msg_buf = NULL;
     self->mqtt_msg_buf_size = 0;
@@ -809,7 +917,7 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
   /** Allocate a message buffer */
   if ((!self->mqtt_msg_buf) && (self->mqtt_msg_buf_size == 0)) {
     if (self->max_msg_buf_size == 0) {
-      self->mqtt_msg_buf_size = in_buf_size + GST_MQTT_LEN_MSG_HDR;
+      self->mqtt_msg_buf_size = in_buf_size + hdr_len;
     } else {
       if (self->max_msg_buf_size < in_buf_size) {
         g_printerr ("%s: The given size for a message buffer is too small: "
@@ -825,47 +933,66 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
     self->mqtt_msg_buf = g_try_malloc0 (self->mqtt_msg_buf_size);
   }
 
-  if (!_mqtt_set_msg_buf_hdr (in_buf, &self->mqtt_msg_hdr)) {
-    ret = GST_FLOW_ERROR;
-    goto ret_with;
-  }
-
   msg_pub = self->mqtt_msg_buf;
   if (!msg_pub) {
     self->mqtt_msg_buf_size = 0;
     ret = GST_FLOW_ERROR;
     goto ret_with;
   }
-  memcpy (msg_pub, &self->mqtt_msg_hdr, sizeof (self->mqtt_msg_hdr));
-  _put_timestamp_to_msg_buf_hdr (self, in_buf, (GstMQTTMessageHdr *) msg_pub);
 
-  in_buf_mem = gst_buffer_get_all_memory (in_buf);
-  if (!in_buf_mem) {
+  if (self->mqtt_msg_buf_size < in_buf_size + hdr_len) {
+    g_printerr ("%s: The message buffer is too small: given (%" G_GSIZE_FORMAT
+        " bytes) vs. required (%" G_GSIZE_FORMAT " bytes)\n", TAG_ERR_MQTTSINK,
+        self->mqtt_msg_buf_size, in_buf_size + hdr_len);
     ret = GST_FLOW_ERROR;
     goto ret_with;
   }
 
-  if (!gst_memory_map (in_buf_mem, &in_buf_map, GST_MAP_READ)) {
-    ret = GST_FLOW_ERROR;
-    goto ret_unref_in_buf_mem;
+  if (self->compact_hdr) {
+    memcpy (msg_pub, compact_hdr, compact_hdr_len);
+    if (with_caps)
+      memcpy (&msg_pub[compact_hdr_len], self->in_caps_str, caps_len);
+  } else {
+    memcpy (msg_pub, &self->mqtt_msg_hdr, sizeof (self->mqtt_msg_hdr));
+    _put_timestamp_to_msg_buf_hdr (self, in_buf,
+        (GstMQTTMessageHdr *) msg_pub);
+  }
+
+  /**
+   * Gather each memory block right after the header. Merging the memories
+   * with gst_buffer_get_all_memory () costs an extra copy if the buffer has
+   * multiple memories (e.g., other/tensors).
+   */
+  offset = hdr_len;
+  num_mems = gst_buffer_n_memory (in_buf);
+  for (i = 0; i < num_mems; ++i) {
+    GstMemory *each_mem = gst_buffer_peek_memory (in_buf, i);
+    GstMapInfo each_map;
+
+    if (!gst_memory_map (each_mem, &each_map, GST_MAP_READ)) {
+      ret = GST_FLOW_ERROR;
+      goto ret_with;
+    }
+    memcpy (&msg_pub[offset], each_map.data, each_map.size);
+    offset += each_map.size;
+    gst_memory_unmap (each_mem, &each_map);
   }
 
   ret = GST_FLOW_OK;
 
-  memcpy (&msg_pub[sizeof (self->mqtt_msg_hdr)], in_buf_map.data,
-      in_buf_map.size);
   mqtt_rc = MQTTAsync_send (self->mqtt_client_handle, self->mqtt_topic,
-      GST_MQTT_LEN_MSG_HDR + in_buf_map.size, self->mqtt_msg_buf,
-      self->mqtt_qos, 1, &self->mqtt_respn_opts);
+      offset, self->mqtt_msg_buf, self->mqtt_qos, 1, &self->mqtt_respn_opts);
   if (mqtt_rc != MQTTASYNC_SUCCESS) {
     ret = GST_FLOW_ERROR;
+  } else if (self->compact_hdr) {
+    if (with_caps) {
+      self->caps_pending = FALSE;
+      self->num_msgs_wo_caps = 0;
+    } else {
+      self->num_msgs_wo_caps++;
+    }
   }
 
-  gst_memory_unmap (in_buf_mem, &in_buf_map);
-
-ret_unref_in_buf_mem:
-  gst_memory_unref (in_buf_mem);
-
 ret_with:
   return ret;
 }
@@ -934,7 +1061,12 @@ gst_mqtt_sink_set_caps (GstBaseSink * basesink, GstCaps * caps)
 
     strncpy (self->mqtt_msg_hdr.gst_caps_str, caps_str,
         MIN (strlen (caps_str), GST_MQTT_MAX_LEN_GST_CAPS_STR - 1));
-    g_free (caps_str);
+
+    /** The compact header carries the caps only when it is changed */
+    g_free (self->in_caps_str);
+    self->in_caps_str = caps_str;
+    self->caps_seq++;
+    self->caps_pending = TRUE;
   }
 
   return ret;
@@ -1246,6 +1378,43 @@ err_free_pair_arrs:
   return;
 }
 
+/**
+ * @brief Getter for the 'compact-header' property.
+ */
+static gboolean
+gst_mqtt_sink_get_compact_hdr (GstMqttSink * self)
+{
+  return self->compact_hdr;
+}
+
+/**
+ * @brief Setter for the 'compact-header' property.
+ */
+static void
+gst_mqtt_sink_set_compact_hdr (GstMqttSink * self, const gboolean flag)
+{
+  self->compact_hdr = flag;
+  self->caps_pending = TRUE;
+}
+
+/**
+ * @brief Getter for the 'caps-interval' property.
+ */
+static guint
+gst_mqtt_sink_get_caps_interval (GstMqttSink * self)
+{
+  return self->caps_interval;
+}
+
+/**
+ * @brief Setter for the 'caps-interval' property.
+ */
+static void
+gst_mqtt_sink_set_caps_interval (GstMqttSink * self, const guint num)
+{
+  self->caps_interval = num;
+}
+
 /** Callback function definitions */
 /**
  * @brief A callback function corresponding to MQTTAsync_connectOptions's
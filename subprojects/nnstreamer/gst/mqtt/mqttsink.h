@@ -88,6 +88,13 @@ struct _GstMqttSink {
   gpointer mqtt_msg_buf;
   gsize mqtt_msg_buf_size;
 
+  gboolean compact_hdr;
+  guint caps_interval;
+  gchar *in_caps_str;
+  guint64 caps_seq;
+  gboolean caps_pending;
+  guint num_msgs_wo_caps;
+
   MQTTAsync mqtt_client_handle;
   MQTTAsync_connectOptions mqtt_conn_opts;
   MQTTAsync_responseOptions mqtt_respn_opts;
@@ -142,6 +142,8 @@ static void cb_mqtt_on_unsubscribe_failure (void *context,
 
 static void cb_memory_wrapped_destroy (void *p);
 
+static gsize _parse_compact_msg_hdr (const guint8 * data, const gsize size,
+    GstMQTTMessageHdr * hdr, guint64 * caps_seq, gchar ** caps_str);
 static GstMQTTMessageHdr *_extract_mqtt_msg_hdr_from (GstMemory * mem,
     GstMemory ** hdr_mem, GstMapInfo * hdr_map_info);
 static void _put_timestamp_on_gst_buf (GstMqttSrc * self,
@@ -210,6 +212,8 @@ gst_mqtt_src_init (GstMqttSrc * self)
   g_mutex_unlock (&self->mqtt_src_mutex);
   self->base_time_epoch = GST_CLOCK_TIME_NONE;
   self->caps = NULL;
+  self->caps_seq = 0;
+  self->has_caps_seq = FALSE;
   self->num_dumped = 0;
 
   gst_base_src_set_live (basesrc, self->is_live);
@@ -1090,13 +1094,17 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
   const int size = message->payloadlen;
   guint8 *data = message->payload;
   GstMQTTMessageHdr *mqtt_msg_hdr;
+  GstMQTTMessageHdr compact_msg_hdr;
   GstMapInfo hdr_map_info;
   GstMemory *received_mem;
-  GstMemory *hdr_mem;
+  GstMemory *hdr_mem = NULL;
   GstBuffer *buffer;
   GstBaseSrc *basesrc;
   GstMqttSrc *self;
   GstClock *clock;
+  const gchar *caps_str;
+  gchar *compact_caps_str = NULL;
+  guint64 caps_seq = 0;
   gsize offset;
   guint i;
   UNUSED (topic_name);
@@ -1112,7 +1120,6 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
   g_mutex_unlock (&self->mqtt_src_mutex);
 
   basesrc = GST_BASE_SRC (self);
-  clock = gst_element_get_clock (GST_ELEMENT (self));
   received_mem = gst_memory_new_wrapped (0, data, size, 0, size, message,
       (GDestroyNotify) cb_memory_wrapped_destroy);
   if (!received_mem) {
@@ -1124,22 +1131,53 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
     return TRUE;
   }
 
-  mqtt_msg_hdr = _extract_mqtt_msg_hdr_from (received_mem, &hdr_mem,
-      &hdr_map_info);
-  if (!mqtt_msg_hdr) {
-    if (!self->err) {
-      self->err = g_error_new (self->gquark_err_tag, ENODATA,
-          "%s: failed to extract header information from received message: %s",
-          __func__, g_strerror (ENODATA));
+  if ((size >= GST_MQTT_COMPACT_LEN_MAGIC) && (memcmp (data,
+              GST_MQTT_COMPACT_MAGIC, GST_MQTT_COMPACT_LEN_MAGIC) == 0)) {
+    offset = _parse_compact_msg_hdr (data, size, &compact_msg_hdr, &caps_seq,
+        &compact_caps_str);
+    if (offset == 0) {
+      if (!self->err) {
+        self->err = g_error_new (self->gquark_err_tag, EBADMSG,
+            "%s: failed to parse the compact header of received message: %s",
+            __func__, g_strerror (EBADMSG));
+      }
+      goto ret_unref_received_mem;
+    }
+    mqtt_msg_hdr = &compact_msg_hdr;
+    caps_str = compact_caps_str;
+
+    /** The caps is omitted unless it is changed. Wait for the next caps */
+    if (!caps_str && (!self->caps || !self->has_caps_seq ||
+            self->caps_seq != caps_seq)) {
+      GST_DEBUG_OBJECT (self,
+          "%s: Dropped a message while waiting for the caps (seq %"
+          G_GUINT64_FORMAT ")", self->mqtt_topic, caps_seq);
+      goto ret_unref_received_mem;
     }
-    goto ret_unref_received_mem;
+    self->caps_seq = caps_seq;
+    self->has_caps_seq = TRUE;
+  } else {
+    mqtt_msg_hdr = _extract_mqtt_msg_hdr_from (received_mem, &hdr_mem,
+        &hdr_map_info);
+    if (!mqtt_msg_hdr) {
+      if (!self->err) {
+        self->err = g_error_new (self->gquark_err_tag, ENODATA,
+            "%s: failed to extract header information from received message: %s",
+            __func__, g_strerror (ENODATA));
+      }
+      goto ret_unref_received_mem;
+    }
+    offset = GST_MQTT_LEN_MSG_HDR;
+    caps_str = mqtt_msg_hdr->gst_caps_str;
+    self->has_caps_seq = FALSE;
   }
 
-  if (!self->caps) {
-    self->caps = gst_caps_from_string (mqtt_msg_hdr->gst_caps_str);
+  /** caps_str is NULL if the caps is not changed (compact header) */
+  if (caps_str && !self->caps) {
+    self->caps = gst_caps_from_string (caps_str);
     gst_mqtt_src_renegotiate (basesrc);
-  } else {
-    GstCaps *recv_caps = gst_caps_from_string (mqtt_msg_hdr->gst_caps_str);
+  } else if (caps_str) {
+    GstCaps *recv_caps = gst_caps_from_string (caps_str);
 
     if (recv_caps && !gst_caps_is_equal (self->caps, recv_caps)) {
       gst_caps_replace (&self->caps, recv_caps);
@@ -1150,7 +1188,6 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
   }
 
   buffer = gst_buffer_new ();
-  offset = GST_MQTT_LEN_MSG_HDR;
   for (i = 0; i < mqtt_msg_hdr->num_mems; ++i) {
     GstMemory *each_memory;
     int each_size;
@@ -1165,6 +1202,7 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
   if (self->debug) {
     GstClockTime base_time = gst_element_get_base_time (GST_ELEMENT (self));
 
+    clock = gst_element_get_clock (GST_ELEMENT (self));
     if (clock) {
       GST_DEBUG_OBJECT (self,
           "A message has been arrived at %" GST_TIME_FORMAT
@@ -1178,10 +1216,13 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
   _put_timestamp_on_gst_buf (self, mqtt_msg_hdr, buffer);
   g_async_queue_push (self->aqueue, buffer);
 
-  gst_memory_unmap (hdr_mem, &hdr_map_info);
-  gst_memory_unref (hdr_mem);
+  if (hdr_mem) {
+    gst_memory_unmap (hdr_mem, &hdr_map_info);
+    gst_memory_unref (hdr_mem);
+  }
 
 ret_unref_received_mem:
+  g_free (compact_caps_str);
   gst_memory_unref (received_mem);
 
   return TRUE;
@@ -1355,6 +1396,76 @@ _unsubscribe (GstMqttSrc * self)
   return TRUE;
 }
 
+/**
+ * @brief A utility function to parse the compact header of a received message
+ * @return The offset of the payload, 0 if the header is invalid
+ */
+static gsize
+_parse_compact_msg_hdr (const guint8 * data, const gsize size,
+    GstMQTTMessageHdr * hdr, guint64 * caps_seq, gchar ** caps_str)
+{
+  const guint8 *pos = data + GST_MQTT_COMPACT_LEN_MAGIC;
+  const guint8 *end = data + size;
+  gsize total = 0;
+  guint64 val;
+  guint8 flags;
+  guint i;
+
+  *caps_str = NULL;
+  if (size < GST_MQTT_COMPACT_LEN_MAGIC + 2)
+    return 0;
+
+  if (*pos++ != GST_MQTT_COMPACT_VERSION)
+    return 0;
+  flags = *pos++;
+
+  if (mqtt_get_varint (&pos, end, caps_seq) != 0)
+    return 0;
+  if (mqtt_get_varint (&pos, end, &val) != 0 || val > GST_MQTT_MAX_NUM_MEMS)
+    return 0;
+
+  hdr->num_mems = (guint) val;
+  for (i = 0; i < hdr->num_mems; ++i) {
+    if (mqtt_get_varint (&pos, end, &val) != 0 || val > size)
+      return 0;
+    hdr->size_mems[i] = (gsize) val;
+    total += hdr->size_mems[i];
+  }
+
+  if (mqtt_get_varint (&pos, end, &val) != 0)
+    return 0;
+  hdr->base_time_epoch = mqtt_zigzag_decode (val);
+  if (mqtt_get_varint (&pos, end, &val) != 0)
+    return 0;
+  hdr->sent_time_epoch = mqtt_zigzag_decode (val);
+
+  /** 0 is decoded to GST_CLOCK_TIME_NONE */
+  if (mqtt_get_varint (&pos, end, &val) != 0)
+    return 0;
+  hdr->duration = val - 1;
+  if (mqtt_get_varint (&pos, end, &val) != 0)
+    return 0;
+  hdr->dts = val - 1;
+  if (mqtt_get_varint (&pos, end, &val) != 0)
+    return 0;
+  hdr->pts = val - 1;
+
+  if (flags & GST_MQTT_COMPACT_FLAG_CAPS) {
+    if (mqtt_get_varint (&pos, end, &val) != 0 || val > (guint64) (end - pos))
+      return 0;
+    *caps_str = g_strndup ((const gchar *) pos, (gsize) val);
+    pos += val;
+  }
+
+  if (total != (gsize) (end - pos)) {
+    g_free (*caps_str);
+    *caps_str = NULL;
+    return 0;
+  }
+
+  return (gsize) (pos - data);
+}
+
 /**
  * @brief A utility function to extract header information from a received message
  */
@@ -46,6 +46,8 @@ typedef struct _GstMqttSrcClass GstMqttSrcClass;
 struct _GstMqttSrc {
   GstBaseSrc parent;
   GstCaps *caps;
+  guint64 caps_seq;
+  gboolean has_caps_seq;
   GQuark gquark_err_tag;
   GError *err;
   gint64 base_time_epoch;
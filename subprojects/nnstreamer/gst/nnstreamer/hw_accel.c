@@ -24,6 +24,12 @@
 #endif /* __TIZEN__ */
 #endif /* __arch64__ || __arm__ */
 
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(__GNUC__)
+#include <cpuid.h>
+#endif /* __GNUC__ */
+#endif /* __x86_64__ || __i386__ */
+
 #if !defined(__APPLE__)
 #include <sys/auxv.h>
 #else
@@ -62,3 +68,72 @@ cpu_neon_accel_available (void)
 
   return neon_available;
 }
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+/**
+ * @brief Check if the OS saves the given register states (XCR0 bits)
+ */
+static gboolean
+cpu_x86_os_supports (guint xcr0_mask)
+{
+  guint eax, ebx, ecx, edx, xcr0_lo, xcr0_hi;
+
+  if (!__get_cpuid (1, &eax, &ebx, &ecx, &edx))
+    return FALSE;
+
+  /* OSXSAVE */
+  if (!(ecx & (1U << 27)))
+    return FALSE;
+
+  __asm__ volatile ("xgetbv":"=a" (xcr0_lo), "=d" (xcr0_hi):"c" (0));
+  (void) xcr0_hi;
+
+  return (xcr0_lo & xcr0_mask) == xcr0_mask;
+}
+#endif /* (__x86_64__ || __i386__) && __GNUC__ */
+
+/**
+ * @brief Check if F16C (float16 conversion) is supported
+ * @retval 0 if supported, else -errno
+ */
+gint
+cpu_f16c_accel_available (void)
+{
+  gint f16c_available = -EINVAL;
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  guint eax, ebx, ecx, edx;
+
+  /* F16C (ecx bit 29) and AVX (ecx bit 28), with SSE and AVX states enabled */
+  if (__get_cpuid (1, &eax, &ebx, &ecx, &edx) &&
+      (ecx & (1U << 29)) && (ecx & (1U << 28)) && cpu_x86_os_supports (0x6)) {
+    f16c_available = 0;
+  }
+#endif /* (__x86_64__ || __i386__) && __GNUC__ */
+
+  return f16c_available;
+}
+
+/**
+ * @brief Check if AVX512-BF16 (bfloat16 conversion) is supported
+ * @retval 0 if supported, else -errno
+ */
+gint
+cpu_avx512bf16_accel_available (void)
+{
+  gint bf16_available = -EINVAL;
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  guint eax, ebx, ecx, edx;
+
+  /* AVX512F (leaf 7, ebx bit 16) and AVX512-BF16 (leaf 7 sub-leaf 1, eax bit 5) */
+  if (__get_cpuid_count (7, 0, &eax, &ebx, &ecx, &edx) &&
+      (ebx & (1U << 16)) && eax >= 1 &&
+      __get_cpuid_count (7, 1, &eax, &ebx, &ecx, &edx) && (eax & (1U << 5)) &&
+      cpu_x86_os_supports (0xe6)) {
+    bf16_available = 0;
+  }
+#endif /* (__x86_64__ || __i386__) && __GNUC__ */
+
+  return bf16_available;
+}
@@ -24,4 +24,16 @@
  */
 gint cpu_neon_accel_available (void);
 
+/**
+ * @brief Check if F16C (float16 conversion) is supported
+ * @retval 0 if supported, else -errno
+ */
+gint cpu_f16c_accel_available (void);
+
+/**
+ * @brief Check if AVX512-BF16 (bfloat16 conversion) is supported
+ * @retval 0 if supported, else -errno
+ */
+gint cpu_avx512bf16_accel_available (void);
+
 #endif /* __G_HW_ACCEL__ */
@@ -96,6 +96,35 @@ typedef struct _GstTensorDecoderDef
        */
 } GstTensorDecoderDef;
 
+/**
+ * @brief Optional callbacks of decoder sub-plugin to handle the buffers directly.
+ * @note These are not in GstTensorDecoderDef, to keep its layout for the sub-plugins built with the older headers. Register them with nnstreamer_decoder_probe_buffer().
+ */
+typedef struct
+{
+  int (*decideAllocation) (void **private_data, const GstTensorsConfig *config,
+      GstQuery *query);
+      /**< Optional. Called when downstream has answered the allocation query, after the caps are negotiated.
+       * The sub-plugin may check the metas downstream supports (e.g., GST_VIDEO_META_API_TYPE) to decide how to lay out the output data.
+       *
+       * @param[in/out] private_data A sub-plugin may save its internal private data here. The sub-plugin is responsible for alloc/free of this pointer.
+       * @param[in] config The structure of input tensor info.
+       * @param[in] query The allocation query answered by downstream.
+       * @return TRUE if OK. FALSE if error.
+       */
+  GstFlowReturn (*decodeBuffer) (void **private_data,
+      const GstTensorsConfig *config, GstBuffer *inbuf, GstBuffer *outbuf);
+      /**< Optional. If this is defined, tensor_decoder calls this instead of decode of GstTensorDecoderDef.
+       * outbuf is always empty and does not come from the buffer pool of downstream. The sub-plugin may append the memories of inbuf to outbuf (gst_memory_share ()) to avoid copying the tensor data.
+       *
+       * @param[in/out] private_data A sub-plugin may save its internal private data here. The sub-plugin is responsible for alloc/free of this pointer.
+       * @param[in] config The structure of input tensor info.
+       * @param[in] inbuf The input buffer holding the tensors. Do not modify the memories of inbuf.
+       * @param[out] outbuf A sub-plugin should append proper memory for the negotiated media type.
+       * @return GST_FLOW_OK if OK.
+       */
+} GstTensorDecoderBufferDef;
+
 /* extern functions for subplugin management, exist in tensor_decoder.c */
 /**
  * @brief Decoder's sub-plugin should call this function to register itself.
@@ -105,6 +134,16 @@ typedef struct _GstTensorDecoderDef
 extern int
 nnstreamer_decoder_probe (GstTensorDecoderDef * decoder);
 
+/**
+ * @brief Decoder's sub-plugin may call this function instead of nnstreamer_decoder_probe() to register itself with the callbacks handling the buffers directly.
+ * @param[in] decoder Decoder sub-plugin to be registered.
+ * @param[in] buffer_def The callbacks handling the buffers. It should be valid until the sub-plugin is unregistered.
+ * @return TRUE if registered. FALSE is failed or duplicated.
+ */
+extern int
+nnstreamer_decoder_probe_buffer (GstTensorDecoderDef * decoder,
+    const GstTensorDecoderBufferDef * buffer_def);
+
 /**
  * @brief Decoder's sub-plugin may call this to unregister itself.
  * @param[in] name The name of decoder sub-plugin.
@@ -161,6 +161,10 @@ typedef struct _GstTensorFilterProperties
 
   int latency; /**< The average latency over the recent 10 inferences in microseconds */
   int throughput; /**< The average throughput in the number of outputs per second */
+
+  int num_threads; /**< The number of intra-op threads for the invoke (0 for the default of the framework). Sub-plugins are supposed to use this unless the custom property gives the number. */
+  int numa_node; /**< The NUMA node to run the model (-1 if not given). tensor_filter pins the invoke thread to the cpus of the node and prefers the memory of the node. */
+  const char *cpu_affinity; /**< The list of cpus to run the model (e.g., "0-3,8", NULL if not given). tensor_filter pins the invoke thread, the threads created by the sub-plugin in open or invoke inherit it. */
 } GstTensorFilterProperties;
 
 /**
@@ -182,7 +186,7 @@ typedef struct _GstTensorFilterFrameworkStatistics
 typedef struct _GstTensorFilterFrameworkInfo
 {
   const char *name; /**< Name of the neural network framework, searchable by FRAMEWORK property. Subplugin is supposed to allocate/deallocate. */
-  int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
+  int allow_in_place; /**< TRUE(nonzero) if invoke may write the output tensors over the input tensors (the data pointers of input and output are aliased). tensor_filter invokes in-place when each output tensor has the same size as the input tensor and the input buffer is writable (otherwise, the input is copied). The value may be updated with the opened model (getFrameworkInfo with private_data). */
   int allocate_in_invoke; /**< TRUE(nonzero) if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
   int run_without_model; /**< TRUE(nonzero) when the neural network framework does not need a model file. Tensor-filter will run invoke_NN without model. */
   int verify_model_path; /**< TRUE(nonzero) when the NNS framework, not the sub-plugin, should verify the path of model files. */
@@ -306,7 +310,7 @@ struct _GstTensorFilterFramework
     struct /** _GstTensorFilterFramework_v0 */
     {
       char *name; /**< Name of the neural network framework, searchable by FRAMEWORK property */
-      int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
+      int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Ignored for V0, tensor_filter never invokes V0 subplugins in-place. Use allow_in_place of GstTensorFilterFrameworkInfo (V1). */
       int allocate_in_invoke; /**< TRUE(nonzero) if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
       int run_without_model; /**< TRUE(nonzero) when the neural network framework does not need a model file. Tensor-filter will run invoke_NN without model. */
       int verify_model_path; /**< TRUE(nonzero) when the NNS framework, not the sub-plugin, should verify the path of model files. */
@@ -615,6 +619,54 @@ extern void
 nnstreamer_filter_shared_model_replace (void *instance, const char *key,
     void *new_interpreter, void (*replace_callback) (void *, void *), void (*free_callback) (void*));
 
+/* extern functions for the artifact cache */
+/**
+ * @brief Get the path of the cached artifact for the opened model.
+ * @details Subplugins may persist compiled or packed artifacts (e.g., a compiled graph, packed weights or a delegate cache) to skip the expensive steps at the next open.
+ *          The cache key is derived from the framework name, the path, size and modification time of each model file, the accelerator configuration and the given tag.
+ *          Thus, the artifact is invalidated if the model or the accelerator is changed.
+ *          The cache directory is "[filter] cache_dir" of the nnstreamer configuration or the user cache directory (e.g., ~/.cache/nnstreamer/filter-cache) by default.
+ * @param[in] prop The properties of tensor-filter. fwname and model_files are required.
+ * @param[in] tag The name of the artifact to distinguish multiple artifacts of a model (e.g., "xnnpack"). May be NULL.
+ * @return Newly allocated path of the artifact, which may not exist. NULL if failed. Caller should free it with g_free().
+ * @note Subplugins that let the framework write its own cache files may use this path as the cache file or directory.
+ */
+extern char *
+nnstreamer_filter_cache_get_path (const GstTensorFilterProperties * prop, const char *tag);
+
+/**
+ * @brief Map the cached artifact of the opened model.
+ * @param[in] prop The properties of tensor-filter.
+ * @param[in] tag The name of the artifact. May be NULL.
+ * @param[out] data The read-only memory of the artifact.
+ * @param[out] size The size of the artifact.
+ * @return The handle of the mapped artifact. NULL if there is no valid artifact. Release it with nnstreamer_filter_cache_release().
+ * @note The data is mapped (mmap) from the cache file, thus it is not copied and valid until it is released.
+ */
+extern void *
+nnstreamer_filter_cache_load (const GstTensorFilterProperties * prop, const char *tag,
+    const void **data, size_t *size);
+
+/**
+ * @brief Release the artifact mapped by nnstreamer_filter_cache_load().
+ * @param[in] handle The handle of the mapped artifact.
+ */
+extern void
+nnstreamer_filter_cache_release (void *handle);
+
+/**
+ * @brief Store the artifact of the opened model to the cache.
+ * @param[in] prop The properties of tensor-filter.
+ * @param[in] tag The name of the artifact. May be NULL.
+ * @param[in] data The artifact to be stored.
+ * @param[in] size The size of the artifact.
+ * @return 0 if stored. Negative errno if failed.
+ * @note The file is replaced atomically, so the other instances loading the same artifact are not affected.
+ */
+extern int
+nnstreamer_filter_cache_store (const GstTensorFilterProperties * prop, const char *tag,
+    const void *data, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -388,6 +388,7 @@ gst_tensor_meta_info_get_header_size (GstTensorMetaInfo * meta);
  * @brief Get the data size calculated from tensor meta.
  * @param[in] meta tensor meta structure
  * @return The data size for meta info (0 if meta is invalid)
+ * @note The size of sparse tensor is calculated with COO encoding. Use gst_tensor_meta_info_get_data_size_from_header() for the other encodings.
  */
 extern gsize
 gst_tensor_meta_info_get_data_size (GstTensorMetaInfo * meta);
@@ -411,6 +412,37 @@ gst_tensor_meta_info_update_header (GstTensorMetaInfo * meta, gpointer header);
 extern gboolean
 gst_tensor_meta_info_parse_header (GstTensorMetaInfo * meta, gpointer header);
 
+/**
+ * @brief Get the sparse encoding from the header of sparse tensor.
+ * @param[in] header pointer to header of sparse tensor
+ * @param[out] encoding pointer to get the encoding (tensor_sparse_encoding)
+ * @param[out] block_size pointer to get the number of elements in a block (0 if it is not block encoding)
+ * @return TRUE if the header has a valid sparse encoding
+ * @note The encoding is written in the header only (COO in the header of old version), GstTensorMetaInfo does not have it.
+ */
+extern gboolean
+gst_tensor_meta_info_get_sparse_encoding (gpointer header, guint * encoding, guint * block_size);
+
+/**
+ * @brief Write the sparse encoding in the header of sparse tensor.
+ * @param[in,out] header pointer to header of sparse tensor
+ * @param[in] encoding the encoding (tensor_sparse_encoding)
+ * @param[in] block_size the number of elements in a block with block encoding
+ * @return TRUE if successfully set the encoding
+ * @note gst_tensor_meta_info_update_header() clears the encoding (COO), set it after updating the header.
+ */
+extern gboolean
+gst_tensor_meta_info_set_sparse_encoding (gpointer header, guint encoding, guint block_size);
+
+/**
+ * @brief Get the data size calculated from the header of tensor.
+ * @param[in] header pointer to header of tensor
+ * @return The data size (0 if the header is invalid)
+ * @note The sparse encoding in the header is applied to the size of sparse tensor.
+ */
+extern gsize
+gst_tensor_meta_info_get_data_size_from_header (gpointer header);
+
 /**
  * @brief Convert GstTensorMetaInfo structure to GstTensorInfo.
  * @param[in] meta tensor meta structure to be converted
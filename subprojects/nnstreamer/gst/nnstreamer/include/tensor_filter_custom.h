@@ -140,4 +140,11 @@ typedef struct _NNStreamer_custom_class NNStreamer_custom_class;
  */
 extern NNStreamer_custom_class *NNStreamer_custom;
 
+/**
+ * @brief A custom filter MAY define NNStreamer_custom_allow_in_place with nonzero value if invoke can write the output tensors over the input tensors (input[i].data may be equal to output[i].data).
+ * tensor_filter invokes in-place when each output tensor has the same size as the input tensor. Ignored with allocate_invoke.
+ * @note This is a separate symbol, not a member of NNStreamer_custom_class, so that the custom filters built with the older headers keep working.
+ */
+extern int NNStreamer_custom_allow_in_place;
+
 #endif /*__NNS_TENSOR_FILTER_CUSTOM_H__*/
@@ -63,6 +63,20 @@ extern int NNS_custom_easy_register (const char * modelname,
     NNS_custom_invoke func, void *data,
     const GstTensorsInfo * in_info, const GstTensorsInfo * out_info);
 
+/**
+ * @brief Register the custom-easy tensor function which can run in-place.
+ * @param[in] modelname The name of custom-easy tensor function.
+ * @param[in] func The tensor function body
+ * @param[in/out] private_data The internal data for the function
+ * @param[in] in_info Input tensor metadata.
+ * @param[in] out_info Output tensor metadata
+ * @note Same as NNS_custom_easy_register(), but func should work even if the output tensor is the input tensor (output[i].data == input[i].data).
+ *       tensor_filter writes the output over the input buffer if each output tensor has the same size as the input tensor, which saves an allocation for each frame.
+ */
+extern int NNS_custom_easy_register_in_place (const char * modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info);
+
 /**
  * @brief Unregister the custom-easy tensor function.
  * @param[in] modelname The registered name of custom-easy tensor function.
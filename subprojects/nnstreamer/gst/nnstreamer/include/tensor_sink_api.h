@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-Sink
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	tensor_sink_api.h
+ * @date	18 Oct 2026
+ * @brief	NNStreamer APIs for the applications to get the data from tensor_sink without the signals
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ *
+ */
+
+/**
+ * SECTION:element-tensor_sink
+ *
+ * How To for NNdevelopers:
+ *
+ * 1. Construct the pipeline with tensor_sink and get the element.
+ * 2. Set the callbacks with "gst_tensor_sink_set_callbacks", or set "max-buffers" and pull the buffers in the app thread.
+ * 3. Link the app with libnnstreamer (pkg-config nnstreamer).
+ *
+ * Usage example of the ring buffer
+ * @code
+ * GstBuffer *buffers[64];
+ * guint i, n;
+ *
+ * g_object_set (sink, "max-buffers", 256, "emit-signal", FALSE, NULL);
+ * ...
+ * while ((n = gst_tensor_sink_try_pull_many (GST_TENSOR_SINK (sink), buffers, 64, GST_SECOND)) > 0) {
+ *   for (i = 0; i < n; i++) {
+ *     // handle the buffer
+ *     gst_buffer_unref (buffers[i]);
+ *   }
+ * }
+ * @endcode
+ */
+#ifndef __NNS_TENSOR_SINK_API_H__
+#define __NNS_TENSOR_SINK_API_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_SINK \
+  (gst_tensor_sink_get_type())
+#define GST_TENSOR_SINK(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_SINK,GstTensorSink))
+#define GST_IS_TENSOR_SINK(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_SINK))
+
+typedef struct _GstTensorSink GstTensorSink;
+
+/**
+ * @brief Callbacks to get the data from tensor_sink without the signals.
+ *
+ * The callbacks are called in the streaming thread. If the callbacks are set, tensor_sink does not emit the signals.
+ */
+typedef struct
+{
+  void (*new_data) (GstTensorSink * sink, GstBuffer * buffer, gpointer user_data); /**< called when new data received */
+  void (*stream_start) (GstTensorSink * sink, gpointer user_data); /**< called when stream started */
+  void (*eos) (GstTensorSink * sink, gpointer user_data); /**< called when end of stream reached */
+
+  /*< private >*/
+  gpointer _reserved[4]; /**< reserved for the future callbacks */
+} GstTensorSinkCallbacks;
+
+/**
+ * @brief Function to get type of tensor_sink.
+ */
+extern GType
+gst_tensor_sink_get_type (void);
+
+/**
+ * @brief Set the callbacks to get the data from tensor_sink.
+ * @param sink tensor_sink instance
+ * @param callbacks the callbacks (NULL to unset)
+ * @param user_data user data passed to the callbacks
+ * @param notify function to free user data when the callbacks are replaced or tensor_sink is finalized
+ */
+extern void
+gst_tensor_sink_set_callbacks (GstTensorSink * sink,
+    const GstTensorSinkCallbacks * callbacks, gpointer user_data,
+    GDestroyNotify notify);
+
+/**
+ * @brief Pull a buffer from the ring, wait until a buffer is available.
+ * @param sink tensor_sink instance
+ * @return the buffer (the caller should unref it), NULL when end of stream reached or flushing.
+ */
+extern GstBuffer *
+gst_tensor_sink_pull (GstTensorSink * sink);
+
+/**
+ * @brief Pull a buffer from the ring with timeout.
+ * @param sink tensor_sink instance
+ * @param timeout the maximum time to wait (0 not to wait, GST_CLOCK_TIME_NONE to wait until a buffer is available)
+ * @return the buffer (the caller should unref it), NULL when timeout, end of stream reached or flushing.
+ */
+extern GstBuffer *
+gst_tensor_sink_try_pull (GstTensorSink * sink, GstClockTime timeout);
+
+/**
+ * @brief Pull the buffers from the ring with a wakeup. Wait until a buffer is available, and get all available buffers up to max.
+ * @param sink tensor_sink instance
+ * @param buffers array to get the buffers (the caller should unref them)
+ * @param max the size of array
+ * @param timeout the maximum time to wait (0 not to wait, GST_CLOCK_TIME_NONE to wait until a buffer is available)
+ * @return the number of buffers, 0 when timeout, end of stream reached or flushing.
+ */
+extern guint
+gst_tensor_sink_try_pull_many (GstTensorSink * sink, GstBuffer ** buffers,
+    guint max, GstClockTime timeout);
+
+G_END_DECLS
+#endif /*__NNS_TENSOR_SINK_API_H__*/
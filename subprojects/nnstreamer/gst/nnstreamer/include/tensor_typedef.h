@@ -59,7 +59,7 @@
 /**
  * @brief Possible tensor element types
  */
-#define GST_TENSOR_TYPE_ALL "{ float32, float64, int64, uint64, int32, uint32, int16, uint16, int8, uint8 }"
+#define GST_TENSOR_TYPE_ALL "{ float16, bfloat16, float32, float64, int64, uint64, int32, uint32, int16, uint16, int8, uint8 }"
 
 /**
  * @brief Possible tensor formats
@@ -162,6 +162,8 @@ typedef enum _nns_tensor_type
   _NNS_FLOAT32,
   _NNS_INT64,
   _NNS_UINT64,
+  _NNS_FLOAT16, /**< IEEE 754 half precision (binary16), stored as uint16_t */
+  _NNS_BFLOAT16, /**< bfloat16 (upper 16 bits of float32), stored as uint16_t */
 
   _NNS_END,
 } tensor_type;
@@ -198,8 +200,22 @@ typedef enum _tensor_format
   _NNS_TENSOR_FORMAT_END
 } tensor_format;
 
+/**
+ * @brief Encoding of the sparse tensor data.
+ * @note The encoding is written in the header of sparse tensor, not in GstTensorMetaInfo (see gst_tensor_meta_info_get_sparse_encoding()).
+ */
+typedef enum _tensor_sparse_encoding
+{
+  _NNS_SPARSE_ENCODING_COO = 0, /**< values and uint32 indices of non-zero elements */
+  _NNS_SPARSE_ENCODING_BITMAP, /**< 64-bit bitmap words of non-zero elements and values */
+  _NNS_SPARSE_ENCODING_BLOCK, /**< values of non-zero blocks and uint32 block indices */
+
+  _NNS_SPARSE_ENCODING_END
+} tensor_sparse_encoding;
+
 /**
  * @brief To make the code simple with all the types. "C++ Template"-like.
+ * float16 and bfloat16 have no native C type, their bits are kept in _uint16_t.
  */
 typedef union {
   int32_t _int32_t;
@@ -265,7 +281,7 @@ typedef struct
  */
 typedef struct
 {
-  uint32_t nnz; /**< the number of "non-zero" elements */
+  uint32_t nnz; /**< the number of "non-zero" elements (non-zero blocks with block encoding) */
 } GstSparseTensorInfo;
 
 /**
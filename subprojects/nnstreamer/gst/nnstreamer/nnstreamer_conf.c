@@ -103,6 +103,11 @@ typedef struct
 
 static confdata conf = { 0 };
 
+/**
+ * @brief Internal cache for the custom key-values
+ */
+static GHashTable *custom_table = NULL;
+
 /**
  * @brief Parse string to get boolean value.
  */
@@ -346,6 +351,10 @@ nnsconf_loadconf (gboolean force_reload)
 
     /* init with 0 */
     memset (&conf, 0, sizeof (confdata));
+
+    /* the custom values are read again from the new configuration */
+    if (custom_table)
+      g_hash_table_remove_all (custom_table);
   }
 #ifndef __TIZEN__
   /** if it's not Tizen, configuration from env-var has a higher priority */
@@ -509,11 +518,6 @@ nnsconf_get_subplugin_info (nnsconf_type_path type, subplugin_info_s * info)
   return g_strv_length (vstr);
 }
 
-/**
- * @brief Internal cache for the custom key-values
- */
-static GHashTable *custom_table = NULL;
-
 /**
  * @brief Public function defined in the header.
  * @note This function is included in nnstreamer internal header for native APIs.
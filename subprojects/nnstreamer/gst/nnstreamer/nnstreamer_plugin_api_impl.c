@@ -14,14 +14,29 @@
  */
 
 #include <nnstreamer_util.h>
+#include <math.h>
 #include <string.h>
 #include <tensor_common.h>
+#include "tensor_data.h"
+
+/**
+ * @brief Default timeout of deadline mode (nanoseconds), a frame at 30 fps.
+ */
+#define DEFAULT_SYNC_DEADLINE_TIMEOUT (33333333)
+
+/**
+ * @brief Default ring size of each pad in nearest and interpolate mode.
+ */
+#define DEFAULT_SYNC_RING_SIZE (64)
 
 static const gchar *gst_tensor_time_sync_mode_string[] = {
   [SYNC_NOSYNC] = "nosync",
   [SYNC_SLOWEST] = "slowest",
   [SYNC_BASEPAD] = "basepad",
   [SYNC_REFRESH] = "refresh",
+  [SYNC_DEADLINE] = "deadline",
+  [SYNC_NEAREST] = "nearest",
+  [SYNC_INTERPOLATE] = "interpolate",
   [SYNC_END] = NULL
 };
 
@@ -60,7 +75,12 @@ gst_tensor_time_sync_set_option_data (tensor_time_sync_data * sync)
 {
   g_return_val_if_fail (sync != NULL, FALSE);
 
-  if (sync->mode == SYNC_END || sync->option == NULL)
+  if (sync->mode == SYNC_END)
+    return FALSE;
+
+  /* deadline, nearest and interpolate mode work with the default option */
+  if (sync->option == NULL && sync->mode != SYNC_DEADLINE &&
+      sync->mode != SYNC_NEAREST && sync->mode != SYNC_INTERPOLATE)
     return FALSE;
 
   switch (sync->mode) {
@@ -90,6 +110,60 @@ gst_tensor_time_sync_set_option_data (tensor_time_sync_data * sync)
       g_strfreev (strv);
       break;
     }
+    case SYNC_DEADLINE:
+    {
+      guint64 timeout = 0;
+
+      if (sync->option != NULL)
+        timeout = g_ascii_strtoull (sync->option, NULL, 10);
+
+      if (timeout == 0)
+        timeout = DEFAULT_SYNC_DEADLINE_TIMEOUT;
+
+      sync->data_deadline.timeout = timeout;
+      sync->data_deadline.clock_id = NULL;
+      sync->data_deadline.pending = 0;
+      sync->data_deadline.expired = FALSE;
+      break;
+    }
+    case SYNC_NEAREST:
+      /* fall-through */
+    case SYNC_INTERPOLATE:
+    {
+      guint sink_id = 0;
+      GstClockTime tolerance = GST_CLOCK_TIME_NONE;
+      guint ring_size = DEFAULT_SYNC_RING_SIZE;
+      gchar **strv;
+
+      /* sink_id:tolerance:ring_size, empty or missing field for default */
+      if (sync->option != NULL) {
+        strv = g_strsplit (sync->option, ":", 3);
+        if (strv[0] != NULL) {
+          sink_id = (guint) g_ascii_strtoull (strv[0], NULL, 10);
+
+          if (strv[1] != NULL) {
+            if (strv[1][0] != '\0')
+              tolerance = g_ascii_strtoull (strv[1], NULL, 10);
+
+            if (strv[2] != NULL && strv[2][0] != '\0')
+              ring_size = (guint) g_ascii_strtoull (strv[2], NULL, 10);
+          }
+        }
+        g_strfreev (strv);
+      }
+
+      /* keeps a buffer before the base timestamp and one after it */
+      if (ring_size < 2) {
+        GST_WARNING ("Invalid ring size %u, it should be 2 or more.",
+            ring_size);
+        ring_size = DEFAULT_SYNC_RING_SIZE;
+      }
+
+      sync->data_nearest.sink_id = sink_id;
+      sync->data_nearest.tolerance = tolerance;
+      sync->data_nearest.ring_size = ring_size;
+      break;
+    }
     default:
       /* unknown mode */
       GST_WARNING ("Unknown mode = %d", sync->mode);
@@ -120,6 +194,11 @@ _gst_tensor_time_sync_is_eos (GstCollectPads * collect,
       if (empty == total)
         is_eos = TRUE;
       break;
+    case SYNC_DEADLINE:
+    case SYNC_NEAREST:
+    case SYNC_INTERPOLATE:
+      /* pads are not waited for, EOS is decided with the state of each pad */
+      break;
     default:
       if (empty > 0)
         is_eos = TRUE;
@@ -190,6 +269,86 @@ gst_tensor_time_sync_get_current_time (GstCollectPads * collect,
   return _gst_tensor_time_sync_is_eos (collect, sync, empty_pad);
 }
 
+/**
+ * @brief Internal macro to get the n-th buffer from the oldest one in the ring.
+ */
+#define _ring_nth(r,n) ((r)->buffers[((r)->head + (n)) % (r)->size])
+
+/**
+ * @brief Internal function to release the buffers in the ring.
+ */
+static void
+_gst_tensor_time_sync_ring_clear (tensor_sync_ring * ring)
+{
+  guint i;
+
+  for (i = 0; i < ring->len; i++)
+    gst_buffer_unref (_ring_nth (ring, i));
+
+  g_free (ring->buffers);
+  memset (ring, 0, sizeof (tensor_sync_ring));
+}
+
+/**
+ * @brief Internal function to remove the oldest buffer in the ring.
+ */
+static void
+_gst_tensor_time_sync_ring_pop (tensor_sync_ring * ring)
+{
+  g_assert (ring->len > 0);
+
+  gst_buffer_unref (ring->buffers[ring->head]);
+  ring->buffers[ring->head] = NULL;
+  ring->head = (ring->head + 1) % ring->size;
+  ring->len--;
+}
+
+/**
+ * @brief Internal function to add a buffer in the ring, keeping the buffers sorted by timestamp.
+ * @return FALSE if the ring is full.
+ */
+static gboolean
+_gst_tensor_time_sync_ring_push (tensor_sync_ring * ring, GstBuffer * buf)
+{
+  guint n;
+
+  if (ring->len >= ring->size)
+    return FALSE;
+
+  n = ring->len++;
+  _ring_nth (ring, n) = buf;
+
+  /* usually appended at the end, move the late one to its position */
+  while (n > 0 && GST_BUFFER_PTS (_ring_nth (ring, n - 1)) > GST_BUFFER_PTS (buf)) {
+    _ring_nth (ring, n) = _ring_nth (ring, n - 1);
+    _ring_nth (ring, n - 1) = buf;
+    n--;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to find the first buffer whose timestamp is not less than given time.
+ * @return Index from the oldest buffer, ring->len if all buffers are older.
+ */
+static guint
+_gst_tensor_time_sync_ring_search (tensor_sync_ring * ring, GstClockTime time)
+{
+  guint low = 0, high = ring->len, mid;
+
+  while (low < high) {
+    mid = low + (high - low) / 2;
+
+    if (GST_BUFFER_PTS (_ring_nth (ring, mid)) < time)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return low;
+}
+
 /**
  * @brief A function to be called while processing a flushing event.
  * It should clear old buffer and reset pad data.
@@ -210,6 +369,8 @@ gst_tensor_time_sync_flush (GstCollectPads * collect)
       gst_buffer_unref (pad->buffer);
       pad->buffer = NULL;
     }
+    pad->updated = FALSE;
+    _gst_tensor_time_sync_ring_clear (&pad->ring);
 
     walk = g_slist_next (walk);
   }
@@ -258,6 +419,410 @@ _gst_tensor_time_sync_buffer_update (GstCollectPads * collect,
   return TRUE;
 }
 
+/**
+ * @brief Internal function to unschedule the deadline timer. Called with the stream lock.
+ */
+static void
+_gst_tensor_time_sync_deadline_clear (tensor_sync_deadline_data * deadline)
+{
+  if (deadline->clock_id) {
+    gst_clock_id_unschedule (deadline->clock_id);
+    gst_clock_id_unref (deadline->clock_id);
+    deadline->clock_id = NULL;
+  }
+
+  deadline->expired = FALSE;
+}
+
+/**
+ * @brief Internal function to keep the latest buffer of each pad (deadline mode).
+ * @return TRUE to push the latest buffers, FALSE to wait for the other pads.
+ */
+static gboolean
+_gst_tensor_time_sync_deadline_update (GstCollectPads * collect,
+    tensor_time_sync_data * sync, GstClockTime * current_time,
+    GstBuffer * tensors_buf, gboolean * is_eos)
+{
+  tensor_sync_deadline_data *deadline = &sync->data_deadline;
+  GSList *walk;
+  GstCollectData *data;
+  GstTensorCollectPadData *pad;
+  GstBuffer *buf, *latest = NULL;
+  guint total, eos, updated, waiting;
+  gboolean ready = TRUE;
+
+  total = eos = updated = waiting = 0;
+
+  for (walk = collect->data; walk; walk = g_slist_next (walk)) {
+    gboolean pad_eos = FALSE;
+
+    data = (GstCollectData *) walk->data;
+    pad = (GstTensorCollectPadData *) data;
+    total++;
+
+    /* drop the old one, only the latest buffer is pushed */
+    buf = gst_collect_pads_pop (collect, data);
+    if (buf != NULL) {
+      if (pad->buffer != NULL)
+        gst_buffer_unref (pad->buffer);
+      pad->buffer = buf;
+      pad->updated = TRUE;
+    } else if (GST_COLLECT_PADS_STATE_IS_SET (data,
+            GST_COLLECT_PADS_STATE_EOS)) {
+      pad_eos = TRUE;
+      eos++;
+    }
+
+    if (pad->buffer == NULL) {
+      ready = FALSE;
+      continue;
+    }
+
+    if (latest == NULL ||
+        GST_BUFFER_PTS (latest) < GST_BUFFER_PTS (pad->buffer))
+      latest = pad->buffer;
+
+    if (pad->updated) {
+      updated++;
+    } else if (!pad_eos) {
+      /* EOS pads never get a new buffer, do not wait for them */
+      waiting++;
+    }
+  }
+
+  /* do not start the timer until every pad gets the first buffer */
+  deadline->pending = ready ? updated : 0;
+
+  if (eos == total && (!ready || updated == 0)) {
+    *is_eos = TRUE;
+    return FALSE;
+  }
+
+  if (!ready || updated == 0) {
+    deadline->expired = FALSE;
+    return FALSE;
+  }
+
+  /* wait for the other pads until the deadline */
+  if (waiting > 0 && !deadline->expired)
+    return FALSE;
+
+  _gst_tensor_time_sync_deadline_clear (deadline);
+
+  for (walk = collect->data; walk; walk = g_slist_next (walk)) {
+    pad = (GstTensorCollectPadData *) walk->data;
+    pad->updated = FALSE;
+  }
+  deadline->pending = 0;
+
+  *current_time = GST_BUFFER_PTS (latest);
+  gst_buffer_copy_into (tensors_buf, latest, GST_BUFFER_COPY_METADATA, 0, -1);
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to interpolate the raw data of a tensor, out = a + (b - a) * w.
+ */
+static void
+_gst_tensor_time_sync_interpolate_raw (gconstpointer a, gconstpointer b,
+    gpointer out, gsize num, tensor_type type, gdouble w)
+{
+  gsize i, esize;
+  gdouble va, vb, v;
+
+  switch (type) {
+    case _NNS_FLOAT32:
+    {
+      const gfloat *fa = (const gfloat *) a;
+      const gfloat *fb = (const gfloat *) b;
+      gfloat *fo = (gfloat *) out;
+      gfloat fw = (gfloat) w;
+
+      for (i = 0; i < num; i++)
+        fo[i] = fa[i] + (fb[i] - fa[i]) * fw;
+      return;
+    }
+    case _NNS_FLOAT64:
+    {
+      const gdouble *da = (const gdouble *) a;
+      const gdouble *db = (const gdouble *) b;
+      gdouble *dout = (gdouble *) out;
+
+      for (i = 0; i < num; i++)
+        dout[i] = da[i] + (db[i] - da[i]) * w;
+      return;
+    }
+    default:
+      break;
+  }
+
+  /* other types, calculate with float64 and round off the integer value */
+  esize = gst_tensor_get_element_size (type);
+
+  for (i = 0; i < num; i++) {
+    gst_tensor_data_raw_typecast ((guint8 *) a + i * esize, type, &va,
+        _NNS_FLOAT64);
+    gst_tensor_data_raw_typecast ((guint8 *) b + i * esize, type, &vb,
+        _NNS_FLOAT64);
+
+    v = va + (vb - va) * w;
+    if (!gst_tensor_data_is_half (type))
+      v = round (v);
+
+    gst_tensor_data_raw_typecast (&v, _NNS_FLOAT64, (guint8 *) out + i * esize,
+        type);
+  }
+}
+
+/**
+ * @brief Internal function to interpolate the tensors linearly at given time (interpolate mode).
+ * @return Newly allocated buffer, NULL if the tensors cannot be interpolated.
+ */
+static GstBuffer *
+_gst_tensor_time_sync_interpolate (GstPad * pad, GstBuffer * prev,
+    GstBuffer * next, GstClockTime current)
+{
+  GstTensorsConfig config;
+  GstCaps *caps;
+  GstBuffer *out = NULL;
+  GstMemory *mem;
+  GstMapInfo map_p, map_n, map_o;
+  gsize size;
+  gdouble w;
+  guint i, num;
+
+  caps = gst_pad_get_current_caps (pad);
+  if (caps == NULL)
+    return NULL;
+
+  gst_tensors_config_from_structure (&config, gst_caps_get_structure (caps, 0));
+  gst_caps_unref (caps);
+
+  /* flexible or sparse tensors cannot be interpolated, use the nearest one */
+  if (!gst_tensors_config_validate (&config) ||
+      !gst_tensors_config_is_static (&config))
+    return NULL;
+
+  num = config.info.num_tensors;
+  if (gst_buffer_n_memory (prev) != num || gst_buffer_n_memory (next) != num)
+    return NULL;
+
+  w = (gdouble) (current - GST_BUFFER_PTS (prev)) /
+      (gdouble) (GST_BUFFER_PTS (next) - GST_BUFFER_PTS (prev));
+
+  out = gst_buffer_new ();
+
+  for (i = 0; i < num; i++) {
+    size = gst_tensor_info_get_size (&config.info.info[i]);
+
+    if (!gst_memory_map (gst_buffer_peek_memory (prev, i), &map_p,
+            GST_MAP_READ)) {
+      goto error;
+    }
+
+    if (!gst_memory_map (gst_buffer_peek_memory (next, i), &map_n,
+            GST_MAP_READ)) {
+      gst_memory_unmap (map_p.memory, &map_p);
+      goto error;
+    }
+
+    if (map_p.size != size || map_n.size != size) {
+      gst_memory_unmap (map_p.memory, &map_p);
+      gst_memory_unmap (map_n.memory, &map_n);
+      goto error;
+    }
+
+    mem = gst_allocator_alloc (NULL, size, NULL);
+    if (mem == NULL || !gst_memory_map (mem, &map_o, GST_MAP_WRITE)) {
+      if (mem)
+        gst_memory_unref (mem);
+      gst_memory_unmap (map_p.memory, &map_p);
+      gst_memory_unmap (map_n.memory, &map_n);
+      goto error;
+    }
+
+    _gst_tensor_time_sync_interpolate_raw (map_p.data, map_n.data, map_o.data,
+        size / gst_tensor_get_element_size (config.info.info[i].type),
+        config.info.info[i].type, w);
+
+    gst_memory_unmap (mem, &map_o);
+    gst_memory_unmap (map_p.memory, &map_p);
+    gst_memory_unmap (map_n.memory, &map_n);
+
+    gst_buffer_append_memory (out, mem);
+  }
+
+  gst_buffer_copy_into (out, prev, GST_BUFFER_COPY_METADATA, 0, -1);
+  GST_BUFFER_PTS (out) = current;
+  GST_BUFFER_DURATION (out) = GST_CLOCK_TIME_NONE;
+  return out;
+
+error:
+  ml_logw ("Failed to interpolate the tensors, use the nearest one.");
+  gst_buffer_unref (out);
+  return NULL;
+}
+
+/**
+ * @brief Internal function to release the buffers selected for the output (nearest and interpolate mode).
+ */
+static void
+_gst_tensor_time_sync_nearest_clear (GstCollectPads * collect)
+{
+  GSList *walk;
+  GstTensorCollectPadData *pad;
+
+  for (walk = collect->data; walk; walk = g_slist_next (walk)) {
+    pad = (GstTensorCollectPadData *) walk->data;
+
+    if (pad->buffer) {
+      gst_buffer_unref (pad->buffer);
+      pad->buffer = NULL;
+    }
+  }
+}
+
+/**
+ * @brief Internal function to select the buffer of each pad at the timestamp of the base pad (nearest and interpolate mode).
+ * The buffers of the other pads are kept in the ring of each pad, sorted by timestamp.
+ * The selected buffers are stored in pad->buffer and the buffer of the base pad is popped.
+ * @return TRUE to push the selected buffers, FALSE to wait for the other pads or if the base buffer is dropped.
+ */
+static gboolean
+_gst_tensor_time_sync_nearest_update (GstCollectPads * collect,
+    tensor_time_sync_data * sync, GstClockTime * current_time,
+    GstBuffer * tensors_buf, gboolean * is_eos)
+{
+  tensor_sync_nearest_data *nearest = &sync->data_nearest;
+  tensor_sync_ring *ring;
+  GSList *walk;
+  GstCollectData *data, *base_data;
+  GstTensorCollectPadData *pad;
+  GstBuffer *buf, *prev, *next;
+  GstClockTime current, dist_prev, dist_next;
+  guint idx;
+  gboolean ready = TRUE;
+
+  walk = g_slist_nth (collect->data, nearest->sink_id);
+  if (walk == NULL) {
+    GST_ERROR_OBJECT (collect, "Cannot get GstCollectData from GSList");
+    return FALSE;
+  }
+
+  base_data = (GstCollectData *) walk->data;
+  buf = gst_collect_pads_peek (collect, base_data);
+  if (buf == NULL) {
+    if (GST_COLLECT_PADS_STATE_IS_SET (base_data, GST_COLLECT_PADS_STATE_EOS))
+      *is_eos = TRUE;
+    return FALSE;
+  }
+
+  current = GST_BUFFER_PTS (buf);
+  gst_buffer_unref (buf);
+
+  if (!GST_CLOCK_TIME_IS_VALID (current)) {
+    GST_WARNING_OBJECT (collect, "Dropped a base buffer without timestamp.");
+    gst_buffer_unref (gst_collect_pads_pop (collect, base_data));
+    return FALSE;
+  }
+
+  /* fill the ring of each pad until it has a buffer after current time */
+  for (walk = collect->data; walk; walk = g_slist_next (walk)) {
+    data = (GstCollectData *) walk->data;
+    pad = (GstTensorCollectPadData *) data;
+    ring = &pad->ring;
+
+    if (data == base_data)
+      continue;
+
+    if (ring->buffers == NULL) {
+      ring->size = nearest->ring_size;
+      ring->buffers = g_new0 (GstBuffer *, ring->size);
+    }
+
+    /* timestamps of the base pad increase, keep one buffer before current time */
+    idx = _gst_tensor_time_sync_ring_search (ring, current);
+    for (; idx > 1; idx--)
+      _gst_tensor_time_sync_ring_pop (ring);
+
+    /* a full ring always has a buffer after current time, the pad is blocked */
+    if (ring->len < ring->size) {
+      buf = gst_collect_pads_pop (collect, data);
+
+      if (buf != NULL) {
+        if (GST_BUFFER_PTS_IS_VALID (buf)) {
+          _gst_tensor_time_sync_ring_push (ring, buf);
+        } else {
+          GST_WARNING_OBJECT (pad->pad, "Dropped a buffer without timestamp.");
+          gst_buffer_unref (buf);
+        }
+      }
+    }
+
+    if (_gst_tensor_time_sync_ring_search (ring, current) < ring->len)
+      continue;
+
+    /* no more buffer, use the last one */
+    if (GST_COLLECT_PADS_STATE_IS_SET (data, GST_COLLECT_PADS_STATE_EOS)) {
+      if (ring->len == 0)
+        *is_eos = TRUE;
+      continue;
+    }
+
+    ready = FALSE;
+  }
+
+  if (*is_eos || !ready)
+    return FALSE;
+
+  for (walk = collect->data; walk; walk = g_slist_next (walk)) {
+    data = (GstCollectData *) walk->data;
+    pad = (GstTensorCollectPadData *) data;
+    ring = &pad->ring;
+
+    if (data == base_data)
+      continue;
+
+    idx = _gst_tensor_time_sync_ring_search (ring, current);
+    prev = (idx > 0) ? _ring_nth (ring, idx - 1) : NULL;
+    next = (idx < ring->len) ? _ring_nth (ring, idx) : NULL;
+
+    dist_prev = prev ? current - GST_BUFFER_PTS (prev) : GST_CLOCK_TIME_NONE;
+    dist_next = next ? GST_BUFFER_PTS (next) - current : GST_CLOCK_TIME_NONE;
+
+    if (GST_CLOCK_TIME_IS_VALID (nearest->tolerance) &&
+        MIN (dist_prev, dist_next) > nearest->tolerance) {
+      GST_DEBUG_OBJECT (pad->pad,
+          "No buffer within the tolerance, drop the base buffer at %"
+          GST_TIME_FORMAT, GST_TIME_ARGS (current));
+      _gst_tensor_time_sync_nearest_clear (collect);
+      gst_buffer_unref (gst_collect_pads_pop (collect, base_data));
+      return FALSE;
+    }
+
+    buf = NULL;
+    if (sync->mode == SYNC_INTERPOLATE && prev && next && dist_next > 0)
+      buf = _gst_tensor_time_sync_interpolate (pad->pad, prev, next, current);
+
+    if (buf == NULL)
+      buf = gst_buffer_ref ((dist_next <= dist_prev) ? next : prev);
+
+    if (pad->buffer)
+      gst_buffer_unref (pad->buffer);
+    pad->buffer = buf;
+  }
+
+  pad = (GstTensorCollectPadData *) base_data;
+  if (pad->buffer)
+    gst_buffer_unref (pad->buffer);
+  pad->buffer = gst_collect_pads_pop (collect, base_data);
+
+  *current_time = current;
+  gst_buffer_copy_into (tensors_buf, pad->buffer, GST_BUFFER_COPY_METADATA, 0,
+      -1);
+  return TRUE;
+}
+
 /**
  * @brief A function call to make tensors from collected pads.
  * It decide which buffer is going to be used according to sync option.
@@ -291,6 +856,18 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
   walk = collect->data;
   counting = empty_pad = 0;
 
+  if (sync->mode == SYNC_DEADLINE) {
+    *is_eos = FALSE;
+    if (!_gst_tensor_time_sync_deadline_update (collect, sync, &current_time,
+            tensors_buf, is_eos))
+      return FALSE;
+  } else if (sync->mode == SYNC_NEAREST || sync->mode == SYNC_INTERPOLATE) {
+    *is_eos = FALSE;
+    if (!_gst_tensor_time_sync_nearest_update (collect, sync, &current_time,
+            tensors_buf, is_eos))
+      return FALSE;
+  }
+
   if (sync->mode == SYNC_BASEPAD) {
     walk = g_slist_nth (walk, sync->data_basepad.sink_id);
     if (walk == NULL) {
@@ -380,6 +957,16 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
           buf = gst_buffer_ref (pad->buffer);
         }
         break;
+      case SYNC_DEADLINE:
+        /* the latest buffer of each pad, see _gst_tensor_time_sync_deadline_update() */
+        buf = gst_buffer_ref (pad->buffer);
+        break;
+      case SYNC_NEAREST:
+      case SYNC_INTERPOLATE:
+        /* see _gst_tensor_time_sync_nearest_update() */
+        buf = pad->buffer;
+        pad->buffer = NULL;
+        break;
       default:
         break;
     }
@@ -440,6 +1027,160 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
   return !(*is_eos);
 }
 
+/**
+ * @brief Internal data for the deadline task. The task is owned by the src pad of the element.
+ */
+typedef struct
+{
+  GstCollectPads *collect;
+  tensor_time_sync_data *sync;
+  GstCollectPadsFunction func;
+  GstElement *element;
+  GstPad *srcpad;
+} tensor_sync_deadline_ctx;
+
+/**
+ * @brief Internal function of the deadline task, waits for the pending deadline and calls the collect function.
+ * The clock thread is not used to push the buffers, the task pushes them from the streaming thread of the src pad.
+ */
+static void
+_gst_tensor_time_sync_deadline_loop (gpointer user_data)
+{
+  tensor_sync_deadline_ctx *ctx = (tensor_sync_deadline_ctx *) user_data;
+  tensor_sync_deadline_data *deadline = &ctx->sync->data_deadline;
+  GstClockID id = NULL;
+  GstFlowReturn ret;
+
+  GST_COLLECT_PADS_STREAM_LOCK (ctx->collect);
+  if (deadline->clock_id) {
+    id = gst_clock_id_ref (deadline->clock_id);
+  } else {
+    /* nothing to wait for, started again with the next deadline */
+    gst_pad_pause_task (ctx->srcpad);
+  }
+  GST_COLLECT_PADS_STREAM_UNLOCK (ctx->collect);
+
+  if (id == NULL)
+    return;
+
+  /* returns early if unscheduled */
+  gst_clock_id_wait (id, NULL);
+
+  GST_COLLECT_PADS_STREAM_LOCK (ctx->collect);
+
+  /* ignore the timer if it is unscheduled or already replaced */
+  if (deadline->clock_id == id) {
+    gst_clock_id_unref (deadline->clock_id);
+    deadline->clock_id = NULL;
+    deadline->expired = TRUE;
+
+    ret = ctx->func (ctx->collect, ctx->element);
+    if (ret != GST_FLOW_OK) {
+      GST_DEBUG_OBJECT (ctx->element, "deadline push returned %s",
+          gst_flow_get_name (ret));
+    }
+  }
+
+  GST_COLLECT_PADS_STREAM_UNLOCK (ctx->collect);
+  gst_clock_id_unref (id);
+}
+
+/**
+ * @brief Start the deadline timer if some pads hold a new buffer which is not pushed yet (deadline mode).
+ */
+void
+gst_tensor_time_sync_deadline_schedule (GstCollectPads * collect,
+    tensor_time_sync_data * sync, GstCollectPadsFunction func,
+    GstElement * element, GstPad * srcpad)
+{
+  tensor_sync_deadline_data *deadline;
+  tensor_sync_deadline_ctx *ctx = NULL;
+  GstClock *clock;
+  gboolean has_task;
+
+  g_return_if_fail (collect != NULL);
+  g_return_if_fail (sync != NULL);
+  g_return_if_fail (func != NULL);
+  g_return_if_fail (GST_IS_ELEMENT (element));
+  g_return_if_fail (GST_IS_PAD (srcpad));
+
+  if (sync->mode != SYNC_DEADLINE)
+    return;
+
+  deadline = &sync->data_deadline;
+
+  /* already waiting, or nothing to push */
+  if (deadline->clock_id != NULL || deadline->pending == 0)
+    return;
+
+  /**
+   * The deadline bounds the latency after a pad gets a new buffer.
+   * Use the pipeline clock if the element has one, the system clock otherwise.
+   */
+  clock = gst_element_get_clock (element);
+  if (clock == NULL)
+    clock = gst_system_clock_obtain ();
+  deadline->clock_id = gst_clock_new_single_shot_id (clock,
+      gst_clock_get_time (clock) + deadline->timeout);
+  gst_object_unref (clock);
+
+  /* the task is created once and kept until the element stops */
+  GST_OBJECT_LOCK (srcpad);
+  has_task = (GST_PAD_TASK (srcpad) != NULL);
+  GST_OBJECT_UNLOCK (srcpad);
+
+  if (!has_task) {
+    ctx = g_new0 (tensor_sync_deadline_ctx, 1);
+    ctx->collect = collect;
+    ctx->sync = sync;
+    ctx->func = func;
+    ctx->element = element;
+    ctx->srcpad = srcpad;
+  }
+
+  if (!gst_pad_start_task (srcpad, _gst_tensor_time_sync_deadline_loop, ctx,
+          g_free)) {
+    GST_WARNING_OBJECT (element, "Failed to start the deadline task.");
+    gst_clock_id_unref (deadline->clock_id);
+    deadline->clock_id = NULL;
+  }
+}
+
+/**
+ * @brief Cancel the pending deadline timer (deadline mode).
+ */
+void
+gst_tensor_time_sync_deadline_cancel (GstCollectPads * collect,
+    tensor_time_sync_data * sync)
+{
+  g_return_if_fail (collect != NULL);
+  g_return_if_fail (sync != NULL);
+
+  if (sync->mode != SYNC_DEADLINE)
+    return;
+
+  GST_COLLECT_PADS_STREAM_LOCK (collect);
+  _gst_tensor_time_sync_deadline_clear (&sync->data_deadline);
+  sync->data_deadline.pending = 0;
+  GST_COLLECT_PADS_STREAM_UNLOCK (collect);
+}
+
+/**
+ * @brief Cancel the pending deadline timer and stop the deadline task (deadline mode).
+ */
+void
+gst_tensor_time_sync_deadline_stop (GstCollectPads * collect,
+    tensor_time_sync_data * sync, GstPad * srcpad)
+{
+  g_return_if_fail (collect != NULL);
+  g_return_if_fail (sync != NULL);
+  g_return_if_fail (GST_IS_PAD (srcpad));
+
+  /* wakes up the task waiting for the deadline */
+  gst_tensor_time_sync_deadline_cancel (collect, sync);
+  gst_pad_stop_task (srcpad);
+}
+
 /**
  * @brief Configure gst-buffer with tensors information.
  * NNStreamer handles single memory chunk as single tensor.
@@ -504,7 +1245,7 @@ gst_tensor_buffer_from_config (GstBuffer * in, GstTensorsConfig * config)
 
       gst_tensor_meta_info_parse_header (&meta, h);
       mem_size[num] = gst_tensor_meta_info_get_header_size (&meta);
-      mem_size[num] += gst_tensor_meta_info_get_data_size (&meta);
+      mem_size[num] += gst_tensor_meta_info_get_data_size_from_header (h);
 
       offset += mem_size[num];
       num++;
@@ -28,6 +28,8 @@ static const gchar *tensor_element_typename[] = {
   [_NNS_FLOAT32] = "float32",
   [_NNS_INT64] = "int64",
   [_NNS_UINT64] = "uint64",
+  [_NNS_FLOAT16] = "float16",
+  [_NNS_BFLOAT16] = "bfloat16",
   [_NNS_END] = NULL,
 };
 
@@ -45,6 +47,8 @@ static const guint tensor_element_size[] = {
   [_NNS_FLOAT32] = 4,
   [_NNS_INT64] = 8,
   [_NNS_UINT64] = 8,
+  [_NNS_FLOAT16] = 2,
+  [_NNS_BFLOAT16] = 2,
 
   [_NNS_END] = 0,
 };
@@ -1063,17 +1067,22 @@ gst_tensor_get_type (const gchar * typestr)
       case 64:
         type = _NNS_INT64;
     }
-  } else if (g_regex_match_simple ("^float(32|64)$",
+  } else if (g_regex_match_simple ("^float(16|32|64)$",
           type_string, G_REGEX_CASELESS, 0)) {
     size = (gsize) g_ascii_strtoull (&type_string[5], NULL, 10);
 
     switch (size) {
+      case 16:
+        type = _NNS_FLOAT16;
+        break;
       case 32:
         type = _NNS_FLOAT32;
         break;
       case 64:
         type = _NNS_FLOAT64;
     }
+  } else if (g_ascii_strcasecmp (type_string, "bfloat16") == 0) {
+    type = _NNS_BFLOAT16;
   }
 
   g_free (type_string);
@@ -1323,6 +1332,9 @@ gst_tensor_meta_info_parse_header (GstTensorMetaInfo * meta, gpointer header)
   switch ((tensor_format) meta->format) {
     case _NNS_TENSOR_FORMAT_SPARSE:
       meta->sparse_info.nnz = val[20];
+      /* the encoding is kept in the header only */
+      if (!gst_tensor_meta_info_get_sparse_encoding (header, NULL, NULL))
+        return FALSE;
       break;
     default:
       break;
@@ -1333,6 +1345,107 @@ gst_tensor_meta_info_parse_header (GstTensorMetaInfo * meta, gpointer header)
   return gst_tensor_meta_info_validate (meta);
 }
 
+/**
+ * @brief Get the sparse encoding from the header of sparse tensor.
+ * @param[in] header pointer to header of sparse tensor
+ * @param[out] encoding pointer to get the encoding (tensor_sparse_encoding)
+ * @param[out] block_size pointer to get the number of elements in a block (0 if it is not block encoding)
+ * @return TRUE if the header has a valid sparse encoding
+ */
+gboolean
+gst_tensor_meta_info_get_sparse_encoding (gpointer header, guint * encoding,
+    guint * block_size)
+{
+  uint32_t *val = (uint32_t *) header;
+
+  g_return_val_if_fail (header != NULL, FALSE);
+
+  if (val[18] != _NNS_TENSOR_FORMAT_SPARSE)
+    return FALSE;
+
+  /* offset 21 and 22, zero in the header of old sparse tensor (COO) */
+  if (val[21] >= _NNS_SPARSE_ENCODING_END ||
+      (val[21] == _NNS_SPARSE_ENCODING_BLOCK && val[22] == 0)) {
+    nns_logd ("Invalid sparse encoding %u (block size %u).", val[21], val[22]);
+    return FALSE;
+  }
+
+  if (encoding)
+    *encoding = val[21];
+  if (block_size)
+    *block_size = (val[21] == _NNS_SPARSE_ENCODING_BLOCK) ? val[22] : 0;
+
+  return TRUE;
+}
+
+/**
+ * @brief Write the sparse encoding in the header of sparse tensor.
+ * @param[in,out] header pointer to header of sparse tensor
+ * @param[in] encoding the encoding (tensor_sparse_encoding)
+ * @param[in] block_size the number of elements in a block with block encoding
+ * @return TRUE if successfully set the encoding
+ */
+gboolean
+gst_tensor_meta_info_set_sparse_encoding (gpointer header, guint encoding,
+    guint block_size)
+{
+  uint32_t *val = (uint32_t *) header;
+
+  g_return_val_if_fail (header != NULL, FALSE);
+  g_return_val_if_fail (val[18] == _NNS_TENSOR_FORMAT_SPARSE, FALSE);
+  g_return_val_if_fail (encoding < _NNS_SPARSE_ENCODING_END, FALSE);
+  g_return_val_if_fail (encoding != _NNS_SPARSE_ENCODING_BLOCK ||
+      block_size > 0, FALSE);
+
+  val[21] = encoding;
+  val[22] = (encoding == _NNS_SPARSE_ENCODING_BLOCK) ? block_size : 0;
+  return TRUE;
+}
+
+/**
+ * @brief Get the data size calculated from the header of tensor.
+ * @param[in] header pointer to header of tensor
+ * @return The data size (0 if the header is invalid)
+ */
+gsize
+gst_tensor_meta_info_get_data_size_from_header (gpointer header)
+{
+  GstTensorMetaInfo meta;
+  guint i, encoding, block_size;
+  gsize dsize, count;
+
+  g_return_val_if_fail (header != NULL, 0);
+
+  if (!gst_tensor_meta_info_parse_header (&meta, header))
+    return 0;
+
+  if (meta.format != _NNS_TENSOR_FORMAT_SPARSE ||
+      !gst_tensor_meta_info_get_sparse_encoding (header, &encoding,
+          &block_size))
+    return gst_tensor_meta_info_get_data_size (&meta);
+
+  dsize = gst_tensor_get_element_size (meta.type);
+
+  switch (encoding) {
+    case _NNS_SPARSE_ENCODING_BITMAP:
+      /* bitmap of 64-bit words and values */
+      count = 1;
+      for (i = 0; i < NNS_TENSOR_META_RANK_LIMIT; i++) {
+        if (meta.dimension[i] == 0)
+          break;
+
+        count *= meta.dimension[i];
+      }
+
+      return (i > 0) ?
+          ((count + 63) / 64) * sizeof (guint64) + meta.sparse_info.nnz * dsize : 0;
+    case _NNS_SPARSE_ENCODING_BLOCK:
+      return meta.sparse_info.nnz * (block_size * dsize + sizeof (guint));
+    default:
+      return gst_tensor_meta_info_get_data_size (&meta);
+  }
+}
+
 /**
  * @brief Convert GstTensorMetaInfo structure to GstTensorInfo.
  * @param[in] meta tensor meta structure to be converted
@@ -24,6 +24,7 @@
  */
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <gmodule.h>
 
 #include "nnstreamer_log.h"
@@ -49,6 +50,54 @@ static GHashTable *subplugins[NNS_SUBPLUGIN_END] = { 0 };
 /** @brief Protects handles and subplugins */
 G_LOCK_DEFINE_STATIC (splock);
 
+/**
+ * @brief The manifest of the subplugin modules.
+ * It keeps the names registered by each module and the attributes of the
+ * subplugins (e.g., template caps of a converter), so that the subplugins can
+ * be found without loading all the modules. A module entry is valid only if
+ * the size and modification time (in nanoseconds) of the module file are not
+ * changed. The manifest is disabled unless '[common] subplugin_manifest' gives
+ * its path.
+ *
+ * [module:<path>]        type, size, mtime, mtime-nsec, names registered by the module
+ * [<type>:<name>]        module path and the attributes of the subplugin
+ *                        (e.g., caps of a converter, accelerators of a filter)
+ */
+static GKeyFile *manifest = NULL;
+static gchar *manifest_path = NULL;
+static gboolean manifest_loaded = FALSE;
+
+/** @brief Protects the manifest */
+G_LOCK_DEFINE_STATIC (manifest_lock);
+
+/** @brief The nanoseconds of the modification time of the module file */
+#if defined(__APPLE__)
+#define MANIFEST_MTIME_NSEC(st) ((gint64) (st).st_mtimespec.tv_nsec)
+#else
+#define MANIFEST_MTIME_NSEC(st) ((gint64) (st).st_mtim.tv_nsec)
+#endif
+
+/** @brief The names registered while the module is being opened in this thread */
+typedef struct
+{
+  subpluginType type; /**< The type of the module being opened */
+  GPtrArray *names; /**< The names registered with the type */
+} subpluginLoading;
+
+static GPrivate loading_module = G_PRIVATE_INIT (NULL);
+
+/** @brief The type names used in the manifest, NULL if not loaded from a module */
+static const gchar *manifest_type_str[] = {
+  [NNS_SUBPLUGIN_FILTER] = "filter",
+  [NNS_SUBPLUGIN_DECODER] = "decoder",
+  [NNS_EASY_CUSTOM_FILTER] = NULL,
+  [NNS_SUBPLUGIN_CONVERTER] = "converter",
+  [NNS_CUSTOM_CONVERTER] = NULL,
+  [NNS_CUSTOM_DECODER] = NULL,
+  [NNS_IF_CUSTOM] = NULL,
+  [NNS_SUBPLUGIN_END] = NULL,
+};
+
 /** @brief Private function for g_hash_table data destructor, GDestroyNotify */
 static void
 _spdata_destroy (gpointer _data)
@@ -100,6 +149,162 @@ _get_subplugin_data (subpluginType type, const gchar * name)
   return spdata;
 }
 
+/**
+ * @brief Internal function to load the manifest. Call this with manifest_lock.
+ * @return TRUE if the manifest is available.
+ */
+static gboolean
+_manifest_load (void)
+{
+  if (manifest_loaded)
+    return (manifest != NULL);
+
+  manifest_loaded = TRUE;
+
+  /* opt-in, the manifest is written only to the configured path */
+  manifest_path = nnsconf_get_custom_value_string ("common",
+      "subplugin_manifest");
+  if (manifest_path == NULL || manifest_path[0] == '\0' ||
+      g_ascii_strcasecmp (manifest_path, "none") == 0) {
+    g_free (manifest_path);
+    manifest_path = NULL;
+    return FALSE;
+  }
+
+  manifest = g_key_file_new ();
+  if (!g_key_file_load_from_file (manifest, manifest_path, G_KEY_FILE_NONE,
+          NULL)) {
+    /* not created yet or broken, start with an empty manifest */
+    g_key_file_free (manifest);
+    manifest = g_key_file_new ();
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to write the manifest. Call this with manifest_lock.
+ */
+static void
+_manifest_save (void)
+{
+  GError *err = NULL;
+  gchar *dir;
+
+  dir = g_path_get_dirname (manifest_path);
+  if (g_mkdir_with_parents (dir, 0700) != 0) {
+    ml_logw ("Cannot create the directory of the subplugin manifest %s.", dir);
+    g_free (dir);
+    return;
+  }
+  g_free (dir);
+
+  /* The file is written to a temporary file and renamed. */
+  if (!g_key_file_save_to_file (manifest, manifest_path, &err)) {
+    ml_logw ("Cannot write the subplugin manifest %s: %s", manifest_path,
+        err ? err->message : "unknown reason");
+    g_clear_error (&err);
+  }
+}
+
+/**
+ * @brief Internal function to check the module entry is still valid. Call this with manifest_lock.
+ */
+static gboolean
+_manifest_module_is_valid (subpluginType type, const gchar * path)
+{
+  GStatBuf st;
+  gchar *group;
+  gboolean valid = FALSE;
+
+  if (g_stat (path, &st) != 0)
+    return FALSE;
+
+  group = g_strdup_printf ("module:%s", path);
+  if (g_key_file_has_group (manifest, group)) {
+    valid = (g_key_file_get_integer (manifest, group, "type", NULL) == type &&
+        g_key_file_has_key (manifest, group, "mtime-nsec", NULL) &&
+        g_key_file_get_int64 (manifest, group, "size", NULL) == st.st_size &&
+        g_key_file_get_int64 (manifest, group, "mtime", NULL) == st.st_mtime &&
+        g_key_file_get_int64 (manifest, group, "mtime-nsec", NULL) ==
+        MANIFEST_MTIME_NSEC (st));
+  }
+  g_free (group);
+
+  return valid;
+}
+
+/**
+ * @brief Internal function to add the names registered by the module.
+ */
+static void
+_manifest_add_module (subpluginType type, const gchar * path,
+    GPtrArray * names)
+{
+  GStatBuf st;
+  gchar *group;
+  guint i;
+
+  if (!manifest_type_str[type] || names->len == 0)
+    return;
+
+  if (g_stat (path, &st) != 0)
+    return;
+
+  G_LOCK (manifest_lock);
+  if (!_manifest_load ())
+    goto done;
+
+  group = g_strdup_printf ("module:%s", path);
+  g_key_file_remove_group (manifest, group, NULL);
+  g_key_file_set_integer (manifest, group, "type", type);
+  g_key_file_set_int64 (manifest, group, "size", st.st_size);
+  g_key_file_set_int64 (manifest, group, "mtime", st.st_mtime);
+  g_key_file_set_int64 (manifest, group, "mtime-nsec",
+      MANIFEST_MTIME_NSEC (st));
+  g_key_file_set_string_list (manifest, group, "names",
+      (const gchar * const *) names->pdata, names->len);
+  g_free (group);
+
+  for (i = 0; i < names->len; i++) {
+    /* the attributes are updated by the subplugin users */
+    group = g_strdup_printf ("%s:%s", manifest_type_str[type],
+        (gchar *) g_ptr_array_index (names, i));
+    g_key_file_remove_group (manifest, group, NULL);
+    g_key_file_set_string (manifest, group, "module", path);
+    g_free (group);
+  }
+
+  _manifest_save ();
+
+done:
+  G_UNLOCK (manifest_lock);
+}
+
+/**
+ * @brief Internal function to get the valid module path of the subplugin. Call this with manifest_lock.
+ * @return Newly allocated path. NULL if unknown or the module is changed.
+ */
+static gchar *
+_manifest_get_module (subpluginType type, const gchar * name)
+{
+  gchar *group, *path;
+
+  if (!manifest_type_str[type] || !_manifest_load ())
+    return NULL;
+
+  group = g_strdup_printf ("%s:%s", manifest_type_str[type], name);
+  path = g_key_file_get_string (manifest, group, "module", NULL);
+  g_free (group);
+
+  if (path && !_manifest_module_is_valid (type, path)) {
+    g_free (path);
+    path = NULL;
+  }
+
+  return path;
+}
+
 /**
  * @brief Internal function to scan sub-plugin.
  */
@@ -107,19 +312,31 @@ static subpluginData *
 _search_subplugin (subpluginType type, const gchar * name, const gchar * path)
 {
   subpluginData *spdata = NULL;
+  subpluginLoading loading;
   GModule *module;
 
   g_return_val_if_fail (name != NULL, NULL);
   g_return_val_if_fail (path != NULL, NULL);
 
+  /* Collect the names the module registers, for the manifest. */
+  loading.type = type;
+  loading.names = g_ptr_array_new_with_free_func (g_free);
+  g_private_set (&loading_module, &loading);
+
   module = g_module_open (path, G_MODULE_BIND_LOCAL);
+  g_private_set (&loading_module, NULL);
+
   /* If this is a correct subplugin, it will register itself */
   if (module == NULL) {
     ml_loge ("Cannot open %s(%s) with error %s.", name, path,
         g_module_error ());
+    g_ptr_array_free (loading.names, TRUE);
     return NULL;
   }
 
+  _manifest_add_module (type, path, loading.names);
+  g_ptr_array_free (loading.names, TRUE);
+
   spdata = _get_subplugin_data (type, name);
   if (spdata) {
     g_ptr_array_add (handles, (gpointer) module);
@@ -133,6 +350,26 @@ _search_subplugin (subpluginType type, const gchar * name, const gchar * path)
   return spdata;
 }
 
+/**
+ * @brief Internal function to load the module which registered the sub-plugin, with the manifest.
+ */
+static subpluginData *
+_search_subplugin_manifest (subpluginType type, const gchar * name)
+{
+  subpluginData *spdata = NULL;
+  gchar *path;
+
+  G_LOCK (manifest_lock);
+  path = _manifest_get_module (type, name);
+  G_UNLOCK (manifest_lock);
+
+  if (path && nnsconf_validate_file ((nnsconf_type_path) type, path))
+    spdata = _search_subplugin (type, name, path);
+
+  g_free (path);
+  return spdata;
+}
+
 /** @brief Public function defined in the header */
 const void *
 get_subplugin (subpluginType type, const char *name)
@@ -141,20 +378,28 @@ get_subplugin (subpluginType type, const char *name)
 
   g_return_val_if_fail (name, NULL);
 
-  if (searchAlgorithm[type] == NNS_SEARCH_GETALL) {
-    nnsconf_type_path conf_type = (nnsconf_type_path) type;
-    subplugin_info_s info;
-    guint i;
-    guint ret = nnsconf_get_subplugin_info (conf_type, &info);
+  spdata = _get_subplugin_data (type, name);
 
-    for (i = 0; i < ret; i++) {
-      _search_subplugin (type, info.names[i], info.paths[i]);
-    }
+  if (spdata == NULL && searchAlgorithm[type] == NNS_SEARCH_GETALL) {
+    /* Load the module only if the manifest knows it. */
+    spdata = _search_subplugin_manifest (type, name);
 
-    searchAlgorithm[type] = NNS_SEARCH_NO_OP;
+    if (spdata == NULL) {
+      nnsconf_type_path conf_type = (nnsconf_type_path) type;
+      subplugin_info_s info;
+      guint i;
+      guint ret = nnsconf_get_subplugin_info (conf_type, &info);
+
+      for (i = 0; i < ret; i++) {
+        if (_get_subplugin_data (type, info.names[i]) == NULL)
+          _search_subplugin (type, info.names[i], info.paths[i]);
+      }
+
+      searchAlgorithm[type] = NNS_SEARCH_NO_OP;
+      spdata = _get_subplugin_data (type, name);
+    }
   }
 
-  spdata = _get_subplugin_data (type, name);
   if (spdata == NULL && searchAlgorithm[type] == NNS_SEARCH_FILENAME) {
     /** Search and register if found with the conf */
     nnsconf_type_path conf_type = (nnsconf_type_path) type;
@@ -162,12 +407,91 @@ get_subplugin (subpluginType type, const char *name)
 
     if (nnsconf_validate_file (conf_type, fullpath)) {
       spdata = _search_subplugin (type, name, fullpath);
+    } else {
+      /* The module may register the name other than its file name. */
+      spdata = _search_subplugin_manifest (type, name);
     }
   }
 
   return (spdata != NULL) ? spdata->data : NULL;
 }
 
+/** @brief Public function defined in the header */
+gchar *
+subplugin_get_manifest_value (subpluginType type, const char *name,
+    const char *key)
+{
+  gchar *group, *path, *value = NULL;
+
+  g_return_val_if_fail (name != NULL, NULL);
+  g_return_val_if_fail (key != NULL, NULL);
+
+  G_LOCK (manifest_lock);
+  path = _manifest_get_module (type, name);
+  if (path) {
+    group = g_strdup_printf ("%s:%s", manifest_type_str[type], name);
+    value = g_key_file_get_string (manifest, group, key, NULL);
+    g_free (group);
+    g_free (path);
+  }
+  G_UNLOCK (manifest_lock);
+
+  return value;
+}
+
+/** @brief Public function defined in the header */
+gboolean
+subplugin_set_manifest_value (subpluginType type, const char *name,
+    const char *key, const char *value)
+{
+  gchar *group, *path, *old;
+  gboolean ret = FALSE;
+
+  g_return_val_if_fail (name != NULL, FALSE);
+  g_return_val_if_fail (key != NULL, FALSE);
+  g_return_val_if_fail (value != NULL, FALSE);
+
+  if (g_str_equal (key, "module")) {
+    ml_loge ("The key 'module' is reserved in the subplugin manifest.");
+    return FALSE;
+  }
+
+  G_LOCK (manifest_lock);
+  path = _manifest_get_module (type, name);
+  if (path) {
+    group = g_strdup_printf ("%s:%s", manifest_type_str[type], name);
+    old = g_key_file_get_string (manifest, group, key, NULL);
+
+    /* write the file only if changed */
+    if (g_strcmp0 (old, value) != 0) {
+      g_key_file_set_string (manifest, group, key, value);
+      _manifest_save ();
+    }
+
+    g_free (old);
+    g_free (group);
+    g_free (path);
+    ret = TRUE;
+  }
+  G_UNLOCK (manifest_lock);
+
+  return ret;
+}
+
+/** @brief Public function defined in the header */
+void
+subplugin_reload_manifest (void)
+{
+  G_LOCK (manifest_lock);
+  if (manifest)
+    g_key_file_free (manifest);
+  manifest = NULL;
+  g_free (manifest_path);
+  manifest_path = NULL;
+  manifest_loaded = FALSE;
+  G_UNLOCK (manifest_lock);
+}
+
 /** @brief Public function defined in the header */
 gchar **
 get_all_subplugins (subpluginType type)
@@ -223,6 +547,7 @@ register_subplugin (subpluginType type, const char *name, const void *data)
 {
   /** @todo data out of scope at add */
   subpluginData *spdata = NULL;
+  subpluginLoading *loading;
   gboolean ret;
 
   g_return_val_if_fail (name, FALSE);
@@ -270,6 +595,11 @@ register_subplugin (subpluginType type, const char *name, const void *data)
   ret = g_hash_table_insert (subplugins[type], g_strdup (name), spdata);
   G_UNLOCK (splock);
 
+  /* registered by the module being opened */
+  loading = g_private_get (&loading_module);
+  if (loading && loading->type == type)
+    g_ptr_array_add (loading->names, g_strdup (name));
+
   return ret;
 }
 
@@ -380,4 +710,6 @@ fini_subplugin (void)
   g_ptr_array_free (handles, TRUE);
   handles = NULL;
   G_UNLOCK (splock);
+
+  subplugin_reload_manifest ();
 }
@@ -97,5 +97,36 @@ subplugin_set_custom_property_desc (subpluginType type, const char *name,
 extern GData *
 subplugin_get_custom_property_desc (subpluginType type, const char *name);
 
+/**
+ * @brief Get the attribute of the subplugin from the subplugin manifest, without loading the subplugin.
+ * @param[in] type Subplugin type
+ * @param[in] name Subplugin name
+ * @param[in] key The attribute name
+ * @return Newly allocated value. NULL if the subplugin is unknown or the module has been changed. Caller should free it.
+ */
+extern gchar *
+subplugin_get_manifest_value (subpluginType type, const char *name,
+    const char *key);
+
+/**
+ * @brief Keep the attribute of the loaded subplugin in the subplugin manifest.
+ * @param[in] type Subplugin type
+ * @param[in] name Subplugin name
+ * @param[in] key The attribute name
+ * @param[in] value The attribute value
+ * @return TRUE if stored. FALSE if the subplugin is not loaded from a module.
+ * @note The attribute is kept until the module is changed.
+ */
+extern gboolean
+subplugin_set_manifest_value (subpluginType type, const char *name,
+    const char *key, const char *value);
+
+/**
+ * @brief Drop the subplugin manifest in memory. It is loaded again with the current configuration at the next use.
+ * @note The manifest path is read once, call this after the configuration is reloaded (e.g., unit tests).
+ */
+extern void
+subplugin_reload_manifest (void);
+
 G_END_DECLS
 #endif /* __GST_NNSTREAMER_SUBPLUGIN_H__ */
@@ -53,11 +53,17 @@
 #include <tensor_decoder/tensordec.h>
 #include <tensor_demux/gsttensordemux.h>
 #include <tensor_filter/tensor_filter.h>
+#include <tensor_filter/tensor_filter_cascade.h>
 #include <tensor_merge/gsttensormerge.h>
 #include <tensor_mux/gsttensormux.h>
 #include <tensor_repo/tensor_reposink.h>
 #include <tensor_repo/tensor_reposrc.h>
+#if !defined(__ANDROID__)
+#include <tensor_repo/tensor_shmsink.h>
+#include <tensor_repo/tensor_shmsrc.h>
+#endif /* !__ANDROID__ */
 #include <tensor_sink/tensor_sink.h>
+#include <tensor_source/tensor_src_synthetic.h>
 #if defined(__gnu_linux__) && !defined(__ANDROID__)
 #include <tensor_source/tensor_src_iio.h>
 #endif /* __gnu_linux__ && !__ANDROID__ */
@@ -91,10 +97,16 @@ gst_nnstreamer_init (GstPlugin * plugin)
   NNSTREAMER_INIT (plugin, decoder, DECODER);
   NNSTREAMER_INIT (plugin, demux, DEMUX);
   NNSTREAMER_INIT (plugin, filter, FILTER);
+  NNSTREAMER_INIT (plugin, filter_cascade, FILTER_CASCADE);
   NNSTREAMER_INIT (plugin, merge, MERGE);
   NNSTREAMER_INIT (plugin, mux, MUX);
   NNSTREAMER_INIT (plugin, reposink, REPOSINK);
   NNSTREAMER_INIT (plugin, reposrc, REPOSRC);
+#if !defined(__ANDROID__)
+  /* POSIX shared memory is not available in Android */
+  NNSTREAMER_INIT (plugin, shmsink, SHMSINK);
+  NNSTREAMER_INIT (plugin, shmsrc, SHMSRC);
+#endif /* !__ANDROID__ */
   NNSTREAMER_INIT (plugin, sink, SINK);
   NNSTREAMER_INIT (plugin, sparse_enc, SPARSE_ENC);
   NNSTREAMER_INIT (plugin, sparse_dec, SPARSE_DEC);
@@ -105,6 +117,7 @@ gst_nnstreamer_init (GstPlugin * plugin)
   NNSTREAMER_INIT (plugin, query_serversrc, QUERY_SERVERSRC);
   NNSTREAMER_INIT (plugin, query_serversink, QUERY_SERVERSINK);
   NNSTREAMER_INIT (plugin, query_client, QUERY_CLIENT);
+  NNSTREAMER_INIT (plugin, src_synthetic, SRC_SYNTHETIC);
 #if defined(__gnu_linux__) && !defined(__ANDROID__)
   /* IIO requires Linux / non-Android */
 #if (GST_VERSION_MAJOR == 1) && (GST_VERSION_MINOR >= 8)
@@ -65,6 +65,9 @@ typedef enum
   SYNC_SLOWEST = 1,
   SYNC_BASEPAD = 2,
   SYNC_REFRESH = 3,
+  SYNC_DEADLINE = 4,
+  SYNC_NEAREST = 5,
+  SYNC_INTERPOLATE = 6,
   SYNC_END,
 } tensor_time_sync_mode;
 
@@ -76,6 +79,35 @@ typedef struct _tensor_sync_basepad_data{
   GstClockTime duration;
 } tensor_sync_basepad_data;
 
+/**
+ * @brief Tensor Merge/Mux sync data for deadline mode
+ */
+typedef struct _tensor_sync_deadline_data{
+  GstClockTime timeout; /**< max time to wait for the other pads after a pad gets a new buffer */
+  GstClockID clock_id; /**< pending deadline, protected by the stream lock of collect pads */
+  guint pending; /**< the number of pads which have a new buffer since the last output */
+  gboolean expired; /**< the deadline is reached, push with the latest buffer of each pad */
+} tensor_sync_deadline_data;
+
+/**
+ * @brief Tensor Merge/Mux sync data for nearest and interpolate mode
+ */
+typedef struct _tensor_sync_nearest_data{
+  guint sink_id; /**< base pad, output timestamps follow this pad */
+  GstClockTime tolerance; /**< max distance to the selected sample, GST_CLOCK_TIME_NONE for unlimited */
+  guint ring_size; /**< max number of buffers kept in the ring of each pad */
+} tensor_sync_nearest_data;
+
+/**
+ * @brief Ring of the buffers sorted by timestamp (nearest and interpolate mode)
+ */
+typedef struct _tensor_sync_ring{
+  GstBuffer **buffers;
+  guint size; /**< capacity of the ring */
+  guint head; /**< index of the oldest buffer */
+  guint len; /**< the number of buffers in the ring */
+} tensor_sync_ring;
+
 /**
  * @brief Tensor Merge/Mux time sync data
  */
@@ -84,6 +116,8 @@ typedef struct _tensor_time_sync_data {
   gchar *option;
   union {
     tensor_sync_basepad_data data_basepad;
+    tensor_sync_deadline_data data_deadline;
+    tensor_sync_nearest_data data_nearest;
   };
 } tensor_time_sync_data;
 
@@ -95,6 +129,8 @@ typedef struct
   GstCollectData collect;
   GstBuffer *buffer;
   GstPad *pad;
+  gboolean updated; /**< buffer is not pushed yet (deadline mode) */
+  tensor_sync_ring ring; /**< buffers sorted by timestamp (nearest and interpolate mode) */
 } GstTensorCollectPadData;
 
 /**
@@ -166,6 +202,35 @@ gst_tensor_time_sync_flush (GstCollectPads * collect);
 extern gboolean
 gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect, tensor_time_sync_data * sync, GstClockTime current_time, GstBuffer * tensors_buf, GstTensorsConfig * configs, gboolean * is_eos);
 
+/**
+ * @brief Start the deadline timer if some pads hold a new buffer which is not pushed yet (deadline mode).
+ * When the deadline is reached, the task of the src pad calls the collect function with the stream lock of collect pads.
+ * @param collect Collect pad.
+ * @param sync Synchronization Option
+ * @param func The collect function of the element.
+ * @param element The element which owns the collect pads, passed to func.
+ * @param srcpad The src pad of the element, which runs the deadline task.
+ */
+extern void
+gst_tensor_time_sync_deadline_schedule (GstCollectPads * collect, tensor_time_sync_data * sync, GstCollectPadsFunction func, GstElement * element, GstPad * srcpad);
+
+/**
+ * @brief Cancel the pending deadline timer (deadline mode).
+ * @param collect Collect pad.
+ * @param sync Synchronization Option
+ */
+extern void
+gst_tensor_time_sync_deadline_cancel (GstCollectPads * collect, tensor_time_sync_data * sync);
+
+/**
+ * @brief Cancel the pending deadline timer and stop the deadline task. Call this before the src pad is deactivated.
+ * @param collect Collect pad.
+ * @param sync Synchronization Option
+ * @param srcpad The src pad of the element, which runs the deadline task.
+ */
+extern void
+gst_tensor_time_sync_deadline_stop (GstCollectPads * collect, tensor_time_sync_data * sync, GstPad * srcpad);
+
 /**
  * @brief Configure gst-buffer with tensors information.
  * NNStreamer handles single memory chunk as single tensor.
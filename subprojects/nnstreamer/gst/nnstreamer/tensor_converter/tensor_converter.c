@@ -170,6 +170,7 @@ static gboolean gst_tensor_converter_parse_caps (GstTensorConverter * self,
 static void gst_tensor_converter_update_caps (GstTensorConverter * self);
 static const NNStreamerExternalConverter *findExternalConverter (const char
     *media_type_name);
+static GstCaps *nnstreamer_converter_query_caps (const char *name);
 
 /**
  * @brief Initialize the tensor_converter's class.
@@ -183,7 +184,6 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
   GstCaps *pad_caps;
   gchar **str_array;
   guint total, i;
-  const NNStreamerExternalConverter *ex;
 
   GST_DEBUG_CATEGORY_INIT (gst_tensor_converter_debug, "tensor_converter", 0,
       "Element to convert media stream to tensor stream");
@@ -300,9 +300,9 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
     total = g_strv_length (str_array);
 
     for (i = 0; i < total; i++) {
-      ex = nnstreamer_converter_find (str_array[i]);
-      if (ex && ex->query_caps)
-        gst_caps_append (pad_caps, ex->query_caps (NULL));
+      GstCaps *caps = nnstreamer_converter_query_caps (str_array[i]);
+      if (caps)
+        gst_caps_append (pad_caps, caps);
     }
 
     g_strfreev (str_array);
@@ -941,6 +941,46 @@ _gst_tensor_converter_chain_push (GstTensorConverter * self, GstBuffer * buf)
   return gst_pad_push (self->srcpad, buffer);
 }
 
+/**
+ * @brief Make the buffer a single memory block (a tensor).
+ * Contiguous spans of the same parent memory are shared without copy.
+ */
+static void
+_gst_tensor_converter_merge_memory (GstBuffer * buf)
+{
+  if (gst_buffer_n_memory (buf) > 1)
+    gst_buffer_replace_all_memory (buf, gst_buffer_get_all_memory (buf));
+}
+
+/**
+ * @brief Append zero padding in place if the memory of the buffer has enough space.
+ * @return TRUE if the buffer is padded.
+ */
+static gboolean
+_gst_tensor_converter_pad_in_place (GstBuffer * buf, gsize size)
+{
+  GstMapInfo info;
+  gsize old_size, offset, maxsize;
+
+  if (!gst_buffer_is_writable (buf) || gst_buffer_n_memory (buf) != 1 ||
+      !gst_buffer_is_memory_range_writable (buf, 0, 1))
+    return FALSE;
+
+  old_size = gst_buffer_get_sizes (buf, &offset, &maxsize);
+  if (old_size >= size || maxsize - offset < size)
+    return FALSE;
+
+  gst_buffer_set_size (buf, size);
+  if (!gst_buffer_map (buf, &info, GST_MAP_WRITE)) {
+    gst_buffer_set_size (buf, old_size);
+    return FALSE;
+  }
+
+  memset (info.data + old_size, 0, size - old_size);
+  gst_buffer_unmap (buf, &info);
+  return TRUE;
+}
+
 /** @brief Chain function's private routine to push multiple buffers */
 static GstFlowReturn
 _gst_tensor_converter_chain_chunk (GstTensorConverter * self,
@@ -994,8 +1034,14 @@ _gst_tensor_converter_chain_chunk (GstTensorConverter * self,
       }
     }
 
-    outbuf = gst_adapter_take_buffer (adapter, out_size);
+    /**
+     * Take the memories without merging. The adapter returns a sub-buffer
+     * if the data is in a buffer, and the memories across the buffers are
+     * copied only if those are not contiguous.
+     */
+    outbuf = gst_adapter_take_buffer_fast (adapter, out_size);
     outbuf = gst_buffer_make_writable (outbuf);
+    _gst_tensor_converter_merge_memory (outbuf);
 
     /** set timestamp */
     GST_BUFFER_PTS (outbuf) = pts;
@@ -1112,9 +1158,15 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       frames_in = buf_size / frame_size;
       break;
     case _NNS_TEXT:
-      if (buf_size != frame_size) {
+      if (buf_size > frame_size) {
+        /* share the memory, the remaining bytes are dropped */
+        inbuf = gst_buffer_copy_region (buf, GST_BUFFER_COPY_ALL, 0,
+            frame_size);
+        _gst_tensor_converter_merge_memory (inbuf);
+      } else if (buf_size < frame_size &&
+          !_gst_tensor_converter_pad_in_place (buf, frame_size)) {
         GstMapInfo src_info, dest_info;
-        gsize block_size = MIN (buf_size, frame_size);
+        gsize block_size = buf_size;
 
         if (!gst_buffer_map (buf, &src_info, GST_MAP_READ)) {
           ml_logf
@@ -2301,6 +2353,41 @@ unregisterExternalConverter (const char *name)
   unregister_subplugin (NNS_SUBPLUGIN_CONVERTER, name);
 }
 
+/**
+ * @brief Get the template caps of converter sub-plugin.
+ * @note This uses the caps in the sub-plugin manifest if available, not to load all sub-plugins.
+ * @return The caps of sub-plugin. NULL if not found. Caller should unref it.
+ */
+static GstCaps *
+nnstreamer_converter_query_caps (const char *name)
+{
+  const NNStreamerExternalConverter *ex;
+  GstCaps *caps = NULL;
+  gchar *str;
+
+  str = subplugin_get_manifest_value (NNS_SUBPLUGIN_CONVERTER, name, "caps");
+  if (str) {
+    caps = gst_caps_from_string (str);
+    g_free (str);
+
+    if (caps)
+      return caps;
+  }
+
+  ex = nnstreamer_converter_find (name);
+  if (ex && ex->query_caps) {
+    caps = ex->query_caps (NULL);
+
+    if (caps) {
+      str = gst_caps_to_string (caps);
+      subplugin_set_manifest_value (NNS_SUBPLUGIN_CONVERTER, name, "caps", str);
+      g_free (str);
+    }
+  }
+
+  return caps;
+}
+
 /**
  * @brief Internal static function to find registered subplugins.
  */
@@ -2318,16 +2405,16 @@ findExternalConverter (const char *media_type)
     total = g_strv_length (str_array);
 
     for (i = 0; i < total; i++) {
-      ex = nnstreamer_converter_find (str_array[i]);
-
       if (g_strcmp0 (media_type, str_array[i]) == 0) {
         /* found matched media type */
+        ex = nnstreamer_converter_find (str_array[i]);
         g_strfreev (str_array);
         return ex;
       }
 
-      if (ex && ex->query_caps) {
-        caps = ex->query_caps (NULL);
+      /* load the sub-plugin only if the media type is matched */
+      caps = nnstreamer_converter_query_caps (str_array[i]);
+      if (caps) {
         caps_size = gst_caps_get_size (caps);
 
         for (j = 0; j < caps_size; j++) {
@@ -2335,6 +2422,7 @@ findExternalConverter (const char *media_type)
           if (g_strcmp0 (media_type, caps_name) == 0) {
             /* found matched media type */
             gst_caps_unref (caps);
+            ex = nnstreamer_converter_find (str_array[i]);
             g_strfreev (str_array);
             return ex;
           }
@@ -11,10 +11,16 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include "tensor_data.h"
+#include "hw_accel.h"
 #include "nnstreamer_log.h"
 #include "nnstreamer_plugin_api.h"
 
+#if defined(HAVE_F16C_INTRINSICS) || defined(HAVE_AVX512BF16_INTRINSICS)
+#include <immintrin.h>
+#endif
+
 /**
  * @brief Macro to set data in struct.
  */
@@ -54,6 +60,219 @@
     } \
   } while (0)
 
+/**
+ * @brief Get the bits of float32 value.
+ */
+static inline guint32
+td_float_to_bits (gfloat f)
+{
+  guint32 bits;
+
+  memcpy (&bits, &f, sizeof (bits));
+  return bits;
+}
+
+/**
+ * @brief Get float32 value from the bits.
+ */
+static inline gfloat
+td_bits_to_float (guint32 bits)
+{
+  gfloat f;
+
+  memcpy (&f, &bits, sizeof (f));
+  return f;
+}
+
+/**
+ * @brief Convert float16 (IEEE 754 binary16) to float32.
+ */
+static inline gfloat
+td_fp16_to_fp32 (guint16 h)
+{
+  guint32 sign = ((guint32) h & 0x8000U) << 16;
+  guint32 exp = (h >> 10) & 0x1fU;
+  guint32 mant = h & 0x3ffU;
+
+  if (exp == 0x1fU) {
+    /* inf or nan (keep nan quiet) */
+    return td_bits_to_float (sign | 0x7f800000U | (mant << 13) |
+        (mant ? 0x400000U : 0));
+  } else if (exp != 0) {
+    return td_bits_to_float (sign | ((exp + 112U) << 23) | (mant << 13));
+  } else if (mant == 0) {
+    return td_bits_to_float (sign);
+  }
+
+  /* subnormal, normalize the mantissa */
+  exp = 113U;
+  while (!(mant & 0x400U)) {
+    mant <<= 1;
+    exp--;
+  }
+
+  return td_bits_to_float (sign | (exp << 23) | ((mant & 0x3ffU) << 13));
+}
+
+/**
+ * @brief Convert float32 to float16 (IEEE 754 binary16), rounding to nearest even.
+ */
+static inline guint16
+td_fp32_to_fp16 (gfloat f)
+{
+  guint32 bits = td_float_to_bits (f);
+  guint32 sign = (bits >> 16) & 0x8000U;
+  guint32 absb = bits & 0x7fffffffU;
+  guint32 r, rem, shift, mant;
+
+  if (absb >= 0x7f800000U) {
+    /* inf or nan (keep nan quiet) */
+    if (absb == 0x7f800000U)
+      return (guint16) (sign | 0x7c00U);
+    return (guint16) (sign | 0x7e00U | ((absb >> 13) & 0x3ffU));
+  }
+
+  /* 65520 and larger rounds to inf */
+  if (absb >= 0x477ff000U)
+    return (guint16) (sign | 0x7c00U);
+
+  if (absb < 0x38800000U) {
+    /* subnormal in float16, 2^-25 and smaller rounds to zero */
+    if (absb <= 0x33000000U)
+      return (guint16) sign;
+
+    mant = (absb & 0x7fffffU) | 0x800000U;
+    shift = 126U - (absb >> 23);
+    r = mant >> shift;
+    rem = mant & ((1U << shift) - 1U);
+
+    if (rem > (1U << (shift - 1U)) || (rem == (1U << (shift - 1U)) && (r & 1U)))
+      r++;
+
+    return (guint16) (sign | r);
+  }
+
+  /* normal, re-bias the exponent */
+  r = (absb - 0x38000000U) >> 13;
+  rem = absb & 0x1fffU;
+
+  if (rem > 0x1000U || (rem == 0x1000U && (r & 1U)))
+    r++;
+
+  return (guint16) (sign | r);
+}
+
+/**
+ * @brief Convert bfloat16 to float32.
+ */
+static inline gfloat
+td_bf16_to_fp32 (guint16 b)
+{
+  return td_bits_to_float ((guint32) b << 16);
+}
+
+/**
+ * @brief Convert float32 to bfloat16, rounding to nearest even.
+ */
+static inline guint16
+td_fp32_to_bf16 (gfloat f)
+{
+  guint32 bits = td_float_to_bits (f);
+
+  /* keep nan quiet */
+  if ((bits & 0x7fffffffU) > 0x7f800000U)
+    return (guint16) ((bits >> 16) | 0x40U);
+
+  bits += 0x7fffU + ((bits >> 16) & 1U);
+  return (guint16) (bits >> 16);
+}
+
+#ifdef HAVE_F16C_INTRINSICS
+/**
+ * @brief Convert float16 to float32 with F16C.
+ */
+__attribute__ ((target ("avx,f16c")))
+static void
+td_fp16_to_fp32_f16c (const guint16 * in, gfloat * out, gsize num)
+{
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    __m128i h = _mm_loadu_si128 ((const __m128i *) (in + i));
+    _mm256_storeu_ps (out + i, _mm256_cvtph_ps (h));
+  }
+
+  for (; i < num; i++)
+    out[i] = td_fp16_to_fp32 (in[i]);
+}
+
+/**
+ * @brief Convert float32 to float16 with F16C.
+ */
+__attribute__ ((target ("avx,f16c")))
+static void
+td_fp32_to_fp16_f16c (const gfloat * in, guint16 * out, gsize num)
+{
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    __m256 v = _mm256_loadu_ps (in + i);
+    _mm_storeu_si128 ((__m128i *) (out + i),
+        _mm256_cvtps_ph (v, _MM_FROUND_TO_NEAREST_INT));
+  }
+
+  for (; i < num; i++)
+    out[i] = td_fp32_to_fp16 (in[i]);
+}
+#endif /* HAVE_F16C_INTRINSICS */
+
+#ifdef HAVE_AVX512BF16_INTRINSICS
+/**
+ * @brief Convert float32 to bfloat16 with AVX512-BF16.
+ * @note vcvtneps2bf16 flushes subnormal inputs to zero.
+ */
+__attribute__ ((target ("avx512f,avx512bf16")))
+static void
+td_fp32_to_bf16_avx512 (const gfloat * in, guint16 * out, gsize num)
+{
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    __m512 v = _mm512_loadu_ps (in + i);
+    _mm256_storeu_si256 ((__m256i *) (out + i),
+        (__m256i) _mm512_cvtneps_pbh (v));
+  }
+
+  for (; i < num; i++)
+    out[i] = td_fp32_to_bf16 (in[i]);
+}
+#endif /* HAVE_AVX512BF16_INTRINSICS */
+
+#if defined(HAVE_F16C_INTRINSICS) || defined(HAVE_AVX512BF16_INTRINSICS)
+/**
+ * @brief Check the cpu features for half precision conversion once.
+ * @return bit 0 if F16C is available, bit 1 if AVX512-BF16 is available.
+ */
+static guint
+td_half_accel (void)
+{
+  static gsize accel = 0;
+
+  if (g_once_init_enter (&accel)) {
+    gsize features = 0x100;
+
+    if (cpu_f16c_accel_available () == 0)
+      features |= 0x1;
+    if (cpu_avx512bf16_accel_available () == 0)
+      features |= 0x2;
+
+    g_once_init_leave (&accel, features);
+  }
+
+  return (guint) (accel & 0x3);
+}
+#endif /* HAVE_F16C_INTRINSICS || HAVE_AVX512BF16_INTRINSICS */
+
 /**
  * @brief Set tensor element data with given type.
  * @param td struct for tensor data
@@ -101,6 +320,10 @@ gst_tensor_data_set (tensor_data_s * td, tensor_type type, gpointer value)
     case _NNS_UINT64:
       td_set_data (td, value, uint64_t);
       break;
+    case _NNS_FLOAT16:
+    case _NNS_BFLOAT16:
+      td_set_data (td, value, uint16_t);
+      break;
     default:
       nns_logw ("Unknown tensor type %d", type);
       return FALSE;
@@ -153,6 +376,10 @@ gst_tensor_data_get (tensor_data_s * td, gpointer value)
     case _NNS_UINT64:
       td_get_data (td, value, uint64_t);
       break;
+    case _NNS_FLOAT16:
+    case _NNS_BFLOAT16:
+      td_get_data (td, value, uint16_t);
+      break;
     default:
       nns_logw ("Unknown tensor type %d", td->type);
       return FALSE;
@@ -176,6 +403,34 @@ gst_tensor_data_typecast (tensor_data_s * td, tensor_type type)
 
   /* do nothing when transform to same type */
   if (td->type != type) {
+    /* half precision has no native type, convert through float32 */
+    if (td->type == _NNS_FLOAT16 || td->type == _NNS_BFLOAT16) {
+      gfloat f = (td->type == _NNS_FLOAT16) ?
+          td_fp16_to_fp32 (td->data._uint16_t) :
+          td_bf16_to_fp32 (td->data._uint16_t);
+
+      td->data._float = f;
+      td->type = _NNS_FLOAT32;
+
+      if (type == _NNS_FLOAT32)
+        return TRUE;
+    }
+
+    if (type == _NNS_FLOAT16 || type == _NNS_BFLOAT16) {
+      guint16 h;
+
+      if (!gst_tensor_data_typecast (td, _NNS_FLOAT32))
+        return FALSE;
+
+      h = (type == _NNS_FLOAT16) ? td_fp32_to_fp16 (td->data._float) :
+          td_fp32_to_bf16 (td->data._float);
+
+      td->data._int64_t = 0;
+      td->data._uint16_t = h;
+      td->type = type;
+      return TRUE;
+    }
+
     is_float = (td->type == _NNS_FLOAT32 || td->type == _NNS_FLOAT64);
 
     switch (type) {
@@ -261,6 +516,94 @@ gst_tensor_data_raw_typecast (gpointer input, tensor_type in_type,
   return TRUE;
 }
 
+/**
+ * @brief Convert half precision tensor data to float32.
+ * @param input pointer of input tensor data (float16 or bfloat16)
+ * @param type input tensor type
+ * @param output pointer of output float32 array
+ * @param num the number of elements
+ * @return TRUE if no error
+ */
+gboolean
+gst_tensor_data_raw_half_to_float (gconstpointer input, tensor_type type,
+    gfloat * output, gsize num)
+{
+  const guint16 *in = (const guint16 *) input;
+  gsize i;
+
+  g_return_val_if_fail (input != NULL, FALSE);
+  g_return_val_if_fail (output != NULL, FALSE);
+
+  switch (type) {
+    case _NNS_FLOAT16:
+#ifdef HAVE_F16C_INTRINSICS
+      if (td_half_accel () & 0x1) {
+        td_fp16_to_fp32_f16c (in, output, num);
+        break;
+      }
+#endif
+      for (i = 0; i < num; i++)
+        output[i] = td_fp16_to_fp32 (in[i]);
+      break;
+    case _NNS_BFLOAT16:
+      for (i = 0; i < num; i++)
+        output[i] = td_bf16_to_fp32 (in[i]);
+      break;
+    default:
+      nns_logw ("Tensor type %d is not half precision", type);
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Convert float32 tensor data to half precision, rounding to nearest even.
+ * @param input pointer of input float32 array
+ * @param output pointer of output tensor data (float16 or bfloat16)
+ * @param type output tensor type
+ * @param num the number of elements
+ * @return TRUE if no error
+ */
+gboolean
+gst_tensor_data_raw_float_to_half (const gfloat * input, gpointer output,
+    tensor_type type, gsize num)
+{
+  guint16 *out = (guint16 *) output;
+  gsize i;
+
+  g_return_val_if_fail (input != NULL, FALSE);
+  g_return_val_if_fail (output != NULL, FALSE);
+
+  switch (type) {
+    case _NNS_FLOAT16:
+#ifdef HAVE_F16C_INTRINSICS
+      if (td_half_accel () & 0x1) {
+        td_fp32_to_fp16_f16c (input, out, num);
+        break;
+      }
+#endif
+      for (i = 0; i < num; i++)
+        out[i] = td_fp32_to_fp16 (input[i]);
+      break;
+    case _NNS_BFLOAT16:
+#ifdef HAVE_AVX512BF16_INTRINSICS
+      if (td_half_accel () & 0x2) {
+        td_fp32_to_bf16_avx512 (input, out, num);
+        break;
+      }
+#endif
+      for (i = 0; i < num; i++)
+        out[i] = td_fp32_to_bf16 (input[i]);
+      break;
+    default:
+      nns_logw ("Tensor type %d is not half precision", type);
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Calculate average value of the tensor.
  * @param raw pointer of raw tensor data
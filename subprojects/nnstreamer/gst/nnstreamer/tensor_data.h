@@ -26,6 +26,11 @@ typedef struct
   tensor_element data;
 } tensor_data_s;
 
+/**
+ * @brief Check if the tensor type is half precision (float16 or bfloat16).
+ */
+#define gst_tensor_data_is_half(t) ((t) == _NNS_FLOAT16 || (t) == _NNS_BFLOAT16)
+
 /**
  * @brief Set tensor element data with given type.
  * @param td struct for tensor data
@@ -66,6 +71,30 @@ extern gboolean
 gst_tensor_data_raw_typecast (gpointer input, tensor_type in_type,
     gpointer output, tensor_type out_type);
 
+/**
+ * @brief Convert half precision tensor data to float32.
+ * @param input pointer of input tensor data (float16 or bfloat16)
+ * @param type input tensor type
+ * @param output pointer of output float32 array
+ * @param num the number of elements
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_half_to_float (gconstpointer input, tensor_type type,
+    gfloat * output, gsize num);
+
+/**
+ * @brief Convert float32 tensor data to half precision, rounding to nearest even.
+ * @param input pointer of input float32 array
+ * @param output pointer of output tensor data (float16 or bfloat16)
+ * @param type output tensor type
+ * @param num the number of elements
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_float_to_half (const gfloat * input, gpointer output,
+    tensor_type type, gsize num);
+
 /**
  * @brief Calculate average value of the tensor.
  * @param raw pointer of raw tensor data
@@ -125,6 +125,10 @@ static gboolean gst_tensordec_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensordec_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensordec_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query);
+static GstFlowReturn gst_tensordec_prepare_output_buffer (GstBaseTransform *
+    trans, GstBuffer * inbuf, GstBuffer ** outbuf);
 
 /**
  * @brief Validate decoder sub-plugin's data.
@@ -145,6 +149,40 @@ nnstreamer_decoder_validate (const GstTensorDecoderDef * decoder)
   return TRUE;
 }
 
+/**
+ * @brief The callbacks handling the buffers (GstTensorDecoderBufferDef), with the name of decoder sub-plugin.
+ */
+static GHashTable *decoder_buffer_defs = NULL;
+G_LOCK_DEFINE_STATIC (buffer_defs_lock);
+
+/**
+ * @brief Find the callbacks handling the buffers of decoder sub-plugin.
+ */
+static const GstTensorDecoderBufferDef *
+nnstreamer_decoder_find_buffer_def (const char *name)
+{
+  const GstTensorDecoderBufferDef *buffer_def = NULL;
+
+  G_LOCK (buffer_defs_lock);
+  if (decoder_buffer_defs)
+    buffer_def = g_hash_table_lookup (decoder_buffer_defs, name);
+  G_UNLOCK (buffer_defs_lock);
+
+  return buffer_def;
+}
+
+/**
+ * @brief Remove the callbacks handling the buffers of decoder sub-plugin.
+ */
+static void
+nnstreamer_decoder_remove_buffer_def (const char *name)
+{
+  G_LOCK (buffer_defs_lock);
+  if (decoder_buffer_defs)
+    g_hash_table_remove (decoder_buffer_defs, name);
+  G_UNLOCK (buffer_defs_lock);
+}
+
 /**
  * @brief Decoder's sub-plugin should call this function to register itself.
  * @param[in] decoder Decoder sub-plugin to be registered.
@@ -157,6 +195,43 @@ nnstreamer_decoder_probe (GstTensorDecoderDef * decoder)
   return register_subplugin (NNS_SUBPLUGIN_DECODER, decoder->modename, decoder);
 }
 
+/**
+ * @brief Decoder's sub-plugin may call this function instead of nnstreamer_decoder_probe() to register itself with the callbacks handling the buffers directly.
+ * @param[in] decoder Decoder sub-plugin to be registered.
+ * @param[in] buffer_def The callbacks handling the buffers. It should be valid until the sub-plugin is unregistered.
+ * @return TRUE if registered. FALSE is failed or duplicated.
+ */
+int
+nnstreamer_decoder_probe_buffer (GstTensorDecoderDef * decoder,
+    const GstTensorDecoderBufferDef * buffer_def)
+{
+  g_return_val_if_fail (nnstreamer_decoder_validate (decoder), FALSE);
+  g_return_val_if_fail (buffer_def != NULL, FALSE);
+
+  /* Add the callbacks first, tensor_decoder may find the sub-plugin once it is registered. */
+  G_LOCK (buffer_defs_lock);
+  if (!decoder_buffer_defs)
+    decoder_buffer_defs =
+        g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  if (g_hash_table_contains (decoder_buffer_defs, decoder->modename)) {
+    G_UNLOCK (buffer_defs_lock);
+    ml_logw ("Decoder %s is already registered.", decoder->modename);
+    return FALSE;
+  }
+
+  g_hash_table_insert (decoder_buffer_defs, g_strdup (decoder->modename),
+      (gpointer) buffer_def);
+  G_UNLOCK (buffer_defs_lock);
+
+  if (!nnstreamer_decoder_probe (decoder)) {
+    nnstreamer_decoder_remove_buffer_def (decoder->modename);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Decoder's sub-plugin may call this to unregister itself.
  * @param[in] name The name of decoder sub-plugin.
@@ -165,6 +240,7 @@ void
 nnstreamer_decoder_exit (const char *name)
 {
   unregister_subplugin (NNS_SUBPLUGIN_DECODER, name);
+  nnstreamer_decoder_remove_buffer_def (name);
 }
 
 /**
@@ -385,6 +461,10 @@ gst_tensordec_class_init (GstTensorDecClass * klass)
   /** Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensordec_transform_size);
+  trans_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_tensordec_decide_allocation);
+  trans_class->prepare_output_buffer =
+      GST_DEBUG_FUNCPTR (gst_tensordec_prepare_output_buffer);
 }
 
 /**
@@ -402,6 +482,7 @@ gst_tensordec_init (GstTensorDec * self)
   self->configured = FALSE;
   self->negotiated = FALSE;
   self->decoder = NULL;
+  self->buffer_def = NULL;
   self->plugin_data = NULL;
   self->is_custom = FALSE;
   self->custom.func = NULL;
@@ -485,6 +566,8 @@ gst_tensordec_set_property (GObject * object, guint prop_id,
           /* Changing decoder. Deallocate the previous */
           gst_tensor_decoder_clean_plugin (self);
           self->decoder = decoder;
+          self->buffer_def =
+              nnstreamer_decoder_find_buffer_def (decoder->modename);
         }
 
         if (0 == self->decoder->init (&self->plugin_data)) {
@@ -503,6 +586,7 @@ gst_tensordec_set_property (GObject * object, guint prop_id,
             mode_string);
         gst_tensor_decoder_clean_plugin (self);
         self->decoder = NULL;
+        self->buffer_def = NULL;
       }
       break;
     }
@@ -658,6 +742,16 @@ gst_tensordec_configure (GstTensorDec * self, const GstCaps * in_caps,
   return TRUE;
 }
 
+/**
+ * @brief Check whether the sub-plugin decodes the buffers directly.
+ */
+static inline gboolean
+gst_tensordec_is_buffer_decoder (GstTensorDec * self)
+{
+  return (!self->is_custom && self->decoder && self->buffer_def &&
+      self->buffer_def->decodeBuffer);
+}
+
 /**
  * @brief non-ip transform. required vmethod for BaseTransform class.
  */
@@ -688,6 +782,11 @@ gst_tensordec_transform (GstBaseTransform * trans,
     /** Internal logic error. Negotation process should prevent this! */
     g_assert (gst_buffer_n_memory (inbuf) == num_tensors);
 
+    /** The sub-plugin handles the buffers directly and may share the input memories. */
+    if (gst_tensordec_is_buffer_decoder (self))
+      return self->buffer_def->decodeBuffer (&self->plugin_data,
+          &self->tensor_config, inbuf, outbuf);
+
     for (i = 0; i < num_tensors; i++) {
       in_mem[i] = gst_buffer_peek_memory (inbuf, i);
       if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
@@ -927,6 +1026,63 @@ gst_tensordec_transform_size (GstBaseTransform * trans,
   return TRUE;
 }
 
+/**
+ * @brief Decide allocation with downstream. optional vmethod of BaseTransform
+ */
+static gboolean
+gst_tensordec_decide_allocation (GstBaseTransform * trans, GstQuery * query)
+{
+  GstTensorDec *self = GST_TENSOR_DECODER_CAST (trans);
+
+  if (!self->is_custom && self->decoder && self->buffer_def &&
+      self->buffer_def->decideAllocation) {
+    if (!self->buffer_def->decideAllocation (&self->plugin_data,
+            &self->tensor_config, query)) {
+      GST_ERROR_OBJECT (self, "The sub-plugin failed to decide allocation.");
+      return FALSE;
+    }
+  }
+
+  /**
+   * Output buffers of decodeBuffer are not acquired from the pool.
+   * Remove the pools not to allocate the buffers which are never used.
+   */
+  if (gst_tensordec_is_buffer_decoder (self)) {
+    while (gst_query_get_n_allocation_pools (query) > 0)
+      gst_query_remove_nth_allocation_pool (query, 0);
+  }
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->decide_allocation (trans,
+      query);
+}
+
+/**
+ * @brief Prepare the output buffer. optional vmethod of BaseTransform
+ *
+ * If the sub-plugin decodes the buffers directly, pass an empty buffer so that it can append the input memories without copy.
+ */
+static GstFlowReturn
+gst_tensordec_prepare_output_buffer (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer ** outbuf)
+{
+  GstTensorDec *self = GST_TENSOR_DECODER_CAST (trans);
+  GstBaseTransformClass *klass;
+
+  if (!gst_tensordec_is_buffer_decoder (self))
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->prepare_output_buffer
+        (trans, inbuf, outbuf);
+
+  *outbuf = gst_buffer_new ();
+
+  klass = GST_BASE_TRANSFORM_GET_CLASS (trans);
+  if (klass->copy_metadata && !klass->copy_metadata (trans, inbuf, *outbuf)) {
+    GST_ELEMENT_WARNING (self, STREAM, NOT_IMPLEMENTED, (NULL),
+        ("could not copy metadata"));
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief Registers a callback for tensor_decoder custom condition
  * @return 0 if success. -ERRNO if error.
@@ -82,6 +82,7 @@ struct _GstTensorDec
   decoder_custom_cb_s custom;
 
   const GstTensorDecoderDef *decoder; /**< Plugin object */
+  const GstTensorDecoderBufferDef *buffer_def; /**< Optional callbacks of plugin object to handle the buffers */
   void *plugin_data;
 };
 
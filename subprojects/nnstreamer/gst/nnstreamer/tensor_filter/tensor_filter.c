@@ -78,9 +78,6 @@
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_filter_debug);
 #define GST_CAT_DEFAULT gst_tensor_filter_debug
 
-#define TF_MODELNAME(prop) \
-    ((prop)->model_files ? ((prop)->model_files[0]) : "[No Model File]")
-
 /**
  * @brief Default caps string for both sink and source pad.
  */
@@ -112,9 +109,15 @@ static void gst_tensor_filter_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_tensor_filter_finalize (GObject * object);
 
+/* GstElement vmethod implementations */
+static GstStateChangeReturn gst_tensor_filter_change_state (GstElement *
+    element, GstStateChange transition);
+
 /* GstBaseTransform vmethod implementations */
 static GstFlowReturn gst_tensor_filter_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf);
+static GstFlowReturn gst_tensor_filter_transform_ip (GstBaseTransform * trans,
+    GstBuffer * buf);
 static GstCaps *gst_tensor_filter_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_tensor_filter_fixate_caps (GstBaseTransform * trans,
@@ -170,6 +173,8 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   /* Processing units */
   trans_class->transform = GST_DEBUG_FUNCPTR (gst_tensor_filter_transform);
+  trans_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_transform_ip);
 
   /* Negotiation units */
   trans_class->transform_caps =
@@ -188,6 +193,9 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
   /* start/stop to call open/close */
   trans_class->start = GST_DEBUG_FUNCPTR (gst_tensor_filter_start);
   trans_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_filter_stop);
+
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_change_state);
 }
 
 /**
@@ -329,24 +337,59 @@ gst_tensor_filter_get_wrapped_mem (GstTensorFilter * self, gpointer data,
 }
 
 /**
- * @brief Prepare statistics for performance profiling (e.g, latency, throughput)
+ * @brief Get the delay (usec) from the running time of the buffer to the current clock time.
+ * @return The delay, or -1 if the buffer is early or there is no clock.
+ * @note The clock and the base time are cached when going to PLAYING, so this does not lock the element.
  */
-static void
-prepare_statistics (GstTensorFilterPrivate * priv)
+static gint64
+gst_tensor_filter_get_queue_delay (GstTensorFilter * self, GstBuffer * inbuf)
 {
-  priv->stat.latest_invoke_time = g_get_real_time ();
+  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (self);
+  GstTensorFilterStatistics *stat = &self->priv.stat;
+  GstClockTime running_time, now;
+
+  if (stat->clock == NULL || !GST_CLOCK_TIME_IS_VALID (stat->base_time))
+    return -1;
+
+  if (!GST_BUFFER_PTS_IS_VALID (inbuf) || trans->segment.format != GST_FORMAT_TIME)
+    return -1;
+
+  running_time = gst_segment_to_running_time (&trans->segment,
+      GST_FORMAT_TIME, GST_BUFFER_PTS (inbuf));
+  if (!GST_CLOCK_TIME_IS_VALID (running_time))
+    return -1;
+
+  now = gst_clock_get_time (stat->clock);
+
+  /* buffers of non-live sources usually arrive earlier than the running time */
+  if (now < stat->base_time + running_time)
+    return -1;
+
+  return (gint64) ((now - stat->base_time - running_time) / GST_USECOND);
 }
 
 /**
- * @brief Helper function to accumulate latencies
+ * @brief Start statistics of the incoming buffer (queueing delay)
  */
 static void
-accumulate_latency (void *data, void *user_data)
+start_statistics (GstTensorFilter * self, GstBuffer * inbuf)
 {
-  gint64 *latency = data;
-  gint64 *total_latency = user_data;
+  GstTensorFilterPrivate *priv = &self->priv;
 
-  *total_latency += *latency;
+  priv->stat.latest_transform_time = g_get_monotonic_time ();
+  priv->stat.samples[GST_TF_STAT_QUEUE] =
+      gst_tensor_filter_get_queue_delay (self, inbuf);
+}
+
+/**
+ * @brief Prepare statistics for performance profiling (e.g, latency, throughput)
+ */
+static void
+prepare_statistics (GstTensorFilterPrivate * priv)
+{
+  priv->stat.latest_invoke_time = g_get_monotonic_time ();
+  priv->stat.samples[GST_TF_STAT_PRE] =
+      priv->stat.latest_invoke_time - priv->stat.latest_transform_time;
 }
 
 #define THRESHOLD_DROP_OLD  (2000)
@@ -358,26 +401,27 @@ accumulate_latency (void *data, void *user_data)
 static void
 record_statistics (GstTensorFilterPrivate * priv)
 {
-  gint64 end_time = g_get_real_time ();
-  gint64 *latency = g_new (gint64, 1);
-  GQueue *recent_latencies = priv->stat.recent_latencies;
+  GstTensorFilterStatistics *stat = &priv->stat;
+  gint64 end_time = g_get_monotonic_time ();
+  gint64 latency = end_time - stat->latest_invoke_time;
 
-  *latency = end_time - priv->stat.latest_invoke_time;
-  priv->stat.total_invoke_latency += *latency;
-  priv->stat.total_invoke_num += 1;
+  stat->latest_invoke_done = end_time;
+  stat->total_invoke_latency += latency;
+  stat->total_invoke_num += 1;
 
-  if (g_queue_get_length (recent_latencies) == GST_TF_STAT_MAX_RECENT)
-    g_free (g_queue_pop_head (recent_latencies));
-  g_queue_push_tail (recent_latencies, latency);
+  stat->samples[GST_TF_STAT_INVOKE] = latency;
 
-  /* the queue should have at least one element */
-  g_assert (g_queue_get_length (recent_latencies) != 0);
+  /* keep the recent latencies in a fixed ring with a running sum */
+  if (stat->recent_num == GST_TF_STAT_MAX_RECENT)
+    stat->recent_total -= stat->recent_latencies[stat->recent_index];
+  else
+    stat->recent_num++;
+  stat->recent_latencies[stat->recent_index] = latency;
+  stat->recent_total += latency;
+  stat->recent_index = (stat->recent_index + 1) % GST_TF_STAT_MAX_RECENT;
 
   if (priv->latency_mode > 0) {
-    gint64 avg_latency = 0;
-
-    g_queue_foreach (recent_latencies, accumulate_latency, &avg_latency);
-    avg_latency /= g_queue_get_length (recent_latencies);
+    gint64 avg_latency = stat->recent_total / stat->recent_num;
 
     /* check integer overflow */
     if (avg_latency <= INT32_MAX)
@@ -386,7 +430,7 @@ record_statistics (GstTensorFilterPrivate * priv)
       priv->prop.latency = -1;
 
     ml_logi ("[%s] Invoke took %.3f ms", TF_MODELNAME (&(priv->prop)),
-        (*latency) / 1000.0);
+        latency / 1000.0);
   }
 
   if (priv->throughput_mode > 0) {
@@ -429,6 +473,29 @@ record_statistics (GstTensorFilterPrivate * priv)
   }
 }
 
+/**
+ * @brief Record the latencies of all stages of the invoke and post the latency report if it is due.
+ */
+static void
+finish_statistics (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  gint64 now = g_get_monotonic_time ();
+
+  priv->stat.samples[GST_TF_STAT_POST] = now - priv->stat.latest_invoke_done;
+  gst_tensor_filter_statistics_add (&priv->stat, priv->stat.samples);
+
+  if (priv->latency_report > 0 &&
+      now - priv->stat.latest_report_time >=
+      (gint64) priv->latency_report * 1000) {
+    GstStructure *s = gst_tensor_filter_statistics_get_latency (&priv->stat);
+
+    priv->stat.latest_report_time = now;
+    gst_element_post_message (GST_ELEMENT_CAST (self),
+        gst_message_new_element (GST_OBJECT_CAST (self), s));
+  }
+}
+
 /**
  * @brief Check throttling delay and send qos overflow event to upstream elements
  */
@@ -544,6 +611,10 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
   if (gst_tensor_filter_check_throttling_delay (trans, inbuf))
     return GST_BASE_TRANSFORM_FLOW_DROPPED;
 
+  /* in-place mode, the output tensors are written over the input buffer */
+  if (outbuf == inbuf)
+    return GST_FLOW_OK;
+
   if (!outbuf) {
     GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
         ("The output buffer for the instance of tensor-filter subplugin (%s / %s) is null. Cannot proceed.",
@@ -594,6 +665,11 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
   if (retval != GST_FLOW_OK)
     return retval;
 
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_report > 0);
+  if (need_profiling)
+    start_statistics (self, inbuf);
+
   allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
 
   in_flexible =
@@ -713,7 +789,6 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     }
   }
 
-  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0);
   if (need_profiling)
     prepare_statistics (priv);
 
@@ -806,6 +881,9 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     gst_buffer_append_memory (outbuf, out_mem[i]);
   }
 
+  if (need_profiling)
+    finish_statistics (self);
+
   return GST_FLOW_OK;
 mem_map_error:
   num_mems = gst_buffer_n_memory (inbuf);
@@ -825,6 +903,139 @@ mem_map_error:
   return GST_FLOW_ERROR;
 }
 
+/**
+ * @brief in-place transform. optional vmethod of GstBaseTransform.
+ *
+ * Called only if in-place mode is set with the negotiated caps (see gst_tensor_filter_check_in_place ()).
+ * The output tensors are written over the input tensors.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMapInfo info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  guint i, num_mems, mapped = 0;
+  gint ret;
+  gboolean need_profiling;
+  gsize expected;
+
+  /* 0. Check all properties. */
+  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, buf,
+      buf);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_report > 0);
+  if (need_profiling)
+    start_statistics (self, buf);
+
+  num_mems = gst_buffer_n_memory (buf);
+  if (num_mems != prop->input_meta.num_tensors) {
+    ml_loge_stacktrace
+        ("gst_tensor_filter_transform_ip: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors). Maybe, the pad capability is not consistent with the actual input stream.\n",
+        num_mems, prop->input_meta.num_tensors);
+    return GST_FLOW_ERROR;
+  }
+
+  /* 1. Map the tensors for read and write, a shared or read-only memory is copied here. */
+  for (i = 0; i < num_mems; i++) {
+    if (!gst_buffer_map_range (buf, i, 1, &info[i], GST_MAP_READWRITE)) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_transform_ip: For the given input buffer, tensor-filter (%s : %s) cannot map the %u-th memory chunk for read and write.\n",
+          prop->fwname, TF_MODELNAME (prop), i);
+      goto mem_map_error;
+    }
+    mapped++;
+
+    expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+    if (expected != info[i].size) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_transform_ip: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd, which is the frame size of the corresponding tensor.\n",
+          i, info[i].size, expected);
+      goto mem_map_error;
+    }
+
+    in_tensors[i].data = out_tensors[i].data = info[i].data;
+    in_tensors[i].size = out_tensors[i].size = info[i].size;
+  }
+
+  if (need_profiling)
+    prepare_statistics (priv);
+
+  /* 2. Call the filter-subplugin callback, "invoke", with the aliased tensors */
+  GST_TF_FW_INVOKE_COMPAT (priv, ret, in_tensors, out_tensors);
+  if (need_profiling)
+    record_statistics (priv);
+
+  for (i = 0; i < num_mems; i++)
+    gst_buffer_unmap (buf, &info[i]);
+
+  if (ret < 0) {
+    ml_loge_stacktrace
+        ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
+        prop->fwname, TF_MODELNAME (prop), ret);
+    return GST_FLOW_ERROR;
+  } else if (ret > 0) {
+    /* drop this buffer */
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  }
+
+  if (need_profiling)
+    finish_statistics (self);
+
+  return GST_FLOW_OK;
+mem_map_error:
+  for (i = 0; i < mapped; i++)
+    gst_buffer_unmap (buf, &info[i]);
+
+  return GST_FLOW_ERROR;
+}
+
+/**
+ * @brief Check if the output tensors can be written over the input tensors.
+ * @param self "this" pointer
+ * @param out_config the config of src pad
+ * @return TRUE if the framework allows in-place invoke and the layouts of input and output match.
+ */
+static gboolean
+gst_tensor_filter_check_in_place (GstTensorFilter * self,
+    const GstTensorsConfig * out_config)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  guint i;
+
+  if (!gst_tensor_filter_allow_in_place (priv) ||
+      gst_tensor_filter_allocate_in_invoke (priv))
+    return FALSE;
+
+  /* tensors are added or removed with combination option */
+  if (priv->combi.in_combi_defined || priv->combi.out_combi_i_defined ||
+      priv->combi.out_combi_o_defined)
+    return FALSE;
+
+  /* flexible and sparse tensors have a header in the memory */
+  if (!gst_tensors_config_is_static (&priv->in_config) ||
+      !gst_tensors_config_is_static (out_config))
+    return FALSE;
+
+  if (prop->input_meta.num_tensors != prop->output_meta.num_tensors)
+    return FALSE;
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    if (gst_tensor_filter_get_tensor_size (self, i, TRUE) !=
+        gst_tensor_filter_get_tensor_size (self, i, FALSE))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Configure input and output tensor info from incaps.
  * @param self "this" pointer
@@ -1007,6 +1218,7 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
     gst_tensors_config_copy (&priv->out_config, &out_config);
 
     priv->configured = TRUE;
+    gst_tensor_filter_common_warmup (priv);
   }
 
 done:
@@ -1227,6 +1439,12 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
     return FALSE;
   }
 
+  /* write the output tensors over the input buffer if possible, it saves an allocation for each frame */
+  gst_base_transform_set_in_place (trans,
+      gst_tensor_filter_check_in_place (self, &config));
+  silent_debug (self, "In-place invoke: %s\n",
+      gst_base_transform_is_in_place (trans) ? "enabled" : "disabled");
+
   return TRUE;
 }
 
@@ -1355,7 +1573,15 @@ gst_tensor_filter_start (GstBaseTransform * trans)
   if (priv->fw == NULL)
     return FALSE;
   gst_tensor_filter_common_open_fw (priv);
-  return priv->prop.fw_opened;
+  if (!priv->prop.fw_opened)
+    return FALSE;
+
+  /* warm up now if the model has fixed tensor info, or after the caps are set. */
+  if (priv->warmup > 0) {
+    gst_tensor_filter_load_tensor_info (priv);
+    gst_tensor_filter_common_warmup (priv);
+  }
+  return TRUE;
 }
 
 /**
@@ -1371,5 +1597,39 @@ gst_tensor_filter_stop (GstBaseTransform * trans)
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
   gst_tensor_filter_common_close_fw (priv);
+
+  /* the streaming thread is stopped, release the cached clock */
+  if (priv->stat.clock) {
+    gst_object_unref (priv->stat.clock);
+    priv->stat.clock = NULL;
+  }
+  priv->stat.base_time = GST_CLOCK_TIME_NONE;
   return TRUE;
 }
+
+/**
+ * @brief Cache the clock and the base time to measure the queueing delay without locking the element.
+ */
+static GstStateChangeReturn
+gst_tensor_filter_change_state (GstElement * element, GstStateChange transition)
+{
+  GstTensorFilterPrivate *priv = &GST_TENSOR_FILTER_CAST (element)->priv;
+
+  if (transition == GST_STATE_CHANGE_PAUSED_TO_PLAYING) {
+    GstClock *clock;
+
+    GST_OBJECT_LOCK (element);
+    clock = GST_ELEMENT_CLOCK (element);
+    if (clock != priv->stat.clock) {
+      if (clock)
+        gst_object_ref (clock);
+      if (priv->stat.clock)
+        gst_object_unref (priv->stat.clock);
+      priv->stat.clock = clock;
+    }
+    priv->stat.base_time = GST_ELEMENT_CAST (element)->base_time;
+    GST_OBJECT_UNLOCK (element);
+  }
+
+  return GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+}
@@ -0,0 +1,1582 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_cascade.c
+ * @date	18 Oct 2026
+ * @brief	GStreamer element to run a graph of models and glue operations in one element
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+/**
+ * SECTION:element-tensor_filter_cascade
+ *
+ * tensor_filter_cascade runs a small graph (DAG) of neural network models and
+ * glue operations (crop, resize, threshold) with a single element.
+ * Multi-stage pipelines (e.g., detector, crop and classifier) usually need
+ * several tensor_filter, tensor_crop and queue elements. With this element,
+ * the intermediate tensors are handed over to the next stage by pointer,
+ * without caps negotiation, buffer wrapping or thread switching for each hop,
+ * and the stages not depending on each other run in parallel.
+ *
+ * The property 'stages' describes the graph. Stages are separated by ';'
+ * and each stage is "name:operation key=value ...".
+ * - filter: a model. The keys are the properties of tensor_filter
+ *   (framework, model, custom, accelerator, input, inputtype, ...).
+ * - crop: region=x:y:w:h crops the region of the first input tensor.
+ *   With a second input tensor, its first four values (x, y, w, h) give the
+ *   region instead, and the region is scaled (nearest) to the size w:h of the
+ *   property region, so that the output dimension is fixed.
+ * - resize: size=w:h scales the first input tensor (nearest).
+ * - threshold: value=v sets the elements less than v to zero.
+ * Crop and resize regard the dimension of the tensor as
+ * channel:width:height:batch (e.g., converted video).
+ *
+ * The key 'in' gives the input tensors of a stage, comma-separated references
+ * to the element input ("input") or a previous stage ("name"), with an
+ * optional tensor index ("name.0"). Without 'in', a stage takes all tensors
+ * of the previous stage (the first stage takes the element input).
+ * The property 'output' gives the output tensors with the same references
+ * (all tensors of the last stage by default).
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 ... ! tensor_converter ! \
+ *    tensor_filter_cascade stages="det:filter framework=tensorflow-lite model=det.tflite ; \
+ *        roi:crop in=input.0,det.0 region=0:0:224:224 ; \
+ *        cls:filter framework=tensorflow-lite model=cls.tflite in=roi ; \
+ *        seg:filter framework=tensorflow-lite model=seg.tflite in=input.0" \
+ *        output=det.0,cls.0,seg.0 ! tensor_sink
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <math.h>
+#include <string.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_util.h>
+#include "tensor_data.h"
+#include "tensor_filter_cascade.h"
+
+/**
+ * @brief Macro for debug mode.
+ */
+#ifndef DBG
+#define DBG (!self->silent)
+#endif
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_filter_cascade_debug);
+#define GST_CAT_DEFAULT gst_tensor_filter_cascade_debug
+
+/**
+ * @brief tensor_filter_cascade properties
+ */
+enum
+{
+  PROP_0,
+  PROP_SILENT,
+  PROP_STAGES,
+  PROP_OUTPUT,
+  PROP_PARALLEL
+};
+
+/**
+ * @brief Flag to print minimized log.
+ */
+#define DEFAULT_SILENT TRUE
+
+/**
+ * @brief Default for the property parallel.
+ */
+#define DEFAULT_PARALLEL TRUE
+
+/**
+ * @brief Name to refer the element input in the stages.
+ */
+#define CASCADE_INPUT_NAME "input"
+
+/**
+ * @brief Operation names of the stages.
+ */
+static const gchar *cascade_op_string[] = {
+  [CASCADE_OP_FILTER] = "filter",
+  [CASCADE_OP_CROP] = "crop",
+  [CASCADE_OP_RESIZE] = "resize",
+  [CASCADE_OP_THRESHOLD] = "threshold",
+  [CASCADE_OP_UNKNOWN] = NULL
+};
+
+/**
+ * @brief Template for sink pad.
+ */
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_DEFAULT));
+
+/**
+ * @brief Template for src pad.
+ */
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_DEFAULT));
+
+#define gst_tensor_filter_cascade_parent_class parent_class
+G_DEFINE_TYPE (GstTensorFilterCascade, gst_tensor_filter_cascade,
+    GST_TYPE_ELEMENT);
+
+static void gst_tensor_filter_cascade_finalize (GObject * object);
+static void gst_tensor_filter_cascade_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec);
+static void gst_tensor_filter_cascade_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec);
+static GstStateChangeReturn gst_tensor_filter_cascade_change_state (GstElement *
+    element, GstStateChange transition);
+static GstFlowReturn gst_tensor_filter_cascade_chain (GstPad * pad,
+    GstObject * parent, GstBuffer * buf);
+static gboolean gst_tensor_filter_cascade_sink_event (GstPad * pad,
+    GstObject * parent, GstEvent * event);
+static gboolean gst_tensor_filter_cascade_sink_query (GstPad * pad,
+    GstObject * parent, GstQuery * query);
+static void gst_tensor_filter_cascade_cleanup (GstTensorFilterCascade * self);
+static void gst_tensor_filter_cascade_worker (gpointer data,
+    gpointer user_data);
+
+/**
+ * @brief Initialize the tensor_filter_cascade's class.
+ */
+static void
+gst_tensor_filter_cascade_class_init (GstTensorFilterCascadeClass * klass)
+{
+  GObjectClass *object_class;
+  GstElementClass *element_class;
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_filter_cascade_debug,
+      "tensor_filter_cascade", 0,
+      "Element to run a graph of models and glue operations");
+
+  object_class = (GObjectClass *) klass;
+  element_class = (GstElementClass *) klass;
+
+  object_class->set_property = gst_tensor_filter_cascade_set_property;
+  object_class->get_property = gst_tensor_filter_cascade_get_property;
+  object_class->finalize = gst_tensor_filter_cascade_finalize;
+
+  /**
+   * GstTensorFilterCascade::silent:
+   *
+   * The flag to enable/disable debugging messages.
+   */
+  g_object_class_install_property (object_class, PROP_SILENT,
+      g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
+          DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorFilterCascade::stages:
+   *
+   * The description of the stages, separated by ';'.
+   * Each stage is "name:operation key=value ...", operation is one of
+   * filter, crop, resize and threshold.
+   */
+  g_object_class_install_property (object_class, PROP_STAGES,
+      g_param_spec_string ("stages", "Stages",
+          "The stages of the graph, separated by ';' "
+          "(e.g., det:filter framework=tensorflow-lite model=a.tflite ; "
+          "cls:filter framework=tensorflow-lite model=b.tflite in=det.0)",
+          "", G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorFilterCascade::output:
+   *
+   * The output tensors, comma-separated references to the stages
+   * (e.g., det.0,cls). All tensors of the last stage by default.
+   */
+  g_object_class_install_property (object_class, PROP_OUTPUT,
+      g_param_spec_string ("output", "Output",
+          "The output tensors, comma-separated references to the stages "
+          "(e.g., det.0,cls). All tensors of the last stage by default.",
+          "", G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorFilterCascade::parallel:
+   *
+   * The flag to run the stages not depending on each other in parallel.
+   */
+  g_object_class_install_property (object_class, PROP_PARALLEL,
+      g_param_spec_boolean ("parallel", "Parallel",
+          "Run the independent stages in parallel with a worker pool",
+          DEFAULT_PARALLEL, G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  element_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_cascade_change_state);
+
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&src_template));
+
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&sink_template));
+
+  gst_element_class_set_static_metadata (element_class,
+      "TensorFilterCascade",
+      "Filter/Tensor",
+      "Runs a graph of neural network models and glue operations in one element",
+      "Samsung Electronics Co., Ltd.");
+}
+
+/**
+ * @brief Initialize tensor_filter_cascade element.
+ */
+static void
+gst_tensor_filter_cascade_init (GstTensorFilterCascade * self)
+{
+  /* setup sink pad */
+  self->sinkpad = gst_pad_new_from_static_template (&sink_template, "sink");
+  gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
+
+  /* setup src pad */
+  self->srcpad = gst_pad_new_from_static_template (&src_template, "src");
+  gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
+
+  gst_pad_set_chain_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_cascade_chain));
+  gst_pad_set_event_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_cascade_sink_event));
+  gst_pad_set_query_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_cascade_sink_query));
+
+  /* init properties */
+  self->silent = DEFAULT_SILENT;
+  self->parallel = DEFAULT_PARALLEL;
+  self->stages_desc = NULL;
+  self->output_desc = NULL;
+
+  self->stages = NULL;
+  self->num_levels = 0;
+  self->num_outputs = 0;
+  self->configured = FALSE;
+  self->pool = NULL;
+  self->pending = 0;
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+
+  gst_tensors_config_init (&self->in_config);
+  gst_tensors_config_init (&self->out_config);
+}
+
+/**
+ * @brief Function to finalize instance.
+ */
+static void
+gst_tensor_filter_cascade_finalize (GObject * object)
+{
+  GstTensorFilterCascade *self;
+
+  self = GST_TENSOR_FILTER_CASCADE (object);
+
+  gst_tensor_filter_cascade_cleanup (self);
+
+  g_free (self->stages_desc);
+  g_free (self->output_desc);
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Setter for tensor_filter_cascade properties.
+ */
+static void
+gst_tensor_filter_cascade_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorFilterCascade *self;
+
+  self = GST_TENSOR_FILTER_CASCADE (object);
+
+  switch (prop_id) {
+    case PROP_SILENT:
+      self->silent = g_value_get_boolean (value);
+      break;
+    case PROP_STAGES:
+      g_free (self->stages_desc);
+      self->stages_desc = g_value_dup_string (value);
+      gst_tensor_filter_cascade_cleanup (self);
+      break;
+    case PROP_OUTPUT:
+      g_free (self->output_desc);
+      self->output_desc = g_value_dup_string (value);
+      gst_tensor_filter_cascade_cleanup (self);
+      break;
+    case PROP_PARALLEL:
+      self->parallel = g_value_get_boolean (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Getter for tensor_filter_cascade properties.
+ */
+static void
+gst_tensor_filter_cascade_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorFilterCascade *self;
+
+  self = GST_TENSOR_FILTER_CASCADE (object);
+
+  switch (prop_id) {
+    case PROP_SILENT:
+      g_value_set_boolean (value, self->silent);
+      break;
+    case PROP_STAGES:
+      g_value_set_string (value, self->stages_desc ? self->stages_desc : "");
+      break;
+    case PROP_OUTPUT:
+      g_value_set_string (value, self->output_desc ? self->output_desc : "");
+      break;
+    case PROP_PARALLEL:
+      g_value_set_boolean (value, self->parallel);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Free the stage and the filter instance.
+ */
+static void
+gst_tensor_filter_cascade_free_stage (gpointer data)
+{
+  tensor_cascade_stage *stage = (tensor_cascade_stage *) data;
+
+  if (stage->filter)
+    g_object_unref (stage->filter);
+
+  gst_tensors_info_free (&stage->in_info);
+  gst_tensors_info_free (&stage->out_info);
+  g_strfreev (stage->options);
+  g_free (stage->name);
+  g_free (stage);
+}
+
+/**
+ * @brief Release the resources of the configured graph.
+ */
+static void
+gst_tensor_filter_cascade_cleanup (GstTensorFilterCascade * self)
+{
+  if (self->pool) {
+    g_thread_pool_free (self->pool, FALSE, TRUE);
+    self->pool = NULL;
+  }
+
+  if (self->stages) {
+    g_ptr_array_free (self->stages, TRUE);
+    self->stages = NULL;
+  }
+
+  self->num_levels = 0;
+  self->num_outputs = 0;
+  self->configured = FALSE;
+
+  gst_tensors_config_free (&self->in_config);
+  gst_tensors_config_free (&self->out_config);
+  gst_tensors_config_init (&self->in_config);
+  gst_tensors_config_init (&self->out_config);
+}
+
+/**
+ * @brief Parse unsigned integers separated by ':' (e.g., 0:0:224:224).
+ */
+static gboolean
+gst_tensor_filter_cascade_parse_uints (const gchar * str, guint * values,
+    guint num)
+{
+  gchar **parts;
+  guint i;
+  gboolean ret = TRUE;
+
+  parts = g_strsplit (str, ":", -1);
+  if (g_strv_length (parts) != num) {
+    ret = FALSE;
+    goto done;
+  }
+
+  for (i = 0; i < num; i++) {
+    gchar *endptr = NULL;
+    guint64 val = g_ascii_strtoull (parts[i], &endptr, 10);
+
+    if (endptr == parts[i] || *endptr != '\0' || val > G_MAXUINT) {
+      ret = FALSE;
+      goto done;
+    }
+    values[i] = (guint) val;
+  }
+
+done:
+  g_strfreev (parts);
+  return ret;
+}
+
+/**
+ * @brief Parse a reference to the tensors of the input or a previous stage.
+ */
+static gboolean
+gst_tensor_filter_cascade_parse_ref (GstTensorFilterCascade * self,
+    const gchar * str, tensor_cascade_ref * ref)
+{
+  gchar **parts;
+  gboolean ret = FALSE;
+  guint i;
+
+  parts = g_strsplit (str, ".", 2);
+  if (!parts[0] || parts[0][0] == '\0')
+    goto done;
+
+  if (g_str_equal (parts[0], CASCADE_INPUT_NAME)) {
+    ref->stage = CASCADE_REF_INPUT;
+  } else {
+    /* only the previous stages can be referred, the graph has no cycle. */
+    for (i = 0; i < self->stages->len; i++) {
+      tensor_cascade_stage *s = g_ptr_array_index (self->stages, i);
+
+      if (g_str_equal (parts[0], s->name))
+        break;
+    }
+
+    if (i == self->stages->len) {
+      ml_loge ("tensor_filter_cascade: unknown stage '%s' (refer to a previous stage or '%s').",
+          parts[0], CASCADE_INPUT_NAME);
+      goto done;
+    }
+    ref->stage = (gint) i;
+  }
+
+  if (parts[1]) {
+    gchar *endptr = NULL;
+    guint64 val = g_ascii_strtoull (parts[1], &endptr, 10);
+
+    if (endptr == parts[1] || *endptr != '\0' || val >= NNS_TENSOR_SIZE_LIMIT) {
+      ml_loge ("tensor_filter_cascade: invalid tensor index in '%s'.", str);
+      goto done;
+    }
+    ref->index = (guint) val;
+  } else {
+    ref->index = CASCADE_REF_ALL;
+  }
+
+  ret = TRUE;
+
+done:
+  g_strfreev (parts);
+  return ret;
+}
+
+/**
+ * @brief Parse comma-separated references.
+ */
+static gboolean
+gst_tensor_filter_cascade_parse_refs (GstTensorFilterCascade * self,
+    const gchar * str, tensor_cascade_ref * refs, guint * num_refs)
+{
+  gchar **parts;
+  guint i, num;
+  gboolean ret = TRUE;
+
+  parts = g_strsplit (str, ",", -1);
+  num = g_strv_length (parts);
+
+  if (num == 0 || num > NNS_TENSOR_SIZE_LIMIT) {
+    ml_loge ("tensor_filter_cascade: invalid references '%s'.", str);
+    ret = FALSE;
+  }
+
+  for (i = 0; ret && i < num; i++)
+    ret = gst_tensor_filter_cascade_parse_ref (self, g_strstrip (parts[i]),
+        &refs[i]);
+
+  if (ret)
+    *num_refs = num;
+
+  g_strfreev (parts);
+  return ret;
+}
+
+/**
+ * @brief Parse a stage description "name:operation key=value ...".
+ */
+static tensor_cascade_stage *
+gst_tensor_filter_cascade_parse_stage (GstTensorFilterCascade * self,
+    const gchar * desc)
+{
+  tensor_cascade_stage *stage;
+  GPtrArray *options;
+  gchar **tokens, **head = NULL;
+  gboolean has_region = FALSE, has_size = FALSE, has_value = FALSE;
+  guint i, t;
+  gint op;
+
+  stage = g_new0 (tensor_cascade_stage, 1);
+  stage->op = CASCADE_OP_UNKNOWN;
+  gst_tensors_info_init (&stage->in_info);
+  gst_tensors_info_init (&stage->out_info);
+
+  options = g_ptr_array_new ();
+  tokens = g_strsplit_set (desc, " \t\r\n", -1);
+
+  for (t = 0; tokens[t]; t++) {
+    gchar *token = tokens[t];
+    gchar *value;
+
+    if (token[0] == '\0')
+      continue;
+
+    if (!head) {
+      /* the first token is name:operation */
+      head = g_strsplit (token, ":", 2);
+      if (!head[0] || !head[1] || head[0][0] == '\0' ||
+          g_str_equal (head[0], CASCADE_INPUT_NAME)) {
+        ml_loge ("tensor_filter_cascade: invalid stage name in '%s'.", desc);
+        goto error;
+      }
+
+      for (i = 0; i < self->stages->len; i++) {
+        tensor_cascade_stage *s = g_ptr_array_index (self->stages, i);
+
+        if (g_str_equal (head[0], s->name)) {
+          ml_loge ("tensor_filter_cascade: duplicated stage name '%s'.",
+              head[0]);
+          goto error;
+        }
+      }
+
+      stage->name = g_strdup (head[0]);
+      op = find_key_strv (cascade_op_string, head[1]);
+      if (op < 0 || op >= CASCADE_OP_UNKNOWN) {
+        ml_loge ("tensor_filter_cascade: unknown operation '%s' of stage '%s'.",
+            head[1], head[0]);
+        goto error;
+      }
+      stage->op = (tensor_cascade_op) op;
+      continue;
+    }
+
+    value = strchr (token, '=');
+    if (!value || value == token) {
+      ml_loge ("tensor_filter_cascade: invalid option '%s' of stage '%s'.",
+          token, stage->name);
+      goto error;
+    }
+    *value++ = '\0';
+
+    if (g_str_equal (token, "in")) {
+      if (!gst_tensor_filter_cascade_parse_refs (self, value, stage->refs,
+              &stage->num_refs))
+        goto error;
+      continue;
+    }
+
+    switch (stage->op) {
+      case CASCADE_OP_FILTER:
+        /* pass to the filter */
+        g_ptr_array_add (options, g_strdup_printf ("%s=%s", token, value));
+        continue;
+      case CASCADE_OP_CROP:
+        if (g_str_equal (token, "region")) {
+          has_region =
+              gst_tensor_filter_cascade_parse_uints (value, stage->region, 4);
+          if (!has_region)
+            break;
+          continue;
+        }
+        break;
+      case CASCADE_OP_RESIZE:
+        if (g_str_equal (token, "size")) {
+          has_size =
+              gst_tensor_filter_cascade_parse_uints (value, stage->size, 2);
+          if (!has_size)
+            break;
+          continue;
+        }
+        break;
+      case CASCADE_OP_THRESHOLD:
+        if (g_str_equal (token, "value")) {
+          gchar *endptr = NULL;
+
+          stage->threshold = g_ascii_strtod (value, &endptr);
+          has_value = (endptr != value && *endptr == '\0');
+          if (!has_value)
+            break;
+          continue;
+        }
+        break;
+      default:
+        break;
+    }
+
+    ml_loge ("tensor_filter_cascade: invalid option '%s=%s' of stage '%s'.",
+        token, value, stage->name);
+    goto error;
+  }
+
+  if (!head) {
+    ml_loge ("tensor_filter_cascade: empty stage.");
+    goto error;
+  }
+
+  /* check mandatory options */
+  switch (stage->op) {
+    case CASCADE_OP_CROP:
+      if (!has_region || stage->region[2] == 0 || stage->region[3] == 0) {
+        ml_loge ("tensor_filter_cascade: crop stage '%s' requires region=x:y:w:h.",
+            stage->name);
+        goto error;
+      }
+      stage->size[0] = stage->region[2];
+      stage->size[1] = stage->region[3];
+      break;
+    case CASCADE_OP_RESIZE:
+      if (!has_size || stage->size[0] == 0 || stage->size[1] == 0) {
+        ml_loge ("tensor_filter_cascade: resize stage '%s' requires size=w:h.",
+            stage->name);
+        goto error;
+      }
+      break;
+    case CASCADE_OP_THRESHOLD:
+      if (!has_value) {
+        ml_loge ("tensor_filter_cascade: threshold stage '%s' requires value.",
+            stage->name);
+        goto error;
+      }
+      break;
+    default:
+      break;
+  }
+
+  /* default input is the previous stage */
+  if (stage->num_refs == 0) {
+    stage->num_refs = 1;
+    stage->refs[0].stage = (self->stages->len > 0) ?
+        (gint) self->stages->len - 1 : CASCADE_REF_INPUT;
+    stage->refs[0].index = CASCADE_REF_ALL;
+  }
+
+  g_ptr_array_add (options, NULL);
+  stage->options = (gchar **) g_ptr_array_free (options, FALSE);
+
+  g_strfreev (head);
+  g_strfreev (tokens);
+  return stage;
+
+error:
+  g_ptr_array_set_free_func (options, g_free);
+  g_ptr_array_free (options, TRUE);
+  g_strfreev (head);
+  g_strfreev (tokens);
+  gst_tensor_filter_cascade_free_stage (stage);
+  return NULL;
+}
+
+/**
+ * @brief Get the tensors info of the element input or a stage.
+ */
+static const GstTensorsInfo *
+gst_tensor_filter_cascade_get_ref_info (GstTensorFilterCascade * self,
+    gint stage)
+{
+  tensor_cascade_stage *s;
+
+  if (stage == CASCADE_REF_INPUT)
+    return &self->in_config.info;
+
+  s = g_ptr_array_index (self->stages, stage);
+  return &s->out_info;
+}
+
+/**
+ * @brief Resolve the references into the list of tensors.
+ */
+static gboolean
+gst_tensor_filter_cascade_resolve_refs (GstTensorFilterCascade * self,
+    const tensor_cascade_ref * refs, guint num_refs,
+    tensor_cascade_ref * tensors, guint * num_tensors, GstTensorsInfo * info)
+{
+  const GstTensorsInfo *ref_info;
+  guint i, j, n = 0;
+
+  for (i = 0; i < num_refs; i++) {
+    guint first, last;
+
+    ref_info = gst_tensor_filter_cascade_get_ref_info (self, refs[i].stage);
+
+    if (refs[i].index == CASCADE_REF_ALL) {
+      first = 0;
+      last = ref_info->num_tensors;
+    } else if (refs[i].index < ref_info->num_tensors) {
+      first = refs[i].index;
+      last = first + 1;
+    } else {
+      ml_loge ("tensor_filter_cascade: tensor index %u is out of range (%u tensors).",
+          refs[i].index, ref_info->num_tensors);
+      return FALSE;
+    }
+
+    for (j = first; j < last; j++) {
+      if (n >= NNS_TENSOR_SIZE_LIMIT) {
+        ml_loge ("tensor_filter_cascade: too many tensors (max %d).",
+            NNS_TENSOR_SIZE_LIMIT);
+        return FALSE;
+      }
+
+      tensors[n].stage = refs[i].stage;
+      tensors[n].index = j;
+      gst_tensor_info_copy (&info->info[n], &ref_info->info[j]);
+      n++;
+    }
+  }
+
+  *num_tensors = info->num_tensors = n;
+  return TRUE;
+}
+
+/**
+ * @brief Get the tensors info of the filter from the properties.
+ */
+static gboolean
+gst_tensor_filter_cascade_get_filter_info (GTensorFilterSingle * filter,
+    gboolean is_input, GstTensorsInfo * info)
+{
+  gchar *dimensions = NULL, *types = NULL;
+  guint num_dims, num_types;
+
+  g_object_get (filter, is_input ? "input" : "output", &dimensions,
+      is_input ? "inputtype" : "outputtype", &types, NULL);
+
+  gst_tensors_info_init (info);
+  num_dims = gst_tensors_info_parse_dimensions_string (info, dimensions);
+  num_types = gst_tensors_info_parse_types_string (info, types);
+  info->num_tensors = num_dims;
+
+  g_free (dimensions);
+  g_free (types);
+
+  return (num_dims > 0 && num_dims == num_types &&
+      gst_tensors_info_validate (info));
+}
+
+/**
+ * @brief Open the model of the filter stage and get the output info.
+ */
+static gboolean
+gst_tensor_filter_cascade_configure_filter (tensor_cascade_stage * stage)
+{
+  GTensorFilterSingleClass *klass;
+  GObjectClass *oclass;
+  guint i;
+
+  stage->filter = g_object_new (G_TYPE_TENSOR_FILTER_SINGLE, NULL);
+  oclass = G_OBJECT_GET_CLASS (stage->filter);
+  klass = G_TENSOR_FILTER_SINGLE_CLASS (oclass);
+
+  for (i = 0; stage->options[i]; i++) {
+    gchar **kv = g_strsplit (stage->options[i], "=", 2);
+
+    if (!g_object_class_find_property (oclass, kv[0])) {
+      ml_loge ("tensor_filter_cascade: unknown filter property '%s' of stage '%s'.",
+          kv[0], stage->name);
+      g_strfreev (kv);
+      return FALSE;
+    }
+
+    gst_util_set_object_arg (G_OBJECT (stage->filter), kv[0], kv[1]);
+    g_strfreev (kv);
+  }
+
+  if (!klass->start (stage->filter)) {
+    ml_loge ("tensor_filter_cascade: failed to open the model of stage '%s'.",
+        stage->name);
+    return FALSE;
+  }
+
+  if (klass->input_configured (stage->filter)) {
+    GstTensorsInfo model_info;
+    gboolean ret;
+
+    ret = gst_tensor_filter_cascade_get_filter_info (stage->filter, TRUE,
+        &model_info);
+    if (ret)
+      ret = gst_tensors_info_is_equal (&model_info, &stage->in_info);
+    gst_tensors_info_free (&model_info);
+
+    if (!ret) {
+      ml_loge ("tensor_filter_cascade: the input of stage '%s' does not match the model.",
+          stage->name);
+      return FALSE;
+    }
+
+    if (!klass->output_configured (stage->filter) ||
+        !gst_tensor_filter_cascade_get_filter_info (stage->filter, FALSE,
+            &stage->out_info)) {
+      ml_loge ("tensor_filter_cascade: failed to get the output of stage '%s'.",
+          stage->name);
+      return FALSE;
+    }
+  } else if (klass->set_input_info (stage->filter, &stage->in_info,
+          &stage->out_info) != 0) {
+    ml_loge ("tensor_filter_cascade: failed to set the input of stage '%s'.",
+        stage->name);
+    return FALSE;
+  }
+
+  stage->allocate_in_invoke = klass->allocate_in_invoke (stage->filter);
+  return TRUE;
+}
+
+/**
+ * @brief Configure a stage with the input info.
+ */
+static gboolean
+gst_tensor_filter_cascade_configure_stage (GstTensorFilterCascade * self,
+    tensor_cascade_stage * stage)
+{
+  GstTensorInfo *in, *out;
+  guint i;
+
+  if (!gst_tensor_filter_cascade_resolve_refs (self, stage->refs,
+          stage->num_refs, stage->inputs, &stage->num_inputs,
+          &stage->in_info))
+    return FALSE;
+
+  if (stage->num_inputs == 0) {
+    ml_loge ("tensor_filter_cascade: stage '%s' has no input tensor.",
+        stage->name);
+    return FALSE;
+  }
+
+  /* level of the stage, stages of the same level do not depend on each other */
+  stage->level = 1;
+  for (i = 0; i < stage->num_inputs; i++) {
+    tensor_cascade_stage *s;
+
+    if (stage->inputs[i].stage == CASCADE_REF_INPUT)
+      continue;
+
+    s = g_ptr_array_index (self->stages, stage->inputs[i].stage);
+    stage->level = MAX (stage->level, s->level + 1);
+  }
+  self->num_levels = MAX (self->num_levels, stage->level);
+
+  if (stage->op == CASCADE_OP_FILTER)
+    return gst_tensor_filter_cascade_configure_filter (stage);
+
+  in = &stage->in_info.info[0];
+
+  if (stage->op == CASCADE_OP_THRESHOLD) {
+    gst_tensors_info_copy (&stage->out_info, &stage->in_info);
+    return TRUE;
+  }
+
+  /* crop and resize: channel:width:height:batch */
+  if (stage->num_inputs < 1 || stage->num_inputs > 2 ||
+      (stage->op == CASCADE_OP_RESIZE && stage->num_inputs != 1)) {
+    ml_loge ("tensor_filter_cascade: invalid number of inputs (%u) of stage '%s'.",
+        stage->num_inputs, stage->name);
+    return FALSE;
+  }
+
+  if (stage->op == CASCADE_OP_CROP) {
+    if (stage->num_inputs == 2) {
+      if (gst_tensor_get_element_count (stage->in_info.info[1].dimension) < 4) {
+        ml_loge ("tensor_filter_cascade: the region tensor of stage '%s' should have 4 elements (x, y, w, h).",
+            stage->name);
+        return FALSE;
+      }
+    } else if (stage->region[0] + stage->region[2] > in->dimension[1] ||
+        stage->region[1] + stage->region[3] > in->dimension[2]) {
+      ml_loge ("tensor_filter_cascade: the region of stage '%s' is out of the tensor (%u:%u).",
+          stage->name, in->dimension[1], in->dimension[2]);
+      return FALSE;
+    }
+  }
+
+  stage->out_info.num_tensors = 1;
+  out = &stage->out_info.info[0];
+  gst_tensor_info_copy (out, in);
+  out->dimension[1] = stage->size[0];
+  out->dimension[2] = stage->size[1];
+  return TRUE;
+}
+
+/**
+ * @brief Parse the stages and configure the graph with the input config.
+ */
+static gboolean
+gst_tensor_filter_cascade_configure (GstTensorFilterCascade * self,
+    const GstTensorsConfig * config)
+{
+  GstTensorsInfo *out_info;
+  gchar **descs;
+  guint i, width, max_width;
+
+  gst_tensor_filter_cascade_cleanup (self);
+  gst_tensors_config_copy (&self->in_config, config);
+  self->stages = g_ptr_array_new_with_free_func
+      (gst_tensor_filter_cascade_free_stage);
+
+  if (!self->stages_desc) {
+    ml_loge ("tensor_filter_cascade: the property stages is not given.");
+    goto error;
+  }
+
+  descs = g_strsplit (self->stages_desc, ";", -1);
+  for (i = 0; descs[i]; i++) {
+    tensor_cascade_stage *stage;
+
+    if (g_strstrip (descs[i])[0] == '\0')
+      continue;
+
+    stage = gst_tensor_filter_cascade_parse_stage (self, descs[i]);
+    if (!stage || !gst_tensor_filter_cascade_configure_stage (self, stage)) {
+      if (stage)
+        gst_tensor_filter_cascade_free_stage (stage);
+      g_strfreev (descs);
+      goto error;
+    }
+
+    g_ptr_array_add (self->stages, stage);
+  }
+  g_strfreev (descs);
+
+  if (self->stages->len == 0) {
+    ml_loge ("tensor_filter_cascade: no stage is given.");
+    goto error;
+  }
+
+  /* output tensors */
+  gst_tensors_config_init (&self->out_config);
+  out_info = &self->out_config.info;
+
+  if (self->output_desc && self->output_desc[0] != '\0') {
+    tensor_cascade_ref refs[NNS_TENSOR_SIZE_LIMIT];
+    guint num_refs;
+
+    if (!gst_tensor_filter_cascade_parse_refs (self, self->output_desc, refs,
+            &num_refs) ||
+        !gst_tensor_filter_cascade_resolve_refs (self, refs, num_refs,
+            self->outputs, &self->num_outputs, out_info))
+      goto error;
+  } else {
+    tensor_cascade_ref last;
+
+    last.stage = (gint) self->stages->len - 1;
+    last.index = CASCADE_REF_ALL;
+
+    if (!gst_tensor_filter_cascade_resolve_refs (self, &last, 1,
+            self->outputs, &self->num_outputs, out_info))
+      goto error;
+  }
+
+  self->out_config.rate_n = config->rate_n;
+  self->out_config.rate_d = config->rate_d;
+
+  /* workers for the widest level, the streaming thread runs one stage. */
+  max_width = 0;
+  for (i = 1; i <= self->num_levels; i++) {
+    guint j;
+
+    width = 0;
+    for (j = 0; j < self->stages->len; j++) {
+      tensor_cascade_stage *s = g_ptr_array_index (self->stages, j);
+
+      if (s->level == i)
+        width++;
+    }
+    max_width = MAX (max_width, width);
+  }
+
+  if (self->parallel && max_width > 1) {
+    GError *err = NULL;
+
+    self->pool = g_thread_pool_new (gst_tensor_filter_cascade_worker, self,
+        (gint) max_width - 1, FALSE, &err);
+    if (!self->pool) {
+      nns_logw ("tensor_filter_cascade: failed to create the worker pool (%s), stages will run sequentially.",
+          err ? err->message : "unknown");
+      g_clear_error (&err);
+    }
+  }
+
+  silent_debug (self, "Configured %u stages in %u levels (parallel %u).",
+      self->stages->len, self->num_levels, self->pool ? max_width : 1);
+
+  self->configured = TRUE;
+  return TRUE;
+
+error:
+  gst_tensor_filter_cascade_cleanup (self);
+  return FALSE;
+}
+
+/**
+ * @brief Scale (nearest) the region of the tensor (channel:width:height:batch).
+ */
+static void
+gst_tensor_filter_cascade_scale (const GstTensorInfo * in_info,
+    const guint8 * src, const guint region[4], const GstTensorInfo * out_info,
+    guint8 * dst)
+{
+  gsize bpp, in_stride, out_stride;
+  guint in_w, in_h, out_w, out_h, planes;
+  guint p, ox, oy, i;
+
+  bpp = gst_tensor_get_element_size (in_info->type) * in_info->dimension[0];
+  in_w = in_info->dimension[1];
+  in_h = in_info->dimension[2];
+  out_w = out_info->dimension[1];
+  out_h = out_info->dimension[2];
+  in_stride = bpp * in_w;
+  out_stride = bpp * out_w;
+
+  planes = 1;
+  for (i = 3; i < NNS_TENSOR_RANK_LIMIT; i++) {
+    if (in_info->dimension[i] > 0)
+      planes *= in_info->dimension[i];
+  }
+
+  for (p = 0; p < planes; p++) {
+    const guint8 *plane = src + (gsize) p * in_stride * in_h;
+
+    for (oy = 0; oy < out_h; oy++) {
+      guint sy = region[1] + (guint) ((guint64) oy * region[3] / out_h);
+      const guint8 *srow = plane + (gsize) sy * in_stride + region[0] * bpp;
+
+      if (region[2] == out_w) {
+        memcpy (dst, srow, out_stride);
+      } else {
+        for (ox = 0; ox < out_w; ox++) {
+          guint sx = (guint) ((guint64) ox * region[2] / out_w);
+          memcpy (dst + ox * bpp, srow + sx * bpp, bpp);
+        }
+      }
+
+      dst += out_stride;
+    }
+  }
+}
+
+/**
+ * @brief Get the region (x, y, w, h) from the first 4 values of the tensor.
+ * @return FALSE if the tensor holds a value that is not finite.
+ */
+static gboolean
+gst_tensor_filter_cascade_get_region (const GstTensorMemory * mem,
+    tensor_type type, const GstTensorInfo * in_info, guint region[4])
+{
+  gsize esize = gst_tensor_get_element_size (type);
+  guint8 *data = (guint8 *) mem->data;
+  gdouble val[4];
+  guint i;
+  guint in_w = in_info->dimension[1];
+  guint in_h = in_info->dimension[2];
+
+  for (i = 0; i < 4; i++) {
+    gst_tensor_data_raw_typecast (data + i * esize, type, &val[i],
+        _NNS_FLOAT64);
+    if (!isfinite (val[i]))
+      return FALSE;
+  }
+
+  /* clamp the region into the tensor before the cast, the model output is untrusted */
+  region[0] = (guint) CLAMP (val[0], 0.0, (gdouble) (in_w - 1));
+  region[1] = (guint) CLAMP (val[1], 0.0, (gdouble) (in_h - 1));
+  region[2] = (guint) CLAMP (val[2], 1.0, (gdouble) (in_w - region[0]));
+  region[3] = (guint) CLAMP (val[3], 1.0, (gdouble) (in_h - region[1]));
+  return TRUE;
+}
+
+/**
+ * @brief Set the elements less than the threshold to zero.
+ */
+static void
+gst_tensor_filter_cascade_threshold (const GstTensorInfo * info,
+    const GstTensorMemory * in, GstTensorMemory * out, gdouble threshold)
+{
+  gsize esize = gst_tensor_get_element_size (info->type);
+  gsize i, num = in->size / esize;
+  guint8 *data = (guint8 *) out->data;
+  gdouble val;
+
+  memcpy (out->data, in->data, in->size);
+
+  for (i = 0; i < num; i++) {
+    gst_tensor_data_raw_typecast (data + i * esize, info->type, &val,
+        _NNS_FLOAT64);
+    if (val < threshold)
+      memset (data + i * esize, 0, esize);
+  }
+}
+
+/**
+ * @brief Run a stage with the tensors of the current frame.
+ */
+static void
+gst_tensor_filter_cascade_run_stage (GstTensorFilterCascade * self,
+    tensor_cascade_stage * stage)
+{
+  GTensorFilterSingleClass *klass;
+  guint i, region[4];
+
+  /* hand over the input tensors by pointer */
+  for (i = 0; i < stage->num_inputs; i++) {
+    const tensor_cascade_ref *ref = &stage->inputs[i];
+
+    if (ref->stage == CASCADE_REF_INPUT) {
+      stage->in[i] = self->src[ref->index];
+    } else {
+      tensor_cascade_stage *s = g_ptr_array_index (self->stages, ref->stage);
+
+      stage->in[i] = s->out[ref->index];
+    }
+  }
+
+  for (i = 0; i < stage->out_info.num_tensors; i++) {
+    stage->out[i].size = gst_tensor_info_get_size (&stage->out_info.info[i]);
+    stage->out[i].data = NULL;
+  }
+
+  if (stage->op == CASCADE_OP_FILTER) {
+    klass = G_TENSOR_FILTER_SINGLE_CLASS (G_OBJECT_GET_CLASS (stage->filter));
+    stage->failed = !klass->invoke (stage->filter, stage->in, stage->out, TRUE);
+    return;
+  }
+
+  for (i = 0; i < stage->out_info.num_tensors; i++) {
+    stage->out[i].data = g_try_malloc (stage->out[i].size);
+    if (!stage->out[i].data) {
+      ml_loge ("tensor_filter_cascade: failed to allocate the output of stage '%s'.",
+          stage->name);
+      stage->failed = TRUE;
+      return;
+    }
+  }
+
+  switch (stage->op) {
+    case CASCADE_OP_CROP:
+      if (stage->num_inputs == 2) {
+        if (!gst_tensor_filter_cascade_get_region (&stage->in[1],
+                stage->in_info.info[1].type, &stage->in_info.info[0],
+                region)) {
+          ml_loge ("tensor_filter_cascade: stage '%s' got a region that is not finite.",
+              stage->name);
+          stage->failed = TRUE;
+          return;
+        }
+      } else {
+        memcpy (region, stage->region, sizeof (region));
+      }
+
+      gst_tensor_filter_cascade_scale (&stage->in_info.info[0],
+          stage->in[0].data, region, &stage->out_info.info[0],
+          stage->out[0].data);
+      break;
+    case CASCADE_OP_RESIZE:
+      region[0] = region[1] = 0;
+      region[2] = stage->in_info.info[0].dimension[1];
+      region[3] = stage->in_info.info[0].dimension[2];
+
+      gst_tensor_filter_cascade_scale (&stage->in_info.info[0],
+          stage->in[0].data, region, &stage->out_info.info[0],
+          stage->out[0].data);
+      break;
+    case CASCADE_OP_THRESHOLD:
+      for (i = 0; i < stage->num_inputs; i++) {
+        gst_tensor_filter_cascade_threshold (&stage->in_info.info[i],
+            &stage->in[i], &stage->out[i], stage->threshold);
+      }
+      break;
+    default:
+      stage->failed = TRUE;
+      break;
+  }
+}
+
+/**
+ * @brief Worker function to run a stage in the thread pool.
+ */
+static void
+gst_tensor_filter_cascade_worker (gpointer data, gpointer user_data)
+{
+  GstTensorFilterCascade *self = GST_TENSOR_FILTER_CASCADE (user_data);
+  tensor_cascade_stage *stage = (tensor_cascade_stage *) data;
+
+  gst_tensor_filter_cascade_run_stage (self, stage);
+
+  g_mutex_lock (&self->lock);
+  self->pending--;
+  g_cond_signal (&self->cond);
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Run all stages level by level. The stages of the same level run in parallel.
+ */
+static gboolean
+gst_tensor_filter_cascade_run (GstTensorFilterCascade * self)
+{
+  tensor_cascade_stage *stage, *last;
+  guint level, i;
+
+  for (i = 0; i < self->stages->len; i++) {
+    stage = g_ptr_array_index (self->stages, i);
+    stage->failed = FALSE;
+  }
+
+  for (level = 1; level <= self->num_levels; level++) {
+    last = NULL;
+
+    for (i = 0; i < self->stages->len; i++) {
+      stage = g_ptr_array_index (self->stages, i);
+      if (stage->level != level)
+        continue;
+
+      if (!self->pool) {
+        gst_tensor_filter_cascade_run_stage (self, stage);
+        continue;
+      }
+
+      /* the streaming thread runs the last stage of the level */
+      if (last) {
+        g_mutex_lock (&self->lock);
+        self->pending++;
+        g_mutex_unlock (&self->lock);
+
+        g_thread_pool_push (self->pool, last, NULL);
+      }
+      last = stage;
+    }
+
+    if (last)
+      gst_tensor_filter_cascade_run_stage (self, last);
+
+    g_mutex_lock (&self->lock);
+    while (self->pending > 0)
+      g_cond_wait (&self->cond, &self->lock);
+    g_mutex_unlock (&self->lock);
+
+    for (i = 0; i < self->stages->len; i++) {
+      stage = g_ptr_array_index (self->stages, i);
+
+      if (stage->level == level && stage->failed) {
+        ml_loge ("tensor_filter_cascade: failed to run stage '%s'.",
+            stage->name);
+        return FALSE;
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Release the intermediate tensors of the current frame.
+ */
+static void
+gst_tensor_filter_cascade_release (GstTensorFilterCascade * self)
+{
+  tensor_cascade_stage *stage;
+  guint i, j;
+
+  for (i = 0; i < self->stages->len; i++) {
+    stage = g_ptr_array_index (self->stages, i);
+
+    if (stage->op == CASCADE_OP_FILTER && stage->allocate_in_invoke) {
+      GTensorFilterSingleClass *klass;
+
+      if (stage->failed || !stage->out[0].data)
+        continue;
+
+      klass = G_TENSOR_FILTER_SINGLE_CLASS (G_OBJECT_GET_CLASS (stage->filter));
+      klass->destroy_notify (stage->filter, stage->out);
+    } else {
+      for (j = 0; j < stage->out_info.num_tensors; j++) {
+        g_free (stage->out[j].data);
+        stage->out[j].data = NULL;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Make the output buffer. The output tensors are transferred without copy if possible.
+ */
+static GstBuffer *
+gst_tensor_filter_cascade_make_output (GstTensorFilterCascade * self,
+    GstBuffer * inbuf)
+{
+  GstBuffer *outbuf;
+  GstMemory *mem;
+  guint i, j;
+
+  outbuf = gst_buffer_new ();
+
+  for (i = 0; i < self->num_outputs; i++) {
+    const tensor_cascade_ref *ref = &self->outputs[i];
+    tensor_cascade_stage *stage;
+    GstTensorMemory *tensor;
+
+    mem = NULL;
+
+    /* same tensor in the output, share the memory */
+    for (j = 0; j < i; j++) {
+      if (self->outputs[j].stage == ref->stage &&
+          self->outputs[j].index == ref->index) {
+        mem = gst_memory_ref (gst_buffer_peek_memory (outbuf, j));
+        break;
+      }
+    }
+
+    if (mem) {
+      /* shared with the previous output */
+    } else if (ref->stage == CASCADE_REF_INPUT) {
+      mem = gst_memory_ref (gst_buffer_peek_memory (inbuf, ref->index));
+    } else {
+      stage = g_ptr_array_index (self->stages, ref->stage);
+      tensor = &stage->out[ref->index];
+
+      if (stage->op != CASCADE_OP_FILTER || !stage->allocate_in_invoke) {
+        mem = gst_memory_new_wrapped (0, tensor->data, tensor->size, 0,
+            tensor->size, tensor->data, g_free);
+        tensor->data = NULL;
+      } else {
+        /* the framework owns the data, copy it. */
+        GstMapInfo map;
+
+        mem = gst_allocator_alloc (NULL, tensor->size, NULL);
+        if (gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+          memcpy (map.data, tensor->data, tensor->size);
+          gst_memory_unmap (mem, &map);
+        } else {
+          ml_loge ("tensor_filter_cascade: failed to map the output memory.");
+          gst_memory_unref (mem);
+          gst_buffer_unref (outbuf);
+          return NULL;
+        }
+      }
+    }
+
+    gst_buffer_append_memory (outbuf, mem);
+  }
+
+  gst_buffer_copy_into (outbuf, inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+  return outbuf;
+}
+
+/**
+ * @brief Chain function, runs the graph with the incoming tensors.
+ */
+static GstFlowReturn
+gst_tensor_filter_cascade_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buf)
+{
+  GstTensorFilterCascade *self = GST_TENSOR_FILTER_CASCADE (parent);
+  GstMapInfo in_map[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *outbuf = NULL;
+  GstFlowReturn ret = GST_FLOW_ERROR;
+  guint i, num_tensors, mapped = 0;
+
+  UNUSED (pad);
+
+  if (!self->configured) {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("tensor_filter_cascade is not configured."));
+    gst_buffer_unref (buf);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  buf = gst_tensor_buffer_from_config (buf, &self->in_config);
+  num_tensors = self->in_config.info.num_tensors;
+
+  if (gst_buffer_n_memory (buf) != num_tensors) {
+    ml_loge ("tensor_filter_cascade: the number of memory blocks (%u) is not matched with the number of tensors (%u).",
+        gst_buffer_n_memory (buf), num_tensors);
+    goto done;
+  }
+
+  for (i = 0; i < num_tensors; i++) {
+    in_mem[i] = gst_buffer_peek_memory (buf, i);
+    if (!gst_memory_map (in_mem[i], &in_map[i], GST_MAP_READ)) {
+      ml_loge ("tensor_filter_cascade: cannot map input memory (%u).", i);
+      goto done;
+    }
+
+    self->src[i].data = in_map[i].data;
+    self->src[i].size = in_map[i].size;
+    mapped++;
+  }
+
+  if (gst_tensor_filter_cascade_run (self))
+    outbuf = gst_tensor_filter_cascade_make_output (self, buf);
+
+  gst_tensor_filter_cascade_release (self);
+
+done:
+  for (i = 0; i < mapped; i++)
+    gst_memory_unmap (in_mem[i], &in_map[i]);
+  gst_buffer_unref (buf);
+
+  if (outbuf)
+    ret = gst_pad_push (self->srcpad, outbuf);
+  else
+    GST_ELEMENT_ERROR (self, STREAM, FAILED, (NULL),
+        ("tensor_filter_cascade failed to process the tensors."));
+
+  return ret;
+}
+
+/**
+ * @brief This function handles sink pad event.
+ */
+static gboolean
+gst_tensor_filter_cascade_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstTensorFilterCascade *self;
+
+  self = GST_TENSOR_FILTER_CASCADE (parent);
+
+  g_return_val_if_fail (event != NULL, FALSE);
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps, *out_caps;
+      GstStructure *structure;
+      GstTensorsConfig config;
+      gboolean ret = FALSE;
+
+      gst_event_parse_caps (event, &caps);
+      silent_debug_caps (self, caps, "caps");
+
+      structure = gst_caps_get_structure (caps, 0);
+      gst_tensors_config_from_structure (&config, structure);
+
+      if (!gst_tensors_config_validate (&config) ||
+          gst_tensors_config_is_flexible (&config)) {
+        GST_ERROR_OBJECT (self, "The input should be static tensors.");
+      } else if (self->configured &&
+          gst_tensors_config_is_equal (&self->in_config, &config)) {
+        /* same input, keep the stages */
+        ret = TRUE;
+      } else {
+        ret = gst_tensor_filter_cascade_configure (self, &config);
+      }
+
+      if (ret) {
+        out_caps = gst_tensor_pad_caps_from_config (self->srcpad,
+            &self->out_config);
+        silent_debug_caps (self, out_caps, "out-caps");
+
+        ret = gst_pad_set_caps (self->srcpad, out_caps);
+        gst_caps_unref (out_caps);
+      }
+
+      gst_tensors_config_free (&config);
+      gst_event_unref (event);
+      return ret;
+    }
+    default:
+      break;
+  }
+
+  return gst_pad_event_default (pad, parent, event);
+}
+
+/**
+ * @brief This function handles sink pad query.
+ */
+static gboolean
+gst_tensor_filter_cascade_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  GstTensorFilterCascade *self;
+
+  self = GST_TENSOR_FILTER_CASCADE (parent);
+
+  GST_DEBUG_OBJECT (self, "Received %s query: %" GST_PTR_FORMAT,
+      GST_QUERY_TYPE_NAME (query), query);
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *caps;
+      GstCaps *filter;
+
+      gst_query_parse_caps (query, &filter);
+
+      caps = gst_pad_get_current_caps (pad);
+      if (!caps)
+        caps = gst_pad_get_pad_template_caps (pad);
+
+      if (filter) {
+        GstCaps *intersection;
+
+        intersection =
+            gst_caps_intersect_full (filter, caps, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref (caps);
+        caps = intersection;
+      }
+
+      silent_debug_caps (self, caps, "caps");
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      return TRUE;
+    }
+    default:
+      break;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+/**
+ * @brief Change state, close the models when the element stops.
+ */
+static GstStateChangeReturn
+gst_tensor_filter_cascade_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstTensorFilterCascade *self;
+  GstStateChangeReturn ret;
+
+  self = GST_TENSOR_FILTER_CASCADE (element);
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_tensor_filter_cascade_cleanup (self);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
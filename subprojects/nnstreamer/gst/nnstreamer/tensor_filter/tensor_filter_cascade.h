@@ -0,0 +1,142 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_cascade.h
+ * @date	18 Oct 2026
+ * @brief	GStreamer element to run a graph of models and glue operations in one element
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_FILTER_CASCADE_H__
+#define __GST_TENSOR_FILTER_CASCADE_H__
+
+#include <gst/gst.h>
+#include <tensor_common.h>
+#include "tensor_filter_single.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_FILTER_CASCADE \
+  (gst_tensor_filter_cascade_get_type())
+#define GST_TENSOR_FILTER_CASCADE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_FILTER_CASCADE,GstTensorFilterCascade))
+#define GST_TENSOR_FILTER_CASCADE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_FILTER_CASCADE,GstTensorFilterCascadeClass))
+#define GST_IS_TENSOR_FILTER_CASCADE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_FILTER_CASCADE))
+#define GST_IS_TENSOR_FILTER_CASCADE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_FILTER_CASCADE))
+
+typedef struct _GstTensorFilterCascade GstTensorFilterCascade;
+typedef struct _GstTensorFilterCascadeClass GstTensorFilterCascadeClass;
+
+/**
+ * @brief Operations of the cascade stages.
+ */
+typedef enum
+{
+  CASCADE_OP_FILTER = 0,
+  CASCADE_OP_CROP,
+  CASCADE_OP_RESIZE,
+  CASCADE_OP_THRESHOLD,
+
+  CASCADE_OP_UNKNOWN
+} tensor_cascade_op;
+
+/**
+ * @brief Index of the element input in tensor_cascade_ref.
+ */
+#define CASCADE_REF_INPUT (-1)
+
+/**
+ * @brief Index meaning all tensors of a stage in tensor_cascade_ref.
+ */
+#define CASCADE_REF_ALL G_MAXUINT
+
+/**
+ * @brief Reference to a tensor of the element input or of a stage.
+ */
+typedef struct
+{
+  gint stage; /**< stage index, CASCADE_REF_INPUT for the element input */
+  guint index; /**< tensor index, CASCADE_REF_ALL for all tensors */
+} tensor_cascade_ref;
+
+/**
+ * @brief A stage (node) of the cascade graph.
+ */
+typedef struct
+{
+  gchar *name; /**< stage name */
+  tensor_cascade_op op; /**< operation */
+  guint level; /**< depth in the graph, stages of the same level are independent */
+
+  guint num_refs; /**< the number of input references */
+  tensor_cascade_ref refs[NNS_TENSOR_SIZE_LIMIT]; /**< input references */
+  guint num_inputs; /**< the number of input tensors (references resolved) */
+  tensor_cascade_ref inputs[NNS_TENSOR_SIZE_LIMIT]; /**< input tensors */
+
+  gchar **options; /**< key=value pairs for the filter properties */
+  guint region[4]; /**< crop region (x, y, width, height) */
+  guint size[2]; /**< output width and height (crop, resize) */
+  gdouble threshold; /**< threshold value */
+
+  GTensorFilterSingle *filter; /**< filter instance (filter stage) */
+  gboolean allocate_in_invoke; /**< the framework allocates the output */
+  GstTensorsInfo in_info; /**< input tensors info */
+  GstTensorsInfo out_info; /**< output tensors info */
+  GstTensorMemory in[NNS_TENSOR_SIZE_LIMIT]; /**< input tensors of the current frame */
+  GstTensorMemory out[NNS_TENSOR_SIZE_LIMIT]; /**< output tensors of the current frame */
+  gboolean failed; /**< the stage failed with the current frame */
+} tensor_cascade_stage;
+
+/**
+ * @brief GstTensorFilterCascade data structure.
+ */
+struct _GstTensorFilterCascade
+{
+  GstElement element; /**< parent object */
+  GstPad *sinkpad; /**< sink pad */
+  GstPad *srcpad; /**< src pad */
+
+  /* <private> */
+  gboolean silent; /**< true to print minimized log */
+  gboolean parallel; /**< true to run independent stages in parallel */
+  gchar *stages_desc; /**< property 'stages' */
+  gchar *output_desc; /**< property 'output' */
+
+  GPtrArray *stages; /**< parsed stages (tensor_cascade_stage) */
+  guint num_levels; /**< the number of levels in the graph */
+  guint num_outputs; /**< the number of output tensors */
+  tensor_cascade_ref outputs[NNS_TENSOR_SIZE_LIMIT]; /**< output tensors */
+
+  gboolean configured; /**< true if the stages are configured */
+  GstTensorsConfig in_config; /**< input tensors config */
+  GstTensorsConfig out_config; /**< output tensors config */
+  GstTensorMemory src[NNS_TENSOR_SIZE_LIMIT]; /**< input tensors of the current frame */
+
+  GThreadPool *pool; /**< workers for the independent stages */
+  GMutex lock; /**< lock for pending */
+  GCond cond; /**< signalled when a stage is done */
+  guint pending; /**< the number of stages running in the workers */
+};
+
+/**
+ * @brief GstTensorFilterCascadeClass data structure.
+ */
+struct _GstTensorFilterCascadeClass
+{
+  GstElementClass parent_class; /**< parent class */
+};
+
+/**
+ * @brief Function to get type of tensor_filter_cascade.
+ */
+GType gst_tensor_filter_cascade_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_TENSOR_FILTER_CASCADE_H__ */
@@ -23,7 +23,18 @@
  *
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* for sched_setaffinity */
+#endif
+
 #include <string.h>
+#include <glib/gstdio.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
 
 #include <hw_accel.h>
 #include <nnstreamer_log.h>
@@ -125,6 +136,12 @@ enum
   PROP_INPUTCOMBINATION,
   PROP_OUTPUTCOMBINATION,
   PROP_SHARED_TENSOR_FILTER_KEY,
+  PROP_LATENCY_STATS,
+  PROP_LATENCY_REPORT,
+  PROP_WARMUP,
+  PROP_NUM_THREADS,
+  PROP_CPU_AFFINITY,
+  PROP_NUMA_NODE,
 };
 
 /**
@@ -544,6 +561,8 @@ gst_tensor_filter_properties_init (GstTensorFilterProperties * prop)
   gst_tensors_info_init (&prop->output_meta);
   gst_tensors_layout_init (prop->output_layout);
   gst_tensors_rank_init (prop->output_ranks);
+
+  prop->numa_node = -1;
 }
 
 /**
@@ -569,12 +588,168 @@ gst_tensor_filter_framework_info_init (GstTensorFilterFrameworkInfo * info)
 static void
 gst_tensor_filter_statistics_init (GstTensorFilterStatistics * stat)
 {
+  guint i;
+
   stat->total_invoke_num = 0;
   stat->total_invoke_latency = 0;
   stat->old_total_invoke_num = 0;
   stat->old_total_invoke_latency = 0;
+  stat->latest_transform_time = 0;
   stat->latest_invoke_time = 0;
-  stat->recent_latencies = g_queue_new ();
+  stat->latest_invoke_done = 0;
+  stat->latest_report_time = 0;
+  stat->recent_index = 0;
+  stat->recent_num = 0;
+  stat->recent_total = 0;
+  for (i = 0; i < GST_TF_STAT_NUM; i++)
+    stat->samples[i] = -1;
+  stat->clock = NULL;
+  stat->base_time = GST_CLOCK_TIME_NONE;
+  g_mutex_init (&stat->lock);
+  /* allocated once, recording a sample never allocates */
+  stat->hist = g_new0 (GstTensorFilterHistogram, GST_TF_STAT_NUM);
+}
+
+/**
+ * @brief Get the histogram bucket of the given latency.
+ */
+static guint
+gst_tensor_filter_histogram_get_index (gint64 latency)
+{
+  guint64 value;
+  guint bits, shift;
+
+  if (latency < GST_TF_HIST_SUB_COUNT)
+    return (latency > 0) ? (guint) latency : 0U;
+
+  value = MIN ((guint64) latency, (G_GUINT64_CONSTANT (1) << GST_TF_HIST_MAX_BITS) - 1);
+  bits = g_bit_storage (value);
+  shift = bits - GST_TF_HIST_SUB_BITS;
+
+  return GST_TF_HIST_SUB_COUNT +
+      (bits - GST_TF_HIST_SUB_BITS - 1) * (GST_TF_HIST_SUB_COUNT / 2) +
+      (guint) ((value >> shift) - (GST_TF_HIST_SUB_COUNT / 2));
+}
+
+/**
+ * @brief Get the highest latency that falls into the given bucket.
+ */
+static gint64
+gst_tensor_filter_histogram_get_value (guint index)
+{
+  guint half = GST_TF_HIST_SUB_COUNT / 2;
+  guint shift;
+  guint64 sub;
+
+  if (index < GST_TF_HIST_SUB_COUNT)
+    return index;
+
+  index -= GST_TF_HIST_SUB_COUNT;
+  shift = index / half + 1;
+  sub = index % half + half;
+
+  return (gint64) (((sub + 1) << shift) - 1);
+}
+
+/**
+ * @brief Get the given percentile (in 1/1000) of the histogram. Caller should hold the lock.
+ */
+static gint64
+gst_tensor_filter_histogram_get_percentile (GstTensorFilterHistogram * hist,
+    guint permille)
+{
+  guint64 target, accum = 0;
+  guint i;
+
+  if (hist->count == 0)
+    return 0;
+
+  /* the smallest rank covering the percentile */
+  target = (hist->count * permille + 999) / 1000;
+  target = CLAMP (target, 1, hist->count);
+
+  for (i = 0; i < GST_TF_HIST_NUM_BUCKETS; i++) {
+    accum += hist->buckets[i];
+    if (accum >= target)
+      return MIN (gst_tensor_filter_histogram_get_value (i), hist->max);
+  }
+
+  return hist->max;
+}
+
+/**
+ * @brief Add the latency samples of an invoke to the histograms of all stages.
+ */
+void
+gst_tensor_filter_statistics_add (GstTensorFilterStatistics * stat,
+    const gint64 samples[GST_TF_STAT_NUM])
+{
+  guint i;
+
+  g_return_if_fail (stat != NULL && stat->hist != NULL);
+  g_return_if_fail (samples != NULL);
+
+  /* one lock for all stages of an invoke */
+  g_mutex_lock (&stat->lock);
+  for (i = 0; i < GST_TF_STAT_NUM; i++) {
+    GstTensorFilterHistogram *hist = &stat->hist[i];
+    gint64 latency = samples[i];
+
+    if (latency < 0)
+      continue;
+
+    hist->buckets[gst_tensor_filter_histogram_get_index (latency)]++;
+    hist->count++;
+    hist->total += latency;
+    if (latency > hist->max)
+      hist->max = latency;
+  }
+  g_mutex_unlock (&stat->lock);
+}
+
+/**
+ * @brief Get the latency percentiles of all stages.
+ */
+GstStructure *
+gst_tensor_filter_statistics_get_latency (GstTensorFilterStatistics * stat)
+{
+  static const gchar *stage_names[GST_TF_STAT_NUM] = {
+    "queue", "pre", "invoke", "post"
+  };
+  GstStructure *s;
+  guint i;
+
+  g_return_val_if_fail (stat != NULL && stat->hist != NULL, NULL);
+
+  s = gst_structure_new_empty ("tensor-filter-latency");
+
+  g_mutex_lock (&stat->lock);
+  for (i = 0; i < GST_TF_STAT_NUM; i++) {
+    GstTensorFilterHistogram *hist = &stat->hist[i];
+    gchar *name;
+
+#define _SET_FIELD(suffix,type,val) do { \
+      name = g_strdup_printf ("%s-%s", stage_names[i], suffix); \
+      gst_structure_set (s, name, type, val, NULL); \
+      g_free (name); \
+    } while (0)
+
+    _SET_FIELD ("count", G_TYPE_UINT64, hist->count);
+    _SET_FIELD ("mean", G_TYPE_INT64,
+        (gint64) (hist->count ? hist->total / hist->count : 0));
+    _SET_FIELD ("p50", G_TYPE_INT64,
+        gst_tensor_filter_histogram_get_percentile (hist, 500));
+    _SET_FIELD ("p95", G_TYPE_INT64,
+        gst_tensor_filter_histogram_get_percentile (hist, 950));
+    _SET_FIELD ("p99", G_TYPE_INT64,
+        gst_tensor_filter_histogram_get_percentile (hist, 990));
+    _SET_FIELD ("max", G_TYPE_INT64, hist->max);
+
+#undef _SET_FIELD
+  }
+  g_mutex_unlock (&stat->lock);
+
+  return s;
 }
 
 /**
@@ -792,6 +967,32 @@ gst_tensor_filter_allocate_in_invoke (GstTensorFilterPrivate * priv)
   return allocate_in_invoke;
 }
 
+/**
+ * @brief check if the framework and the opened model allow in-place invoke (output tensors over input tensors)
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if in-place invoke is allowed
+ */
+gboolean
+gst_tensor_filter_allow_in_place (GstTensorFilterPrivate * priv)
+{
+  int allow_in_place = 0;
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    /**
+     * V0 cannot describe the model-dependent in-place and old V0 subplugins may set allow_in_place,
+     * which was not supported. Only the in-tree custom filters are invoked in-place.
+     */
+    if (g_strcmp0 (priv->fw->name, "custom") == 0)
+      allow_in_place = custom_filter_allow_in_place (priv->privateData);
+    else if (g_strcmp0 (priv->fw->name, "custom-easy") == 0)
+      allow_in_place = custom_easy_filter_allow_in_place (priv->privateData);
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    allow_in_place = priv->info.allow_in_place;
+  }
+
+  return (allow_in_place != 0);
+}
+
 /**
  * @brief Free the data allocated for tensor filter output
  * @param[in] priv Struct containing the properties of the object
@@ -1004,6 +1205,45 @@ gst_tensor_filter_install_properties (GObjectClass * gobject_class)
           "to declare and share such instances. "
           "If it is NULL, it means the model representations is not shared.",
           NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_STATS,
+      g_param_spec_boxed ("latency-stats", "Latency statistics",
+          "The p50/p95/p99/max/mean latency (usec) and the number of samples "
+          "of each processing stage (queue, pre, invoke, post) as a structure. "
+          "Collected only if latency, throughput or latency-report is enabled.",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_REPORT,
+      g_param_spec_uint ("latency-report", "Latency report interval",
+          "Interval in milliseconds to post the latency statistics "
+          "as an element message \"tensor-filter-latency\" (0: off).",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_WARMUP,
+      g_param_spec_uint ("warmup", "Warm-up invokes",
+          "The number of dummy invokes with zero-filled input tensors "
+          "right after opening the framework, which makes the subplugin "
+          "allocate buffers and compile the model before the first frame. "
+          "Done when the element starts if the model has fixed tensor info, "
+          "otherwise when the input caps are configured (0: off).",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "The number of intra-op threads of the framework for the invoke. "
+          "A thread count given with the custom property of the sub-plugin "
+          "(e.g., NumThreads) has priority (0: framework default).",
+          0, G_MAXINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CPU_AFFINITY,
+      g_param_spec_string ("cpu-affinity", "CPU affinity",
+          "The list of cpus to run the model (e.g., 0-3,8). The thread is "
+          "pinned while opening the framework, the streaming thread is pinned "
+          "from its first invoke until the framework is closed, and the "
+          "threads created by the sub-plugin inherit it. Linux only.",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_NUMA_NODE,
+      g_param_spec_int ("numa-node", "NUMA node",
+          "The NUMA node to run the model. Without cpu-affinity, the threads "
+          "are pinned to the cpus of the node. The memory touched in open and "
+          "invoke (e.g., output tensors) prefers the node. Linux only "
+          "(-1: not given).",
+          -1, G_MAXINT, -1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -1019,6 +1259,7 @@ gst_tensor_filter_common_init_property (GstTensorFilterPrivate * priv)
   gst_tensor_filter_properties_init (&priv->prop);
   gst_tensor_filter_framework_info_init (&priv->info);
   gst_tensor_filter_statistics_init (&priv->stat);
+  g_mutex_init (&priv->affinity_lock);
 
   /* set default framework 'auto' */
   priv->prop.fwname = g_strdup ("auto");
@@ -1043,6 +1284,7 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
   g_free_const (prop->accl_str);
   g_free (prop->hw_list);
   g_free (prop->shared_tensor_filter_key);
+  g_free_const (prop->cpu_affinity);
 
   g_free_const (prop->custom_properties);
   g_strfreev_const (prop->model_files);
@@ -1057,13 +1299,16 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
   g_list_free (priv->combi.out_combi_i);
   g_list_free (priv->combi.out_combi_o);
 
-  if (priv->stat.recent_latencies != NULL) {
-    GQueue *queue = priv->stat.recent_latencies;
-    gint64 *latency;
-    while ((latency = g_queue_pop_tail (queue)) != NULL)
-      g_free (latency);
-    g_queue_free (queue);
+  if (priv->stat.hist != NULL) {
+    g_free (priv->stat.hist);
+    priv->stat.hist = NULL;
+    g_mutex_clear (&priv->stat.lock);
   }
+  if (priv->stat.clock) {
+    gst_object_unref (priv->stat.clock);
+    priv->stat.clock = NULL;
+  }
+  g_mutex_clear (&priv->affinity_lock);
 
   G_LOCK (shared_model_table);
   if (shared_model_table) {
@@ -1878,6 +2123,282 @@ _gtfc_setprop_OUTPUTCOMBINATION (GstTensorFilterPrivate * priv,
   return ret;
 }
 
+/**
+ * @brief Parse the list of cpus (e.g., "0-3,8").
+ * @param[in] str The list of cpus.
+ * @param[in] func Callback for each cpu (may be NULL to validate the list only).
+ * @param[in] data User data for the callback.
+ * @return TRUE if the list is valid.
+ */
+static gboolean
+_gtfc_parse_cpu_list (const gchar * str, void (*func) (guint, gpointer),
+    gpointer data)
+{
+  gchar **strv;
+  guint i, num;
+  gboolean ret = TRUE;
+
+  strv = g_strsplit_set (str, ",\n", -1);
+  num = g_strv_length (strv);
+
+  for (i = 0; i < num && ret; i++) {
+    gchar *item = g_strstrip (strv[i]);
+    gchar *end = NULL;
+    guint64 first, last, cpu;
+
+    if (item[0] == '\0')
+      continue;
+
+    if (!g_ascii_isdigit (item[0])) {
+      ret = FALSE;
+      break;
+    }
+
+    first = last = g_ascii_strtoull (item, &end, 10);
+    if (end && *end == '-') {
+      if (!g_ascii_isdigit (end[1])) {
+        ret = FALSE;
+        break;
+      }
+      last = g_ascii_strtoull (end + 1, &end, 10);
+    }
+
+    if ((end && *end != '\0') || first > last || last >= G_MAXUINT16) {
+      ret = FALSE;
+      break;
+    }
+
+    if (func) {
+      for (cpu = first; cpu <= last; cpu++)
+        func ((guint) cpu, data);
+    }
+  }
+
+  g_strfreev (strv);
+  return ret;
+}
+
+#if defined(__linux__)
+/**
+ * @brief Callback of _gtfc_parse_cpu_list to fill the cpu set.
+ */
+static void
+_gtfc_add_cpu (guint cpu, gpointer data)
+{
+  cpu_set_t *set = (cpu_set_t *) data;
+
+  if (cpu < CPU_SETSIZE)
+    CPU_SET (cpu, set);
+}
+
+G_STATIC_ASSERT (sizeof (cpu_set_t) <= sizeof (((GstTensorFilterAffinity *) 0)->cpus));
+
+#if defined(__NR_set_mempolicy) && defined(__NR_get_mempolicy) && !defined(__ANDROID__)
+#define TF_HAVE_MEMPOLICY
+#define TF_MPOL_PREFERRED (1)
+#define TF_MPOL_MAX_NODE (sizeof (((GstTensorFilterAffinity *) 0)->mempolicy_nodes) * 8)
+#endif
+#endif
+
+/**
+ * @brief Set the cpu set and the memory policy of the calling thread, and save the current ones.
+ * A failure is warned once and not tried again. Call it with the affinity lock.
+ */
+static void
+_gtfc_set_affinity (GstTensorFilterPrivate * priv,
+    GstTensorFilterAffinity * saved)
+{
+  GstTensorFilterAffinity *affinity = &priv->affinity;
+
+  saved->has_cpus = FALSE;
+  saved->has_mempolicy = FALSE;
+
+#if defined(__linux__)
+  if (affinity->has_cpus) {
+    if (sched_getaffinity (0, sizeof (cpu_set_t),
+            (cpu_set_t *) saved->cpus) == 0 &&
+        sched_setaffinity (0, sizeof (cpu_set_t),
+            (cpu_set_t *) affinity->cpus) == 0) {
+      saved->has_cpus = TRUE;
+    } else {
+      /* e.g., the cpus are out of the cpuset of the process */
+      ml_logw ("Failed to set the cpu affinity '%s', the threads are not pinned.",
+          priv->prop.cpu_affinity ? priv->prop.cpu_affinity : "");
+      affinity->has_cpus = FALSE;
+    }
+  }
+
+#if defined(TF_HAVE_MEMPOLICY)
+  if (affinity->has_mempolicy) {
+    /* MPOL_PREFERRED, the pages are first-touched by this thread */
+    if (syscall (__NR_get_mempolicy, &saved->mempolicy_mode,
+            saved->mempolicy_nodes, TF_MPOL_MAX_NODE, NULL, 0) == 0 &&
+        syscall (__NR_set_mempolicy, affinity->mempolicy_mode,
+            affinity->mempolicy_nodes, TF_MPOL_MAX_NODE + 1) == 0) {
+      saved->has_mempolicy = TRUE;
+    } else {
+      /* e.g., not permitted in the container */
+      ml_logw ("Failed to set the memory policy for numa node %d, "
+          "the memory is allocated on the node of the pinned cpus.",
+          priv->prop.numa_node);
+      affinity->has_mempolicy = FALSE;
+    }
+  }
+#endif
+#endif
+
+  if (!affinity->has_cpus && !affinity->has_mempolicy)
+    g_atomic_int_set (&priv->affinity_serial, 0);
+}
+
+/**
+ * @brief Restore the saved cpu set of a thread (0 for the calling thread).
+ * The memory policy can be restored only for the calling thread.
+ */
+static void
+_gtfc_restore_affinity (gint tid, GstTensorFilterAffinity * saved)
+{
+#if defined(__linux__)
+  /* another thread may have exited already, ignore the error */
+  if (saved->has_cpus &&
+      sched_setaffinity (tid, sizeof (cpu_set_t),
+          (cpu_set_t *) saved->cpus) != 0 && tid == 0)
+    ml_logw ("Failed to restore the cpu affinity.");
+
+#if defined(TF_HAVE_MEMPOLICY)
+  if (saved->has_mempolicy && tid == 0 &&
+      syscall (__NR_set_mempolicy, saved->mempolicy_mode,
+          saved->mempolicy_nodes, TF_MPOL_MAX_NODE + 1) != 0)
+    ml_logw ("Failed to restore the memory policy.");
+#endif
+#else
+  UNUSED (tid);
+#endif
+
+  saved->has_cpus = FALSE;
+  saved->has_mempolicy = FALSE;
+}
+
+/**
+ * @brief Restore the thread pinned by invoke. Call it with the affinity lock.
+ * The memory policy of another thread is left, it only prefers the node.
+ */
+static void
+_gtfc_unpin_affinity (GstTensorFilterPrivate * priv)
+{
+  if (priv->affinity_thread == NULL)
+    return;
+
+  _gtfc_restore_affinity ((priv->affinity_thread == g_thread_self ()) ?
+      0 : priv->affinity_tid, &priv->affinity_saved);
+
+  g_atomic_pointer_set (&priv->affinity_thread, NULL);
+  g_atomic_int_set (&priv->affinity_thread_serial, 0);
+  priv->affinity_tid = 0;
+}
+
+/**
+ * @brief Update the cpu set and the memory policy with cpu-affinity and numa-node.
+ * The cpu list of numa-node is read here, not in every invoke.
+ */
+static void
+_gtfc_update_affinity (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterAffinity affinity;
+#if defined(__linux__)
+  cpu_set_t *set = (cpu_set_t *) affinity.cpus;
+  gchar *cpulist = NULL;
+  gboolean valid;
+#endif
+
+  memset (&affinity, 0, sizeof (affinity));
+
+  if (prop->cpu_affinity == NULL && prop->numa_node < 0)
+    goto done;
+
+#if defined(__linux__)
+  if (prop->cpu_affinity) {
+    cpulist = g_strdup (prop->cpu_affinity);
+  } else {
+    gchar *path = g_strdup_printf ("/sys/devices/system/node/node%d/cpulist",
+        prop->numa_node);
+
+    if (!g_file_get_contents (path, &cpulist, NULL, NULL)) {
+      ml_logw ("Failed to get the cpus of numa node %d.", prop->numa_node);
+      cpulist = NULL;
+    }
+    g_free (path);
+  }
+
+  if (cpulist) {
+    CPU_ZERO (set);
+    valid = _gtfc_parse_cpu_list (cpulist, _gtfc_add_cpu, set);
+
+    if (!valid || CPU_COUNT (set) == 0)
+      ml_logw ("Invalid cpu list '%s' for the affinity.", cpulist);
+    else
+      affinity.has_cpus = TRUE;
+
+    g_free (cpulist);
+  }
+
+  if (prop->numa_node >= 0) {
+#if defined(TF_HAVE_MEMPOLICY)
+    const gsize bits = sizeof (gulong) * 8;
+
+    if ((gsize) prop->numa_node < TF_MPOL_MAX_NODE) {
+      affinity.has_mempolicy = TRUE;
+      affinity.mempolicy_mode = TF_MPOL_PREFERRED;
+      affinity.mempolicy_nodes[prop->numa_node / bits] =
+          1UL << (prop->numa_node % bits);
+    } else {
+      ml_logw ("Cannot set the memory policy for numa node %d, "
+          "the memory is allocated on the node of the pinned cpus.",
+          prop->numa_node);
+    }
+#else
+    ml_logw ("The memory policy is not supported on this platform, "
+        "the memory is allocated on the node of the pinned cpus.");
+#endif
+  }
+#else
+  ml_logw ("The cpu affinity and numa node are not supported on this platform.");
+#endif
+
+done:
+  g_mutex_lock (&priv->affinity_lock);
+  priv->affinity = affinity;
+  if (affinity.has_cpus || affinity.has_mempolicy) {
+    /* the pinned thread is pinned again on its next invoke */
+    g_atomic_int_set (&priv->affinity_serial, ++priv->affinity_updates);
+  } else {
+    g_atomic_int_set (&priv->affinity_serial, 0);
+    _gtfc_unpin_affinity (priv);
+  }
+  g_mutex_unlock (&priv->affinity_lock);
+}
+
+/** @brief Handle "PROP_CPU_AFFINITY" for set-property */
+static gint
+_gtfc_setprop_CPU_AFFINITY (GstTensorFilterPrivate * priv,
+    GstTensorFilterProperties * prop, const GValue * value)
+{
+  const gchar *str = g_value_get_string (value);
+
+  if (str && !_gtfc_parse_cpu_list (str, NULL, NULL)) {
+    ml_loge ("Invalid cpu-affinity '%s', it should be a list of cpus "
+        "(e.g., 0-3,8).", str);
+    return -EINVAL;
+  }
+
+  g_free_const (prop->cpu_affinity);
+  prop->cpu_affinity = (str && str[0] != '\0') ? g_strdup (str) : NULL;
+  _gtfc_update_affinity (priv);
+
+  return 0;
+}
+
 /** @brief Handle "PROP_SHARED_TENSOR_FILTER_KEY" for set-property */
 static gint
 _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (GstTensorFilterProperties * prop,
@@ -1976,6 +2497,22 @@ gst_tensor_filter_common_set_property (GstTensorFilterPrivate * priv,
     case PROP_SHARED_TENSOR_FILTER_KEY:
       status = _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (prop, value);
       break;
+    case PROP_LATENCY_REPORT:
+      priv->latency_report = g_value_get_uint (value);
+      break;
+    case PROP_WARMUP:
+      priv->warmup = g_value_get_uint (value);
+      break;
+    case PROP_NUM_THREADS:
+      prop->num_threads = (int) g_value_get_uint (value);
+      break;
+    case PROP_CPU_AFFINITY:
+      status = _gtfc_setprop_CPU_AFFINITY (priv, prop, value);
+      break;
+    case PROP_NUMA_NODE:
+      prop->numa_node = g_value_get_int (value);
+      _gtfc_update_affinity (priv);
+      break;
     default:
       return FALSE;
   }
@@ -2178,6 +2715,26 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
       else
         g_value_set_string (value, "");
       break;
+    case PROP_LATENCY_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_filter_statistics_get_latency (&priv->stat));
+      break;
+    case PROP_LATENCY_REPORT:
+      g_value_set_uint (value, priv->latency_report);
+      break;
+    case PROP_WARMUP:
+      g_value_set_uint (value, priv->warmup);
+      break;
+    case PROP_NUM_THREADS:
+      g_value_set_uint (value, (guint) prop->num_threads);
+      break;
+    case PROP_CPU_AFFINITY:
+      g_value_set_string (value,
+          prop->cpu_affinity ? prop->cpu_affinity : "");
+      break;
+    case PROP_NUMA_NODE:
+      g_value_set_int (value, prop->numa_node);
+      break;
     default:
       /* unknown property */
       return FALSE;
@@ -2426,8 +2983,20 @@ gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
       }
       /* 0 if successfully loaded. 1 if skipped (already loaded). */
       if (verify_model_path (priv)) {
+        GstTensorFilterAffinity saved = { 0 };
+
+        /**
+         * Threads created in open (e.g., thread pool of the framework) inherit the affinity.
+         * Open may run in the application thread, restore it after open.
+         */
+        if (g_atomic_int_get (&priv->affinity_serial) != 0) {
+          g_mutex_lock (&priv->affinity_lock);
+          _gtfc_set_affinity (priv, &saved);
+          g_mutex_unlock (&priv->affinity_lock);
+        }
         if (priv->fw->open (&priv->prop, &priv->privateData) >= 0)
           priv->prop.fw_opened = TRUE;
+        _gtfc_restore_affinity (0, &saved);
       }
     } else {
       priv->prop.fw_opened = TRUE;
@@ -2453,12 +3022,45 @@ gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
   }
 }
 
+/**
+ * @brief Pin the calling thread to the cpus of cpu-affinity or numa-node, and prefer the memory of numa-node.
+ */
+void
+gst_tensor_filter_common_pin_affinity (GstTensorFilterPrivate * priv)
+{
+  GThread *self = g_thread_self ();
+  gint serial = g_atomic_int_get (&priv->affinity_serial);
+
+  /* the streaming thread is pinned already */
+  if (serial == 0 || (g_atomic_pointer_get (&priv->affinity_thread) == self &&
+          g_atomic_int_get (&priv->affinity_thread_serial) == serial))
+    return;
+
+  g_mutex_lock (&priv->affinity_lock);
+  serial = g_atomic_int_get (&priv->affinity_serial);
+  if (serial != 0) {
+    /* another thread invokes now, or the affinity is updated */
+    _gtfc_unpin_affinity (priv);
+    _gtfc_set_affinity (priv, &priv->affinity_saved);
+#if defined(__linux__)
+    priv->affinity_tid = (gint) syscall (__NR_gettid);
+#endif
+    g_atomic_pointer_set (&priv->affinity_thread, self);
+    g_atomic_int_set (&priv->affinity_thread_serial, serial);
+  }
+  g_mutex_unlock (&priv->affinity_lock);
+}
+
 /**
  * @brief Close NN framework.
  */
 void
 gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv)
 {
+  g_mutex_lock (&priv->affinity_lock);
+  _gtfc_unpin_affinity (priv);
+  g_mutex_unlock (&priv->affinity_lock);
+
   if (priv->prop.fw_opened) {
     if (priv->fw && priv->fw->close) {
       priv->fw->close (&priv->prop, &priv->privateData);
@@ -2470,9 +3072,90 @@ gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv)
     priv->fw = NULL;
     priv->privateData = NULL;
     priv->configured = FALSE;
+    priv->warmup_done = FALSE;
   }
 }
 
+/**
+ * @brief Run the warm-up invokes with zero-filled input tensors.
+ */
+gboolean
+gst_tensor_filter_common_warmup (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  gboolean allocate_in_invoke;
+  gint64 start_time, end_time;
+  guint i, n;
+  gint ret = 0;
+
+  prop = &priv->prop;
+
+  if (priv->warmup == 0 || priv->warmup_done)
+    return TRUE;
+
+  /* cannot prepare the dummy tensors without fixed tensor info */
+  if (!prop->fw_opened || !prop->input_configured || !prop->output_configured)
+    return TRUE;
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+
+  memset (in_tensors, 0, sizeof (in_tensors));
+  memset (out_tensors, 0, sizeof (out_tensors));
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    in_tensors[i].size = gst_tensors_info_get_size (&prop->input_meta, i);
+    in_tensors[i].data = g_malloc0 (in_tensors[i].size);
+  }
+
+  if (!allocate_in_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      out_tensors[i].size = gst_tensors_info_get_size (&prop->output_meta, i);
+      out_tensors[i].data = g_malloc (out_tensors[i].size);
+    }
+  }
+
+  start_time = g_get_monotonic_time ();
+  for (n = 0; n < priv->warmup; n++) {
+    GST_TF_FW_INVOKE_COMPAT (priv, ret, in_tensors, out_tensors);
+    if (ret < 0)
+      break;
+
+    if (allocate_in_invoke && ret == 0) {
+      for (i = 0; i < prop->output_meta.num_tensors; i++) {
+        if (out_tensors[i].data)
+          gst_tensor_filter_destroy_notify_util (priv, out_tensors[i].data);
+        out_tensors[i].data = NULL;
+      }
+    }
+  }
+  end_time = g_get_monotonic_time ();
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++)
+    g_free (in_tensors[i].data);
+
+  if (!allocate_in_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++)
+      g_free (out_tensors[i].data);
+  }
+
+  /* do not retry, the subplugin would fail again. */
+  priv->warmup_done = TRUE;
+
+  if (ret < 0) {
+    ml_loge
+        ("The warm-up invoke of the tensor-filter subplugin (%s for %s) has failed with error code (%d) at %u-th trial.\n",
+        prop->fwname, TF_MODELNAME (prop), ret, n);
+    return FALSE;
+  }
+
+  ml_logi ("Filter %s with model file %s is warmed up with %u invokes. It took %"
+      G_GINT64_FORMAT " us", prop->fwname, TF_MODELNAME (prop), priv->warmup,
+      end_time - start_time);
+  return TRUE;
+}
+
 /**
  * @brief return accl_hw type from string
  * @param key The key string value
@@ -2819,25 +3502,99 @@ accl_hw_get_type (void)
   return g_accl_hw_type_id_store;
 }
 
+/**
+ * @brief Get the comma separated list of the accelerators supported by the framework.
+ * @return Newly allocated string. NULL if the framework cannot tell the accelerators.
+ */
+static gchar *
+_get_available_hw_str (const GstTensorFilterFramework * fw,
+    GstTensorFilterProperties * prop)
+{
+  GPtrArray *hw_names;
+  gchar *str = NULL;
+  gint idx;
+
+  hw_names = g_ptr_array_new ();
+
+  if (GST_TF_FW_V0 (fw)) {
+    GEnumClass *enum_class;
+
+    if (!fw->checkAvailability)
+      goto done;
+
+    enum_class = g_type_class_ref (accl_hw_get_type ());
+    for (idx = 0; idx < (gint) enum_class->n_values; idx++) {
+      accl_hw hw = (accl_hw) enum_class->values[idx].value;
+      const gchar *name = get_accl_hw_str (hw);
+
+      if (hw == ACCL_NONE || hw == ACCL_AUTO || hw == ACCL_DEFAULT)
+        continue;
+
+      /* skip the aliases having the same value */
+      if (g_strcmp0 (enum_class->values[idx].value_name, name) != 0)
+        continue;
+
+      if (fw->checkAvailability (hw) == 0)
+        g_ptr_array_add (hw_names, (gpointer) name);
+    }
+    g_type_class_unref (enum_class);
+  } else if (GST_TF_FW_V1 (fw)) {
+    GstTensorFilterFrameworkInfo info;
+
+    if (fw->getFrameworkInfo (fw, prop, NULL, &info) != 0)
+      goto done;
+
+    for (idx = 0; idx < info.num_hw; idx++)
+      g_ptr_array_add (hw_names, (gpointer) get_accl_hw_str (info.hw_list[idx]));
+  } else {
+    goto done;
+  }
+
+  g_ptr_array_add (hw_names, NULL);
+  str = g_strjoinv (",", (gchar **) hw_names->pdata);
+
+done:
+  g_ptr_array_free (hw_names, TRUE);
+  return str;
+}
+
 /**
  * @brief Check if the given hw is supported by the framework.
  * @note This function is included in nnstreamer internal header for native APIs.
  *       When changing the declaration, you should update the internal header (nnstreamer_internal.h).
+ * @note Without the custom option, this uses the accelerators in the subplugin manifest if available, not to load the sub-plugin.
  */
 gboolean
 gst_tensor_filter_check_hw_availability (const gchar * name, const accl_hw hw,
     const char *custom)
 {
-  gint idx = 0;
   gboolean available = FALSE;
-  GstTensorFilterFrameworkInfo info;
   GstTensorFilterProperties prop;
   const GstTensorFilterFramework *fw;
+  gchar *hw_str;
 
   if (!name) {
     nns_logw ("Cannot check hw availability, given framwork name is NULL.");
     return FALSE;
   }
+
+  if (!custom) {
+    hw_str = subplugin_get_manifest_value (NNS_SUBPLUGIN_FILTER, name,
+        "accelerators");
+    if (hw_str) {
+      gchar **hw_list = g_strsplit (hw_str, ",", -1);
+
+      /** Only check for specific HW, DEFAULT/AUTO are always supported */
+      available = (hw == ACCL_AUTO || hw == ACCL_DEFAULT ||
+          g_strv_contains ((const gchar * const *) hw_list,
+              get_accl_hw_str (hw)));
+
+      g_strfreev (hw_list);
+      g_free (hw_str);
+      return available;
+    }
+  }
+
   if ((fw = nnstreamer_filter_find (name)) == NULL) {
     nns_logw ("Cannot find sub-plugin for %s.", name);
     return FALSE;
@@ -2846,21 +3603,24 @@ gst_tensor_filter_check_hw_availability (const gchar * name, const accl_hw hw,
   if (GST_TF_FW_V1 (fw))
     gst_tensor_filter_properties_init (&prop);
 
+  hw_str = _get_available_hw_str (fw, &prop);
+
   /** Only check for specific HW, DEFAULT/AUTO are always supported */
   if (hw == ACCL_AUTO || hw == ACCL_DEFAULT) {
     available = TRUE;
-  } else if (GST_TF_FW_V0 (fw)) {
-    if (fw->checkAvailability && fw->checkAvailability (hw) == 0)
-      available = TRUE;
-  } else if (GST_TF_FW_V1 (fw)) {
-    if (fw->getFrameworkInfo (fw, &prop, NULL, &info) == 0) {
-      for (idx = 0; idx < info.num_hw; idx++) {
-        if (info.hw_list[idx] == hw) {
-          available = TRUE;
-          break;
-        }
-      }
-    }
+  } else if (hw_str) {
+    gchar **hw_list = g_strsplit (hw_str, ",", -1);
+
+    available = g_strv_contains ((const gchar * const *) hw_list,
+        get_accl_hw_str (hw));
+    g_strfreev (hw_list);
+  }
+
+  /* keep the accelerators of the module in the manifest */
+  if (hw_str) {
+    subplugin_set_manifest_value (NNS_SUBPLUGIN_FILTER, name, "accelerators",
+        hw_str);
+    g_free (hw_str);
   }
 
   /* handle custom option */
@@ -3061,3 +3821,199 @@ nnstreamer_filter_shared_model_replace (void *instance, const char *key,
   }
   G_UNLOCK (shared_model_table);
 }
+
+/**
+ * @brief The version of the artifact cache key. Increase it if the key is changed.
+ */
+#define TF_CACHE_KEY_VERSION "2"
+
+/**
+ * @brief The nanoseconds of the modification time, a model rewritten within a second has a different key.
+ */
+#if defined(__APPLE__)
+#define TF_CACHE_MTIME_NSEC(st) ((gint64) (st).st_mtimespec.tv_nsec)
+#else
+#define TF_CACHE_MTIME_NSEC(st) ((gint64) (st).st_mtim.tv_nsec)
+#endif
+
+/**
+ * @brief Append the string including the null terminator to the cache key.
+ */
+static void
+_cache_key_update (GChecksum * sum, const gchar * str)
+{
+  if (str == NULL)
+    str = "";
+  g_checksum_update (sum, (const guchar *) str, strlen (str) + 1);
+}
+
+/**
+ * @brief Get the file name of the artifact of the given model.
+ * @note The model files are identified by path, size and modification time instead of the contents, to keep the lookup cheap for the large models.
+ */
+static gchar *
+_cache_get_filename (const GstTensorFilterProperties * prop, const char *tag)
+{
+  GChecksum *sum;
+  GStatBuf st;
+  gchar *str, *fwname, *filename = NULL;
+  int i;
+
+  if (!prop || !prop->fwname || !prop->model_files || prop->num_models <= 0) {
+    nns_loge ("Cannot get the cache key: the framework and model are not given.");
+    return NULL;
+  }
+
+  sum = g_checksum_new (G_CHECKSUM_SHA256);
+  _cache_key_update (sum, TF_CACHE_KEY_VERSION);
+  _cache_key_update (sum, prop->fwname);
+
+  for (i = 0; i < prop->num_models; i++) {
+    if (g_stat (prop->model_files[i], &st) != 0) {
+      nns_loge ("Cannot get the cache key: failed to get the status of %s.",
+          prop->model_files[i]);
+      goto done;
+    }
+
+    str = g_strdup_printf ("%s:%" G_GINT64_FORMAT ":%" G_GINT64_FORMAT
+        ".%09" G_GINT64_FORMAT, prop->model_files[i], (gint64) st.st_size,
+        (gint64) st.st_mtime, TF_CACHE_MTIME_NSEC (st));
+    _cache_key_update (sum, str);
+    g_free (str);
+  }
+
+  _cache_key_update (sum, prop->accl_str);
+  for (i = 0; i < prop->num_hw; i++)
+    _cache_key_update (sum, get_accl_hw_str (prop->hw_list[i]));
+  _cache_key_update (sum, tag);
+
+  fwname = g_strdup (prop->fwname);
+  g_strdelimit (fwname, G_DIR_SEPARATOR_S, '_');
+  filename = g_strdup_printf ("%s-%s", fwname, g_checksum_get_string (sum));
+  g_free (fwname);
+
+done:
+  g_checksum_free (sum);
+  return filename;
+}
+
+/**
+ * @brief Get the path of the cached artifact for the opened model.
+ */
+char *
+nnstreamer_filter_cache_get_path (const GstTensorFilterProperties * prop,
+    const char *tag)
+{
+  gchar *dir, *filename, *path;
+
+  filename = _cache_get_filename (prop, tag);
+  if (!filename)
+    return NULL;
+
+  dir = nnsconf_get_custom_value_string ("filter", "cache_dir");
+  if (!dir || dir[0] == '\0') {
+    g_free (dir);
+    dir = g_build_filename (g_get_user_cache_dir (), "nnstreamer",
+        "filter-cache", NULL);
+  }
+
+  path = g_build_filename (dir, filename, NULL);
+  g_free (dir);
+  g_free (filename);
+  return path;
+}
+
+/**
+ * @brief Map the cached artifact of the opened model.
+ */
+void *
+nnstreamer_filter_cache_load (const GstTensorFilterProperties * prop,
+    const char *tag, const void **data, size_t *size)
+{
+  GMappedFile *mapped;
+  GError *err = NULL;
+  gchar *path;
+
+  if (!data || !size) {
+    nns_loge ("Cannot load the cached artifact: invalid parameter.");
+    return NULL;
+  }
+
+  path = nnstreamer_filter_cache_get_path (prop, tag);
+  if (!path)
+    return NULL;
+
+  mapped = g_mapped_file_new (path, FALSE, &err);
+  if (!mapped) {
+    /* cache miss */
+    nns_logd ("Cannot map the cached artifact %s: %s", path,
+        err ? err->message : "unknown reason");
+    g_clear_error (&err);
+    g_free (path);
+    return NULL;
+  }
+
+  if (g_mapped_file_get_length (mapped) == 0) {
+    nns_logw ("The cached artifact %s is empty.", path);
+    g_mapped_file_unref (mapped);
+    g_free (path);
+    return NULL;
+  }
+
+  *data = g_mapped_file_get_contents (mapped);
+  *size = g_mapped_file_get_length (mapped);
+
+  g_free (path);
+  return mapped;
+}
+
+/**
+ * @brief Release the artifact mapped by nnstreamer_filter_cache_load().
+ */
+void
+nnstreamer_filter_cache_release (void *handle)
+{
+  if (handle)
+    g_mapped_file_unref ((GMappedFile *) handle);
+}
+
+/**
+ * @brief Store the artifact of the opened model to the cache.
+ */
+int
+nnstreamer_filter_cache_store (const GstTensorFilterProperties * prop,
+    const char *tag, const void *data, size_t size)
+{
+  GError *err = NULL;
+  gchar *path, *dir;
+  int ret = 0;
+
+  if (!data || size == 0 || size > G_MAXSSIZE) {
+    nns_loge ("Cannot store the artifact: invalid parameter.");
+    return -EINVAL;
+  }
+
+  path = nnstreamer_filter_cache_get_path (prop, tag);
+  if (!path)
+    return -EINVAL;
+
+  dir = g_path_get_dirname (path);
+  if (g_mkdir_with_parents (dir, 0700) != 0) {
+    ret = -errno;
+    nns_loge ("Cannot create the cache directory %s.", dir);
+    goto done;
+  }
+
+  /* g_file_set_contents() writes a temporary file and renames it. */
+  if (!g_file_set_contents (path, data, (gssize) size, &err)) {
+    nns_loge ("Cannot store the artifact %s: %s", path,
+        err ? err->message : "unknown reason");
+    g_clear_error (&err);
+    ret = -EIO;
+  }
+
+done:
+  g_free (dir);
+  g_free (path);
+  return ret;
+}
@@ -26,6 +26,7 @@
 #define __G_TENSOR_FILTER_COMMON_H__
 
 #include <glib-object.h>
+#include <gst/gst.h>
 #include <errno.h>
 #include <nnstreamer_subplugin.h>
 #include <nnstreamer_plugin_api_util.h>
@@ -46,6 +47,10 @@ G_BEGIN_DECLS
 #define GST_TF_FW_V0(fw) GST_TF_FW_VN (fw, 0)
 #define GST_TF_FW_V1(fw) GST_TF_FW_VN (fw, 1)
 
+/** The first model file name for the log messages */
+#define TF_MODELNAME(prop) \
+    ((prop)->model_files ? ((prop)->model_files[0]) : "[No Model File]")
+
 /**
  * @brief Invoke callbacks of nn framework. Guarantees calling open for the first call.
  */
@@ -67,6 +72,8 @@ G_BEGIN_DECLS
 
 #define GST_TF_FW_INVOKE_COMPAT(priv,ret,in,out) do { \
       ret = -1; \
+      if (g_atomic_int_get (&(priv)->affinity_serial) != 0) \
+        gst_tensor_filter_common_pin_affinity (priv); \
       if (GST_TF_FW_V0 ((priv)->fw)) { \
         ret = (priv)->fw->invoke_NN (&(priv)->prop, &(priv)->privateData, (in), (out)); \
       } else if (GST_TF_FW_V1 ((priv)->fw)) { \
@@ -76,6 +83,44 @@ G_BEGIN_DECLS
 
 #define GST_TF_STAT_MAX_RECENT (10)
 
+/**
+ * @brief Latency histogram layout (log-linear, HDR-style).
+ * Values below GST_TF_HIST_SUB_COUNT usec have their own bucket. Each
+ * following power of two is split into GST_TF_HIST_SUB_COUNT / 2 buckets,
+ * so the relative error of a percentile is at most 1 / 32. Values are
+ * clamped to 2^GST_TF_HIST_MAX_BITS usec.
+ */
+#define GST_TF_HIST_SUB_BITS (6)
+#define GST_TF_HIST_SUB_COUNT (1 << GST_TF_HIST_SUB_BITS)
+#define GST_TF_HIST_MAX_BITS (40)
+#define GST_TF_HIST_NUM_BUCKETS \
+    (GST_TF_HIST_SUB_COUNT + \
+     (GST_TF_HIST_MAX_BITS - GST_TF_HIST_SUB_BITS) * (GST_TF_HIST_SUB_COUNT / 2))
+
+/**
+ * @brief The stages of tensor-filter processing measured separately.
+ */
+typedef enum
+{
+  GST_TF_STAT_QUEUE = 0, /**< delay from the running time of the buffer to its arrival (live pipelines) */
+  GST_TF_STAT_PRE, /**< from the arrival of the buffer to the invoke (mapping, allocation) */
+  GST_TF_STAT_INVOKE, /**< invoke of the sub-plugin */
+  GST_TF_STAT_POST, /**< from the end of the invoke to the output buffer */
+
+  GST_TF_STAT_NUM
+} GstTensorFilterStatType;
+
+/**
+ * @brief Fixed-size latency histogram (usec)
+ */
+typedef struct _GstTensorFilterHistogram
+{
+  guint64 count; /**< number of samples */
+  guint64 total; /**< sum of samples */
+  gint64 max; /**< maximum sample */
+  guint64 buckets[GST_TF_HIST_NUM_BUCKETS]; /**< number of samples per bucket */
+} GstTensorFilterHistogram;
+
 /**
  * @brief Structure definition for tensor-filter statistics
  */
@@ -85,10 +130,35 @@ typedef struct _GstTensorFilterStatistics
   gint64 total_invoke_latency;  /**< accumulated invoke latency (usec) */
   gint64 old_total_invoke_num;      /**< cached value. number of total invokes */
   gint64 old_total_invoke_latency;  /**< cached value. accumulated invoke latency (usec) */
+  gint64 latest_transform_time; /**< the arrival time of the latest buffer (usec) */
   gint64 latest_invoke_time;    /**< the latest invoke time (usec) */
-  void *recent_latencies;       /**< data structure (e.g., queue) to hold recent latencies */
+  gint64 latest_invoke_done;    /**< the end time of the latest invoke (usec) */
+  gint64 latest_report_time;    /**< the time of the latest latency report (usec) */
+  gint64 recent_latencies[GST_TF_STAT_MAX_RECENT]; /**< ring of the recent invoke latencies */
+  guint recent_index;           /**< the next position in recent_latencies */
+  guint recent_num;             /**< the number of valid recent latencies */
+  gint64 recent_total;          /**< the sum of the recent latencies */
+
+  gint64 samples[GST_TF_STAT_NUM]; /**< latency samples of the current invoke (usec, -1: none) */
+  GstClock *clock;              /**< the clock cached when going to PLAYING, for the queueing delay */
+  GstClockTime base_time;       /**< the base time cached with the clock */
+
+  GMutex lock;                  /**< protects the histograms */
+  GstTensorFilterHistogram *hist; /**< latency histograms, GST_TF_STAT_NUM entries */
 } GstTensorFilterStatistics;
 
+/**
+ * @brief Structure definition for the cpu set and the memory policy of a thread.
+ */
+typedef struct _GstTensorFilterAffinity
+{
+  gboolean has_cpus; /**< True if the cpu set is given */
+  gulong cpus[128 / sizeof (gulong)]; /**< The cpu set (cpu_set_t) */
+  gboolean has_mempolicy; /**< True if the memory policy is given */
+  gint mempolicy_mode; /**< The mode of the memory policy */
+  gulong mempolicy_nodes[4]; /**< The node mask of the memory policy */
+} GstTensorFilterAffinity;
+
 /**
  * @brief Structure definition for tensor-filter in/out combination
  */
@@ -130,6 +200,17 @@ typedef struct _GstTensorFilterPrivate
 
   gint latency_mode;     /**< latency profiling mode (0: off, 1: on, ...) */
   gint throughput_mode;  /**< throughput profiling mode (0: off, 1: on, ...) */
+  guint latency_report;  /**< interval to post the latency histograms to the bus (msec, 0: off) */
+  guint warmup;          /**< number of dummy invokes after opening the framework */
+  gboolean warmup_done;  /**< TRUE if the warm-up invokes are done for the opened framework */
+  GMutex affinity_lock; /**< protects the affinity and the pinned thread */
+  GstTensorFilterAffinity affinity; /**< the cpu set and the memory policy from cpu-affinity and numa-node */
+  gint affinity_updates; /**< the number of updates of the affinity, the serial of the next one */
+  gint affinity_serial; /**< (atomic) the serial of the affinity, 0 if no affinity is given */
+  gpointer affinity_thread; /**< (atomic) the thread pinned by invoke */
+  gint affinity_thread_serial; /**< (atomic) the serial of the affinity the thread is pinned with */
+  gint affinity_tid; /**< the kernel id of the pinned thread */
+  GstTensorFilterAffinity affinity_saved; /**< the affinity of the pinned thread before pinning */
 
   GstTensorFilterCombination combi;
 } GstTensorFilterPrivate;
@@ -161,6 +242,53 @@ gst_tensorsinfo_compare_print (const GstTensorsInfo * info1,
 extern gboolean
 gst_tensor_filter_allocate_in_invoke (GstTensorFilterPrivate * priv);
 
+/**
+ * @brief check if the framework and the opened model allow in-place invoke (output tensors over input tensors)
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if in-place invoke is allowed
+ */
+extern gboolean
+gst_tensor_filter_allow_in_place (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief check if the custom filter opened with private_data allows in-place invoke (NNStreamer_custom_allow_in_place)
+ * @note Internal for the in-tree V0 framework "custom", which is not able to describe the model-dependent in-place with the V0 interface.
+ */
+extern gboolean
+custom_filter_allow_in_place (void *private_data);
+
+/**
+ * @brief check if the custom-easy model opened with private_data allows in-place invoke (NNS_custom_easy_register_in_place)
+ * @note Internal for the in-tree V0 framework "custom-easy", which is not able to describe the model-dependent in-place with the V0 interface.
+ */
+extern gboolean
+custom_easy_filter_allow_in_place (void *private_data);
+
+/**
+ * @brief Pin the calling thread to the cpus of cpu-affinity or numa-node, and prefer the memory of numa-node.
+ * @param[in] priv Struct containing the properties of the object
+ * @note The streaming thread is pinned once, on its first invoke. It is restored when another thread invokes, or when the framework is closed.
+ */
+extern void
+gst_tensor_filter_common_pin_affinity (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Add the latency samples of an invoke to the histograms of all stages.
+ * @param[in] stat The statistics of tensor-filter
+ * @param[in] samples The latency of each stage in microseconds, a negative value skips the stage
+ */
+extern void
+gst_tensor_filter_statistics_add (GstTensorFilterStatistics * stat,
+    const gint64 samples[GST_TF_STAT_NUM]);
+
+/**
+ * @brief Get the latency percentiles of all stages.
+ * @param[in] stat The statistics of tensor-filter
+ * @return Newly allocated structure "tensor-filter-latency". Caller should free it.
+ */
+extern GstStructure *
+gst_tensor_filter_statistics_get_latency (GstTensorFilterStatistics * stat);
+
 /**
  * @brief Installs all the properties for tensor_filter
  * @param[in] gobject_class Glib object class whose properties will be set
@@ -241,6 +369,15 @@ extern void gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv);
  */
 extern void gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv);
 
+/**
+ * @brief Run the warm-up invokes with zero-filled input tensors.
+ * @param[in] priv Struct containing the properties of the object
+ * @return FALSE if the subplugin has failed to invoke. TRUE if done or skipped.
+ * @note Skipped if the warm-up is disabled or the tensor info is not configured yet.
+ */
+extern gboolean
+gst_tensor_filter_common_warmup (GstTensorFilterPrivate * priv);
+
 /**
  * @brief Get neural network framework name from given model file. This does not guarantee the framework is available on the target device.
  * @param[in] model_files the prediction model paths
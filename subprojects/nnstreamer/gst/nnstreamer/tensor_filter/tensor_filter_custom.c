@@ -31,6 +31,7 @@
 #include <gmodule.h>
 
 #include "tensor_filter_custom.h"
+#include "tensor_filter_common.h"
 #include "nnstreamer_plugin_api_filter.h"
 #include "nnstreamer_conf.h"
 #include <nnstreamer_log.h>
@@ -51,6 +52,7 @@ struct _internal_data
 {
   GModule *module;
   NNStreamer_custom_class *methods;
+  gboolean allow_in_place; /**< NNStreamer_custom_allow_in_place of the custom filter */
 
   void *customFW_private_data;
 };
@@ -64,7 +66,7 @@ static int
 custom_loadlib (const GstTensorFilterProperties * prop, void **private_data)
 {
   internal_data *ptr;
-  gpointer custom_cls;
+  gpointer custom_cls, in_place;
 
   if (*private_data != NULL) {
     /** @todo : Check the integrity of filter->data and filter->model_file, nnfw */
@@ -111,6 +113,11 @@ custom_loadlib (const GstTensorFilterProperties * prop, void **private_data)
 
   ptr->methods = *(NNStreamer_custom_class **) custom_cls;
 
+  /* optional, in-place invoke is not allowed without the symbol */
+  if (g_module_symbol (ptr->module, "NNStreamer_custom_allow_in_place",
+          &in_place) && in_place != NULL)
+    ptr->allow_in_place = (*(int *) in_place != 0);
+
   if (NULL == ptr->methods->initfunc) {
     ml_loge ("tensor_filter_custom (%s) requires a valid 'initfunc'.",
         prop->model_files[0]);
@@ -291,6 +298,17 @@ custom_allocateInInvoke (void **private_data)
   return -EINVAL;
 }
 
+/**
+ * @brief check if the custom filter opened with private_data allows in-place invoke (NNStreamer_custom_allow_in_place)
+ */
+gboolean
+custom_filter_allow_in_place (void *private_data)
+{
+  internal_data *ptr = private_data;
+
+  return (ptr && ptr->methods->invoke && ptr->allow_in_place);
+}
+
 /**
  * @brief Check support of the backend
  */
@@ -308,7 +326,7 @@ static gchar filter_subplugin_custom[] = "custom";
 static GstTensorFilterFramework NNS_support_custom = {
   .version = GST_TENSOR_FILTER_FRAMEWORK_V0,
   .name = filter_subplugin_custom,
-  .allow_in_place = FALSE,      /* custom cannot support in-place (output == input). */
+  .allow_in_place = FALSE,      /* not for V0. tensor_filter checks NNStreamer_custom_allow_in_place with custom_filter_allow_in_place. */
   .allocate_in_invoke = TRUE,   /* GstTensorFilter allocates output buffers */
   .run_without_model = FALSE,   /* custom needs a so file */
   .invoke_NN = custom_invoke,
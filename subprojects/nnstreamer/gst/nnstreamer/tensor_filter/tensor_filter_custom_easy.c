@@ -29,6 +29,7 @@
 #include <nnstreamer_plugin_api_util.h>
 #include <nnstreamer_subplugin.h>
 #include <nnstreamer_util.h>
+#include "tensor_filter_common.h"
 
 void init_filter_custom_easy (void) __attribute__((constructor));
 void fini_filter_custom_easy (void) __attribute__((destructor));
@@ -42,6 +43,7 @@ typedef struct _internal_data
   GstTensorsInfo in_info;
   GstTensorsInfo out_info;
   void *data; /**< The easy-filter writer's data */
+  int allow_in_place; /**< func can write output tensors over input tensors */
 } internal_data;
 
 /**
@@ -66,13 +68,14 @@ custom_free_internal_data (internal_data * data)
 }
 
 /**
- * @brief Register the custom-easy tensor function. More info in .h
+ * @brief Internal function to register the custom-easy tensor function.
  * @return 0 if success. -ERRNO if error.
  */
-int
-NNS_custom_easy_register (const char *modelname,
+static int
+custom_easy_register (const char *modelname,
     NNS_custom_invoke func, void *data,
-    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info,
+    int allow_in_place)
 {
   internal_data *ptr;
 
@@ -90,6 +93,7 @@ NNS_custom_easy_register (const char *modelname,
 
   ptr->func = func;
   ptr->data = data;
+  ptr->allow_in_place = allow_in_place;
   gst_tensors_info_copy (&ptr->in_info, in_info);
   gst_tensors_info_copy (&ptr->out_info, out_info);
 
@@ -100,6 +104,32 @@ NNS_custom_easy_register (const char *modelname,
   return -EINVAL;
 }
 
+/**
+ * @brief Register the custom-easy tensor function. More info in .h
+ * @return 0 if success. -ERRNO if error.
+ */
+int
+NNS_custom_easy_register (const char *modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+{
+  return custom_easy_register (modelname, func, data, in_info, out_info,
+      FALSE);
+}
+
+/**
+ * @brief Register the custom-easy tensor function which can run in-place. More info in .h
+ * @return 0 if success. -ERRNO if error.
+ */
+int
+NNS_custom_easy_register_in_place (const char *modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+{
+  return custom_easy_register (modelname, func, data, in_info, out_info,
+      TRUE);
+}
+
 /**
  * @brief Unregister the custom-easy tensor function.
  * @return 0 if success. -EINVAL if invalid model name.
@@ -225,11 +255,22 @@ custom_close (const GstTensorFilterProperties * prop, void **private_data)
   *private_data = NULL;
 }
 
+/**
+ * @brief check if the custom-easy model opened with private_data allows in-place invoke (NNS_custom_easy_register_in_place)
+ */
+gboolean
+custom_easy_filter_allow_in_place (void *private_data)
+{
+  runtime_data *rd = private_data;
+
+  return (rd && rd->model && rd->model->allow_in_place);
+}
+
 static char name_str[] = "custom-easy";
 static GstTensorFilterFramework NNS_support_custom_easy = {
   .version = GST_TENSOR_FILTER_FRAMEWORK_V0,
   .name = name_str,
-  .allow_in_place = FALSE,      /* custom cannot support in-place. */
+  .allow_in_place = FALSE,      /* not for V0. tensor_filter checks NNS_custom_easy_register_in_place with custom_easy_filter_allow_in_place. */
   .allocate_in_invoke = FALSE,  /* we allocate output buffers for you. */
   .run_without_model = FALSE,   /* we need a func to run. */
   .invoke_NN = custom_invoke,
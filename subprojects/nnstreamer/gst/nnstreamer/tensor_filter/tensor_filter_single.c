@@ -53,8 +53,30 @@ typedef struct _GTensorFilterSinglePrivate
 {
   GstTensorFilterPrivate filter_priv; /**< Internal properties for tensor-filter */
   gboolean allocate_in_invoke;  /**< cached value after first invoke */
+
+  GMutex lock; /**< Lock for the output cache */
+  gpointer out_cache; /**< Released output block, reused by the next zero-copy invoke */
+  gsize out_cache_size; /**< Size of the cached output block */
 } GTensorFilterSinglePrivate;
 
+/**
+ * @brief Output memory handed over to the caller by zero-copy or batched invoke.
+ */
+typedef struct _GTensorFilterSingleOutput
+{
+  GTensorFilterSingle *self; /**< Reference of the filter owning the memory */
+  guint num_sets; /**< The number of output sets */
+  guint num_tensors; /**< The number of tensors in an output set */
+  gpointer block; /**< Output block allocated by tensor_filter_single (NULL if the framework allocates in invoke) */
+  gsize block_size; /**< Size of the output block */
+  gpointer *fw_data; /**< Output data allocated by the framework in invoke */
+} GTensorFilterSingleOutput;
+
+/**
+ * @brief Align the offset of each tensor in an output block.
+ */
+#define G_TENSOR_FILTER_SINGLE_ALIGN(s) (((s) + 15U) & ~((gsize) 15U))
+
 #define G_TENSOR_FILTER_SINGLE_PRIV(obj) ((GTensorFilterSinglePrivate *) (obj)->priv)
 
 #define g_tensor_filter_single_parent_class parent_class
@@ -80,6 +102,12 @@ static void g_tensor_filter_destroy_notify (GTensorFilterSingle * self,
 static gboolean g_tensor_filter_allocate_in_invoke (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_single_start (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_single_stop (GTensorFilterSingle * self);
+static gboolean g_tensor_filter_single_invoke_zero_copy (GTensorFilterSingle *
+    self, const GstTensorMemory * input, GstTensorMemory * output,
+    GDestroyNotify * release, gpointer * release_data);
+static gboolean g_tensor_filter_single_invoke_batch (GTensorFilterSingle * self,
+    guint num_sets, const GstTensorMemory * input, GstTensorMemory * output,
+    GDestroyNotify * release, gpointer * release_data);
 
 /**
  * @brief initialize the tensor_filter's class
@@ -105,6 +133,8 @@ g_tensor_filter_single_class_init (GTensorFilterSingleClass * klass)
   klass->set_input_info = g_tensor_filter_set_input_info;
   klass->destroy_notify = g_tensor_filter_destroy_notify;
   klass->allocate_in_invoke = g_tensor_filter_allocate_in_invoke;
+  klass->invoke_zero_copy = g_tensor_filter_single_invoke_zero_copy;
+  klass->invoke_batch = g_tensor_filter_single_invoke_batch;
 }
 
 /**
@@ -123,6 +153,10 @@ g_tensor_filter_single_init (GTensorFilterSingle * self)
 
   gst_tensor_filter_common_init_property (priv);
   spriv->allocate_in_invoke = FALSE;
+
+  g_mutex_init (&spriv->lock);
+  spriv->out_cache = NULL;
+  spriv->out_cache_size = 0;
 }
 
 /**
@@ -146,6 +180,10 @@ g_tensor_filter_single_finalize (GObject * object)
 
   gst_tensor_filter_common_free_property (priv);
 
+  g_free (spriv->out_cache);
+  spriv->out_cache = NULL;
+  g_mutex_clear (&spriv->lock);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -261,6 +299,7 @@ g_tensor_filter_single_start (GTensorFilterSingle * self)
 
   gst_tensor_filter_load_tensor_info (priv);
   spriv->allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  gst_tensor_filter_common_warmup (priv);
 
   priv->configured = TRUE;
 
@@ -343,8 +382,8 @@ g_tensor_filter_single_invoke (GTensorFilterSingle * self,
   if (spriv->allocate_in_invoke) {
     if (!allocate) {
       /**
-       * @todo how can we remove memcpy if output data is already allocated
-       * single-shot should fill the output data, but sub-plugin allocates new memory.
+       * Single-shot should fill the output data, but sub-plugin allocates new memory.
+       * Use invoke_zero_copy or invoke_batch to get the output without memcpy.
        */
       _out = out_tensors;
 
@@ -388,6 +427,274 @@ error:
   return FALSE;
 }
 
+/**
+ * @brief Get an output block of given size, reusing the released one if possible.
+ */
+static gpointer
+g_tensor_filter_single_acquire_block (GTensorFilterSinglePrivate * spriv,
+    gsize size)
+{
+  gpointer block = NULL;
+
+  g_mutex_lock (&spriv->lock);
+  if (spriv->out_cache && spriv->out_cache_size == size) {
+    block = spriv->out_cache;
+    spriv->out_cache = NULL;
+    spriv->out_cache_size = 0;
+  }
+  g_mutex_unlock (&spriv->lock);
+
+  if (!block)
+    block = g_try_malloc (size);
+
+  return block;
+}
+
+/**
+ * @brief Return an output block, keep it for the next invoke if the cache is empty.
+ */
+static void
+g_tensor_filter_single_return_block (GTensorFilterSinglePrivate * spriv,
+    gpointer block, gsize size)
+{
+  gpointer old = block;
+
+  g_mutex_lock (&spriv->lock);
+  if (!spriv->out_cache || spriv->out_cache_size != size) {
+    old = spriv->out_cache;
+    spriv->out_cache = block;
+    spriv->out_cache_size = size;
+  }
+  g_mutex_unlock (&spriv->lock);
+
+  g_free (old);
+}
+
+/**
+ * @brief Release the output memory handed over by zero-copy or batched invoke.
+ * @param data The output handle (GTensorFilterSingleOutput)
+ */
+static void
+g_tensor_filter_single_release (gpointer data)
+{
+  GTensorFilterSingleOutput *handle = (GTensorFilterSingleOutput *) data;
+  GTensorFilterSinglePrivate *spriv;
+  guint i;
+
+  if (!handle)
+    return;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (handle->self);
+
+  if (handle->block) {
+    g_tensor_filter_single_return_block (spriv, handle->block,
+        handle->block_size);
+  } else {
+    for (i = 0; i < handle->num_sets * handle->num_tensors; i++) {
+      if (handle->fw_data[i])
+        gst_tensor_filter_destroy_notify_util (&spriv->filter_priv,
+            handle->fw_data[i]);
+    }
+  }
+
+  g_object_unref (handle->self);
+  g_free (handle);
+}
+
+/**
+ * @brief Create the output handle and allocate the output block if needed.
+ * @return The output handle, NULL if failed to allocate the output.
+ */
+static GTensorFilterSingleOutput *
+g_tensor_filter_single_prepare_output (GTensorFilterSingle * self,
+    guint num_sets, GstTensorMemory * output)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  GTensorFilterSingleOutput *handle;
+  guint s, i, num_tensors;
+  gsize size, offset;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+  num_tensors = priv->prop.output_meta.num_tensors;
+
+  handle = (GTensorFilterSingleOutput *) g_malloc0 (sizeof
+      (GTensorFilterSingleOutput) + num_sets * num_tensors * sizeof (gpointer));
+  handle->self = g_object_ref (self);
+  handle->num_sets = num_sets;
+  handle->num_tensors = num_tensors;
+  handle->fw_data = (gpointer *) (handle + 1);
+
+  /* the output size is given by the model, not by the caller */
+  size = 0;
+  for (i = 0; i < num_tensors; i++) {
+    output[i].size = gst_tensor_info_get_size (&priv->prop.output_meta.info[i]);
+    size += G_TENSOR_FILTER_SINGLE_ALIGN (output[i].size);
+  }
+
+  for (s = 1; s < num_sets; s++) {
+    for (i = 0; i < num_tensors; i++)
+      output[s * num_tensors + i].size = output[i].size;
+  }
+
+  if (spriv->allocate_in_invoke)
+    return handle;
+
+  /* a single block for all sets, recycled when the caller releases it */
+  handle->block_size = size * num_sets;
+  handle->block = g_tensor_filter_single_acquire_block (spriv,
+      handle->block_size);
+  if (!handle->block) {
+    g_critical ("Failed to allocate the output tensor.");
+    handle->block_size = 0;
+    g_tensor_filter_single_release (handle);
+    return NULL;
+  }
+
+  offset = 0;
+  for (s = 0; s < num_sets; s++) {
+    for (i = 0; i < num_tensors; i++) {
+      output[s * num_tensors + i].data = (guint8 *) handle->block + offset;
+      offset += G_TENSOR_FILTER_SINGLE_ALIGN (output[i].size);
+    }
+  }
+
+  return handle;
+}
+
+/**
+ * @brief Called to invoke the filter with several input sets
+ * @param self "this" pointer
+ * @param num_sets the number of input (and output) sets
+ * @param input memory containing input data, num_sets sets of input tensors
+ * @param output memory to put output data into, num_sets sets of output tensors
+ * @param release callback to release the output, NULL if the caller allocated the output
+ * @param release_data data to be passed to release
+ * @return TRUE if there is no error.
+ */
+static gboolean
+g_tensor_filter_single_invoke_batch (GTensorFilterSingle * self,
+    guint num_sets, const GstTensorMemory * input, GstTensorMemory * output,
+    GDestroyNotify * release, gpointer * release_data)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  GTensorFilterSingleOutput *handle = NULL;
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory *_out, *out;
+  guint s, i, num_in, num_out;
+  gint status;
+
+  if (num_sets == 0 || !input || !output) {
+    g_critical ("Invalid input or output to invoke the filter.");
+    return FALSE;
+  }
+
+  if (release && !release_data) {
+    g_critical ("The release data is required to hand over the output.");
+    return FALSE;
+  }
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  /** start if not already started */
+  if (!priv->configured) {
+    if (!g_tensor_filter_single_start (self)) {
+      return FALSE;
+    }
+  }
+
+  num_in = priv->prop.input_meta.num_tensors;
+  num_out = priv->prop.output_meta.num_tensors;
+
+  if (release) {
+    handle = g_tensor_filter_single_prepare_output (self, num_sets, output);
+    if (!handle)
+      return FALSE;
+  }
+
+  /**
+   * Sub-plugins do not provide batched invoke; run the sets back to back
+   * with the framework opened and the output allocated once.
+   */
+  for (s = 0; s < num_sets; s++) {
+    out = output + s * num_out;
+    _out = out;
+
+    if (spriv->allocate_in_invoke) {
+      _out = out_tensors;
+
+      for (i = 0; i < num_out; i++) {
+        out_tensors[i].data = NULL;
+        out_tensors[i].size = out[i].size;
+      }
+    }
+
+    GST_TF_FW_INVOKE_COMPAT (priv, status, input + s * num_in, _out);
+    if (status != 0)
+      goto error;
+
+    if (_out != out) {
+      if (handle) {
+        /* hand over the memory allocated by the sub-plugin */
+        for (i = 0; i < num_out; i++) {
+          out[i].data = _out[i].data;
+          handle->fw_data[s * num_out + i] = _out[i].data;
+        }
+      } else {
+        for (i = 0; i < num_out; i++)
+          memcpy (out[i].data, _out[i].data, out[i].size);
+
+        g_tensor_filter_destroy_notify (self, _out);
+      }
+    }
+  }
+
+  if (handle) {
+    *release = g_tensor_filter_single_release;
+    *release_data = handle;
+  }
+
+  return TRUE;
+
+error:
+  g_critical ("Failed to invoke the model (set %u of %u).", s + 1, num_sets);
+
+  if (handle) {
+    g_tensor_filter_single_release (handle);
+
+    for (i = 0; i < num_sets * num_out; i++)
+      output[i].data = NULL;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Called to invoke the filter and hand the output over without memcpy
+ * @param self "this" pointer
+ * @param input memory containing input data to run processing on
+ * @param output memory to be filled with the output data after processing
+ * @param release callback to release the output
+ * @param release_data data to be passed to release
+ * @return TRUE if there is no error.
+ */
+static gboolean
+g_tensor_filter_single_invoke_zero_copy (GTensorFilterSingle * self,
+    const GstTensorMemory * input, GstTensorMemory * output,
+    GDestroyNotify * release, gpointer * release_data)
+{
+  if (!release) {
+    g_critical ("The release callback is required to hand over the output.");
+    return FALSE;
+  }
+
+  return g_tensor_filter_single_invoke_batch (self, 1, input, output, release,
+      release_data);
+}
+
 /**
  * @brief Set input tensor information in the framework
  * @param self "this" pointer
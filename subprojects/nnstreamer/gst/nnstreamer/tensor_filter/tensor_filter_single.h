@@ -81,6 +81,23 @@ struct _GTensorFilterSingleClass
   gboolean (*allocate_in_invoke) (GTensorFilterSingle * self);
   /** Free the data allocated by the tensor filter in invoke */
   void (*destroy_notify) (GTensorFilterSingle * self, GstTensorMemory * mem);
+  /**
+   * Invoke the filter and hand the output memory over without copying.
+   * The caller owns the output until it calls release (release_data),
+   * which must happen before the filter is stopped.
+   */
+  gboolean (*invoke_zero_copy) (GTensorFilterSingle * self,
+      const GstTensorMemory * input, GstTensorMemory * output,
+      GDestroyNotify * release, gpointer * release_data);
+  /**
+   * Invoke the filter with num_sets input sets in one call.
+   * Input and output are arrays of num_sets sets of tensors, laid out set by set.
+   * If release is NULL, the output data must be allocated by the caller.
+   * Otherwise the output is handed over as in invoke_zero_copy.
+   */
+  gboolean (*invoke_batch) (GTensorFilterSingle * self, guint num_sets,
+      const GstTensorMemory * input, GstTensorMemory * output,
+      GDestroyNotify * release, gpointer * release_data);
 };
 
 /**
@@ -69,6 +69,7 @@
 #endif
 
 #include <nnstreamer_log.h>
+#include <math.h>
 #include <string.h>
 
 #include <nnstreamer_subplugin.h>
@@ -97,6 +98,7 @@ enum
   PROP_THEN_OPTION, /**< Option for TRUE Action */
   PROP_ELSE, /**< Action if it is FALSE */
   PROP_ELSE_OPTION, /**< Option for FALSE Action */
+  PROP_CV_THRESHOLD, /**< Threshold for TENSOR_COUNT_ABOVE */
 };
 
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_if_debug);
@@ -149,9 +151,25 @@ gst_tensor_if_cv_get_type (void)
   if (mode_type == 0) {
     static GEnumValue mode_types[] = {
       {TIFCV_A_VALUE, "A_VALUE", "Decide based on a single scalar value"},
+      {TIFCV_TENSOR_TOTAL_VALUE, "TENSOR_TOTAL_VALUE",
+          "Decide based on a total (sum) value of a specific tensor"},
       {TIFCV_TENSOR_AVERAGE_VALUE, "TENSOR_AVERAGE_VALUE",
           "Decide based on a average value of a specific tensor"},
       {TIFCV_CUSTOM, "CUSTOM", "Decide based on a user defined callback"},
+      {TIFCV_TENSOR_MAX_VALUE, "TENSOR_MAX_VALUE",
+          "Decide based on the max value of a specific tensor"},
+      {TIFCV_TENSOR_MIN_VALUE, "TENSOR_MIN_VALUE",
+          "Decide based on the min value of a specific tensor"},
+      {TIFCV_TENSOR_L1_NORM, "TENSOR_L1_NORM",
+          "Decide based on the L1 norm of a specific tensor"},
+      {TIFCV_TENSOR_L2_NORM, "TENSOR_L2_NORM",
+          "Decide based on the L2 norm of a specific tensor"},
+      {TIFCV_TENSOR_COUNT_ABOVE, "TENSOR_COUNT_ABOVE",
+          "Decide based on the number of elements greater than the threshold"},
+      {TIFCV_TENSOR_ARGMAX, "TENSOR_ARGMAX",
+          "Decide based on the index of the max value of a specific tensor"},
+      {TIFCV_TENSOR_DELTA_VALUE, "TENSOR_DELTA_VALUE",
+          "Decide based on the mean absolute difference from the previous frame"},
       {0, NULL, NULL},
     };
     mode_type = g_enum_register_static ("tensor_if_compared_value", mode_types);
@@ -279,6 +297,9 @@ gst_tensor_if_init (GstTensorIf * tensor_if)
   memset (tensor_if->sv, 0, sizeof (tensor_if_sv_s) * 2);
   memset (&tensor_if->custom, 0, sizeof (custom_cb_s));
   tensor_if->custom_configured = FALSE;
+  tensor_if->cv_threshold = 0.0;
+  tensor_if->prev_data = NULL;
+  tensor_if->prev_size = 0;
 
   g_mutex_init (&tensor_if->lock);
 }
@@ -317,6 +338,9 @@ gst_tensor_if_dispose (GObject * object)
   tensor_if->custom.func = NULL;
   tensor_if->custom.data = NULL;
   tensor_if->custom_configured = FALSE;
+  g_free (tensor_if->prev_data);
+  tensor_if->prev_data = NULL;
+  tensor_if->prev_size = 0;
 
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
@@ -439,6 +463,9 @@ gst_tensor_if_set_property (GObject * object, guint prop_id,
     case PROP_ELSE_OPTION:
       gst_tensor_if_set_property_glist (value, &self->else_option, ",");
       break;
+    case PROP_CV_THRESHOLD:
+      self->cv_threshold = g_value_get_double (value);
+      break;
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
@@ -473,7 +500,15 @@ gst_tensor_if_property_to_string (GValue * value, GList * prop_list,
   g_ptr_array_add (arr, NULL);
   strings = (gchar **) g_ptr_array_free (arr, FALSE);
   len = g_strv_length (strings);
-  if (prop_id == PROP_CV_OPTION && len % 5 == 0) {
+  if (prop_id == PROP_CV_OPTION && len == 9) {
+    gchar *start =
+        g_strjoin (":", strings[0], strings[1], strings[2], strings[3], NULL);
+    gchar *size =
+        g_strjoin (":", strings[4], strings[5], strings[6], strings[7], NULL);
+    p = g_strjoin (",", start, size, strings[8], NULL);
+    g_free (start);
+    g_free (size);
+  } else if (prop_id == PROP_CV_OPTION && len % 5 == 0) {
     gchar *dim =
         g_strjoin (":", strings[0], strings[1], strings[2], strings[3], NULL);
     p = g_strjoin (",", dim, strings[4], NULL);
@@ -556,6 +591,9 @@ gst_tensor_if_get_property (GObject * object, guint prop_id,
     case PROP_ELSE_OPTION:
       gst_tensor_if_property_to_string (value, self->else_option, prop_id);
       break;
+    case PROP_CV_THRESHOLD:
+      g_value_set_double (value, self->cv_threshold);
+      break;
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
@@ -586,6 +624,12 @@ gst_tensor_if_install_properties (GObjectClass * gobject_class)
           "Specify an element of the nth tensor or pick tensor ", "",
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_CV_THRESHOLD,
+      g_param_spec_double ("compared-value-threshold", "CV_THRESHOLD",
+          "Threshold of the elements counted by TENSOR_COUNT_ABOVE",
+          -G_MAXDOUBLE, G_MAXDOUBLE, 0.0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   g_object_class_install_property (gobject_class, PROP_SV,
       g_param_spec_string ("supplied-value", "SV",
           " Supplied Value by user ", "",
@@ -652,6 +696,10 @@ gst_tensor_if_event (GstPad * pad, GstObject * parent, GstEvent * event)
         GST_ERROR_OBJECT (tensor_if, "Failed to parse caps.\n");
         return FALSE;
       }
+      /* the previous frame is not comparable after the caps is changed */
+      g_free (tensor_if->prev_data);
+      tensor_if->prev_data = NULL;
+      tensor_if->prev_size = 0;
       break;
     }
     default:
@@ -786,6 +834,10 @@ gst_tensor_if_get_comparison_result (GstTensorIf * tensor_if,
   gboolean ret = FALSE;
   tensor_data_s svtc_1, svtc_2;
 
+  /* compare half precision values in float32 */
+  if (gst_tensor_data_is_half (cv->type))
+    gst_tensor_data_typecast (cv, _NNS_FLOAT32);
+
   svtc_1.type = tensor_if->sv->type;
   svtc_1.data = tensor_if->sv->data[0];
   gst_tensor_data_typecast (&svtc_1, cv->type);
@@ -872,6 +924,369 @@ gst_tensor_if_get_tensor_average (GstTensorIf * tensor_if,
   return TRUE;
 }
 
+/**
+ * @brief Internal data structure to accumulate a reduction over the rows
+ */
+typedef struct
+{
+  gdouble value; /**< accumulated value */
+  guint64 index; /**< index of the max value (argmax) */
+  guint64 num; /**< the number of elements reduced */
+} tensor_if_reduce_s;
+
+/**
+ * @brief Function to reduce a contiguous run of elements
+ */
+typedef void (*tensor_if_reduce_row) (tensor_if_compared_value cv,
+    const void *data, const void *prev, gsize n, gdouble threshold,
+    tensor_if_reduce_s * r);
+
+#define tif_abs(v) (((v) < 0) ? -(v) : (v))
+
+/**
+ * @brief Macro to define a reduction function for the given element type.
+ * @details Each case is a plain loop over a contiguous run of elements with
+ *          an integer accumulator for the narrow integer types, so that the
+ *          compiler can auto-vectorize it.
+ */
+#define tif_define_reduce_row(T,ACC_T) \
+static void \
+tif_reduce_row_##T (tensor_if_compared_value cv, const void * data, \
+    const void * prev, gsize n, gdouble threshold, tensor_if_reduce_s * r) \
+{ \
+  const T *row = (const T *) data; \
+  const T *old = (const T *) prev; \
+  ACC_T acc = 0; \
+  guint64 cnt = 0; \
+  gsize i, mi = 0; \
+  T m; \
+  switch (cv) { \
+    case TIFCV_TENSOR_TOTAL_VALUE: \
+      for (i = 0; i < n; i++) \
+        acc += (ACC_T) row[i]; \
+      r->value += (gdouble) acc; \
+      break; \
+    case TIFCV_TENSOR_MAX_VALUE: \
+      m = row[0]; \
+      for (i = 1; i < n; i++) \
+        m = (row[i] > m) ? row[i] : m; \
+      if (r->num == 0 || (gdouble) m > r->value) \
+        r->value = (gdouble) m; \
+      break; \
+    case TIFCV_TENSOR_MIN_VALUE: \
+      m = row[0]; \
+      for (i = 1; i < n; i++) \
+        m = (row[i] < m) ? row[i] : m; \
+      if (r->num == 0 || (gdouble) m < r->value) \
+        r->value = (gdouble) m; \
+      break; \
+    case TIFCV_TENSOR_L1_NORM: \
+      for (i = 0; i < n; i++) \
+        acc += tif_abs ((ACC_T) row[i]); \
+      r->value += (gdouble) acc; \
+      break; \
+    case TIFCV_TENSOR_L2_NORM: \
+      for (i = 0; i < n; i++) \
+        acc += (ACC_T) row[i] * (ACC_T) row[i]; \
+      r->value += (gdouble) acc; \
+      break; \
+    case TIFCV_TENSOR_COUNT_ABOVE: \
+      for (i = 0; i < n; i++) \
+        cnt += ((gdouble) row[i] > threshold) ? 1 : 0; \
+      r->value += (gdouble) cnt; \
+      break; \
+    case TIFCV_TENSOR_ARGMAX: \
+      m = row[0]; \
+      for (i = 1; i < n; i++) { \
+        if (row[i] > m) { \
+          m = row[i]; \
+          mi = i; \
+        } \
+      } \
+      if (r->num == 0 || (gdouble) m > r->value) { \
+        r->value = (gdouble) m; \
+        r->index = r->num + mi; \
+      } \
+      break; \
+    case TIFCV_TENSOR_DELTA_VALUE: \
+      if (old) { \
+        for (i = 0; i < n; i++) \
+          acc += tif_abs ((ACC_T) row[i] - (ACC_T) old[i]); \
+      } else { \
+        for (i = 0; i < n; i++) \
+          acc += tif_abs ((ACC_T) row[i]); \
+      } \
+      r->value += (gdouble) acc; \
+      break; \
+    default: \
+      break; \
+  } \
+  r->num += n; \
+}
+
+tif_define_reduce_row (int32_t, gdouble)
+tif_define_reduce_row (uint32_t, gdouble)
+tif_define_reduce_row (int16_t, gint64)
+tif_define_reduce_row (uint16_t, gint64)
+tif_define_reduce_row (int8_t, gint64)
+tif_define_reduce_row (uint8_t, gint64)
+tif_define_reduce_row (double, gdouble)
+tif_define_reduce_row (float, gdouble)
+tif_define_reduce_row (int64_t, gdouble)
+tif_define_reduce_row (uint64_t, gdouble)
+
+/**
+ * @brief The number of half precision elements widened to float32 at a time.
+ */
+#define TIF_HALF_CHUNK 256
+
+/**
+ * @brief Reduction function for half precision, widens each chunk to float32.
+ * @note The float32 reducer keeps r->num, so that max/min and argmax are
+ *       consistent across the chunks.
+ */
+static void
+tif_reduce_row_half (tensor_type type, tensor_if_compared_value cv,
+    const void *data, const void *prev, gsize n, gdouble threshold,
+    tensor_if_reduce_s * r)
+{
+  const guint16 *row = (const guint16 *) data;
+  const guint16 *old = (const guint16 *) prev;
+  gfloat row_f[TIF_HALF_CHUNK], old_f[TIF_HALF_CHUNK];
+  gsize i, len;
+
+  for (i = 0; i < n; i += len) {
+    len = MIN (n - i, TIF_HALF_CHUNK);
+
+    gst_tensor_data_raw_half_to_float (row + i, type, row_f, len);
+    if (old)
+      gst_tensor_data_raw_half_to_float (old + i, type, old_f, len);
+
+    tif_reduce_row_float (cv, row_f, old ? old_f : NULL, len, threshold, r);
+  }
+}
+
+/**
+ * @brief Reduction function for float16.
+ */
+static void
+tif_reduce_row_float16 (tensor_if_compared_value cv, const void *data,
+    const void *prev, gsize n, gdouble threshold, tensor_if_reduce_s * r)
+{
+  tif_reduce_row_half (_NNS_FLOAT16, cv, data, prev, n, threshold, r);
+}
+
+/**
+ * @brief Reduction function for bfloat16.
+ */
+static void
+tif_reduce_row_bfloat16 (tensor_if_compared_value cv, const void *data,
+    const void *prev, gsize n, gdouble threshold, tensor_if_reduce_s * r)
+{
+  tif_reduce_row_half (_NNS_BFLOAT16, cv, data, prev, n, threshold, r);
+}
+
+/**
+ * @brief Reduction functions, indexed by tensor_type.
+ */
+static const tensor_if_reduce_row tif_reduce_row_funcs[_NNS_END] = {
+  [_NNS_INT32] = tif_reduce_row_int32_t,
+  [_NNS_UINT32] = tif_reduce_row_uint32_t,
+  [_NNS_INT16] = tif_reduce_row_int16_t,
+  [_NNS_UINT16] = tif_reduce_row_uint16_t,
+  [_NNS_INT8] = tif_reduce_row_int8_t,
+  [_NNS_UINT8] = tif_reduce_row_uint8_t,
+  [_NNS_FLOAT64] = tif_reduce_row_double,
+  [_NNS_FLOAT32] = tif_reduce_row_float,
+  [_NNS_INT64] = tif_reduce_row_int64_t,
+  [_NNS_UINT64] = tif_reduce_row_uint64_t,
+  [_NNS_FLOAT16] = tif_reduce_row_float16,
+  [_NNS_BFLOAT16] = tif_reduce_row_bfloat16,
+};
+
+/**
+ * @brief Parse the compared-value-option for the reductions.
+ * @details The option is either "nth" (the whole tensor) or
+ *          "s0:s1:s2:s3,l0:l1:l2:l3,nth" (the region starting at [s0][s1][s2][s3]
+ *          whose size is [l0][l1][l2][l3]). The size 0 means until the end of
+ *          the dimension, e.g., "1:0:0:0,1:0:0:0,0" selects the 2nd channel.
+ */
+static gboolean
+gst_tensor_if_parse_region (GstTensorIf * tensor_if, GstBuffer * buf,
+    guint * nth, tensor_dim start, tensor_dim len)
+{
+  GList *list = tensor_if->cv_option;
+  const uint32_t *dim;
+  guint i, num = g_list_length (list);
+
+  if (num != 1 && num != (NNS_TENSOR_RANK_LIMIT * 2 + 1)) {
+    GST_ERROR_OBJECT (tensor_if,
+        "Please specify a proper 'compared-value-option' property, e.g., 0 or 0:0:0:0,1:0:0:0,0");
+    return FALSE;
+  }
+
+  memset (start, 0, sizeof (tensor_dim));
+  memset (len, 0, sizeof (tensor_dim));
+
+  if (num > 1) {
+    for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++, list = list->next)
+      start[i] = GPOINTER_TO_INT (list->data);
+    for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++, list = list->next)
+      len[i] = GPOINTER_TO_INT (list->data);
+  }
+
+  *nth = GPOINTER_TO_INT (list->data);
+  if (gst_buffer_n_memory (buf) <= *nth) {
+    GST_ERROR_OBJECT (tensor_if, "Index should be lower than buffer size");
+    return FALSE;
+  }
+
+  dim = tensor_if->in_config.info.info[*nth].dimension;
+  for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
+    if (start[i] >= dim[i]) {
+      GST_ERROR_OBJECT (tensor_if, "Invalid region start %u of dim %u",
+          start[i], i);
+      return FALSE;
+    }
+
+    if (len[i] == 0)
+      len[i] = dim[i] - start[i];
+
+    if (start[i] + len[i] > dim[i]) {
+      GST_ERROR_OBJECT (tensor_if, "Invalid region size %u of dim %u",
+          len[i], i);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Calculate the reduction (sum, max, min, norms, count, argmax, or delta) of the nth tensor
+ */
+static gboolean
+gst_tensor_if_get_tensor_reduction (GstTensorIf * tensor_if,
+    GstBuffer * buf, tensor_data_s * cv)
+{
+  GstMemory *in_mem;
+  GstMapInfo in_info;
+  tensor_if_reduce_s r = { 0.0, 0, 0 };
+  tensor_if_reduce_row reduce;
+  tensor_dim start, len, pos;
+  const uint32_t *dim;
+  const guint8 *prev = NULL;
+  gsize esize, run, offset, stride[NNS_TENSOR_RANK_LIMIT];
+  guint nth, i, k;
+  tensor_type type;
+  gdouble value;
+
+  if (!gst_tensor_if_parse_region (tensor_if, buf, &nth, start, len))
+    return FALSE;
+
+  type = tensor_if->in_config.info.info[nth].type;
+  dim = tensor_if->in_config.info.info[nth].dimension;
+  esize = gst_tensor_get_element_size (type);
+  reduce = (type < _NNS_END) ? tif_reduce_row_funcs[type] : NULL;
+
+  if (reduce == NULL) {
+    GST_ELEMENT_ERROR (tensor_if, STREAM, NOT_IMPLEMENTED, (NULL),
+        ("The compared value %d is not supported for the tensor type %s.",
+            tensor_if->cv, gst_tensor_get_type_string (type)));
+    return FALSE;
+  }
+
+  in_mem = gst_buffer_peek_memory (buf, nth);
+  if (!gst_memory_map (in_mem, &in_info, GST_MAP_READ)) {
+    GST_WARNING_OBJECT (tensor_if, "Failed to map the input buffer.");
+    return FALSE;
+  }
+
+  if (in_info.size <
+      gst_tensor_info_get_size (&tensor_if->in_config.info.info[nth])) {
+    GST_ERROR_OBJECT (tensor_if, "Invalid input buffer size %" G_GSIZE_FORMAT,
+        in_info.size);
+    gst_memory_unmap (in_mem, &in_info);
+    return FALSE;
+  }
+
+  if (tensor_if->cv == TIFCV_TENSOR_DELTA_VALUE &&
+      tensor_if->prev_size == in_info.size)
+    prev = tensor_if->prev_data;
+
+  stride[0] = 1;
+  for (i = 1; i < NNS_TENSOR_RANK_LIMIT; i++)
+    stride[i] = stride[i - 1] * dim[i - 1];
+
+  /* merge the inner dimensions fully covered by the region into a run */
+  run = len[0];
+  k = 1;
+  while (k < NNS_TENSOR_RANK_LIMIT && len[k - 1] == dim[k - 1]) {
+    run *= len[k];
+    k++;
+  }
+
+  memset (pos, 0, sizeof (tensor_dim));
+  do {
+    offset = start[0];
+    for (i = 1; i < NNS_TENSOR_RANK_LIMIT; i++)
+      offset += (start[i] + pos[i]) * stride[i];
+    offset *= esize;
+
+    reduce (tensor_if->cv, in_info.data + offset,
+        prev ? prev + offset : NULL, run, tensor_if->cv_threshold, &r);
+
+    /* move to the next run */
+    for (i = k; i < NNS_TENSOR_RANK_LIMIT; i++) {
+      if (++pos[i] < len[i])
+        break;
+      pos[i] = 0;
+    }
+  } while (i < NNS_TENSOR_RANK_LIMIT);
+
+  if (tensor_if->cv == TIFCV_TENSOR_DELTA_VALUE) {
+    /* cache the current frame for the next one */
+    if (tensor_if->prev_size != in_info.size) {
+      g_free (tensor_if->prev_data);
+      tensor_if->prev_data = g_malloc (in_info.size);
+      tensor_if->prev_size = in_info.size;
+    }
+    memcpy (tensor_if->prev_data, in_info.data, in_info.size);
+  }
+
+  gst_memory_unmap (in_mem, &in_info);
+
+  switch (tensor_if->cv) {
+    case TIFCV_TENSOR_MAX_VALUE:
+    case TIFCV_TENSOR_MIN_VALUE:
+      gst_tensor_data_set (cv, _NNS_FLOAT64, &r.value);
+      gst_tensor_data_typecast (cv, type);
+      break;
+    case TIFCV_TENSOR_COUNT_ABOVE:
+    {
+      guint64 count = (guint64) r.value;
+      gst_tensor_data_set (cv, _NNS_UINT64, &count);
+      break;
+    }
+    case TIFCV_TENSOR_ARGMAX:
+      gst_tensor_data_set (cv, _NNS_UINT64, &r.index);
+      break;
+    case TIFCV_TENSOR_L2_NORM:
+      value = sqrt (r.value);
+      gst_tensor_data_set (cv, _NNS_FLOAT64, &value);
+      break;
+    case TIFCV_TENSOR_DELTA_VALUE:
+      value = (r.num > 0) ? r.value / r.num : 0.0;
+      gst_tensor_data_set (cv, _NNS_FLOAT64, &value);
+      break;
+    default:
+      gst_tensor_data_set (cv, _NNS_FLOAT64, &r.value);
+      break;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Calculate compared value
  */
@@ -943,6 +1358,15 @@ gst_tensor_if_calculate_cv (GstTensorIf * tensor_if, GstBuffer * buf,
       }
       return gst_tensor_if_get_tensor_average (tensor_if, buf, cv, nth);
     }
+    case TIFCV_TENSOR_TOTAL_VALUE:
+    case TIFCV_TENSOR_MAX_VALUE:
+    case TIFCV_TENSOR_MIN_VALUE:
+    case TIFCV_TENSOR_L1_NORM:
+    case TIFCV_TENSOR_L2_NORM:
+    case TIFCV_TENSOR_COUNT_ABOVE:
+    case TIFCV_TENSOR_ARGMAX:
+    case TIFCV_TENSOR_DELTA_VALUE:
+      return gst_tensor_if_get_tensor_reduction (tensor_if, buf, cv);
     default:
       GST_ERROR_OBJECT (tensor_if,
           "Compared value is not supported yet or not defined");
@@ -51,6 +51,20 @@ typedef enum {
   TIFCV_ALL_TENSORS_AVERAGE_VALUE = 4,	/**< Decide based on a average value of
 					     tensors or a specific tensor */
   TIFCV_CUSTOM = 5,    /**< Decide based on a user defined condition */
+  TIFCV_TENSOR_MAX_VALUE = 6,	/**< Decide based on the max value of a
+				     specific tensor (or its region) */
+  TIFCV_TENSOR_MIN_VALUE = 7,	/**< Decide based on the min value of a
+				     specific tensor (or its region) */
+  TIFCV_TENSOR_L1_NORM = 8,	/**< Decide based on the L1 norm of a
+				     specific tensor (or its region) */
+  TIFCV_TENSOR_L2_NORM = 9,	/**< Decide based on the L2 norm of a
+				     specific tensor (or its region) */
+  TIFCV_TENSOR_COUNT_ABOVE = 10,	/**< Decide based on the number of elements
+					     greater than the threshold */
+  TIFCV_TENSOR_ARGMAX = 11,	/**< Decide based on the index of the max
+				     value in a specific tensor (or its region) */
+  TIFCV_TENSOR_DELTA_VALUE = 12,	/**< Decide based on the mean absolute
+					     difference from the previous frame */
   TIFCV_END,
 } tensor_if_compared_value;
 
@@ -142,6 +156,10 @@ struct _GstTensorIf
   gboolean custom_configured;
   custom_cb_s custom;
 
+  gdouble cv_threshold; /**< threshold for TENSOR_COUNT_ABOVE */
+  gpointer prev_data; /**< cached previous tensor for TENSOR_DELTA_VALUE */
+  gsize prev_size;
+
   GMutex lock; /**< Lock for custom callback */
 };
 
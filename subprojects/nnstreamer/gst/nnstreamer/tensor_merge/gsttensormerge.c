@@ -123,6 +123,9 @@ static GstStateChangeReturn gst_tensor_merge_change_state (GstElement * element,
     GstStateChange transition);
 static gboolean gst_tensor_merge_sink_event (GstCollectPads * pads,
     GstCollectData * data, GstEvent * event, GstTensorMerge * tensor_merge);
+static GstFlowReturn gst_tensor_merge_do_clip (GstCollectPads * pads,
+    GstCollectData * data, GstBuffer * buffer, GstBuffer ** out,
+    GstTensorMerge * tensor_merge);
 static GstFlowReturn gst_tensor_merge_collected (GstCollectPads * pads,
     GstTensorMerge * tensor_merge);
 
@@ -131,6 +134,7 @@ static void gst_tensor_merge_set_property (GObject * object, guint prop_id,
 static void gst_tensor_merge_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_tensor_merge_finalize (GObject * object);
+static void gst_tensor_merge_clear_pool (GstTensorMerge * tensor_merge);
 
 #define gst_tensor_merge_parent_class parent_class
 G_DEFINE_TYPE (GstTensorMerge, gst_tensor_merge, GST_TYPE_ELEMENT);
@@ -224,6 +228,9 @@ gst_tensor_merge_init (GstTensorMerge * tensor_merge)
   gst_collect_pads_set_function (tensor_merge->collect,
       (GstCollectPadsFunction) GST_DEBUG_FUNCPTR (gst_tensor_merge_collected),
       tensor_merge);
+  gst_collect_pads_set_clip_function (tensor_merge->collect,
+      (GstCollectPadsClipFunction)
+      GST_DEBUG_FUNCPTR (gst_tensor_merge_do_clip), tensor_merge);
 
   tensor_merge->silent = TRUE;
   tensor_merge->sync.mode = SYNC_NOSYNC;
@@ -233,6 +240,8 @@ gst_tensor_merge_init (GstTensorMerge * tensor_merge)
   tensor_merge->loaded = FALSE;
   tensor_merge->current_time = 0;
   tensor_merge->need_set_time = TRUE;
+  tensor_merge->plan.valid = FALSE;
+  tensor_merge->pool = NULL;
 }
 
 /**
@@ -267,6 +276,8 @@ gst_tensor_merge_finalize (GObject * object)
     tensor_merge->collect = NULL;
   }
 
+  gst_tensor_merge_clear_pool (tensor_merge);
+
   if (tensor_merge->option) {
     g_free (tensor_merge->option);
     tensor_merge->option = NULL;
@@ -314,10 +325,23 @@ gst_tensor_merge_request_new_pad (GstElement * element, GstPadTemplate * templ,
 
   if (newpad) {
     GstTensorCollectPadData *tensormergepad;
+    gboolean locked, waiting;
+
+    locked = waiting = TRUE;
+
+    if (tensor_merge->sync.mode == SYNC_DEADLINE ||
+        tensor_merge->sync.mode == SYNC_NEAREST ||
+        tensor_merge->sync.mode == SYNC_INTERPOLATE) {
+      locked = waiting = FALSE;
+    }
 
     tensormergepad = (GstTensorCollectPadData *)
         gst_collect_pads_add_pad (tensor_merge->collect, newpad,
-        sizeof (GstTensorCollectPadData), NULL, TRUE);
+        sizeof (GstTensorCollectPadData), NULL, locked);
+
+    /* NOTE: if locked is TRUE, waiting flag is not effective */
+    gst_collect_pads_set_waiting (tensor_merge->collect,
+        (GstCollectData *) tensormergepad, waiting);
 
     tensormergepad->pad = newpad;
     gst_pad_set_element_private (newpad, tensormergepad);
@@ -347,6 +371,25 @@ gst_tensor_merge_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
   return gst_pad_event_default (pad, parent, event);
 }
 
+/**
+ * @brief set pads waiting property
+ */
+static void
+gst_tensor_merge_set_waiting (GstTensorMerge * tensor_merge, gboolean waiting)
+{
+  if (tensor_merge->sync.mode == SYNC_DEADLINE ||
+      tensor_merge->sync.mode == SYNC_NEAREST ||
+      tensor_merge->sync.mode == SYNC_INTERPOLATE) {
+    GstCollectPads *pads = tensor_merge->collect;
+    GSList *walk = pads->data;
+
+    while (walk) {
+      gst_collect_pads_set_waiting (pads, walk->data, waiting);
+      walk = g_slist_next (walk);
+    }
+  }
+}
+
 /**
  * @brief sink event vmethod
  */
@@ -360,8 +403,13 @@ gst_tensor_merge_sink_event (GstCollectPads * pads, GstCollectData * data,
     case GST_EVENT_FLUSH_STOP:
       tensor_merge->need_segment = TRUE;
       tensor_merge->need_set_time = TRUE;
+      gst_tensor_time_sync_deadline_cancel (tensor_merge->collect,
+          &tensor_merge->sync);
       gst_tensor_time_sync_flush (tensor_merge->collect);
       break;
+    case GST_EVENT_EOS:
+      gst_tensor_merge_set_waiting (tensor_merge, FALSE);
+      break;
     default:
       break;
   }
@@ -453,35 +501,137 @@ gst_tensor_merge_collect_buffer (GstTensorMerge * tensor_merge,
       &tensor_merge->tensors_config, is_eos);
 }
 
+/**
+ * @brief Release the buffer pool for the output tensor.
+ */
+static void
+gst_tensor_merge_clear_pool (GstTensorMerge * tensor_merge)
+{
+  if (tensor_merge->pool) {
+    gst_buffer_pool_set_active (tensor_merge->pool, FALSE);
+    gst_object_unref (tensor_merge->pool);
+    tensor_merge->pool = NULL;
+  }
+}
+
+/**
+ * @brief Compute the copy plan with the input tensors info, and prepare the buffer pool for the output tensor.
+ * @param tensor_merge tensor merger
+ * @return TRUE if the plan is ready
+ */
+static gboolean
+gst_tensor_merge_prepare_plan (GstTensorMerge * tensor_merge)
+{
+  tensor_merge_copy_plan *plan = &tensor_merge->plan;
+  GstTensorsInfo *info = &tensor_merge->tensors_config.info;
+  GstStructure *config;
+  GstCaps *caps;
+  gsize element_size, block, out_size;
+  guint axis, i, j;
+
+  out_size = plan->valid ? plan->out_size : 0;
+  plan->valid = FALSE;
+
+  if (tensor_merge->mode != GTT_LINEAR)
+    return FALSE;
+
+  axis = tensor_merge->data_linear.direction;
+  if (axis >= LINEAR_END || info->num_tensors == 0)
+    return FALSE;
+
+  element_size = gst_tensor_get_element_size (info->info[0].type);
+
+  /* the dimensions above the merge axis are same in all input tensors */
+  plan->num_tensors = info->num_tensors;
+  plan->num_blocks = 1;
+  for (j = axis + 1; j < NNS_TENSOR_RANK_LIMIT; j++)
+    plan->num_blocks *= info->info[0].dimension[j];
+
+  plan->out_size = 0;
+  for (i = 0; i < info->num_tensors; i++) {
+    block = element_size;
+    for (j = 0; j <= axis; j++)
+      block *= info->info[i].dimension[j];
+
+    plan->block_size[i] = block;
+    plan->out_size += block * plan->num_blocks;
+  }
+
+  if (plan->out_size == 0)
+    return FALSE;
+
+  silent_debug (tensor_merge, "Copy plan: %u tensors, %" G_GSIZE_FORMAT
+      " blocks, %" G_GSIZE_FORMAT " bytes", plan->num_tensors, plan->num_blocks,
+      plan->out_size);
+
+  /* keep the pool if the size of output tensor is not changed */
+  if (tensor_merge->pool && out_size == plan->out_size) {
+    plan->valid = TRUE;
+    return TRUE;
+  }
+
+  gst_tensor_merge_clear_pool (tensor_merge);
+
+  caps = gst_pad_get_current_caps (tensor_merge->srcpad);
+  tensor_merge->pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (tensor_merge->pool);
+  gst_buffer_pool_config_set_params (config, caps, plan->out_size, 2, 0);
+  if (caps)
+    gst_caps_unref (caps);
+
+  if (!gst_buffer_pool_set_config (tensor_merge->pool, config) ||
+      !gst_buffer_pool_set_active (tensor_merge->pool, TRUE)) {
+    GST_ERROR_OBJECT (tensor_merge, "Failed to activate the buffer pool.");
+    gst_tensor_merge_clear_pool (tensor_merge);
+    return FALSE;
+  }
+
+  plan->valid = TRUE;
+  return TRUE;
+}
+
+/**
+ * @brief Check the input memories with the copy plan.
+ */
+static gboolean
+gst_tensor_merge_check_plan (GstTensorMerge * tensor_merge,
+    GstMapInfo * in_info, guint num_mem)
+{
+  tensor_merge_copy_plan *plan = &tensor_merge->plan;
+  guint i;
+
+  if (!plan->valid || plan->num_tensors != num_mem)
+    return FALSE;
+
+  for (i = 0; i < num_mem; i++) {
+    if (in_info[i].size < plan->block_size[i] * plan->num_blocks)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Generate Output GstMemory
  * @param tensor_merge tensor merger
  * @param tensors_buf collected tensors buffer
  * @param tensor_buf output tensor buffer
- * @return boolean
+ * @return GstFlowReturn
  */
 static GstFlowReturn
 gst_tensor_merge_generate_mem (GstTensorMerge * tensor_merge,
-    GstBuffer * tensors_buf, GstBuffer * tensor_buf)
+    GstBuffer * tensors_buf, GstBuffer ** tensor_buf)
 {
   GstFlowReturn ret = GST_FLOW_OK;
   GstMapInfo mInfo[NNS_TENSOR_SIZE_LIMIT];
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo outInfo;
-  GstMemory *outMem;
-  uint8_t *inptr, *outptr;
+  GstBuffer *outbuf = NULL;
+  tensor_merge_copy_plan *plan = &tensor_merge->plan;
+  uint8_t *outptr;
   guint num_mem = tensor_merge->tensors_config.info.num_tensors;
-  guint i, j, k, l;
-  size_t c, s;
-  gsize outSize = 0;
-  gsize element_size;
-  tensor_dim dim;
-  tensor_type type;
-
-  memcpy (&dim, &tensor_merge->tensors_config.info.info[0].dimension,
-      sizeof (tensor_dim));
-  type = tensor_merge->tensors_config.info.info[0].type;
-  element_size = gst_tensor_get_element_size (type);
+  guint i;
+  gsize b, s;
 
   for (i = 0; i < num_mem; i++) {
     mem[i] = gst_buffer_peek_memory (tensors_buf, i);
@@ -491,107 +641,45 @@ gst_tensor_merge_generate_mem (GstTensorMerge * tensor_merge,
       ret = GST_FLOW_ERROR;
       goto error_ret;
     }
-    outSize += mInfo[i].size;
   }
 
-  outMem = gst_allocator_alloc (NULL, outSize, NULL);
-  if (!gst_memory_map (outMem, &outInfo, GST_MAP_WRITE)) {
-    gst_allocator_free (NULL, outMem);
+  /* the plan is computed at caps time, update it if input is changed */
+  if (!gst_tensor_merge_check_plan (tensor_merge, mInfo, num_mem)) {
+    if (!gst_tensor_merge_prepare_plan (tensor_merge) ||
+        !gst_tensor_merge_check_plan (tensor_merge, mInfo, num_mem)) {
+      ml_loge ("Failed to get the copy plan for the input tensors.\n");
+      ret = GST_FLOW_ERROR;
+      goto error_ret;
+    }
+  }
+
+  ret = gst_buffer_pool_acquire_buffer (tensor_merge->pool, &outbuf, NULL);
+  if (ret != GST_FLOW_OK) {
+    ml_loge ("Cannot get output buffer from the pool.\n");
+    goto error_ret;
+  }
+
+  if (!gst_buffer_map (outbuf, &outInfo, GST_MAP_WRITE)) {
     ml_logf ("Cannot map output memory buffer\n");
+    gst_buffer_unref (outbuf);
     ret = GST_FLOW_ERROR;
     goto error_ret;
   }
   outptr = outInfo.data;
 
-  switch (tensor_merge->mode) {
-    case GTT_LINEAR:
-    {
-      switch (tensor_merge->data_linear.direction) {
-        case LINEAR_FIRST:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (i = 0; i < dim[2]; i++) {
-              for (j = 0; j < dim[1]; j++) {
-                for (k = 0; k < num_mem; k++) {
-                  c = tensor_merge->tensors_config.info.info[k].dimension[0];
-                  s = element_size * c;
-                  inptr =
-                      mInfo[k].data + (l * dim[2] * dim[1] + i * dim[1] +
-                      j) * s;
-                  memcpy (outptr, inptr, s);
-                  outptr += s;
-                }
-              }
-            }
-          }
-          break;
-        }
-        case LINEAR_SECOND:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (i = 0; i < dim[2]; i++) {
-              for (k = 0; k < num_mem; k++) {
-                c = 1;
-                for (j = 0; j < LINEAR_SECOND + 1; j++)
-                  c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-                s = element_size * c;
-
-                inptr = mInfo[k].data + (l * dim[2] + i) * s;
-
-                memcpy (outptr, inptr, s);
-                outptr += s;
-              }
-            }
-          }
-          break;
-        }
-        case LINEAR_THIRD:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (k = 0; k < num_mem; k++) {
-              c = 1;
-              for (j = 0; j < LINEAR_THIRD + 1; j++)
-                c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-              s = element_size * c;
-
-              inptr = mInfo[k].data + l * s;
-
-              memcpy (outptr, inptr, s);
-              outptr += s;
-            }
-          }
-          break;
-        }
-        case LINEAR_FOURTH:
-        {
-          for (k = 0; k < num_mem; k++) {
-            c = 1;
-            for (j = 0; j < LINEAR_FOURTH + 1; j++)
-              c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-            s = element_size * c;
-
-            inptr = mInfo[k].data;
-            memcpy (outptr, inptr, s);
-            outptr += s;
-          }
-          break;
-        }
-        default:
-          ret = GST_FLOW_ERROR;
-      }
-      break;
+  /* copy a block of each input tensor in turn */
+  for (b = 0; b < plan->num_blocks; b++) {
+    for (i = 0; i < num_mem; i++) {
+      s = plan->block_size[i];
+      memcpy (outptr, mInfo[i].data + b * s, s);
+      outptr += s;
     }
-    default:
-      ret = GST_FLOW_ERROR;
   }
 
-  gst_memory_unmap (outMem, &outInfo);
-  gst_buffer_append_memory (tensor_buf, outMem);
-  gst_buffer_copy_into (tensor_buf, tensors_buf, GST_BUFFER_COPY_TIMESTAMPS, 0,
+  gst_buffer_unmap (outbuf, &outInfo);
+  gst_buffer_copy_into (outbuf, tensors_buf, GST_BUFFER_COPY_TIMESTAMPS, 0,
       -1);
+  *tensor_buf = outbuf;
 
 error_ret:
   for (i = 0; i < num_mem; i++)
@@ -620,6 +708,7 @@ gst_tensor_merge_set_src_caps (GstTensorMerge * tensor_merge)
 
     if (gst_pad_set_caps (tensor_merge->srcpad, newcaps)) {
       tensor_merge->negotiated = TRUE;
+      gst_tensor_merge_prepare_plan (tensor_merge);
     }
 
     gst_caps_unref (newcaps);
@@ -670,6 +759,7 @@ gst_tensor_merge_collected (GstCollectPads * pads,
   GstFlowReturn ret = GST_FLOW_OK;
   GstBuffer *tensors_buf, *tensor_buf;
   gboolean isEOS = FALSE;
+  gboolean buf_collected = FALSE;
   UNUSED (pads);
 
   GST_DEBUG_OBJECT (tensor_merge, " all pads are collected ");
@@ -687,10 +777,21 @@ gst_tensor_merge_collected (GstCollectPads * pads,
     return GST_FLOW_ERROR;
   }
 
-  if (!gst_tensor_merge_collect_buffer (tensor_merge, tensors_buf, &isEOS)) {
+  buf_collected =
+      gst_tensor_merge_collect_buffer (tensor_merge, tensors_buf, &isEOS);
+
+  gst_tensor_merge_set_waiting (tensor_merge, TRUE);
+
+  if (!buf_collected) {
     if (isEOS) {
       gst_pad_push_event (tensor_merge->srcpad, gst_event_new_eos ());
       ret = GST_FLOW_EOS;
+    } else {
+      /* push the latest buffers if the other pads are late (deadline mode) */
+      gst_tensor_time_sync_deadline_schedule (tensor_merge->collect,
+          &tensor_merge->sync,
+          (GstCollectPadsFunction) gst_tensor_merge_collected,
+          GST_ELEMENT (tensor_merge), tensor_merge->srcpad);
     }
 
     goto beach;
@@ -704,13 +805,9 @@ gst_tensor_merge_collected (GstCollectPads * pads,
   gst_tensor_merge_send_segment_event (tensor_merge,
       GST_BUFFER_PTS (tensors_buf), GST_BUFFER_DTS (tensors_buf));
 
-  if ((tensor_buf = gst_buffer_new ()) == NULL) {
-    ml_logf ("gst_buffer_new() returns NULL. Out of memory?\n");
-    ret = GST_FLOW_ERROR;
+  ret = gst_tensor_merge_generate_mem (tensor_merge, tensors_buf, &tensor_buf);
+  if (ret != GST_FLOW_OK)
     goto beach;
-  }
-
-  gst_tensor_merge_generate_mem (tensor_merge, tensors_buf, tensor_buf);
 
   ret = gst_pad_push (tensor_merge->srcpad, tensor_buf);
   tensor_merge->need_set_time = TRUE;
@@ -724,6 +821,20 @@ beach:
   return ret;
 }
 
+/**
+ * @brief Gst Clip Pads Function which is called right after a buffer is received for each pad.
+ */
+static GstFlowReturn
+gst_tensor_merge_do_clip (GstCollectPads * pads, GstCollectData * data,
+    GstBuffer * buffer, GstBuffer ** out, GstTensorMerge * tensor_merge)
+{
+  UNUSED (pads);
+  UNUSED (data);
+  gst_tensor_merge_set_waiting (tensor_merge, FALSE);
+  *out = buffer;
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief Ready --> Pasuse State Change
  */
@@ -733,6 +844,7 @@ gst_tensor_merge_ready_to_paused (GstTensorMerge * tensor_merge)
   tensor_merge->need_stream_start = TRUE;
   tensor_merge->need_segment = TRUE;
   tensor_merge->negotiated = FALSE;
+  tensor_merge->plan.valid = FALSE;
   gst_collect_pads_start (tensor_merge->collect);
 }
 
@@ -751,6 +863,10 @@ gst_tensor_merge_change_state (GstElement * element, GstStateChange transition)
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_collect_pads_stop (tensor_merge->collect);
+      gst_tensor_time_sync_deadline_stop (tensor_merge->collect,
+          &tensor_merge->sync, tensor_merge->srcpad);
+      gst_tensor_time_sync_flush (tensor_merge->collect);
+      gst_tensor_merge_clear_pool (tensor_merge);
       break;
     default:
       break;
@@ -65,6 +65,19 @@ typedef struct _tensor_merge_linear {
   tensor_merge_linear_mode direction;
 } tensor_merge_linear;
 
+/**
+ * @brief Copy plan to concatenate the input tensors, computed at caps time.
+ * The input tensors are copied into the output as blocks of contiguous bytes.
+ * The dimensions below the merge axis are coalesced into a block, and the dimensions above it into the number of blocks.
+ */
+typedef struct _tensor_merge_copy_plan {
+  gboolean valid; /**< TRUE if the plan is computed */
+  guint num_tensors; /**< the number of input tensors */
+  gsize num_blocks; /**< the number of blocks in each input tensor */
+  gsize block_size[NNS_TENSOR_SIZE_LIMIT]; /**< bytes of a block in each input tensor */
+  gsize out_size; /**< bytes of the output tensor */
+} tensor_merge_copy_plan;
+
 /**
  * @brief Tensor Merge data structure
  */
@@ -91,6 +104,9 @@ struct _GstTensorMerge
   GstClockTime current_time;
   gboolean need_set_time;
   GstTensorsConfig tensors_config; /**< output tensors info */
+
+  tensor_merge_copy_plan plan; /**< copy plan for the current input tensors */
+  GstBufferPool *pool; /**< buffer pool for the output tensor */
 };
 
 /**
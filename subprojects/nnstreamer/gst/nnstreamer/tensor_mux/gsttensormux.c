@@ -163,7 +163,10 @@ gst_tensor_mux_class_init (GstTensorMuxClass * klass)
 
   g_object_class_install_property (gobject_class, PROP_SYNC_OPTION,
       g_param_spec_string ("sync-option", "Sync Option",
-          "Option for the time synchronization mode ?", "", G_PARAM_READWRITE));
+          "Option for the time synchronization mode ? "
+          "(basepad: sink_id:duration, deadline: timeout in nanoseconds, "
+          "nearest and interpolate: sink_id:tolerance:ring_size)",
+          "", G_PARAM_READWRITE));
 
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_tensor_mux_request_new_pad);
@@ -274,7 +277,10 @@ gst_tensor_mux_request_new_pad (GstElement * element, GstPadTemplate * templ,
 
     locked = waiting = TRUE;
 
-    if (tensor_mux->sync.mode == SYNC_REFRESH) {
+    if (tensor_mux->sync.mode == SYNC_REFRESH ||
+        tensor_mux->sync.mode == SYNC_DEADLINE ||
+        tensor_mux->sync.mode == SYNC_NEAREST ||
+        tensor_mux->sync.mode == SYNC_INTERPOLATE) {
       locked = waiting = FALSE;
     }
 
@@ -320,7 +326,10 @@ gst_tensor_mux_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
 static void
 gst_tensor_mux_set_waiting (GstTensorMux * tensor_mux, gboolean waiting)
 {
-  if (tensor_mux->sync.mode == SYNC_REFRESH) {
+  if (tensor_mux->sync.mode == SYNC_REFRESH ||
+      tensor_mux->sync.mode == SYNC_DEADLINE ||
+      tensor_mux->sync.mode == SYNC_NEAREST ||
+      tensor_mux->sync.mode == SYNC_INTERPOLATE) {
     GstCollectPads *pads = tensor_mux->collect;
     GSList *walk = pads->data;
 
@@ -344,6 +353,8 @@ gst_tensor_mux_sink_event (GstCollectPads * pads, GstCollectData * data,
     case GST_EVENT_FLUSH_STOP:
       tensor_mux->need_segment = TRUE;
       tensor_mux->need_set_time = TRUE;
+      gst_tensor_time_sync_deadline_cancel (tensor_mux->collect,
+          &tensor_mux->sync);
       gst_tensor_time_sync_flush (tensor_mux->collect);
       break;
     case GST_EVENT_EOS:
@@ -510,6 +521,11 @@ gst_tensor_mux_collected (GstCollectPads * pads, GstTensorMux * tensor_mux)
     if (isEOS) {
       gst_pad_push_event (tensor_mux->srcpad, gst_event_new_eos ());
       ret = GST_FLOW_EOS;
+    } else {
+      /* push the latest buffers if the other pads are late (deadline mode) */
+      gst_tensor_time_sync_deadline_schedule (tensor_mux->collect,
+          &tensor_mux->sync, (GstCollectPadsFunction) gst_tensor_mux_collected,
+          GST_ELEMENT (tensor_mux), tensor_mux->srcpad);
     }
 
     gst_buffer_unref (tensors_buf);
@@ -580,6 +596,9 @@ gst_tensor_mux_change_state (GstElement * element, GstStateChange transition)
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_collect_pads_stop (tensor_mux->collect);
+      gst_tensor_time_sync_deadline_stop (tensor_mux->collect,
+          &tensor_mux->sync, tensor_mux->srcpad);
+      gst_tensor_time_sync_flush (tensor_mux->collect);
       break;
     default:
       break;
@@ -28,6 +28,15 @@
  * to upstream elements by sending qos events, which prevents unnecessary
  * data from upstream elements.
  *
+ * When 'adaptive' property is set, the element lowers the frame-rate under
+ * load to keep the latency in 'latency-budget', and raises it back up to the
+ * negotiated frame-rate when downstream has enough headroom. The latency is
+ * estimated from the processing time of downstream (time to push a buffer,
+ * without the clock wait of a synchronized sink), the age of incoming buffers
+ * (running-time against the pipeline clock) and the lateness reported by qos
+ * events. Frames over the adaptive rate are dropped here, and the adaptive
+ * rate is propagated to upstream elements with throttling qos events.
+ *
  * <refsect2>
  * <title>Example launch line with tensor rate</title>
  * gst-launch-1.0 videotestsrc
@@ -38,6 +47,16 @@
  *      ! videoconvert
  *      ! autovideosink
  * </refsect2>
+ * <refsect2>
+ * <title>Example launch line with adaptive tensor rate</title>
+ * gst-launch-1.0 v4l2src
+ *      ! videoconvert ! videoscale
+ *      ! video/x-raw,format=RGB,width=300,height=300,framerate=30/1
+ *      ! tensor_converter
+ *      ! tensor_rate adaptive=true latency-budget=100000000
+ *      ! tensor_filter framework=tensorflow-lite model=ssd_mobilenet.tflite
+ *      ! tensor_sink
+ * </refsect2>
  */
 
 #ifdef HAVE_CONFIG_H
@@ -72,6 +91,18 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_rate_debug);
 /** @brief default parameters */
 #define DEFAULT_SILENT    TRUE
 #define DEFAULT_THROTTLE  TRUE
+#define DEFAULT_ADAPTIVE  FALSE
+#define DEFAULT_LATENCY_BUDGET  (100 * GST_MSECOND)
+
+/** @brief parameters of adaptive rate control */
+#define ADAPTIVE_EWMA_WEIGHT    (0.125) /* weight of new sample in the averages */
+#define ADAPTIVE_DECREASE       (0.8)   /* multiplicative decrease over the budget */
+#define ADAPTIVE_INCREASE       (1.1)   /* increase when downstream has headroom */
+#define ADAPTIVE_LOW_WATERMARK  (0.5)   /* latency ratio to the budget to increase */
+#define ADAPTIVE_HEADROOM       (0.8)   /* max ratio of processing time to interval to increase */
+#define ADAPTIVE_HOLD_FRAMES    (8)     /* hysteresis, frames between rate changes */
+#define ADAPTIVE_MIN_RATE       (1.0)
+#define ADAPTIVE_MAX_RATE       (1000.0) /* used when the framerate is variable */
 
 /**
  * @brief tensor_rate properties
@@ -86,6 +117,9 @@ enum
   PROP_SILENT,
   PROP_THROTTLE,
   PROP_FRAMERATE,
+  PROP_ADAPTIVE,
+  PROP_LATENCY_BUDGET,
+  PROP_ADAPTIVE_RATE,
 };
 
 /**
@@ -138,6 +172,13 @@ static gboolean gst_tensor_rate_start (GstBaseTransform * trans);
 static gboolean gst_tensor_rate_stop (GstBaseTransform * trans);
 static gboolean gst_tensor_rate_sink_event (GstBaseTransform * trans,
     GstEvent * event);
+static gboolean gst_tensor_rate_src_event (GstBaseTransform * trans,
+    GstEvent * event);
+
+static gboolean gst_tensor_rate_adaptive_accept (GstTensorRate * self,
+    GstClockTime ts);
+static GstFlowReturn gst_tensor_rate_adaptive_push (GstTensorRate * self,
+    GstBuffer * outbuf, GstClockTime ts);
 
 static void gst_tensor_rate_install_properties (GObjectClass * gobject_class);
 
@@ -189,6 +230,7 @@ gst_tensor_rate_class_init (GstTensorRateClass * klass)
 
   /* setup sink event */
   trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensor_rate_sink_event);
+  trans_class->src_event = GST_DEBUG_FUNCPTR (gst_tensor_rate_src_event);
 
   /* start/stop to call open/close */
   trans_class->start = GST_DEBUG_FUNCPTR (gst_tensor_rate_start);
@@ -206,8 +248,6 @@ gst_tensor_rate_push_buffer (GstTensorRate * self, GstBuffer * outbuf,
   GstClockTime push_ts;
   UNUSED (next_intime);
 
-  GST_BUFFER_OFFSET (outbuf) = self->out;
-  GST_BUFFER_OFFSET_END (outbuf) = self->out + 1;
   GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_DISCONT);
 
   if (duplicate)
@@ -218,7 +258,6 @@ gst_tensor_rate_push_buffer (GstTensorRate * self, GstBuffer * outbuf,
   /* this is the timestamp we put on the buffer */
   push_ts = self->next_ts;
 
-  self->out++;
   self->out_frame_count++;
 
   if (self->to_rate_numerator) {
@@ -244,10 +283,30 @@ gst_tensor_rate_push_buffer (GstTensorRate * self, GstBuffer * outbuf,
   /* adapt for looping, bring back to time in current segment. */
   GST_BUFFER_TIMESTAMP (outbuf) = push_ts - self->segment.base;
 
+  /* drop here if downstream cannot keep the latency budget */
+  if (self->adaptive && !gst_tensor_rate_adaptive_accept (self, push_ts)) {
+    silent_debug (self, "adaptive rate, dropping buffer outgoing ts %"
+        GST_TIME_FORMAT, GST_TIME_ARGS (push_ts));
+    gst_buffer_unref (outbuf);
+
+    self->drop++;
+    if (!self->silent)
+      gst_tensor_rate_notify_drop (self);
+
+    return GST_FLOW_OK;
+  }
+
+  GST_BUFFER_OFFSET (outbuf) = self->out;
+  GST_BUFFER_OFFSET_END (outbuf) = self->out + 1;
+  self->out++;
+
   silent_debug (self, "old is best, dup, pushing buffer outgoing ts %"
       GST_TIME_FORMAT, GST_TIME_ARGS (push_ts));
 
-  res = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), outbuf);
+  if (self->adaptive)
+    res = gst_tensor_rate_adaptive_push (self, outbuf, push_ts);
+  else
+    res = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), outbuf);
 
   return res;
 }
@@ -307,6 +366,16 @@ gst_tensor_rate_reset (GstTensorRate * self)
 
   self->sent_qos_on_passthrough = FALSE;
 
+  self->adaptive_rate = 0.0;
+  self->adaptive_interval = 0;
+  self->adaptive_next_ts = GST_CLOCK_TIME_NONE;
+  self->proc_avg = 0;
+  self->latency_avg = 0;
+  self->buffer_age = 0;
+  self->qos_late = 0;
+  self->adaptive_hold = 0;
+  self->adaptive_stable = 0;
+
   gst_tensor_rate_swap_prev (self, NULL, 0);
 }
 
@@ -320,6 +389,9 @@ gst_tensor_rate_init (GstTensorRate * self)
 
   self->silent = DEFAULT_SILENT;
   self->throttle = DEFAULT_THROTTLE;
+  self->adaptive = DEFAULT_ADAPTIVE;
+  self->latency_budget = DEFAULT_LATENCY_BUDGET;
+  self->latency = 0;
 
   /* decided from caps negotiation */
   self->from_rate_numerator = 0;
@@ -361,6 +433,12 @@ gst_tensor_rate_set_property (GObject * object, guint prop_id,
     case PROP_THROTTLE:
       self->throttle = g_value_get_boolean (value);
       break;
+    case PROP_ADAPTIVE:
+      self->adaptive = g_value_get_boolean (value);
+      break;
+    case PROP_LATENCY_BUDGET:
+      self->latency_budget = g_value_get_uint64 (value);
+      break;
     case PROP_FRAMERATE:
     {
       const gchar *str = g_value_get_string (value);
@@ -438,6 +516,15 @@ gst_tensor_rate_get_property (GObject * object, guint prop_id,
         g_value_take_string (value, str);
       }
       break;
+    case PROP_ADAPTIVE:
+      g_value_set_boolean (value, self->adaptive);
+      break;
+    case PROP_LATENCY_BUDGET:
+      g_value_set_uint64 (value, self->latency_budget);
+      break;
+    case PROP_ADAPTIVE_RATE:
+      g_value_set_double (value, self->adaptive_rate);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -458,7 +545,13 @@ gst_tensor_rate_send_qos_throttle (GstTensorRate * self, GstClockTime timestamp)
   GstClockTimeDiff delay;
   GstEvent *event;
 
-  delay = GST_TENSOR_RATE_SCALED_TIME (self, 1);
+  if (!self->throttle)
+    return;
+
+  if (self->adaptive && self->adaptive_interval > 0)
+    delay = self->adaptive_interval;
+  else
+    delay = GST_TENSOR_RATE_SCALED_TIME (self, 1);
   delay = (GstClockTimeDiff) (((gdouble) delay) * THROTTLE_DELAY_RATIO);
 
   event = gst_event_new_qos (GST_QOS_TYPE_THROTTLE,
@@ -470,6 +563,223 @@ gst_tensor_rate_send_qos_throttle (GstTensorRate * self, GstClockTime timestamp)
   gst_pad_push_event (sinkpad, event);
 }
 
+/**
+ * @brief Get the max framerate in adaptive mode (the negotiated framerate).
+ */
+static gdouble
+gst_tensor_rate_adaptive_max_rate (GstTensorRate * self)
+{
+  if (self->to_rate_numerator > 0 && self->to_rate_denominator > 0)
+    return (gdouble) self->to_rate_numerator / self->to_rate_denominator;
+
+  if (self->from_rate_numerator > 0 && self->from_rate_denominator > 0)
+    return (gdouble) self->from_rate_numerator / self->from_rate_denominator;
+
+  return ADAPTIVE_MAX_RATE;
+}
+
+/**
+ * @brief Set the framerate in adaptive mode.
+ */
+static void
+gst_tensor_rate_adaptive_set_rate (GstTensorRate * self, gdouble rate)
+{
+  gdouble max_rate = gst_tensor_rate_adaptive_max_rate (self);
+
+  rate = CLAMP (rate, MIN (ADAPTIVE_MIN_RATE, max_rate), max_rate);
+
+  GST_OBJECT_LOCK (self);
+  self->adaptive_rate = rate;
+  self->adaptive_interval = (guint64) (GST_SECOND / rate);
+  GST_OBJECT_UNLOCK (self);
+}
+
+/**
+ * @brief Check the frame with given timestamp is accepted in adaptive mode.
+ * @return TRUE if the frame is not over the adaptive framerate
+ */
+static gboolean
+gst_tensor_rate_adaptive_accept (GstTensorRate * self, GstClockTime ts)
+{
+  GstClockTime tolerance;
+
+  if (self->adaptive_rate <= 0.0) {
+    gst_tensor_rate_adaptive_set_rate (self,
+        gst_tensor_rate_adaptive_max_rate (self));
+  }
+
+  /* tolerate the jitter of incoming timestamps */
+  tolerance = self->adaptive_interval / 8;
+
+  if (GST_CLOCK_TIME_IS_VALID (self->adaptive_next_ts)) {
+    if (ts + tolerance < self->adaptive_next_ts)
+      return FALSE;
+
+    /* keep the phase, unless there was a gap in the stream */
+    if (self->adaptive_next_ts + self->adaptive_interval >= ts) {
+      self->adaptive_next_ts += self->adaptive_interval;
+      return TRUE;
+    }
+  }
+
+  self->adaptive_next_ts = ts + self->adaptive_interval;
+  return TRUE;
+}
+
+/**
+ * @brief Get the age of incoming buffer, the running-time behind the pipeline clock.
+ */
+static GstClockTime
+gst_tensor_rate_get_buffer_age (GstTensorRate * self, GstClockTime ts)
+{
+  GstClock *clock;
+  GstClockTime now, running_time, age = 0;
+
+  /* the base time is valid in playing state */
+  if (GST_STATE (self) != GST_STATE_PLAYING)
+    return 0;
+
+  clock = gst_element_get_clock (GST_ELEMENT_CAST (self));
+  if (!clock)
+    return 0;
+
+  now = gst_clock_get_time (clock) -
+      gst_element_get_base_time (GST_ELEMENT_CAST (self));
+  running_time = gst_segment_to_running_time (&self->segment,
+      GST_FORMAT_TIME, ts);
+
+  if (GST_CLOCK_TIME_IS_VALID (running_time) && now > running_time)
+    age = now - running_time;
+
+  gst_object_unref (clock);
+  return age;
+}
+
+/**
+ * @brief Update the framerate in adaptive mode with the processing time of downstream.
+ */
+static void
+gst_tensor_rate_adaptive_update (GstTensorRate * self, GstClockTime proc,
+    GstClockTime ts)
+{
+  gdouble rate = self->adaptive_rate;
+  gint64 late;
+  gboolean changed = FALSE;
+
+  if (self->proc_avg == 0) {
+    self->proc_avg = proc;
+    self->latency_avg = self->buffer_age + proc;
+  } else {
+    self->proc_avg += (gint64) (((gdouble) proc - self->proc_avg) *
+        ADAPTIVE_EWMA_WEIGHT);
+    self->latency_avg += (gint64) (((gdouble) (self->buffer_age + proc) -
+            self->latency_avg) * ADAPTIVE_EWMA_WEIGHT);
+  }
+
+  GST_OBJECT_LOCK (self);
+  late = self->qos_late;
+  self->qos_late = 0;
+  GST_OBJECT_UNLOCK (self);
+
+  if (self->adaptive_hold > 0)
+    self->adaptive_hold--;
+
+  if (self->latency_avg + late > self->latency_budget) {
+    self->adaptive_stable = 0;
+
+    /* decrease once, and wait until the new rate takes effect */
+    if (self->adaptive_hold == 0) {
+      rate *= ADAPTIVE_DECREASE;
+      if (self->proc_avg > 0)
+        rate = MIN (rate, (gdouble) GST_SECOND / self->proc_avg);
+
+      self->adaptive_hold = ADAPTIVE_HOLD_FRAMES;
+      changed = TRUE;
+    }
+  } else if (self->latency_avg <
+      self->latency_budget * ADAPTIVE_LOW_WATERMARK &&
+      self->proc_avg * rate < GST_SECOND * ADAPTIVE_HEADROOM &&
+      rate < gst_tensor_rate_adaptive_max_rate (self)) {
+    /* increase when the budget is kept with headroom for a while */
+    if (++self->adaptive_stable >= ADAPTIVE_HOLD_FRAMES) {
+      rate *= ADAPTIVE_INCREASE;
+      self->adaptive_stable = 0;
+      changed = TRUE;
+    }
+  } else {
+    self->adaptive_stable = 0;
+  }
+
+  if (changed) {
+    gst_tensor_rate_adaptive_set_rate (self, rate);
+
+    silent_debug (self, "adaptive rate %.2f, latency %" GST_TIME_FORMAT
+        ", processing time %" GST_TIME_FORMAT, self->adaptive_rate,
+        GST_TIME_ARGS (self->latency_avg), GST_TIME_ARGS (self->proc_avg));
+
+    gst_tensor_rate_send_qos_throttle (self, ts);
+  }
+}
+
+/**
+ * @brief Get the current time of the pipeline clock, or the monotonic time without the clock.
+ */
+static GstClockTime
+gst_tensor_rate_adaptive_get_time (GstClock * clock)
+{
+  if (clock)
+    return gst_clock_get_time (clock);
+
+  return g_get_monotonic_time () * GST_USECOND;
+}
+
+/**
+ * @brief Push the buffer and measure the processing time of downstream in adaptive mode.
+ * The synchronized sink waits for the clock until the running-time of the buffer, which is not the processing time.
+ */
+static GstFlowReturn
+gst_tensor_rate_adaptive_push (GstTensorRate * self, GstBuffer * outbuf,
+    GstClockTime ts)
+{
+  GstFlowReturn res;
+  GstClock *clock = NULL;
+  GstClockTime start, end, running_time, due = GST_CLOCK_TIME_NONE;
+
+  /* the base time is valid in playing state */
+  if (GST_STATE (self) == GST_STATE_PLAYING)
+    clock = gst_element_get_clock (GST_ELEMENT_CAST (self));
+
+  if (clock) {
+    running_time = gst_segment_to_running_time (&self->segment,
+        GST_FORMAT_TIME, GST_BUFFER_TIMESTAMP (outbuf));
+
+    if (GST_CLOCK_TIME_IS_VALID (running_time)) {
+      GST_OBJECT_LOCK (self);
+      due = running_time + self->latency;
+      GST_OBJECT_UNLOCK (self);
+
+      due += gst_element_get_base_time (GST_ELEMENT_CAST (self));
+    }
+  }
+
+  start = gst_tensor_rate_adaptive_get_time (clock);
+  res = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), outbuf);
+  end = gst_tensor_rate_adaptive_get_time (clock);
+
+  if (res == GST_FLOW_OK) {
+    /* exclude the clock wait, downstream may render the buffer after it is due */
+    if (GST_CLOCK_TIME_IS_VALID (due) && due > start)
+      start = MIN (due, end);
+
+    gst_tensor_rate_adaptive_update (self, end - start, ts);
+  }
+
+  if (clock)
+    gst_object_unref (clock);
+
+  return res;
+}
+
 /**
  * @brief in-place transform
  */
@@ -515,6 +825,9 @@ gst_tensor_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
 
   intime = in_ts + self->segment.base;
 
+  if (self->adaptive)
+    self->buffer_age = gst_tensor_rate_get_buffer_age (self, in_ts);
+
   /* let's send a QoS event even if pass-through is used on the same caps */
   if (gst_base_transform_is_passthrough (trans)) {
     if (!self->sent_qos_on_passthrough) {
@@ -522,6 +835,22 @@ gst_tensor_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
       gst_tensor_rate_send_qos_throttle (self, intime);
     }
 
+    if (self->adaptive) {
+      if (!gst_tensor_rate_adaptive_accept (self, intime)) {
+        self->drop++;
+        if (!self->silent)
+          gst_tensor_rate_notify_drop (self);
+
+        return GST_BASE_TRANSFORM_FLOW_DROPPED;
+      }
+
+      /* push here to measure the processing time of downstream */
+      self->out++;
+      res = gst_tensor_rate_adaptive_push (self, gst_buffer_ref (buffer),
+          intime);
+      return (res == GST_FLOW_OK) ? GST_BASE_TRANSFORM_FLOW_DROPPED : res;
+    }
+
     self->out++;
     return GST_FLOW_OK;
   }
@@ -735,6 +1064,10 @@ gst_tensor_rate_set_caps (GstBaseTransform * trans,
   self->to_rate_numerator = rate_numerator;
   self->to_rate_denominator = rate_denominator;
 
+  /* the max framerate in adaptive mode may be changed */
+  if (self->adaptive_rate > 0.0)
+    gst_tensor_rate_adaptive_set_rate (self, self->adaptive_rate);
+
   /**
    * After a setcaps, our caps may have changed. In that case, we can't use
    * the old buffer, if there was one (it might have different dimensions)
@@ -919,6 +1252,42 @@ gst_tensor_rate_sink_event (GstBaseTransform * trans, GstEvent * event)
   return GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
 }
 
+/**
+ * @brief Event handler for src pad of tensor rate.
+ * @param[in] trans "this" pointer
+ * @param[in] event a passed event object
+ * @return TRUE if there is no error.
+ */
+static gboolean
+gst_tensor_rate_src_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstTensorRate *self = GST_TENSOR_RATE (trans);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_LATENCY) {
+    GstClockTime latency;
+
+    gst_event_parse_latency (event, &latency);
+
+    GST_OBJECT_LOCK (self);
+    self->latency = latency;
+    GST_OBJECT_UNLOCK (self);
+  } else if (GST_EVENT_TYPE (event) == GST_EVENT_QOS && self->adaptive) {
+    GstQOSType type;
+    GstClockTimeDiff diff;
+
+    gst_event_parse_qos (event, &type, NULL, &diff, NULL);
+
+    /* lateness of the buffer in downstream */
+    if (type != GST_QOS_TYPE_THROTTLE && diff > 0) {
+      GST_OBJECT_LOCK (self);
+      self->qos_late = MAX (self->qos_late, diff);
+      GST_OBJECT_UNLOCK (self);
+    }
+  }
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->src_event (trans, event);
+}
+
 /**
  * @brief Called when the element starts processing. optional vmethod of BaseTransform
  * @param[in] trans "this" pointer
@@ -994,4 +1363,24 @@ gst_tensor_rate_install_properties (GObjectClass * object_class)
           "Specify a target framerate to adjust (e.g., framerate=10/1). "
           "Otherwise, the latest processing time will be a target interval.",
           "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /* PROP_ADAPTIVE */
+  g_object_class_install_property (object_class, PROP_ADAPTIVE,
+      g_param_spec_boolean ("adaptive", "Adaptive",
+          "Lower the framerate under load to keep the latency in the budget, "
+          "and raise it up to the negotiated framerate with headroom",
+          DEFAULT_ADAPTIVE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /* PROP_LATENCY_BUDGET */
+  g_object_class_install_property (object_class, PROP_LATENCY_BUDGET,
+      g_param_spec_uint64 ("latency-budget", "Latency budget",
+          "The latency budget (in nanoseconds) in adaptive mode", 1,
+          G_MAXUINT64, DEFAULT_LATENCY_BUDGET,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /* PROP_ADAPTIVE_RATE */
+  g_object_class_install_property (object_class, PROP_ADAPTIVE_RATE,
+      g_param_spec_double ("adaptive-rate", "Adaptive rate",
+          "The current framerate in adaptive mode (0 if not started)", 0.0,
+          G_MAXDOUBLE, 0.0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
@@ -62,6 +62,20 @@ struct _GstTensorRate
   gint rate_n, rate_d;          /**< framerate property */
   gboolean silent;              /**< debug property */
   gboolean throttle;            /**< throttle property */
+  gboolean adaptive;            /**< adaptive property */
+  guint64 latency_budget;       /**< latency-budget property */
+
+  /** Adaptive rate control */
+  gdouble adaptive_rate;        /**< current framerate in adaptive mode */
+  guint64 adaptive_interval;    /**< interval of the current framerate */
+  guint64 adaptive_next_ts;     /**< earliest timestamp of the next frame to accept */
+  guint64 proc_avg;             /**< average processing time of downstream */
+  guint64 latency_avg;          /**< average latency (buffer age and processing time) */
+  guint64 buffer_age;           /**< age of the last input buffer */
+  gint64 qos_late;              /**< lateness reported by qos events from downstream */
+  guint64 latency;              /**< latency of the pipeline, the synchronized sink renders a buffer at running-time + latency */
+  guint adaptive_hold;          /**< frames to wait before decreasing the rate again */
+  guint adaptive_stable;        /**< frames meeting the budget with headroom */
 };
 
 /**
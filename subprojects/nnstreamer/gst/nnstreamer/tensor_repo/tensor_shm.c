@@ -0,0 +1,718 @@
+/**
+ * NNStreamer Tensor Shared-Memory Channel
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ */
+/**
+ * @file	tensor_shm.c
+ * @date	18 Oct 2026
+ * @brief	Inter-process tensor channel (shared-memory ring of tensor slots) for tensor_shmsink and tensor_shmsrc
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+#include "tensor_shm.h"
+
+#define GST_TENSOR_SHM_MAGIC (0x4E4E5348U) /* "NNSH" */
+#define GST_TENSOR_SHM_VERSION (1U)
+
+/**
+ * @brief Alignment of the slots and tensor memories in the segment (cache line).
+ */
+#define GST_TENSOR_SHM_ALIGN(s) (((s) + 63) & ~((gsize) 63))
+
+/**
+ * @brief Timeout (in microseconds) of a single doorbell wait. Waiters re-check the flushing flag after this.
+ */
+#define GST_TENSOR_SHM_WAIT_US (100 * 1000)
+
+/**
+ * @brief Buffer flags delivered through the channel.
+ */
+#define GST_TENSOR_SHM_BUFFER_FLAGS \
+  (GST_BUFFER_FLAG_DISCONT | GST_BUFFER_FLAG_GAP | GST_BUFFER_FLAG_DELTA_UNIT | \
+   GST_BUFFER_FLAG_DROPPABLE | GST_BUFFER_FLAG_HEADER)
+
+/**
+ * @brief Header of the shared-memory segment, placed at offset 0.
+ * head and tail are free-running counters; (head - tail) is the number of slots in use.
+ */
+typedef struct
+{
+  guint32 magic;
+  guint32 version;
+  guint32 num_slots;
+  guint32 reserved;
+  guint64 slot_size; /**< max size of tensor data in a slot */
+  guint64 slot_stride; /**< size of a slot including the slot header */
+  guint head; /**< number of slots published by the producer */
+  guint tail; /**< number of slots released by the consumer */
+  gint data_bell; /**< doorbell (futex word) rung when a slot is published or EOS */
+  gint space_bell; /**< doorbell (futex word) rung when a slot is released */
+  gint eos;
+} GstTensorShmHeader;
+
+/**
+ * @brief Header of each slot. The caps string is updated only when the caps of the slot is changed.
+ */
+typedef struct
+{
+  guint32 caps_seq;
+  guint32 num_mems;
+  guint64 pts;
+  guint64 dts;
+  guint64 duration;
+  guint64 offset;
+  guint64 offset_end;
+  guint32 flags;
+  guint32 reserved;
+  guint64 mem_size[NNS_TENSOR_SIZE_LIMIT];
+  gchar caps[GST_TENSOR_SHM_CAPS_LEN];
+} GstTensorShmSlot;
+
+/**
+ * @brief Process-local handle of the channel.
+ */
+struct _GstTensorShm
+{
+  gint refcount;
+  gchar *name;
+  gboolean is_producer;
+  gint flushing;
+
+  gpointer map;
+  gsize map_size;
+  GstTensorShmHeader *header;
+  guint8 *slots;
+
+  /* producer */
+  guint32 caps_seq;
+  gchar *caps_str;
+
+  /* consumer */
+  GMutex lock;
+  gsize slot_size; /**< slot size validated when opening the segment */
+  guint read_pos;
+  guint32 last_caps_seq;
+  gboolean *released;
+};
+
+/**
+ * @brief Slot reference shared by the memories of a buffer from the consumer.
+ */
+typedef struct
+{
+  GstTensorShm *shm;
+  guint index;
+  gint refcount;
+} GstTensorShmSlotRef;
+
+/**
+ * @brief Wait until the doorbell is rung (or timeout).
+ */
+static void
+_shm_bell_wait (gint * bell, gint val)
+{
+#if defined(__linux__)
+  struct timespec ts;
+
+  ts.tv_sec = GST_TENSOR_SHM_WAIT_US / G_USEC_PER_SEC;
+  ts.tv_nsec = (GST_TENSOR_SHM_WAIT_US % G_USEC_PER_SEC) * 1000;
+
+  /* shared futex (not private), the word is in the mapped segment. */
+  syscall (SYS_futex, bell, FUTEX_WAIT, val, &ts, NULL, 0);
+#else
+  if (g_atomic_int_get (bell) == val)
+    g_usleep (1000);
+#endif
+}
+
+/**
+ * @brief Ring the doorbell and wake up the waiters.
+ */
+static void
+_shm_bell_ring (gint * bell)
+{
+  g_atomic_int_inc (bell);
+#if defined(__linux__)
+  syscall (SYS_futex, bell, FUTEX_WAKE, G_MAXINT, NULL, NULL, 0);
+#endif
+}
+
+/**
+ * @brief Get the slot at the given position.
+ */
+static inline GstTensorShmSlot *
+_shm_get_slot (GstTensorShm * shm, guint pos)
+{
+  GstTensorShmHeader *hdr = shm->header;
+
+  return (GstTensorShmSlot *) (shm->slots +
+      (gsize) (pos % hdr->num_slots) * hdr->slot_stride);
+}
+
+/**
+ * @brief Get the data pointer of the slot.
+ */
+static inline guint8 *
+_shm_get_slot_data (GstTensorShmSlot * slot)
+{
+  return ((guint8 *) slot) + GST_TENSOR_SHM_ALIGN (sizeof (GstTensorShmSlot));
+}
+
+/**
+ * @brief Get the size of the segment.
+ */
+static gsize
+_shm_get_total_size (guint num_slots, guint64 slot_stride)
+{
+  return GST_TENSOR_SHM_ALIGN (sizeof (GstTensorShmHeader)) +
+      (gsize) num_slots * slot_stride;
+}
+
+/**
+ * @brief Allocate the handle and set the pointers of the mapped segment.
+ */
+static GstTensorShm *
+_shm_new_handle (const gchar * name, gpointer map, gsize map_size,
+    gboolean is_producer)
+{
+  GstTensorShm *shm;
+
+  shm = g_new0 (GstTensorShm, 1);
+  shm->refcount = 1;
+  shm->name = g_strdup (name);
+  shm->is_producer = is_producer;
+  shm->map = map;
+  shm->map_size = map_size;
+  shm->header = (GstTensorShmHeader *) map;
+  shm->slots = ((guint8 *) map) +
+      GST_TENSOR_SHM_ALIGN (sizeof (GstTensorShmHeader));
+  g_mutex_init (&shm->lock);
+
+  return shm;
+}
+
+/**
+ * @brief Create (and own) a shared-memory tensor channel. Called by the producer.
+ */
+GstTensorShm *
+gst_tensor_shm_create (const gchar * name, guint num_slots, gsize slot_size)
+{
+  GstTensorShm *shm;
+  GstTensorShmHeader *hdr;
+  guint64 stride;
+  gsize total;
+  gpointer map;
+  int fd;
+
+  g_return_val_if_fail (name != NULL, NULL);
+  g_return_val_if_fail (num_slots > 0, NULL);
+  g_return_val_if_fail (slot_size > 0, NULL);
+
+  stride = GST_TENSOR_SHM_ALIGN (sizeof (GstTensorShmSlot)) +
+      GST_TENSOR_SHM_ALIGN (slot_size);
+  total = _shm_get_total_size (num_slots, stride);
+
+  fd = shm_open (name, O_CREAT | O_RDWR | O_TRUNC, 0600);
+  if (fd < 0) {
+    nns_loge ("Failed to create shared memory %s (%s).", name,
+        g_strerror (errno));
+    return NULL;
+  }
+
+  if (ftruncate (fd, (off_t) total) != 0) {
+    nns_loge ("Failed to resize shared memory %s (%s).", name,
+        g_strerror (errno));
+    close (fd);
+    shm_unlink (name);
+    return NULL;
+  }
+
+  map = mmap (NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (map == MAP_FAILED) {
+    nns_loge ("Failed to map shared memory %s (%s).", name,
+        g_strerror (errno));
+    shm_unlink (name);
+    return NULL;
+  }
+
+  shm = _shm_new_handle (name, map, total, TRUE);
+  hdr = shm->header;
+
+  hdr->version = GST_TENSOR_SHM_VERSION;
+  hdr->num_slots = num_slots;
+  hdr->slot_size = GST_TENSOR_SHM_ALIGN (slot_size);
+  hdr->slot_stride = stride;
+  hdr->head = hdr->tail = 0;
+  hdr->eos = 0;
+
+  /* Publish the header at last, the consumer checks the magic number. */
+  g_atomic_int_set ((gint *) & hdr->magic, (gint) GST_TENSOR_SHM_MAGIC);
+  return shm;
+}
+
+/**
+ * @brief Attach to the shared-memory tensor channel created by the producer.
+ */
+GstTensorShm *
+gst_tensor_shm_open (const gchar * name)
+{
+  GstTensorShm *shm;
+  GstTensorShmHeader *hdr;
+  struct stat st;
+  gpointer map;
+  int fd;
+
+  g_return_val_if_fail (name != NULL, NULL);
+
+  fd = shm_open (name, O_RDWR, 0);
+  if (fd < 0)
+    return NULL;
+
+  if (fstat (fd, &st) != 0 ||
+      (gsize) st.st_size < GST_TENSOR_SHM_ALIGN (sizeof (GstTensorShmHeader))) {
+    /* The producer has not initialized the segment yet. */
+    close (fd);
+    return NULL;
+  }
+
+  map = mmap (NULL, (gsize) st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+      fd, 0);
+  close (fd);
+
+  if (map == MAP_FAILED)
+    return NULL;
+
+  hdr = (GstTensorShmHeader *) map;
+  if ((guint32) g_atomic_int_get ((gint *) & hdr->magic) != GST_TENSOR_SHM_MAGIC
+      || hdr->version != GST_TENSOR_SHM_VERSION || hdr->num_slots == 0
+      || hdr->slot_stride < GST_TENSOR_SHM_ALIGN (sizeof (GstTensorShmSlot))
+      || hdr->slot_stride > (guint64) st.st_size
+      || hdr->slot_size >
+      hdr->slot_stride - GST_TENSOR_SHM_ALIGN (sizeof (GstTensorShmSlot))
+      || _shm_get_total_size (hdr->num_slots, hdr->slot_stride) >
+      (gsize) st.st_size) {
+    munmap (map, (gsize) st.st_size);
+    return NULL;
+  }
+
+  shm = _shm_new_handle (name, map, (gsize) st.st_size, FALSE);
+  shm->released = g_new0 (gboolean, hdr->num_slots);
+  shm->slot_size = (gsize) hdr->slot_size;
+  shm->read_pos = (guint) g_atomic_int_get (&hdr->tail);
+  shm->last_caps_seq = 0;
+
+  return shm;
+}
+
+/**
+ * @brief Increase the reference count of the channel handle.
+ */
+GstTensorShm *
+gst_tensor_shm_ref (GstTensorShm * shm)
+{
+  g_return_val_if_fail (shm != NULL, NULL);
+
+  g_atomic_int_inc (&shm->refcount);
+  return shm;
+}
+
+/**
+ * @brief Decrease the reference count of the channel handle.
+ */
+void
+gst_tensor_shm_unref (GstTensorShm * shm)
+{
+  g_return_if_fail (shm != NULL);
+
+  if (!g_atomic_int_dec_and_test (&shm->refcount))
+    return;
+
+  if (shm->is_producer) {
+    gst_tensor_shm_set_eos (shm);
+    shm_unlink (shm->name);
+  }
+
+  munmap (shm->map, shm->map_size);
+  g_mutex_clear (&shm->lock);
+  g_free (shm->released);
+  g_free (shm->caps_str);
+  g_free (shm->name);
+  g_free (shm);
+}
+
+/**
+ * @brief Get the maximum size of tensor data in a slot.
+ */
+gsize
+gst_tensor_shm_get_slot_size (GstTensorShm * shm)
+{
+  g_return_val_if_fail (shm != NULL, 0);
+
+  return (gsize) shm->header->slot_size;
+}
+
+/**
+ * @brief Get the slot size to transfer the static tensors.
+ */
+gsize
+gst_tensor_shm_get_slot_size_from_config (const GstTensorsConfig * config)
+{
+  gsize size = 0;
+  guint i;
+
+  g_return_val_if_fail (config != NULL, 0);
+
+  if (config->format != _NNS_TENSOR_FORMAT_STATIC ||
+      !gst_tensors_config_validate (config))
+    return 0;
+
+  for (i = 0; i < config->info.num_tensors; i++)
+    size += GST_TENSOR_SHM_ALIGN (gst_tensor_info_get_size (&config->info.info[i]));
+
+  return size;
+}
+
+/**
+ * @brief Set the caps of the following buffers. Called by the producer.
+ */
+gboolean
+gst_tensor_shm_set_caps (GstTensorShm * shm, GstCaps * caps)
+{
+  gchar *str;
+
+  g_return_val_if_fail (shm != NULL, FALSE);
+  g_return_val_if_fail (shm->is_producer, FALSE);
+  g_return_val_if_fail (GST_IS_CAPS (caps), FALSE);
+
+  str = gst_caps_to_string (caps);
+  if (strlen (str) >= GST_TENSOR_SHM_CAPS_LEN) {
+    nns_loge ("The caps string is too long (%" G_GSIZE_FORMAT
+        ") for shared memory %s.", strlen (str), shm->name);
+    g_free (str);
+    return FALSE;
+  }
+
+  if (g_strcmp0 (str, shm->caps_str) != 0) {
+    g_free (shm->caps_str);
+    shm->caps_str = str;
+    shm->caps_seq++;
+  } else {
+    g_free (str);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Copy the buffer into the next free slot and ring the doorbell.
+ */
+GstFlowReturn
+gst_tensor_shm_push (GstTensorShm * shm, GstBuffer * buffer)
+{
+  GstTensorShmHeader *hdr;
+  GstTensorShmSlot *slot;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint8 *data;
+  guint head, i, num_mems;
+  gsize offset, total;
+  gint bell;
+
+  g_return_val_if_fail (shm != NULL, GST_FLOW_ERROR);
+  g_return_val_if_fail (shm->is_producer, GST_FLOW_ERROR);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_FLOW_ERROR);
+
+  hdr = shm->header;
+  num_mems = gst_buffer_n_memory (buffer);
+
+  if (num_mems > NNS_TENSOR_SIZE_LIMIT) {
+    nns_loge ("Too many memories (%u) in a buffer.", num_mems);
+    return GST_FLOW_ERROR;
+  }
+
+  for (i = 0, total = 0; i < num_mems; i++) {
+    mem = gst_buffer_peek_memory (buffer, i);
+    total += GST_TENSOR_SHM_ALIGN (gst_memory_get_sizes (mem, NULL, NULL));
+  }
+
+  if (total > hdr->slot_size) {
+    nns_loge ("The buffer (%" G_GSIZE_FORMAT " bytes) exceeds the slot size (%"
+        G_GSIZE_FORMAT " bytes) of %s.", total, (gsize) hdr->slot_size,
+        shm->name);
+    return GST_FLOW_ERROR;
+  }
+
+  head = hdr->head;
+
+  /* Wait for a free slot. */
+  while (TRUE) {
+    bell = g_atomic_int_get (&hdr->space_bell);
+
+    if (head - (guint) g_atomic_int_get (&hdr->tail) < hdr->num_slots)
+      break;
+
+    if (g_atomic_int_get (&shm->flushing))
+      return GST_FLOW_FLUSHING;
+
+    _shm_bell_wait (&hdr->space_bell, bell);
+  }
+
+  slot = _shm_get_slot (shm, head);
+  data = _shm_get_slot_data (slot);
+
+  for (i = 0, offset = 0; i < num_mems; i++) {
+    mem = gst_buffer_peek_memory (buffer, i);
+
+    if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+      nns_loge ("Failed to map the memory (%u) to publish.", i);
+      return GST_FLOW_ERROR;
+    }
+
+    nns_memcpy (data + offset, map.data, map.size);
+    slot->mem_size[i] = map.size;
+    offset += GST_TENSOR_SHM_ALIGN (map.size);
+
+    gst_memory_unmap (mem, &map);
+  }
+
+  /* Update caps string only when this slot has old one. */
+  if (slot->caps_seq != shm->caps_seq && shm->caps_str) {
+    g_strlcpy (slot->caps, shm->caps_str, GST_TENSOR_SHM_CAPS_LEN);
+    slot->caps_seq = shm->caps_seq;
+  }
+
+  slot->num_mems = num_mems;
+  slot->pts = GST_BUFFER_PTS (buffer);
+  slot->dts = GST_BUFFER_DTS (buffer);
+  slot->duration = GST_BUFFER_DURATION (buffer);
+  slot->offset = GST_BUFFER_OFFSET (buffer);
+  slot->offset_end = GST_BUFFER_OFFSET_END (buffer);
+  slot->flags = GST_BUFFER_FLAGS (buffer);
+
+  g_atomic_int_set (&hdr->head, head + 1);
+  _shm_bell_ring (&hdr->data_bell);
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Release the slot and advance the tail over the released slots.
+ */
+static void
+_shm_release_slot (GstTensorShm * shm, guint pos)
+{
+  GstTensorShmHeader *hdr = shm->header;
+  guint tail;
+
+  g_mutex_lock (&shm->lock);
+
+  shm->released[pos % hdr->num_slots] = TRUE;
+
+  /* Downstream may free the buffers out of order. */
+  tail = hdr->tail;
+  while (tail != shm->read_pos && shm->released[tail % hdr->num_slots]) {
+    shm->released[tail % hdr->num_slots] = FALSE;
+    tail++;
+  }
+
+  g_atomic_int_set (&hdr->tail, tail);
+  g_mutex_unlock (&shm->lock);
+
+  _shm_bell_ring (&hdr->space_bell);
+}
+
+/**
+ * @brief Callback to release the slot when all memories of the buffer are freed.
+ */
+static void
+_shm_slot_ref_free (gpointer data)
+{
+  GstTensorShmSlotRef *ref = (GstTensorShmSlotRef *) data;
+
+  if (!g_atomic_int_dec_and_test (&ref->refcount))
+    return;
+
+  _shm_release_slot (ref->shm, ref->index);
+  gst_tensor_shm_unref (ref->shm);
+  g_free (ref);
+}
+
+/**
+ * @brief Get the next buffer from the channel. Called by the consumer.
+ */
+GstFlowReturn
+gst_tensor_shm_pull (GstTensorShm * shm, GstBuffer ** buffer, GstCaps ** caps)
+{
+  GstTensorShmHeader *hdr;
+  GstTensorShmSlot *slot;
+  GstTensorShmSlotRef *ref;
+  GstBuffer *buf;
+  GstMemory *mem;
+  guint8 *data;
+  guint i, pos, num_mems;
+  gsize offset, total;
+  gsize mem_size[NNS_TENSOR_SIZE_LIMIT];
+  gint bell;
+
+  g_return_val_if_fail (shm != NULL, GST_FLOW_ERROR);
+  g_return_val_if_fail (!shm->is_producer, GST_FLOW_ERROR);
+  g_return_val_if_fail (buffer != NULL, GST_FLOW_ERROR);
+  g_return_val_if_fail (caps != NULL, GST_FLOW_ERROR);
+
+  hdr = shm->header;
+  pos = shm->read_pos;
+  *buffer = NULL;
+  *caps = NULL;
+
+  /* Wait for a published slot. */
+  while (TRUE) {
+    bell = g_atomic_int_get (&hdr->data_bell);
+
+    if ((guint) g_atomic_int_get (&hdr->head) != pos)
+      break;
+
+    if (g_atomic_int_get (&hdr->eos))
+      return GST_FLOW_EOS;
+
+    if (g_atomic_int_get (&shm->flushing))
+      return GST_FLOW_FLUSHING;
+
+    _shm_bell_wait (&hdr->data_bell, bell);
+  }
+
+  slot = _shm_get_slot (shm, pos);
+  data = _shm_get_slot_data (slot);
+
+  /**
+   * The slot header is written by the other process.
+   * Take a copy of the sizes and do not read past the slot.
+   */
+  num_mems = slot->num_mems;
+  if (num_mems > NNS_TENSOR_SIZE_LIMIT) {
+    nns_loge ("Invalid slot (%u memories) in shared memory %s.",
+        num_mems, shm->name);
+    return GST_FLOW_ERROR;
+  }
+
+  for (i = 0, total = 0; i < num_mems; i++) {
+    mem_size[i] = (gsize) slot->mem_size[i];
+
+    if (mem_size[i] > shm->slot_size) {
+      total = G_MAXSIZE;
+      break;
+    }
+
+    total += GST_TENSOR_SHM_ALIGN (mem_size[i]);
+  }
+
+  if (total > shm->slot_size) {
+    nns_loge ("Invalid slot (memory size exceeds the slot size %"
+        G_GSIZE_FORMAT ") in shared memory %s.", shm->slot_size, shm->name);
+    return GST_FLOW_ERROR;
+  }
+
+  if (slot->caps_seq != shm->last_caps_seq) {
+    gchar caps_str[GST_TENSOR_SHM_CAPS_LEN];
+
+    g_strlcpy (caps_str, slot->caps, GST_TENSOR_SHM_CAPS_LEN);
+    *caps = gst_caps_from_string (caps_str);
+    shm->last_caps_seq = slot->caps_seq;
+  }
+
+  buf = gst_buffer_new ();
+
+  ref = g_new0 (GstTensorShmSlotRef, 1);
+  ref->shm = gst_tensor_shm_ref (shm);
+  ref->index = pos;
+  ref->refcount = (gint) num_mems + 1;
+
+  for (i = 0, offset = 0; i < num_mems; i++) {
+    gsize size = mem_size[i];
+
+    /* Wrap the slot (zero-copy), the memory is read-only. */
+    mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, data + offset,
+        size, 0, size, ref, _shm_slot_ref_free);
+    gst_buffer_append_memory (buf, mem);
+
+    offset += GST_TENSOR_SHM_ALIGN (size);
+  }
+
+  GST_BUFFER_PTS (buf) = slot->pts;
+  GST_BUFFER_DTS (buf) = slot->dts;
+  GST_BUFFER_DURATION (buf) = slot->duration;
+  GST_BUFFER_OFFSET (buf) = slot->offset;
+  GST_BUFFER_OFFSET_END (buf) = slot->offset_end;
+  GST_BUFFER_FLAG_SET (buf, slot->flags & GST_TENSOR_SHM_BUFFER_FLAGS);
+
+  g_mutex_lock (&shm->lock);
+  shm->read_pos = pos + 1;
+  g_mutex_unlock (&shm->lock);
+
+  /* Drop the reference of this function (empty buffer releases the slot here). */
+  _shm_slot_ref_free (ref);
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Set EOS (End-of-Stream) of the channel.
+ */
+void
+gst_tensor_shm_set_eos (GstTensorShm * shm)
+{
+  g_return_if_fail (shm != NULL);
+
+  g_atomic_int_set (&shm->header->eos, 1);
+  _shm_bell_ring (&shm->header->data_bell);
+}
+
+/**
+ * @brief Interrupt (or resume) the blocking calls of this handle.
+ */
+void
+gst_tensor_shm_set_flushing (GstTensorShm * shm, gboolean flushing)
+{
+  g_return_if_fail (shm != NULL);
+
+  g_atomic_int_set (&shm->flushing, flushing ? 1 : 0);
+
+  if (flushing) {
+    /* Wake up the waiters of this process. */
+    _shm_bell_ring (&shm->header->data_bell);
+    _shm_bell_ring (&shm->header->space_bell);
+  }
+}
@@ -0,0 +1,132 @@
+/**
+ * NNStreamer Tensor Shared-Memory Channel Header
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ */
+/**
+ * @file	tensor_shm.h
+ * @date	18 Oct 2026
+ * @brief	Inter-process tensor channel (shared-memory ring of tensor slots) for tensor_shmsink and tensor_shmsrc
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ *
+ * The channel is a named POSIX shared-memory segment with a header and a
+ * fixed number of tensor slots. One producer (tensor_shmsink) publishes slots
+ * and one consumer (tensor_shmsrc) releases them, so the ring is lock-free
+ * across processes (single-producer / single-consumer). On Linux, a futex in
+ * the segment is used as a doorbell; on other platforms the waiters poll.
+ */
+#ifndef __GST_TENSOR_SHM_H__
+#define __GST_TENSOR_SHM_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+
+#include "tensor_common.h"
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The maximum length of the caps string stored in each slot.
+ */
+#define GST_TENSOR_SHM_CAPS_LEN (1024)
+
+/**
+ * @brief Opaque handle of the shared-memory tensor channel.
+ */
+typedef struct _GstTensorShm GstTensorShm;
+
+/**
+ * @brief Create (and own) a shared-memory tensor channel. Called by the producer.
+ * @param name The name of the shared-memory segment. (e.g., "/nns-shm-0")
+ * @param num_slots The number of tensor slots in the ring.
+ * @param slot_size The maximum size of tensor data in a slot.
+ * @return Newly created channel. NULL if failed.
+ */
+extern GstTensorShm *
+gst_tensor_shm_create (const gchar * name, guint num_slots, gsize slot_size);
+
+/**
+ * @brief Attach to the shared-memory tensor channel created by the producer.
+ * @param name The name of the shared-memory segment.
+ * @return The channel handle. NULL if the channel does not exist yet.
+ */
+extern GstTensorShm *
+gst_tensor_shm_open (const gchar * name);
+
+/**
+ * @brief Increase the reference count of the channel handle.
+ */
+extern GstTensorShm *
+gst_tensor_shm_ref (GstTensorShm * shm);
+
+/**
+ * @brief Decrease the reference count of the channel handle. The producer unlinks the segment when the handle is released.
+ */
+extern void
+gst_tensor_shm_unref (GstTensorShm * shm);
+
+/**
+ * @brief Get the maximum size of tensor data in a slot.
+ */
+extern gsize
+gst_tensor_shm_get_slot_size (GstTensorShm * shm);
+
+/**
+ * @brief Get the slot size to transfer the static tensors.
+ * @return The slot size, 0 if the config is not static.
+ */
+extern gsize
+gst_tensor_shm_get_slot_size_from_config (const GstTensorsConfig * config);
+
+/**
+ * @brief Set the caps of the following buffers. Called by the producer.
+ * @return TRUE if the caps can be delivered through the channel.
+ */
+extern gboolean
+gst_tensor_shm_set_caps (GstTensorShm * shm, GstCaps * caps);
+
+/**
+ * @brief Copy the buffer into the next free slot and ring the doorbell.
+ * Blocks while the ring is full.
+ * @return GST_FLOW_OK if the buffer is published, GST_FLOW_FLUSHING if interrupted.
+ */
+extern GstFlowReturn
+gst_tensor_shm_push (GstTensorShm * shm, GstBuffer * buffer);
+
+/**
+ * @brief Get the next buffer from the channel. Called by the consumer.
+ * The memories of the buffer refer the slot directly (read-only) and the slot is released when the buffer is freed.
+ * @param[out] buffer The buffer of the next slot.
+ * @param[out] caps Newly allocated caps if the caps is changed, otherwise NULL.
+ * @return GST_FLOW_OK, GST_FLOW_EOS, or GST_FLOW_FLUSHING if interrupted.
+ */
+extern GstFlowReturn
+gst_tensor_shm_pull (GstTensorShm * shm, GstBuffer ** buffer, GstCaps ** caps);
+
+/**
+ * @brief Set EOS (End-of-Stream) of the channel.
+ */
+extern void
+gst_tensor_shm_set_eos (GstTensorShm * shm);
+
+/**
+ * @brief Interrupt (or resume) the blocking calls of this handle.
+ */
+extern void
+gst_tensor_shm_set_flushing (GstTensorShm * shm, gboolean flushing);
+
+G_END_DECLS
+
+#endif /* __GST_TENSOR_SHM_H__ */
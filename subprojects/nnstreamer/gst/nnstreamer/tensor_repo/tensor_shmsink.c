@@ -0,0 +1,461 @@
+/**
+ * GStreamer
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ */
+
+/**
+ * SECTION: element-tensor_shmsink
+ *
+ * Sink element to publish tensors to tensor_shmsrc in other processes.
+ * Unlike tensor_reposink, the tensors are copied once into a shared-memory ring
+ * and tensor_shmsrc maps the slots without copy.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 videotestsrc ! tensor_converter ! tensor_shmsink shm-name=/nns-cam0
+ * gst-launch-1.0 tensor_shmsrc shm-name=/nns-cam0 ! tensor_sink
+ * ]|
+ * </refsect2>
+ *
+ * @file	tensor_shmsink.c
+ * @date	18 Oct 2026
+ * @brief	GStreamer plugin to publish tensors to other processes through shared memory
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <nnstreamer_util.h>
+
+#include "tensor_shmsink.h"
+
+/**
+ * @brief Macro for debug mode.
+ */
+#ifndef DBG
+#define DBG (!self->silent)
+#endif
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_shmsink_debug);
+#define GST_CAT_DEFAULT gst_tensor_shmsink_debug
+
+/**
+ * @brief tensor_shmsink properties
+ */
+enum
+{
+  PROP_0,
+  PROP_SHM_NAME,
+  PROP_NUM_SLOTS,
+  PROP_SLOT_SIZE,
+  PROP_SILENT
+};
+
+#define DEFAULT_SHM_NAME "/nnstreamer-tensor-shm"
+#define DEFAULT_NUM_SLOTS 8
+#define DEFAULT_SLOT_SIZE 0
+#define DEFAULT_SILENT TRUE
+
+static void gst_tensor_shmsink_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_tensor_shmsink_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_tensor_shmsink_finalize (GObject * object);
+
+static gboolean gst_tensor_shmsink_start (GstBaseSink * sink);
+static gboolean gst_tensor_shmsink_stop (GstBaseSink * sink);
+static gboolean gst_tensor_shmsink_unlock (GstBaseSink * sink);
+static gboolean gst_tensor_shmsink_unlock_stop (GstBaseSink * sink);
+static gboolean gst_tensor_shmsink_event (GstBaseSink * sink,
+    GstEvent * event);
+static GstFlowReturn gst_tensor_shmsink_render (GstBaseSink * sink,
+    GstBuffer * buffer);
+static gboolean gst_tensor_shmsink_set_caps (GstBaseSink * sink,
+    GstCaps * caps);
+
+#define gst_tensor_shmsink_parent_class parent_class
+G_DEFINE_TYPE (GstTensorShmSink, gst_tensor_shmsink, GST_TYPE_BASE_SINK);
+
+/**
+ * @brief class initialization of tensor_shmsink
+ */
+static void
+gst_tensor_shmsink_class_init (GstTensorShmSinkClass * klass)
+{
+  GObjectClass *gobject_class;
+  GstElementClass *element_class;
+  GstBaseSinkClass *basesink_class;
+  GstPadTemplate *pad_template;
+  GstCaps *pad_caps;
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_shmsink_debug, "tensor_shmsink", 0,
+      "Sink element to publish tensors through shared memory");
+
+  gobject_class = G_OBJECT_CLASS (klass);
+  element_class = GST_ELEMENT_CLASS (klass);
+  basesink_class = GST_BASE_SINK_CLASS (klass);
+
+  gobject_class->set_property = gst_tensor_shmsink_set_property;
+  gobject_class->get_property = gst_tensor_shmsink_get_property;
+  gobject_class->finalize = gst_tensor_shmsink_finalize;
+
+  g_object_class_install_property (gobject_class, PROP_SHM_NAME,
+      g_param_spec_string ("shm-name", "Shared memory name",
+          "The name of shared memory segment (shared with tensor_shmsrc)",
+          DEFAULT_SHM_NAME, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_SLOTS,
+      g_param_spec_uint ("num-slots", "Number of slots",
+          "The number of tensor slots in the shared-memory ring",
+          2, 1024, DEFAULT_NUM_SLOTS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_SLOT_SIZE,
+      g_param_spec_uint64 ("slot-size", "Slot size",
+          "The max size of tensor data in a slot. "
+          "0 to get the size from static tensor caps, "
+          "this must be set for flexible and sparse tensors",
+          0, G_MAXUINT64, DEFAULT_SLOT_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_SILENT,
+      g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
+          DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gst_element_class_set_static_metadata (element_class,
+      "TensorShmSink",
+      "Sink/Tensor/Repository",
+      "Publish tensors to other processes through shared memory",
+      "Samsung Electronics Co., Ltd.");
+
+  /* pad template */
+  pad_caps = gst_caps_from_string (GST_TENSOR_CAP_DEFAULT "; "
+      GST_TENSORS_CAP_MAKE (GST_TENSOR_FORMAT_ALL));
+  pad_template = gst_pad_template_new ("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+      pad_caps);
+  gst_element_class_add_pad_template (element_class, pad_template);
+  gst_caps_unref (pad_caps);
+
+  basesink_class->start = GST_DEBUG_FUNCPTR (gst_tensor_shmsink_start);
+  basesink_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_shmsink_stop);
+  basesink_class->unlock = GST_DEBUG_FUNCPTR (gst_tensor_shmsink_unlock);
+  basesink_class->unlock_stop =
+      GST_DEBUG_FUNCPTR (gst_tensor_shmsink_unlock_stop);
+  basesink_class->event = GST_DEBUG_FUNCPTR (gst_tensor_shmsink_event);
+  basesink_class->render = GST_DEBUG_FUNCPTR (gst_tensor_shmsink_render);
+  basesink_class->set_caps = GST_DEBUG_FUNCPTR (gst_tensor_shmsink_set_caps);
+}
+
+/**
+ * @brief initialization of tensor_shmsink
+ */
+static void
+gst_tensor_shmsink_init (GstTensorShmSink * self)
+{
+  GstBaseSink *basesink;
+
+  basesink = GST_BASE_SINK (self);
+
+  self->silent = DEFAULT_SILENT;
+  self->shm_name = g_strdup (DEFAULT_SHM_NAME);
+  self->num_slots = DEFAULT_NUM_SLOTS;
+  self->slot_size = DEFAULT_SLOT_SIZE;
+  self->shm = NULL;
+
+  /* ignore sync and preroll, tensors are consumed in other process */
+  gst_base_sink_set_sync (basesink, FALSE);
+  gst_base_sink_set_async_enabled (basesink, FALSE);
+}
+
+/**
+ * @brief set property vmethod
+ */
+static void
+gst_tensor_shmsink_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorShmSink *self;
+
+  self = GST_TENSOR_SHMSINK (object);
+
+  switch (prop_id) {
+    case PROP_SHM_NAME:
+      g_free (self->shm_name);
+      self->shm_name = g_value_dup_string (value);
+      break;
+    case PROP_NUM_SLOTS:
+      self->num_slots = g_value_get_uint (value);
+      break;
+    case PROP_SLOT_SIZE:
+      self->slot_size = g_value_get_uint64 (value);
+      break;
+    case PROP_SILENT:
+      self->silent = g_value_get_boolean (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief get property vmethod
+ */
+static void
+gst_tensor_shmsink_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorShmSink *self;
+
+  self = GST_TENSOR_SHMSINK (object);
+
+  switch (prop_id) {
+    case PROP_SHM_NAME:
+      g_value_set_string (value, self->shm_name);
+      break;
+    case PROP_NUM_SLOTS:
+      g_value_set_uint (value, self->num_slots);
+      break;
+    case PROP_SLOT_SIZE:
+      g_value_set_uint64 (value, self->slot_size);
+      break;
+    case PROP_SILENT:
+      g_value_set_boolean (value, self->silent);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief finalize vmethod implementation
+ */
+static void
+gst_tensor_shmsink_finalize (GObject * object)
+{
+  GstTensorShmSink *self;
+
+  self = GST_TENSOR_SHMSINK (object);
+
+  g_free (self->shm_name);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Create the shared-memory channel.
+ */
+static gboolean
+gst_tensor_shmsink_open (GstTensorShmSink * self, gsize slot_size)
+{
+  GstTensorShm *shm;
+
+  if (!self->shm_name || self->shm_name[0] != '/') {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS,
+        ("Invalid shared memory name '%s', it should start with '/'.",
+            GST_STR_NULL (self->shm_name)), (NULL));
+    return FALSE;
+  }
+
+  shm = gst_tensor_shm_create (self->shm_name, self->num_slots, slot_size);
+  if (!shm) {
+    GST_ELEMENT_ERROR (self, RESOURCE, OPEN_WRITE,
+        ("Cannot create shared memory %s.", self->shm_name), (NULL));
+    return FALSE;
+  }
+
+  GST_OBJECT_LOCK (self);
+  self->shm = shm;
+  GST_OBJECT_UNLOCK (self);
+
+  silent_debug (self, "Created shared memory %s (%u slots, %" G_GSIZE_FORMAT
+      " bytes)", self->shm_name, self->num_slots, slot_size);
+  return TRUE;
+}
+
+/**
+ * @brief Release the shared-memory channel.
+ */
+static void
+gst_tensor_shmsink_close (GstTensorShmSink * self)
+{
+  GstTensorShm *shm;
+
+  GST_OBJECT_LOCK (self);
+  shm = self->shm;
+  self->shm = NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (shm)
+    gst_tensor_shm_unref (shm);
+}
+
+/**
+ * @brief start vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsink_start (GstBaseSink * sink)
+{
+  GstTensorShmSink *self;
+
+  self = GST_TENSOR_SHMSINK (sink);
+
+  /* If slot-size is not given, create the channel with the caps. */
+  if (self->slot_size > 0)
+    return gst_tensor_shmsink_open (self, (gsize) self->slot_size);
+
+  return TRUE;
+}
+
+/**
+ * @brief stop vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsink_stop (GstBaseSink * sink)
+{
+  gst_tensor_shmsink_close (GST_TENSOR_SHMSINK (sink));
+  return TRUE;
+}
+
+/**
+ * @brief unlock vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsink_unlock (GstBaseSink * sink)
+{
+  GstTensorShmSink *self;
+
+  self = GST_TENSOR_SHMSINK (sink);
+
+  GST_OBJECT_LOCK (self);
+  if (self->shm)
+    gst_tensor_shm_set_flushing (self->shm, TRUE);
+  GST_OBJECT_UNLOCK (self);
+
+  return TRUE;
+}
+
+/**
+ * @brief unlock_stop vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsink_unlock_stop (GstBaseSink * sink)
+{
+  GstTensorShmSink *self;
+
+  self = GST_TENSOR_SHMSINK (sink);
+
+  GST_OBJECT_LOCK (self);
+  if (self->shm)
+    gst_tensor_shm_set_flushing (self->shm, FALSE);
+  GST_OBJECT_UNLOCK (self);
+
+  return TRUE;
+}
+
+/**
+ * @brief Handle events.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_shmsink_event (GstBaseSink * sink, GstEvent * event)
+{
+  GstTensorShmSink *self;
+
+  self = GST_TENSOR_SHMSINK (sink);
+
+  GST_DEBUG_OBJECT (self, "received event %s", GST_EVENT_TYPE_NAME (event));
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_EOS:
+      if (self->shm)
+        gst_tensor_shm_set_eos (self->shm);
+      break;
+    default:
+      break;
+  }
+
+  return GST_BASE_SINK_CLASS (parent_class)->event (sink, event);
+}
+
+/**
+ * @brief render vmethod implementation
+ */
+static GstFlowReturn
+gst_tensor_shmsink_render (GstBaseSink * sink, GstBuffer * buffer)
+{
+  GstTensorShmSink *self;
+  GstFlowReturn ret;
+
+  self = GST_TENSOR_SHMSINK (sink);
+
+  if (!self->shm) {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION,
+        ("Shared memory is not ready, caps are not negotiated."), (NULL));
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  ret = gst_tensor_shm_push (self->shm, buffer);
+  if (ret == GST_FLOW_ERROR) {
+    GST_ELEMENT_ERROR (self, RESOURCE, WRITE,
+        ("Cannot publish the buffer into shared memory %s.", self->shm_name),
+        (NULL));
+  }
+
+  return ret;
+}
+
+/**
+ * @brief set_caps vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsink_set_caps (GstBaseSink * sink, GstCaps * caps)
+{
+  GstTensorShmSink *self;
+  GstTensorsConfig config;
+  GstStructure *structure;
+  gsize size;
+
+  self = GST_TENSOR_SHMSINK (sink);
+  silent_debug_caps (self, caps, "set caps");
+
+  structure = gst_caps_get_structure (caps, 0);
+  gst_tensors_config_from_structure (&config, structure);
+  size = gst_tensor_shm_get_slot_size_from_config (&config);
+  gst_tensors_config_free (&config);
+
+  if (self->shm) {
+    if (size > gst_tensor_shm_get_slot_size (self->shm)) {
+      GST_ERROR_OBJECT (self, "The size of tensors (%" G_GSIZE_FORMAT
+          ") exceeds the slot size.", size);
+      return FALSE;
+    }
+  } else {
+    if (size == 0) {
+      GST_ERROR_OBJECT (self,
+          "Cannot get the size of tensors, set the property slot-size.");
+      return FALSE;
+    }
+
+    if (!gst_tensor_shmsink_open (self, size))
+      return FALSE;
+  }
+
+  return gst_tensor_shm_set_caps (self->shm, caps);
+}
@@ -0,0 +1,82 @@
+/**
+ * GStreamer
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ */
+
+/**
+ * @file	tensor_shmsink.h
+ * @date	18 Oct 2026
+ * @brief	GStreamer plugin to publish tensors to other processes through shared memory
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_SHMSINK_H__
+#define __GST_TENSOR_SHMSINK_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstbasesink.h>
+
+#include "tensor_shm.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_SHMSINK \
+  (gst_tensor_shmsink_get_type())
+#define GST_TENSOR_SHMSINK(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_SHMSINK,GstTensorShmSink))
+#define GST_TENSOR_SHMSINK_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_SHMSINK,GstTensorShmSinkClass))
+#define GST_IS_TENSOR_SHMSINK(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_SHMSINK))
+#define GST_IS_TENSOR_SHMSINK_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_SHMSINK))
+
+typedef struct _GstTensorShmSink GstTensorShmSink;
+typedef struct _GstTensorShmSinkClass GstTensorShmSinkClass;
+
+/**
+ * @brief GstTensorShmSink data structure.
+ *
+ * GstTensorShmSink inherits GstBaseSink.
+ */
+struct _GstTensorShmSink
+{
+  GstBaseSink element;
+
+  gboolean silent;
+  gchar *shm_name; /**< the name of shared-memory segment */
+  guint num_slots; /**< the number of slots in the ring */
+  guint64 slot_size; /**< the max size of tensor data in a slot (0 to get it from caps) */
+  GstTensorShm *shm; /**< shared-memory channel */
+};
+
+/**
+ * @brief GstTensorShmSinkClass data structure.
+ *
+ * GstTensorShmSink inherits GstBaseSink.
+ */
+struct _GstTensorShmSinkClass
+{
+  GstBaseSinkClass parent_class;
+};
+
+/**
+ * @brief Function to get type of tensor_shmsink.
+ */
+GType gst_tensor_shmsink_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_TENSOR_SHMSINK_H__ */
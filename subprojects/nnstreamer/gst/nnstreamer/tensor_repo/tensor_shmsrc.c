@@ -0,0 +1,354 @@
+/**
+ * GStreamer
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ */
+
+/**
+ * SECTION: element-tensor_shmsrc
+ *
+ * Source element to receive tensors from tensor_shmsink in other process.
+ * The output buffers refer the shared-memory slots (read-only) without copy,
+ * and the caps is updated with the caps of tensor_shmsink.
+ *
+ * @file	tensor_shmsrc.c
+ * @date	18 Oct 2026
+ * @brief	GStreamer plugin to receive tensors from other processes through shared memory
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <nnstreamer_util.h>
+
+#include "tensor_shmsrc.h"
+
+/**
+ * @brief Macro for debug mode.
+ */
+#ifndef DBG
+#define DBG (!self->silent)
+#endif
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_shmsrc_debug);
+#define GST_CAT_DEFAULT gst_tensor_shmsrc_debug
+
+/**
+ * @brief tensor_shmsrc properties
+ */
+enum
+{
+  PROP_0,
+  PROP_SHM_NAME,
+  PROP_SILENT
+};
+
+#define DEFAULT_SHM_NAME "/nnstreamer-tensor-shm"
+#define DEFAULT_SILENT TRUE
+
+/**
+ * @brief Interval (in microseconds) to check the shared memory is created.
+ */
+#define SHM_OPEN_INTERVAL_US (10 * 1000)
+
+static void gst_tensor_shmsrc_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_tensor_shmsrc_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_tensor_shmsrc_finalize (GObject * object);
+static gboolean gst_tensor_shmsrc_start (GstBaseSrc * src);
+static gboolean gst_tensor_shmsrc_stop (GstBaseSrc * src);
+static gboolean gst_tensor_shmsrc_unlock (GstBaseSrc * src);
+static gboolean gst_tensor_shmsrc_unlock_stop (GstBaseSrc * src);
+static gboolean gst_tensor_shmsrc_negotiate (GstBaseSrc * src);
+static GstFlowReturn gst_tensor_shmsrc_create (GstPushSrc * src,
+    GstBuffer ** buffer);
+
+#define gst_tensor_shmsrc_parent_class parent_class
+G_DEFINE_TYPE (GstTensorShmSrc, gst_tensor_shmsrc, GST_TYPE_PUSH_SRC);
+
+/**
+ * @brief class initialization of tensor_shmsrc
+ */
+static void
+gst_tensor_shmsrc_class_init (GstTensorShmSrcClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstPushSrcClass *pushsrc_class = GST_PUSH_SRC_CLASS (klass);
+  GstBaseSrcClass *basesrc_class = GST_BASE_SRC_CLASS (klass);
+  GstPadTemplate *pad_template;
+  GstCaps *pad_caps;
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_shmsrc_debug, "tensor_shmsrc", 0,
+      "Source element to receive tensors through shared memory");
+
+  gobject_class->set_property = gst_tensor_shmsrc_set_property;
+  gobject_class->get_property = gst_tensor_shmsrc_get_property;
+  gobject_class->finalize = gst_tensor_shmsrc_finalize;
+
+  g_object_class_install_property (gobject_class, PROP_SHM_NAME,
+      g_param_spec_string ("shm-name", "Shared memory name",
+          "The name of shared memory segment (shared with tensor_shmsink)",
+          DEFAULT_SHM_NAME, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_SILENT,
+      g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
+          DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  basesrc_class->start = GST_DEBUG_FUNCPTR (gst_tensor_shmsrc_start);
+  basesrc_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_shmsrc_stop);
+  basesrc_class->unlock = GST_DEBUG_FUNCPTR (gst_tensor_shmsrc_unlock);
+  basesrc_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_tensor_shmsrc_unlock_stop);
+  basesrc_class->negotiate = GST_DEBUG_FUNCPTR (gst_tensor_shmsrc_negotiate);
+  pushsrc_class->create = GST_DEBUG_FUNCPTR (gst_tensor_shmsrc_create);
+
+  gst_element_class_set_static_metadata (element_class,
+      "TensorShmSrc",
+      "Source/Tensor/Repository",
+      "Receive tensors from other processes through shared memory",
+      "Samsung Electronics Co., Ltd.");
+
+  /* pad template */
+  pad_caps = gst_caps_from_string (GST_TENSOR_CAP_DEFAULT "; "
+      GST_TENSORS_CAP_MAKE (GST_TENSOR_FORMAT_ALL));
+  pad_template = gst_pad_template_new ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+      pad_caps);
+  gst_element_class_add_pad_template (element_class, pad_template);
+  gst_caps_unref (pad_caps);
+}
+
+/**
+ * @brief object initialization of tensor_shmsrc
+ */
+static void
+gst_tensor_shmsrc_init (GstTensorShmSrc * self)
+{
+  self->silent = DEFAULT_SILENT;
+  self->shm_name = g_strdup (DEFAULT_SHM_NAME);
+  self->shm = NULL;
+  self->flushing = 0;
+
+  gst_base_src_set_format (GST_BASE_SRC (self), GST_FORMAT_TIME);
+}
+
+/**
+ * @brief object finalize of tensor_shmsrc
+ */
+static void
+gst_tensor_shmsrc_finalize (GObject * object)
+{
+  GstTensorShmSrc *self = GST_TENSOR_SHMSRC (object);
+
+  g_free (self->shm_name);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief set property of tensor_shmsrc
+ */
+static void
+gst_tensor_shmsrc_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorShmSrc *self = GST_TENSOR_SHMSRC (object);
+
+  switch (prop_id) {
+    case PROP_SHM_NAME:
+      g_free (self->shm_name);
+      self->shm_name = g_value_dup_string (value);
+      break;
+    case PROP_SILENT:
+      self->silent = g_value_get_boolean (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief get property of tensor_shmsrc
+ */
+static void
+gst_tensor_shmsrc_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorShmSrc *self = GST_TENSOR_SHMSRC (object);
+
+  switch (prop_id) {
+    case PROP_SHM_NAME:
+      g_value_set_string (value, self->shm_name);
+      break;
+    case PROP_SILENT:
+      g_value_set_boolean (value, self->silent);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief start vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsrc_start (GstBaseSrc * src)
+{
+  GstTensorShmSrc *self = GST_TENSOR_SHMSRC (src);
+
+  if (!self->shm_name || self->shm_name[0] != '/') {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS,
+        ("Invalid shared memory name '%s', it should start with '/'.",
+            GST_STR_NULL (self->shm_name)), (NULL));
+    return FALSE;
+  }
+
+  /* The channel is attached in create(), tensor_shmsink may start later. */
+  return TRUE;
+}
+
+/**
+ * @brief stop vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsrc_stop (GstBaseSrc * src)
+{
+  GstTensorShmSrc *self = GST_TENSOR_SHMSRC (src);
+  GstTensorShm *shm;
+
+  GST_OBJECT_LOCK (self);
+  shm = self->shm;
+  self->shm = NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  /* The buffers in the pipeline hold own reference of the channel. */
+  if (shm)
+    gst_tensor_shm_unref (shm);
+
+  return TRUE;
+}
+
+/**
+ * @brief unlock vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsrc_unlock (GstBaseSrc * src)
+{
+  GstTensorShmSrc *self = GST_TENSOR_SHMSRC (src);
+
+  GST_OBJECT_LOCK (self);
+  g_atomic_int_set (&self->flushing, 1);
+  if (self->shm)
+    gst_tensor_shm_set_flushing (self->shm, TRUE);
+  GST_OBJECT_UNLOCK (self);
+
+  return TRUE;
+}
+
+/**
+ * @brief unlock_stop vmethod implementation
+ */
+static gboolean
+gst_tensor_shmsrc_unlock_stop (GstBaseSrc * src)
+{
+  GstTensorShmSrc *self = GST_TENSOR_SHMSRC (src);
+
+  GST_OBJECT_LOCK (self);
+  g_atomic_int_set (&self->flushing, 0);
+  if (self->shm)
+    gst_tensor_shm_set_flushing (self->shm, FALSE);
+  GST_OBJECT_UNLOCK (self);
+
+  return TRUE;
+}
+
+/**
+ * @brief negotiate vmethod implementation
+ * The caps is given by tensor_shmsink with the first buffer.
+ */
+static gboolean
+gst_tensor_shmsrc_negotiate (GstBaseSrc * src)
+{
+  UNUSED (src);
+  return TRUE;
+}
+
+/**
+ * @brief Wait for tensor_shmsink and attach to the shared memory.
+ */
+static GstFlowReturn
+gst_tensor_shmsrc_attach (GstTensorShmSrc * self)
+{
+  GstTensorShm *shm = NULL;
+
+  while (!shm) {
+    if (g_atomic_int_get (&self->flushing))
+      return GST_FLOW_FLUSHING;
+
+    shm = gst_tensor_shm_open (self->shm_name);
+    if (!shm)
+      g_usleep (SHM_OPEN_INTERVAL_US);
+  }
+
+  GST_OBJECT_LOCK (self);
+  self->shm = shm;
+  if (g_atomic_int_get (&self->flushing))
+    gst_tensor_shm_set_flushing (shm, TRUE);
+  GST_OBJECT_UNLOCK (self);
+
+  silent_debug (self, "Attached to shared memory %s", self->shm_name);
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief create func of tensor_shmsrc
+ */
+static GstFlowReturn
+gst_tensor_shmsrc_create (GstPushSrc * src, GstBuffer ** buffer)
+{
+  GstTensorShmSrc *self = GST_TENSOR_SHMSRC (src);
+  GstBuffer *buf = NULL;
+  GstCaps *caps = NULL;
+  GstFlowReturn ret;
+
+  if (!self->shm) {
+    ret = gst_tensor_shmsrc_attach (self);
+    if (ret != GST_FLOW_OK)
+      return ret;
+  }
+
+  ret = gst_tensor_shm_pull (self->shm, &buf, &caps);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  if (caps) {
+    silent_debug_caps (self, caps, "caps from tensor_shmsink");
+
+    if (!gst_base_src_set_caps (GST_BASE_SRC (self), caps)) {
+      GST_ELEMENT_ERROR (self, CORE, NEGOTIATION,
+          ("Negotiation failed with the caps from tensor_shmsink."), (NULL));
+      gst_caps_unref (caps);
+      gst_buffer_unref (buf);
+      return GST_FLOW_NOT_NEGOTIATED;
+    }
+
+    gst_caps_unref (caps);
+  }
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
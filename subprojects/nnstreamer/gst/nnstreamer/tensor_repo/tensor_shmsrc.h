@@ -0,0 +1,80 @@
+/**
+ * GStreamer
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ */
+
+/**
+ * @file	tensor_shmsrc.h
+ * @date	18 Oct 2026
+ * @brief	GStreamer plugin to receive tensors from other processes through shared memory
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_SHMSRC_H__
+#define __GST_TENSOR_SHMSRC_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstpushsrc.h>
+
+#include "tensor_shm.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_SHMSRC \
+  (gst_tensor_shmsrc_get_type())
+#define GST_TENSOR_SHMSRC(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_SHMSRC,GstTensorShmSrc))
+#define GST_TENSOR_SHMSRC_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_SHMSRC,GstTensorShmSrcClass))
+#define GST_IS_TENSOR_SHMSRC(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_SHMSRC))
+#define GST_IS_TENSOR_SHMSRC_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_SHMSRC))
+
+typedef struct _GstTensorShmSrc GstTensorShmSrc;
+typedef struct _GstTensorShmSrcClass GstTensorShmSrcClass;
+
+/**
+ * @brief GstTensorShmSrc data structure.
+ *
+ * GstTensorShmSrc inherits GstPushSrc
+ */
+struct _GstTensorShmSrc
+{
+  GstPushSrc parent;
+  gboolean silent;
+  gchar *shm_name; /**< the name of shared-memory segment */
+  GstTensorShm *shm; /**< shared-memory channel */
+  gint flushing;
+};
+
+/**
+ * @brief GstTensorShmSrcClass data structure.
+ *
+ * GstTensorShmSrc inherits GstPushSrc
+ */
+struct _GstTensorShmSrcClass
+{
+  GstPushSrcClass parent_class;
+};
+
+/**
+ * @brief Function to get type of tensor_shmsrc.
+ */
+GType gst_tensor_shmsrc_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_TENSOR_SHMSRC_H__ */
@@ -32,6 +32,7 @@
 #include <config.h>
 #endif
 
+#include <string.h>
 #include "tensor_sink.h"
 
 /**
@@ -71,7 +72,10 @@ enum
   PROP_0,
   PROP_SIGNAL_RATE,
   PROP_EMIT_SIGNAL,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_MAX_BUFFERS,
+  PROP_DROP_POLICY,
+  PROP_DROPPED
 };
 
 /**
@@ -89,6 +93,21 @@ enum
  */
 #define DEFAULT_SILENT TRUE
 
+/**
+ * @brief The number of buffers in the ring (0 to disable the ring).
+ */
+#define DEFAULT_MAX_BUFFERS 0
+
+/**
+ * @brief The maximum number of buffers in the ring.
+ */
+#define MAX_RING_BUFFERS 65536
+
+/**
+ * @brief The policy to drop the buffer when the ring is full.
+ */
+#define DEFAULT_DROP_POLICY GST_TENSOR_SINK_DROP_OLDEST
+
 /**
  * @brief Flag for qos event.
  *
@@ -122,10 +141,14 @@ static GstFlowReturn gst_tensor_sink_render (GstBaseSink * sink,
     GstBuffer * buffer);
 static GstFlowReturn gst_tensor_sink_render_list (GstBaseSink * sink,
     GstBufferList * buffer_list);
+static gboolean gst_tensor_sink_start (GstBaseSink * sink);
+static gboolean gst_tensor_sink_stop (GstBaseSink * sink);
 
 /** internal functions */
 static void gst_tensor_sink_render_buffer (GstTensorSink * self,
     GstBuffer * buffer);
+static void gst_tensor_sink_ring_render (GstTensorSink * self,
+    GstBuffer * buffer);
 static void gst_tensor_sink_set_last_render_time (GstTensorSink * self,
     GstClockTime now);
 static GstClockTime gst_tensor_sink_get_last_render_time (GstTensorSink * self);
@@ -136,6 +159,35 @@ static void gst_tensor_sink_set_emit_signal (GstTensorSink * self,
 static gboolean gst_tensor_sink_get_emit_signal (GstTensorSink * self);
 static void gst_tensor_sink_set_silent (GstTensorSink * self, gboolean silent);
 static gboolean gst_tensor_sink_get_silent (GstTensorSink * self);
+static void gst_tensor_sink_ring_free (GstTensorSink * self);
+static void gst_tensor_sink_ring_clear (GstTensorSink * self);
+static void gst_tensor_sink_ring_set_state (GstTensorSink * self,
+    gboolean flushing, gboolean eos);
+
+#define GST_TYPE_TENSOR_SINK_DROP_POLICY (gst_tensor_sink_drop_policy_get_type ())
+/**
+ * @brief A private function to register GEnumValue array for the 'drop-policy' property
+ *        to a GType and return it
+ */
+static GType
+gst_tensor_sink_drop_policy_get_type (void)
+{
+  static GType policy_type = 0;
+
+  if (policy_type == 0) {
+    static GEnumValue policy_types[] = {
+      {GST_TENSOR_SINK_DROP_OLDEST, "Drop the oldest buffer in the ring",
+          "drop-oldest"},
+      {GST_TENSOR_SINK_DROP_NEWEST, "Drop the new buffer", "drop-newest"},
+      {0, NULL, NULL},
+    };
+
+    policy_type =
+        g_enum_register_static ("tensor_sink_drop_policy", policy_types);
+  }
+
+  return policy_type;
+}
 
 #define gst_tensor_sink_parent_class parent_class
 G_DEFINE_TYPE (GstTensorSink, gst_tensor_sink, GST_TYPE_BASE_SINK);
@@ -198,6 +250,41 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorSink::max-buffers:
+   *
+   * The number of buffers in the ring for gst_tensor_sink_pull (), rounded up to a power of two.
+   * The ring is allocated when the element starts. If set 0 (default value), the ring is disabled.
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_BUFFERS,
+      g_param_spec_uint ("max-buffers", "Max buffers",
+          "The number of buffers in the ring to be pulled by the application "
+          "(0 to disable the ring, rounded up to a power of two)", 0,
+          MAX_RING_BUFFERS, DEFAULT_MAX_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::drop-policy:
+   *
+   * The policy to drop the buffer when the ring is full.
+   * The streaming thread never waits for the application.
+   */
+  g_object_class_install_property (gobject_class, PROP_DROP_POLICY,
+      g_param_spec_enum ("drop-policy", "Drop policy",
+          "The policy to drop the buffer when the ring is full",
+          GST_TYPE_TENSOR_SINK_DROP_POLICY, DEFAULT_DROP_POLICY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::dropped:
+   *
+   * The number of buffers dropped because the ring is full.
+   */
+  g_object_class_install_property (gobject_class, PROP_DROPPED,
+      g_param_spec_uint64 ("dropped", "Dropped",
+          "The number of buffers dropped because the ring is full", 0,
+          G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstTensorSink::new-data:
    *
@@ -248,6 +335,8 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
   bsink_class->query = GST_DEBUG_FUNCPTR (gst_tensor_sink_query);
   bsink_class->render = GST_DEBUG_FUNCPTR (gst_tensor_sink_render);
   bsink_class->render_list = GST_DEBUG_FUNCPTR (gst_tensor_sink_render_list);
+  bsink_class->start = GST_DEBUG_FUNCPTR (gst_tensor_sink_start);
+  bsink_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_sink_stop);
 }
 
 /**
@@ -261,12 +350,20 @@ gst_tensor_sink_init (GstTensorSink * self)
   bsink = GST_BASE_SINK (self);
 
   g_mutex_init (&self->mutex);
+  g_mutex_init (&self->ring_lock);
+  g_cond_init (&self->ring_cond);
 
   /** init properties */
   self->silent = DEFAULT_SILENT;
   self->emit_signal = DEFAULT_EMIT_SIGNAL;
   self->signal_rate = DEFAULT_SIGNAL_RATE;
   self->last_render_time = GST_CLOCK_TIME_NONE;
+  self->max_buffers = DEFAULT_MAX_BUFFERS;
+  self->drop_policy = DEFAULT_DROP_POLICY;
+  self->dropped = 0;
+  self->ring = NULL;
+  self->flushing = TRUE;
+  self->eos = FALSE;
 
   /** enable qos */
   gst_base_sink_set_qos_enabled (bsink, DEFAULT_QOS);
@@ -301,6 +398,18 @@ gst_tensor_sink_set_property (GObject * object, guint prop_id,
       gst_tensor_sink_set_silent (self, g_value_get_boolean (value));
       break;
 
+    case PROP_MAX_BUFFERS:
+      g_mutex_lock (&self->mutex);
+      self->max_buffers = g_value_get_uint (value);
+      g_mutex_unlock (&self->mutex);
+      break;
+
+    case PROP_DROP_POLICY:
+      g_mutex_lock (&self->mutex);
+      self->drop_policy = g_value_get_enum (value);
+      g_mutex_unlock (&self->mutex);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -333,6 +442,24 @@ gst_tensor_sink_get_property (GObject * object, guint prop_id,
       g_value_set_boolean (value, gst_tensor_sink_get_silent (self));
       break;
 
+    case PROP_MAX_BUFFERS:
+      g_mutex_lock (&self->mutex);
+      g_value_set_uint (value, self->max_buffers);
+      g_mutex_unlock (&self->mutex);
+      break;
+
+    case PROP_DROP_POLICY:
+      g_mutex_lock (&self->mutex);
+      g_value_set_enum (value, self->drop_policy);
+      g_mutex_unlock (&self->mutex);
+      break;
+
+    case PROP_DROPPED:
+      g_mutex_lock (&self->mutex);
+      g_value_set_uint64 (value, self->dropped);
+      g_mutex_unlock (&self->mutex);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -351,7 +478,13 @@ gst_tensor_sink_finalize (GObject * object)
 
   self = GST_TENSOR_SINK (object);
 
+  gst_tensor_sink_ring_free (self);
+  if (self->notify)
+    self->notify (self->user_data);
+
   g_mutex_clear (&self->mutex);
+  g_mutex_clear (&self->ring_lock);
+  g_cond_clear (&self->ring_cond);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -366,6 +499,8 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
 {
   GstTensorSink *self;
   GstEventType type;
+  GstTensorSinkCallbacks callbacks;
+  gpointer user_data;
 
   self = GST_TENSOR_SINK (sink);
   type = GST_EVENT_TYPE (event);
@@ -373,9 +508,18 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
   GST_DEBUG_OBJECT (self, "Received %s event: %" GST_PTR_FORMAT,
       GST_EVENT_TYPE_NAME (event), event);
 
+  g_mutex_lock (&self->mutex);
+  callbacks = self->callbacks;
+  user_data = self->user_data;
+  g_mutex_unlock (&self->mutex);
+
   switch (type) {
     case GST_EVENT_STREAM_START:
-      if (gst_tensor_sink_get_emit_signal (self)) {
+      gst_tensor_sink_ring_set_state (self, FALSE, FALSE);
+
+      if (callbacks.stream_start) {
+        callbacks.stream_start (self, user_data);
+      } else if (gst_tensor_sink_get_emit_signal (self)) {
         silent_debug (self, "Emit signal for stream start");
 
         g_signal_emit (self, _tensor_sink_signals[SIGNAL_STREAM_START], 0);
@@ -383,13 +527,27 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
       break;
 
     case GST_EVENT_EOS:
-      if (gst_tensor_sink_get_emit_signal (self)) {
+      /* wake up the consumers, the buffers in the ring can be pulled */
+      gst_tensor_sink_ring_set_state (self, FALSE, TRUE);
+
+      if (callbacks.eos) {
+        callbacks.eos (self, user_data);
+      } else if (gst_tensor_sink_get_emit_signal (self)) {
         silent_debug (self, "Emit signal for eos");
 
         g_signal_emit (self, _tensor_sink_signals[SIGNAL_EOS], 0);
       }
       break;
 
+    case GST_EVENT_FLUSH_START:
+      gst_tensor_sink_ring_set_state (self, TRUE, FALSE);
+      break;
+
+    case GST_EVENT_FLUSH_STOP:
+      gst_tensor_sink_ring_clear (self);
+      gst_tensor_sink_ring_set_state (self, FALSE, FALSE);
+      break;
+
     default:
       break;
   }
@@ -469,6 +627,217 @@ gst_tensor_sink_render_list (GstBaseSink * sink, GstBufferList * buffer_list)
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Start processing, allocate the ring.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_start (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+  guint max_buffers, size, i;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  max_buffers = self->max_buffers;
+  self->dropped = 0;
+  g_mutex_unlock (&self->mutex);
+
+  g_mutex_lock (&self->ring_lock);
+  if (max_buffers > 0) {
+    size = 1;
+    while (size < max_buffers)
+      size <<= 1;
+
+    self->ring = g_new0 (GstTensorSinkRingCell, size);
+    for (i = 0; i < size; i++)
+      self->ring[i].seq = (gint) i;
+
+    self->ring_mask = size - 1;
+    self->enqueue_pos = self->dequeue_pos = 0;
+  }
+
+  self->flushing = FALSE;
+  self->eos = FALSE;
+  g_mutex_unlock (&self->ring_lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop processing, wake up the consumers and free the ring.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_stop (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  gst_tensor_sink_ring_set_state (self, TRUE, FALSE);
+  gst_tensor_sink_ring_free (self);
+
+  return TRUE;
+}
+
+/**
+ * @brief Push a buffer into the ring (lock-free).
+ * @return FALSE if the ring is full.
+ */
+static gboolean
+gst_tensor_sink_ring_push (GstTensorSink * self, GstBuffer * buffer)
+{
+  GstTensorSinkRingCell *cell;
+  guint pos;
+  gint dif;
+
+  pos = (guint) g_atomic_int_get (&self->enqueue_pos);
+  for (;;) {
+    cell = &self->ring[pos & self->ring_mask];
+    dif = (gint) ((guint) g_atomic_int_get (&cell->seq) - pos);
+
+    if (dif == 0) {
+      if (g_atomic_int_compare_and_exchange (&self->enqueue_pos, (gint) pos,
+              (gint) (pos + 1)))
+        break;
+    } else if (dif < 0) {
+      /* full */
+      return FALSE;
+    }
+
+    pos = (guint) g_atomic_int_get (&self->enqueue_pos);
+  }
+
+  cell->buffer = buffer;
+  g_atomic_int_set (&cell->seq, (gint) (pos + 1));
+  return TRUE;
+}
+
+/**
+ * @brief Pop a buffer from the ring (lock-free).
+ * @return the buffer, NULL if the ring is empty.
+ */
+static GstBuffer *
+gst_tensor_sink_ring_pop (GstTensorSink * self)
+{
+  GstTensorSinkRingCell *cell;
+  GstBuffer *buffer;
+  guint pos;
+  gint dif;
+
+  pos = (guint) g_atomic_int_get (&self->dequeue_pos);
+  for (;;) {
+    cell = &self->ring[pos & self->ring_mask];
+    dif = (gint) ((guint) g_atomic_int_get (&cell->seq) - (pos + 1));
+
+    if (dif == 0) {
+      if (g_atomic_int_compare_and_exchange (&self->dequeue_pos, (gint) pos,
+              (gint) (pos + 1)))
+        break;
+    } else if (dif < 0) {
+      /* empty */
+      return NULL;
+    }
+
+    pos = (guint) g_atomic_int_get (&self->dequeue_pos);
+  }
+
+  buffer = cell->buffer;
+  cell->buffer = NULL;
+  g_atomic_int_set (&cell->seq, (gint) (pos + self->ring_mask + 1));
+  return buffer;
+}
+
+/**
+ * @brief Push a buffer into the ring with the drop policy, and wake up the consumers.
+ * @note The streaming thread does not take a lock unless a consumer is waiting.
+ */
+static void
+gst_tensor_sink_ring_render (GstTensorSink * self, GstBuffer * buffer)
+{
+  GstBuffer *oldest;
+  guint64 dropped = 0;
+
+  gst_buffer_ref (buffer);
+
+  while (!gst_tensor_sink_ring_push (self, buffer)) {
+    if (self->drop_policy == GST_TENSOR_SINK_DROP_NEWEST) {
+      gst_buffer_unref (buffer);
+      dropped++;
+      break;
+    }
+
+    oldest = gst_tensor_sink_ring_pop (self);
+    if (oldest) {
+      gst_buffer_unref (oldest);
+      dropped++;
+    }
+  }
+
+  if (dropped > 0) {
+    g_mutex_lock (&self->mutex);
+    self->dropped += dropped;
+    g_mutex_unlock (&self->mutex);
+  }
+
+  if (g_atomic_int_get (&self->waiters) > 0) {
+    g_mutex_lock (&self->ring_lock);
+    g_cond_broadcast (&self->ring_cond);
+    g_mutex_unlock (&self->ring_lock);
+  }
+}
+
+/**
+ * @brief Drop all buffers in the ring.
+ */
+static void
+gst_tensor_sink_ring_clear (GstTensorSink * self)
+{
+  GstBuffer *buffer;
+
+  g_mutex_lock (&self->ring_lock);
+  if (self->ring) {
+    while ((buffer = gst_tensor_sink_ring_pop (self)) != NULL)
+      gst_buffer_unref (buffer);
+  }
+  g_mutex_unlock (&self->ring_lock);
+}
+
+/**
+ * @brief Free the ring.
+ */
+static void
+gst_tensor_sink_ring_free (GstTensorSink * self)
+{
+  gst_tensor_sink_ring_clear (self);
+
+  g_mutex_lock (&self->ring_lock);
+  g_free (self->ring);
+  self->ring = NULL;
+  g_mutex_unlock (&self->ring_lock);
+}
+
+/**
+ * @brief Set the state of the stream and wake up the consumers.
+ */
+static void
+gst_tensor_sink_ring_set_state (GstTensorSink * self, gboolean flushing,
+    gboolean eos)
+{
+  g_mutex_lock (&self->ring_lock);
+  self->flushing = flushing;
+  self->eos = eos;
+  g_cond_broadcast (&self->ring_cond);
+  g_mutex_unlock (&self->ring_lock);
+
+  if (flushing)
+    gst_tensor_sink_ring_clear (self);
+}
+
 /**
  * @brief Handle buffer data.
  * @return None
@@ -514,9 +883,23 @@ gst_tensor_sink_render_buffer (GstTensorSink * self, GstBuffer * buffer)
   }
 
   if (notify) {
+    GstTensorSinkCallbacks callbacks;
+    gpointer user_data;
+
     gst_tensor_sink_set_last_render_time (self, now);
 
-    if (gst_tensor_sink_get_emit_signal (self)) {
+    /* the ring is allocated before streaming and freed after streaming */
+    if (self->ring)
+      gst_tensor_sink_ring_render (self, buffer);
+
+    g_mutex_lock (&self->mutex);
+    callbacks = self->callbacks;
+    user_data = self->user_data;
+    g_mutex_unlock (&self->mutex);
+
+    if (callbacks.new_data) {
+      callbacks.new_data (self, buffer, user_data);
+    } else if (gst_tensor_sink_get_emit_signal (self)) {
       silent_debug (self,
           "Emit signal for new data [%" GST_TIME_FORMAT "] rate [%d]",
           GST_TIME_ARGS (now), signal_rate);
@@ -642,3 +1025,105 @@ gst_tensor_sink_get_silent (GstTensorSink * self)
 
   return self->silent;
 }
+
+/**
+ * @brief Set the callbacks to get the data from tensor_sink.
+ */
+void
+gst_tensor_sink_set_callbacks (GstTensorSink * sink,
+    const GstTensorSinkCallbacks * callbacks, gpointer user_data,
+    GDestroyNotify notify)
+{
+  GDestroyNotify old_notify;
+  gpointer old_data;
+
+  g_return_if_fail (GST_IS_TENSOR_SINK (sink));
+
+  g_mutex_lock (&sink->mutex);
+  old_notify = sink->notify;
+  old_data = sink->user_data;
+
+  if (callbacks) {
+    sink->callbacks = *callbacks;
+    sink->user_data = user_data;
+    sink->notify = notify;
+  } else {
+    memset (&sink->callbacks, 0, sizeof (GstTensorSinkCallbacks));
+    sink->user_data = NULL;
+    sink->notify = NULL;
+  }
+  g_mutex_unlock (&sink->mutex);
+
+  if (old_notify)
+    old_notify (old_data);
+}
+
+/**
+ * @brief Pull a buffer from the ring, wait until a buffer is available.
+ */
+GstBuffer *
+gst_tensor_sink_pull (GstTensorSink * sink)
+{
+  return gst_tensor_sink_try_pull (sink, GST_CLOCK_TIME_NONE);
+}
+
+/**
+ * @brief Pull a buffer from the ring with timeout.
+ */
+GstBuffer *
+gst_tensor_sink_try_pull (GstTensorSink * sink, GstClockTime timeout)
+{
+  GstBuffer *buffer = NULL;
+
+  if (gst_tensor_sink_try_pull_many (sink, &buffer, 1, timeout) == 0)
+    return NULL;
+
+  return buffer;
+}
+
+/**
+ * @brief Pull the buffers from the ring with a wakeup.
+ */
+guint
+gst_tensor_sink_try_pull_many (GstTensorSink * sink, GstBuffer ** buffers,
+    guint max, GstClockTime timeout)
+{
+  gint64 end_time = 0;
+  guint n = 0;
+
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (sink), 0);
+  g_return_val_if_fail (buffers != NULL, 0);
+  g_return_val_if_fail (max > 0, 0);
+
+  if (GST_CLOCK_TIME_IS_VALID (timeout))
+    end_time = g_get_monotonic_time () + GST_TIME_AS_USECONDS (timeout);
+
+  g_mutex_lock (&sink->ring_lock);
+  /* the streaming thread wakes up the consumers if waiters is not 0 */
+  g_atomic_int_inc (&sink->waiters);
+
+  for (;;) {
+    while (sink->ring && n < max) {
+      buffers[n] = gst_tensor_sink_ring_pop (sink);
+      if (buffers[n] == NULL)
+        break;
+      n++;
+    }
+
+    if (n > 0 || sink->ring == NULL || sink->flushing || sink->eos)
+      break;
+
+    if (!GST_CLOCK_TIME_IS_VALID (timeout)) {
+      g_cond_wait (&sink->ring_cond, &sink->ring_lock);
+    } else if (timeout == 0 || g_get_monotonic_time () >= end_time) {
+      break;
+    } else {
+      g_cond_wait_until (&sink->ring_cond, &sink->ring_lock, end_time);
+    }
+  }
+
+  g_atomic_int_add (&sink->waiters, -1);
+  g_mutex_unlock (&sink->ring_lock);
+
+  return n;
+}
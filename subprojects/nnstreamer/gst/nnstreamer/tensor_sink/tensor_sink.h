@@ -30,23 +30,35 @@
 #include <gst/gst.h>
 #include <gst/base/gstbasesink.h>
 #include <tensor_common.h>
+#include <tensor_sink_api.h>
 
 G_BEGIN_DECLS
 
-#define GST_TYPE_TENSOR_SINK \
-  (gst_tensor_sink_get_type())
-#define GST_TENSOR_SINK(obj) \
-  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_SINK,GstTensorSink))
 #define GST_TENSOR_SINK_CLASS(klass) \
   (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_SINK,GstTensorSinkClass))
-#define GST_IS_TENSOR_SINK(obj) \
-  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_SINK))
 #define GST_IS_TENSOR_SINK_CLASS(klass) \
   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_SINK))
 
-typedef struct _GstTensorSink GstTensorSink;
 typedef struct _GstTensorSinkClass GstTensorSinkClass;
 
+/**
+ * @brief The policy to drop the buffer when the ring is full.
+ */
+typedef enum
+{
+  GST_TENSOR_SINK_DROP_OLDEST = 0, /**< drop the oldest buffer in the ring */
+  GST_TENSOR_SINK_DROP_NEWEST = 1 /**< drop the new buffer */
+} GstTensorSinkDropPolicy;
+
+/**
+ * @brief A cell of the ring (bounded lock-free queue).
+ */
+typedef struct
+{
+  gint seq; /**< sequence of the cell */
+  GstBuffer *buffer; /**< buffer in the cell */
+} GstTensorSinkRingCell;
+
 /**
  * @brief GstTensorSink data structure.
  *
@@ -61,6 +73,24 @@ struct _GstTensorSink
   gboolean emit_signal; /**< true to emit signal for new data, eos */
   guint signal_rate; /**< new data signals per second */
   GstClockTime last_render_time; /**< buffer rendered time */
+
+  GstTensorSinkCallbacks callbacks; /**< callbacks for the application */
+  gpointer user_data; /**< user data for the callbacks */
+  GDestroyNotify notify; /**< function to free user data */
+
+  guint max_buffers; /**< the number of buffers in the ring (0 to disable the ring) */
+  GstTensorSinkDropPolicy drop_policy; /**< the policy when the ring is full */
+  guint64 dropped; /**< the number of dropped buffers */
+
+  GstTensorSinkRingCell *ring; /**< ring of the buffers to be pulled */
+  guint ring_mask; /**< the number of cells - 1 (power of two) */
+  gint enqueue_pos; /**< position to push the buffer */
+  gint dequeue_pos; /**< position to pull the buffer */
+  gint waiters; /**< the number of consumers waiting for the buffer */
+  GMutex ring_lock; /**< lock for the consumers */
+  GCond ring_cond; /**< signalled when a buffer is pushed */
+  gboolean flushing; /**< true when flushing or stopped */
+  gboolean eos; /**< true when end of stream reached */
 };
 
 /**
@@ -78,11 +108,6 @@ struct _GstTensorSinkClass
   void (*eos) (GstElement * element); /**< signal when end of stream reached */
 };
 
-/**
- * @brief Function to get type of tensor_sink.
- */
-GType gst_tensor_sink_get_type (void);
-
 G_END_DECLS
 
 #endif /** __GST_TENSOR_SINK_H__ */
@@ -0,0 +1,807 @@
+/**
+ * GStreamer
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ */
+
+/**
+ * SECTION: element-tensor_src_synthetic
+ *
+ * Source element to generate synthetic tensors without media decoders.
+ * The tensors (static, flexible or sparse) are generated once in a small pool
+ * when the element starts, and the output buffers share the memories of the
+ * pool (read-only), so that the element pushes buffers at the maximum rate
+ * without allocation and copy.
+ * With the property 'framerate', the buffers are timestamped with the given rate
+ * and the element runs at that rate if 'is-live' is enabled.
+ * Each buffer has the reference timestamp meta with its send time
+ * (GST_TENSOR_SRC_SYNTHETIC_SEND_TIME_CAPS) to measure the latency of a pipeline.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 tensor_src_synthetic num-buffers=1000 dimension=3:224:224:1 type=uint8 ! \
+ *     tensor_transform mode=typecast option=float32 ! fakesink
+ * ]|
+ * </refsect2>
+ *
+ * @file	tensor_src_synthetic.c
+ * @date	18 Oct 2026
+ * @brief	GStreamer plugin to generate synthetic tensors for tests and benchmarks
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <nnstreamer_util.h>
+#include <tensor_data.h>
+#include <tensor_sparse/tensor_sparse_util.h>
+
+#include "tensor_src_synthetic.h"
+
+/**
+ * @brief Macro for debug mode.
+ */
+#ifndef DBG
+#define DBG (!self->silent)
+#endif
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_src_synthetic_debug);
+#define GST_CAT_DEFAULT gst_tensor_src_synthetic_debug
+
+/**
+ * @brief tensor_src_synthetic properties
+ */
+enum
+{
+  PROP_0,
+  PROP_SILENT,
+  PROP_FORMAT,
+  PROP_DIMENSION,
+  PROP_TYPE,
+  PROP_FRAMERATE,
+  PROP_IS_LIVE,
+  PROP_PATTERN,
+  PROP_SPARSITY,
+  PROP_POOL_SIZE,
+  PROP_SEND_TIME
+};
+
+#define DEFAULT_SILENT TRUE
+#define DEFAULT_FORMAT _NNS_TENSOR_FORMAT_STATIC
+#define DEFAULT_DIMENSION "1:1:1:1"
+#define DEFAULT_TYPE "uint8"
+#define DEFAULT_IS_LIVE FALSE
+#define DEFAULT_PATTERN GTSS_PATTERN_COUNTER
+#define DEFAULT_SPARSITY 0
+#define DEFAULT_POOL_SIZE 4
+#define DEFAULT_SEND_TIME TRUE
+
+/**
+ * @brief The maximum number of pre-generated buffers.
+ */
+#define MAX_POOL_SIZE 64
+
+/**
+ * @brief Seed of the pseudo-random generator, the data is same in every run.
+ */
+#define RANDOM_SEED 0x6e6e73U
+
+#if GST_CHECK_VERSION(1, 14, 0)
+/**
+ * @brief Caps of the send time meta.
+ */
+static GstStaticCaps send_time_caps =
+GST_STATIC_CAPS (GST_TENSOR_SRC_SYNTHETIC_SEND_TIME_CAPS);
+
+static GstPadProbeReturn gst_tensor_src_synthetic_send_time_probe (GstPad *
+    pad, GstPadProbeInfo * info, gpointer user_data);
+#endif
+
+static void gst_tensor_src_synthetic_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec);
+static void gst_tensor_src_synthetic_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec);
+static void gst_tensor_src_synthetic_finalize (GObject * object);
+static gboolean gst_tensor_src_synthetic_start (GstBaseSrc * src);
+static gboolean gst_tensor_src_synthetic_stop (GstBaseSrc * src);
+static gboolean gst_tensor_src_synthetic_negotiate (GstBaseSrc * src);
+static void gst_tensor_src_synthetic_get_times (GstBaseSrc * src,
+    GstBuffer * buffer, GstClockTime * start, GstClockTime * end);
+static GstFlowReturn gst_tensor_src_synthetic_create (GstPushSrc * src,
+    GstBuffer ** buffer);
+
+#define gst_tensor_src_synthetic_parent_class parent_class
+G_DEFINE_TYPE (GstTensorSrcSynthetic, gst_tensor_src_synthetic,
+    GST_TYPE_PUSH_SRC);
+
+#define GST_TYPE_TENSOR_SRC_SYNTHETIC_PATTERN (gst_tensor_src_synthetic_pattern_get_type ())
+/**
+ * @brief A private function to register GEnumValue array for the 'pattern' property
+ * @return GType of the pattern enum
+ */
+static GType
+gst_tensor_src_synthetic_pattern_get_type (void)
+{
+  static GType pattern_type = 0;
+
+  if (pattern_type == 0) {
+    static GEnumValue pattern_types[] = {
+      {GTSS_PATTERN_ZERO, "All elements are zero", "zero"},
+      {GTSS_PATTERN_COUNTER, "Values increasing with the element index",
+          "counter"},
+      {GTSS_PATTERN_RANDOM, "Pseudo-random values in [0, 100)", "random"},
+      {0, NULL, NULL},
+    };
+    pattern_type =
+        g_enum_register_static ("gtss_pattern_type", pattern_types);
+  }
+
+  return pattern_type;
+}
+
+/**
+ * @brief class initialization of tensor_src_synthetic
+ */
+static void
+gst_tensor_src_synthetic_class_init (GstTensorSrcSyntheticClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstPushSrcClass *pushsrc_class = GST_PUSH_SRC_CLASS (klass);
+  GstBaseSrcClass *basesrc_class = GST_BASE_SRC_CLASS (klass);
+  GstPadTemplate *pad_template;
+  GstCaps *pad_caps;
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_src_synthetic_debug,
+      "tensor_src_synthetic", 0, "Source element to generate synthetic tensors");
+
+  gobject_class->set_property = gst_tensor_src_synthetic_set_property;
+  gobject_class->get_property = gst_tensor_src_synthetic_get_property;
+  gobject_class->finalize = gst_tensor_src_synthetic_finalize;
+
+  g_object_class_install_property (gobject_class, PROP_SILENT,
+      g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
+          DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::format:
+   *
+   * The format of output tensors (static, flexible or sparse).
+   */
+  g_object_class_install_property (gobject_class, PROP_FORMAT,
+      g_param_spec_string ("format", "Format",
+          "The format of output tensors (static, flexible or sparse)",
+          "static", G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::dimension:
+   *
+   * The dimensions of output tensors, separated by ',' for multiple tensors.
+   */
+  g_object_class_install_property (gobject_class, PROP_DIMENSION,
+      g_param_spec_string ("dimension", "Dimension",
+          "The dimensions of output tensors, separated by ',' (e.g., 3:224:224:1,10:1:1:1)",
+          DEFAULT_DIMENSION, G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::type:
+   *
+   * The types of output tensors, separated by ',' for multiple tensors.
+   */
+  g_object_class_install_property (gobject_class, PROP_TYPE,
+      g_param_spec_string ("type", "Type",
+          "The types of output tensors, separated by ',' (e.g., uint8,float32)",
+          DEFAULT_TYPE, G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::framerate:
+   *
+   * The framerate of output stream. 0/1 (default) means unlimited rate.
+   */
+  g_object_class_install_property (gobject_class, PROP_FRAMERATE,
+      gst_param_spec_fraction ("framerate", "Framerate",
+          "The framerate of output stream, 0/1 for the unlimited rate",
+          0, 1, G_MAXINT, 1, 0, 1, G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_READY | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::is-live:
+   *
+   * If TRUE, the element pushes the buffers at the rate of the property 'framerate'.
+   */
+  g_object_class_install_property (gobject_class, PROP_IS_LIVE,
+      g_param_spec_boolean ("is-live", "Is Live",
+          "Whether to act as a live source (sync to the framerate)",
+          DEFAULT_IS_LIVE, G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::pattern:
+   *
+   * The data pattern of output tensors.
+   */
+  g_object_class_install_property (gobject_class, PROP_PATTERN,
+      g_param_spec_enum ("pattern", "Pattern",
+          "The data pattern of output tensors",
+          GST_TYPE_TENSOR_SRC_SYNTHETIC_PATTERN, DEFAULT_PATTERN,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::sparsity:
+   *
+   * The percentage of zero elements in output tensors.
+   */
+  g_object_class_install_property (gobject_class, PROP_SPARSITY,
+      g_param_spec_uint ("sparsity", "Sparsity",
+          "The percentage of elements set to zero", 0, 100, DEFAULT_SPARSITY,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::pool-size:
+   *
+   * The number of pre-generated buffers, used in turn.
+   */
+  g_object_class_install_property (gobject_class, PROP_POOL_SIZE,
+      g_param_spec_uint ("pool-size", "Pool size",
+          "The number of pre-generated buffers, used in turn",
+          1, MAX_POOL_SIZE, DEFAULT_POOL_SIZE,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSrcSynthetic::send-time:
+   *
+   * If TRUE, the element adds the reference timestamp meta with the send time to each buffer.
+   */
+  g_object_class_install_property (gobject_class, PROP_SEND_TIME,
+      g_param_spec_boolean ("send-time", "Send time",
+          "Add the send time (monotonic, ns) to each buffer as reference timestamp meta",
+          DEFAULT_SEND_TIME, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  basesrc_class->start = GST_DEBUG_FUNCPTR (gst_tensor_src_synthetic_start);
+  basesrc_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_src_synthetic_stop);
+  basesrc_class->negotiate =
+      GST_DEBUG_FUNCPTR (gst_tensor_src_synthetic_negotiate);
+  basesrc_class->get_times =
+      GST_DEBUG_FUNCPTR (gst_tensor_src_synthetic_get_times);
+  pushsrc_class->create = GST_DEBUG_FUNCPTR (gst_tensor_src_synthetic_create);
+
+  gst_element_class_set_static_metadata (element_class,
+      "TensorSrcSynthetic",
+      "Source/Tensor",
+      "Generate synthetic tensors at a set or unlimited rate",
+      "Samsung Electronics Co., Ltd.");
+
+  /* pad template */
+  pad_caps = gst_caps_from_string (GST_TENSOR_CAP_DEFAULT "; "
+      GST_TENSORS_CAP_MAKE (GST_TENSOR_FORMAT_ALL));
+  pad_template = gst_pad_template_new ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+      pad_caps);
+  gst_element_class_add_pad_template (element_class, pad_template);
+  gst_caps_unref (pad_caps);
+}
+
+/**
+ * @brief object initialization of tensor_src_synthetic
+ */
+static void
+gst_tensor_src_synthetic_init (GstTensorSrcSynthetic * self)
+{
+  self->silent = DEFAULT_SILENT;
+  self->dimension = g_strdup (DEFAULT_DIMENSION);
+  self->type = g_strdup (DEFAULT_TYPE);
+  self->pattern = DEFAULT_PATTERN;
+  self->sparsity = DEFAULT_SPARSITY;
+  self->pool_size = DEFAULT_POOL_SIZE;
+  self->send_time = DEFAULT_SEND_TIME;
+  self->pool = NULL;
+  self->count = 0;
+  self->start_time = GST_CLOCK_TIME_NONE;
+
+  gst_tensors_config_init (&self->config);
+  self->config.format = DEFAULT_FORMAT;
+  self->config.rate_n = 0;
+  self->config.rate_d = 1;
+
+  gst_base_src_set_format (GST_BASE_SRC (self), GST_FORMAT_TIME);
+  gst_base_src_set_live (GST_BASE_SRC (self), DEFAULT_IS_LIVE);
+
+#if GST_CHECK_VERSION(1, 14, 0)
+  /* stamp the send time after basesrc waits for the clock (live mode) */
+  gst_pad_add_probe (GST_BASE_SRC_PAD (self), GST_PAD_PROBE_TYPE_BUFFER,
+      gst_tensor_src_synthetic_send_time_probe, self, NULL);
+#endif
+}
+
+/**
+ * @brief object finalize of tensor_src_synthetic
+ */
+static void
+gst_tensor_src_synthetic_finalize (GObject * object)
+{
+  GstTensorSrcSynthetic *self = GST_TENSOR_SRC_SYNTHETIC (object);
+
+  g_free (self->dimension);
+  g_free (self->type);
+  gst_tensors_config_free (&self->config);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief set property of tensor_src_synthetic
+ */
+static void
+gst_tensor_src_synthetic_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorSrcSynthetic *self = GST_TENSOR_SRC_SYNTHETIC (object);
+
+  switch (prop_id) {
+    case PROP_SILENT:
+      self->silent = g_value_get_boolean (value);
+      break;
+    case PROP_FORMAT:
+    {
+      const gchar *str = g_value_get_string (value);
+      tensor_format format = gst_tensor_get_format (str);
+
+      if (format == _NNS_TENSOR_FORMAT_END) {
+        ml_logw ("Invalid format '%s', it should be one of "
+            GST_TENSOR_FORMAT_ALL ".", GST_STR_NULL (str));
+        break;
+      }
+      self->config.format = format;
+      break;
+    }
+    case PROP_DIMENSION:
+      g_free (self->dimension);
+      self->dimension = g_value_dup_string (value);
+      break;
+    case PROP_TYPE:
+      g_free (self->type);
+      self->type = g_value_dup_string (value);
+      break;
+    case PROP_FRAMERATE:
+      self->config.rate_n = gst_value_get_fraction_numerator (value);
+      self->config.rate_d = gst_value_get_fraction_denominator (value);
+      break;
+    case PROP_IS_LIVE:
+      gst_base_src_set_live (GST_BASE_SRC (self), g_value_get_boolean (value));
+      break;
+    case PROP_PATTERN:
+      self->pattern = g_value_get_enum (value);
+      break;
+    case PROP_SPARSITY:
+      self->sparsity = g_value_get_uint (value);
+      break;
+    case PROP_POOL_SIZE:
+      self->pool_size = g_value_get_uint (value);
+      break;
+    case PROP_SEND_TIME:
+      self->send_time = g_value_get_boolean (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief get property of tensor_src_synthetic
+ */
+static void
+gst_tensor_src_synthetic_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorSrcSynthetic *self = GST_TENSOR_SRC_SYNTHETIC (object);
+
+  switch (prop_id) {
+    case PROP_SILENT:
+      g_value_set_boolean (value, self->silent);
+      break;
+    case PROP_FORMAT:
+      g_value_set_string (value,
+          gst_tensor_get_format_string (self->config.format));
+      break;
+    case PROP_DIMENSION:
+      g_value_set_string (value, self->dimension);
+      break;
+    case PROP_TYPE:
+      g_value_set_string (value, self->type);
+      break;
+    case PROP_FRAMERATE:
+      gst_value_set_fraction (value, self->config.rate_n,
+          self->config.rate_d);
+      break;
+    case PROP_IS_LIVE:
+      g_value_set_boolean (value, gst_base_src_is_live (GST_BASE_SRC (self)));
+      break;
+    case PROP_PATTERN:
+      g_value_set_enum (value, self->pattern);
+      break;
+    case PROP_SPARSITY:
+      g_value_set_uint (value, self->sparsity);
+      break;
+    case PROP_POOL_SIZE:
+      g_value_set_uint (value, self->pool_size);
+      break;
+    case PROP_SEND_TIME:
+      g_value_set_boolean (value, self->send_time);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Parse the properties 'dimension' and 'type' to tensors info.
+ */
+static gboolean
+gst_tensor_src_synthetic_parse_info (GstTensorSrcSynthetic * self)
+{
+  GstTensorsInfo *info = &self->config.info;
+  guint num_dims, num_types;
+
+  gst_tensors_info_free (info);
+  gst_tensors_info_init (info);
+
+  num_dims = gst_tensors_info_parse_dimensions_string (info, self->dimension);
+  num_types = gst_tensors_info_parse_types_string (info, self->type);
+
+  if (num_dims == 0 || num_dims != num_types) {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS,
+        ("The number of dimensions (%u, '%s') and types (%u, '%s') should be same.",
+            num_dims, GST_STR_NULL (self->dimension), num_types,
+            GST_STR_NULL (self->type)), (NULL));
+    return FALSE;
+  }
+
+  info->num_tensors = num_dims;
+
+  if (!gst_tensors_info_validate (info)) {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS,
+        ("Invalid tensor info (dimension '%s', type '%s').",
+            self->dimension, self->type), (NULL));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Fill dense tensor data with the pattern of tensor_src_synthetic.
+ */
+static void
+gst_tensor_src_synthetic_fill (GstTensorSrcSynthetic * self,
+    const GstTensorInfo * info, guint slot, GRand * rand, guint8 * data)
+{
+  gsize i, num;
+  gsize esize;
+  tensor_data_s td;
+  gdouble value;
+
+  num = gst_tensor_get_element_count (info->dimension);
+  esize = gst_tensor_get_element_size (info->type);
+
+  for (i = 0; i < num; i++) {
+    switch (self->pattern) {
+      case GTSS_PATTERN_COUNTER:
+        value = (gdouble) ((slot + i) % 100);
+        break;
+      case GTSS_PATTERN_RANDOM:
+        value = g_rand_double_range (rand, 0.0, 100.0);
+        break;
+      case GTSS_PATTERN_ZERO:
+      default:
+        value = 0.0;
+        break;
+    }
+
+    if (self->sparsity > 0 &&
+        (guint) g_rand_int_range (rand, 0, 100) < self->sparsity)
+      value = 0.0;
+
+    gst_tensor_data_set (&td, _NNS_FLOAT64, &value);
+    gst_tensor_data_typecast (&td, info->type);
+    gst_tensor_data_get (&td, data + i * esize);
+  }
+}
+
+/**
+ * @brief Generate a memory block of the tensor in the pool.
+ */
+static GstMemory *
+gst_tensor_src_synthetic_generate (GstTensorSrcSynthetic * self,
+    GstTensorInfo * info, guint slot, GRand * rand)
+{
+  GstMemory *mem, *out_mem;
+  GstMapInfo map;
+  GstTensorMetaInfo meta;
+  gsize size;
+
+  size = gst_tensor_info_get_size (info);
+  mem = gst_allocator_alloc (NULL, size, NULL);
+  if (!mem || !gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+    ml_loge ("Failed to allocate the memory of synthetic tensor (%"
+        G_GSIZE_FORMAT " bytes).", size);
+    if (mem)
+      gst_memory_unref (mem);
+    return NULL;
+  }
+
+  gst_tensor_src_synthetic_fill (self, info, slot, rand, map.data);
+  gst_memory_unmap (mem, &map);
+
+  switch (self->config.format) {
+    case _NNS_TENSOR_FORMAT_FLEXIBLE:
+      gst_tensor_info_convert_to_meta (info, &meta);
+      meta.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+      out_mem = gst_tensor_meta_info_append_header (&meta, mem);
+      gst_memory_unref (mem);
+      break;
+    case _NNS_TENSOR_FORMAT_SPARSE:
+      gst_tensor_info_convert_to_meta (info, &meta);
+      meta.format = _NNS_TENSOR_FORMAT_SPARSE;
+      meta.media_type = _NNS_TENSOR;
+      out_mem = gst_tensor_sparse_from_dense (&meta, mem);
+      gst_memory_unref (mem);
+      break;
+    default:
+      out_mem = mem;
+      break;
+  }
+
+  /* The memory is shared with all output buffers. */
+  if (out_mem)
+    GST_MINI_OBJECT_FLAG_SET (out_mem, GST_MEMORY_FLAG_READONLY);
+
+  return out_mem;
+}
+
+/**
+ * @brief Release the pre-generated buffers.
+ */
+static void
+gst_tensor_src_synthetic_free_pool (GstTensorSrcSynthetic * self)
+{
+  guint i;
+
+  if (self->pool) {
+    for (i = 0; i < self->pool_size; i++) {
+      if (self->pool[i])
+        gst_buffer_unref (self->pool[i]);
+    }
+
+    g_free (self->pool);
+    self->pool = NULL;
+  }
+}
+
+/**
+ * @brief start vmethod implementation
+ */
+static gboolean
+gst_tensor_src_synthetic_start (GstBaseSrc * src)
+{
+  GstTensorSrcSynthetic *self = GST_TENSOR_SRC_SYNTHETIC (src);
+  GstTensorsInfo *info;
+  GstMemory *mem;
+  GRand *rand;
+  guint s, t;
+
+  if (!gst_tensor_src_synthetic_parse_info (self))
+    return FALSE;
+
+  info = &self->config.info;
+  rand = g_rand_new_with_seed (RANDOM_SEED);
+  self->pool = g_new0 (GstBuffer *, self->pool_size);
+
+  for (s = 0; s < self->pool_size; s++) {
+    self->pool[s] = gst_buffer_new ();
+
+    for (t = 0; t < info->num_tensors; t++) {
+      mem = gst_tensor_src_synthetic_generate (self, &info->info[t], s, rand);
+      if (!mem) {
+        GST_ELEMENT_ERROR (self, RESOURCE, FAILED,
+            ("Failed to generate synthetic tensors."), (NULL));
+        g_rand_free (rand);
+        gst_tensor_src_synthetic_free_pool (self);
+        return FALSE;
+      }
+
+      gst_buffer_append_memory (self->pool[s], mem);
+    }
+  }
+
+  g_rand_free (rand);
+
+  self->count = 0;
+  self->start_time = GST_CLOCK_TIME_NONE;
+
+  silent_debug (self, "Generated %u buffers of %u tensors (%s).",
+      self->pool_size, info->num_tensors,
+      gst_tensor_get_format_string (self->config.format));
+  return TRUE;
+}
+
+/**
+ * @brief stop vmethod implementation
+ */
+static gboolean
+gst_tensor_src_synthetic_stop (GstBaseSrc * src)
+{
+  GstTensorSrcSynthetic *self = GST_TENSOR_SRC_SYNTHETIC (src);
+
+  /* The buffers in the pipeline hold own reference of the memories. */
+  gst_tensor_src_synthetic_free_pool (self);
+  return TRUE;
+}
+
+/**
+ * @brief negotiate vmethod implementation
+ * The caps is fixed with the properties.
+ */
+static gboolean
+gst_tensor_src_synthetic_negotiate (GstBaseSrc * src)
+{
+  GstTensorSrcSynthetic *self = GST_TENSOR_SRC_SYNTHETIC (src);
+  GstTensorsConfig *config = &self->config;
+  GstCaps *caps;
+  gboolean ret;
+
+  if (gst_tensors_config_is_sparse (config)) {
+    caps = gst_caps_from_string (GST_TENSORS_SPARSE_CAP_DEFAULT);
+    if (config->rate_n >= 0 && config->rate_d > 0) {
+      gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION,
+          config->rate_n, config->rate_d, NULL);
+    }
+  } else {
+    caps = gst_tensors_caps_from_config (config);
+  }
+
+  silent_debug_caps (self, caps, "src caps");
+
+  ret = gst_base_src_set_caps (src, caps);
+  gst_caps_unref (caps);
+
+  if (!ret) {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION,
+        ("Negotiation failed with the caps of synthetic tensors."), (NULL));
+  }
+
+  return ret;
+}
+
+/**
+ * @brief get_times vmethod implementation
+ * Sync to the clock with the timestamp of the buffer if the element is live.
+ */
+static void
+gst_tensor_src_synthetic_get_times (GstBaseSrc * src, GstBuffer * buffer,
+    GstClockTime * start, GstClockTime * end)
+{
+  GstClockTime timestamp, duration;
+
+  *start = *end = GST_CLOCK_TIME_NONE;
+
+  if (!gst_base_src_is_live (src))
+    return;
+
+  timestamp = GST_BUFFER_PTS (buffer);
+  duration = GST_BUFFER_DURATION (buffer);
+
+  if (GST_CLOCK_TIME_IS_VALID (timestamp)) {
+    *start = timestamp;
+    if (GST_CLOCK_TIME_IS_VALID (duration))
+      *end = timestamp + duration;
+  }
+}
+
+/**
+ * @brief create func of tensor_src_synthetic
+ */
+static GstFlowReturn
+gst_tensor_src_synthetic_create (GstPushSrc * src, GstBuffer ** buffer)
+{
+  GstTensorSrcSynthetic *self = GST_TENSOR_SRC_SYNTHETIC (src);
+  GstTensorsConfig *config = &self->config;
+  GstBuffer *slot, *buf;
+  GstClockTime now;
+  guint i, num_mems;
+
+  if (!self->pool)
+    return GST_FLOW_NOT_NEGOTIATED;
+
+  /* Output buffer shares the memories of pre-generated buffer. */
+  slot = self->pool[self->count % self->pool_size];
+  num_mems = gst_buffer_n_memory (slot);
+
+  buf = gst_buffer_new ();
+  for (i = 0; i < num_mems; i++)
+    gst_buffer_append_memory (buf, gst_memory_ref (gst_buffer_peek_memory (slot,
+                i)));
+
+  now = gst_util_get_timestamp ();
+  if (!GST_CLOCK_TIME_IS_VALID (self->start_time))
+    self->start_time = now;
+
+  if (config->rate_n > 0 && config->rate_d > 0) {
+    GST_BUFFER_PTS (buf) = gst_util_uint64_scale_int (self->count * GST_SECOND,
+        config->rate_d, config->rate_n);
+    GST_BUFFER_DURATION (buf) =
+        gst_util_uint64_scale_int ((self->count + 1) * GST_SECOND,
+        config->rate_d, config->rate_n) - GST_BUFFER_PTS (buf);
+  } else {
+    GST_BUFFER_PTS (buf) = now - self->start_time;
+  }
+
+  GST_BUFFER_OFFSET (buf) = self->count;
+  GST_BUFFER_OFFSET_END (buf) = self->count + 1;
+
+#if GST_CHECK_VERSION(1, 14, 0)
+  /* the send time is updated when the buffer is pushed */
+  if (self->send_time) {
+    GstCaps *caps = gst_static_caps_get (&send_time_caps);
+
+    gst_buffer_add_reference_timestamp_meta (buf, caps, now,
+        GST_CLOCK_TIME_NONE);
+    gst_caps_unref (caps);
+  }
+#endif
+
+  self->count++;
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
+
+#if GST_CHECK_VERSION(1, 14, 0)
+/**
+ * @brief Buffer probe on the src pad to set the send time.
+ * The buffer is pushed after basesrc waits for the clock in live mode, so the send time excludes the wait.
+ */
+static GstPadProbeReturn
+gst_tensor_src_synthetic_send_time_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstTensorSrcSynthetic *self = GST_TENSOR_SRC_SYNTHETIC (user_data);
+  GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstReferenceTimestampMeta *meta;
+  GstCaps *caps;
+
+  UNUSED (pad);
+
+  if (!self->send_time || buf == NULL)
+    return GST_PAD_PROBE_OK;
+
+  caps = gst_static_caps_get (&send_time_caps);
+  meta = gst_buffer_get_reference_timestamp_meta (buf, caps);
+  gst_caps_unref (caps);
+
+  /* the buffer is created in this element and not shared yet */
+  if (meta)
+    meta->timestamp = gst_util_get_timestamp ();
+
+  return GST_PAD_PROBE_OK;
+}
+#endif
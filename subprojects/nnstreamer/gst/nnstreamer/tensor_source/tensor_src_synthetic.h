@@ -0,0 +1,107 @@
+/**
+ * GStreamer
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ */
+
+/**
+ * @file	tensor_src_synthetic.h
+ * @date	18 Oct 2026
+ * @brief	GStreamer plugin to generate synthetic tensors for tests and benchmarks
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_SRC_SYNTHETIC_H__
+#define __GST_TENSOR_SRC_SYNTHETIC_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstpushsrc.h>
+#include <tensor_common.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_SRC_SYNTHETIC \
+  (gst_tensor_src_synthetic_get_type())
+#define GST_TENSOR_SRC_SYNTHETIC(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_SRC_SYNTHETIC,GstTensorSrcSynthetic))
+#define GST_TENSOR_SRC_SYNTHETIC_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_SRC_SYNTHETIC,GstTensorSrcSyntheticClass))
+#define GST_IS_TENSOR_SRC_SYNTHETIC(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_SRC_SYNTHETIC))
+#define GST_IS_TENSOR_SRC_SYNTHETIC_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_SRC_SYNTHETIC))
+
+/**
+ * @brief Caps of the reference timestamp meta holding the send time of a buffer.
+ *
+ * The timestamp is a monotonic time in nanoseconds (gst_util_get_timestamp()),
+ * taken when the buffer is created. A sink in the same process may subtract it
+ * from the current monotonic time to get the end-to-end latency.
+ */
+#define GST_TENSOR_SRC_SYNTHETIC_SEND_TIME_CAPS "timestamp/x-nnstreamer-send-time"
+
+typedef struct _GstTensorSrcSynthetic GstTensorSrcSynthetic;
+typedef struct _GstTensorSrcSyntheticClass GstTensorSrcSyntheticClass;
+
+/**
+ * @brief Data patterns of the synthetic tensors.
+ */
+typedef enum
+{
+  GTSS_PATTERN_ZERO = 0, /**< all elements are zero */
+  GTSS_PATTERN_COUNTER, /**< element value increases with index and slot */
+  GTSS_PATTERN_RANDOM, /**< pseudo-random values with a fixed seed */
+} GstTensorSrcSyntheticPattern;
+
+/**
+ * @brief GstTensorSrcSynthetic data structure.
+ *
+ * GstTensorSrcSynthetic inherits GstPushSrc
+ */
+struct _GstTensorSrcSynthetic
+{
+  GstPushSrc parent;
+  gboolean silent;
+
+  gchar *dimension; /**< dimensions of output tensors */
+  gchar *type; /**< types of output tensors */
+  GstTensorsConfig config; /**< tensor format, types, dimensions and framerate */
+  GstTensorSrcSyntheticPattern pattern; /**< data pattern */
+  guint sparsity; /**< percentage of zero elements */
+  guint pool_size; /**< the number of pre-generated buffers */
+  gboolean send_time; /**< add send time meta to each buffer */
+
+  GstBuffer **pool; /**< pre-generated buffers, output buffers share their memories */
+  guint64 count; /**< the number of buffers created since start */
+  GstClockTime start_time; /**< monotonic time when the first buffer is created */
+};
+
+/**
+ * @brief GstTensorSrcSyntheticClass data structure.
+ *
+ * GstTensorSrcSynthetic inherits GstPushSrc
+ */
+struct _GstTensorSrcSyntheticClass
+{
+  GstPushSrcClass parent_class;
+};
+
+/**
+ * @brief Function to get type of tensor_src_synthetic.
+ */
+GType gst_tensor_src_synthetic_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_TENSOR_SRC_SYNTHETIC_H__ */
@@ -93,6 +93,9 @@ gst_tensor_sparse_dec_sink_event (GstPad * pad, GstObject * parent,
     GstEvent * event);
 static gboolean gst_tensor_sparse_dec_sink_query (GstPad * pad,
     GstObject * parent, GstQuery * query);
+static GstStateChangeReturn gst_tensor_sparse_dec_change_state (GstElement *
+    element, GstStateChange transition);
+static void gst_tensor_sparse_dec_clear_pool (GstTensorSparseDec * self);
 
 /**
  * @brief Initialize the tensor_sparse's class.
@@ -112,6 +115,7 @@ gst_tensor_sparse_dec_class_init (GstTensorSparseDecClass * klass)
   object_class->set_property = gst_tensor_sparse_dec_set_property;
   object_class->get_property = gst_tensor_sparse_dec_get_property;
   object_class->finalize = gst_tensor_sparse_dec_finalize;
+  element_class->change_state = gst_tensor_sparse_dec_change_state;
 
   /**
    * GstTensorSparseDec::silent:
@@ -163,6 +167,8 @@ gst_tensor_sparse_dec_init (GstTensorSparseDec * self)
   self->silent = DEFAULT_SILENT;
   gst_tensors_config_init (&self->in_config);
   gst_tensors_config_init (&self->out_config);
+  self->pool = NULL;
+  self->pool_size = 0;
 }
 
 /**
@@ -176,10 +182,36 @@ gst_tensor_sparse_dec_finalize (GObject * object)
 
   gst_tensors_config_free (&self->in_config);
   gst_tensors_config_free (&self->out_config);
+  gst_tensor_sparse_dec_clear_pool (self);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Handle state transition.
+ */
+static GstStateChangeReturn
+gst_tensor_sparse_dec_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstTensorSparseDec *self;
+  GstStateChangeReturn ret;
+
+  self = GST_TENSOR_SPARSE_DEC (element);
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_tensor_sparse_dec_clear_pool (self);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
 /**
  * @brief Setter for tensor_sparse_dec properties.
  */
@@ -352,6 +384,99 @@ gst_tensor_sparse_dec_sink_event (GstPad * pad, GstObject * parent,
   return gst_pad_event_default (pad, parent, event);
 }
 
+/**
+ * @brief Release the buffer pool for the output tensor.
+ */
+static void
+gst_tensor_sparse_dec_clear_pool (GstTensorSparseDec * self)
+{
+  if (self->pool) {
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_object_unref (self->pool);
+    self->pool = NULL;
+  }
+
+  self->pool_size = 0;
+}
+
+/**
+ * @brief Prepare the buffer pool for the output tensor with given size.
+ */
+static gboolean
+gst_tensor_sparse_dec_prepare_pool (GstTensorSparseDec * self, gsize size)
+{
+  GstStructure *config;
+  GstCaps *caps;
+
+  /* keep the pool if the size of output tensor is not changed */
+  if (self->pool && self->pool_size == size)
+    return TRUE;
+
+  gst_tensor_sparse_dec_clear_pool (self);
+
+  caps = gst_pad_get_current_caps (self->srcpad);
+  self->pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (self->pool);
+  gst_buffer_pool_config_set_params (config, caps, size, 2, 0);
+  if (caps)
+    gst_caps_unref (caps);
+
+  if (!gst_buffer_pool_set_config (self->pool, config) ||
+      !gst_buffer_pool_set_active (self->pool, TRUE)) {
+    GST_ERROR_OBJECT (self, "Failed to activate the buffer pool.");
+    gst_tensor_sparse_dec_clear_pool (self);
+    return FALSE;
+  }
+
+  self->pool_size = size;
+  return TRUE;
+}
+
+/**
+ * @brief Decode a sparse tensor into the buffer from the pool.
+ */
+static GstBuffer *
+gst_tensor_sparse_dec_decode_pooled (GstTensorSparseDec * self,
+    GstMemory * mem, GstTensorMetaInfo * meta)
+{
+  GstBuffer *outbuf = NULL;
+  GstMapInfo map;
+  gsize size;
+  gboolean decoded;
+
+  if (!gst_tensor_meta_info_parse_memory (meta, mem)) {
+    nns_loge ("Failed to parse meta info from given memory");
+    return NULL;
+  }
+
+  meta->format = _NNS_TENSOR_FORMAT_STATIC;
+  size = gst_tensor_meta_info_get_data_size (meta);
+
+  if (size == 0 || !gst_tensor_sparse_dec_prepare_pool (self, size))
+    return NULL;
+
+  if (gst_buffer_pool_acquire_buffer (self->pool, &outbuf, NULL) != GST_FLOW_OK) {
+    GST_ERROR_OBJECT (self, "Cannot get output buffer from the pool.");
+    return NULL;
+  }
+
+  if (!gst_buffer_map (outbuf, &map, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (self, "Cannot map output buffer.");
+    gst_buffer_unref (outbuf);
+    return NULL;
+  }
+
+  decoded = gst_tensor_sparse_to_dense_into (meta, mem, map.data, map.size);
+  gst_buffer_unmap (outbuf, &map);
+
+  if (!decoded) {
+    gst_buffer_unref (outbuf);
+    return NULL;
+  }
+
+  return outbuf;
+}
+
 /**
  * @brief Internal function to transform the input buffer.
  */
@@ -362,28 +487,41 @@ gst_tensor_sparse_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   GstTensorSparseDec *self = GST_TENSOR_SPARSE_DEC (parent);
   GstTensorMetaInfo meta;
   GstMemory *mem;
-  GstBuffer *outbuf;
+  GstBuffer *outbuf = NULL;
   GstTensorsInfo info;
   guint i;
 
   UNUSED (pad);
 
   buf = gst_tensor_buffer_from_config (buf, &self->in_config);
-  outbuf = gst_buffer_new ();
 
   gst_tensors_info_init (&info);
   info.num_tensors = gst_buffer_n_memory (buf);
 
-  for (i = 0; i < info.num_tensors; ++i) {
-    mem = gst_buffer_peek_memory (buf, i);
-    mem = gst_tensor_sparse_to_dense (&meta, mem);
-    if (!mem) {
+  if (info.num_tensors == 1) {
+    /* single tensor, decode into the buffer from the pool */
+    mem = gst_buffer_peek_memory (buf, 0);
+    outbuf = gst_tensor_sparse_dec_decode_pooled (self, mem, &meta);
+    if (!outbuf) {
       nns_loge ("failed to convert to dense tensor");
       goto done;
     }
 
-    gst_buffer_append_memory (outbuf, mem);
-    gst_tensor_meta_info_convert (&meta, &info.info[i]);
+    gst_tensor_meta_info_convert (&meta, &info.info[0]);
+  } else {
+    outbuf = gst_buffer_new ();
+
+    for (i = 0; i < info.num_tensors; ++i) {
+      mem = gst_buffer_peek_memory (buf, i);
+      mem = gst_tensor_sparse_to_dense (&meta, mem);
+      if (!mem) {
+        nns_loge ("failed to convert to dense tensor");
+        goto done;
+      }
+
+      gst_buffer_append_memory (outbuf, mem);
+      gst_tensor_meta_info_convert (&meta, &info.info[i]);
+    }
   }
 
   /* check the decoded tensor with negotiated config when it's valid */
@@ -391,17 +529,19 @@ gst_tensor_sparse_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     if (!gst_tensors_info_is_equal (&self->out_config.info, &info)) {
       /* if it's not compatible with downstream, do not send the buffer */
       /** @todo consider more error handling */
-      gst_buffer_unref (outbuf);
       ret = GST_FLOW_OK;
       goto done;
     }
   }
 
+  gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+
   ret = gst_pad_push (self->srcpad, outbuf);
+  outbuf = NULL;
 
 done:
   gst_buffer_unref (buf);
-  if (ret != GST_FLOW_OK)
+  if (outbuf)
     gst_buffer_unref (outbuf);
 
   return ret;
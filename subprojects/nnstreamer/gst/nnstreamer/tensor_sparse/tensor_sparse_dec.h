@@ -46,6 +46,9 @@ struct _GstTensorSparseDec
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
   gboolean silent; /**< true to print minimized log */
+
+  GstBufferPool *pool; /**< buffer pool for the output tensor */
+  gsize pool_size; /**< the size of buffer in the pool */
 };
 
 /**
@@ -18,6 +18,13 @@
  * The input is always in the format of other/tensors,format=static.
  * The output is always in the format of ohter/tensors,format=sparse.
  *
+ * The property 'encoding' selects the layout of sparse tensor data.
+ * 'coo' (default) writes the values and indices of non-zero elements,
+ * 'bitmap' writes a bitmap of non-zero elements and the values, and
+ * 'block' writes the non-zero blocks of 'block-size' elements and the block indices.
+ * With 'auto', the encoder selects the encoding with the smallest data size for each tensor.
+ * The encoding is written in the header of each sparse tensor, thus tensor_sparse_dec handles all of them.
+ *
  * Please see also tensor_sparse_dec.
  *
  * <refsect2>
@@ -53,7 +60,9 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_sparse_enc_debug);
 enum
 {
   PROP_0,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_ENCODING,
+  PROP_BLOCK_SIZE
 };
 
 /**
@@ -61,6 +70,46 @@ enum
  */
 #define DEFAULT_SILENT TRUE
 
+/**
+ * @brief Default sparse encoding.
+ */
+#define DEFAULT_ENCODING _NNS_SPARSE_ENCODING_COO
+
+/**
+ * @brief Default number of elements in a block with block encoding.
+ */
+#define DEFAULT_BLOCK_SIZE 16
+
+#define GST_TYPE_TENSOR_SPARSE_ENCODING (gst_tensor_sparse_encoding_get_type ())
+/**
+ * @brief A private function to register GEnumValue array for the 'encoding' property
+ *        to a GType and return it
+ */
+static GType
+gst_tensor_sparse_encoding_get_type (void)
+{
+  static GType encoding_type = 0;
+
+  if (encoding_type == 0) {
+    static GEnumValue encoding_types[] = {
+      {_NNS_SPARSE_ENCODING_COO,
+          "Values and indices of non-zero elements", "coo"},
+      {_NNS_SPARSE_ENCODING_BITMAP,
+          "Bitmap of non-zero elements and values", "bitmap"},
+      {_NNS_SPARSE_ENCODING_BLOCK,
+          "Non-zero blocks of block-size elements and block indices", "block"},
+      {TENSOR_SPARSE_ENCODING_AUTO,
+          "Encoding with the smallest data size for each tensor", "auto"},
+      {0, NULL, NULL},
+    };
+
+    encoding_type =
+        g_enum_register_static ("gtse_encoding_type", encoding_types);
+  }
+
+  return encoding_type;
+}
+
 /**
  * @brief Template for sink pad.
  */
@@ -122,6 +171,28 @@ gst_tensor_sparse_enc_class_init (GstTensorSparseEncClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorSparseEnc::encoding:
+   *
+   * The encoding of sparse tensor data.
+   */
+  g_object_class_install_property (object_class, PROP_ENCODING,
+      g_param_spec_enum ("encoding", "Encoding",
+          "The encoding of sparse tensor data",
+          GST_TYPE_TENSOR_SPARSE_ENCODING, DEFAULT_ENCODING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSparseEnc::block-size:
+   *
+   * The number of elements in a block with block encoding.
+   */
+  g_object_class_install_property (object_class, PROP_BLOCK_SIZE,
+      g_param_spec_uint ("block-size", "Block size",
+          "The number of elements in a block with block (or auto) encoding",
+          1, G_MAXUINT16, DEFAULT_BLOCK_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_pad_template (element_class,
       gst_static_pad_template_get (&src_template));
 
@@ -162,6 +233,8 @@ gst_tensor_sparse_enc_init (GstTensorSparseEnc * self)
 
   /* init properties */
   self->silent = DEFAULT_SILENT;
+  self->encoding = DEFAULT_ENCODING;
+  self->block_size = DEFAULT_BLOCK_SIZE;
   gst_tensors_config_init (&self->in_config);
 }
 
@@ -194,6 +267,12 @@ gst_tensor_sparse_enc_set_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
+    case PROP_ENCODING:
+      self->encoding = g_value_get_enum (value);
+      break;
+    case PROP_BLOCK_SIZE:
+      self->block_size = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -215,6 +294,12 @@ gst_tensor_sparse_enc_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_ENCODING:
+      g_value_set_enum (value, self->encoding);
+      break;
+    case PROP_BLOCK_SIZE:
+      g_value_set_uint (value, self->block_size);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -393,7 +478,8 @@ gst_tensor_sparse_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
     /* do real encoding here */
     mem = gst_buffer_peek_memory (buf, i);
-    mem = gst_tensor_sparse_from_dense (&meta, mem);
+    mem = gst_tensor_sparse_from_dense_full (&meta, mem, self->encoding,
+        self->block_size);
     if (!mem) {
       nns_loge ("failed to convert to sparse tensor");
       ret = GST_FLOW_ERROR;
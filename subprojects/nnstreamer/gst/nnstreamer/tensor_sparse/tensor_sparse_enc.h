@@ -45,6 +45,8 @@ struct _GstTensorSparseEnc
   /* <private> */
   GstTensorsConfig in_config; /**< input tensors config */
   gboolean silent; /**< true to print minimized log */
+  guint encoding; /**< sparse encoding (tensor_sparse_encoding or auto) */
+  guint block_size; /**< the number of elements in a block with block encoding */
 };
 
 /**
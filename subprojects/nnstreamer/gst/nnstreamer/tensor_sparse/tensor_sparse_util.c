@@ -17,92 +17,485 @@
 #include <tensor_data.h>
 #include "tensor_sparse_util.h"
 
+#if defined(__GNUC__)
+#define sparse_ctz64(x) ((guint) __builtin_ctzll (x))
+#define sparse_popcount64(x) ((guint) __builtin_popcountll (x))
+#else
 /**
- * @brief Make dense tensor with input sparse tensor.
+ * @brief Get the number of trailing zero bits. (x should not be 0)
+ */
+static inline guint
+sparse_ctz64 (guint64 x)
+{
+  guint n = 0;
+
+  while ((x & 1) == 0) {
+    x >>= 1;
+    n++;
+  }
+
+  return n;
+}
+
+/**
+ * @brief Get the number of set bits.
+ */
+static inline guint
+sparse_popcount64 (guint64 x)
+{
+  x = x - ((x >> 1) & G_GUINT64_CONSTANT (0x5555555555555555));
+  x = (x & G_GUINT64_CONSTANT (0x3333333333333333)) +
+      ((x >> 2) & G_GUINT64_CONSTANT (0x3333333333333333));
+  x = (x + (x >> 4)) & G_GUINT64_CONSTANT (0x0f0f0f0f0f0f0f0f);
+  return (guint) ((x * G_GUINT64_CONSTANT (0x0101010101010101)) >> 56);
+}
+#endif
+
+/**
+ * @brief Read an index. The indices follow the values, they may not be aligned.
+ */
+static inline guint
+sparse_get_index (const guint8 * indices, gsize i)
+{
+  guint idx;
+
+  memcpy (&idx, indices + i * sizeof (guint), sizeof (guint));
+  return idx;
+}
+
+/**
+ * @brief Write an index. The indices follow the values, they may not be aligned.
+ */
+static inline void
+sparse_set_index (guint8 * indices, gsize i, guint idx)
+{
+  memcpy (indices + i * sizeof (guint), &idx, sizeof (guint));
+}
+
+/**
+ * @brief Macro to get the bitmap of non-zero elements (a 64-bit word for 64 elements).
+ * The inner loop has no branch, so that the compiler can vectorize the comparison.
+ */
+#define sparse_get_mask(ctype,data,count,mask) do { \
+    const ctype *_d = (const ctype *) (data); \
+    gulong _w, _n = (count) / 64; \
+    guint _k, _r = (count) % 64; \
+    guint64 _m; \
+    for (_w = 0; _w < _n; _w++, _d += 64) { \
+      _m = 0; \
+      for (_k = 0; _k < 64; _k++) \
+        _m |= ((guint64) (_d[_k] != 0)) << _k; \
+      (mask)[_w] = _m; \
+    } \
+    if (_r > 0) { \
+      _m = 0; \
+      for (_k = 0; _k < _r; _k++) \
+        _m |= ((guint64) (_d[_k] != 0)) << _k; \
+      (mask)[_n] = _m; \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to get the bitmap of non-zero half precision elements (-0.0 is zero).
+ */
+#define sparse_get_mask_half(data,count,mask) do { \
+    const uint16_t *_d = (const uint16_t *) (data); \
+    gulong _w, _n = (count) / 64; \
+    guint _k, _r = (count) % 64; \
+    guint64 _m; \
+    for (_w = 0; _w < _n; _w++, _d += 64) { \
+      _m = 0; \
+      for (_k = 0; _k < 64; _k++) \
+        _m |= ((guint64) ((_d[_k] & 0x7fffU) != 0)) << _k; \
+      (mask)[_w] = _m; \
+    } \
+    if (_r > 0) { \
+      _m = 0; \
+      for (_k = 0; _k < _r; _k++) \
+        _m |= ((guint64) ((_d[_k] & 0x7fffU) != 0)) << _k; \
+      (mask)[_n] = _m; \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to compress the non-zero elements with the bitmap.
+ */
+#define sparse_compress(utype,data,mask,num_words,values,indices) do { \
+    const utype *_d = (const utype *) (data); \
+    utype *_v = (utype *) (values); \
+    gulong _w; \
+    guint _k; \
+    guint64 _m; \
+    for (_w = 0; _w < (num_words); _w++) { \
+      for (_m = (mask)[_w]; _m != 0; _m &= _m - 1) { \
+        _k = sparse_ctz64 (_m); \
+        if (indices) \
+          sparse_set_index ((indices), _v - (utype *) (values), \
+              (guint) (_w * 64 + _k)); \
+        *_v++ = _d[_w * 64 + _k]; \
+      } \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to scatter the values with the indices into zero-filled dense data.
+ */
+#define sparse_scatter(utype,values,indices,nnz,dense) do { \
+    const utype *_v = (const utype *) (values); \
+    utype *_o = (utype *) (dense); \
+    guint _i; \
+    for (_i = 0; _i < (nnz); _i++) \
+      _o[sparse_get_index ((indices), _i)] = _v[_i]; \
+  } while (0)
+
+/**
+ * @brief Macro to expand the values with the bitmap into dense data.
+ */
+#define sparse_expand(utype,values,bitmap,count,dense) do { \
+    const utype *_v = (const utype *) (values); \
+    utype *_o = (utype *) (dense); \
+    gulong _w, _n = ((count) + 63) / 64; \
+    guint _len; \
+    guint64 _m; \
+    for (_w = 0; _w < _n; _w++, _o += 64) { \
+      memcpy (&_m, (bitmap) + _w * sizeof (guint64), sizeof (guint64)); \
+      _len = (guint) MIN (64, (count) - _w * 64); \
+      if (_len == 64 && _m == G_MAXUINT64) { \
+        memcpy (_o, _v, 64 * sizeof (utype)); \
+        _v += 64; \
+        continue; \
+      } \
+      memset (_o, 0, _len * sizeof (utype)); \
+      for (; _m != 0; _m &= _m - 1) \
+        _o[sparse_ctz64 (_m)] = *_v++; \
+    } \
+  } while (0)
+
+/**
+ * @brief Internal function to get the bitmap of non-zero elements.
+ * @return TRUE if the bitmap is filled
+ */
+static gboolean
+_sparse_get_mask (tensor_type type, gconstpointer data, gulong count,
+    guint64 * mask)
+{
+  /* compare float types with its value (-0.0 is zero), others with bit pattern */
+  switch (type) {
+    case _NNS_FLOAT32:
+      sparse_get_mask (float, data, count, mask);
+      break;
+    case _NNS_FLOAT64:
+      sparse_get_mask (double, data, count, mask);
+      break;
+    case _NNS_FLOAT16:
+    case _NNS_BFLOAT16:
+      sparse_get_mask_half (data, count, mask);
+      break;
+    case _NNS_INT8:
+    case _NNS_UINT8:
+      sparse_get_mask (uint8_t, data, count, mask);
+      break;
+    case _NNS_INT16:
+    case _NNS_UINT16:
+      sparse_get_mask (uint16_t, data, count, mask);
+      break;
+    case _NNS_INT32:
+    case _NNS_UINT32:
+      sparse_get_mask (uint32_t, data, count, mask);
+      break;
+    case _NNS_INT64:
+    case _NNS_UINT64:
+      sparse_get_mask (uint64_t, data, count, mask);
+      break;
+    default:
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to compress the non-zero elements. (indices is nullable)
+ */
+static void
+_sparse_compress (gsize element_size, gconstpointer data,
+    const guint64 * mask, gulong num_words, gpointer values, guint8 * indices)
+{
+  switch (element_size) {
+    case 1:
+      sparse_compress (uint8_t, data, mask, num_words, values, indices);
+      break;
+    case 2:
+      sparse_compress (uint16_t, data, mask, num_words, values, indices);
+      break;
+    case 4:
+      sparse_compress (uint32_t, data, mask, num_words, values, indices);
+      break;
+    case 8:
+      sparse_compress (uint64_t, data, mask, num_words, values, indices);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/**
+ * @brief Internal function to check the bitmap has non-zero element in given range.
+ */
+static gboolean
+_sparse_mask_any (const guint64 * mask, guint64 start, guint64 len)
+{
+  guint64 bits;
+  guint offset, n;
+
+  while (len > 0) {
+    offset = (guint) (start % 64);
+    n = (guint) MIN (64 - offset, len);
+
+    bits = mask[start / 64] >> offset;
+    if (n < 64)
+      bits &= (G_GUINT64_CONSTANT (1) << n) - 1;
+
+    if (bits != 0)
+      return TRUE;
+
+    start += n;
+    len -= n;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Internal function to fill dense tensor data with sparse tensor data.
+ * @param[in] meta tensor meta of the sparse tensor
+ * @param[in] encoding the encoding of the sparse tensor
+ * @param[in] block_size the number of elements in a block with block encoding
+ * @param[in] data sparse tensor data (without header)
+ * @param[out] dense dense tensor data to be filled
+ * @param[in] dense_size the size of dense tensor data
+ * @return TRUE if dense data is filled
+ * @note The caller should check the size of sparse tensor data with the encoding.
+ */
+static gboolean
+_sparse_decode (GstTensorMetaInfo * meta, guint encoding, guint block_size,
+    const guint8 * data, guint8 * dense, gsize dense_size)
+{
+  GstSparseTensorInfo *sparse = &meta->sparse_info;
+  const guint8 *indices;
+  gsize element_size;
+  guint64 count, start, end, block, total, len;
+  guint64 m;
+  guint i;
+
+  element_size = gst_tensor_get_element_size (meta->type);
+  count = dense_size / element_size;
+
+  switch (encoding) {
+    case _NNS_SPARSE_ENCODING_BITMAP:
+      /* validate the bitmap with nnz */
+      total = 0;
+      for (start = 0; start < count; start += 64) {
+        memcpy (&m, data + (start / 64) * sizeof (guint64), sizeof (guint64));
+        if (count - start < 64 && (m >> (count - start)) != 0) {
+          nns_loge ("Invalid bitmap, out of tensor size");
+          return FALSE;
+        }
+
+        total += sparse_popcount64 (m);
+      }
+
+      if (total != sparse->nnz) {
+        nns_loge ("Invalid bitmap, mismatched nnz %u (bitmap %" G_GUINT64_FORMAT
+            ")", sparse->nnz, total);
+        return FALSE;
+      }
+
+      switch (element_size) {
+        case 1:
+          sparse_expand (uint8_t, data + ((count + 63) / 64) * sizeof (guint64),
+              data, count, dense);
+          break;
+        case 2:
+          sparse_expand (uint16_t, data + ((count + 63) / 64) * sizeof (guint64),
+              data, count, dense);
+          break;
+        case 4:
+          sparse_expand (uint32_t, data + ((count + 63) / 64) * sizeof (guint64),
+              data, count, dense);
+          break;
+        case 8:
+          sparse_expand (uint64_t, data + ((count + 63) / 64) * sizeof (guint64),
+              data, count, dense);
+          break;
+        default:
+          return FALSE;
+      }
+      break;
+    case _NNS_SPARSE_ENCODING_BLOCK:
+      block = block_size;
+      indices = data + sparse->nnz * block * element_size;
+
+      /* copy non-zero blocks and fill zero between blocks */
+      end = 0;
+      for (i = 0; i < sparse->nnz; i++) {
+        start = (guint64) sparse_get_index (indices, i) * block;
+        if (start < end || start >= count) {
+          nns_loge ("Invalid block index %u", sparse_get_index (indices, i));
+          return FALSE;
+        }
+
+        len = MIN (block, count - start);
+        memset (dense + end * element_size, 0, (start - end) * element_size);
+        memcpy (dense + start * element_size,
+            data + i * block * element_size, len * element_size);
+        end = start + len;
+      }
+
+      memset (dense + end * element_size, 0, (count - end) * element_size);
+      break;
+    default:
+      indices = data + sparse->nnz * element_size;
+
+      for (i = 0; i < sparse->nnz; i++) {
+        if (sparse_get_index (indices, i) >= count) {
+          nns_loge ("Invalid index %u", sparse_get_index (indices, i));
+          return FALSE;
+        }
+      }
+
+      memset (dense, 0, dense_size);
+
+      switch (element_size) {
+        case 1:
+          sparse_scatter (uint8_t, data, indices, sparse->nnz, dense);
+          break;
+        case 2:
+          sparse_scatter (uint16_t, data, indices, sparse->nnz, dense);
+          break;
+        case 4:
+          sparse_scatter (uint32_t, data, indices, sparse->nnz, dense);
+          break;
+        case 8:
+          sparse_scatter (uint64_t, data, indices, sparse->nnz, dense);
+          break;
+        default:
+          return FALSE;
+      }
+      break;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Fill given dense tensor data with input sparse tensor.
  * @param[in,out] meta tensor meta structure to be updated
  * @param[in] mem gst-memory of sparse tensor data
- * @return pointer of GstMemory with dense tensor data or NULL on error. Caller should handle this newly allocated memory.
+ * @param[out] dense pointer of dense tensor data to be filled
+ * @param[in] size the size of dense tensor data
+ * @return TRUE if dense tensor data is filled
  */
-GstMemory *
-gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
+gboolean
+gst_tensor_sparse_to_dense_into (GstTensorMetaInfo * meta, GstMemory * mem,
+    gpointer dense, gsize size)
 {
-  GstMemory *dense = NULL;
+  GstTensorMetaInfo dense_meta;
   GstMapInfo map;
-  guint i, nnz;
-  guint8 *output, *input;
-  guint *indices;
-  gsize output_size, element_size;
+  gsize header_size, element_size, output_size;
+  guint encoding, block_size;
+  gboolean ret = FALSE;
+
+  g_return_val_if_fail (meta != NULL, FALSE);
+  g_return_val_if_fail (dense != NULL, FALSE);
 
   if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
     nns_loge ("Failed to map given memory");
-    return NULL;
+    return FALSE;
   }
 
-  if (!gst_tensor_meta_info_parse_header (meta, map.data)) {
+  if (!gst_tensor_meta_info_parse_header (meta, map.data) ||
+      !gst_tensor_meta_info_get_sparse_encoding (map.data, &encoding,
+          &block_size)) {
     nns_loge ("Failed to parse meta info from given memory");
     goto done;
   }
 
-  meta->format = _NNS_TENSOR_FORMAT_STATIC;
+  dense_meta = *meta;
+  dense_meta.format = _NNS_TENSOR_FORMAT_STATIC;
 
+  header_size = gst_tensor_meta_info_get_header_size (meta);
   element_size = gst_tensor_get_element_size (meta->type);
-  output_size = gst_tensor_meta_info_get_data_size (meta);
+  output_size = gst_tensor_meta_info_get_data_size (&dense_meta);
 
-  if (element_size == 0 || output_size == 0) {
+  if (element_size == 0 || output_size == 0 || map.size < header_size) {
     nns_loge ("Got invalid meta info");
     goto done;
   }
 
-  output = (guint8 *) g_malloc0 (output_size);
-
-  nnz = meta->sparse_info.nnz;
-  input = map.data + gst_tensor_meta_info_get_header_size (meta);
-  indices = (guint *) (input + element_size * nnz);
-
-  for (i = 0; i < nnz; ++i) {
-    switch (meta->type) {
-      case _NNS_INT32:
-        ((int32_t *) output)[indices[i]] = ((int32_t *) input)[i];
-        break;
-      case _NNS_UINT32:
-        ((uint32_t *) output)[indices[i]] = ((uint32_t *) input)[i];
-        break;
-      case _NNS_INT16:
-        ((int16_t *) output)[indices[i]] = ((int16_t *) input)[i];
-        break;
-      case _NNS_UINT16:
-        ((uint16_t *) output)[indices[i]] = ((uint16_t *) input)[i];
-        break;
-      case _NNS_INT8:
-        ((int8_t *) output)[indices[i]] = ((int8_t *) input)[i];
-        break;
-      case _NNS_UINT8:
-        ((uint8_t *) output)[indices[i]] = ((uint8_t *) input)[i];
-        break;
-      case _NNS_FLOAT64:
-        ((double *) output)[indices[i]] = ((double *) input)[i];
-        break;
-      case _NNS_FLOAT32:
-        ((float *) output)[indices[i]] = ((float *) input)[i];
-        break;
-      case _NNS_INT64:
-        ((int64_t *) output)[indices[i]] = ((int64_t *) input)[i];
-        break;
-      case _NNS_UINT64:
-        ((uint64_t *) output)[indices[i]] = ((uint64_t *) input)[i];
-        break;
-      default:
-        nns_loge ("Error occured during get tensor value");
-        g_free (output);
-        goto done;
-    }
+  if (output_size != size) {
+    nns_loge ("Invalid size of dense tensor, expected %" G_GSIZE_FORMAT
+        " but given %" G_GSIZE_FORMAT, output_size, size);
+    goto done;
+  }
+
+  if (map.size - header_size <
+      gst_tensor_meta_info_get_data_size_from_header (map.data)) {
+    nns_loge ("The size of sparse data is smaller than expected");
+    goto done;
   }
 
-  dense = gst_memory_new_wrapped (0, output, output_size, 0, output_size,
-      output, g_free);
+  ret = _sparse_decode (meta, encoding, block_size, map.data + header_size,
+      (guint8 *) dense, size);
+  if (ret)
+    meta->format = _NNS_TENSOR_FORMAT_STATIC;
 
 done:
   gst_memory_unmap (mem, &map);
+  return ret;
+}
+
+/**
+ * @brief Make dense tensor with input sparse tensor.
+ * @param[in,out] meta tensor meta structure to be updated
+ * @param[in] mem gst-memory of sparse tensor data
+ * @return pointer of GstMemory with dense tensor data or NULL on error. Caller should handle this newly allocated memory.
+ */
+GstMemory *
+gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
+{
+  GstMemory *dense = NULL;
+  GstMapInfo map;
+  gsize output_size;
+
+  if (!gst_tensor_meta_info_parse_memory (meta, mem)) {
+    nns_loge ("Failed to parse meta info from given memory");
+    return NULL;
+  }
+
+  meta->format = _NNS_TENSOR_FORMAT_STATIC;
+  output_size = gst_tensor_meta_info_get_data_size (meta);
+
+  if (output_size == 0) {
+    nns_loge ("Got invalid meta info");
+    return NULL;
+  }
+
+  dense = gst_allocator_alloc (NULL, output_size, NULL);
+  if (!gst_memory_map (dense, &map, GST_MAP_WRITE)) {
+    nns_loge ("Failed to map dense memory");
+    gst_memory_unref (dense);
+    return NULL;
+  }
+
+  if (!gst_tensor_sparse_to_dense_into (meta, mem, map.data, output_size)) {
+    gst_memory_unmap (dense, &map);
+    gst_memory_unref (dense);
+    return NULL;
+  }
+
+  gst_memory_unmap (dense, &map);
   return dense;
 }
 
@@ -114,16 +507,31 @@ done:
  */
 GstMemory *
 gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem)
+{
+  return gst_tensor_sparse_from_dense_full (meta, mem,
+      _NNS_SPARSE_ENCODING_COO, 0);
+}
+
+/**
+ * @brief Make sparse tensor with input dense tensor and given encoding.
+ * @param[in,out] meta tensor meta structure to be updated
+ * @param[in] mem gst-memory of dense tensor data
+ * @param[in] encoding the encoding of sparse tensor (tensor_sparse_encoding or TENSOR_SPARSE_ENCODING_AUTO)
+ * @param[in] block_size the number of elements in a block with block (or auto) encoding
+ * @return pointer of GstMemory with sparse tensor data or NULL on error. Caller should handle this newly allocated memory.
+ */
+GstMemory *
+gst_tensor_sparse_from_dense_full (GstTensorMetaInfo * meta, GstMemory * mem,
+    guint encoding, guint block_size)
 {
   GstMemory *sparse = NULL;
-  GstMapInfo map;
-  guint i, nnz = 0;
-  guint8 *output;
-  tensor_type data_type;
-  void *values;
-  guint *indices;
-  gsize output_size, header_size, element_size;
-  gulong element_count;
+  GstMapInfo map, out_map;
+  guint64 *mask = NULL;
+  guint8 *values;
+  guint8 *indices;
+  gsize header_size, element_size, block_bytes;
+  gsize size[_NNS_SPARSE_ENCODING_END];
+  gulong element_count, num_words, i, j, nnz, nzb;
 
   if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
     nns_loge ("Failed to map given memory");
@@ -134,122 +542,109 @@ gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem)
   element_size = gst_tensor_get_element_size (meta->type);
   element_count = gst_tensor_get_element_count (meta->dimension);
 
-  if (element_size == 0 || element_count == 0) {
+  if (element_size == 0 || element_count == 0 ||
+      map.size < element_size * element_count) {
     nns_loge ("Got invalid meta info");
     goto done;
   }
 
-  /** alloc maximum possible size of memory */
-  values = g_malloc0 (element_size * element_count);
-  indices = g_malloc0 (sizeof (guint) * element_count);
+  if (encoding > TENSOR_SPARSE_ENCODING_AUTO ||
+      (encoding == _NNS_SPARSE_ENCODING_BLOCK && block_size == 0)) {
+    nns_loge ("Invalid sparse encoding %u (block size %u)", encoding,
+        block_size);
+    goto done;
+  }
 
-  data_type = meta->type;
+  /* first pass: bitmap of non-zero elements and the size of each encoding */
+  num_words = (element_count + 63) / 64;
+  mask = g_new (guint64, num_words);
 
-  /** Consider using macro to reduce loc and readability */
-  for (i = 0; i < element_count; ++i) {
-    switch (data_type) {
-      case _NNS_INT32:
-        if (((int32_t *) map.data)[i] != 0) {
-          ((int32_t *) values)[nnz] = ((int32_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT32:
-        if (((uint32_t *) map.data)[i] != 0) {
-          ((uint32_t *) values)[nnz] = ((uint32_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT16:
-        if (((int16_t *) map.data)[i] != 0) {
-          ((int16_t *) values)[nnz] = ((int16_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT16:
-        if (((uint16_t *) map.data)[i] != 0) {
-          ((uint16_t *) values)[nnz] = ((uint16_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT8:
-        if (((int8_t *) map.data)[i] != 0) {
-          ((int8_t *) values)[nnz] = ((int8_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT8:
-        if (((uint8_t *) map.data)[i] != 0) {
-          ((uint8_t *) values)[nnz] = ((uint8_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_FLOAT64:
-        if (((double *) map.data)[i] != 0) {
-          ((double *) values)[nnz] = ((double *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_FLOAT32:
-        if (((float *) map.data)[i] != 0) {
-          ((float *) values)[nnz] = ((float *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT64:
-        if (((int64_t *) map.data)[i] != 0) {
-          ((int64_t *) values)[nnz] = ((int64_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT64:
-        if (((uint64_t *) map.data)[i] != 0) {
-          ((uint64_t *) values)[nnz] = ((uint64_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      default:
-        nns_loge ("Error occured during get tensor value");
-        g_free (values);
-        g_free (indices);
-        goto done;
+  if (!_sparse_get_mask ((tensor_type) meta->type, map.data, element_count,
+          mask)) {
+    nns_loge ("Error occured during get tensor value");
+    goto done;
+  }
+
+  nnz = 0;
+  for (i = 0; i < num_words; i++)
+    nnz += sparse_popcount64 (mask[i]);
+
+  nzb = 0;
+  if (block_size > 0 && (encoding == _NNS_SPARSE_ENCODING_BLOCK ||
+          encoding == TENSOR_SPARSE_ENCODING_AUTO)) {
+    for (i = 0; i < element_count; i += block_size) {
+      if (_sparse_mask_any (mask, i, MIN (block_size, element_count - i)))
+        nzb++;
     }
   }
 
-  /** update meta nnz info */
+  block_bytes = block_size * element_size;
+  size[_NNS_SPARSE_ENCODING_COO] = nnz * (element_size + sizeof (guint));
+  size[_NNS_SPARSE_ENCODING_BITMAP] =
+      num_words * sizeof (guint64) + nnz * element_size;
+  size[_NNS_SPARSE_ENCODING_BLOCK] = nzb * (block_bytes + sizeof (guint));
+
+  if (encoding == TENSOR_SPARSE_ENCODING_AUTO) {
+    encoding = _NNS_SPARSE_ENCODING_COO;
+    if (size[_NNS_SPARSE_ENCODING_BITMAP] < size[encoding])
+      encoding = _NNS_SPARSE_ENCODING_BITMAP;
+    if (block_size > 0 && size[_NNS_SPARSE_ENCODING_BLOCK] < size[encoding])
+      encoding = _NNS_SPARSE_ENCODING_BLOCK;
+  }
+
+  /** update meta info */
   meta->format = _NNS_TENSOR_FORMAT_SPARSE;
-  meta->sparse_info.nnz = nnz;
+  meta->sparse_info.nnz =
+      (encoding == _NNS_SPARSE_ENCODING_BLOCK) ? nzb : nnz;
 
-  /** write to output buffer */
-  output_size = element_size * nnz + sizeof (guint) * nnz;
+  /* second pass: compress non-zero elements into exactly sized memory */
+  sparse = gst_allocator_alloc (NULL, header_size + size[encoding], NULL);
+  if (!gst_memory_map (sparse, &out_map, GST_MAP_WRITE)) {
+    nns_loge ("Failed to map sparse memory");
+    gst_memory_unref (sparse);
+    sparse = NULL;
+    goto done;
+  }
+
+  gst_tensor_meta_info_update_header (meta, out_map.data);
+  gst_tensor_meta_info_set_sparse_encoding (out_map.data, encoding, block_size);
+  values = out_map.data + header_size;
 
-  /** add meta info header */
-  output_size += header_size;
-  output = g_malloc0 (output_size);
+  switch (encoding) {
+    case _NNS_SPARSE_ENCODING_BITMAP:
+      memcpy (values, mask, num_words * sizeof (guint64));
+      _sparse_compress (element_size, map.data, mask, num_words,
+          values + num_words * sizeof (guint64), NULL);
+      break;
+    case _NNS_SPARSE_ENCODING_BLOCK:
+      indices = values + nzb * block_bytes;
 
-  gst_tensor_meta_info_update_header (meta, output);
+      for (i = 0, j = 0; i < element_count; i += block_size) {
+        gsize len;
 
-  memcpy (output + header_size, values, element_size * nnz);
-  memcpy (output + header_size + (element_size * nnz),
-      indices, sizeof (guint) * nnz);
+        if (!_sparse_mask_any (mask, i, MIN (block_size, element_count - i)))
+          continue;
 
-  g_free (values);
-  g_free (indices);
+        /* the last block may be partial, fill zero */
+        len = MIN (block_size, element_count - i) * element_size;
+        memcpy (values + j * block_bytes, map.data + i * element_size, len);
+        if (len < block_bytes)
+          memset (values + j * block_bytes + len, 0, block_bytes - len);
+
+        sparse_set_index (indices, j++, (guint) (i / block_size));
+      }
+      break;
+    default:
+      indices = values + nnz * element_size;
+      _sparse_compress (element_size, map.data, mask, num_words, values,
+          indices);
+      break;
+  }
 
-  sparse = gst_memory_new_wrapped (0, output, output_size, 0, output_size,
-      output, g_free);
+  gst_memory_unmap (sparse, &out_map);
 
 done:
+  g_free (mask);
   gst_memory_unmap (mem, &map);
   return sparse;
 }
@@ -20,6 +20,11 @@
 
 G_BEGIN_DECLS
 
+/**
+ * @brief Sparse encoding to select the encoding with the smallest data size. (see gst_tensor_sparse_from_dense())
+ */
+#define TENSOR_SPARSE_ENCODING_AUTO (_NNS_SPARSE_ENCODING_END)
+
 /**
  * @brief Make dense tensor with input sparse tensor.
  * @param[in,out] meta tensor meta structure to be updated
@@ -29,14 +34,39 @@ G_BEGIN_DECLS
 extern GstMemory *
 gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem);
 
+/**
+ * @brief Fill given dense tensor data with input sparse tensor.
+ * @param[in,out] meta tensor meta structure to be updated
+ * @param[in] mem gst-memory of sparse tensor data
+ * @param[out] dense pointer of dense tensor data to be filled
+ * @param[in] size the size of dense tensor data
+ * @return TRUE if dense tensor data is filled
+ */
+extern gboolean
+gst_tensor_sparse_to_dense_into (GstTensorMetaInfo * meta, GstMemory * mem, gpointer dense, gsize size);
+
 /**
  * @brief Make sparse tensor with input dense tensor.
  * @param[in,out] meta tensor meta structure to be updated
  * @param[in] mem gst-memory of dense tensor data
  * @return pointer of GstMemory with sparse tensor data or NULL on error. Caller should handle this newly allocated memory.
+ * @note The sparse tensor is encoded with COO encoding.
  */
 extern GstMemory *
 gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem);
 
+/**
+ * @brief Make sparse tensor with input dense tensor and given encoding.
+ * @param[in,out] meta tensor meta structure to be updated
+ * @param[in] mem gst-memory of dense tensor data
+ * @param[in] encoding the encoding of sparse tensor (tensor_sparse_encoding or TENSOR_SPARSE_ENCODING_AUTO)
+ * @param[in] block_size the number of elements in a block with block (or auto) encoding
+ * @return pointer of GstMemory with sparse tensor data or NULL on error. Caller should handle this newly allocated memory.
+ * @note The selected encoding is written in the header of sparse tensor (see gst_tensor_meta_info_get_sparse_encoding()).
+ */
+extern GstMemory *
+gst_tensor_sparse_from_dense_full (GstTensorMetaInfo * meta, GstMemory * mem,
+    guint encoding, guint block_size);
+
 G_END_DECLS
 #endif /* __GST_TENSOR_SPARSE_UTIL_H__ */
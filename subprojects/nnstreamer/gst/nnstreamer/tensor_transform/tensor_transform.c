@@ -68,16 +68,16 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_transform_debug);
 #define GST_CAT_DEFAULT gst_tensor_transform_debug
 #define CAPS_STRING GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_MAKE ("{ static, flexible }")
 #define REGEX_DIMCHG_OPTION "^([0-3]):([0-3])$"
-#define REGEX_TYPECAST_OPTION "(^[u]?int(8|16|32|64)$|^float(32|64)$)"
+#define REGEX_TYPECAST_OPTION "(^[u]?int(8|16|32|64)$|^b?float(16|32|64)$)"
 #define REGEX_TRANSPOSE_OPTION "^(?:([0-2]):(?!.*\\1)){3}3$"
-#define REGEX_STAND_OPTION "^(default|dc-average)(:([u]?int(8|16|32|64)|float(32|64)))?(,per-channel:(true|false))?$"
+#define REGEX_STAND_OPTION "^(default|dc-average)(:([u]?int(8|16|32|64)|b?float(16|32|64)))?(,per-channel:(true|false))?$"
 #define REGEX_CLAMP_OPTION "^((([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?))):"\
     "((([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?)))$"
-#define REGEX_ARITH_OPTION "^(typecast:([u]?int(8|16|32|64)|float(32|64)),)?"\
+#define REGEX_ARITH_OPTION "^(typecast:([u]?int(8|16|32|64)|b?float(16|32|64)),)?"\
     "(per-channel:(false|true@[0-9]+),)?"\
     "(((add|mul|div)(:([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?))+(@[0-9]+)?)(,|))+$"
 
-#define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|float(32|64)))"
+#define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|b?float(16|32|64)))"
 
 /**
  * @brief tensor_transform properties
@@ -283,6 +283,8 @@ gst_tensor_transform_init (GstTensorTransform * filter)
   filter->operators = NULL;
   filter->acceleration = DEFAULT_ACCELERATION;
   filter->apply = NULL;
+  filter->half_buf = NULL;
+  filter->half_buf_size = 0;
 
   gst_tensors_config_init (&filter->in_config);
   gst_tensors_config_init (&filter->out_config);
@@ -939,6 +941,10 @@ gst_tensor_transform_finalize (GObject * object)
     filter->apply = NULL;
   }
 
+  g_free (filter->half_buf);
+  filter->half_buf = NULL;
+  filter->half_buf_size = 0;
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -1143,7 +1149,7 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
             op_s = (tensor_transform_operator_s *) walk->data;
             switch (op_s->op) {
               case GTT_OP_TYPECAST:
-                gst_tensor_data_typecast (&value, op_s->value.type);
+                gst_tensor_data_typecast (&value, out_info->type);
                 break;
               case GTT_OP_ADD:
               case GTT_OP_MUL:
@@ -1189,7 +1195,7 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
        */
       switch (op_s->op) {
         case GTT_OP_TYPECAST:
-          gst_tensor_data_typecast (&value, op_s->value.type);
+          gst_tensor_data_typecast (&value, out_info->type);
           break;
         case GTT_OP_ADD:
         case GTT_OP_MUL:
@@ -1460,6 +1466,93 @@ gst_tensor_transform_clamp (GstTensorTransform * filter,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Function type of the subroutines for tensor-transform modes.
+ */
+typedef GstFlowReturn (*GstTensorTransformFunc) (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr);
+
+/**
+ * @brief Run the subroutine for half precision (float16, bfloat16) tensors.
+ * There is no arithmetic for half precision on CPU. The input is converted
+ * to float32 in bulk, the mode runs in float32 (with orc if enabled) and the
+ * result is rounded once to the half precision output.
+ * @param[in/out] filter "this" pointer
+ * @param[in] func subroutine of the mode
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_half (GstTensorTransform * filter,
+    GstTensorTransformFunc func, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr)
+{
+  GstTensorInfo in_f32, out_f32;
+  gboolean in_half, out_half;
+  gsize num, size;
+  gfloat *in_buf, *out_buf;
+  GstFlowReturn ret;
+
+  in_half = gst_tensor_data_is_half (in_info->type);
+  out_half = gst_tensor_data_is_half (out_info->type);
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+  /* typecast between half precision and float32 needs a single pass */
+  if (func == gst_tensor_transform_typecast) {
+    if (in_half && out_info->type == _NNS_FLOAT32) {
+      gst_tensor_data_raw_half_to_float (inptr, in_info->type,
+          (gfloat *) outptr, num);
+      return GST_FLOW_OK;
+    }
+
+    if (out_half && in_info->type == _NNS_FLOAT32) {
+      gst_tensor_data_raw_float_to_half ((const gfloat *) inptr, outptr,
+          out_info->type, num);
+      return GST_FLOW_OK;
+    }
+  }
+
+  size = sizeof (gfloat) * num * ((in_half ? 1 : 0) + (out_half ? 1 : 0));
+  if (filter->half_buf_size < size) {
+    g_free (filter->half_buf);
+    filter->half_buf = g_try_malloc (size);
+    filter->half_buf_size = filter->half_buf ? size : 0;
+
+    if (!filter->half_buf) {
+      GST_ERROR_OBJECT (filter, "Failed to allocate the float32 buffer.");
+      return GST_FLOW_ERROR;
+    }
+  }
+
+  in_buf = out_buf = (gfloat *) filter->half_buf;
+  if (in_half)
+    out_buf += num;
+
+  in_f32 = *in_info;
+  out_f32 = *out_info;
+
+  if (in_half) {
+    gst_tensor_data_raw_half_to_float (inptr, in_info->type, in_buf, num);
+    in_f32.type = _NNS_FLOAT32;
+    inptr = (const uint8_t *) in_buf;
+  }
+
+  if (out_half)
+    out_f32.type = _NNS_FLOAT32;
+
+  ret = func (filter, &in_f32, &out_f32, inptr,
+      out_half ? (uint8_t *) out_buf : outptr);
+
+  if (ret == GST_FLOW_OK && out_half)
+    gst_tensor_data_raw_float_to_half (out_buf, outptr, out_info->type, num);
+
+  return ret;
+}
+
 /**
  * @brief non-ip transform. required vmethod for BaseTransform class.
  * @param[in/out] trans "super" pointer
@@ -1484,6 +1577,7 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
   GstTensorMetaInfo meta;
   GstTensorInfo in_flex_info, out_flex_info;
   gboolean in_flexible, out_flexible;
+  GstTensorTransformFunc func;
 
   filter = GST_TENSOR_TRANSFORM_CAST (trans);
 
@@ -1575,34 +1669,38 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
 
     switch (filter->mode) {
       case GTT_DIMCHG:
-        res = gst_tensor_transform_dimchg (filter, in_info, out_info,
-            inptr, outptr);
+        func = gst_tensor_transform_dimchg;
         break;
       case GTT_TYPECAST:
-        res = gst_tensor_transform_typecast (filter, in_info, out_info,
-            inptr, outptr);
+        func = gst_tensor_transform_typecast;
         break;
       case GTT_ARITHMETIC:
-        res = gst_tensor_transform_arithmetic (filter, in_info, out_info,
-            inptr, outptr);
+        func = gst_tensor_transform_arithmetic;
         break;
       case GTT_TRANSPOSE:
-        res = gst_tensor_transform_transpose (filter, in_info, out_info,
-            inptr, outptr);
+        func = gst_tensor_transform_transpose;
         break;
       case GTT_STAND:
-        res = gst_tensor_transform_stand (filter, in_info, out_info,
-            inptr, outptr);
+        func = gst_tensor_transform_stand;
         break;
       case GTT_CLAMP:
-        res = gst_tensor_transform_clamp (filter, in_info, out_info,
-            inptr, outptr);
+        func = gst_tensor_transform_clamp;
         break;
       default:
         ml_loge ("Not supported tensor transform mode");
         res = GST_FLOW_NOT_SUPPORTED;
         goto done;
     }
+
+    /* dimchg and transpose move elements only, others compute the value */
+    if (filter->mode != GTT_DIMCHG && filter->mode != GTT_TRANSPOSE &&
+        (gst_tensor_data_is_half (in_info->type) ||
+            gst_tensor_data_is_half (out_info->type))) {
+      res = gst_tensor_transform_half (filter, func, in_info, out_info,
+          inptr, outptr);
+    } else {
+      res = func (filter, in_info, out_info, inptr, outptr);
+    }
   }
 
 done:
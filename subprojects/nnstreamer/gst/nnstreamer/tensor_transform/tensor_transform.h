@@ -165,6 +165,9 @@ struct _GstTensorTransform
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
   GList *apply; /**< Select the tensors to apply transformation */
+
+  gpointer half_buf; /**< float32 scratch buffer to transform half precision tensors */
+  gsize half_buf_size; /**< size of the scratch buffer */
 };
 
 /**
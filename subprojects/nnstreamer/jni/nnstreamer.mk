@@ -55,12 +55,14 @@ NNSTREAMER_PLUGINS_SRCS := \
     $(NNSTREAMER_GST_HOME)/tensor_decoder/tensordec.c \
     $(NNSTREAMER_GST_HOME)/tensor_demux/gsttensordemux.c \
     $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter.c \
+    $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_cascade.c \
     $(NNSTREAMER_GST_HOME)/tensor_merge/gsttensormerge.c \
     $(NNSTREAMER_GST_HOME)/tensor_mux/gsttensormux.c \
     $(NNSTREAMER_GST_HOME)/tensor_repo/tensor_repo.c \
     $(NNSTREAMER_GST_HOME)/tensor_repo/tensor_reposink.c \
     $(NNSTREAMER_GST_HOME)/tensor_repo/tensor_reposrc.c \
     $(NNSTREAMER_GST_HOME)/tensor_sink/tensor_sink.c \
+    $(NNSTREAMER_GST_HOME)/tensor_source/tensor_src_synthetic.c \
     $(NNSTREAMER_GST_HOME)/tensor_sparse/tensor_sparse_util.c \
     $(NNSTREAMER_GST_HOME)/tensor_sparse/tensor_sparse_enc.c \
     $(NNSTREAMER_GST_HOME)/tensor_sparse/tensor_sparse_dec.c \
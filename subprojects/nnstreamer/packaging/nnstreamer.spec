@@ -1061,6 +1061,7 @@ cp -r result %{buildroot}%{_datadir}/nnstreamer/unittest/
 
 %files devel
 %{_includedir}/nnstreamer/tensor_if.h
+%{_includedir}/nnstreamer/tensor_sink_api.h
 %{_includedir}/nnstreamer/tensor_filter_custom.h
 %{_includedir}/nnstreamer/tensor_filter_custom_easy.h
 %{_includedir}/nnstreamer/tensor_converter_custom.h
@@ -18,7 +18,10 @@
 #include <glib/gstdio.h>
 #include <nnstreamer_conf.h>
 #include <nnstreamer_plugin_api.h>
+#include <nnstreamer_subplugin.h>
 #include <tensor_common.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <unittest_util.h>
 
@@ -191,6 +194,31 @@ TEST (commonGetTensorType, float64_n)
   EXPECT_EQ (gst_tensor_get_type ("float6"), _NNS_END);
 }
 
+/**
+ * @brief Test for half precision type string.
+ */
+TEST (commonGetTensorType, float16)
+{
+  EXPECT_EQ (gst_tensor_get_type ("float16"), _NNS_FLOAT16);
+  EXPECT_EQ (gst_tensor_get_type ("FLOAT16"), _NNS_FLOAT16);
+  EXPECT_EQ (gst_tensor_get_type ("bfloat16"), _NNS_BFLOAT16);
+  EXPECT_EQ (gst_tensor_get_type ("BFloat16"), _NNS_BFLOAT16);
+  EXPECT_STREQ (gst_tensor_get_type_string (_NNS_FLOAT16), "float16");
+  EXPECT_STREQ (gst_tensor_get_type_string (_NNS_BFLOAT16), "bfloat16");
+  EXPECT_EQ (gst_tensor_get_element_size (_NNS_FLOAT16), 2U);
+  EXPECT_EQ (gst_tensor_get_element_size (_NNS_BFLOAT16), 2U);
+}
+
+/**
+ * @brief Test for half precision type string.
+ */
+TEST (commonGetTensorType, float16_n)
+{
+  EXPECT_EQ (gst_tensor_get_type ("float8"), _NNS_END);
+  EXPECT_EQ (gst_tensor_get_type ("bfloat32"), _NNS_END);
+  EXPECT_EQ (gst_tensor_get_type ("bfloat"), _NNS_END);
+}
+
 /**
  * @brief Test for int64 type string.
  */
@@ -1706,6 +1734,169 @@ TEST (confCustom, subpluginPrefix_n)
   EXPECT_STREQ (nnsconf_get_subplugin_name_prefix ((nnsconf_type_path) -1), NULL);
 }
 
+/**
+ * @brief Test subplugin manifest with the subplugin not loaded from a module.
+ */
+TEST (confCustom, subpluginManifestUnknown_n)
+{
+  EXPECT_TRUE (subplugin_get_manifest_value (NNS_SUBPLUGIN_CONVERTER, "not-existing-converter", "caps") == NULL);
+  EXPECT_FALSE (subplugin_set_manifest_value (NNS_SUBPLUGIN_CONVERTER, "not-existing-converter", "caps", "other/tensors"));
+  EXPECT_TRUE (subplugin_get_manifest_value (NNS_CUSTOM_DECODER, "custom-decoder", "caps") == NULL);
+}
+
+/**
+ * @brief Test subplugin manifest with invalid param.
+ */
+TEST (confCustom, subpluginManifestInvalidParam_n)
+{
+  EXPECT_TRUE (subplugin_get_manifest_value (NNS_SUBPLUGIN_FILTER, NULL, "key") == NULL);
+  EXPECT_TRUE (subplugin_get_manifest_value (NNS_SUBPLUGIN_FILTER, "custom", NULL) == NULL);
+  EXPECT_FALSE (subplugin_set_manifest_value (NNS_SUBPLUGIN_FILTER, NULL, "key", "value"));
+  EXPECT_FALSE (subplugin_set_manifest_value (NNS_SUBPLUGIN_FILTER, "custom", NULL, "value"));
+  EXPECT_FALSE (subplugin_set_manifest_value (NNS_SUBPLUGIN_FILTER, "custom", "key", NULL));
+  /* reserved key */
+  EXPECT_FALSE (subplugin_set_manifest_value (NNS_SUBPLUGIN_FILTER, "custom", "module", "/tmp/a.so"));
+}
+
+/**
+ * @brief Test subplugin manifest: written at loading, reused after reload and invalidated by the changed module.
+ */
+TEST (confCustom, subpluginManifest_p)
+{
+  gchar *fullpath = g_build_path ("/", g_get_tmp_dir (), "nns-manifest-XXXXXX", NULL);
+  gchar *dir = g_mkdtemp (fullpath);
+  gchar *dird = g_build_path ("/", dir, "decoders", NULL);
+  gchar *filename = g_build_path ("/", dir, "nnstreamer.ini", NULL);
+  gchar *manifest_file = g_build_path ("/", dir, "manifest.ini", NULL);
+  gchar *module = g_build_path ("/", dird,
+      "libnnstreamer_decoder_direct_video" NNSTREAMER_SO_FILE_EXTENSION, NULL);
+  gchar *confenv = g_strdup (g_getenv ("NNSTREAMER_CONF"));
+  gchar *contents, *group, *value;
+  const gchar *orig_module;
+  struct timespec times[2];
+  GKeyFile *key_file;
+  gsize len;
+  FILE *fp;
+
+  /* copy of the decoder module built with nnstreamer */
+  orig_module = nnsconf_get_fullpath ("direct_video", NNSCONF_PATH_DECODERS);
+  if (orig_module == NULL) {
+    /* the decoder is not built */
+    goto done;
+  }
+
+  EXPECT_EQ (g_mkdir (dird, 0755), 0);
+  ASSERT_TRUE (g_file_get_contents (orig_module, &contents, &len, NULL));
+  ASSERT_TRUE (g_file_set_contents (module, contents, len, NULL));
+  g_free (contents);
+
+  fp = g_fopen (filename, "w");
+  ASSERT_TRUE (fp != NULL);
+  g_fprintf (fp, "[common]\n");
+  g_fprintf (fp, "enable_envvar=False\n");
+  g_fprintf (fp, "subplugin_manifest=%s\n", manifest_file);
+  g_fprintf (fp, "[decoder]\n");
+  g_fprintf (fp, "decoders=%s\n", dird);
+  fclose (fp);
+
+  EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", filename, TRUE));
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  subplugin_reload_manifest ();
+
+  /* written when the module is loaded */
+  EXPECT_FALSE (g_file_test (manifest_file, G_FILE_TEST_EXISTS));
+  EXPECT_TRUE (get_subplugin (NNS_SUBPLUGIN_DECODER, "direct_video") != NULL);
+  EXPECT_TRUE (g_file_test (manifest_file, G_FILE_TEST_IS_REGULAR));
+
+  key_file = g_key_file_new ();
+  ASSERT_TRUE (g_key_file_load_from_file (key_file, manifest_file, G_KEY_FILE_NONE, NULL));
+  value = g_key_file_get_string (key_file, "decoder:direct_video", "module", NULL);
+  EXPECT_STREQ (value, module);
+  g_free (value);
+  group = g_strdup_printf ("module:%s", module);
+  EXPECT_EQ (g_key_file_get_int64 (key_file, group, "size", NULL), (gint64) len);
+  EXPECT_TRUE (g_key_file_has_key (key_file, group, "mtime", NULL));
+  EXPECT_TRUE (g_key_file_has_key (key_file, group, "mtime-nsec", NULL));
+  g_free (group);
+  g_key_file_free (key_file);
+
+  EXPECT_TRUE (subplugin_set_manifest_value (NNS_SUBPLUGIN_DECODER, "direct_video", "caps", "video/x-raw"));
+
+  /* reused from the file, without loading the module */
+  subplugin_reload_manifest ();
+  value = subplugin_get_manifest_value (NNS_SUBPLUGIN_DECODER, "direct_video", "caps");
+  EXPECT_STREQ (value, "video/x-raw");
+  g_free (value);
+
+  /* the module changed within the same second is not valid anymore */
+  times[0].tv_sec = times[1].tv_sec = 1000000000;
+  times[0].tv_nsec = times[1].tv_nsec = 100;
+  ASSERT_EQ (utimensat (AT_FDCWD, module, times, 0), 0);
+  EXPECT_TRUE (subplugin_get_manifest_value (NNS_SUBPLUGIN_DECODER, "direct_video", "caps") == NULL);
+
+  g_remove (manifest_file);
+  g_remove (module);
+  g_rmdir (dird);
+  g_remove (filename);
+
+done:
+  if (confenv) {
+    EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", confenv, TRUE));
+    g_free (confenv);
+  } else {
+    g_unsetenv ("NNSTREAMER_CONF");
+  }
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  subplugin_reload_manifest ();
+
+  g_rmdir (dir);
+  g_free (module);
+  g_free (manifest_file);
+  g_free (filename);
+  g_free (dird);
+  g_free (fullpath);
+}
+
+/**
+ * @brief Test subplugin manifest disabled without the configuration.
+ */
+TEST (confCustom, subpluginManifestDisabled_n)
+{
+  gchar *fullpath = g_build_path ("/", g_get_tmp_dir (), "nns-manifest-XXXXXX", NULL);
+  gchar *dir = g_mkdtemp (fullpath);
+  gchar *filename = g_build_path ("/", dir, "nnstreamer.ini", NULL);
+  gchar *confenv = g_strdup (g_getenv ("NNSTREAMER_CONF"));
+  FILE *fp;
+
+  fp = g_fopen (filename, "w");
+  ASSERT_TRUE (fp != NULL);
+  g_fprintf (fp, "[common]\n");
+  g_fprintf (fp, "enable_envvar=False\n");
+  fclose (fp);
+
+  EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", filename, TRUE));
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  subplugin_reload_manifest ();
+
+  EXPECT_TRUE (check_custom_conf ("common", "subplugin_manifest", NULL));
+  EXPECT_TRUE (subplugin_get_manifest_value (NNS_SUBPLUGIN_DECODER, "direct_video", "caps") == NULL);
+  EXPECT_FALSE (subplugin_set_manifest_value (NNS_SUBPLUGIN_DECODER, "direct_video", "caps", "video/x-raw"));
+
+  if (confenv) {
+    EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", confenv, TRUE));
+    g_free (confenv);
+  } else {
+    g_unsetenv ("NNSTREAMER_CONF");
+  }
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  subplugin_reload_manifest ();
+
+  g_remove (filename);
+  g_rmdir (dir);
+  g_free (filename);
+  g_free (fullpath);
+}
+
 /**
  * @brief Test version control (positive)
  */
@@ -16,6 +16,7 @@
 #include <glib.h>
 #include <mutex>
 #include <memory>
+#include <vector>
 
 /**
  * @brief A helper class for testing the GstMQTT elements
@@ -71,6 +72,36 @@ public:
     this->dc = dc;
   }
 
+  /**
+   * @brief Start (or stop) keeping a copy of the payloads given to MQTTAsync_send()
+   */
+  void setRecordSend (bool flag) {
+    std::lock_guard<std::mutex> lock (this->sent_lock);
+
+    this->record_send = flag;
+    this->sent_payloads.clear ();
+  }
+
+  /**
+   * @brief Keep a copy of the given payload if recording is enabled
+   */
+  void recordSend (const void *payload, int payloadlen) {
+    std::lock_guard<std::mutex> lock (this->sent_lock);
+    const uint8_t *data = (const uint8_t *) payload;
+
+    if (this->record_send)
+      this->sent_payloads.emplace_back (data, data + payloadlen);
+  }
+
+  /**
+   * @brief Getter for the recorded payloads
+   */
+  std::vector<std::vector<uint8_t>> getSentPayloads () {
+    std::lock_guard<std::mutex> lock (this->sent_lock);
+
+    return this->sent_payloads;
+  }
+
   /**
    * @brief Setter for fail_send (if it is true, MQTTAsync_send() will be failed)
    */
@@ -167,7 +198,7 @@ private:
   GstMqttTestHelper ():
       context (nullptr), cl (nullptr), ma (nullptr), dc (nullptr),
       fail_send (false), fail_disconnect (false), fail_subscribe (false),
-      fail_unsubscribe (false), is_connected (false) {};
+      fail_unsubscribe (false), is_connected (false), record_send (false) {};
 
   GstMqttTestHelper (const GstMqttTestHelper &) = delete;
   GstMqttTestHelper &operator=(const GstMqttTestHelper &) = delete;
@@ -182,4 +213,8 @@ private:
   bool fail_subscribe;
   bool fail_unsubscribe;
   bool is_connected;
+
+  std::mutex sent_lock;
+  bool record_send;
+  std::vector<std::vector<uint8_t>> sent_payloads;
 };
@@ -83,6 +83,7 @@ int MQTTAsync_send (MQTTAsync handle, const char *destinationName,
     return MQTTASYNC_FAILURE;
   }
 
+  GstMqttTestHelper::getInstance ().recordSend (payload, payloadlen);
   ret = std::async (std::launch::async, response->onSuccess, ctx,
       &data);
 
@@ -1069,6 +1070,294 @@ free_strs:
     FAIL () << err_msg;
 }
 
+/**
+ * @brief Test the varint helpers of the compact message header
+ */
+TEST (testMqttCommon, compactVarint)
+{
+  const uint64_t uvals[] = { 0, 1, 127, 128, 16383, 16384, G_MAXUINT32,
+    G_MAXUINT64 };
+  const int64_t svals[] = { 0, -1, 1, G_MININT64, G_MAXINT64 };
+  uint8_t buf[GST_MQTT_MAX_LEN_VARINT];
+  const uint8_t *pos;
+  uint64_t val;
+  unsigned int len;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (uvals); i++) {
+    len = mqtt_put_varint (buf, uvals[i]);
+    EXPECT_LE (len, (unsigned int) GST_MQTT_MAX_LEN_VARINT);
+
+    pos = buf;
+    EXPECT_EQ (mqtt_get_varint (&pos, buf + len, &val), 0);
+    EXPECT_EQ (val, uvals[i]);
+    EXPECT_EQ (pos, buf + len);
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (svals); i++)
+    EXPECT_EQ (mqtt_zigzag_decode (mqtt_zigzag_encode (svals[i])), svals[i]);
+
+  /** GST_CLOCK_TIME_NONE is encoded in a single byte */
+  EXPECT_EQ (mqtt_put_varint (buf, GST_CLOCK_TIME_NONE + 1), 1U);
+}
+
+/**
+ * @brief Test the varint helpers with a truncated input (negative case)
+ */
+TEST (testMqttCommon, compactVarint_n)
+{
+  uint8_t buf[GST_MQTT_MAX_LEN_VARINT];
+  const uint8_t *pos = buf;
+  uint64_t val = 0;
+  unsigned int len;
+
+  len = mqtt_put_varint (buf, G_MAXUINT32);
+  EXPECT_NE (mqtt_get_varint (&pos, buf + len - 1, &val), 0);
+  EXPECT_EQ (pos, buf);
+}
+
+/**
+ * @brief Test for mqttsink with GstMqttTestHelper (push GstBuffers with the compact header)
+ */
+TEST (testMqttSinkWithHelper, sinkPushCompact)
+{
+  const gchar *caps_str = "other/tensors,format=static,num_tensors=2,"
+      "types=uint8.uint8,dimensions=16:1:1:1.8:1:1:1,framerate=0/1";
+  const gsize size_mems[] = { 16, 8 };
+  const guint interval = 3;
+  const gint num_buffers = 10;
+  GstHarness *h = gst_harness_new ("mqttsink");
+  std::vector<std::vector<uint8_t>> payloads;
+  GstCaps *caps;
+  GstBuffer *in_buf;
+  GstFlowReturn ret;
+  gboolean compact;
+  guint val_interval;
+  guint i, j, k;
+
+  ASSERT_TRUE (h != NULL);
+
+  g_object_set (h->element, "compact-header", TRUE, "caps-interval", interval,
+      "num-buffers", num_buffers, "sync", FALSE, NULL);
+  g_object_get (h->element, "compact-header", &compact, "caps-interval",
+      &val_interval, NULL);
+  EXPECT_TRUE (compact);
+  EXPECT_EQ (val_interval, interval);
+
+  gst_harness_set_src_caps_str (h, caps_str);
+  GstMqttTestHelper::getInstance ().initFailFlags ();
+  GstMqttTestHelper::getInstance ().setRecordSend (true);
+
+  for (i = 0; i < (guint) num_buffers; ++i) {
+    in_buf = gst_buffer_new ();
+
+    for (j = 0; j < G_N_ELEMENTS (size_mems); ++j) {
+      guint8 *data = (guint8 *) g_malloc (size_mems[j]);
+
+      for (k = 0; k < size_mems[j]; ++k)
+        data[k] = (guint8) (i * 16 + j * 8 + k);
+      gst_buffer_append_memory (in_buf,
+          gst_memory_new_wrapped ((GstMemoryFlags) 0, data, size_mems[j], 0,
+              size_mems[j], data, g_free));
+    }
+    GST_BUFFER_PTS (in_buf) = i * 10 * GST_MSECOND;
+
+    ret = gst_harness_push (h, in_buf);
+    EXPECT_EQ (ret, GST_FLOW_OK);
+  }
+
+  payloads = GstMqttTestHelper::getInstance ().getSentPayloads ();
+  GstMqttTestHelper::getInstance ().setRecordSend (false);
+  ASSERT_EQ (payloads.size (), (gsize) num_buffers);
+
+  caps = gst_caps_from_string (caps_str);
+
+  /** The caps is sent with the first message and after every 'interval' messages without it */
+  for (i = 0; i < payloads.size (); ++i) {
+    const uint8_t *pos = payloads[i].data ();
+    const uint8_t *end = pos + payloads[i].size ();
+    gboolean expect_caps = (i % (interval + 1)) == 0;
+    uint64_t val;
+    guint8 flags;
+
+    ASSERT_GT (payloads[i].size (), (gsize) GST_MQTT_COMPACT_LEN_MAGIC + 2);
+    EXPECT_EQ (memcmp (pos, GST_MQTT_COMPACT_MAGIC,
+        GST_MQTT_COMPACT_LEN_MAGIC), 0);
+    pos += GST_MQTT_COMPACT_LEN_MAGIC;
+    EXPECT_EQ (*pos++, GST_MQTT_COMPACT_VERSION);
+    flags = *pos++;
+    EXPECT_EQ ((flags & GST_MQTT_COMPACT_FLAG_CAPS) != 0, expect_caps);
+
+    /** caps_seq does not change while the caps is the same */
+    ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+    EXPECT_EQ (val, 1U);
+
+    ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+    ASSERT_EQ (val, G_N_ELEMENTS (size_mems));
+    for (j = 0; j < G_N_ELEMENTS (size_mems); ++j) {
+      ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+      EXPECT_EQ (val, size_mems[j]);
+    }
+
+    /** base_time_epoch, sent_time_epoch, duration, dts and pts */
+    ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+    ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+    ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+    EXPECT_EQ (val, 0U);
+    ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+    EXPECT_EQ (val, 0U);
+    ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+    EXPECT_EQ (val, (uint64_t) (i * 10 * GST_MSECOND) + 1);
+
+    if (flags & GST_MQTT_COMPACT_FLAG_CAPS) {
+      GstCaps *sent_caps;
+      gchar *sent_caps_str;
+
+      ASSERT_EQ (mqtt_get_varint (&pos, end, &val), 0);
+      ASSERT_LE (val, (uint64_t) (end - pos));
+      sent_caps_str = g_strndup ((const gchar *) pos, val);
+      pos += val;
+
+      sent_caps = gst_caps_from_string (sent_caps_str);
+      ASSERT_TRUE (sent_caps != NULL);
+      EXPECT_TRUE (gst_caps_is_equal (sent_caps, caps));
+      gst_caps_unref (sent_caps);
+      g_free (sent_caps_str);
+    }
+
+    /** The tensors follow the header without any padding */
+    ASSERT_EQ ((gsize) (end - pos), size_mems[0] + size_mems[1]);
+    for (j = 0; j < G_N_ELEMENTS (size_mems); ++j) {
+      for (k = 0; k < size_mems[j]; ++k)
+        EXPECT_EQ (*pos++, (guint8) (i * 16 + j * 8 + k));
+    }
+  }
+
+  gst_caps_unref (caps);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief A helper function for the generation of a dummy MQTT message with the compact header
+ */
+static gsize _gen_dummy_compact_mqtt_msg (guint8 *payload,
+    GstMQTTMessageHdr *hdr, const guint64 caps_seq, const gchar *caps_str,
+    const gsize len_buf)
+{
+  gsize len = 0;
+  guint i;
+
+  memcpy (payload, GST_MQTT_COMPACT_MAGIC, GST_MQTT_COMPACT_LEN_MAGIC);
+  len += GST_MQTT_COMPACT_LEN_MAGIC;
+  payload[len++] = GST_MQTT_COMPACT_VERSION;
+  payload[len++] = caps_str ? GST_MQTT_COMPACT_FLAG_CAPS : 0;
+  len += mqtt_put_varint (&payload[len], caps_seq);
+  len += mqtt_put_varint (&payload[len], hdr->num_mems);
+  for (i = 0; i < hdr->num_mems; i++)
+    len += mqtt_put_varint (&payload[len], hdr->size_mems[i]);
+  len += mqtt_put_varint (&payload[len], mqtt_zigzag_encode (hdr->base_time_epoch));
+  len += mqtt_put_varint (&payload[len], mqtt_zigzag_encode (hdr->sent_time_epoch));
+  len += mqtt_put_varint (&payload[len], hdr->duration + 1);
+  len += mqtt_put_varint (&payload[len], hdr->dts + 1);
+  len += mqtt_put_varint (&payload[len], hdr->pts + 1);
+  if (caps_str) {
+    len += mqtt_put_varint (&payload[len], strlen (caps_str));
+    memcpy (&payload[len], caps_str, strlen (caps_str));
+    len += strlen (caps_str);
+  }
+  memset (&payload[len], 0, len_buf);
+
+  return len + len_buf;
+}
+
+/**
+ * @brief Test mqttsrc with the compact message header
+ */
+TEST (testMqttSrcWithHelper, srcNormalLaunchCompact)
+{
+  const gsize len_buf = 1024;
+  gchar *caps_str = g_strdup ("video/x-raw,width=32,height=16,format=RGB");
+  gchar *topic_name = g_strdup ("test_topic");
+  gchar *str_pipeline = g_strdup_printf (
+      "mqttsrc sub-topic=%s debug=true is-live=true num-buffers=%d "
+      "sub-timeout=%" G_GINT64_FORMAT " ! "
+      "capsfilter caps=%s ! videoconvert ! videoscale ! fakesink",
+      topic_name, 1, G_TIME_SPAN_MINUTE, caps_str);
+  GError *err = NULL;
+  GstElement *pipeline;
+  GstStateChangeReturn ret;
+  GstState cur_state;
+  GstMQTTMessageHdr hdr;
+  MQTTAsync_message *msg;
+  std::future<int> ma_ret;
+  std::string err_msg;
+  bool err_flag = false;
+
+  pipeline = gst_parse_launch (str_pipeline, &err);
+  g_free (str_pipeline);
+  if ((!pipeline) || (err)) {
+    err_flag = true;
+    err_msg = std::string ("Failed to launch the given pipeline");
+    goto free_strs;
+  }
+  GstMqttTestHelper::getInstance ().initFailFlags ();
+
+  msg = (MQTTAsync_message *) g_try_malloc0 (sizeof(*msg));
+  if (!msg) {
+    err_flag = true;
+    err_msg = std::string ("Failed to allocate a MQTTAsync_message");
+    goto free_strs;
+  }
+
+  _set_ts_gst_mqtt_message_hdr (pipeline, &hdr, GST_SECOND, 500 * GST_MSECOND);
+  ret = gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  EXPECT_NE (ret, GST_STATE_CHANGE_FAILURE);
+
+  hdr.num_mems = 1;
+  hdr.size_mems[0] = len_buf;
+
+  msg->payload = g_try_malloc0 (GST_MQTT_MAX_LEN_COMPACT_HDR +
+      strlen (caps_str) + len_buf);
+  if (!msg->payload) {
+    err_flag = true;
+    err_msg = std::string (
+        "Failed to allocate buffer for MQTT message payload");
+    goto free_msg_buf;
+  }
+  msg->payloadlen = _gen_dummy_compact_mqtt_msg ((guint8 *) msg->payload,
+      &hdr, 1, caps_str, len_buf);
+  EXPECT_LT ((gsize) msg->payloadlen, GST_MQTT_LEN_MSG_HDR + len_buf);
+
+  ret = gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  EXPECT_NE (ret, GST_STATE_CHANGE_FAILURE);
+
+  ma_ret = std::async (std::launch::async,
+      GstMqttTestHelper::getInstance ().getCbMessageArrived (),
+      GstMqttTestHelper::getInstance ().getContext (), topic_name, 0, msg);
+  EXPECT_TRUE (ma_ret.get ());
+
+  ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
+  EXPECT_EQ (ret, GST_STATE_CHANGE_SUCCESS);
+  EXPECT_EQ (cur_state, GST_STATE_PLAYING);
+
+  ret = gst_element_set_state (pipeline, GST_STATE_NULL);
+  EXPECT_NE (ret, GST_STATE_CHANGE_FAILURE);
+
+  ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
+  EXPECT_EQ (ret, GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (pipeline);
+
+  g_free (msg->payload);
+free_msg_buf:
+  g_free (msg);
+free_strs:
+  g_free (caps_str);
+  g_free (topic_name);
+
+  if (err_flag)
+    FAIL () << err_msg;
+}
+
 /**
  * @brief Main GTest
  */
@@ -0,0 +1,418 @@
+/**
+ * @file	benchmark_pipelines.c
+ * @date	18 Oct 2026
+ * @brief	Throughput and latency benchmark of the pipelines with nnstreamer elements
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs.
+ *
+ * Each case is a pipeline fed by tensor_src_synthetic. The buffers are counted
+ * at the sink pad of the last element (fakesink named "sink"), and the latency
+ * of each buffer is the difference between the arrival time and the send time
+ * stamped by tensor_src_synthetic. The elements which create new buffers
+ * without copying the meta (e.g., tensor_aggregator) report throughput only.
+ *
+ * Usage: benchmark_pipelines [-n BUFFERS] [-c CASE] [-r REPEAT]
+ */
+
+#include <string.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <nnstreamer_plugin_api.h>
+#include <tensor_filter_custom_easy.h>
+#include <tensor_source/tensor_src_synthetic.h>
+
+/**
+ * @brief Default number of buffers in each case.
+ */
+#define DEFAULT_NUM_BUFFERS (5000U)
+
+/**
+ * @brief Timeout (in seconds) of each case.
+ */
+#define BENCHMARK_TIMEOUT (120U)
+
+/**
+ * @brief Model name of the custom-easy filter.
+ */
+#define CUSTOM_EASY_MODEL "benchmark_passthrough"
+
+/**
+ * @brief Benchmark case.
+ */
+typedef struct
+{
+  const gchar *name; /**< case name */
+  const gchar *pipeline; /**< pipeline description (the part before the path of test data if needs_data) */
+  gboolean needs_data; /**< the path of test data is appended to pipeline */
+  const gchar *pipeline_after_data; /**< pipeline description after the path of test data */
+} benchmark_case_s;
+
+/**
+ * @brief Benchmark cases.
+ */
+static const benchmark_case_s benchmark_cases[] = {
+  {"src_only",
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! "
+      "fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"transform_typecast",
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! "
+      "tensor_transform mode=typecast option=float32 acceleration=true ! "
+      "fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"transform_arithmetic",
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! "
+      "tensor_transform mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 acceleration=true ! "
+      "fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"transform_transpose",
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! "
+      "tensor_transform mode=transpose option=1:2:0:3 ! "
+      "fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"transform_float16",
+      "tensor_src_synthetic dimension=3:224:224:1 type=float32 ! "
+      "tensor_transform mode=typecast option=float16 ! "
+      "fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"converter_flexible",
+      "tensor_src_synthetic format=flexible dimension=3:224:224:1 type=uint8 ! "
+      "tensor_converter ! fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"converter_video",
+      "videotestsrc pattern=solid-color ! video/x-raw,format=RGB,width=224,height=224 ! "
+      "tensor_converter ! fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"merge",
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! m.sink_0 "
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! m.sink_1 "
+      "tensor_merge name=m mode=linear option=3 sync-mode=nosync ! "
+      "fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"split",
+      "tensor_src_synthetic dimension=6:224:224:1 type=uint8 ! "
+      "tensor_split name=s tensorseg=3:224:224,3:224:224 "
+      "s.src_0 ! fakesink name=sink sync=false s.src_1 ! fakesink sync=false",
+      FALSE, NULL},
+  {"aggregator",
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! "
+      "tensor_aggregator frames-in=1 frames-out=4 frames-flush=4 frames-dim=3 ! "
+      "fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"sparse_enc_dec",
+      "tensor_src_synthetic dimension=3:224:224:1 type=float32 sparsity=90 ! "
+      "tensor_sparse_enc ! tensor_sparse_dec ! fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"decoder_direct_video",
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! "
+      "tensor_decoder mode=direct_video ! fakesink name=sink sync=false",
+      FALSE, NULL},
+  {"decoder_image_labeling",
+      "tensor_src_synthetic dimension=1001:1:1:1 type=uint8 pattern=random ! "
+      "tensor_decoder mode=image_labeling option1=",
+      TRUE, " ! fakesink name=sink sync=false"},
+  {"filter_custom_easy",
+      "tensor_src_synthetic dimension=3:224:224:1 type=uint8 ! "
+      "tensor_filter framework=custom-easy model=" CUSTOM_EASY_MODEL " ! "
+      "fakesink name=sink sync=false",
+      FALSE, NULL},
+};
+
+/**
+ * @brief Measured data of a case.
+ */
+typedef struct
+{
+  GstCaps *send_time_caps; /**< caps of the send time meta */
+  guint64 received; /**< the number of buffers received at the sink */
+  GstClockTime first; /**< arrival time of the first buffer */
+  GstClockTime last; /**< arrival time of the last buffer */
+  GArray *latency; /**< latency samples (GstClockTime) */
+} benchmark_data_s;
+
+/**
+ * @brief Pass-through function of the custom-easy filter.
+ */
+static int
+benchmark_passthrough (void *data, const GstTensorFilterProperties * prop,
+    const GstTensorMemory * in, GstTensorMemory * out)
+{
+  (void) data;
+  (void) prop;
+
+  memcpy (out[0].data, in[0].data, MIN (in[0].size, out[0].size));
+  return 0;
+}
+
+/**
+ * @brief Register the custom-easy model for the case 'filter_custom_easy'.
+ */
+static gboolean
+benchmark_register_custom_easy (void)
+{
+  GstTensorsInfo info;
+  int ret;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", info.info[0].dimension);
+
+  ret = NNS_custom_easy_register (CUSTOM_EASY_MODEL, benchmark_passthrough,
+      NULL, &info, &info);
+  gst_tensors_info_free (&info);
+
+  return (ret == 0);
+}
+
+/**
+ * @brief Pad probe to measure the throughput and latency.
+ */
+static GstPadProbeReturn
+benchmark_probe_cb (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  benchmark_data_s *bdata = (benchmark_data_s *) user_data;
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstClockTime now = gst_util_get_timestamp ();
+
+  (void) pad;
+
+  if (bdata->received == 0)
+    bdata->first = now;
+  bdata->last = now;
+  bdata->received++;
+
+#if GST_CHECK_VERSION(1, 14, 0)
+  {
+    GstReferenceTimestampMeta *meta;
+
+    meta = gst_buffer_get_reference_timestamp_meta (buffer,
+        bdata->send_time_caps);
+    if (meta && now >= meta->timestamp) {
+      GstClockTime latency = now - meta->timestamp;
+      g_array_append_val (bdata->latency, latency);
+    }
+  }
+#else
+  (void) buffer;
+#endif
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Set the number of buffers to all source elements in the pipeline.
+ */
+static void
+benchmark_set_num_buffers (GstElement * pipeline, guint num_buffers)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+
+  it = gst_bin_iterate_sources (GST_BIN (pipeline));
+  while (gst_iterator_next (it, &item) == GST_ITERATOR_OK) {
+    GObject *src = g_value_get_object (&item);
+
+    g_object_set (src, "num-buffers", (gint) num_buffers, NULL);
+    g_value_reset (&item);
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+}
+
+/**
+ * @brief Compare function to sort latency samples.
+ */
+static gint
+benchmark_compare_latency (gconstpointer a, gconstpointer b)
+{
+  GstClockTime la = *((const GstClockTime *) a);
+  GstClockTime lb = *((const GstClockTime *) b);
+
+  return (la > lb) - (la < lb);
+}
+
+/**
+ * @brief Get the percentile from the sorted latency samples.
+ */
+static gdouble
+benchmark_percentile (GArray * sorted, gdouble p)
+{
+  guint idx;
+
+  if (sorted->len == 0)
+    return 0.0;
+
+  idx = (guint) (p / 100.0 * (sorted->len - 1) + 0.5);
+  return (gdouble) g_array_index (sorted, GstClockTime, idx) / GST_USECOND;
+}
+
+/**
+ * @brief Run a case and print the result.
+ * @return TRUE if the pipeline reached EOS.
+ */
+static gboolean
+benchmark_run_case (const benchmark_case_s * bcase, const gchar * data_path,
+    guint num_buffers)
+{
+  benchmark_data_s bdata;
+  GstElement *pipeline, *sink;
+  GstPad *pad;
+  GstBus *bus;
+  GstMessage *msg;
+  GError *err = NULL;
+  gchar *str;
+  gboolean eos = FALSE;
+
+  if (bcase->needs_data)
+    str = g_strconcat (bcase->pipeline, data_path, bcase->pipeline_after_data,
+        NULL);
+  else
+    str = g_strdup (bcase->pipeline);
+
+  pipeline = gst_parse_launch (str, &err);
+  g_free (str);
+
+  if (!pipeline || err) {
+    g_printerr ("%-24s failed to create pipeline: %s\n", bcase->name,
+        err ? err->message : "unknown error");
+    g_clear_error (&err);
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return FALSE;
+  }
+
+  memset (&bdata, 0, sizeof (bdata));
+  bdata.send_time_caps =
+      gst_caps_from_string (GST_TENSOR_SRC_SYNTHETIC_SEND_TIME_CAPS);
+  bdata.latency = g_array_sized_new (FALSE, FALSE, sizeof (GstClockTime),
+      num_buffers);
+
+  benchmark_set_num_buffers (pipeline, num_buffers);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  pad = gst_element_get_static_pad (sink, "sink");
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER, benchmark_probe_cb,
+      &bdata, NULL);
+  gst_object_unref (pad);
+  gst_object_unref (sink);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, BENCHMARK_TIMEOUT * GST_SECOND,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  if (msg) {
+    if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS) {
+      eos = TRUE;
+    } else {
+      gst_message_parse_error (msg, &err, NULL);
+      g_printerr ("%-24s error: %s\n", bcase->name, err->message);
+      g_clear_error (&err);
+    }
+    gst_message_unref (msg);
+  } else {
+    g_printerr ("%-24s timeout\n", bcase->name);
+  }
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  if (eos && bdata.received > 1) {
+    gdouble elapsed = (gdouble) (bdata.last - bdata.first);
+    gdouble ns_per_buf = elapsed / (bdata.received - 1);
+
+    g_array_sort (bdata.latency, benchmark_compare_latency);
+
+    g_print ("%-24s %10" G_GUINT64_FORMAT " %12.1f %12.1f", bcase->name,
+        bdata.received, GST_SECOND / ns_per_buf, ns_per_buf);
+    if (bdata.latency->len > 0) {
+      g_print (" %10.1f %10.1f %10.1f %10.1f\n",
+          benchmark_percentile (bdata.latency, 50.0),
+          benchmark_percentile (bdata.latency, 90.0),
+          benchmark_percentile (bdata.latency, 99.0),
+          benchmark_percentile (bdata.latency, 100.0));
+    } else {
+      g_print (" %10s %10s %10s %10s\n", "-", "-", "-", "-");
+    }
+  } else if (eos) {
+    g_printerr ("%-24s received %" G_GUINT64_FORMAT " buffers\n", bcase->name,
+        bdata.received);
+    eos = FALSE;
+  }
+
+  g_array_free (bdata.latency, TRUE);
+  gst_caps_unref (bdata.send_time_caps);
+  return eos;
+}
+
+/**
+ * @brief Main function of the benchmark.
+ */
+int
+main (int argc, char **argv)
+{
+  guint num_buffers = DEFAULT_NUM_BUFFERS;
+  guint repeat = 1;
+  gchar **case_names = NULL;
+  gchar *data_path;
+  const gchar *root_path;
+  GOptionContext *ctx;
+  GError *err = NULL;
+  guint i, r;
+  gint failed = 0;
+  GOptionEntry entries[] = {
+    {"buffers", 'n', 0, G_OPTION_ARG_INT, &num_buffers,
+        "The number of buffers in each case", "N"},
+    {"case", 'c', 0, G_OPTION_ARG_STRING_ARRAY, &case_names,
+        "Run the case only (can be given multiple times)", "NAME"},
+    {"repeat", 'r', 0, G_OPTION_ARG_INT, &repeat,
+        "The number of runs of each case", "N"},
+    {NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL}
+  };
+
+  ctx = g_option_context_new ("- nnstreamer pipeline benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_printerr ("Failed to parse options: %s\n", err->message);
+    g_clear_error (&err);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  gst_init (&argc, &argv);
+
+  if (!benchmark_register_custom_easy ())
+    g_printerr ("Failed to register custom-easy model %s\n", CUSTOM_EASY_MODEL);
+
+  /* test data for the decoders */
+  root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  data_path = g_build_filename (root_path ? root_path : ".", "tests",
+      "test_models", "labels", "labels.txt", NULL);
+
+  g_print ("%-24s %10s %12s %12s %10s %10s %10s %10s\n", "case", "buffers",
+      "buffers/s", "ns/buffer", "p50(us)", "p90(us)", "p99(us)", "max(us)");
+
+  for (i = 0; i < G_N_ELEMENTS (benchmark_cases); i++) {
+    const benchmark_case_s *bcase = &benchmark_cases[i];
+
+    if (case_names && !g_strv_contains ((const gchar * const *) case_names,
+            bcase->name))
+      continue;
+
+    for (r = 0; r < MAX (repeat, 1U); r++) {
+      if (!benchmark_run_case (bcase, data_path, num_buffers))
+        failed++;
+    }
+  }
+
+  g_free (data_path);
+  g_strfreev (case_names);
+
+  return (failed > 0) ? 1 : 0;
+}
@@ -11,6 +11,8 @@
 #include <flatbuffers/flexbuffers.h>
 #include <glib.h>
 #include <gst/gst.h>
+#include <gst/check/gstharness.h>
+#include <gst/video/video.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_subplugin.h>
 #include <tensor_common.h>
@@ -346,6 +348,144 @@ TEST (tensorDecoder, subpluginNullDesc_n)
   free_default_decoder (sub);
 }
 
+/**
+ * @brief Push a RGB tensor (3:width:height:1) to direct_video and pull the output.
+ */
+static GstBuffer *
+_direct_video_run (guint width, guint height, gboolean video_meta,
+    GstBuffer **inbuf)
+{
+  GstHarness *h;
+  GstTensorsConfig config;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo info;
+  gchar *dim;
+  gsize i, size;
+
+  h = gst_harness_new ("tensor_decoder");
+  g_object_set (h->element, "mode", "direct_video", "option1", "RGB", NULL);
+  if (video_meta)
+    gst_harness_add_propose_allocation_meta (h, GST_VIDEO_META_API_TYPE, NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  dim = g_strdup_printf ("3:%u:%u:1", width, height);
+  gst_tensor_parse_dimension (dim, config.info.info[0].dimension);
+  g_free (dim);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  size = gst_tensors_info_get_size (&config.info, 0);
+  in_buf = gst_harness_create_buffer (h, size);
+  if (gst_buffer_map (in_buf, &info, GST_MAP_WRITE)) {
+    for (i = 0; i < size; i++)
+      info.data[i] = (uint8_t) i;
+    gst_buffer_unmap (in_buf, &info);
+  }
+
+  *inbuf = gst_buffer_ref (in_buf);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+
+  gst_harness_teardown (h);
+  return out_buf;
+}
+
+/**
+ * @brief Check whether the output buffer shares the memory of the input buffer.
+ */
+static gboolean
+_direct_video_is_shared (GstBuffer *in_buf, GstBuffer *out_buf)
+{
+  GstMapInfo in_info, out_info;
+  gboolean shared = FALSE;
+
+  if (!gst_buffer_map (in_buf, &in_info, GST_MAP_READ))
+    return FALSE;
+
+  if (gst_buffer_map (out_buf, &out_info, GST_MAP_READ)) {
+    shared = (in_info.data == out_info.data);
+    gst_buffer_unmap (out_buf, &out_info);
+  }
+
+  gst_buffer_unmap (in_buf, &in_info);
+
+  return shared;
+}
+
+/**
+ * @brief Test for direct_video, 4-byte aligned rows are not copied.
+ */
+TEST (tensorDecoderDirectVideo, zeroCopyAligned)
+{
+  GstBuffer *in_buf = NULL, *out_buf;
+
+  out_buf = _direct_video_run (4, 2, FALSE, &in_buf);
+  ASSERT_TRUE (out_buf != NULL);
+
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 24U);
+  EXPECT_TRUE (_direct_video_is_shared (in_buf, out_buf));
+
+  gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+}
+
+/**
+ * @brief Test for direct_video, unaligned rows are described with GstVideoMeta strides.
+ */
+TEST (tensorDecoderDirectVideo, zeroCopyVideoMeta)
+{
+  GstBuffer *in_buf = NULL, *out_buf;
+  GstVideoMeta *meta;
+
+  out_buf = _direct_video_run (3, 2, TRUE, &in_buf);
+  ASSERT_TRUE (out_buf != NULL);
+
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 18U);
+  EXPECT_TRUE (_direct_video_is_shared (in_buf, out_buf));
+
+  meta = gst_buffer_get_video_meta (out_buf);
+  ASSERT_TRUE (meta != NULL);
+  EXPECT_EQ (meta->format, GST_VIDEO_FORMAT_RGB);
+  EXPECT_EQ (meta->width, 3U);
+  EXPECT_EQ (meta->height, 2U);
+  EXPECT_EQ (meta->stride[0], 9);
+  EXPECT_EQ (meta->offset[0], 0U);
+
+  gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+}
+
+/**
+ * @brief Test for direct_video, unaligned rows are padded if downstream does not support GstVideoMeta.
+ */
+TEST (tensorDecoderDirectVideo, paddingWithoutVideoMeta)
+{
+  GstBuffer *in_buf = NULL, *out_buf;
+  GstMapInfo info;
+  guint h, w;
+
+  out_buf = _direct_video_run (3, 2, FALSE, &in_buf);
+  ASSERT_TRUE (out_buf != NULL);
+
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 24U);
+  EXPECT_TRUE (gst_buffer_get_video_meta (out_buf) == NULL);
+  EXPECT_FALSE (_direct_video_is_shared (in_buf, out_buf));
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  for (h = 0; h < 2; h++) {
+    for (w = 0; w < 9; w++)
+      EXPECT_EQ (info.data[h * 12 + w], h * 9 + w);
+  }
+  gst_buffer_unmap (out_buf, &info);
+
+  gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+}
+
 /**
  * @brief Main GTest
  */
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2026 Samsung Electronics
+#
+# @file generateTest.py
+# @brief Generate the heatmap and the golden keypoints for the pose estimation decoder
+# @author Samsung Electronics
+
+import struct
+
+LABELS = 14
+GRID = 5
+SCALE = 2  # option1 (10:10) / option2 (5:5)
+
+
+def cell_index(x, y, k):
+    return (y * GRID + x) * LABELS + k
+
+
+heatmap = [0.0] * (GRID * GRID * LABELS)
+first = []
+second = []
+
+for k in range(LABELS):
+    x = k % GRID
+    y = k // GRID
+    heatmap[cell_index(x, y, k)] = 1.0
+    refine = 0.0
+    if 0 < x < GRID - 1:
+        # quadratic fit of (0.25, 1.0, 0.75) gives the peak at x + 0.25
+        heatmap[cell_index(x - 1, y, k)] = 0.25
+        heatmap[cell_index(x + 1, y, k)] = 0.75
+        refine = 0.25
+    first.append(((x + refine) * SCALE, y * SCALE, 1.0))
+
+    # second person, at the last row
+    if k % 2 == 0:
+        heatmap[cell_index(x, GRID - 1, k)] = 0.6
+        second.append((x * SCALE, (GRID - 1) * SCALE, 0.6))
+    else:
+        second.append((0.0, 0.0, 0.0))
+
+with open('pose_heatmap.raw', 'wb') as f:
+    f.write(struct.pack('%df' % len(heatmap), *heatmap))
+
+with open('pose_keypoints.golden', 'wb') as f:
+    for kp in first:
+        f.write(struct.pack('3f', *kp))
+
+with open('pose_keypoints_peaks.golden', 'wb') as f:
+    for kp in first + second:
+        f.write(struct.pack('3f', *kp))
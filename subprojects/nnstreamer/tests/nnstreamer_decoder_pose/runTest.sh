@@ -33,4 +33,15 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=4 ! videoc
 # TEST WITH MORE BUFFERS
 gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=20 ! videoconvert ! videoscale ! video/x-raw,width=14,height=14,format=RGB ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:128,div:255 ! tensor_split name=a tensorseg=1:14:14:1,2:14:14:1 a.src_0 ! tensor_transform mode=transpose option=1:2:0:3 ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 ! fakesink" 2 0 0 $PERFORMANCE
 
+# Keypoints tensor output
+python3 generateTest.py
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=pose_heatmap.raw blocksize=-1 ! application/octet-stream ! tensor_converter input-dim=14:5:5:1 input-type=float32 ! tensor_decoder mode=pose_estimation option1=10:10 option2=5:5 option5=tensor ! filesink location=pose_keypoints.log sync=true" 3 0 0 $PERFORMANCE
+callCompareTest pose_keypoints.golden pose_keypoints.log 3-1 "Compare keypoints" 0 0
+
+# Keypoints tensor output with the peaks of multiple persons
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=pose_heatmap.raw blocksize=-1 ! application/octet-stream ! tensor_converter input-dim=14:5:5:1 input-type=float32 ! tensor_decoder mode=pose_estimation option1=10:10 option2=5:5 option5=tensor option6=2:0.5 ! filesink location=pose_keypoints_peaks.log sync=true" 4 0 0 $PERFORMANCE
+callCompareTest pose_keypoints_peaks.golden pose_keypoints_peaks.log 4-1 "Compare keypoints of the peaks" 0 0
+
+rm pose_heatmap.raw pose_keypoints*.golden pose_keypoints*.log
+
 report
@@ -902,7 +902,7 @@ TEST (nnstreamerFilterLua, dataType00_n)
 {
   /**
    * Invalid data type `uint128`. Type should be one of
-   * { float32, float64, int64, uint64, int32, uint32, int16, uint16, int8, uint8 }
+   * { float16, bfloat16, float32, float64, int64, uint64, int32, uint32, int16, uint16, int8, uint8 }
    */
   const char *invalid_data_type = "uint128";
   int ret;
@@ -127,6 +127,104 @@ TEST_F (NNSFilterSingleTest, invoke_p)
   klass->destroy_notify (single, &output);
 }
 
+/**
+ * @brief Test to invoke tf-lite model without copying the output.
+ */
+TEST_F (NNSFilterSingleTest, invokeZeroCopy_p)
+{
+  GstTensorMemory out;
+  GDestroyNotify release = nullptr;
+  gpointer release_data = nullptr;
+  gpointer prev_data = nullptr;
+  guint i;
+
+  ASSERT_TRUE (this->loaded);
+
+  out.data = nullptr;
+  out.size = 0;
+
+  /* the output is handed over until released, and recycled for the next call */
+  for (i = 0; i < 3U; i++) {
+    EXPECT_TRUE (klass->invoke_zero_copy (single, &input, &out, &release, &release_data));
+    ASSERT_TRUE (release != nullptr && release_data != nullptr);
+    EXPECT_TRUE (out.data != nullptr);
+    EXPECT_EQ (1001U, out.size);
+    EXPECT_EQ (951U, get_max_score (&out));
+
+    if (prev_data && !klass->allocate_in_invoke (single))
+      EXPECT_EQ (prev_data, out.data);
+
+    prev_data = out.data;
+    release (release_data);
+  }
+}
+
+/**
+ * @brief Test to invoke tf-lite model with several input sets.
+ */
+TEST_F (NNSFilterSingleTest, invokeBatch_p)
+{
+  const guint num_sets = 4U;
+  GstTensorMemory in[4], out[4];
+  GDestroyNotify release = nullptr;
+  gpointer release_data = nullptr;
+  guint i;
+
+  ASSERT_TRUE (this->loaded);
+
+  for (i = 0; i < num_sets; i++) {
+    in[i] = input;
+    out[i].data = nullptr;
+    out[i].size = 0;
+  }
+
+  /* output handed over by the filter */
+  EXPECT_TRUE (klass->invoke_batch (single, num_sets, in, out, &release, &release_data));
+  ASSERT_TRUE (release != nullptr && release_data != nullptr);
+
+  for (i = 0; i < num_sets; i++) {
+    EXPECT_TRUE (out[i].data != nullptr);
+    EXPECT_EQ (1001U, out[i].size);
+    EXPECT_EQ (951U, get_max_score (&out[i]));
+  }
+
+  release (release_data);
+
+  /* output allocated by the caller */
+  for (i = 0; i < num_sets; i++) {
+    out[i].size = 1001U;
+    out[i].data = g_malloc0 (out[i].size);
+  }
+
+  EXPECT_TRUE (klass->invoke_batch (single, num_sets, in, out, nullptr, nullptr));
+
+  for (i = 0; i < num_sets; i++) {
+    EXPECT_EQ (951U, get_max_score (&out[i]));
+    g_free (out[i].data);
+  }
+}
+
+/**
+ * @brief Test to invoke tf-lite model with invalid param (zero-copy and batch).
+ */
+TEST_F (NNSFilterSingleTest, invokeBatchInvalidParam_n)
+{
+  GDestroyNotify release = nullptr;
+  gpointer release_data = nullptr;
+
+  ASSERT_TRUE (this->loaded);
+  EXPECT_TRUE (klass->start (single));
+
+  EXPECT_FALSE (klass->invoke_batch (single, 0U, &input, &output, &release, &release_data));
+  EXPECT_FALSE (klass->invoke_batch (single, 1U, NULL, &output, &release, &release_data));
+  EXPECT_FALSE (klass->invoke_batch (single, 1U, &input, NULL, &release, &release_data));
+  EXPECT_FALSE (klass->invoke_batch (single, 1U, &input, &output, &release, NULL));
+  EXPECT_FALSE (klass->invoke_zero_copy (single, &input, &output, NULL, &release_data));
+  EXPECT_TRUE (release == nullptr && release_data == nullptr);
+
+  EXPECT_TRUE (klass->stop (single));
+}
+
 /**
  * @brief Test to invoke tf-lite model with invalid param.
  */
@@ -248,6 +346,37 @@ TEST (testTensorFilterSingle, invokeUnknownFW_n)
   g_free (out.data);
 }
 
+/**
+ * @brief Test to invoke several sets with unknown framework.
+ */
+TEST (testTensorFilterSingle, invokeBatchUnknownFW_n)
+{
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  GstTensorMemory in, out;
+  GDestroyNotify release = nullptr;
+  gpointer release_data = nullptr;
+
+  in.size = out.size = 200U;
+  in.data = g_malloc0 (in.size);
+  out.data = nullptr;
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE, NULL);
+  klass = (GTensorFilterSingleClass *) g_type_class_ref (G_TYPE_TENSOR_FILTER_SINGLE);
+
+  /* set invalid fw and invoke */
+  g_object_set (G_OBJECT (single), "framework", "unknown-fw", NULL);
+
+  EXPECT_FALSE (klass->invoke_zero_copy (single, &in, &out, &release, &release_data));
+  EXPECT_FALSE (klass->invoke_batch (single, 1U, &in, &out, &release, &release_data));
+  EXPECT_TRUE (release == nullptr && release_data == nullptr);
+  EXPECT_TRUE (out.data == nullptr);
+
+  g_type_class_unref (klass);
+  g_object_unref (single);
+  g_free (in.data);
+}
+
 /**
  * @brief Main GTest.
  */
@@ -149,6 +149,24 @@ for BLOCKING in "${BLOCKING_LIST[@]}"; do
 done
 done
 
+## Test gRPC non-blocking client with multiple concurrent streams and back-pressure.
+## The frames of videotestsrc are identical, so the results are compared regardless of their order.
+for IDL in "${IDL_LIST[@]}"; do
+  PORT=`python3 get_available_port.py`
+  # tensor_sink (client, 4 streams) --> tensor_src (server), other/tensor
+  gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_src_grpc port=${PORT} num-buffers=${NUM_BUFFERS} idl=${IDL} blocking=false ! 'other/tensor,dimension=(string)3:640:480,type=(string)uint8,framerate=(fraction)5/1' ! multifilesink location=result_%1d.log" ${INDEX}-1 0 0 $PERFORMANCE &
+  sleep 1
+  gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=${NUM_BUFFERS} ! video/x-raw,width=640,height=480,framerate=5/1 ! tensor_converter ! tensor_sink_grpc port=${PORT} idl=${IDL} blocking=false streams=4 max-buffers=2" ${INDEX}-2 0 0 $PERFORMANCE
+
+  for i in `seq 0 $((NUM_BUFFERS-1))`
+  do
+    callCompareTest original1_${i}.log result_${i}.log GoldenTest-${INDEX} "gRPC ${IDL}/Multi-streams $((i+1))/${NUM_BUFFERS}" 0 0
+  done
+
+  INDEX=$((INDEX + 1))
+  rm result_*.log
+done
+
 rm original*.log
 
 report
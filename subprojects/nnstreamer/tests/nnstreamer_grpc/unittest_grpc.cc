@@ -422,6 +422,100 @@ TEST (nnstreamerGrpc, sinkInvalidPort_n)
   gst_object_unref (test_data.pipeline);
 }
 
+/**
+ * @brief Test gRPC tensor_sink streams and max-buffers properties
+ */
+TEST (nnstreamerGrpc, sinkStreamsProperty)
+{
+  TestOption option;
+  GstElement *sink;
+  guint streams, max_buffers;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SINK;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  sink = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+
+  g_object_get (sink, "streams", &streams, "max-buffers", &max_buffers, NULL);
+  EXPECT_EQ (streams, 1U);
+  EXPECT_EQ (max_buffers, 0U);
+
+  g_object_set (sink, "streams", 4, "max-buffers", 8, NULL);
+  g_object_get (sink, "streams", &streams, "max-buffers", &max_buffers, NULL);
+  EXPECT_EQ (streams, 4U);
+  EXPECT_EQ (max_buffers, 8U);
+
+  gst_object_unref (sink);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Test gRPC tensor_src invalid streams
+ */
+TEST (nnstreamerGrpc, srcInvalidStreams_n)
+{
+  TestOption option;
+  GstElement *src;
+  guint streams;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SRC;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  src = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "src");
+  ASSERT_TRUE (src != NULL);
+
+  g_object_set (src, "streams", 0, NULL);
+  g_object_get (src, "streams", &streams, NULL);
+  EXPECT_EQ (streams, 1U);
+
+  g_object_set (src, "streams", 1000, NULL);
+  g_object_get (src, "streams", &streams, NULL);
+  EXPECT_EQ (streams, 1U);
+
+  gst_object_unref (src);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Test gRPC non-blocking client stops even if the queued buffers are never sent (no server)
+ */
+TEST (nnstreamerGrpc, sinkStopWithoutPeer_n)
+{
+  TestOption option;
+  GstElement *sink;
+  GstStateChangeReturn ret;
+  gint64 start_time;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SINK;
+  option.server = FALSE;
+  option.port = DEFAULT_PORT + 1;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  sink = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+  g_object_set (sink, "blocking", FALSE, "streams", 2, "max-buffers", 2, NULL);
+
+  ret = gst_element_set_state (test_data.pipeline, GST_STATE_PLAYING);
+  EXPECT_NE (ret, GST_STATE_CHANGE_FAILURE);
+  g_usleep (G_USEC_PER_SEC / 2);
+
+  /* the queue is full and never drained, stop () should not wait forever */
+  start_time = g_get_monotonic_time ();
+  ret = gst_element_set_state (test_data.pipeline, GST_STATE_NULL);
+  EXPECT_NE (ret, GST_STATE_CHANGE_FAILURE);
+  EXPECT_LT (g_get_monotonic_time () - start_time, 10 * G_USEC_PER_SEC);
+
+  gst_object_unref (sink);
+  gst_object_unref (test_data.pipeline);
+}
+
 /**
  * @brief gtest main
  */
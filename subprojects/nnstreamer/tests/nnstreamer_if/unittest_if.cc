@@ -862,6 +862,186 @@ TEST (tensorIfCustom, invalidParam3_n)
   EXPECT_NE (0, nnstreamer_if_custom_unregister ("tifx"));
 }
 
+/**
+ * @brief Push the given frame num_frames times to tensor_if with the given condition.
+ * @return The number of frames passed to the sink (the condition is TRUE).
+ */
+static gint
+_run_tensor_if_reduction_data (const gchar *condition, const gchar *type,
+    gconstpointer data, gsize size, guint num_frames)
+{
+  GstElement *pipeline, *appsrc_handle, *sink_handle;
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo info;
+  gint idx = 0;
+  guint i;
+  gchar *str_pipeline = g_strdup_printf (
+      "appsrc name=appsrc ! other/tensor,dimension=(string)3:4:2:2,type=(string)%s,framerate=(fraction)0/1 ! "
+      "tensor_if name=tif %s then=PASSTHROUGH else=SKIP ! "
+      "tensor_sink name=sinkx async=false", type, condition);
+
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  if (pipeline == NULL)
+    return -1;
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (pipeline), "appsrc");
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sinkx");
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx);
+
+  data_received = 0;
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  for (i = 0; i < num_frames; i++) {
+    buf = gst_buffer_new ();
+    mem = gst_allocator_alloc (NULL, size, NULL);
+    if (gst_memory_map (mem, &info, GST_MAP_WRITE)) {
+      memcpy (info.data, data, size);
+      gst_memory_unmap (mem, &info);
+    }
+    gst_buffer_append_memory (buf, mem);
+
+    EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf), GST_FLOW_OK);
+    g_usleep (100000);
+  }
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  gst_object_unref (sink_handle);
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (pipeline);
+
+  return data_received;
+}
+
+/**
+ * @brief Push the first test frame num_frames times to tensor_if with the given condition.
+ * @return The number of frames passed to the sink (the condition is TRUE).
+ */
+static gint
+_run_tensor_if_reduction (const gchar *condition, guint num_frames)
+{
+  return _run_tensor_if_reduction_data (condition, "int32", test_frames[0],
+      192, num_frames);
+}
+
+/**
+ * @brief Push a half precision frame (0, 1, ..., 47) to tensor_if with the given condition.
+ * @return The number of frames passed to the sink (the condition is TRUE).
+ */
+static gint
+_run_tensor_if_reduction_half (const gchar *condition, tensor_type type,
+    guint num_frames)
+{
+  gfloat f32[48];
+  guint16 half[48];
+  guint i;
+
+  for (i = 0; i < 48; i++)
+    f32[i] = (gfloat) i;
+
+  if (!gst_tensor_data_raw_float_to_half (f32, half, type, 48))
+    return -1;
+
+  return _run_tensor_if_reduction_data (condition,
+      gst_tensor_get_type_string (type), half, sizeof (half), num_frames);
+}
+
+/**
+ * @brief Test reductions of the whole tensor
+ */
+TEST (tensorIfReduction, wholeTensor)
+{
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_TOTAL_VALUE "
+      "compared-value-option=0 supplied-value=55800 operator=EQ", 1));
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_MAX_VALUE "
+      "compared-value-option=0 supplied-value=1224 operator=EQ", 1));
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_MIN_VALUE "
+      "compared-value-option=0 supplied-value=1101 operator=EQ", 1));
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_L1_NORM "
+      "compared-value-option=0 supplied-value=55800 operator=EQ", 1));
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_L2_NORM "
+      "compared-value-option=0 supplied-value=8000,8100 operator=RANGE_INCLUSIVE", 1));
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_ARGMAX "
+      "compared-value-option=0 supplied-value=47 operator=EQ", 1));
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_COUNT_ABOVE "
+      "compared-value-option=0 compared-value-threshold=1200 supplied-value=24 operator=EQ", 1));
+}
+
+/**
+ * @brief Test reductions of a channel and a region
+ */
+TEST (tensorIfReduction, region)
+{
+  /* the 1st channel: 1101, 1104, ..., 1222 */
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_MAX_VALUE "
+      "compared-value-option=0:0:0:0,1:0:0:0,0 supplied-value=1222 operator=EQ", 1));
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_ARGMAX "
+      "compared-value-option=0:0:0:0,1:0:0:0,0 supplied-value=15 operator=EQ", 1));
+
+  /* [0..2][1..2][0..1][1]: 1204 ~ 1209 and 1216 ~ 1221 */
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_TOTAL_VALUE "
+      "compared-value-option=0:1:0:1,3:2:2:1,0 supplied-value=14550 operator=EQ", 1));
+}
+
+/**
+ * @brief Test delta from the previous frame
+ */
+TEST (tensorIfReduction, delta)
+{
+  /* the first frame is compared with zeros, the second one is same as the first */
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_DELTA_VALUE "
+      "compared-value-option=0 supplied-value=0.5 operator=LT", 2));
+  EXPECT_EQ (1, _run_tensor_if_reduction ("compared-value=TENSOR_DELTA_VALUE "
+      "compared-value-option=0 supplied-value=1162.5 operator=EQ", 3));
+}
+
+/**
+ * @brief Test reductions of half precision tensors
+ */
+TEST (tensorIfReduction, halfPrecision)
+{
+  const tensor_type types[] = { _NNS_FLOAT16, _NNS_BFLOAT16 };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (types); i++) {
+    EXPECT_EQ (1, _run_tensor_if_reduction_half ("compared-value=TENSOR_TOTAL_VALUE "
+        "compared-value-option=0 supplied-value=1128 operator=EQ", types[i], 1));
+    EXPECT_EQ (1, _run_tensor_if_reduction_half ("compared-value=TENSOR_MAX_VALUE "
+        "compared-value-option=0 supplied-value=47 operator=EQ", types[i], 1));
+    EXPECT_EQ (1, _run_tensor_if_reduction_half ("compared-value=TENSOR_MIN_VALUE "
+        "compared-value-option=0 supplied-value=0 operator=EQ", types[i], 1));
+    EXPECT_EQ (1, _run_tensor_if_reduction_half ("compared-value=TENSOR_L2_NORM "
+        "compared-value-option=0 supplied-value=188.9,189.1 operator=RANGE_INCLUSIVE", types[i], 1));
+    EXPECT_EQ (1, _run_tensor_if_reduction_half ("compared-value=TENSOR_ARGMAX "
+        "compared-value-option=0 supplied-value=47 operator=EQ", types[i], 1));
+    EXPECT_EQ (1, _run_tensor_if_reduction_half ("compared-value=TENSOR_COUNT_ABOVE "
+        "compared-value-option=0 compared-value-threshold=40 supplied-value=7 operator=EQ", types[i], 1));
+    /* the 1st channel: 0, 3, ..., 45 */
+    EXPECT_EQ (1, _run_tensor_if_reduction_half ("compared-value=TENSOR_MAX_VALUE "
+        "compared-value-option=0:0:0:0,1:0:0:0,0 supplied-value=45 operator=EQ", types[i], 1));
+    /* the second frame is same as the first one */
+    EXPECT_EQ (1, _run_tensor_if_reduction_half ("compared-value=TENSOR_DELTA_VALUE "
+        "compared-value-option=0 supplied-value=0.5 operator=LT", types[i], 2));
+  }
+}
+
+/**
+ * @brief Test reductions with invalid region
+ */
+TEST (tensorIfReduction, invalidRegion_n)
+{
+  EXPECT_EQ (0, _run_tensor_if_reduction ("compared-value=TENSOR_MAX_VALUE "
+      "compared-value-option=3:0:0:0,1:0:0:0,0 supplied-value=0 operator=GE", 1));
+  EXPECT_EQ (0, _run_tensor_if_reduction ("compared-value=TENSOR_MAX_VALUE "
+      "compared-value-option=0:0:0:0,4:0:0:0,0 supplied-value=0 operator=GE", 1));
+  EXPECT_EQ (0, _run_tensor_if_reduction ("compared-value=TENSOR_MAX_VALUE "
+      "compared-value-option=0:0,0 supplied-value=0 operator=GE", 1));
+}
+
 
 /**
  * @brief Main GTest
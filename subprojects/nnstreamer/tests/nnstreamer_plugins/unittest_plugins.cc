@@ -8,7 +8,11 @@
  */
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <glib/gstdio.h>
+#include <gst/app/gstappsink.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/base/gstbasetransform.h>
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstharness.h>
 #include <gst/check/gsttestclock.h>
@@ -17,8 +21,10 @@
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api_filter.h>
 #include <nnstreamer_subplugin.h>
+#include <nnstreamer_util.h>
 #include <string.h>
 #include <tensor_common.h>
+#include <tensor_filter_custom_easy.h>
 #include <tensor_meta.h>
 #include <unistd.h>
 
@@ -1117,6 +1123,170 @@ TEST_TRANSFORM_TYPECAST (typecast_14, 3U, 5U, double, _NNS_FLOAT64, uint64_t,
 TEST_TRANSFORM_TYPECAST (typecast_14_accel, 3U, 5U, double, _NNS_FLOAT64,
     uint64_t, "uint64", _NNS_UINT64, TRUE)
 
+/**
+ * @brief Push a buffer to tensor_transform and compare the output.
+ */
+static void
+run_transform_half (gint mode, const gchar *option, gboolean accel,
+    tensor_type in_type, gconstpointer in_data, tensor_type out_type,
+    gconstpointer expected, guint num)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  gchar *dim;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", mode, "option", option,
+      "acceleration", accel, NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = in_type;
+  dim = g_strdup_printf ("%u", num);
+  gst_tensor_parse_dimension (dim, config.info.info[0].dimension);
+  g_free (dim);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, num * gst_tensor_get_element_size (in_type));
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  memcpy (info.data, in_data, info.size);
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), num * gst_tensor_get_element_size (out_type));
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+  EXPECT_EQ (memcmp (info.data, expected, info.size), 0);
+  gst_memory_unmap (mem, &info);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform typecast (float32 <-> float16)
+ */
+TEST (testTensorTransform, typecastFloat16)
+{
+  const float f32[6] = { 0.5f, -2.0f, 1.0f, 65504.0f, 1e-8f, 0.1f };
+  /* 0.1 rounds to the nearest float16 (0x2e66) */
+  const uint16_t f16[6] = { 0x3800, 0xc000, 0x3c00, 0x7bff, 0x0000, 0x2e66 };
+  const float back[6] = { 0.5f, -2.0f, 1.0f, 65504.0f, 0.0f, 0.0999755859375f };
+
+  run_transform_half (GTT_TYPECAST, "float16", FALSE, _NNS_FLOAT32, f32,
+      _NNS_FLOAT16, f16, 6U);
+  run_transform_half (GTT_TYPECAST, "float16", TRUE, _NNS_FLOAT32, f32,
+      _NNS_FLOAT16, f16, 6U);
+  run_transform_half (GTT_TYPECAST, "float32", FALSE, _NNS_FLOAT16, f16,
+      _NNS_FLOAT32, back, 6U);
+}
+
+/**
+ * @brief Test for tensor_transform typecast (bfloat16 -> uint8, float16 -> bfloat16)
+ */
+TEST (testTensorTransform, typecastBfloat16)
+{
+  /* 1.0, 2.0, 255.0, 7.0 */
+  const uint16_t bf16[4] = { 0x3f80, 0x4000, 0x437f, 0x40e0 };
+  const uint8_t u8[4] = { 1U, 2U, 255U, 7U };
+  const uint16_t f16[4] = { 0x3c00, 0x4000, 0x5bf8, 0x4700 };
+
+  run_transform_half (GTT_TYPECAST, "uint8", FALSE, _NNS_BFLOAT16, bf16,
+      _NNS_UINT8, u8, 4U);
+  run_transform_half (GTT_TYPECAST, "uint8", TRUE, _NNS_BFLOAT16, bf16,
+      _NNS_UINT8, u8, 4U);
+  run_transform_half (GTT_TYPECAST, "bfloat16", FALSE, _NNS_FLOAT16, f16,
+      _NNS_BFLOAT16, bf16, 4U);
+}
+
+/**
+ * @brief Test for tensor_transform arithmetic (float16)
+ */
+TEST (testTensorTransform, arithmeticFloat16)
+{
+  /* 1.5, -0.5, 3.0 */
+  const uint16_t f16[3] = { 0x3e00, 0xb800, 0x4200 };
+  /* (x + 1) * 2 : 5.0, 1.0, 8.0 */
+  const uint16_t f16_out[3] = { 0x4500, 0x3c00, 0x4800 };
+  const float f32_out[3] = { 5.0f, 1.0f, 8.0f };
+
+  run_transform_half (GTT_ARITHMETIC, "add:1,mul:2", FALSE, _NNS_FLOAT16,
+      f16, _NNS_FLOAT16, f16_out, 3U);
+  run_transform_half (GTT_ARITHMETIC, "add:1,mul:2", TRUE, _NNS_FLOAT16,
+      f16, _NNS_FLOAT16, f16_out, 3U);
+  run_transform_half (GTT_ARITHMETIC, "typecast:float32,add:1,mul:2", TRUE,
+      _NNS_FLOAT16, f16, _NNS_FLOAT32, f32_out, 3U);
+  run_transform_half (GTT_ARITHMETIC, "typecast:float16,mul:0.5,add:-1", FALSE,
+      _NNS_FLOAT32, f32_out, _NNS_FLOAT16, f16, 3U);
+}
+
+/**
+ * @brief Test for tensor_transform clamp and stand (bfloat16)
+ */
+TEST (testTensorTransform, clampStandBfloat16)
+{
+  /* -3.0, 0.5, 2.0, 1.0 */
+  const uint16_t bf16[4] = { 0xc040, 0x3f00, 0x4000, 0x3f80 };
+  /* clamp to [-1, 1] : -1.0, 0.5, 1.0, 1.0 */
+  const uint16_t clamped[4] = { 0xbf80, 0x3f00, 0x3f80, 0x3f80 };
+  /* subtract the average (0.125) */
+  const float dc[4] = { -3.125f, 0.375f, 1.875f, 0.875f };
+
+  run_transform_half (GTT_CLAMP, "-1:1", FALSE, _NNS_BFLOAT16, bf16,
+      _NNS_BFLOAT16, clamped, 4U);
+  run_transform_half (GTT_STAND, "dc-average:float32", FALSE, _NNS_BFLOAT16,
+      bf16, _NNS_FLOAT32, dc, 4U);
+}
+
+/**
+ * @brief Test for half precision conversion of tensor data.
+ */
+TEST (testTensorTransform, dataConvertHalf)
+{
+  const uint16_t special[6] = { 0x7c00, 0xfc00, 0x0001, 0x8000, 0x03ff, 0x0400 };
+  float f32[6];
+  uint16_t f16[6];
+  tensor_data_s td;
+  uint16_t h = 0x3c00;
+  int32_t i32;
+
+  /* infinity, subnormal and -0.0 survive the round trip */
+  EXPECT_TRUE (gst_tensor_data_raw_half_to_float (special, _NNS_FLOAT16, f32, 6U));
+  EXPECT_TRUE (std::isinf (f32[0]) && f32[0] > 0);
+  EXPECT_TRUE (std::isinf (f32[1]) && f32[1] < 0);
+  EXPECT_FLOAT_EQ (f32[2], 5.9604645e-08f);
+  EXPECT_TRUE (f32[3] == 0.0f && std::signbit (f32[3]));
+  EXPECT_TRUE (gst_tensor_data_raw_float_to_half (f32, f16, _NNS_FLOAT16, 6U));
+  EXPECT_EQ (memcmp (f16, special, sizeof (special)), 0);
+
+  /* bfloat16 rounds to nearest even */
+  f32[0] = 1.00390625f; /* 0x3f808000, tie */
+  f32[1] = 1.01171875f; /* 0x3f818000, tie */
+  EXPECT_TRUE (gst_tensor_data_raw_float_to_half (f32, f16, _NNS_BFLOAT16, 2U));
+  EXPECT_EQ (f16[0], 0x3f80);
+  EXPECT_EQ (f16[1], 0x3f82);
+
+  /* scalar typecast through float32 */
+  EXPECT_TRUE (gst_tensor_data_set (&td, _NNS_FLOAT16, &h));
+  EXPECT_TRUE (gst_tensor_data_typecast (&td, _NNS_INT32));
+  EXPECT_TRUE (gst_tensor_data_get (&td, &i32));
+  EXPECT_EQ (i32, 1);
+
+  EXPECT_FALSE (gst_tensor_data_raw_half_to_float (special, _NNS_FLOAT32, f32, 6U));
+  EXPECT_FALSE (gst_tensor_data_raw_float_to_half (f32, f16, _NNS_UINT16, 6U));
+}
+
 /**
  * @brief Test for tensor_transform arithmetic (float32, add .5)
  */
@@ -3153,6 +3323,59 @@ TEST (testTensorConverter, bytesToStatic)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_converter (bytes to static tensor, frames-per-tensor with contiguous memories)
+ */
+TEST (testTensorConverter, bytesChunkSharedMemory)
+{
+  GstHarness *h;
+  GstCaps *caps;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *parent, *mem;
+  GstMapInfo pmap, map;
+  guint i;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "input-dim", "4", "input-type", "uint8",
+      "frames-per-tensor", 3, NULL);
+
+  caps = gst_caps_from_string ("application/octet-stream");
+  gst_harness_set_src_caps (h, caps);
+
+  /* sub-memories of a ring buffer (parent memory) */
+  parent = gst_allocator_alloc (NULL, 16, NULL);
+  ASSERT_TRUE (gst_memory_map (parent, &pmap, GST_MAP_WRITE));
+  for (i = 0; i < 16; i++)
+    pmap.data[i] = i;
+
+  /* push 2 frames in each buffer, a tensor (3 frames) spans two buffers */
+  for (i = 0; i < 2; i++) {
+    in_buf = gst_buffer_new ();
+    gst_buffer_append_memory (in_buf, gst_memory_share (parent, i * 8, 8));
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 12U);
+
+  /* contiguous memories are shared without copy */
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_EQ (map.data, pmap.data);
+  for (i = 0; i < 12; i++)
+    EXPECT_EQ (map.data[i], i);
+  gst_memory_unmap (mem, &map);
+
+  gst_buffer_unref (out_buf);
+  gst_memory_unmap (parent, &pmap);
+  gst_memory_unref (parent);
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_converter (bytes to flex tensor)
  */
@@ -6719,6 +6942,100 @@ TEST (testDecoderSubplugins, protobufInvalidParam2_n)
   EXPECT_EQ (GST_FLOW_ERROR, pb_dec->decode (NULL, &config, input, NULL));
 }
 
+/**
+ * @brief Test for protobuf converter (the output memories refer to the serialized buffer)
+ */
+TEST (testConverterSubplugins, protobufZeroCopy)
+{
+  GstBuffer *dec_out_buf, *conv_out_buf;
+  GstTensorsConfig config, check_config;
+  GstTensorMemory input[2];
+  GstMapInfo dec_info, info;
+  const GstTensorDecoderDef *pb_dec;
+  const NNStreamerExternalConverter *pb_conv;
+  guint i;
+
+  pb_dec = nnstreamer_decoder_find ("protobuf");
+  pb_conv = nnstreamer_converter_find ("protobuf");
+  ASSERT_TRUE (pb_dec);
+  ASSERT_TRUE (pb_conv);
+
+  gst_tensors_config_init (&config);
+  gst_tensors_config_init (&check_config);
+  config.rate_n = 30;
+  config.rate_d = 1;
+  config.info.num_tensors = 2;
+  for (i = 0; i < 2; i++) {
+    config.info.info[i].type = _NNS_INT32;
+    gst_tensor_parse_dimension ("3:4:2:2", config.info.info[i].dimension);
+    input[i].size = gst_tensor_info_get_size (&config.info.info[i]);
+    input[i].data = (gpointer) aggr_test_frames[i];
+  }
+
+  dec_out_buf = gst_buffer_new ();
+  EXPECT_EQ (GST_FLOW_OK, pb_dec->decode (NULL, &config, input, dec_out_buf));
+
+  conv_out_buf = pb_conv->convert (dec_out_buf, &check_config, NULL);
+  ASSERT_TRUE (conv_out_buf != NULL);
+  EXPECT_EQ (gst_buffer_n_memory (conv_out_buf), 2U);
+  EXPECT_TRUE (gst_tensors_config_is_equal (&config, &check_config));
+
+  ASSERT_TRUE (gst_buffer_map (dec_out_buf, &dec_info, GST_MAP_READ));
+  for (i = 0; i < 2; i++) {
+    GstMemory *mem = gst_buffer_peek_memory (conv_out_buf, i);
+
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    EXPECT_EQ (info.size, input[i].size);
+    EXPECT_TRUE (info.data > dec_info.data);
+    EXPECT_TRUE (info.data + info.size <= dec_info.data + dec_info.size);
+    EXPECT_EQ (memcmp (info.data, input[i].data, info.size), 0);
+    gst_memory_unmap (mem, &info);
+  }
+  gst_buffer_unmap (dec_out_buf, &dec_info);
+
+  gst_tensors_config_free (&check_config);
+  gst_buffer_unref (conv_out_buf);
+  gst_buffer_unref (dec_out_buf);
+}
+
+/**
+ * @brief Test for protobuf converter with a truncated message
+ */
+TEST (testConverterSubplugins, protobufTruncated_n)
+{
+  GstBuffer *dec_out_buf, *conv_out_buf;
+  GstTensorsConfig config, check_config;
+  GstTensorMemory input[1];
+  const GstTensorDecoderDef *pb_dec;
+  const NNStreamerExternalConverter *pb_conv;
+
+  pb_dec = nnstreamer_decoder_find ("protobuf");
+  pb_conv = nnstreamer_converter_find ("protobuf");
+  ASSERT_TRUE (pb_dec);
+  ASSERT_TRUE (pb_conv);
+
+  gst_tensors_config_init (&config);
+  gst_tensors_config_init (&check_config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("3:4:2:2", config.info.info[0].dimension);
+  input[0].size = gst_tensor_info_get_size (&config.info.info[0]);
+  input[0].data = (gpointer) aggr_test_frames[0];
+
+  dec_out_buf = gst_buffer_new ();
+  EXPECT_EQ (GST_FLOW_OK, pb_dec->decode (NULL, &config, input, dec_out_buf));
+
+  /** Cut the last byte of the tensor data */
+  gst_buffer_resize (dec_out_buf, 0, gst_buffer_get_size (dec_out_buf) - 1);
+  conv_out_buf = pb_conv->convert (dec_out_buf, &check_config, NULL);
+  EXPECT_TRUE (conv_out_buf == NULL);
+
+  gst_tensors_config_free (&check_config);
+  gst_buffer_unref (dec_out_buf);
+}
+
 /**
  * @brief Test for converter subplugins with invalid parameter
  */
@@ -7451,9 +7768,9 @@ TEST (testTensorCrop, infoDelayed_n)
 }
 
 /**
- * @brief Macro to test sparse tensor conversion for each data type.
+ * @brief Macro to test sparse tensor conversion for each data type and encoding.
  */
-#define RUN_SPARSE_CONVERT_TEST(ttype,dtype) do {\
+#define RUN_SPARSE_CONVERT_TEST_ENCODING(ttype,dtype,enc,bsize) do {\
     const gint sparse_test_data[40] = {\
       0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,\
       0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,\
@@ -7462,7 +7779,7 @@ TEST (testTensorCrop, infoDelayed_n)
     GstMapInfo map;\
     GstTensorInfo info;\
     GstTensorMetaInfo meta;\
-    guint i;\
+    guint i, encoding = _NNS_SPARSE_ENCODING_END;\
     gpointer data;\
     gsize data_size;\
     gst_tensor_info_init (&info);\
@@ -7475,8 +7792,15 @@ TEST (testTensorCrop, infoDelayed_n)
       ((dtype *) data)[i] = (dtype) sparse_test_data[i];\
     origin = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,\
         data, data_size, 0, data_size, data, g_free);\
-    sparse = gst_tensor_sparse_from_dense (&meta, origin);\
-    EXPECT_TRUE (sparse != NULL);\
+    sparse = gst_tensor_sparse_from_dense_full (&meta, origin, (enc), (bsize));\
+    ASSERT_TRUE (sparse != NULL);\
+    ASSERT_TRUE (gst_memory_map (sparse, &map, GST_MAP_READ));\
+    EXPECT_TRUE (gst_tensor_meta_info_get_sparse_encoding (map.data, &encoding, NULL));\
+    if ((enc) != TENSOR_SPARSE_ENCODING_AUTO)\
+      EXPECT_EQ (encoding, (guint) (enc));\
+    EXPECT_EQ (map.size, gst_tensor_meta_info_get_header_size (&meta) +\
+        gst_tensor_meta_info_get_data_size_from_header (map.data));\
+    gst_memory_unmap (sparse, &map);\
     dense = gst_tensor_sparse_to_dense (&meta, sparse);\
     EXPECT_TRUE (dense != NULL);\
     ASSERT_TRUE (gst_memory_map (dense, &map, GST_MAP_READ));\
@@ -7489,6 +7813,12 @@ TEST (testTensorCrop, infoDelayed_n)
     gst_memory_unref (origin);\
   } while (0)
 
+/**
+ * @brief Macro to test sparse tensor conversion (COO encoding) for each data type.
+ */
+#define RUN_SPARSE_CONVERT_TEST(ttype,dtype) \
+    RUN_SPARSE_CONVERT_TEST_ENCODING (ttype, dtype, _NNS_SPARSE_ENCODING_COO, 0)
+
 /**
  * @brief Test for tensor_sparse util, sparse tensor for various data type.
  */
@@ -7506,6 +7836,222 @@ TEST (testTensorSparse, utilConvert)
   RUN_SPARSE_CONVERT_TEST (_NNS_FLOAT32, float);
 }
 
+/**
+ * @brief Test for tensor_sparse util, bitmap encoding for various data type.
+ */
+TEST (testTensorSparse, utilConvertBitmap)
+{
+  const guint enc = _NNS_SPARSE_ENCODING_BITMAP;
+
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_INT32, int32_t, enc, 0);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_UINT16, uint16_t, enc, 0);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_INT8, int8_t, enc, 0);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_UINT64, uint64_t, enc, 0);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_FLOAT64, double, enc, 0);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_FLOAT32, float, enc, 0);
+}
+
+/**
+ * @brief Test for tensor_sparse util, block encoding for various data type and block size.
+ */
+TEST (testTensorSparse, utilConvertBlock)
+{
+  const guint enc = _NNS_SPARSE_ENCODING_BLOCK;
+
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_INT32, int32_t, enc, 4);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_UINT16, uint16_t, enc, 16);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_INT8, int8_t, enc, 7);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_UINT64, uint64_t, enc, 1);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_FLOAT64, double, enc, 64);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_FLOAT32, float, enc, 3);
+}
+
+/**
+ * @brief Test for tensor_sparse util, select the encoding with the smallest size.
+ */
+TEST (testTensorSparse, utilConvertAuto)
+{
+  const guint enc = TENSOR_SPARSE_ENCODING_AUTO;
+
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_INT32, int32_t, enc, 16);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_UINT8, uint8_t, enc, 0);
+  RUN_SPARSE_CONVERT_TEST_ENCODING (_NNS_FLOAT32, float, enc, 2);
+}
+
+/**
+ * @brief Test for tensor_sparse util, large tensor with dense and zero runs.
+ */
+TEST (testTensorSparse, utilConvertLarge)
+{
+  const guint encodings[] = { _NNS_SPARSE_ENCODING_COO,
+      _NNS_SPARSE_ENCODING_BITMAP, _NNS_SPARSE_ENCODING_BLOCK };
+  GstTensorMetaInfo meta;
+  GstMemory *origin, *sparse, *dense;
+  GstMapInfo map;
+  float *data;
+  guint i, e, encoding, nnz = 0;
+  const guint count = 1000U;
+  gsize data_size = count * sizeof (float);
+
+  data = (float *) g_malloc0 (data_size);
+  for (i = 0; i < count; i++) {
+    /* zero run, fully dense 64 elements, then scattered values */
+    if ((i >= 128 && i < 192) || (i > 300 && i % 7 == 0))
+      data[i] = (float) (i + 1) * ((i % 2) ? -0.5f : 0.5f);
+    if (data[i] != 0)
+      nnz++;
+  }
+
+  origin = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  for (e = 0; e < G_N_ELEMENTS (encodings); e++) {
+    gst_tensor_meta_info_init (&meta);
+    meta.type = _NNS_FLOAT32;
+    meta.dimension[0] = 10;
+    meta.dimension[1] = 100;
+
+    sparse = gst_tensor_sparse_from_dense_full (&meta, origin, encodings[e], 32);
+    ASSERT_TRUE (sparse != NULL);
+    ASSERT_TRUE (gst_memory_map (sparse, &map, GST_MAP_READ));
+    EXPECT_TRUE (gst_tensor_meta_info_get_sparse_encoding (map.data, &encoding, NULL));
+    EXPECT_EQ (encoding, encodings[e]);
+    gst_memory_unmap (sparse, &map);
+    if (encodings[e] != _NNS_SPARSE_ENCODING_BLOCK)
+      EXPECT_EQ (meta.sparse_info.nnz, nnz);
+
+    dense = gst_tensor_sparse_to_dense (&meta, sparse);
+    ASSERT_TRUE (dense != NULL);
+    EXPECT_EQ (meta.format, (guint) _NNS_TENSOR_FORMAT_STATIC);
+
+    ASSERT_TRUE (gst_memory_map (dense, &map, GST_MAP_READ));
+    EXPECT_EQ (map.size, data_size);
+    EXPECT_EQ (memcmp (map.data, data, data_size), 0);
+    gst_memory_unmap (dense, &map);
+
+    gst_memory_unref (sparse);
+    gst_memory_unref (dense);
+  }
+
+  gst_memory_unref (origin);
+}
+
+/**
+ * @brief Test for tensor_sparse util, invalid index in sparse tensor.
+ */
+TEST (testTensorSparse, utilInvalidIndex_n)
+{
+  const guint encodings[] = { _NNS_SPARSE_ENCODING_COO,
+      _NNS_SPARSE_ENCODING_BLOCK };
+  GstTensorMetaInfo meta;
+  GstMemory *origin, *sparse, *dense;
+  GstMapInfo map;
+  guint8 *data;
+  guint e, invalid_index = 100U;
+  gsize data_size = 32U;
+
+  data = (guint8 *) g_malloc0 (data_size);
+  data[5] = 1;
+  origin = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  for (e = 0; e < G_N_ELEMENTS (encodings); e++) {
+    gst_tensor_meta_info_init (&meta);
+    meta.type = _NNS_UINT8;
+    meta.dimension[0] = data_size;
+
+    sparse = gst_tensor_sparse_from_dense_full (&meta, origin, encodings[e], 4);
+    ASSERT_TRUE (sparse != NULL);
+    EXPECT_EQ (meta.sparse_info.nnz, 1U);
+
+    /* overwrite the index, out of the tensor */
+    ASSERT_TRUE (gst_memory_map (sparse, &map, GST_MAP_WRITE));
+    memcpy (map.data + map.size - sizeof (guint), &invalid_index,
+        sizeof (guint));
+    gst_memory_unmap (sparse, &map);
+
+    dense = gst_tensor_sparse_to_dense (&meta, sparse);
+    EXPECT_FALSE (dense != NULL);
+
+    gst_memory_unref (sparse);
+  }
+
+  gst_memory_unref (origin);
+}
+
+/**
+ * @brief Test for tensor_sparse util, invalid encoding.
+ */
+TEST (testTensorSparse, utilInvalidEncoding_n)
+{
+  GstTensorMetaInfo meta;
+  GstMemory *in, *out;
+  guint8 *data;
+  gsize data_size = 32U;
+
+  data = (guint8 *) g_malloc0 (data_size);
+  in = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  gst_tensor_meta_info_init (&meta);
+  meta.type = _NNS_UINT8;
+  meta.dimension[0] = data_size;
+
+  /* block encoding without block size */
+  out = gst_tensor_sparse_from_dense_full (&meta, in, _NNS_SPARSE_ENCODING_BLOCK, 0);
+  EXPECT_FALSE (out != NULL);
+
+  out = gst_tensor_sparse_from_dense_full (&meta, in, TENSOR_SPARSE_ENCODING_AUTO + 1, 0);
+  EXPECT_FALSE (out != NULL);
+
+  gst_memory_unref (in);
+}
+
+/**
+ * @brief Test for tensor_sparse util, the encoding in the header of sparse tensor.
+ */
+TEST (testTensorSparse, utilHeaderEncoding)
+{
+  GstTensorMetaInfo meta;
+  guint8 header[128];
+  guint32 *val = (guint32 *) header;
+  guint encoding, block_size;
+
+  gst_tensor_meta_info_init (&meta);
+  meta.type = _NNS_UINT8;
+  meta.dimension[0] = 32U;
+  meta.format = _NNS_TENSOR_FORMAT_SPARSE;
+  meta.sparse_info.nnz = 2U;
+  ASSERT_EQ (gst_tensor_meta_info_get_header_size (&meta), sizeof (header));
+
+  /* the header without the encoding (old version) is COO */
+  EXPECT_TRUE (gst_tensor_meta_info_update_header (&meta, header));
+  EXPECT_TRUE (gst_tensor_meta_info_get_sparse_encoding (header, &encoding, &block_size));
+  EXPECT_EQ (encoding, (guint) _NNS_SPARSE_ENCODING_COO);
+  EXPECT_EQ (block_size, 0U);
+  EXPECT_EQ (gst_tensor_meta_info_get_data_size_from_header (header),
+      2U * (1U + sizeof (guint)));
+
+  EXPECT_TRUE (gst_tensor_meta_info_set_sparse_encoding (header, _NNS_SPARSE_ENCODING_BLOCK, 4U));
+  EXPECT_TRUE (gst_tensor_meta_info_get_sparse_encoding (header, &encoding, &block_size));
+  EXPECT_EQ (encoding, (guint) _NNS_SPARSE_ENCODING_BLOCK);
+  EXPECT_EQ (block_size, 4U);
+  EXPECT_TRUE (gst_tensor_meta_info_parse_header (&meta, header));
+  EXPECT_EQ (meta.sparse_info.nnz, 2U);
+  EXPECT_EQ (gst_tensor_meta_info_get_data_size_from_header (header),
+      2U * (4U + sizeof (guint)));
+
+  /* invalid encoding in the header */
+  val[21] = _NNS_SPARSE_ENCODING_END;
+  EXPECT_FALSE (gst_tensor_meta_info_get_sparse_encoding (header, NULL, NULL));
+  EXPECT_FALSE (gst_tensor_meta_info_parse_header (&meta, header));
+  EXPECT_EQ (gst_tensor_meta_info_get_data_size_from_header (header), 0U);
+
+  val[21] = _NNS_SPARSE_ENCODING_BLOCK;
+  val[22] = 0U;
+  EXPECT_FALSE (gst_tensor_meta_info_get_sparse_encoding (header, NULL, NULL));
+}
+
 /**
  * @brief Test for tensor_sparse util, invalid tensor-meta.
  */
@@ -7554,27 +8100,865 @@ TEST (testTensorSparse, encInvalidProperty_n)
 }
 
 /**
- * @brief Test for tensor_sparse_dec, invalid property name.
+ * @brief Test for tensor_sparse_enc, encoding and block-size properties.
  */
-TEST (testTensorSparse, decInvalidProperty_n)
+TEST (testTensorSparse, encProperties)
 {
   GstHarness *h;
-  gboolean value_bool, res_bool;
-  gchar *value_str = NULL;
+  gint encoding;
+  guint block_size;
 
-  h = gst_harness_new ("tensor_sparse_dec");
+  h = gst_harness_new ("tensor_sparse_enc");
 
-  g_object_get (h->element, "silent", &value_bool, NULL);
-  g_object_set (h->element, "silent", !value_bool, NULL);
-  g_object_get (h->element, "silent", &res_bool, NULL);
-  EXPECT_EQ (res_bool, !value_bool);
+  g_object_get (h->element, "encoding", &encoding, "block-size", &block_size,
+      NULL);
+  EXPECT_EQ (encoding, (gint) _NNS_SPARSE_ENCODING_COO);
+  EXPECT_EQ (block_size, 16U);
 
-  g_object_set (h->element, "invalid-prop", &value_str, NULL);
-  EXPECT_FALSE (value_str != NULL);
+  gst_util_set_object_arg (G_OBJECT (h->element), "encoding", "bitmap");
+  g_object_get (h->element, "encoding", &encoding, NULL);
+  EXPECT_EQ (encoding, (gint) _NNS_SPARSE_ENCODING_BITMAP);
+
+  gst_util_set_object_arg (G_OBJECT (h->element), "encoding", "auto");
+  g_object_get (h->element, "encoding", &encoding, NULL);
+  EXPECT_EQ (encoding, (gint) TENSOR_SPARSE_ENCODING_AUTO);
+
+  g_object_set (h->element, "block-size", 8U, NULL);
+  g_object_get (h->element, "block-size", &block_size, NULL);
+  EXPECT_EQ (block_size, 8U);
 
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_sparse enc and dec, round trip with each encoding.
+ */
+TEST (testTensorSparse, encDecEncodings)
+{
+  const gchar *encodings[] = { "coo", "bitmap", "block", "auto" };
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  guint i, e;
+  const guint count = 100U;
+  guint8 data[100];
+
+  for (i = 0; i < count; i++)
+    data[i] = (i % 9 == 0) ? (guint8) i : 0;
+
+  for (e = 0; e < G_N_ELEMENTS (encodings); e++) {
+    gchar *desc = g_strdup_printf (
+        "tensor_sparse_enc encoding=%s block-size=4 ! tensor_sparse_dec",
+        encodings[e]);
+
+    h = gst_harness_new_parse (desc);
+    g_free (desc);
+    gst_harness_set_src_caps_str (h,
+        "other/tensors,num_tensors=1,types=uint8,dimensions=100:1:1:1,"
+        "format=static,framerate=0/1");
+
+    for (i = 0; i < 2; i++) {
+      in_buf = gst_harness_create_buffer (h, count);
+      ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+      memcpy (map.data, data, count);
+      gst_buffer_unmap (in_buf, &map);
+
+      EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+      out_buf = gst_harness_pull (h);
+      ASSERT_TRUE (out_buf != NULL);
+      EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+      ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+      EXPECT_EQ (map.size, count);
+      EXPECT_EQ (memcmp (map.data, data, count), 0);
+      gst_buffer_unmap (out_buf, &map);
+      gst_buffer_unref (out_buf);
+    }
+
+    gst_harness_teardown (h);
+  }
+}
+
+/**
+ * @brief Test for tensor_sparse_dec, invalid property name.
+ */
+TEST (testTensorSparse, decInvalidProperty_n)
+{
+  GstHarness *h;
+  gboolean value_bool, res_bool;
+  gchar *value_str = NULL;
+
+  h = gst_harness_new ("tensor_sparse_dec");
+
+  g_object_get (h->element, "silent", &value_bool, NULL);
+  g_object_set (h->element, "silent", !value_bool, NULL);
+  g_object_get (h->element, "silent", &res_bool, NULL);
+  EXPECT_EQ (res_bool, !value_bool);
+
+  g_object_set (h->element, "invalid-prop", &value_str, NULL);
+  EXPECT_FALSE (value_str != NULL);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Set caps (uint8 tensor, 1:4:4:1) for tensor_filter_cascade test.
+ */
+static void
+_cascade_test_set_caps (GstHarness * h)
+{
+  GstTensorsConfig config;
+  GstCaps *caps;
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1:4:4:1", config.info.info[0].dimension);
+
+  caps = gst_tensors_caps_from_config (&config);
+  gst_harness_set_src_caps (h, caps);
+  gst_tensors_config_free (&config);
+}
+
+/**
+ * @brief Push a buffer (16 bytes, 0 to 15) for tensor_filter_cascade test.
+ */
+static GstFlowReturn
+_cascade_test_push (GstHarness * h, GstMemory ** input)
+{
+  GstBuffer *in_buf;
+  GstMapInfo map;
+  guint i;
+
+  in_buf = gst_harness_create_buffer (h, 16U);
+  *input = gst_buffer_peek_memory (in_buf, 0);
+
+  if (gst_buffer_map (in_buf, &map, GST_MAP_WRITE)) {
+    for (i = 0; i < 16U; i++)
+      map.data[i] = (guint8) i;
+    gst_buffer_unmap (in_buf, &map);
+  }
+
+  return gst_harness_push (h, in_buf);
+}
+
+/**
+ * @brief In-code function for tensor_filter_cascade test (doubles the values).
+ */
+static int
+_cascade_test_double (void *, const GstTensorFilterProperties *,
+    const GstTensorMemory *in, GstTensorMemory *out)
+{
+  guint i;
+
+  for (i = 0; i < in[0].size; i++)
+    ((guint8 *) out[0].data)[i] = ((guint8 *) in[0].data)[i] * 2;
+
+  return 0;
+}
+
+/**
+ * @brief Test for tensor_filter_cascade, crop/resize/threshold stages.
+ */
+TEST (testTensorFilterCascade, glueStages)
+{
+  const guint8 expected_roi[4] = { 5, 6, 9, 10 };
+  const guint8 expected_big[16] = {
+    5, 5, 6, 6, 5, 5, 6, 6, 9, 9, 10, 10, 9, 9, 10, 10
+  };
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstMemory *input, *mem;
+  GstMapInfo map;
+  guint i;
+
+  h = gst_harness_new ("tensor_filter_cascade");
+  g_object_set (h->element, "stages",
+      "roi:crop region=1:1:2:2 ; th:threshold in=input value=8 ; "
+      "big:resize in=roi size=4:4", "output", "roi,big,th,input", NULL);
+  _cascade_test_set_caps (h);
+
+  EXPECT_EQ (_cascade_test_push (h, &input), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 4U);
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, 4U);
+  for (i = 0; i < 4U; i++)
+    EXPECT_EQ (map.data[i], expected_roi[i]);
+  gst_memory_unmap (mem, &map);
+
+  mem = gst_buffer_peek_memory (out_buf, 1);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, 16U);
+  for (i = 0; i < 16U; i++)
+    EXPECT_EQ (map.data[i], expected_big[i]);
+  gst_memory_unmap (mem, &map);
+
+  mem = gst_buffer_peek_memory (out_buf, 2);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, 16U);
+  for (i = 0; i < 16U; i++)
+    EXPECT_EQ (map.data[i], (i < 8U) ? 0U : i);
+  gst_memory_unmap (mem, &map);
+
+  /* the input tensor is passed without copy */
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 3) == input);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_filter_cascade, independent model stages.
+ */
+TEST (testTensorFilterCascade, filterStages)
+{
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstMemory *input, *mem;
+  GstMapInfo map;
+  GstTensorsInfo info;
+  guint i;
+  int ret;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1:4:4:1", info.info[0].dimension);
+
+  ret = NNS_custom_easy_register ("cascade_double", _cascade_test_double,
+      NULL, &info, &info);
+  ASSERT_EQ (ret, 0);
+
+  h = gst_harness_new ("tensor_filter_cascade");
+  g_object_set (h->element, "stages",
+      "a:filter framework=custom-easy model=cascade_double ; "
+      "b:filter framework=custom-easy model=cascade_double in=input ; "
+      "c:filter framework=custom-easy model=cascade_double in=a",
+      "output", "b,c", NULL);
+  _cascade_test_set_caps (h);
+
+  EXPECT_EQ (_cascade_test_push (h, &input), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 2U);
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  for (i = 0; i < 16U; i++)
+    EXPECT_EQ (map.data[i], i * 2);
+  gst_memory_unmap (mem, &map);
+
+  mem = gst_buffer_peek_memory (out_buf, 1);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  for (i = 0; i < 16U; i++)
+    EXPECT_EQ (map.data[i], i * 4);
+  gst_memory_unmap (mem, &map);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("cascade_double");
+  ASSERT_EQ (ret, 0);
+}
+
+/**
+ * @brief Test for tensor_filter_cascade, reference to unknown stage.
+ */
+TEST (testTensorFilterCascade, unknownStage_n)
+{
+  GstHarness *h;
+  GstMemory *input;
+
+  h = gst_harness_new ("tensor_filter_cascade");
+  g_object_set (h->element, "stages",
+      "roi:crop region=1:1:2:2 in=invalid", NULL);
+  _cascade_test_set_caps (h);
+
+  EXPECT_NE (_cascade_test_push (h, &input), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_filter_cascade, crop region out of the tensor.
+ */
+TEST (testTensorFilterCascade, invalidRegion_n)
+{
+  GstHarness *h;
+  GstMemory *input;
+
+  h = gst_harness_new ("tensor_filter_cascade");
+  g_object_set (h->element, "stages", "roi:crop region=3:3:2:2", NULL);
+  _cascade_test_set_caps (h);
+
+  EXPECT_NE (_cascade_test_push (h, &input), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Create a buffer (16 bytes, 0 to 15) for in-place tensor_filter test.
+ */
+static GstBuffer *
+_inplace_test_new_buffer (void)
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+  guint i;
+
+  buf = gst_buffer_new_allocate (NULL, 16U, NULL);
+  if (gst_buffer_map (buf, &map, GST_MAP_WRITE)) {
+    for (i = 0; i < 16U; i++)
+      map.data[i] = i;
+    gst_buffer_unmap (buf, &map);
+  }
+
+  return buf;
+}
+
+/**
+ * @brief In-code function for in-place tensor_filter test (copies the first bytes of the input).
+ */
+static int
+_inplace_test_head (void *, const GstTensorFilterProperties *,
+    const GstTensorMemory *in, GstTensorMemory *out)
+{
+  memmove (out[0].data, in[0].data, MIN (in[0].size, out[0].size));
+  return 0;
+}
+
+/**
+ * @brief Check the output of in-place tensor_filter test (doubles the values).
+ */
+static void
+_inplace_test_check_output (GstBuffer *buf)
+{
+  GstMapInfo map;
+  guint i;
+
+  ASSERT_EQ (gst_buffer_n_memory (buf), 1U);
+  ASSERT_TRUE (gst_buffer_map (buf, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, 16U);
+  for (i = 0; i < 16U; i++)
+    EXPECT_EQ (map.data[i], i * 2);
+  gst_buffer_unmap (buf, &map);
+}
+
+/**
+ * @brief Test for tensor_filter, in-place invoke with writable input buffer.
+ */
+TEST (testTensorFilterInPlace, writableInput)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *input;
+  GstTensorsInfo info;
+  int ret;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1:4:4:1", info.info[0].dimension);
+
+  ret = NNS_custom_easy_register_in_place ("inplace_double",
+      _cascade_test_double, NULL, &info, &info);
+  ASSERT_EQ (ret, 0);
+
+  h = gst_harness_new ("tensor_filter");
+  g_object_set (h->element, "framework", "custom-easy", "model",
+      "inplace_double", NULL);
+  _cascade_test_set_caps (h);
+
+  in_buf = _inplace_test_new_buffer ();
+  input = gst_buffer_peek_memory (in_buf, 0);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_TRUE (gst_base_transform_is_in_place (GST_BASE_TRANSFORM (h->element)));
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  _inplace_test_check_output (out_buf);
+
+  /* the output is written over the input memory */
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0) == input);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("inplace_double");
+  ASSERT_EQ (ret, 0);
+}
+
+/**
+ * @brief Test for tensor_filter, in-place invoke copies the input buffer if it is not writable.
+ */
+TEST (testTensorFilterInPlace, sharedInput)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  GstTensorsInfo info;
+  guint i;
+  int ret;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1:4:4:1", info.info[0].dimension);
+
+  ret = NNS_custom_easy_register_in_place ("inplace_double",
+      _cascade_test_double, NULL, &info, &info);
+  ASSERT_EQ (ret, 0);
+
+  h = gst_harness_new ("tensor_filter");
+  g_object_set (h->element, "framework", "custom-easy", "model",
+      "inplace_double", NULL);
+  _cascade_test_set_caps (h);
+
+  /* keep a reference, the input buffer is not writable */
+  in_buf = _inplace_test_new_buffer ();
+  EXPECT_EQ (gst_harness_push (h, gst_buffer_ref (in_buf)), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  _inplace_test_check_output (out_buf);
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0) != gst_buffer_peek_memory (in_buf, 0));
+
+  /* the input is not changed */
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_READ));
+  for (i = 0; i < 16U; i++)
+    EXPECT_EQ (map.data[i], i);
+  gst_buffer_unmap (in_buf, &map);
+
+  gst_buffer_unref (in_buf);
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("inplace_double");
+  ASSERT_EQ (ret, 0);
+}
+
+/**
+ * @brief Test for tensor_filter, in-place invoke is disabled if the output size is different.
+ */
+TEST (testTensorFilterInPlace, differentSize_n)
+{
+  GstHarness *h;
+  GstTensorsInfo in_info, out_info;
+  int ret;
+
+  gst_tensors_info_init (&in_info);
+  in_info.num_tensors = 1U;
+  in_info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1:4:4:1", in_info.info[0].dimension);
+
+  gst_tensors_info_init (&out_info);
+  out_info.num_tensors = 1U;
+  out_info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1:2:2:1", out_info.info[0].dimension);
+
+  ret = NNS_custom_easy_register_in_place ("inplace_diff",
+      _inplace_test_head, NULL, &in_info, &out_info);
+  ASSERT_EQ (ret, 0);
+
+  h = gst_harness_new ("tensor_filter");
+  g_object_set (h->element, "framework", "custom-easy", "model",
+      "inplace_diff", NULL);
+  _cascade_test_set_caps (h);
+
+  EXPECT_EQ (gst_harness_push (h, _inplace_test_new_buffer ()), GST_FLOW_OK);
+  EXPECT_FALSE (gst_base_transform_is_in_place (GST_BASE_TRANSFORM (h->element)));
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("inplace_diff");
+  ASSERT_EQ (ret, 0);
+}
+
+/**
+ * @brief Test for tensor_filter, in-place invoke is disabled if the model is not registered for in-place.
+ */
+TEST (testTensorFilterInPlace, notAllowed_n)
+{
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstTensorsInfo info;
+  int ret;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1:4:4:1", info.info[0].dimension);
+
+  ret = NNS_custom_easy_register ("not_inplace_double", _cascade_test_double,
+      NULL, &info, &info);
+  ASSERT_EQ (ret, 0);
+
+  h = gst_harness_new ("tensor_filter");
+  g_object_set (h->element, "framework", "custom-easy", "model",
+      "not_inplace_double", NULL);
+  _cascade_test_set_caps (h);
+
+  EXPECT_EQ (gst_harness_push (h, _inplace_test_new_buffer ()), GST_FLOW_OK);
+  EXPECT_FALSE (gst_base_transform_is_in_place (GST_BASE_TRANSFORM (h->element)));
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  _inplace_test_check_output (out_buf);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("not_inplace_double");
+  ASSERT_EQ (ret, 0);
+}
+
+/**
+ * @brief Internal function to run tensor_mux with nearest/interpolate mode.
+ * Base pad gets the frames at 0, 33, 66 and 100 ms, the other pad gets the samples every 10 ms until 70 ms.
+ * The value of each tensor is its timestamp in milliseconds.
+ * @return The number of output buffers.
+ */
+static guint
+_sync_nearest_run (const gchar *mode, const gchar *option, gfloat *out_base, gfloat *out_other, guint max_out)
+{
+  const guint64 base_ts[] = { 0, 33, 66, 100 };
+  gchar *str_pipeline;
+  GstElement *pipeline, *src0, *src1, *sink;
+  GstSample *sample;
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  gfloat value;
+  guint i, received = 0;
+
+  str_pipeline = g_strdup_printf (
+      "appsrc name=src0 format=time caps=other/tensor,dimension=(string)1:1:1:1,type=(string)float32,framerate=(fraction)0/1 ! mux.sink_0 "
+      "appsrc name=src1 format=time caps=other/tensor,dimension=(string)1:1:1:1,type=(string)float32,framerate=(fraction)0/1 ! mux.sink_1 "
+      "tensor_mux name=mux sync-mode=%s sync-option=%s ! appsink name=sink sync=false",
+      mode, option);
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  if (pipeline == NULL)
+    return 0;
+
+  src0 = gst_bin_get_by_name (GST_BIN (pipeline), "src0");
+  src1 = gst_bin_get_by_name (GST_BIN (pipeline), "src1");
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  for (i = 0; i < 8U; i++) {
+    value = (gfloat) (i * 10);
+    buf = gst_buffer_new_wrapped (_g_memdup (&value, sizeof (value)), sizeof (value));
+    GST_BUFFER_PTS (buf) = i * 10 * GST_MSECOND;
+    EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (src1), buf), GST_FLOW_OK);
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (base_ts); i++) {
+    value = (gfloat) base_ts[i];
+    buf = gst_buffer_new_wrapped (_g_memdup (&value, sizeof (value)), sizeof (value));
+    GST_BUFFER_PTS (buf) = base_ts[i] * GST_MSECOND;
+    EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (src0), buf), GST_FLOW_OK);
+  }
+
+  gst_app_src_end_of_stream (GST_APP_SRC (src1));
+  gst_app_src_end_of_stream (GST_APP_SRC (src0));
+
+  /* pulls the output until EOS */
+  while ((sample = gst_app_sink_pull_sample (GST_APP_SINK (sink))) != NULL) {
+    buf = gst_sample_get_buffer (sample);
+
+    if (received < max_out && gst_buffer_n_memory (buf) == 2U) {
+      mem = gst_buffer_peek_memory (buf, 0);
+      if (gst_memory_map (mem, &map, GST_MAP_READ)) {
+        out_base[received] = *((gfloat *) map.data);
+        gst_memory_unmap (mem, &map);
+      }
+
+      mem = gst_buffer_peek_memory (buf, 1);
+      if (gst_memory_map (mem, &map, GST_MAP_READ)) {
+        out_other[received] = *((gfloat *) map.data);
+        gst_memory_unmap (mem, &map);
+      }
+
+      EXPECT_EQ (GST_BUFFER_PTS (buf), (GstClockTime) ((gdouble) out_base[received] * GST_MSECOND));
+    }
+
+    received++;
+    gst_sample_unref (sample);
+  }
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_object_unref (src0);
+  gst_object_unref (src1);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return received;
+}
+
+/**
+ * @brief Test for tensor_mux, nearest mode without tolerance.
+ */
+TEST (testTensorMuxSync, nearest)
+{
+  const gfloat expected_base[] = { 0, 33, 66, 100 };
+  const gfloat expected_other[] = { 0, 30, 70, 70 };
+  gfloat out_base[4], out_other[4];
+  guint i;
+
+  ASSERT_EQ (_sync_nearest_run ("nearest", "0::8", out_base, out_other, 4U), 4U);
+
+  for (i = 0; i < 4U; i++) {
+    EXPECT_FLOAT_EQ (out_base[i], expected_base[i]);
+    EXPECT_FLOAT_EQ (out_other[i], expected_other[i]);
+  }
+}
+
+/**
+ * @brief Test for tensor_mux, nearest mode drops the base buffer out of the tolerance.
+ */
+TEST (testTensorMuxSync, nearestTolerance)
+{
+  const gfloat expected_other[] = { 0, 30, 70 };
+  gfloat out_base[4], out_other[4];
+  guint i;
+
+  /* the nearest one of 100 ms is 70 ms, farther than 20 ms */
+  ASSERT_EQ (_sync_nearest_run ("nearest", "0:20000000:8", out_base, out_other, 4U), 3U);
+
+  for (i = 0; i < 3U; i++)
+    EXPECT_FLOAT_EQ (out_other[i], expected_other[i]);
+}
+
+/**
+ * @brief Test for tensor_mux, interpolate mode.
+ */
+TEST (testTensorMuxSync, interpolate)
+{
+  gfloat out_base[4], out_other[4];
+  guint i;
+
+  ASSERT_EQ (_sync_nearest_run ("interpolate", "0:20000000:8", out_base, out_other, 4U), 3U);
+
+  /* the value is its timestamp, interpolated value is same as base */
+  for (i = 0; i < 3U; i++)
+    EXPECT_NEAR (out_other[i], out_base[i], 0.001);
+}
+
+/**
+ * @brief Test for tensor_mux, small ring blocks the other pad until the base pad catches up.
+ */
+TEST (testTensorMuxSync, interpolateSmallRing)
+{
+  gfloat out_base[4], out_other[4];
+  guint i;
+
+  ASSERT_EQ (_sync_nearest_run ("interpolate", "0::2", out_base, out_other, 4U), 4U);
+
+  for (i = 0; i < 3U; i++)
+    EXPECT_NEAR (out_other[i], out_base[i], 0.001);
+
+  /* no buffer after 70 ms, use the nearest one */
+  EXPECT_FLOAT_EQ (out_other[3], 70);
+}
+
+/**
+ * @brief Test for time sync option, invalid ring size.
+ */
+TEST (testTensorMuxSync, invalidRingSize_n)
+{
+  tensor_time_sync_data sync;
+
+  memset (&sync, 0, sizeof (sync));
+  sync.mode = gst_tensor_time_sync_get_mode ("nearest");
+  EXPECT_EQ (sync.mode, SYNC_NEAREST);
+
+  sync.option = g_strdup ("1:1000:1");
+  EXPECT_TRUE (gst_tensor_time_sync_set_option_data (&sync));
+  EXPECT_EQ (sync.data_nearest.sink_id, 1U);
+  EXPECT_EQ (sync.data_nearest.tolerance, 1000U);
+  /* uses the default ring size */
+  EXPECT_GT (sync.data_nearest.ring_size, 1U);
+  g_free (sync.option);
+
+  sync.option = NULL;
+  EXPECT_TRUE (gst_tensor_time_sync_set_option_data (&sync));
+  EXPECT_EQ (sync.data_nearest.sink_id, 0U);
+  EXPECT_FALSE (GST_CLOCK_TIME_IS_VALID (sync.data_nearest.tolerance));
+}
+
+/**
+ * @brief Internal function to push a uint8 tensor to the appsrc.
+ */
+static void
+_merge_push_tensor (GstElement *pipeline, const gchar *name, const guint8 *data, gsize size)
+{
+  GstElement *src;
+  GstBuffer *buf;
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  ASSERT_TRUE (src != NULL);
+
+  buf = gst_buffer_new_wrapped (_g_memdup (data, size), size);
+  GST_BUFFER_PTS (buf) = 0;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (src), buf), GST_FLOW_OK);
+  gst_object_unref (src);
+}
+
+/**
+ * @brief Internal function to compare the output of tensor_merge.
+ */
+static void
+_merge_check_output (GstElement *pipeline, const guint8 *expected, gsize size)
+{
+  GstElement *sink;
+  GstSample *sample;
+  GstBuffer *buf;
+  GstMapInfo map;
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+
+  sample = gst_app_sink_try_pull_sample (GST_APP_SINK (sink), 5 * GST_SECOND);
+  gst_object_unref (sink);
+  ASSERT_TRUE (sample != NULL);
+
+  buf = gst_sample_get_buffer (sample);
+  EXPECT_EQ (gst_buffer_n_memory (buf), 1U);
+  ASSERT_TRUE (gst_buffer_map (buf, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, size);
+  EXPECT_EQ (memcmp (map.data, expected, size), 0);
+  gst_buffer_unmap (buf, &map);
+
+  gst_sample_unref (sample);
+}
+
+/**
+ * @brief Test for tensor_merge, linear mode with the first axis.
+ */
+TEST (testTensorMerge, linearFirstAxis)
+{
+  const guint8 in0[] = { 0, 1, 2, 3 };
+  const guint8 in1[] = { 10, 11, 12, 13, 14, 15 };
+  const guint8 expected[] = { 0, 1, 10, 11, 12, 2, 3, 13, 14, 15 };
+  GstElement *pipeline;
+  guint i;
+
+  pipeline = gst_parse_launch (
+      "appsrc name=src0 format=time caps=other/tensor,dimension=(string)2:2:1:1,type=(string)uint8,framerate=(fraction)0/1 ! merge.sink_0 "
+      "appsrc name=src1 format=time caps=other/tensor,dimension=(string)3:2:1:1,type=(string)uint8,framerate=(fraction)0/1 ! merge.sink_1 "
+      "tensor_merge name=merge mode=linear option=0 ! appsink name=sink sync=false async=false",
+      NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  /* the output buffer from the pool is reused, check the data of each frame */
+  for (i = 0; i < 3U; i++) {
+    _merge_push_tensor (pipeline, "src0", in0, sizeof (in0));
+    _merge_push_tensor (pipeline, "src1", in1, sizeof (in1));
+    _merge_check_output (pipeline, expected, sizeof (expected));
+  }
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  gst_object_unref (pipeline);
+}
+
+/**
+ * @brief Test for tensor_merge, linear mode with 3 tensors and several blocks.
+ */
+TEST (testTensorMerge, linearMultiTensors)
+{
+  const guint8 in0[] = { 0, 1, 2, 3 };
+  const guint8 in1[] = { 10, 11, 12, 13, 14, 15, 16, 17 };
+  const guint8 in2[] = { 20, 21, 22, 23 };
+  const guint8 expected[] = { 0, 1, 10, 11, 12, 13, 20, 21, 2, 3, 14, 15, 16, 17, 22, 23 };
+  GstElement *pipeline;
+
+  pipeline = gst_parse_launch (
+      "appsrc name=src0 format=time caps=other/tensor,dimension=(string)2:1:2:1,type=(string)uint8,framerate=(fraction)0/1 ! merge.sink_0 "
+      "appsrc name=src1 format=time caps=other/tensor,dimension=(string)2:2:2:1,type=(string)uint8,framerate=(fraction)0/1 ! merge.sink_1 "
+      "appsrc name=src2 format=time caps=other/tensor,dimension=(string)2:1:2:1,type=(string)uint8,framerate=(fraction)0/1 ! merge.sink_2 "
+      "tensor_merge name=merge mode=linear option=1 ! appsink name=sink sync=false async=false",
+      NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  _merge_push_tensor (pipeline, "src0", in0, sizeof (in0));
+  _merge_push_tensor (pipeline, "src1", in1, sizeof (in1));
+  _merge_push_tensor (pipeline, "src2", in2, sizeof (in2));
+  _merge_check_output (pipeline, expected, sizeof (expected));
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  gst_object_unref (pipeline);
+}
+
+/**
+ * @brief Test for tensor_merge, the copy plan and the output buffer are updated when the caps is changed.
+ */
+TEST (testTensorMerge, linearRenegotiation)
+{
+  const guint8 in0[] = { 0, 1, 2, 3 };
+  const guint8 in1[] = { 10, 11, 12, 13 };
+  const guint8 expected[] = { 0, 1, 10, 11, 2, 3, 12, 13 };
+  const guint8 in0_new[] = { 0, 1, 2, 3, 4, 5 };
+  const guint8 in1_new[] = { 10, 11, 12, 13, 14, 15 };
+  const guint8 expected_new[] = { 0, 1, 2, 10, 11, 12, 3, 4, 5, 13, 14, 15 };
+  GstElement *pipeline, *src;
+  GstCaps *caps;
+
+  pipeline = gst_parse_launch (
+      "appsrc name=src0 format=time caps=other/tensor,dimension=(string)2:2:1:1,type=(string)uint8,framerate=(fraction)0/1 ! merge.sink_0 "
+      "appsrc name=src1 format=time caps=other/tensor,dimension=(string)2:2:1:1,type=(string)uint8,framerate=(fraction)0/1 ! merge.sink_1 "
+      "tensor_merge name=merge mode=linear option=0 ! appsink name=sink sync=false async=false",
+      NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  _merge_push_tensor (pipeline, "src0", in0, sizeof (in0));
+  _merge_push_tensor (pipeline, "src1", in1, sizeof (in1));
+  _merge_check_output (pipeline, expected, sizeof (expected));
+
+  /* negotiate again with the larger tensors */
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_READY, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  caps = gst_caps_from_string ("other/tensor,dimension=(string)3:2:1:1,type=(string)uint8,framerate=(fraction)0/1");
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src0");
+  g_object_set (src, "caps", caps, NULL);
+  gst_object_unref (src);
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src1");
+  g_object_set (src, "caps", caps, NULL);
+  gst_object_unref (src);
+  gst_caps_unref (caps);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  _merge_push_tensor (pipeline, "src0", in0_new, sizeof (in0_new));
+  _merge_push_tensor (pipeline, "src1", in1_new, sizeof (in1_new));
+  _merge_check_output (pipeline, expected_new, sizeof (expected_new));
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  gst_object_unref (pipeline);
+}
+
 /**
  * @brief Main function for unit test.
  */
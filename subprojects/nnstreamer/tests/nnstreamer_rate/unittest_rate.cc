@@ -9,6 +9,8 @@
 
 #include <gtest/gtest.h>
 #include <glib.h>
+#include <gst/check/gstharness.h>
+#include <gst/check/gsttestclock.h>
 #include <unittest_util.h>
 
 #include <nnstreamer_plugin_api_filter.h>
@@ -75,6 +77,7 @@ protected:
   const guint64 DEFAULT_OUT = 0;
   const guint64 DEFAULT_DUP = 0;
   const guint64 DEFAULT_DROP = 0;
+  const guint64 DEFAULT_LATENCY_BUDGET = 100 * GST_MSECOND;
 
   /**
    * @brief Construct a new NNSRateTest object
@@ -435,6 +438,166 @@ TEST_F (NNSRateTest, throttling)
   g_free (framework);
 }
 
+/**
+ * @brief Test tensor_rate adaptive properties
+ */
+TEST_F (NNSRateTest, adaptiveProperty)
+{
+  gboolean adaptive;
+  guint64 budget;
+  gdouble adaptive_rate;
+
+  ASSERT_TRUE (setupPipeline());
+
+  GstElement *rate = getRateElem();
+  ASSERT_TRUE (rate != NULL);
+
+  g_object_get (rate, "adaptive", &adaptive, "latency-budget", &budget,
+      "adaptive-rate", &adaptive_rate, NULL);
+  EXPECT_FALSE (adaptive);
+  EXPECT_EQ (budget, DEFAULT_LATENCY_BUDGET);
+  EXPECT_DOUBLE_EQ (adaptive_rate, 0.0);
+
+  g_object_set (rate, "adaptive", (gboolean) TRUE,
+      "latency-budget", (guint64) (30 * GST_MSECOND), NULL);
+  g_object_get (rate, "adaptive", &adaptive, "latency-budget", &budget, NULL);
+  EXPECT_TRUE (adaptive);
+  EXPECT_EQ (budget, (guint64) (30 * GST_MSECOND));
+}
+
+/**
+ * @brief Data to emulate downstream of tensor_rate with the test clock.
+ */
+typedef struct {
+  GstTestClock *clock; /**< the clock of the harness */
+  GstClockTime proc; /**< processing time of downstream */
+} RateDownstreamData;
+
+/**
+ * @brief Pad probe emulating a synchronized sink, waits for the running-time of the buffer and processes it.
+ */
+static GstPadProbeReturn
+_rate_downstream_probe_cb (GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+  RateDownstreamData *data = (RateDownstreamData *) user_data;
+  GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstClockTime now = gst_clock_get_time (GST_CLOCK (data->clock));
+
+  /* the base time is 0 and the segment starts from 0 */
+  if (GST_BUFFER_PTS (buf) > now)
+    now = GST_BUFFER_PTS (buf);
+
+  gst_test_clock_set_time (data->clock, now + data->proc);
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Internal function to push the frames (30 fps) to tensor_rate in adaptive mode.
+ * @param budget The latency budget
+ * @param proc The processing time of downstream
+ * @param early The time to push a frame before its running-time
+ * @param[out] received The number of buffers pushed downstream
+ * @return The harness, caller should tear it down.
+ */
+static GstHarness *
+_rate_adaptive_run (guint64 budget, GstClockTime proc, GstClockTime early, guint *received)
+{
+  const guint num_buffers = 90;
+  GstHarness *h;
+  GstPad *srcpad;
+  GstBuffer *buf;
+  GstClockTime pts, now;
+  RateDownstreamData data;
+  guint i;
+
+  h = gst_harness_new ("tensor_rate");
+  g_object_set (h->element, "adaptive", (gboolean) TRUE, "latency-budget",
+      budget, "throttle", (gboolean) FALSE, NULL);
+
+  gst_harness_use_testclock (h);
+  data.clock = gst_harness_get_testclock (h);
+  data.proc = proc;
+
+  srcpad = gst_element_get_static_pad (h->element, "src");
+  gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BUFFER,
+      _rate_downstream_probe_cb, &data, NULL);
+  gst_object_unref (srcpad);
+
+  gst_harness_set_src_caps_str (h,
+      "other/tensor,dimension=(string)4:1:1:1,type=(string)uint8,framerate=(fraction)30/1");
+
+  for (i = 0; i < num_buffers; i++) {
+    pts = gst_util_uint64_scale (i, GST_SECOND, 30);
+
+    /* upstream produces the frame at the time, or earlier with early */
+    now = gst_clock_get_time (GST_CLOCK (data.clock));
+    if (pts > early && pts - early > now)
+      gst_test_clock_set_time (data.clock, pts - early);
+
+    buf = gst_harness_create_buffer (h, 4);
+    GST_BUFFER_PTS (buf) = pts;
+    GST_BUFFER_DURATION (buf) = gst_util_uint64_scale (1, GST_SECOND, 30);
+    EXPECT_EQ (gst_harness_push (h, buf), GST_FLOW_OK);
+  }
+
+  *received = gst_harness_buffers_received (h);
+  gst_object_unref (data.clock);
+
+  return h;
+}
+
+/**
+ * @brief Test tensor_rate adaptive mode, downstream keeps the latency budget.
+ * The clock wait of the synchronized sink is not the processing time of downstream.
+ */
+TEST_F (NNSRateTest, adaptiveFastDownstream)
+{
+  GstHarness *h;
+  guint64 in, out, drop;
+  gdouble adaptive_rate;
+  guint received;
+
+  /* the sink waits 20ms for each frame, and processes it in 5ms */
+  h = _rate_adaptive_run (20 * GST_MSECOND, 5 * GST_MSECOND, 20 * GST_MSECOND, &received);
+
+  g_object_get (h->element, "in", &in, "out", &out, "drop", &drop,
+      "adaptive-rate", &adaptive_rate, NULL);
+
+  EXPECT_EQ (in, 90U);
+  EXPECT_EQ (out, 90U);
+  EXPECT_EQ (0U, drop);
+  EXPECT_EQ (received, 90U);
+  EXPECT_DOUBLE_EQ (adaptive_rate, 30.0);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test tensor_rate adaptive mode, drop frames with slow downstream.
+ */
+TEST_F (NNSRateTest, adaptiveSlowDownstream)
+{
+  GstHarness *h;
+  guint64 in, out, drop;
+  gdouble adaptive_rate;
+  guint received;
+
+  /* 50ms, slower than 30 fps */
+  h = _rate_adaptive_run (80 * GST_MSECOND, 50 * GST_MSECOND, 0, &received);
+
+  g_object_get (h->element, "in", &in, "out", &out, "drop", &drop,
+      "adaptive-rate", &adaptive_rate, NULL);
+
+  EXPECT_EQ (in, 90U);
+  EXPECT_EQ (in, out + drop);
+  EXPECT_EQ (out, (guint64) received);
+  EXPECT_GT (drop, 0U);
+  EXPECT_LT (adaptive_rate, 30.0);
+  EXPECT_GE (adaptive_rate, 1.0);
+
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief gtest main
  */
@@ -9,12 +9,21 @@
 
 #include <gtest/gtest.h>
 #include <glib/gstdio.h>
+#include <gst/app/gstappsink.h>
 #include <gst/app/gstappsrc.h>
+#include <gst/check/gstharness.h>
+#include <gst/check/gsttestclock.h>
 #include <gst/gst.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #include <nnstreamer_conf.h>
+#include <tensor_sink_api.h>
 #include <unittest_util.h>
 #include "nnstreamer_plugin_api_filter.h"
 #include "tensor_common.h"
@@ -1392,6 +1401,181 @@ TEST (tensorSinkTest, signalRate)
   _free_test_data (option);
 }
 
+static guint test_sink_cb_received = 0;
+static gboolean test_sink_cb_started = FALSE;
+static gboolean test_sink_cb_eos = FALSE;
+
+/**
+ * @brief Callback for new data of tensor sink.
+ */
+static void
+_test_sink_new_data (GstTensorSink *sink, GstBuffer *buffer, gpointer user_data)
+{
+  test_sink_cb_received++;
+  EXPECT_TRUE (GST_IS_TENSOR_SINK (sink));
+  EXPECT_TRUE (GST_IS_BUFFER (buffer));
+  EXPECT_EQ (GPOINTER_TO_UINT (user_data), 1234U);
+}
+
+/**
+ * @brief Callback for stream start of tensor sink.
+ */
+static void
+_test_sink_stream_start (GstTensorSink *, gpointer)
+{
+  test_sink_cb_started = TRUE;
+}
+
+/**
+ * @brief Callback for eos of tensor sink.
+ */
+static void
+_test_sink_eos (GstTensorSink *, gpointer)
+{
+  test_sink_cb_eos = TRUE;
+}
+
+/**
+ * @brief Test for tensor sink callbacks (no signal).
+ */
+TEST (tensorSinkTest, callbacks)
+{
+  const guint num_buffers = 5;
+  GstTensorSinkCallbacks callbacks = { 0 };
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  callbacks.new_data = _test_sink_new_data;
+  callbacks.stream_start = _test_sink_stream_start;
+  callbacks.eos = _test_sink_eos;
+  gst_tensor_sink_set_callbacks (GST_TENSOR_SINK (g_test_data.sink),
+      &callbacks, GUINT_TO_POINTER (1234U), NULL);
+
+  test_sink_cb_received = 0;
+  test_sink_cb_started = test_sink_cb_eos = FALSE;
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+  g_usleep (jitter);
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** the callbacks are called instead of the signals */
+  EXPECT_EQ (test_sink_cb_received, num_buffers);
+  EXPECT_TRUE (test_sink_cb_started);
+  EXPECT_TRUE (test_sink_cb_eos);
+  EXPECT_EQ (g_test_data.received, 0U);
+
+  gst_tensor_sink_set_callbacks (GST_TENSOR_SINK (g_test_data.sink), NULL, NULL, NULL);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink ring with the policy to drop the oldest buffer.
+ */
+TEST (tensorSinkTest, ringDropOldest)
+{
+  const guint num_buffers = 10;
+  GstBuffer *buffers[16];
+  guint64 dropped;
+  guint i, n;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  g_object_set (g_test_data.sink, "max-buffers", 4U, "emit-signal", FALSE, NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+  g_usleep (jitter);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** the last 4 buffers remain */
+  n = gst_tensor_sink_try_pull_many (GST_TENSOR_SINK (g_test_data.sink), buffers, 16, 0);
+  EXPECT_EQ (n, 4U);
+  for (i = 0; i < n; i++) {
+    EXPECT_EQ (GST_BUFFER_PTS (buffers[i]),
+        gst_util_uint64_scale (num_buffers - n + i, GST_SECOND, fps));
+    gst_buffer_unref (buffers[i]);
+  }
+
+  g_object_get (g_test_data.sink, "dropped", &dropped, NULL);
+  EXPECT_EQ (dropped, (guint64) (num_buffers - 4));
+
+  /** eos, no more buffer without waiting */
+  EXPECT_TRUE (gst_tensor_sink_pull (GST_TENSOR_SINK (g_test_data.sink)) == NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink ring with the policy to drop the new buffer.
+ */
+TEST (tensorSinkTest, ringDropNewest)
+{
+  const guint num_buffers = 10;
+  GstBuffer *buffer;
+  guint64 dropped;
+  guint i;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_util_set_object_arg (G_OBJECT (g_test_data.sink), "drop-policy", "drop-newest");
+  g_object_set (g_test_data.sink, "max-buffers", 3U, "emit-signal", FALSE, NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+  g_usleep (jitter);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** the ring size is rounded up to 4, the first 4 buffers remain */
+  for (i = 0; i < 4U; i++) {
+    buffer = gst_tensor_sink_try_pull (GST_TENSOR_SINK (g_test_data.sink), 10 * GST_MSECOND);
+    ASSERT_TRUE (buffer != NULL);
+    EXPECT_EQ (GST_BUFFER_PTS (buffer), gst_util_uint64_scale (i, GST_SECOND, fps));
+    gst_buffer_unref (buffer);
+  }
+
+  EXPECT_TRUE (gst_tensor_sink_try_pull (GST_TENSOR_SINK (g_test_data.sink), 10 * GST_MSECOND) == NULL);
+
+  g_object_get (g_test_data.sink, "dropped", &dropped, NULL);
+  EXPECT_EQ (dropped, (guint64) (num_buffers - 4));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink pull without the ring.
+ */
+TEST (tensorSinkTest, ringDisabled_n)
+{
+  GstElement *sink;
+  GstBuffer *buffers[2];
+  guint max_buffers;
+
+  sink = gst_element_factory_make ("tensor_sink", NULL);
+  ASSERT_TRUE (sink != NULL);
+
+  g_object_get (sink, "max-buffers", &max_buffers, NULL);
+  EXPECT_EQ (max_buffers, 0U);
+
+  /** no ring, returns without waiting */
+  EXPECT_TRUE (gst_tensor_sink_pull (GST_TENSOR_SINK (sink)) == NULL);
+  EXPECT_EQ (gst_tensor_sink_try_pull_many (GST_TENSOR_SINK (sink), buffers, 2, GST_SECOND), 0U);
+
+  gst_object_unref (sink);
+}
+
 /**
  * @brief Test for caps negotiation failed.
  */
@@ -1639,6 +1823,120 @@ TEST (tensorStreamTest, muxRefreshMode)
   EXPECT_EQ (g_test_data.tensors_config.rate_d, 1);
 }
 
+/**
+ * @brief Push a tensor (10 bytes filled with value) to given appsrc.
+ */
+static void
+_push_deadline_buffer (GstElement *pipeline, const gchar *name, guint8 value, GstClockTime pts)
+{
+  GstElement *src;
+  GstBuffer *buf;
+  GstMapInfo map;
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  ASSERT_TRUE (src != NULL);
+
+  buf = gst_buffer_new_allocate (NULL, 10, NULL);
+  ASSERT_TRUE (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  memset (map.data, value, map.size);
+  gst_buffer_unmap (buf, &map);
+  GST_BUFFER_PTS (buf) = pts;
+
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (src), buf), GST_FLOW_OK);
+  gst_object_unref (src);
+}
+
+/**
+ * @brief Check the values of 2 tensors in the sample from tensor_mux (deadline mode).
+ */
+static void
+_check_deadline_sample (GstSample *sample, guint8 value0, guint8 value1)
+{
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint8 expected[2] = { value0, value1 };
+  guint i;
+
+  ASSERT_TRUE (sample != NULL);
+  buf = gst_sample_get_buffer (sample);
+  ASSERT_TRUE (buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (buf), 2U);
+
+  for (i = 0; i < 2; i++) {
+    mem = gst_buffer_peek_memory (buf, i);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    EXPECT_EQ (map.size, 10U);
+    EXPECT_EQ (map.data[0], expected[i]);
+    EXPECT_EQ (map.data[map.size - 1], expected[i]);
+    gst_memory_unmap (mem, &map);
+  }
+
+  gst_sample_unref (sample);
+}
+
+/**
+ * @brief Test for other/tensors with tensor_mux (deadline mode).
+ * The deadline is driven by the test clock, the buffer from the slow pad is reused when the deadline is reached.
+ */
+TEST (tensorStreamTest, muxDeadlineMode)
+{
+  GstElement *pipeline, *sink;
+  GstClock *clock;
+  GstClockID pending_id;
+  GstSample *sample;
+  gchar *str_pipeline;
+
+  str_pipeline = g_strdup (
+      "tensor_mux name=mux sync-mode=deadline sync-option=30000000 ! appsink name=sink sync=false "
+      "appsrc name=src0 format=time ! other/tensor,type=(string)uint8,dimension=(string)10:1:1:1,framerate=(fraction)0/1 ! mux.sink_0 "
+      "appsrc name=src1 format=time ! other/tensor,type=(string)uint8,dimension=(string)10:1:1:1,framerate=(fraction)0/1 ! mux.sink_1");
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  ASSERT_TRUE (pipeline != NULL);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+
+  clock = gst_test_clock_new ();
+  gst_pipeline_use_clock (GST_PIPELINE (pipeline), clock);
+
+  EXPECT_NE (gst_element_set_state (pipeline, GST_STATE_PLAYING), GST_STATE_CHANGE_FAILURE);
+
+  /** both pads receive new data, output buffers without the deadline */
+  _push_deadline_buffer (pipeline, "src0", 1, 0);
+  _push_deadline_buffer (pipeline, "src1", 11, 0);
+  _check_deadline_sample (gst_app_sink_try_pull_sample (GST_APP_SINK (sink), 5 * GST_SECOND), 1, 11);
+
+  /** the pipeline clock is distributed in playing state */
+  EXPECT_EQ (gst_element_get_state (pipeline, NULL, NULL, 5 * GST_SECOND), GST_STATE_CHANGE_SUCCESS);
+
+  /** sink_1 does not receive new data, wait for the deadline */
+  _push_deadline_buffer (pipeline, "src0", 2, 10 * GST_MSECOND);
+  gst_test_clock_wait_for_next_pending_id (GST_TEST_CLOCK (clock), &pending_id);
+  EXPECT_TRUE (gst_app_sink_try_pull_sample (GST_APP_SINK (sink), 50 * GST_MSECOND) == NULL);
+
+  /** the deadline is reached, output buffers with the previous data of sink_1 */
+  gst_test_clock_set_time (GST_TEST_CLOCK (clock), gst_clock_id_get_time (pending_id));
+  gst_clock_id_unref (pending_id);
+  _check_deadline_sample (gst_app_sink_try_pull_sample (GST_APP_SINK (sink), 5 * GST_SECOND), 2, 11);
+
+  /** both pads receive new data before the deadline */
+  _push_deadline_buffer (pipeline, "src0", 3, 20 * GST_MSECOND);
+  gst_test_clock_wait_for_next_pending_id (GST_TEST_CLOCK (clock), NULL);
+  _push_deadline_buffer (pipeline, "src1", 12, 20 * GST_MSECOND);
+  _check_deadline_sample (gst_app_sink_try_pull_sample (GST_APP_SINK (sink), 5 * GST_SECOND), 3, 12);
+
+  /** the deadline is canceled, nothing is pushed with the old data */
+  EXPECT_TRUE (gst_app_sink_try_pull_sample (GST_APP_SINK (sink), 50 * GST_MSECOND) == NULL);
+
+  EXPECT_EQ (gst_element_set_state (pipeline, GST_STATE_NULL), GST_STATE_CHANGE_SUCCESS);
+
+  gst_object_unref (sink);
+  gst_object_unref (clock);
+  gst_object_unref (pipeline);
+}
+
 /**
  * @brief Test for flexible tensors with tensor_mux (nego failure).
  */
@@ -3701,6 +3999,62 @@ TEST (tensorStreamTest, filterProperties1)
   _free_test_data (option);
 }
 
+/**
+ * @brief Test for the latency histograms of tensor filter.
+ */
+TEST (tensorStreamTest, filterLatencyStats)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  GstStructure *stats = NULL;
+  guint64 count;
+  gint64 p50, p95, p99, max_latency;
+  guint report;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  /* default report interval is 0 (off) */
+  g_object_get (filter, "latency-report", &report, NULL);
+  EXPECT_EQ (report, 0U);
+
+  g_object_set (filter, "latency", 1, "latency-report", 10U, NULL);
+  g_object_get (filter, "latency-report", &report, NULL);
+  EXPECT_EQ (report, 10U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  g_object_get (filter, "latency-stats", &stats, NULL);
+  ASSERT_TRUE (stats != NULL);
+  EXPECT_TRUE (gst_structure_has_name (stats, "tensor-filter-latency"));
+
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "invoke-count", &count));
+  EXPECT_EQ (count, num_buffers);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "pre-count", &count));
+  EXPECT_EQ (count, num_buffers);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "post-count", &count));
+  EXPECT_EQ (count, num_buffers);
+
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "invoke-p50", &p50));
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "invoke-p95", &p95));
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "invoke-p99", &p99));
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "invoke-max", &max_latency));
+  EXPECT_GE (p50, 0);
+  EXPECT_LE (p50, p95);
+  EXPECT_LE (p95, p99);
+  EXPECT_LE (p99, max_latency);
+
+  gst_structure_free (stats);
+  gst_object_unref (filter);
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
 /**
  * @brief Test for tensor filter properties.
  */
@@ -4272,6 +4626,376 @@ TEST (tensorStreamTest, subpluginV0CheckFW_n)
   g_free (fw);
 }
 
+static guint test_custom_invoked = 0;
+
+/**
+ * @brief The invoke callback counting the number of invokes.
+ */
+static int
+test_custom_v0_invoke_count (const GstTensorFilterProperties *prop,
+    void **private_data, const GstTensorMemory *input, GstTensorMemory *output)
+{
+  test_custom_invoked++;
+  return test_custom_v0_invoke (prop, private_data, input, output);
+}
+
+/**
+ * @brief Test for the warm-up invokes of tensor filter.
+ */
+TEST (tensorStreamTest, subpluginV0Warmup)
+{
+  const guint num_buffers = 5;
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstElement *pipeline, *filter;
+  GstMessage *msg;
+  guint warmup;
+  gchar *str_pipeline;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V0;
+  fw->name = (char *) test_fw_custom_name;
+  fw->run_without_model = TRUE;
+  fw->invoke_NN = test_custom_v0_invoke_count;
+  fw->setInputDimension = test_custom_v0_setdim;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=%u ! videoconvert ! video/x-raw,width=160,height=120,format=RGB ! "
+      "tensor_converter ! tensor_filter name=test_filter framework=%s warmup=3 ! fakesink",
+      num_buffers, test_fw_custom_name);
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  ASSERT_TRUE (pipeline != NULL);
+
+  filter = gst_bin_get_by_name (GST_BIN (pipeline), "test_filter");
+  g_object_get (filter, "warmup", &warmup, NULL);
+  EXPECT_EQ (warmup, 3U);
+
+  test_custom_invoked = 0;
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      5 * GST_SECOND, (GstMessageType) (GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  ASSERT_TRUE (msg != NULL);
+  EXPECT_EQ (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  /* the dummy invokes and the invokes for the buffers */
+  EXPECT_EQ (test_custom_invoked, num_buffers + warmup);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  gst_object_unref (filter);
+  gst_object_unref (pipeline);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+static gint test_custom_num_threads = 0;
+static gboolean test_custom_pinned = FALSE;
+static gint test_custom_cpus_after_invoke = 0;
+
+/**
+ * @brief The invoke callback checking the number of threads and the cpu affinity.
+ */
+static int
+test_custom_v0_invoke_affinity (const GstTensorFilterProperties *prop,
+    void **private_data, const GstTensorMemory *input, GstTensorMemory *output)
+{
+#if defined(__linux__)
+  cpu_set_t set;
+
+  CPU_ZERO (&set);
+  if (sched_getaffinity (0, sizeof (set), &set) == 0)
+    test_custom_pinned = (CPU_COUNT (&set) == 1 && CPU_ISSET (0, &set));
+#else
+  test_custom_pinned = TRUE;
+#endif
+
+  test_custom_num_threads = prop->num_threads;
+  return test_custom_v0_invoke (prop, private_data, input, output);
+}
+
+/**
+ * @brief The probe callback to get the number of cpus of the streaming thread after invoke.
+ */
+static GstPadProbeReturn
+test_custom_affinity_probe_cb (GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+#if defined(__linux__)
+  cpu_set_t set;
+
+  CPU_ZERO (&set);
+  if (sched_getaffinity (0, sizeof (set), &set) == 0)
+    test_custom_cpus_after_invoke = CPU_COUNT (&set);
+#endif
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Test for the number of threads and the cpu affinity of tensor filter.
+ */
+TEST (tensorStreamTest, subpluginV0Affinity)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstElement *pipeline, *filter;
+  GstMessage *msg;
+  GstPad *srcpad;
+  guint num_threads;
+  gint numa_node;
+  gchar *str_pipeline, *cpus;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V0;
+  fw->name = (char *) test_fw_custom_name;
+  fw->run_without_model = TRUE;
+  fw->invoke_NN = test_custom_v0_invoke_affinity;
+  fw->setInputDimension = test_custom_v0_setdim;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=3 ! videoconvert ! video/x-raw,width=160,height=120,format=RGB ! "
+      "tensor_converter ! queue ! tensor_filter name=test_filter framework=%s num-threads=2 cpu-affinity=0 ! fakesink",
+      test_fw_custom_name);
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  ASSERT_TRUE (pipeline != NULL);
+
+  filter = gst_bin_get_by_name (GST_BIN (pipeline), "test_filter");
+  g_object_get (filter, "num-threads", &num_threads, "cpu-affinity", &cpus,
+      "numa-node", &numa_node, NULL);
+  EXPECT_EQ (num_threads, 2U);
+  EXPECT_STREQ (cpus, "0");
+  EXPECT_EQ (numa_node, -1);
+  g_free (cpus);
+
+  /* the streaming thread of queue is pinned once, it stays pinned between invokes */
+  srcpad = gst_element_get_static_pad (filter, "src");
+  gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BUFFER,
+      test_custom_affinity_probe_cb, NULL, NULL);
+  gst_object_unref (srcpad);
+
+  test_custom_num_threads = 0;
+  test_custom_pinned = FALSE;
+  test_custom_cpus_after_invoke = 0;
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      5 * GST_SECOND, (GstMessageType) (GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  ASSERT_TRUE (msg != NULL);
+  EXPECT_EQ (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  EXPECT_EQ (test_custom_num_threads, 2);
+  EXPECT_TRUE (test_custom_pinned);
+#if defined(__linux__)
+  EXPECT_EQ (test_custom_cpus_after_invoke, 1);
+#endif
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  gst_object_unref (filter);
+  gst_object_unref (pipeline);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the cpu affinity of the streaming thread restored after the framework is closed.
+ */
+TEST (tensorStreamTest, subpluginV0AffinityRestore)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstBuffer *buf;
+  gint num_cpus = 0, cpus_after_close = 0;
+  guint i;
+#if defined(__linux__)
+  cpu_set_t set;
+
+  CPU_ZERO (&set);
+  if (sched_getaffinity (0, sizeof (set), &set) == 0)
+    num_cpus = CPU_COUNT (&set);
+#endif
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V0;
+  fw->name = (char *) test_fw_custom_name;
+  fw->run_without_model = TRUE;
+  fw->invoke_NN = test_custom_v0_invoke_affinity;
+  fw->setInputDimension = test_custom_v0_setdim;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  h = gst_harness_new ("tensor_filter");
+  g_object_set (h->element, "framework", test_fw_custom_name, "cpu-affinity", "0", NULL);
+  gst_harness_set_src_caps_str (h,
+      "other/tensor,dimension=(string)4:1:1:1,type=(string)uint8,framerate=(fraction)0/1");
+
+  /* the buffers are pushed and invoked in this thread */
+  test_custom_pinned = FALSE;
+  for (i = 0; i < 3; i++) {
+    buf = gst_harness_create_buffer (h, 4);
+    EXPECT_EQ (gst_harness_push (h, buf), GST_FLOW_OK);
+  }
+  EXPECT_EQ (gst_harness_buffers_received (h), 3U);
+  EXPECT_TRUE (test_custom_pinned);
+
+  /* stop closes the framework and gives the affinity back */
+  gst_harness_teardown (h);
+
+#if defined(__linux__)
+  CPU_ZERO (&set);
+  if (sched_getaffinity (0, sizeof (set), &set) == 0)
+    cpus_after_close = CPU_COUNT (&set);
+#endif
+  EXPECT_EQ (cpus_after_close, num_cpus);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the cpu affinity of tensor filter with invalid cpu list.
+ */
+TEST (tensorStreamTest, subpluginAffinityInvalid_n)
+{
+  GstElement *filter;
+  gchar *cpus;
+
+  filter = gst_element_factory_make ("tensor_filter", NULL);
+  ASSERT_TRUE (filter != NULL);
+
+  g_object_set (filter, "cpu-affinity", "0-3,8", NULL);
+  g_object_get (filter, "cpu-affinity", &cpus, NULL);
+  EXPECT_STREQ (cpus, "0-3,8");
+  g_free (cpus);
+
+  /* invalid lists are ignored */
+  g_object_set (filter, "cpu-affinity", "3-1", NULL);
+  g_object_set (filter, "cpu-affinity", "a,b", NULL);
+  g_object_set (filter, "cpu-affinity", "1-", NULL);
+  g_object_get (filter, "cpu-affinity", &cpus, NULL);
+  EXPECT_STREQ (cpus, "0-3,8");
+  g_free (cpus);
+
+  gst_object_unref (filter);
+}
+
+/**
+ * @brief Test for the artifact cache of tensor filter.
+ */
+TEST (tensorStreamTest, filterCacheStoreLoad)
+{
+  GstTensorFilterProperties prop;
+  const gchar artifact[] = "compiled-model-artifact";
+  const gchar *model_files[1];
+  gchar *cache_dir, *model, *path, *path_gpu;
+  struct timespec times[2];
+  const void *data = NULL;
+  size_t size = 0;
+  void *handle;
+
+  cache_dir = g_dir_make_tmp ("nns-filter-cache-XXXXXX", NULL);
+  ASSERT_TRUE (cache_dir != NULL);
+  g_setenv ("NNSTREAMER_filter_cache_dir", cache_dir, TRUE);
+
+  model = g_build_filename (cache_dir, "model.bin", NULL);
+  ASSERT_TRUE (g_file_set_contents (model, "model", -1, NULL));
+  model_files[0] = model;
+
+  memset (&prop, 0, sizeof (prop));
+  prop.fwname = "custom";
+  prop.model_files = model_files;
+  prop.num_models = 1;
+  prop.accl_str = "cpu";
+
+  /* nothing is cached yet */
+  EXPECT_TRUE (nnstreamer_filter_cache_load (&prop, "test", &data, &size) == NULL);
+
+  EXPECT_EQ (nnstreamer_filter_cache_store (&prop, "test", artifact, sizeof (artifact)), 0);
+  path = nnstreamer_filter_cache_get_path (&prop, "test");
+  ASSERT_TRUE (path != NULL);
+  EXPECT_TRUE (g_str_has_prefix (path, cache_dir));
+  EXPECT_TRUE (g_file_test (path, G_FILE_TEST_IS_REGULAR));
+
+  handle = nnstreamer_filter_cache_load (&prop, "test", &data, &size);
+  ASSERT_TRUE (handle != NULL);
+  EXPECT_EQ (size, sizeof (artifact));
+  EXPECT_EQ (memcmp (data, artifact, size), 0);
+  nnstreamer_filter_cache_release (handle);
+
+  /* another tag or accelerator is another artifact */
+  EXPECT_TRUE (nnstreamer_filter_cache_load (&prop, "other", &data, &size) == NULL);
+  prop.accl_str = "gpu";
+  path_gpu = nnstreamer_filter_cache_get_path (&prop, "test");
+  EXPECT_STRNE (path, path_gpu);
+  EXPECT_TRUE (nnstreamer_filter_cache_load (&prop, "test", &data, &size) == NULL);
+  prop.accl_str = "cpu";
+
+  /* the artifact of the updated model should not be used */
+  ASSERT_TRUE (g_file_set_contents (model, "updated-model", -1, NULL));
+  EXPECT_TRUE (nnstreamer_filter_cache_load (&prop, "test", &data, &size) == NULL);
+  g_remove (path);
+  g_free (path);
+
+  /* the model rewritten with the same size within a second */
+  times[0].tv_sec = times[1].tv_sec = 1000000000;
+  times[0].tv_nsec = times[1].tv_nsec = 100;
+  ASSERT_EQ (utimensat (AT_FDCWD, model, times, 0), 0);
+  EXPECT_EQ (nnstreamer_filter_cache_store (&prop, "test", artifact, sizeof (artifact)), 0);
+  path = nnstreamer_filter_cache_get_path (&prop, "test");
+  ASSERT_TRUE (path != NULL);
+
+  ASSERT_TRUE (g_file_set_contents (model, "updated-modem", -1, NULL));
+  times[0].tv_nsec = times[1].tv_nsec = 200;
+  ASSERT_EQ (utimensat (AT_FDCWD, model, times, 0), 0);
+  EXPECT_TRUE (nnstreamer_filter_cache_load (&prop, "test", &data, &size) == NULL);
+
+  g_remove (path);
+  g_remove (model);
+  g_rmdir (cache_dir);
+  g_unsetenv ("NNSTREAMER_filter_cache_dir");
+  g_free (path_gpu);
+  g_free (path);
+  g_free (model);
+  g_free (cache_dir);
+}
+
+/**
+ * @brief Test for the artifact cache of tensor filter with invalid param.
+ */
+TEST (tensorStreamTest, filterCacheInvalidParam_n)
+{
+  GstTensorFilterProperties prop;
+  const void *data = NULL;
+  size_t size = 0;
+  const gchar *model_files[1] = { "/not/existing/model.bin" };
+
+  memset (&prop, 0, sizeof (prop));
+  EXPECT_TRUE (nnstreamer_filter_cache_get_path (NULL, "test") == NULL);
+  EXPECT_TRUE (nnstreamer_filter_cache_get_path (&prop, "test") == NULL);
+  EXPECT_TRUE (nnstreamer_filter_cache_load (&prop, "test", NULL, &size) == NULL);
+  EXPECT_NE (nnstreamer_filter_cache_store (&prop, "test", NULL, 0), 0);
+
+  /* the model file should exist */
+  prop.fwname = "custom";
+  prop.model_files = model_files;
+  prop.num_models = 1;
+  EXPECT_TRUE (nnstreamer_filter_cache_get_path (&prop, "test") == NULL);
+  EXPECT_TRUE (nnstreamer_filter_cache_load (&prop, "test", &data, &size) == NULL);
+  EXPECT_NE (nnstreamer_filter_cache_store (&prop, "test", "data", 4U), 0);
+}
+
 /**
  * @brief Test for hw availability on various filter subplugins.
  */
@@ -0,0 +1,343 @@
+/**
+ * @file	unittest_src_synthetic.cc
+ * @date	18 Oct 2026
+ * @brief	Unit test for tensor_src_synthetic
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs.
+ */
+#include <gtest/gtest.h>
+#include <gst/check/gstharness.h>
+#include <gst/gst.h>
+#include <tensor_common.h>
+#include <tensor_source/tensor_src_synthetic.h>
+#include <unittest_util.h>
+
+/**
+ * @brief element name to be tested
+ */
+#define ELEMENT_NAME "tensor_src_synthetic"
+
+/**
+ * @brief Test for default properties of tensor_src_synthetic.
+ */
+TEST (tensorSrcSynthetic, properties)
+{
+  GstElement *src;
+  gchar *str;
+  guint uval;
+  gboolean bval;
+  gint num, den;
+
+  src = gst_element_factory_make (ELEMENT_NAME, NULL);
+  ASSERT_TRUE (src != NULL);
+
+  g_object_get (src, "format", &str, NULL);
+  EXPECT_STREQ (str, "static");
+  g_free (str);
+
+  g_object_get (src, "dimension", &str, NULL);
+  EXPECT_STREQ (str, "1:1:1:1");
+  g_free (str);
+
+  g_object_get (src, "type", &str, NULL);
+  EXPECT_STREQ (str, "uint8");
+  g_free (str);
+
+  g_object_get (src, "pool-size", &uval, NULL);
+  EXPECT_EQ (uval, 4U);
+
+  g_object_get (src, "is-live", &bval, NULL);
+  EXPECT_FALSE (bval);
+
+  g_object_get (src, "send-time", &bval, NULL);
+  EXPECT_TRUE (bval);
+
+  g_object_set (src, "format", "sparse", "framerate", 30, 1, NULL);
+  g_object_get (src, "format", &str, "framerate", &num, &den, NULL);
+  EXPECT_STREQ (str, "sparse");
+  EXPECT_EQ (num, 30);
+  EXPECT_EQ (den, 1);
+  g_free (str);
+
+  /* invalid format is ignored */
+  g_object_set (src, "format", "invalid", NULL);
+  g_object_get (src, "format", &str, NULL);
+  EXPECT_STREQ (str, "sparse");
+  g_free (str);
+
+  gst_object_unref (src);
+}
+
+/**
+ * @brief Test for static tensors with counter pattern, the buffers share the memories of the pool.
+ */
+TEST (tensorSrcSynthetic, staticCounter)
+{
+  GstHarness *h;
+  GstBuffer *buf[3];
+  GstMemory *mem;
+  GstMapInfo map;
+  GstCaps *caps;
+  GstTensorsConfig config;
+  guint i, j;
+
+  h = gst_harness_new (ELEMENT_NAME);
+  ASSERT_TRUE (h != NULL);
+
+  g_object_set (h->element, "num-buffers", 3, "dimension", "4:1:1:1",
+      "type", "uint8", "pool-size", 2, NULL);
+  gst_harness_play (h);
+
+  for (i = 0; i < 3; i++) {
+    buf[i] = gst_harness_pull (h);
+    ASSERT_TRUE (buf[i] != NULL);
+    EXPECT_EQ (gst_buffer_n_memory (buf[i]), 1U);
+    EXPECT_EQ (gst_buffer_get_size (buf[i]), 4U);
+    EXPECT_EQ (GST_BUFFER_OFFSET (buf[i]), i);
+    EXPECT_TRUE (GST_BUFFER_PTS_IS_VALID (buf[i]));
+
+    mem = gst_buffer_peek_memory (buf[i], 0);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    for (j = 0; j < 4; j++)
+      EXPECT_EQ (map.data[j], (i % 2) + j);
+    gst_memory_unmap (mem, &map);
+
+#if GST_CHECK_VERSION(1, 14, 0)
+    {
+      GstCaps *ts_caps = gst_caps_from_string (GST_TENSOR_SRC_SYNTHETIC_SEND_TIME_CAPS);
+      EXPECT_TRUE (gst_buffer_get_reference_timestamp_meta (buf[i], ts_caps) != NULL);
+      gst_caps_unref (ts_caps);
+    }
+#endif
+  }
+
+  /* the 3rd buffer shares the memory of the 1st slot */
+  EXPECT_EQ (gst_buffer_peek_memory (buf[0], 0), gst_buffer_peek_memory (buf[2], 0));
+  EXPECT_NE (gst_buffer_peek_memory (buf[0], 0), gst_buffer_peek_memory (buf[1], 0));
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  ASSERT_TRUE (caps != NULL);
+  EXPECT_TRUE (gst_tensors_config_from_structure (
+      &config, gst_caps_get_structure (caps, 0)));
+  EXPECT_EQ (config.format, _NNS_TENSOR_FORMAT_STATIC);
+  EXPECT_EQ (config.info.num_tensors, 1U);
+  EXPECT_EQ (config.info.info[0].type, _NNS_UINT8);
+  EXPECT_EQ (config.info.info[0].dimension[0], 4U);
+  gst_tensors_config_free (&config);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < 3; i++)
+    gst_buffer_unref (buf[i]);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for multi tensors with the framerate.
+ */
+TEST (tensorSrcSynthetic, multiTensorsFramerate)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint i;
+
+  h = gst_harness_new (ELEMENT_NAME);
+  ASSERT_TRUE (h != NULL);
+
+  g_object_set (h->element, "num-buffers", 3, "dimension", "2:1:1:1,3:1:1:1",
+      "type", "float32,int16", "framerate", 10, 1, "pattern", 0 /* zero */,
+      "send-time", FALSE, NULL);
+  gst_harness_play (h);
+
+  for (i = 0; i < 3; i++) {
+    buf = gst_harness_pull (h);
+    ASSERT_TRUE (buf != NULL);
+    EXPECT_EQ (gst_buffer_n_memory (buf), 2U);
+    EXPECT_EQ (gst_buffer_get_size (buf), 2 * sizeof (float) + 3 * sizeof (int16_t));
+    EXPECT_EQ (GST_BUFFER_PTS (buf), i * GST_SECOND / 10);
+    EXPECT_EQ (GST_BUFFER_DURATION (buf), GST_SECOND / 10);
+
+    mem = gst_buffer_peek_memory (buf, 1);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    EXPECT_EQ (((int16_t *) map.data)[0], 0);
+    EXPECT_EQ (((int16_t *) map.data)[2], 0);
+    gst_memory_unmap (mem, &map);
+
+#if GST_CHECK_VERSION(1, 14, 0)
+    {
+      GstCaps *ts_caps = gst_caps_from_string (GST_TENSOR_SRC_SYNTHETIC_SEND_TIME_CAPS);
+      EXPECT_TRUE (gst_buffer_get_reference_timestamp_meta (buf, ts_caps) == NULL);
+      gst_caps_unref (ts_caps);
+    }
+#endif
+
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for flexible tensors.
+ */
+TEST (tensorSrcSynthetic, flexible)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+  GstCaps *caps;
+  GstTensorMetaInfo meta;
+  GstStructure *s;
+
+  h = gst_harness_new (ELEMENT_NAME);
+  ASSERT_TRUE (h != NULL);
+
+  g_object_set (h->element, "num-buffers", 1, "format", "flexible", "dimension", "3:4:1:1",
+      "type", "float32", NULL);
+  gst_harness_play (h);
+
+  buf = gst_harness_pull (h);
+  ASSERT_TRUE (buf != NULL);
+  EXPECT_EQ (gst_buffer_n_memory (buf), 1U);
+
+  EXPECT_TRUE (gst_tensor_meta_info_parse_memory (&meta, gst_buffer_peek_memory (buf, 0)));
+  EXPECT_EQ (meta.type, _NNS_FLOAT32);
+  EXPECT_EQ (meta.dimension[0], 3U);
+  EXPECT_EQ (meta.dimension[1], 4U);
+  EXPECT_EQ (gst_buffer_get_size (buf),
+      gst_tensor_meta_info_get_header_size (&meta) + 12 * sizeof (float));
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  ASSERT_TRUE (caps != NULL);
+  s = gst_caps_get_structure (caps, 0);
+  EXPECT_STREQ (gst_structure_get_string (s, "format"), "flexible");
+  gst_caps_unref (caps);
+
+  gst_buffer_unref (buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for sparse tensors, all elements are zero with sparsity 100.
+ */
+TEST (tensorSrcSynthetic, sparse)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+  GstCaps *caps;
+  GstTensorMetaInfo meta;
+  GstStructure *s;
+
+  h = gst_harness_new (ELEMENT_NAME);
+  ASSERT_TRUE (h != NULL);
+
+  g_object_set (h->element, "num-buffers", 1, "format", "sparse", "dimension", "100:1:1:1",
+      "type", "int32", "sparsity", 100, NULL);
+  gst_harness_play (h);
+
+  buf = gst_harness_pull (h);
+  ASSERT_TRUE (buf != NULL);
+
+  EXPECT_TRUE (gst_tensor_meta_info_parse_memory (&meta, gst_buffer_peek_memory (buf, 0)));
+  EXPECT_EQ (meta.format, _NNS_TENSOR_FORMAT_SPARSE);
+  EXPECT_EQ (meta.type, _NNS_INT32);
+  EXPECT_EQ (meta.sparse_info.nnz, 0U);
+  EXPECT_LT (gst_buffer_get_size (buf), 100 * sizeof (int32_t));
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  ASSERT_TRUE (caps != NULL);
+  s = gst_caps_get_structure (caps, 0);
+  EXPECT_STREQ (gst_structure_get_string (s, "format"), "sparse");
+  gst_caps_unref (caps);
+
+  gst_buffer_unref (buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for the pipeline with tensor_src_synthetic, all buffers are received.
+ */
+TEST (tensorSrcSynthetic, pipelineNumBuffers)
+{
+  GstElement *pipeline;
+  GstBus *bus;
+  GstMessage *msg;
+
+  pipeline = gst_parse_launch ("tensor_src_synthetic num-buffers=100 dimension=3:32:32:1 type=uint8 ! "
+                               "tensor_transform mode=typecast option=float32 ! fakesink sync=false",
+      NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, 5 * GST_SECOND,
+      (GstMessageType) (GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  ASSERT_TRUE (msg != NULL);
+  EXPECT_EQ (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  gst_object_unref (pipeline);
+}
+
+/**
+ * @brief Test for invalid tensor info (the number of dimensions and types are different).
+ */
+TEST (tensorSrcSynthetic, invalidInfo_n)
+{
+  GstElement *src;
+
+  src = gst_element_factory_make (ELEMENT_NAME, NULL);
+  ASSERT_TRUE (src != NULL);
+
+  g_object_set (src, "dimension", "3:4:1:1,2:1:1:1", "type", "uint8", NULL);
+  EXPECT_EQ (gst_element_set_state (src, GST_STATE_PAUSED), GST_STATE_CHANGE_FAILURE);
+
+  gst_element_set_state (src, GST_STATE_NULL);
+  gst_object_unref (src);
+}
+
+/**
+ * @brief Test for invalid tensor type.
+ */
+TEST (tensorSrcSynthetic, invalidType_n)
+{
+  GstElement *src;
+
+  src = gst_element_factory_make (ELEMENT_NAME, NULL);
+  ASSERT_TRUE (src != NULL);
+
+  g_object_set (src, "dimension", "3:4:1:1", "type", "uint128", NULL);
+  EXPECT_EQ (gst_element_set_state (src, GST_STATE_PAUSED), GST_STATE_CHANGE_FAILURE);
+
+  gst_element_set_state (src, GST_STATE_NULL);
+  gst_object_unref (src);
+}
+
+/**
+ * @brief Main function for unit test.
+ */
+int
+main (int argc, char **argv)
+{
+  int ret = -1;
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    g_warning ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  gst_init (&argc, &argv);
+
+  try {
+    ret = RUN_ALL_TESTS ();
+  } catch (...) {
+    g_warning ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return ret;
+}
@@ -115,6 +115,9 @@ orc_test_gcc_compile (OrcProgram *p)
   if (strcmp (orc_target_get_name (target), "mmx") == 0) {
     flags |= ORC_TARGET_MMX_SHORT_JUMPS;
   }
+  if (strcmp (orc_target_get_name (target), "avx") == 0) {
+    flags |= ORC_TARGET_AVX_SHORT_JUMPS;
+  }
 
   result = orc_program_compile_full (p, target, flags);
   if (ORC_COMPILE_RESULT_IS_FATAL(result)) {
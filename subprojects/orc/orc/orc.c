@@ -55,6 +55,7 @@ orc_init (void)
 #endif
 #ifdef ENABLE_BACKEND_SSE
       orc_sse_init();
+      orc_avx_init();
 #endif
 #ifdef ENABLE_BACKEND_ALTIVEC
       orc_powerpc_init();
@@ -0,0 +1,94 @@
+
+#include "config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <sys/types.h>
+
+#include <orc/orcprogram.h>
+#include <orc/orcdebug.h>
+#include <orc/orcavx.h>
+#include <orc/orcx86insn.h>
+
+/**
+ * SECTION:orcavx
+ * @title: AVX
+ * @short_description: code generation for AVX2
+ */
+
+
+const char *
+orc_x86_get_regname_avx(int i)
+{
+  static const char *x86_regs[] = {
+    "ymm0", "ymm1", "ymm2", "ymm3", "ymm4", "ymm5", "ymm6", "ymm7",
+    "ymm8", "ymm9", "ymm10", "ymm11", "ymm12", "ymm13", "ymm14", "ymm15"
+  };
+
+  if (i>=X86_XMM0 && i<X86_XMM0 + 16) return x86_regs[i - X86_XMM0];
+  switch (i) {
+    case 0:
+      return "UNALLOCATED";
+    case 1:
+      return "direct";
+    default:
+      return "ERROR";
+  }
+}
+
+
+void
+orc_x86_emit_mov_memoffset_avx (OrcCompiler *compiler, int size, int offset,
+    int reg1, int reg2, int is_aligned)
+{
+  switch (size) {
+    case 4:
+      orc_avx_emit_movd_load_memoffset (compiler, offset, reg1, reg2);
+      break;
+    case 8:
+      orc_avx_emit_movq_load_memoffset (compiler, offset, reg1, reg2);
+      break;
+    case 16:
+    case 32:
+      if (is_aligned) {
+        orc_avx_emit_movdqa_load_memoffset (compiler, size, offset, reg1, reg2);
+      } else {
+        orc_avx_emit_movdqu_load_memoffset (compiler, size, offset, reg1, reg2);
+      }
+      break;
+    default:
+      ORC_COMPILER_ERROR(compiler, "bad size");
+      break;
+  }
+}
+
+void
+orc_x86_emit_mov_avx_memoffset (OrcCompiler *compiler, int size, int reg1, int offset,
+    int reg2, int aligned, int uncached)
+{
+  switch (size) {
+    case 4:
+      orc_avx_emit_movd_store_memoffset (compiler, reg1, offset, reg2);
+      break;
+    case 8:
+      orc_avx_emit_movq_store_memoffset (compiler, reg1, offset, reg2);
+      break;
+    case 16:
+    case 32:
+      if (aligned) {
+        if (uncached) {
+          orc_avx_emit_movntdq_store_memoffset (compiler, size, reg1, offset, reg2);
+        } else {
+          orc_avx_emit_movdqa_store_memoffset (compiler, size, reg1, offset, reg2);
+        }
+      } else {
+        orc_avx_emit_movdqu_store_memoffset (compiler, size, reg1, offset, reg2);
+      }
+      break;
+    default:
+      ORC_COMPILER_ERROR(compiler, "bad size");
+      break;
+  }
+}
@@ -0,0 +1,115 @@
+
+#ifndef _ORC_AVX_H_
+#define _ORC_AVX_H_
+
+#include <orc/orc.h>
+#include <orc/orcx86.h>
+#include <orc/orcx86insn.h>
+#include <orc/orcsse.h>
+
+ORC_BEGIN_DECLS
+
+#ifdef ORC_ENABLE_UNSTABLE_API
+
+ORC_API const char * orc_x86_get_regname_avx(int i);
+ORC_API void orc_x86_emit_mov_memoffset_avx (OrcCompiler *compiler, int size, int offset,
+    int reg1, int reg2, int is_aligned);
+ORC_API void orc_x86_emit_mov_avx_memoffset (OrcCompiler *compiler, int size, int reg1, int offset,
+    int reg2, int aligned, int uncached);
+
+ORC_API void orc_avx_load_constant (OrcCompiler *compiler, int reg, int size,
+    orc_uint64 value);
+
+#define orc_avx_emit_paddb(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_paddb, s, 0, a, b, c)
+#define orc_avx_emit_paddw(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_paddw, s, 0, a, b, c)
+#define orc_avx_emit_paddd(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_paddd, s, 0, a, b, c)
+#define orc_avx_emit_paddq(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_paddq, s, 0, a, b, c)
+#define orc_avx_emit_psubb(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psubb, s, 0, a, b, c)
+#define orc_avx_emit_psubw(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psubw, s, 0, a, b, c)
+#define orc_avx_emit_psubd(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psubd, s, 0, a, b, c)
+#define orc_avx_emit_psubq(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psubq, s, 0, a, b, c)
+#define orc_avx_emit_pand(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pand, s, 0, a, b, c)
+#define orc_avx_emit_pandn(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pandn, s, 0, a, b, c)
+#define orc_avx_emit_por(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_por, s, 0, a, b, c)
+#define orc_avx_emit_pxor(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pxor, s, 0, a, b, c)
+#define orc_avx_emit_pcmpeqb(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pcmpeqb, s, 0, a, b, c)
+#define orc_avx_emit_pcmpeqd(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pcmpeqd, s, 0, a, b, c)
+#define orc_avx_emit_packsswb(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_packsswb, s, 0, a, b, c)
+#define orc_avx_emit_packuswb(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_packuswb, s, 0, a, b, c)
+#define orc_avx_emit_packssdw(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_packssdw, s, 0, a, b, c)
+#define orc_avx_emit_packusdw(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_packusdw, s, 0, a, b, c)
+#define orc_avx_emit_pmullw(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmullw, s, 0, a, b, c)
+#define orc_avx_emit_pmulld(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmulld, s, 0, a, b, c)
+#define orc_avx_emit_pmuldq(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmuldq, s, 0, a, b, c)
+#define orc_avx_emit_pmuludq(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmuludq, s, 0, a, b, c)
+#define orc_avx_emit_psadbw(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psadbw, s, 0, a, b, c)
+#define orc_avx_emit_minps(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_minps, s, 0, a, b, c)
+#define orc_avx_emit_minpd(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_minpd, s, 0, a, b, c)
+#define orc_avx_emit_maxps(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_maxps, s, 0, a, b, c)
+#define orc_avx_emit_maxpd(p,s,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_maxpd, s, 0, a, b, c)
+
+#define orc_avx_emit_movdqa(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_movdqa, s, 0, 0, a, b)
+#define orc_avx_emit_pabsb(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pabsb, s, 0, 0, a, b)
+#define orc_avx_emit_pmovsxbw(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmovsxbw, s, 0, 0, a, b)
+#define orc_avx_emit_pmovsxwd(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmovsxwd, s, 0, 0, a, b)
+#define orc_avx_emit_pmovsxdq(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmovsxdq, s, 0, 0, a, b)
+#define orc_avx_emit_pmovzxbw(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmovzxbw, s, 0, 0, a, b)
+#define orc_avx_emit_pmovzxwd(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmovzxwd, s, 0, 0, a, b)
+#define orc_avx_emit_pmovzxdq(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pmovzxdq, s, 0, 0, a, b)
+#define orc_avx_emit_cvttps2dq(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_cvttps2dq, s, 0, 0, a, b)
+#define orc_avx_emit_cvttpd2dq(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_cvttpd2dq, s, 0, 0, a, b)
+#define orc_avx_emit_cvtdq2ps(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_cvtdq2ps, s, 0, 0, a, b)
+#define orc_avx_emit_cvtdq2pd(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_cvtdq2pd, s, 0, 0, a, b)
+#define orc_avx_emit_cvtps2pd(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_cvtps2pd, s, 0, 0, a, b)
+#define orc_avx_emit_cvtpd2ps(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_cvtpd2ps, s, 0, 0, a, b)
+#define orc_avx_emit_vpbroadcastb(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vpbroadcastb, s, 0, 0, a, b)
+#define orc_avx_emit_vpbroadcastw(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vpbroadcastw, s, 0, 0, a, b)
+#define orc_avx_emit_vpbroadcastd(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vpbroadcastd, s, 0, 0, a, b)
+#define orc_avx_emit_vpbroadcastq(p,s,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vpbroadcastq, s, 0, 0, a, b)
+
+#define orc_avx_emit_psraw_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psraw_imm, s, imm, 0, a, b)
+#define orc_avx_emit_psrlw_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psrlw_imm, s, imm, 0, a, b)
+#define orc_avx_emit_psllw_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psllw_imm, s, imm, 0, a, b)
+#define orc_avx_emit_psrad_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psrad_imm, s, imm, 0, a, b)
+#define orc_avx_emit_psrld_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psrld_imm, s, imm, 0, a, b)
+#define orc_avx_emit_pslld_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pslld_imm, s, imm, 0, a, b)
+#define orc_avx_emit_psrlq_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psrlq_imm, s, imm, 0, a, b)
+#define orc_avx_emit_psllq_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psllq_imm, s, imm, 0, a, b)
+#define orc_avx_emit_psrldq_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_psrldq_imm, s, imm, 0, a, b)
+#define orc_avx_emit_pslldq_imm(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pslldq_imm, s, imm, 0, a, b)
+#define orc_avx_emit_pshufd(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pshufd, s, imm, 0, a, b)
+#define orc_avx_emit_pshuflw(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_pshuflw, s, imm, 0, a, b)
+#define orc_avx_emit_vpermq(p,s,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vpermq, s, imm, 0, a, b)
+#define orc_avx_emit_vperm2i128(p,imm,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vperm2i128, 32, imm, a, b, c)
+#define orc_avx_emit_vinserti128(p,imm,a,b,c) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vinserti128, 32, imm, a, b, c)
+#define orc_avx_emit_vextracti128(p,imm,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vextracti128, 32, imm, 0, a, b)
+#define orc_avx_emit_vzeroupper(p) orc_x86_emit_cpuinsn_vex(p, ORC_X86_vzeroupper, 16, 0, 0, 0, 0)
+
+#define orc_avx_emit_movd_load_register(p,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_movd_load, 16, 0, 0, a, b)
+#define orc_avx_emit_movd_store_register(p,a,b) orc_x86_emit_cpuinsn_vex(p, ORC_X86_movd_store, 16, 0, 0, a, b)
+
+#define orc_avx_emit_movd_load_memoffset(p,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_movd_load, 16, 0, offset, a, b)
+#define orc_avx_emit_movq_load_memoffset(p,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_movq_sse_load, 16, 0, offset, a, b)
+#define orc_avx_emit_movdqa_load_memoffset(p,s,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_movdqa_load, s, 0, offset, a, b)
+#define orc_avx_emit_movdqu_load_memoffset(p,s,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_movdqu_load, s, 0, offset, a, b)
+#define orc_avx_emit_vpbroadcastb_load_memoffset(p,s,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_vpbroadcastb, s, 0, offset, a, b)
+#define orc_avx_emit_vpbroadcastw_load_memoffset(p,s,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_vpbroadcastw, s, 0, offset, a, b)
+#define orc_avx_emit_vpbroadcastd_load_memoffset(p,s,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_vpbroadcastd, s, 0, offset, a, b)
+#define orc_avx_emit_vpbroadcastq_load_memoffset(p,s,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_vpbroadcastq, s, 0, offset, a, b)
+#define orc_avx_emit_vbroadcasti128_load_memoffset(p,offset,a,b) orc_x86_emit_cpuinsn_vex_load_memoffset(p, ORC_X86_vbroadcasti128, 32, 0, offset, a, b)
+
+#define orc_avx_emit_pextrb_memoffset(p,imm,a,offset,b) orc_x86_emit_cpuinsn_vex_store_memoffset(p, ORC_X86_pextrb, 16, imm, a, offset, b)
+#define orc_avx_emit_pextrw_memoffset(p,imm,a,offset,b) orc_x86_emit_cpuinsn_vex_store_memoffset(p, ORC_X86_pextrw, 16, imm, a, offset, b)
+#define orc_avx_emit_movd_store_memoffset(p,a,offset,b) orc_x86_emit_cpuinsn_vex_store_memoffset(p, ORC_X86_movd_store, 16, 0, a, offset, b)
+#define orc_avx_emit_movq_store_memoffset(p,a,offset,b) orc_x86_emit_cpuinsn_vex_store_memoffset(p, ORC_X86_movq_sse_store, 16, 0, a, offset, b)
+#define orc_avx_emit_movdqa_store_memoffset(p,s,a,offset,b) orc_x86_emit_cpuinsn_vex_store_memoffset(p, ORC_X86_movdqa_store, s, 0, a, offset, b)
+#define orc_avx_emit_movdqu_store_memoffset(p,s,a,offset,b) orc_x86_emit_cpuinsn_vex_store_memoffset(p, ORC_X86_movdqu_store, s, 0, a, offset, b)
+#define orc_avx_emit_movntdq_store_memoffset(p,s,a,offset,b) orc_x86_emit_cpuinsn_vex_store_memoffset(p, ORC_X86_movntdq_store, s, 0, a, offset, b)
+
+#endif
+
+ORC_API unsigned int orc_avx_get_cpu_flags (void);
+
+ORC_END_DECLS
+
+#endif
@@ -30,6 +30,7 @@
 #endif
 #include <orc/orcdebug.h>
 #include <orc/orcsse.h>
+#include <orc/orcavx.h>
 #include <orc/orcmmx.h>
 #include <orc/orcprogram.h>
 #include <orc/orcutils.h>
@@ -41,10 +42,14 @@
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 
 int orc_x86_sse_flags;
 int orc_x86_mmx_flags;
+int orc_x86_avx_flags;
 static orc_uint32 orc_x86_vendor;
 static int orc_x86_microarchitecture;
 
@@ -114,6 +119,25 @@ get_cpuid (orc_uint32 op, orc_uint32 *a, orc_uint32 *b,
 
 #endif
 
+static orc_uint32
+get_xcr0 (void)
+{
+#if defined(_MSC_VER) && (_MSC_FULL_VER >= 160040219)
+  return (orc_uint32) _xgetbv (0);
+#elif (defined(__GNUC__) || defined (__SUNPRO_C)) && \
+    (defined(HAVE_I386) || defined(HAVE_AMD64))
+  orc_uint32 eax, edx;
+
+  /* xgetbv, spelled out for assemblers that don't know it */
+  __asm__ (
+      "  .byte 0x0f, 0x01, 0xd0\n"
+      : "=a" (eax), "=d" (edx) : "c" (0));
+  return eax;
+#else
+  return 0;
+#endif
+}
+
 
 struct desc_struct {
   int desc;
@@ -202,6 +226,7 @@ handle_cache_descriptor (unsigned int desc)
 static void orc_sse_detect_cpuid_intel (orc_uint32 level);
 static void orc_sse_detect_cpuid_amd (orc_uint32 level);
 static void orc_sse_detect_cpuid_generic (orc_uint32 level);
+static void orc_x86_cpuid_handle_avx_flags (orc_uint32 level);
 
 static void
 orc_x86_detect_cpuid (void)
@@ -244,6 +269,10 @@ orc_x86_detect_cpuid (void)
       break;
   }
 
+  if (level >= 1) {
+    orc_x86_cpuid_handle_avx_flags (level);
+  }
+
   if (orc_compiler_flag_check ("-sse2")) {
     orc_x86_sse_flags &= ~ORC_TARGET_SSE_SSE2;
   }
@@ -265,6 +294,16 @@ orc_x86_detect_cpuid (void)
   if (orc_compiler_flag_check ("-sse5")) {
     orc_x86_sse_flags &= ~ORC_TARGET_SSE_SSE5;
   }
+  if (orc_compiler_flag_check ("-avx")) {
+    orc_x86_avx_flags &= ~(ORC_TARGET_AVX_AVX | ORC_TARGET_AVX_AVX2 |
+        ORC_TARGET_AVX_AVX512F);
+  }
+  if (orc_compiler_flag_check ("-avx2")) {
+    orc_x86_avx_flags &= ~(ORC_TARGET_AVX_AVX2 | ORC_TARGET_AVX_AVX512F);
+  }
+  if (orc_compiler_flag_check ("-avx512")) {
+    orc_x86_avx_flags &= ~ORC_TARGET_AVX_AVX512F;
+  }
 
 }
 
@@ -324,6 +363,33 @@ orc_x86_cpuid_handle_standard_flags (void)
   }
 }
 
+static void
+orc_x86_cpuid_handle_avx_flags (orc_uint32 level)
+{
+  orc_uint32 eax, ebx, ecx, edx;
+  orc_uint32 xcr0;
+
+  get_cpuid (0x00000001, &eax, &ebx, &ecx, &edx);
+
+  /* AVX needs the OS to save the YMM state (OSXSAVE, XCR0 bits 1 and 2) */
+  if (!(ecx & (1<<27)) || !(ecx & (1<<28))) return;
+  xcr0 = get_xcr0 ();
+  if ((xcr0 & 0x6) != 0x6) return;
+
+  orc_x86_avx_flags |= ORC_TARGET_AVX_AVX;
+
+  if (level < 7) return;
+
+  get_cpuid_ecx (0x00000007, 0, &eax, &ebx, &ecx, &edx);
+  if (ebx & (1<<5)) {
+    orc_x86_avx_flags |= ORC_TARGET_AVX_AVX2;
+  }
+  /* AVX-512 also needs the opmask and ZMM state (XCR0 bits 5 to 7) */
+  if ((ebx & (1<<16)) && (xcr0 & 0xe6) == 0xe6) {
+    orc_x86_avx_flags |= ORC_TARGET_AVX_AVX512F;
+  }
+}
+
 static void
 orc_x86_cpuid_handle_family_model_stepping (void)
 {
@@ -555,6 +621,13 @@ orc_sse_get_cpu_flags(void)
   return orc_x86_sse_flags;
 }
 
+unsigned int
+orc_avx_get_cpu_flags(void)
+{
+  orc_x86_detect_cpuid ();
+  return orc_x86_avx_flags;
+}
+
 unsigned int
 orc_mmx_get_cpu_flags(void)
 {
@@ -33,6 +33,9 @@ struct _OrcSysOpcode {
 
 
 #define ORC_SYS_OPCODE_FLAG_FIXED (1<<0)
+#define ORC_SYS_OPCODE_FLAG_VEX_W (1<<1)
+#define ORC_SYS_OPCODE_FLAG_HALF_RM (1<<2)
+#define ORC_SYS_OPCODE_FLAG_HALF_REG (1<<3)
 
 #endif
 
@@ -13,6 +13,7 @@ ORC_BEGIN_DECLS
  * already done as part of orc_init() */
 void orc_mmx_init (void);
 void orc_sse_init (void);
+void orc_avx_init (void);
 void orc_arm_init (void);
 void orc_powerpc_init (void);
 void orc_c_init (void);
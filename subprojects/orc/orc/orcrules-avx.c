@@ -0,0 +1,757 @@
+
+#include "config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <sys/types.h>
+
+#include <orc/orcprogram.h>
+#include <orc/orcdebug.h>
+#include <orc/orcavx.h>
+
+#define SIZE 65536
+
+/* VEX.256 where the vector is wider than an xmm register, VEX.128 otherwise */
+static int
+avx_size (OrcCompiler *p, int var)
+{
+  if ((p->vars[var].size << p->loop_shift) > 16) {
+    return 32;
+  }
+  return 16;
+}
+
+/* avx rules */
+
+static void
+avx_rule_loadpX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
+{
+  OrcVariable *src = compiler->vars + insn->src_args[0];
+  OrcVariable *dest = compiler->vars + insn->dest_args[0];
+  int reg = dest->alloc;
+  int size = ORC_PTR_TO_INT(user);
+  int offset;
+
+  if (src->vartype == ORC_VAR_TYPE_PARAM) {
+    offset = ORC_STRUCT_OFFSET(OrcExecutor, params[insn->src_args[0]]);
+
+    switch (size) {
+      case 1:
+        orc_avx_emit_vpbroadcastb_load_memoffset (compiler, 32, offset,
+            compiler->exec_reg, reg);
+        break;
+      case 2:
+        orc_avx_emit_vpbroadcastw_load_memoffset (compiler, 32, offset,
+            compiler->exec_reg, reg);
+        break;
+      case 4:
+        orc_avx_emit_vpbroadcastd_load_memoffset (compiler, 32, offset,
+            compiler->exec_reg, reg);
+        break;
+      case 8:
+        if (src->size == 8) {
+          int tmp_offset = ORC_STRUCT_OFFSET(OrcExecutor,arrays[ORC_VAR_T1]);
+
+          /* the two halves are not adjacent in the executor */
+          orc_x86_emit_mov_memoffset_reg (compiler, 4, offset,
+              compiler->exec_reg, compiler->gp_tmpreg);
+          orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+              tmp_offset + 0, compiler->exec_reg);
+          orc_x86_emit_mov_memoffset_reg (compiler, 4,
+              (int)ORC_STRUCT_OFFSET(OrcExecutor,
+                params[insn->src_args[0] + (ORC_VAR_T1 - ORC_VAR_P1)]),
+              compiler->exec_reg, compiler->gp_tmpreg);
+          orc_x86_emit_mov_reg_memoffset (compiler, 4, compiler->gp_tmpreg,
+              tmp_offset + 4, compiler->exec_reg);
+          orc_avx_emit_vpbroadcastq_load_memoffset (compiler, 32, tmp_offset,
+              compiler->exec_reg, reg);
+        } else {
+          orc_avx_emit_movd_load_memoffset (compiler, offset,
+              compiler->exec_reg, reg);
+          orc_avx_emit_vpbroadcastq (compiler, 32, reg, reg);
+        }
+        break;
+      default:
+        ORC_ASSERT(0);
+        break;
+    }
+  } else if (src->vartype == ORC_VAR_TYPE_CONST) {
+    orc_avx_load_constant (compiler, reg, size, src->value.i);
+  } else {
+    ORC_ASSERT(0);
+  }
+}
+
+static void
+avx_load_memoffset (OrcCompiler *compiler, OrcInstruction *insn, int offset,
+    int is_aligned)
+{
+  OrcVariable *src = compiler->vars + insn->src_args[0];
+  OrcVariable *dest = compiler->vars + insn->dest_args[0];
+  int ptr_reg;
+
+  if (src->ptr_register == 0) {
+    int i = insn->src_args[0];
+    orc_x86_emit_mov_memoffset_reg (compiler, compiler->is_64bit ? 8 : 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, arrays[i]),
+        compiler->exec_reg, compiler->gp_tmpreg);
+    ptr_reg = compiler->gp_tmpreg;
+  } else {
+    ptr_reg = src->ptr_register;
+  }
+  switch (src->size << compiler->loop_shift) {
+    case 1:
+      orc_x86_emit_mov_memoffset_reg (compiler, 1, offset, ptr_reg,
+          compiler->gp_tmpreg);
+      orc_avx_emit_movd_load_register (compiler, compiler->gp_tmpreg,
+          dest->alloc);
+      break;
+    case 2:
+      orc_x86_emit_mov_memoffset_reg (compiler, 2, offset, ptr_reg,
+          compiler->gp_tmpreg);
+      orc_avx_emit_movd_load_register (compiler, compiler->gp_tmpreg,
+          dest->alloc);
+      break;
+    case 4:
+    case 8:
+    case 16:
+    case 32:
+      orc_x86_emit_mov_memoffset_avx (compiler,
+          src->size << compiler->loop_shift, offset, ptr_reg,
+          dest->alloc, is_aligned);
+      break;
+    default:
+      orc_compiler_error (compiler, "bad load size %d",
+          src->size << compiler->loop_shift);
+      break;
+  }
+
+  src->update_type = 2;
+}
+
+static void
+avx_rule_loadX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
+{
+  OrcVariable *src = compiler->vars + insn->src_args[0];
+
+  avx_load_memoffset (compiler, insn, compiler->offset * src->size,
+      src->is_aligned);
+}
+
+static void
+avx_rule_loadoffX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
+{
+  OrcVariable *src = compiler->vars + insn->src_args[0];
+  int offset;
+
+  if (compiler->vars[insn->src_args[1]].vartype != ORC_VAR_TYPE_CONST) {
+    orc_compiler_error (compiler, "code generation rule for %s only works with constant offset",
+        insn->opcode->name);
+    return;
+  }
+
+  offset = compiler->vars[insn->src_args[1]].value.i;
+
+  /* the array is aligned, but the offset may not keep it aligned */
+  avx_load_memoffset (compiler, insn, (compiler->offset + offset) * src->size,
+      src->is_aligned && (offset & ((1<<compiler->loop_shift) - 1)) == 0);
+}
+
+static void
+avx_rule_storeX (OrcCompiler *compiler, void *user, OrcInstruction *insn)
+{
+  OrcVariable *src = compiler->vars + insn->src_args[0];
+  OrcVariable *dest = compiler->vars + insn->dest_args[0];
+  int offset;
+  int ptr_reg;
+
+  offset = compiler->offset * dest->size;
+  if (dest->ptr_register == 0) {
+    orc_x86_emit_mov_memoffset_reg (compiler, compiler->is_64bit ? 8 : 4,
+        dest->ptr_offset, compiler->exec_reg, compiler->gp_tmpreg);
+    ptr_reg = compiler->gp_tmpreg;
+  } else {
+    ptr_reg = dest->ptr_register;
+  }
+  switch (dest->size << compiler->loop_shift) {
+    case 1:
+      orc_avx_emit_pextrb_memoffset (compiler, 0, src->alloc, offset,
+          ptr_reg);
+      break;
+    case 2:
+      orc_avx_emit_pextrw_memoffset (compiler, 0, src->alloc, offset,
+          ptr_reg);
+      break;
+    case 4:
+    case 8:
+    case 16:
+    case 32:
+      orc_x86_emit_mov_avx_memoffset (compiler,
+          dest->size << compiler->loop_shift, src->alloc, offset, ptr_reg,
+          dest->is_aligned, dest->is_uncached);
+      break;
+    default:
+      orc_compiler_error (compiler, "bad size");
+      break;
+  }
+
+  dest->update_type = 2;
+}
+
+static void
+avx_rule_copyx (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  if (p->vars[insn->src_args[0]].alloc == p->vars[insn->dest_args[0]].alloc) {
+    return;
+  }
+
+  orc_avx_emit_movdqa (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_unary (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_x86_emit_cpuinsn_vex (p, ORC_PTR_TO_INT(user),
+      avx_size (p, insn->dest_args[0]), 0, 0,
+      p->vars[insn->src_args[0]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_binary (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_x86_emit_cpuinsn_vex (p, ORC_PTR_TO_INT(user),
+      avx_size (p, insn->dest_args[0]), 0,
+      p->vars[insn->src_args[0]].alloc,
+      p->vars[insn->src_args[1]].alloc,
+      p->vars[insn->dest_args[0]].alloc);
+}
+
+/* Keeps the low bytes of src that belong to this iteration and clears the
+ * rest of the ymm register, so that the accumulator can always be updated
+ * with a 256-bit add. */
+static int
+avx_acc_source (OrcCompiler *p, int src, int bytes)
+{
+  int tmp;
+
+  if (bytes >= 32) return src;
+
+  tmp = orc_compiler_get_temp_reg (p);
+  if (bytes < 16) {
+    orc_avx_emit_pslldq_imm (p, 16, 16 - bytes, src, tmp);
+  } else {
+    orc_avx_emit_movdqa (p, 16, src, tmp);
+  }
+  return tmp;
+}
+
+static void
+avx_rule_accw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+
+  src = avx_acc_source (p, src, 2 << p->loop_shift);
+  orc_avx_emit_paddw (p, 32, dest, src, dest);
+}
+
+static void
+avx_rule_accl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+
+  src = avx_acc_source (p, src, 4 << p->loop_shift);
+  orc_avx_emit_paddd (p, 32, dest, src, dest);
+}
+
+static void
+avx_rule_accsadubl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src1 = p->vars[insn->src_args[0]].alloc;
+  int src2 = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int tmp = orc_compiler_get_temp_reg (p);
+  int tmp2;
+
+  if (p->loop_shift <= 2) {
+    tmp2 = orc_compiler_get_temp_reg (p);
+    orc_avx_emit_pslldq_imm (p, 16, 16 - (1<<p->loop_shift), src1, tmp);
+    orc_avx_emit_pslldq_imm (p, 16, 16 - (1<<p->loop_shift), src2, tmp2);
+    orc_avx_emit_psadbw (p, 16, tmp, tmp2, tmp);
+  } else if (p->loop_shift == 3) {
+    orc_avx_emit_psadbw (p, 16, src1, src2, tmp);
+    orc_avx_emit_pslldq_imm (p, 16, 8, tmp, tmp);
+  } else if (p->loop_shift == 4) {
+    orc_avx_emit_psadbw (p, 16, src1, src2, tmp);
+  } else {
+    orc_avx_emit_psadbw (p, 32, src1, src2, tmp);
+  }
+  orc_avx_emit_paddd (p, 32, dest, tmp, dest);
+}
+
+static void
+avx_rule_shift (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int type = ORC_PTR_TO_INT(user);
+  const int opcodes[] = { ORC_X86_psllw, ORC_X86_psrlw, ORC_X86_psraw,
+    ORC_X86_pslld, ORC_X86_psrld, ORC_X86_psrad, ORC_X86_psllq,
+    ORC_X86_psrlq };
+  const int opcodes_imm[] = { ORC_X86_psllw_imm, ORC_X86_psrlw_imm,
+    ORC_X86_psraw_imm, ORC_X86_pslld_imm, ORC_X86_psrld_imm,
+    ORC_X86_psrad_imm, ORC_X86_psllq_imm, ORC_X86_psrlq_imm };
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->dest_args[0]);
+
+  if (p->vars[insn->src_args[1]].vartype == ORC_VAR_TYPE_CONST) {
+    orc_x86_emit_cpuinsn_vex (p, opcodes_imm[type], size,
+        p->vars[insn->src_args[1]].value.i, 0, src, dest);
+  } else if (p->vars[insn->src_args[1]].vartype == ORC_VAR_TYPE_PARAM) {
+    int tmp = orc_compiler_get_temp_reg (p);
+
+    /* the count is taken from the low 64 bits of an xmm register */
+    orc_x86_emit_mov_memoffset_avx (p, 4,
+        (int)ORC_STRUCT_OFFSET(OrcExecutor, params[insn->src_args[1]]),
+        p->exec_reg, tmp, FALSE);
+
+    orc_x86_emit_cpuinsn_vex (p, opcodes[type], size, 0, src, tmp, dest);
+  } else {
+    orc_compiler_error (p, "code generation rule for %s only works with "
+        "constant or parameter shifts", insn->opcode->name);
+    p->result = ORC_COMPILE_RESULT_UNKNOWN_COMPILE;
+  }
+}
+
+static void
+avx_rule_convsbw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_pmovsxbw (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convubw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_pmovzxbw (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convswl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_pmovsxwd (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convuwl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_pmovzxwd (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convslq (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_pmovsxdq (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convulq (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_pmovzxdq (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+/* The pack instructions work within 128-bit lanes, so a 256-bit source is
+ * split and packed into an xmm register instead. */
+static void
+avx_emit_pack (OrcCompiler *p, int opcode, int src_var, int src, int dest)
+{
+  if (avx_size (p, src_var) == 32) {
+    int tmp = orc_compiler_get_temp_reg (p);
+
+    orc_avx_emit_vextracti128 (p, 1, src, tmp);
+    orc_x86_emit_cpuinsn_vex (p, opcode, 16, 0, src, tmp, dest);
+  } else {
+    orc_x86_emit_cpuinsn_vex (p, opcode, 16, 0, src, src, dest);
+  }
+}
+
+static void
+avx_rule_convssswb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  avx_emit_pack (p, ORC_X86_packsswb, insn->src_args[0],
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convsuswb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  avx_emit_pack (p, ORC_X86_packuswb, insn->src_args[0],
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convwb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->src_args[0]);
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  orc_avx_emit_psllw_imm (p, size, 8, src, tmp);
+  orc_avx_emit_psrlw_imm (p, size, 8, tmp, tmp);
+  avx_emit_pack (p, ORC_X86_packuswb, insn->src_args[0], tmp, dest);
+}
+
+static void
+avx_rule_convhwb (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->src_args[0]);
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  orc_avx_emit_psrlw_imm (p, size, 8, src, tmp);
+  avx_emit_pack (p, ORC_X86_packuswb, insn->src_args[0], tmp, dest);
+}
+
+static void
+avx_rule_convlw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->src_args[0]);
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  orc_avx_emit_pslld_imm (p, size, 16, src, tmp);
+  orc_avx_emit_psrad_imm (p, size, 16, tmp, tmp);
+  avx_emit_pack (p, ORC_X86_packssdw, insn->src_args[0], tmp, dest);
+}
+
+static void
+avx_rule_convhlw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->src_args[0]);
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  orc_avx_emit_psrad_imm (p, size, 16, src, tmp);
+  avx_emit_pack (p, ORC_X86_packssdw, insn->src_args[0], tmp, dest);
+}
+
+static void
+avx_rule_convssslw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  avx_emit_pack (p, ORC_X86_packssdw, insn->src_args[0],
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convsuslw (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  avx_emit_pack (p, ORC_X86_packusdw, insn->src_args[0],
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convql (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->src_args[0]);
+
+  orc_avx_emit_pshufd (p, size, ORC_SSE_SHUF(2,0,2,0), src, dest);
+  if (size == 32) {
+    orc_avx_emit_vpermq (p, 32, ORC_SSE_SHUF(3,1,2,0), dest, dest);
+  }
+}
+
+#define AVX_MUL_WIDEN(opcode,convert,mul) \
+static void \
+avx_rule_ ## opcode (OrcCompiler *p, void *user, OrcInstruction *insn) \
+{ \
+  int size = avx_size (p, insn->dest_args[0]); \
+  int tmp = orc_compiler_get_temp_reg (p); \
+  int tmp2 = orc_compiler_get_temp_reg (p); \
+\
+  orc_avx_emit_ ## convert (p, size, p->vars[insn->src_args[0]].alloc, tmp); \
+  orc_avx_emit_ ## convert (p, size, p->vars[insn->src_args[1]].alloc, tmp2); \
+  orc_avx_emit_ ## mul (p, size, tmp, tmp2, \
+      p->vars[insn->dest_args[0]].alloc); \
+}
+
+AVX_MUL_WIDEN(mulsbw, pmovsxbw, pmullw)
+AVX_MUL_WIDEN(mulubw, pmovzxbw, pmullw)
+AVX_MUL_WIDEN(mulswl, pmovsxwd, pmulld)
+AVX_MUL_WIDEN(muluwl, pmovzxwd, pmulld)
+AVX_MUL_WIDEN(mulslq, pmovsxdq, pmuldq)
+AVX_MUL_WIDEN(mululq, pmovzxdq, pmuludq)
+
+/* float ops */
+
+static void
+avx_rule_minmax (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int opcode = ORC_PTR_TO_INT(user);
+  int src0 = p->vars[insn->src_args[0]].alloc;
+  int src1 = p->vars[insn->src_args[1]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->dest_args[0]);
+
+  if (p->target_flags & ORC_TARGET_FAST_NAN) {
+    orc_x86_emit_cpuinsn_vex (p, opcode, size, 0, src0, src1, dest);
+  } else {
+    int tmp = orc_compiler_get_temp_reg (p);
+
+    /* min/max return the second operand if either is NaN, so or'ing
+     * both orders propagates the NaN like the C backup does */
+    orc_x86_emit_cpuinsn_vex (p, opcode, size, 0, src1, src0, tmp);
+    orc_x86_emit_cpuinsn_vex (p, opcode, size, 0, src0, src1, dest);
+    orc_avx_emit_por (p, size, dest, tmp, dest);
+  }
+}
+
+static void
+avx_rule_convfl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->dest_args[0]);
+  int tmpc;
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  tmpc = orc_compiler_get_temp_constant (p, 4, 0x80000000);
+  orc_avx_emit_psrad_imm (p, size, 31, src, tmp);
+  orc_avx_emit_cvttps2dq (p, size, src, dest);
+  orc_avx_emit_pcmpeqd (p, size, tmpc, dest, tmpc);
+  orc_avx_emit_pandn (p, size, tmp, tmpc, tmp);
+  orc_avx_emit_paddd (p, size, dest, tmp, dest);
+}
+
+static void
+avx_rule_convdl (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  int src = p->vars[insn->src_args[0]].alloc;
+  int dest = p->vars[insn->dest_args[0]].alloc;
+  int size = avx_size (p, insn->src_args[0]);
+  int tmpc;
+  int tmp = orc_compiler_get_temp_reg (p);
+
+  tmpc = orc_compiler_get_temp_constant (p, 4, 0x80000000);
+  orc_avx_emit_pshufd (p, size, ORC_SSE_SHUF(3,1,3,1), src, tmp);
+  if (size == 32) {
+    orc_avx_emit_vpermq (p, 32, ORC_SSE_SHUF(3,1,2,0), tmp, tmp);
+  }
+  orc_avx_emit_cvttpd2dq (p, size, src, dest);
+  orc_avx_emit_psrad_imm (p, 16, 31, tmp, tmp);
+  orc_avx_emit_pcmpeqd (p, 16, tmpc, dest, tmpc);
+  orc_avx_emit_pandn (p, 16, tmp, tmpc, tmp);
+  orc_avx_emit_paddd (p, 16, dest, tmp, dest);
+}
+
+static void
+avx_rule_convlf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_cvtdq2ps (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convld (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_cvtdq2pd (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convfd (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_cvtps2pd (p, avx_size (p, insn->dest_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+static void
+avx_rule_convdf (OrcCompiler *p, void *user, OrcInstruction *insn)
+{
+  orc_avx_emit_cvtpd2ps (p, avx_size (p, insn->src_args[0]),
+      p->vars[insn->src_args[0]].alloc, p->vars[insn->dest_args[0]].alloc);
+}
+
+void
+orc_compiler_avx_register_rules (OrcTarget *target)
+{
+  OrcRuleSet *rule_set;
+
+#define REG(x) \
+  orc_rule_register (rule_set, #x , avx_rule_ ## x, NULL)
+#define REG_UNARY(x,insn) \
+  orc_rule_register (rule_set, #x , avx_rule_unary, (void *)ORC_X86_ ## insn)
+#define REG_BINARY(x,insn) \
+  orc_rule_register (rule_set, #x , avx_rule_binary, (void *)ORC_X86_ ## insn)
+
+  /* Opcodes without a rule here make the whole program fall back to
+   * the sse target. */
+  rule_set = orc_rule_set_new (orc_opcode_set_get("sys"), target,
+      ORC_TARGET_AVX_AVX2);
+
+  orc_rule_register (rule_set, "loadb", avx_rule_loadX, NULL);
+  orc_rule_register (rule_set, "loadw", avx_rule_loadX, NULL);
+  orc_rule_register (rule_set, "loadl", avx_rule_loadX, NULL);
+  orc_rule_register (rule_set, "loadq", avx_rule_loadX, NULL);
+  orc_rule_register (rule_set, "loadoffb", avx_rule_loadoffX, NULL);
+  orc_rule_register (rule_set, "loadoffw", avx_rule_loadoffX, NULL);
+  orc_rule_register (rule_set, "loadoffl", avx_rule_loadoffX, NULL);
+  orc_rule_register (rule_set, "loadpb", avx_rule_loadpX, (void *)1);
+  orc_rule_register (rule_set, "loadpw", avx_rule_loadpX, (void *)2);
+  orc_rule_register (rule_set, "loadpl", avx_rule_loadpX, (void *)4);
+  orc_rule_register (rule_set, "loadpq", avx_rule_loadpX, (void *)8);
+
+  orc_rule_register (rule_set, "storeb", avx_rule_storeX, NULL);
+  orc_rule_register (rule_set, "storew", avx_rule_storeX, NULL);
+  orc_rule_register (rule_set, "storel", avx_rule_storeX, NULL);
+  orc_rule_register (rule_set, "storeq", avx_rule_storeX, NULL);
+
+  orc_rule_register (rule_set, "copyb", avx_rule_copyx, NULL);
+  orc_rule_register (rule_set, "copyw", avx_rule_copyx, NULL);
+  orc_rule_register (rule_set, "copyl", avx_rule_copyx, NULL);
+  orc_rule_register (rule_set, "copyq", avx_rule_copyx, NULL);
+
+  REG_UNARY(absb, pabsb);
+  REG_BINARY(addb, paddb);
+  REG_BINARY(addssb, paddsb);
+  REG_BINARY(addusb, paddusb);
+  REG_BINARY(andb, pand);
+  REG_BINARY(andnb, pandn);
+  REG_BINARY(avgub, pavgb);
+  REG_BINARY(cmpeqb, pcmpeqb);
+  REG_BINARY(cmpgtsb, pcmpgtb);
+  REG_BINARY(maxsb, pmaxsb);
+  REG_BINARY(maxub, pmaxub);
+  REG_BINARY(minsb, pminsb);
+  REG_BINARY(minub, pminub);
+  REG_BINARY(orb, por);
+  REG_BINARY(subb, psubb);
+  REG_BINARY(subssb, psubsb);
+  REG_BINARY(subusb, psubusb);
+  REG_BINARY(xorb, pxor);
+
+  REG_UNARY(absw, pabsw);
+  REG_BINARY(addw, paddw);
+  REG_BINARY(addssw, paddsw);
+  REG_BINARY(addusw, paddusw);
+  REG_BINARY(andw, pand);
+  REG_BINARY(andnw, pandn);
+  REG_BINARY(avguw, pavgw);
+  REG_BINARY(cmpeqw, pcmpeqw);
+  REG_BINARY(cmpgtsw, pcmpgtw);
+  REG_BINARY(maxsw, pmaxsw);
+  REG_BINARY(maxuw, pmaxuw);
+  REG_BINARY(minsw, pminsw);
+  REG_BINARY(minuw, pminuw);
+  REG_BINARY(mullw, pmullw);
+  REG_BINARY(mulhsw, pmulhw);
+  REG_BINARY(mulhuw, pmulhuw);
+  REG_BINARY(orw, por);
+  REG_BINARY(subw, psubw);
+  REG_BINARY(subssw, psubsw);
+  REG_BINARY(subusw, psubusw);
+  REG_BINARY(xorw, pxor);
+
+  REG_UNARY(absl, pabsd);
+  REG_BINARY(addl, paddd);
+  REG_BINARY(andl, pand);
+  REG_BINARY(andnl, pandn);
+  REG_BINARY(cmpeql, pcmpeqd);
+  REG_BINARY(cmpgtsl, pcmpgtd);
+  REG_BINARY(maxsl, pmaxsd);
+  REG_BINARY(maxul, pmaxud);
+  REG_BINARY(minsl, pminsd);
+  REG_BINARY(minul, pminud);
+  REG_BINARY(mulll, pmulld);
+  REG_BINARY(orl, por);
+  REG_BINARY(subl, psubd);
+  REG_BINARY(xorl, pxor);
+
+  REG_BINARY(addq, paddq);
+  REG_BINARY(andq, pand);
+  REG_BINARY(andnq, pandn);
+  REG_BINARY(orq, por);
+  REG_BINARY(subq, psubq);
+  REG_BINARY(xorq, pxor);
+  REG_BINARY(cmpeqq, pcmpeqq);
+  REG_BINARY(cmpgtsq, pcmpgtq);
+
+  orc_rule_register (rule_set, "shlw", avx_rule_shift, (void *)0);
+  orc_rule_register (rule_set, "shruw", avx_rule_shift, (void *)1);
+  orc_rule_register (rule_set, "shrsw", avx_rule_shift, (void *)2);
+  orc_rule_register (rule_set, "shll", avx_rule_shift, (void *)3);
+  orc_rule_register (rule_set, "shrul", avx_rule_shift, (void *)4);
+  orc_rule_register (rule_set, "shrsl", avx_rule_shift, (void *)5);
+  orc_rule_register (rule_set, "shlq", avx_rule_shift, (void *)6);
+  orc_rule_register (rule_set, "shruq", avx_rule_shift, (void *)7);
+
+  REG(convsbw);
+  REG(convubw);
+  REG(convswl);
+  REG(convuwl);
+  REG(convslq);
+  REG(convulq);
+  REG(convssswb);
+  REG(convsuswb);
+  REG(convwb);
+  REG(convhwb);
+  REG(convlw);
+  REG(convhlw);
+  REG(convssslw);
+  REG(convsuslw);
+  REG(convql);
+
+  REG(mulsbw);
+  REG(mulubw);
+  REG(mulswl);
+  REG(muluwl);
+  REG(mulslq);
+  REG(mululq);
+
+  REG(accw);
+  REG(accl);
+  REG(accsadubl);
+
+  REG_BINARY(addf, addps);
+  REG_BINARY(subf, subps);
+  REG_BINARY(mulf, mulps);
+  REG_BINARY(divf, divps);
+  REG_UNARY(sqrtf, sqrtps);
+  REG_BINARY(cmpeqf, cmpeqps);
+  REG_BINARY(cmpltf, cmpltps);
+  REG_BINARY(cmplef, cmpleps);
+  orc_rule_register (rule_set, "minf", avx_rule_minmax, (void *)ORC_X86_minps);
+  orc_rule_register (rule_set, "maxf", avx_rule_minmax, (void *)ORC_X86_maxps);
+  REG(convfl);
+  REG(convlf);
+
+  REG_BINARY(addd, addpd);
+  REG_BINARY(subd, subpd);
+  REG_BINARY(muld, mulpd);
+  REG_BINARY(divd, divpd);
+  REG_UNARY(sqrtd, sqrtpd);
+  REG_BINARY(cmpeqd, cmpeqpd);
+  REG_BINARY(cmpltd, cmpltpd);
+  REG_BINARY(cmpled, cmplepd);
+  orc_rule_register (rule_set, "mind", avx_rule_minmax, (void *)ORC_X86_minpd);
+  orc_rule_register (rule_set, "maxd", avx_rule_minmax, (void *)ORC_X86_maxpd);
+  REG(convdl);
+  REG(convld);
+  REG(convfd);
+  REG(convdf);
+}
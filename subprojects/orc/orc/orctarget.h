@@ -65,6 +65,15 @@ typedef enum {
   ORC_TARGET_SSE_64BIT = (1<<9)
 }OrcTargetSSEFlags;
 
+typedef enum {
+  ORC_TARGET_AVX_AVX = (1<<0),
+  ORC_TARGET_AVX_AVX2 = (1<<1),
+  ORC_TARGET_AVX_AVX512F = (1<<2),
+  ORC_TARGET_AVX_FRAME_POINTER = (1<<7),
+  ORC_TARGET_AVX_SHORT_JUMPS = (1<<8),
+  ORC_TARGET_AVX_64BIT = (1<<9)
+} OrcTargetAVXFlags;
+
 
 /**
  * OrcTarget:
@@ -189,6 +189,14 @@ ORC_API void orc_x86_emit_cpuinsn_branch (OrcCompiler *p, int index, int label);
 ORC_API void orc_x86_emit_cpuinsn_label (OrcCompiler *p, int index, int label);
 ORC_API void orc_x86_emit_cpuinsn_none (OrcCompiler *p, int index);
 ORC_API void orc_x86_emit_cpuinsn_align (OrcCompiler *p, int index, int align_shift);
+ORC_API void orc_x86_emit_cpuinsn_vex (OrcCompiler *p, int index, int size,
+    int imm, int src0, int src1, int dest);
+ORC_API void orc_x86_emit_cpuinsn_vex_load_memoffset (OrcCompiler *p, int index,
+    int size, int imm, int offset, int src, int dest);
+ORC_API void orc_x86_emit_cpuinsn_vex_store_memoffset (OrcCompiler *p, int index,
+    int size, int imm, int src, int offset, int dest);
+ORC_API void orc_x86_emit_cpuinsn_vex_load_memindex (OrcCompiler *p, int index,
+    int size, int imm, int offset, int src, int src_index, int shift, int dest);
 
 #endif
 
@@ -7,6 +7,7 @@
 #include <orc/orccpuinsn.h>
 #include <orc/orcx86.h>
 #include <orc/orcsse.h>
+#include <orc/orcavx.h>
 #include <orc/orcmmx.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -90,21 +91,21 @@ static const OrcSysOpcode orc_x86_opcodes[] = {
   { "pabsb", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f381c },
   { "pabsw", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f381d },
   { "pabsd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f381e },
-  { "pmovsxbw", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3820 },
-  { "pmovsxbd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3821 },
-  { "pmovsxbq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3822 },
-  { "pmovsxwd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3823 },
-  { "pmovsxwq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3824 },
-  { "pmovsxdq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3825 },
+  { "pmovsxbw", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3820 },
+  { "pmovsxbd", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3821 },
+  { "pmovsxbq", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3822 },
+  { "pmovsxwd", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3823 },
+  { "pmovsxwq", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3824 },
+  { "pmovsxdq", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3825 },
   { "pmuldq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3828 },
   { "pcmpeqq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3829 },
   { "packusdw", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f382b },
-  { "pmovzxbw", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3830 },
-  { "pmovzxbd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3831 },
-  { "pmovzxbq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3832 },
-  { "pmovzxwd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3833 },
-  { "pmovzxwq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3834 },
-  { "pmovzxdq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3835 },
+  { "pmovzxbw", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3830 },
+  { "pmovzxbd", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3831 },
+  { "pmovzxbq", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3832 },
+  { "pmovzxwd", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3833 },
+  { "pmovzxwq", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3834 },
+  { "pmovzxdq", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x01, 0x0f3835 },
   { "pmulld", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3840 },
   { "phminposuw", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3841 },
   { "pminsb", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x01, 0x0f3838 },
@@ -133,11 +134,11 @@ static const OrcSysOpcode orc_x86_opcodes[] = {
   { "cmpleps", ORC_X86_INSN_TYPE_SSEM_SSE, 0, 0x00, 0x0fc2, 2 },
   { "cmplepd", ORC_X86_INSN_TYPE_SSEM_SSE, 0, 0x66, 0x0fc2, 2 },
   { "cvttps2dq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0xf3, 0x0f5b },
-  { "cvttpd2dq", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x66, 0x0fe6 },
+  { "cvttpd2dq", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_REG, 0x66, 0x0fe6 },
   { "cvtdq2ps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x00, 0x0f5b },
-  { "cvtdq2pd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0xf3, 0x0fe6 },
-  { "cvtps2pd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x00, 0x0f5a },
-  { "cvtpd2ps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x66, 0x0f5a },
+  { "cvtdq2pd", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0xf3, 0x0fe6 },
+  { "cvtps2pd", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x00, 0x0f5a },
+  { "cvtpd2ps", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_REG, 0x66, 0x0f5a },
   { "minps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x00, 0x0f5d },
   { "minpd", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x66, 0x0f5d },
   { "maxps", ORC_X86_INSN_TYPE_MMXM_MMX, 0, 0x00, 0x0f5f },
@@ -256,6 +257,17 @@ static const OrcSysOpcode orc_x86_opcodes[] = {
   { "movq", ORC_X86_INSN_TYPE_MMXM_MMX_REV, 0, 0x00, 0x0f7f },
   { "endbr32", ORC_X86_INSN_TYPE_NONE, 0, 0xf3, 0x0f1efb },
   { "endbr64", ORC_X86_INSN_TYPE_NONE, 0, 0xf3, 0x0f1efa },
+  { "pextrb", ORC_X86_INSN_TYPE_IMM8_MMX_REG_REV, 0, 0x01, 0x0f3a14 },
+  { "vpbroadcastb", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x66, 0x0f3878 },
+  { "vpbroadcastw", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x66, 0x0f3879 },
+  { "vpbroadcastd", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x66, 0x0f3858 },
+  { "vpbroadcastq", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x66, 0x0f3859 },
+  { "vbroadcasti128", ORC_X86_INSN_TYPE_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x66, 0x0f385a },
+  { "vpermq", ORC_X86_INSN_TYPE_IMM8_MMXM_MMX, ORC_SYS_OPCODE_FLAG_VEX_W, 0x66, 0x0f3a00 },
+  { "vperm2i128", ORC_X86_INSN_TYPE_IMM8_MMXM_MMX, 0, 0x66, 0x0f3a46 },
+  { "vextracti128", ORC_X86_INSN_TYPE_IMM8_MMX_REG_REV, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x66, 0x0f3a39 },
+  { "vinserti128", ORC_X86_INSN_TYPE_IMM8_MMXM_MMX, ORC_SYS_OPCODE_FLAG_HALF_RM, 0x66, 0x0f3a38 },
+  { "vzeroupper", ORC_X86_INSN_TYPE_NONE, 0, 0x00, 0x0f77 },
 };
 
 static void
@@ -299,6 +311,124 @@ is_sse_reg (int reg)
   return (reg >= X86_XMM0) && (reg <= X86_XMM15);
 }
 
+static const char *
+orc_x86_get_regname_vex (int reg, int size)
+{
+  if (!is_sse_reg (reg)) {
+    return orc_x86_get_regname_size (reg, 4);
+  }
+  if (size == 32) {
+    return orc_x86_get_regname_avx (reg);
+  }
+  return orc_x86_get_regname_sse (reg);
+}
+
+static void
+orc_x86_vex_get_operands (OrcX86Insn *xinsn, int *rm, int *reg)
+{
+  switch (xinsn->opcode->type) {
+    case ORC_X86_INSN_TYPE_IMM8_MMX_SHIFT:
+      *rm = xinsn->dest;
+      *reg = 0;
+      break;
+    case ORC_X86_INSN_TYPE_MMXM_MMX_REV:
+    case ORC_X86_INSN_TYPE_SSEM_SSE_REV:
+    case ORC_X86_INSN_TYPE_MMX_REGM_REV:
+    case ORC_X86_INSN_TYPE_IMM8_MMX_REG_REV:
+      *rm = xinsn->dest;
+      *reg = xinsn->src;
+      break;
+    case ORC_X86_INSN_TYPE_NONE:
+      *rm = 0;
+      *reg = 0;
+      break;
+    default:
+      *rm = xinsn->src;
+      *reg = xinsn->dest;
+      break;
+  }
+}
+
+static void
+orc_x86_insn_output_asm_vex (OrcCompiler *p, OrcX86Insn *xinsn)
+{
+  const OrcSysOpcode *opcode = xinsn->opcode;
+  char name_str[20] = { 0 };
+  char imm_str[40] = { 0 };
+  char rm_str[40] = { 0 };
+  char vvvv_str[40] = { 0 };
+  const char *reg_str;
+  int rm_size;
+  int reg_size;
+  int rm;
+  int reg;
+
+  orc_x86_vex_get_operands (xinsn, &rm, &reg);
+
+  if (opcode->name[0] == 'v') {
+    sprintf(name_str, "%s", opcode->name);
+  } else {
+    sprintf(name_str, "v%s", opcode->name);
+  }
+
+  if (opcode->type == ORC_X86_INSN_TYPE_NONE) {
+    ORC_ASM_CODE(p,"  %s\n", name_str);
+    return;
+  }
+
+  rm_size = (opcode->flags & ORC_SYS_OPCODE_FLAG_HALF_RM) ? 16 : xinsn->size;
+  reg_size = (opcode->flags & ORC_SYS_OPCODE_FLAG_HALF_REG) ? 16 : xinsn->size;
+
+  switch (opcode->type) {
+    case ORC_X86_INSN_TYPE_IMM8_MMX_SHIFT:
+    case ORC_X86_INSN_TYPE_IMM8_MMXM_MMX:
+    case ORC_X86_INSN_TYPE_IMM8_MMX_REG_REV:
+      sprintf(imm_str, "$%d, ", xinsn->imm);
+      break;
+    default:
+      break;
+  }
+
+  if (xinsn->type == ORC_X86_RM_REG) {
+    sprintf(rm_str, "%%%s", orc_x86_get_regname_vex (rm, rm_size));
+  } else if (xinsn->type == ORC_X86_RM_MEMOFFSET) {
+    sprintf(rm_str, "%d(%%%s)", xinsn->offset,
+        orc_x86_get_regname_ptr (p, rm));
+  } else if (xinsn->type == ORC_X86_RM_MEMINDEX) {
+    sprintf(rm_str, "%d(%%%s,%%%s,%d)", xinsn->offset,
+        orc_x86_get_regname_ptr (p, rm),
+        orc_x86_get_regname_ptr (p, xinsn->index_reg),
+        1<<xinsn->shift);
+  } else {
+    ORC_ASSERT(0);
+  }
+
+  if (xinsn->vex_src) {
+    sprintf(vvvv_str, "%%%s, ",
+        orc_x86_get_regname_vex (xinsn->vex_src, xinsn->size));
+  }
+
+  switch (opcode->type) {
+    case ORC_X86_INSN_TYPE_IMM8_MMX_SHIFT:
+      ORC_ASM_CODE(p,"  %s %s%s, %%%s\n", name_str, imm_str, rm_str,
+          orc_x86_get_regname_vex (xinsn->vex_src, xinsn->size));
+      break;
+    case ORC_X86_INSN_TYPE_MMXM_MMX_REV:
+    case ORC_X86_INSN_TYPE_SSEM_SSE_REV:
+    case ORC_X86_INSN_TYPE_MMX_REGM_REV:
+    case ORC_X86_INSN_TYPE_IMM8_MMX_REG_REV:
+      reg_str = orc_x86_get_regname_vex (reg, reg_size);
+      ORC_ASM_CODE(p,"  %s %s%%%s, %s%s\n", name_str, imm_str, reg_str,
+          vvvv_str, rm_str);
+      break;
+    default:
+      reg_str = orc_x86_get_regname_vex (reg, reg_size);
+      ORC_ASM_CODE(p,"  %s %s%s, %s%%%s\n", name_str, imm_str, rm_str,
+          vvvv_str, reg_str);
+      break;
+  }
+}
+
 static void
 orc_x86_insn_output_asm (OrcCompiler *p, OrcX86Insn *xinsn)
 {
@@ -307,6 +437,11 @@ orc_x86_insn_output_asm (OrcCompiler *p, OrcX86Insn *xinsn)
   char op2_str[40] = { 0 };
   int is_sse;
 
+  if (xinsn->vex) {
+    orc_x86_insn_output_asm_vex (p, xinsn);
+    return;
+  }
+
   if (xinsn->opcode->type == ORC_X86_INSN_TYPE_ALIGN) {
     if (xinsn->size > 0) ORC_ASM_CODE(p,".p2align %d\n", xinsn->size);
     return;
@@ -563,11 +698,78 @@ orc_uint8 nop_codes[][16] = {
 #endif
 };
 
+static void
+output_vex_opcode (OrcCompiler *p, OrcX86Insn *xinsn)
+{
+  const OrcSysOpcode *opcode = xinsn->opcode;
+  int rm;
+  int reg;
+  int index;
+  int r, x, b, w, l;
+  int pp;
+  int map;
+  int vvvv;
+
+  ORC_ASSERT(opcode->code != 0);
+
+  orc_x86_vex_get_operands (xinsn, &rm, &reg);
+  index = (xinsn->type == ORC_X86_RM_MEMINDEX) ? xinsn->index_reg : 0;
+
+  r = !(reg & 8);
+  x = !(index & 8);
+  b = !(rm & 8);
+  w = (opcode->flags & ORC_SYS_OPCODE_FLAG_VEX_W) ? 1 : 0;
+  l = (xinsn->size == 32) ? 1 : 0;
+
+  switch (opcode->prefix) {
+    case 0x01:
+    case 0x66:
+      pp = 1;
+      break;
+    case 0xf3:
+      pp = 2;
+      break;
+    case 0xf2:
+      pp = 3;
+      break;
+    default:
+      pp = 0;
+      break;
+  }
+
+  if (opcode->code & 0xff0000) {
+    map = (((opcode->code >> 8) & 0xff) == 0x38) ? 2 : 3;
+  } else {
+    map = 1;
+  }
+
+  if (xinsn->vex_src) {
+    vvvv = (~xinsn->vex_src) & 0xf;
+  } else {
+    vvvv = 0xf;
+  }
+
+  if (map == 1 && !w && x && b) {
+    *p->codeptr++ = 0xc5;
+    *p->codeptr++ = (r << 7) | (vvvv << 3) | (l << 2) | pp;
+  } else {
+    *p->codeptr++ = 0xc4;
+    *p->codeptr++ = (r << 7) | (x << 6) | (b << 5) | map;
+    *p->codeptr++ = (w << 7) | (vvvv << 3) | (l << 2) | pp;
+  }
+  *p->codeptr++ = (opcode->code >> 0) & 0xff;
+}
+
 static void
 orc_x86_insn_output_opcode (OrcCompiler *p, OrcX86Insn *xinsn)
 {
   int is_sse;
 
+  if (xinsn->vex) {
+    output_vex_opcode (p, xinsn);
+    return;
+  }
+
   is_sse = FALSE;
   if (is_sse_reg (xinsn->src) || is_sse_reg (xinsn->dest)) {
     is_sse = TRUE;
@@ -1154,3 +1356,83 @@ orc_x86_emit_cpuinsn_memoffset (OrcCompiler *p, int index, int size,
   xinsn->size = size;
 }
 
+
+void
+orc_x86_emit_cpuinsn_vex (OrcCompiler *p, int index, int size, int imm,
+    int src0, int src1, int dest)
+{
+  OrcX86Insn *xinsn = orc_x86_get_output_insn (p);
+  const OrcSysOpcode *opcode = orc_x86_opcodes + index;
+
+  xinsn->opcode_index = index;
+  xinsn->opcode = opcode;
+  xinsn->imm = imm;
+  if (opcode->type == ORC_X86_INSN_TYPE_IMM8_MMX_SHIFT) {
+    /* shift by immediate: the source is in r/m, the destination in vvvv */
+    xinsn->dest = src1;
+    xinsn->vex_src = dest;
+  } else {
+    xinsn->src = src1;
+    xinsn->dest = dest;
+    xinsn->vex_src = src0;
+  }
+  xinsn->type = ORC_X86_RM_REG;
+  xinsn->size = size;
+  xinsn->vex = TRUE;
+}
+
+void
+orc_x86_emit_cpuinsn_vex_load_memoffset (OrcCompiler *p, int index, int size,
+    int imm, int offset, int src, int dest)
+{
+  OrcX86Insn *xinsn = orc_x86_get_output_insn (p);
+  const OrcSysOpcode *opcode = orc_x86_opcodes + index;
+
+  xinsn->opcode_index = index;
+  xinsn->opcode = opcode;
+  xinsn->imm = imm;
+  xinsn->src = src;
+  xinsn->dest = dest;
+  xinsn->type = ORC_X86_RM_MEMOFFSET;
+  xinsn->offset = offset;
+  xinsn->size = size;
+  xinsn->vex = TRUE;
+}
+
+void
+orc_x86_emit_cpuinsn_vex_store_memoffset (OrcCompiler *p, int index, int size,
+    int imm, int src, int offset, int dest)
+{
+  OrcX86Insn *xinsn = orc_x86_get_output_insn (p);
+  const OrcSysOpcode *opcode = orc_x86_opcodes + index;
+
+  xinsn->opcode_index = index;
+  xinsn->opcode = opcode;
+  xinsn->imm = imm;
+  xinsn->src = src;
+  xinsn->dest = dest;
+  xinsn->type = ORC_X86_RM_MEMOFFSET;
+  xinsn->offset = offset;
+  xinsn->size = size;
+  xinsn->vex = TRUE;
+}
+
+void
+orc_x86_emit_cpuinsn_vex_load_memindex (OrcCompiler *p, int index, int size,
+    int imm, int offset, int src, int src_index, int shift, int dest)
+{
+  OrcX86Insn *xinsn = orc_x86_get_output_insn (p);
+  const OrcSysOpcode *opcode = orc_x86_opcodes + index;
+
+  xinsn->opcode_index = index;
+  xinsn->opcode = opcode;
+  xinsn->imm = imm;
+  xinsn->src = src;
+  xinsn->dest = dest;
+  xinsn->type = ORC_X86_RM_MEMINDEX;
+  xinsn->offset = offset;
+  xinsn->index_reg = src_index;
+  xinsn->shift = shift;
+  xinsn->size = size;
+  xinsn->vex = TRUE;
+}
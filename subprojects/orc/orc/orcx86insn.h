@@ -280,6 +280,17 @@ typedef enum {
   ORC_X86_movq_mmx_store,
   ORC_X86_endbr32,
   ORC_X86_endbr64,
+  ORC_X86_pextrb,
+  ORC_X86_vpbroadcastb,
+  ORC_X86_vpbroadcastw,
+  ORC_X86_vpbroadcastd,
+  ORC_X86_vpbroadcastq,
+  ORC_X86_vbroadcasti128,
+  ORC_X86_vpermq,
+  ORC_X86_vperm2i128,
+  ORC_X86_vextracti128,
+  ORC_X86_vinserti128,
+  ORC_X86_vzeroupper,
 } OrcX86Opcode;
 
 enum {
@@ -302,6 +313,8 @@ struct _OrcX86Insn {
   int index_reg;
   int shift;
   int code_offset;
+  int vex;
+  int vex_src;
 };
 
 ORC_API OrcX86Insn * orc_x86_get_output_insn (OrcCompiler *p);